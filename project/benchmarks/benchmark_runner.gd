@@ -16,6 +16,7 @@ func _init() -> void:
 
 	benchmark_spatial_queries_2d()
 	benchmark_spatial_queries_3d()
+	benchmark_spatial_rebuild_2d()
 	benchmark_array_filter()
 	benchmark_array_sort()
 	benchmark_array_reduce()
@@ -116,6 +117,39 @@ func benchmark_spatial_queries_3d() -> void:
 	print("")
 
 
+func benchmark_spatial_rebuild_2d() -> void:
+	print("--- SpatialGrid2D vs SpatialHash2D Rebuild ---")
+
+	var positions := PackedVector2Array()
+	positions.resize(ITEM_COUNT)
+	for i in ITEM_COUNT:
+		positions[i] = Vector2(randf() * 1000, randf() * 1000)
+
+	var origin := Vector2(500, 500)
+	var radius := 100.0
+
+	var spatial := SpatialHash2D.new()
+	spatial.cell_size = 50.0
+	var grid := SpatialGrid2D.new()
+	grid.cell_size = 50.0
+
+	# Rebuild + one query, as done every physics frame
+	var hash_time := benchmark(func():
+		spatial.build(positions)
+		var _result := spatial.query_radius(origin, radius)
+	)
+
+	var grid_time := benchmark(func():
+		grid.build(positions)
+		var _result := grid.query_radius(origin, radius)
+	)
+
+	print("  Rebuild + radius query:")
+	print("    SpatialHash2D: %.3f ms" % hash_time)
+	print("    SpatialGrid2D: %.3f ms (%.1fx faster)" % [grid_time, hash_time / grid_time if grid_time > 0 else 0.0])
+	print("")
+
+
 func benchmark_array_filter() -> void:
 	print("--- Array Filter Benchmarks ---")
 
@@ -0,0 +1,143 @@
+extends SceneTree
+## AgentiteG Native Benchmarks
+##
+## Runs NativeBenchmark, writes the results as JSON and compares them against
+## a stored baseline. Exits with code 1 when any case regressed.
+## Needs a library built with: scons benchmarks=yes (libagentiteg.benchmark.*)
+## Run with: godot --headless --path project -s res://benchmarks/native_benchmark.gd -- [options]
+##
+## Options:
+##   --sizes=1000,10000     Input sizes (default 1000,10000,100000)
+##   --filter=spatial       Only cases whose name contains this
+##   --min-time=0.2         Seconds per timed run
+##   --repetitions=3        Timed runs per case, fastest kept
+##   --output=<path>        Results file (default res://benchmarks/results/native_latest.json)
+##   --baseline=<path>      Baseline file (default res://benchmarks/baselines/native_baseline.json)
+##   --tolerance=0.15       Allowed slowdown before a case counts as a regression
+##   --save-baseline        Write the results to the baseline file instead of comparing
+##   --no-baseline          Only write the results (used by scons benchmark_smoke)
+
+const DEFAULT_OUTPUT := "res://benchmarks/results/native_latest.json"
+const DEFAULT_BASELINE := "res://benchmarks/baselines/native_baseline.json"
+const MAIN_EXTENSION := "res://addons/agentiteg/agentiteg.gdextension"
+# Lives in a .gdignore folder, so the editor never loads it with the project
+const BENCHMARK_EXTENSION := "res://benchmarks/native/agentiteg_benchmark.gdextension"
+
+func _init() -> void:
+	if not load_benchmark_extension():
+		print("NativeBenchmark is not available. Build with: scons benchmarks=yes")
+		quit(1)
+		return
+
+	var options := parse_options(OS.get_cmdline_user_args())
+
+	var bench = ClassDB.instantiate("NativeBenchmark")
+	if options.has("sizes"):
+		var sizes := PackedInt32Array()
+		for part in String(options["sizes"]).split(",", false):
+			sizes.append(int(part))
+		bench.sizes = sizes
+	if options.has("filter"):
+		bench.filter = options["filter"]
+	if options.has("min-time"):
+		bench.min_time = float(options["min-time"])
+	if options.has("repetitions"):
+		bench.repetitions = int(options["repetitions"])
+
+	print("=" .repeat(72))
+	print("AgentiteG Native Benchmarks")
+	print("=" .repeat(72))
+
+	var report: Dictionary = bench.run()
+	if report["results"].is_empty():
+		print("No benchmark results (check --filter)")
+		quit(1)
+		return
+	print("SIMD: %s, threads: %d" % [report["simd_level"], report["threads"]])
+	print("")
+	print("%-40s %8s %12s %14s %8s" % ["Case", "Size", "ns/op", "items/s", "allocs"])
+	for result in report["results"]:
+		print("%-40s %8d %12.0f %14.0f %8.1f" % [
+			result["name"], result["size"], result["ns_per_op"],
+			result["items_per_second"], result["allocations_per_op"]])
+
+	var output: String = options.get("output", DEFAULT_OUTPUT)
+	var baseline_path: String = options.get("baseline", DEFAULT_BASELINE)
+
+	if options.has("save-baseline"):
+		if not write_json(baseline_path, report):
+			quit(1)
+			return
+		print("")
+		print("Baseline saved to %s" % baseline_path)
+		quit(0)
+		return
+
+	if not write_json(output, report):
+		quit(1)
+		return
+	print("")
+	print("Results written to %s" % output)
+
+	if options.has("no-baseline"):
+		quit(0)
+		return
+
+	if not FileAccess.file_exists(baseline_path):
+		print("No baseline at %s (run with --save-baseline to create one)" % baseline_path)
+		quit(0)
+		return
+
+	var baseline = JSON.parse_string(FileAccess.get_file_as_string(baseline_path))
+	if typeof(baseline) != TYPE_DICTIONARY:
+		print("Could not parse baseline %s" % baseline_path)
+		quit(1)
+		return
+
+	var tolerance := float(options.get("tolerance", "0.15"))
+	var regressions: Array = ClassDB.class_call_static("NativeBenchmark", "compare", report, baseline, tolerance)
+	if regressions.is_empty():
+		print("No regressions against baseline (tolerance %.0f%%)" % (tolerance * 100.0))
+		quit(0)
+		return
+
+	print("")
+	print("%d regression(s) against baseline (tolerance %.0f%%):" % [regressions.size(), tolerance * 100.0])
+	for r in regressions:
+		print("  %-38s %8d %10.0f -> %10.0f ns  (%.2fx)" % [
+			r["name"], r["size"], r["baseline_ns"], r["current_ns"], r["ratio"]])
+	quit(1)
+
+
+# Swap the regular library for the instrumented benchmark build
+func load_benchmark_extension() -> bool:
+	if ClassDB.class_exists("NativeBenchmark"):
+		return true
+	if GDExtensionManager.is_extension_loaded(MAIN_EXTENSION):
+		GDExtensionManager.unload_extension(MAIN_EXTENSION)
+	if GDExtensionManager.load_extension(BENCHMARK_EXTENSION) != GDExtensionManager.LOAD_STATUS_OK:
+		return false
+	return ClassDB.class_exists("NativeBenchmark")
+
+
+func parse_options(args: PackedStringArray) -> Dictionary:
+	var options := {}
+	for arg in args:
+		if not arg.begins_with("--"):
+			continue
+		var eq := arg.find("=")
+		if eq < 0:
+			options[arg.substr(2)] = ""
+		else:
+			options[arg.substr(2, eq - 2)] = arg.substr(eq + 1)
+	return options
+
+
+func write_json(path: String, data: Dictionary) -> bool:
+	DirAccess.make_dir_recursive_absolute(ProjectSettings.globalize_path(path.get_base_dir()))
+	var file := FileAccess.open(path, FileAccess.WRITE)
+	if file == null:
+		print("Could not write %s" % path)
+		return false
+	file.store_string(JSON.stringify(data, "\t"))
+	return true
@@ -73,6 +73,19 @@ func _init():
 	var clamped = MathOps.clamp_length_batch_2d(big_vecs, 10.0)
 	print("Clamped: ", clamped)  # Should be (10, 0), (5, 0)
 
+	# Test SoA variants against the vector versions
+	print("SIMD level: ", MathOps.get_simd_level())
+	var soa_vecs = PackedVector2Array()
+	for i in range(37):
+		soa_vecs.append(Vector2(i * 0.5 - 9.0, 3.0 - i))
+	var soa = MathOps.to_soa_2d(soa_vecs)
+	assert(MathOps.from_soa_2d(soa[0], soa[1]) == soa_vecs, "SoA round trip should be exact")
+	var soa_normalized = MathOps.normalize_batch_2d_soa(soa[0], soa[1])
+	assert(MathOps.from_soa_2d(soa_normalized[0], soa_normalized[1]) == MathOps.normalize_batch_2d(soa_vecs), "SoA normalize should match")
+	var soa_matrix = MathOps.distance_matrix_2d_soa(soa[0], soa[1], soa[0], soa[1])
+	assert(soa_matrix == MathOps.distance_matrix_2d(soa_vecs, soa_vecs), "SoA distance matrix should match")
+	assert(soa_matrix.size() == 37 * 37, "Distance matrix should hold every pair")
+
 	print("\n=== BatchOps ===")
 	# Test apply velocities
 	var positions = PackedVector2Array([Vector2(0, 0), Vector2(10, 10)])
@@ -103,12 +116,179 @@ func _init():
 	var limited = BatchOps.limit_velocity_2d(fast_vels, 10.0)
 	print("Limited velocities: ", limited)  # Should be (10, 0), (5, 0)
 
+	# Test in-place and into variants against the returning versions
+	var position_buffer = Vector2Buffer.new()
+	position_buffer.set_data(positions)
+	BatchOps.apply_velocities_2d_in_place(position_buffer, velocities, delta)
+	assert(position_buffer.get_data() == new_positions, "In-place apply velocities should match")
+	var velocity_buffer = Vector2Buffer.new()
+	velocity_buffer.set_data(fast_vels)
+	BatchOps.limit_velocity_2d_in_place(velocity_buffer, 10.0)
+	assert(velocity_buffer.get_data() == limited, "In-place limit velocity should match")
+	var desired_buffer = Vector2Buffer.new()
+	BatchOps.seek_batch_into(seeker_positions, targets, 10.0, desired_buffer)
+	assert(desired_buffer.get_data() == desired, "Seek into buffer should match")
+	MathOps.scale_batch_2d_in_place(desired_buffer, 2.0)
+	assert(desired_buffer.get_data() == MathOps.scale_batch_2d(desired, 2.0), "In-place scale should match")
+	var scaled_desired = desired_buffer.get_data()
+	BatchOps.seek_batch_into(seeker_positions, PackedVector2Array([Vector2.ZERO]), 10.0, desired_buffer)
+	assert(desired_buffer.get_data() == scaled_desired, "Mismatched seek into should leave the buffer unchanged")
+	print("In-place variants match")
+
+	# Test the fused steering integrator against the chained calls
+	var crowd = SteeringIntegrator2D.new()
+	crowd.max_speed = 10.0
+	crowd.set_agents(seeker_positions)
+	crowd.set_targets(targets)
+	crowd.step(delta)
+	var chained_vels = BatchOps.limit_velocity_2d(BatchOps.apply_accelerations_2d(
+		PackedVector2Array([Vector2.ZERO, Vector2.ZERO]), BatchOps.seek_batch(seeker_positions, targets, 10.0), delta), 10.0)
+	var chained_pos = BatchOps.apply_velocities_2d(seeker_positions, chained_vels, delta)
+	for i in range(2):
+		assert(crowd.get_positions()[i].is_equal_approx(chained_pos[i]), "Fused step should match chained calls")
+	print("Steering integrator: ", crowd.get_positions())
+
+	# Test the fused step with every behavior on against the per-behavior batch calls
+	var mix_positions = PackedVector2Array()
+	var mix_velocities = PackedVector2Array()
+	var mix_targets = PackedVector2Array()
+	for i in range(60):
+		mix_positions.append(Vector2(i % 8, i / 8) * 6.0 + Vector2(0.5 * (i % 3), 0.0))
+		mix_velocities.append(Vector2(20, 0).rotated(i * 0.7))
+		mix_targets.append(Vector2(100, 40) - Vector2(i, 2 * i))
+	var mix_centers = PackedVector2Array([Vector2(30, 10), Vector2(10, 45), Vector2(60, 60)])
+	var mix_radii = PackedFloat32Array([8.0, 5.0, 12.0])
+	var mix = SteeringIntegrator2D.new()
+	mix.max_speed = 25.0
+	mix.max_force = 60.0
+	mix.seek_weight = 1.5
+	mix.separation_radius = 10.0
+	mix.separation_weight = 40.0
+	mix.avoidance_lookahead = 15.0
+	mix.avoidance_weight = 30.0
+	mix.set_agents(mix_positions, mix_velocities)
+	mix.set_targets(mix_targets)
+	mix.set_obstacles(mix_centers, mix_radii)
+	mix.step(delta)
+	var mix_seek = BatchOps.seek_batch(mix_positions, mix_targets, 25.0)
+	var mix_sep = BatchOps.separation_2d(mix_positions, 10.0, 40.0)
+	var mix_avoid = BatchOps.avoid_circles_2d(mix_positions, mix_velocities, mix_centers, mix_radii, 15.0, 30.0)
+	var mix_steering = PackedVector2Array()
+	for i in range(mix_positions.size()):
+		mix_steering.append(mix_seek[i] * 1.5 + mix_sep[i] + mix_avoid[i])
+	mix_steering = BatchOps.limit_velocity_2d(mix_steering, 60.0)
+	var mix_vels = BatchOps.limit_velocity_2d(BatchOps.apply_accelerations_2d(mix_velocities, mix_steering, delta), 25.0)
+	var mix_pos = BatchOps.apply_velocities_2d(mix_positions, mix_vels, delta)
+	var mix_separating = 0
+	var mix_avoiding = 0
+	for i in range(mix_positions.size()):
+		assert(mix.get_velocities()[i].distance_to(mix_vels[i]) < 1e-3, "Fused separation/avoidance velocity should match chained calls")
+		assert(mix.get_positions()[i].distance_to(mix_pos[i]) < 1e-3, "Fused separation/avoidance position should match chained calls")
+		mix_separating += 1 if mix_sep[i] != Vector2.ZERO else 0
+		mix_avoiding += 1 if mix_avoid[i] != Vector2.ZERO else 0
+	assert(mix_separating > 0 and mix_avoiding > 0, "The mixed case should exercise separation and avoidance")
+
+	# Same in 3D: seek + separation with agents spread in depth
+	var mix_positions_3d = PackedVector3Array()
+	var mix_targets_3d = PackedVector3Array()
+	for i in range(60):
+		mix_positions_3d.append(Vector3(i % 4, (i / 4) % 4, i / 16) * 6.0 + Vector3(0.5 * (i % 3), 0.0, 0.25 * (i % 5)))
+		mix_targets_3d.append(Vector3(50, -20, 30) + Vector3(i, 0, -i))
+	var mix_3d = SteeringIntegrator3D.new()
+	mix_3d.max_speed = 25.0
+	mix_3d.max_force = 60.0
+	mix_3d.separation_radius = 10.0
+	mix_3d.separation_weight = 40.0
+	mix_3d.set_agents(mix_positions_3d)
+	mix_3d.set_targets(mix_targets_3d)
+	mix_3d.step(delta)
+	var mix_seek_3d = BatchOps.seek_batch_3d(mix_positions_3d, mix_targets_3d, 25.0)
+	var mix_sep_3d = BatchOps.separation_3d(mix_positions_3d, 10.0, 40.0)
+	var mix_steering_3d = PackedVector3Array()
+	for i in range(mix_positions_3d.size()):
+		mix_steering_3d.append(mix_seek_3d[i] + mix_sep_3d[i])
+	mix_steering_3d = BatchOps.limit_velocity_3d(mix_steering_3d, 60.0)
+	var mix_zero_3d = PackedVector3Array()
+	mix_zero_3d.resize(mix_positions_3d.size())
+	var mix_vels_3d = BatchOps.limit_velocity_3d(BatchOps.apply_accelerations_3d(mix_zero_3d, mix_steering_3d, delta), 25.0)
+	var mix_pos_3d = BatchOps.apply_velocities_3d(mix_positions_3d, mix_vels_3d, delta)
+	for i in range(mix_positions_3d.size()):
+		assert(mix_3d.get_positions()[i].distance_to(mix_pos_3d[i]) < 1e-3, "Fused 3D separation should match chained calls")
+
+	# 3D avoidance of agents and spheres in the z = 0 plane matches the circle avoidance
+	var mix_plane = PackedVector3Array()
+	var mix_plane_vels = PackedVector3Array()
+	for i in range(mix_positions.size()):
+		mix_plane.append(Vector3(mix_positions[i].x, mix_positions[i].y, 0.0))
+		mix_plane_vels.append(Vector3(mix_velocities[i].x, mix_velocities[i].y, 0.0))
+	var mix_spheres = PackedVector3Array()
+	for c in mix_centers:
+		mix_spheres.append(Vector3(c.x, c.y, 0.0))
+	var avoid_3d = SteeringIntegrator3D.new()
+	avoid_3d.max_speed = 25.0
+	avoid_3d.avoidance_lookahead = 15.0
+	avoid_3d.avoidance_weight = 30.0
+	avoid_3d.set_agents(mix_plane, mix_plane_vels)
+	avoid_3d.set_obstacles(mix_spheres, mix_radii)
+	avoid_3d.step(delta)
+	var avoid_vels = BatchOps.limit_velocity_2d(BatchOps.apply_accelerations_2d(mix_velocities, mix_avoid, delta), 25.0)
+	for i in range(mix_positions.size()):
+		var v = avoid_3d.get_velocities()[i]
+		assert(Vector2(v.x, v.y).distance_to(avoid_vels[i]) < 1e-3 and v.z == 0.0, "Fused 3D avoidance should match circle avoidance")
+	print("Steering integrator with separation and avoidance matches the batch calls")
+
+	# Test the agent store: stable handles, swap-remove and in-place interop
+	var store = AgentStore2D.new()
+	var handles = store.add_batch(positions, velocities, PackedFloat32Array([8.0, 8.0]))
+	var extra = store.add(Vector2(10, 2), Vector2.ZERO, 8.0)
+	BatchOps.apply_velocities_store_2d(store, delta)
+	assert(store.get_positions().slice(0, 2) == new_positions, "Store apply velocities should match")
+	var store_pairs = CollisionOps.circles_self_collision_store(store)
+	assert(store_pairs == CollisionOps.circles_self_collision(store.get_positions(), store.get_radii()), "Store collision should match")
+	assert(store.remove(handles[0]), "Remove should succeed")
+	assert(not store.has(handles[0]) and store.get_count() == 2, "Removed handle should be invalid")
+	assert(store.index_of(extra) == 0 and store.get_position(extra) == Vector2(10, 2), "Last agent should move into the freed index")
+	print("Agent store: ", store.get_count(), " agents, ", store_pairs.size() / 2, " pairs")
+
+	# A hash built from a store keeps its own copy of the positions: integrating the
+	# store afterwards leaves the hash on the build-time positions until the next rebuild
+	var store_hash = SpatialHash2D.new()
+	store_hash.cell_size = 16.0
+	store_hash.build_from_store(store)
+	var built_positions = store.get_positions()
+	store.set_velocities(PackedVector2Array([Vector2(100, 0), Vector2(100, 0)]))
+	BatchOps.apply_velocities_store_2d(store, 1.0)
+	assert(store.get_position(extra) == built_positions[0] + Vector2(100, 0), "Store should integrate after a hash build")
+	assert(0 in store_hash.query_radius(built_positions[0], 0.5), "Hash should keep the build-time positions")
+	assert(store_hash.query_radius(store.get_positions()[0], 0.5).is_empty(), "Hash should not see later store writes")
+	store_hash.build_from_store(store)
+	assert(0 in store_hash.query_radius(store.get_positions()[0], 0.5), "Rebuilt hash should see the new positions")
+
 	# Test flock
 	var flock_pos = PackedVector2Array([Vector2(0, 0), Vector2(10, 0), Vector2(5, 10)])
 	var flock_vel = PackedVector2Array([Vector2(1, 0), Vector2(1, 0), Vector2(1, 0)])
 	var flock_forces = BatchOps.flock_2d(flock_pos, flock_vel, 20.0, 30.0, 30.0, 1.0, 0.5, 0.3)
 	print("Flock forces: ", flock_forces)
 
+	# Test flock with a prebuilt spatial hash (must match the all-pairs result)
+	var big_flock_pos = PackedVector2Array()
+	var big_flock_vel = PackedVector2Array()
+	for i in range(300):
+		big_flock_pos.append(Vector2(i % 20, i / 20) * 8.0)
+		big_flock_vel.append(Vector2(1, 0).rotated(i * 0.1))
+	var flock_hash = SpatialHash2D.new()
+	flock_hash.cell_size = 32.0
+	flock_hash.build(big_flock_pos)
+	var grid_forces = BatchOps.flock_2d(big_flock_pos, big_flock_vel, 20.0, 30.0, 30.0, 1.0, 0.5, 0.3)
+	var hash_forces = BatchOps.flock_2d(big_flock_pos, big_flock_vel, 20.0, 30.0, 30.0, 1.0, 0.5, 0.3, flock_hash)
+	assert(grid_forces == hash_forces)
+	print("Flock with spatial hash: ", hash_forces.size(), " forces, matches internal grid")
+
+	var flock_pos_3d = PackedVector3Array([Vector3(0, 0, 0), Vector3(10, 0, 0), Vector3(5, 10, 0)])
+	var flock_vel_3d = PackedVector3Array([Vector3(1, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 0)])
+	var flock_forces_3d = BatchOps.flock_3d(flock_pos_3d, flock_vel_3d, 20.0, 30.0, 30.0, 1.0, 0.5, 0.3)
+	print("Flock forces 3D: ", flock_forces_3d)
+
 	print("\n=== RandomOps ===")
 	var rng = RandomOps.new()
 	rng.seed(12345)
@@ -173,6 +353,21 @@ func _init():
 			var dist = poisson[i].distance_to(poisson[j])
 			assert(dist >= 9.9, "Poisson points should be at least min_distance apart")
 
+	# Test tiled Poisson: chunks match the region and keep spacing across borders
+	var tiled = TiledPoisson2D.new()
+	tiled.seed = 7
+	tiled.tile_size = 40.0
+	tiled.min_distance = 10.0
+	var region = tiled.generate(Rect2(0, 0, 80, 40))
+	var chunk_a = tiled.generate_chunk(Vector2i(0, 0))
+	var chunk_b = tiled.generate_chunk(Vector2i(1, 0))
+	assert(chunk_a.size() + chunk_b.size() == region.size(), "Chunks should add up to the region")
+	for pa in chunk_a:
+		assert(region.has(pa), "Chunk points should match the region")
+		for pb in chunk_b:
+			assert(pa.distance_to(pb) >= 9.9, "Spacing should hold across chunk borders")
+	print("Tiled Poisson 2D: ", region.size(), " points")
+
 	# Test Gaussian distribution
 	var gaussian = rng.randn_array(1000)
 	var mean_sum = 0.0
@@ -182,6 +377,18 @@ func _init():
 	print("Gaussian mean (should be ~0): ", mean)
 	assert(abs(mean) < 0.2, "Gaussian mean should be close to 0")
 
+	# Test counter-based streams: threaded fills match serial and split fills
+	var prng = ParallelRandom.new()
+	prng.seed = 12345
+	var threaded_normals = prng.randn_array(20000)
+	prng.position = 0
+	prng.threaded = false
+	var first_half = prng.randn_array(10000)
+	var second_half = prng.randn_array(10000)
+	assert(first_half + second_half == threaded_normals, "Threaded fill should match serial fills")
+	assert(prng.position == 20000, "Position should advance by count")
+	print("ParallelRandom normals match serial order")
+
 	print("\n=== NoiseOps ===")
 	var noise = NoiseOps.new()
 	noise.set_seed(12345)
@@ -210,6 +417,30 @@ func _init():
 	print("Perlin grid 4x4: ", grid_vals.size(), " values")
 	assert(grid_vals.size() == 16, "Grid should have 16 values")
 
+	# Test grids cell by cell against the single-point calls. 37 columns is not
+	# a multiple of the SIMD width, so the scalar tail runs, and 250 rows span
+	# several row chunks, so rows are filled on worker threads. The origin and
+	# cell size are exact in single precision, so both sides see the same inputs.
+	var grid_origin = Vector2(-3.25, 1.5)
+	var grid_cell = Vector2(0.5, 0.25)
+	var grid_w = 37
+	var grid_h = 250
+	var perlin_grid = noise.perlin_2d_grid(grid_origin, grid_cell, grid_w, grid_h)
+	var simplex_grid = noise.simplex_2d_grid(grid_origin, grid_cell, grid_w, grid_h)
+	var worley_grid = noise.worley_2d_grid(grid_origin, grid_cell, grid_w, grid_h)
+	var fbm_grid = noise.fbm_2d_grid(grid_origin, grid_cell, grid_w, grid_h)
+	var ridged_grid = noise.ridged_2d_grid(grid_origin, grid_cell, grid_w, grid_h)
+	for gy in range(grid_h):
+		for gx in range(grid_w):
+			var cell_pos = Vector2(grid_origin.x + gx * grid_cell.x, grid_origin.y + gy * grid_cell.y)
+			var cell = gy * grid_w + gx
+			assert(perlin_grid[cell] == noise.perlin_2d(cell_pos), "Perlin grid should match perlin_2d")
+			assert(simplex_grid[cell] == noise.simplex_2d(cell_pos), "Simplex grid should match simplex_2d")
+			assert(worley_grid[cell] == noise.worley_2d(cell_pos), "Worley grid should match worley_2d")
+			assert(fbm_grid[cell] == noise.fbm_2d(cell_pos), "FBM grid should match fbm_2d")
+			assert(ridged_grid[cell] == noise.ridged_2d(cell_pos), "Ridged grid should match ridged_2d")
+	print("Noise grids match single-point calls (", grid_w, "x", grid_h, ")")
+
 	# Test Simplex noise
 	var s_val = noise.simplex_2d(Vector2(10.5, 20.3))
 	print("Simplex 2D at (10.5, 20.3): ", s_val)
@@ -241,6 +472,13 @@ func _init():
 	var p3d = noise.perlin_3d(Vector3(5.0, 5.0, 5.0))
 	print("Perlin 3D: ", p3d)
 
+	# Test fused volume (padding overlaps the neighboring chunk)
+	var volume = noise.fbm_3d_volume(Vector3(0, 0, 0), Vector3(1, 1, 1), Vector3i(4, 4, 4), 2.0, 1)
+	assert(volume.size() == 6 * 6 * 6, "Padded volume should be 6x6x6")
+	var next_volume = noise.fbm_3d_volume(Vector3(4, 0, 0), Vector3(1, 1, 1), Vector3i(4, 4, 4), 2.0, 1)
+	assert(volume[6 * 6 + 6 + 5] == next_volume[6 * 6 + 6 + 1], "Chunk borders should match")
+	print("FBM 3D volume: ", volume.size(), " samples")
+
 	print("\n=== GridOps ===")
 	# Test coordinate conversion
 	var idx = GridOps.to_index(5, 3, 10)
@@ -301,10 +539,64 @@ func _init():
 	print("Line (0,0) to (0,4) no wall: ", clear2)  # Should be true
 	assert(clear2 == true, "Line with no wall should be clear")
 
+	# Test batch raycast (positions in cell units, cell centers at +0.5)
+	var ray_hits = GridOps.raycast_grid_batch(blocking_grid, 5, 5,
+		PackedVector2Array([Vector2(0.5, 2.5), Vector2(0.5, 0.5)]),
+		PackedVector2Array([Vector2(1, 0), Vector2(0, 1)]),
+		PackedFloat32Array([10.0, 10.0]), 1)
+	print("Batch raycast hits: ", ray_hits[0], " at ", ray_hits[1])
+	assert(ray_hits[0] == PackedInt32Array([12, -1]), "First ray should hit the wall, second should miss")
+	assert(is_equal_approx(ray_hits[1][0], 1.5), "Wall should be entered 1.5 cells away")
+
+	# Test merged FOV and incremental visibility
+	var fov_origins = PackedVector2Array([Vector2(0, 0), Vector2(4, 4)])
+	var fov_radii = PackedInt32Array([5, 1])
+	var team_fov = GridOps.fov_shadowcast_multi(blocking_grid, 5, 5, fov_origins, fov_radii, 1)
+	assert(team_fov[0] == 1 and team_fov[24] == 1, "Both observers should see their own cells")
+	assert(team_fov[18] == 0, "Cell (3, 3) should be hidden behind the wall")
+	var fog = VisibilityMap.new()
+	fog.set_grid(blocking_grid, 5, 5, 1)
+	assert(fog.update(fov_origins, fov_radii) == 2, "First update should cast both observers")
+	assert(fog.get_visibility() == team_fov, "VisibilityMap should match fov_shadowcast_multi")
+	assert(fog.update(fov_origins, fov_radii) == 0, "Unmoved observers should be skipped")
+	blocking_grid[12] = 0
+	fog.update_grid(blocking_grid, Rect2i(2, 2, 1, 1))
+	assert(fog.update(fov_origins, fov_radii) == 1, "Only the observer in range of the change should be recast")
+	assert(fog.is_cell_visible(Vector2i(3, 3)), "Removing the wall should reveal (3, 3)")
+	print("VisibilityMap: ", fog.get_visibility().count(1), " visible cells")
+
+	# Test fractional origins are rounded down: (-0.5, 0.5) is in cell (-1, 0), off the grid
+	var frac_origins = PackedVector2Array([Vector2(-0.5, 0.5), Vector2(2.75, 0.5)])
+	var frac_radii = PackedInt32Array([0, 0])
+	var frac_fov = GridOps.fov_shadowcast_multi(blocking_grid, 5, 5, frac_origins, frac_radii, 1)
+	assert(frac_fov.count(1) == 1 and frac_fov[2] == 1, "Only cell (2, 0) should be seen")
+	var frac_fog = VisibilityMap.new()
+	frac_fog.set_grid(blocking_grid, 5, 5, 1)
+	frac_fog.update(frac_origins, frac_radii)
+	assert(frac_fog.get_visibility() == frac_fov, "VisibilityMap should round origins the same way")
+
 	# Test connected components
 	var comp_count = GridOps.count_connected_components(test_grid, 5, 5, 1)
 	print("Connected components of 1s: ", comp_count)
 	assert(comp_count == 2, "Should have 2 connected components of 1s")
+	var labeled = GridOps.label_components_with_sizes(test_grid, 5, 5, 1)
+	assert(labeled[0] == GridOps.label_connected_components(test_grid, 5, 5, 1), "Labels should match label_connected_components")
+	assert(labeled[1] == PackedInt32Array([4, 9]), "Sizes should come with the labels")
+
+	# Test incremental components: cutting (3, 3) splits the right island
+	var islands = ConnectedComponents.new()
+	var island_grid = test_grid.duplicate()
+	islands.set_grid(island_grid, 5, 5, 1)
+	assert(islands.are_connected(Vector2i(3, 1), Vector2i(1, 4)), "Right island should start connected")
+	island_grid[18] = 0
+	islands.update_cells(island_grid, PackedInt32Array([18]))
+	assert(islands.get_component_count() == 3, "Removing (3, 3) should split the island")
+	assert(not islands.are_connected(Vector2i(3, 1), Vector2i(1, 4)), "Pieces should no longer be connected")
+	island_grid[18] = 1
+	island_grid[7] = 1
+	islands.update_cells(island_grid, PackedInt32Array([18, 7]))
+	assert(islands.get_component_count() == 1, "Refilling and bridging should join everything")
+	print("ConnectedComponents: ", islands.get_component_count(), " component of ", islands.get_component_size(islands.get_label(Vector2i(0, 0))), " cells")
 
 	# Test distance field
 	var target_grid = PackedInt32Array([
@@ -320,6 +612,13 @@ func _init():
 	assert(dist_field[12] == 0, "Target cell distance should be 0")
 	assert(dist_field[11] == 1, "Adjacent cell distance should be 1")
 
+	# Test exact Euclidean distance field
+	var euclid_sq = GridOps.euclidean_distance_field_squared(target_grid, 5, 5, 1)
+	var euclid = GridOps.euclidean_distance_field(target_grid, 5, 5, 1)
+	print("Euclidean distance to corner: ", euclid[0], " (squared ", euclid_sq[0], ")")
+	assert(euclid_sq[0] == 8 and euclid_sq[1] == 5, "Squared distances should be exact")
+	assert(is_equal_approx(euclid[0], sqrt(8.0)), "Corner distance should be sqrt(8)")
+
 	# Test find value
 	var found = GridOps.find_value(test_grid, 1)
 	print("Found ", found.size(), " cells with value 1")
@@ -397,6 +696,65 @@ func _init():
 	print("JPS path: ", jps_path.size(), " steps")
 	assert(jps_path.size() > 0, "JPS should find a path")
 
+	# Test reusing a PathfindingContext across searches
+	var ctx = PathfindingContext.new()
+	var ctx_path = PathfindingOps.astar_grid(costs, 5, 5, Vector2i(0, 0), Vector2i(4, 4), true, ctx)
+	assert(ctx_path == path, "Context search should match plain search")
+	var ctx_jps = PathfindingOps.jps_grid(walkable_grid, 5, 5, Vector2i(0, 0), Vector2i(4, 4), ctx)
+	assert(ctx_jps == jps_path, "Context JPS should match plain JPS")
+	var ctx_reach = PathfindingOps.reachable_cells(simple_costs, 3, 3, Vector2i(0, 0), 2.0, ctx)
+	assert(ctx_reach.size() == reachable.size(), "Context reachability should match")
+	print("PathfindingContext capacity: ", ctx.get_cell_capacity())  # Should be 25
+
+	# Test batch pathfinding (list and flat output agree with single searches)
+	var batch_starts = PackedVector2Array([Vector2(0, 0), Vector2(4, 0), Vector2(0, 4)])
+	var batch_goals = PackedVector2Array([Vector2(4, 4), Vector2(0, 4), Vector2(9, 9)])
+	var batch_paths = PathfindingOps.astar_batch(costs, 5, 5, batch_starts, batch_goals, true, ctx)
+	assert(batch_paths.size() == 3, "One result per pair")
+	assert(batch_paths[0] == path, "Batch path should match astar_grid")
+	assert(batch_paths[2].size() == 0, "Out of bounds goal has no path")
+	var flat_paths = PathfindingOps.astar_batch_flat(costs, 5, 5, batch_starts, batch_goals, true)
+	assert(flat_paths.get_query_count() == 3, "Flat batch should hold every pair")
+	assert(flat_paths.get_neighbors(1) == batch_paths[1], "Flat path should match list path")
+	print("Batch paths: ", batch_paths.size(), " results, ", flat_paths.get_total_count(), " cells total")
+
+	# Test hierarchical pathfinding on a map with a wall across the middle
+	var hpa_costs = PackedFloat32Array()
+	for y in range(32):
+		for x in range(32):
+			hpa_costs.append(0.0 if (x == 16 and y < 28) else 1.0)
+	var hpa = HierarchicalPathfinder.new()
+	hpa.cluster_size = 8
+	hpa.build(hpa_costs, 32, 32)
+	var hpa_path = hpa.find_path(Vector2i(2, 2), Vector2i(30, 2))
+	assert(hpa_path.size() > 0, "HPA* should find a path around the wall")
+	assert(hpa_path[0] == 2 * 32 + 2, "HPA* path should start at start")
+	assert(hpa_path[hpa_path.size() - 1] == 2 * 32 + 30, "HPA* path should end at goal")
+	print("HPA* path: ", hpa_path.size(), " steps, ", hpa.get_node_count(), " entrances")
+
+	# Close the gap and update only that region
+	for y in range(28, 32):
+		hpa_costs[y * 32 + 16] = 0.0
+	hpa.update_region(hpa_costs, Rect2i(16, 28, 1, 4))
+	assert(hpa.find_path(Vector2i(2, 2), Vector2i(30, 2)).size() == 0, "Wall should now block the path")
+
+	# Test cached flow fields on the same walled map
+	var flows = FlowFieldCache.new()
+	flows.set_costs(hpa_costs, 32, 32)
+	var flow_goals = PackedVector2Array([Vector2(30, 2)])
+	var cached_flow = flows.get_flow_field(flow_goals)
+	assert(cached_flow == PathfindingOps.flow_field_multi(hpa_costs, 32, 32, flow_goals), "Cached flow should match flow_field_multi")
+	assert(flows.has_field(flow_goals), "Field should be cached")
+	assert(is_inf(flows.get_dijkstra_map(flow_goals)[2 * 32 + 2]), "Wall should cut off the west side")
+
+	# Open a door and repair the cached field
+	hpa_costs[10 * 32 + 16] = 1.0
+	flows.update_costs(hpa_costs, Rect2i(16, 10, 1, 1))
+	var door_distances = flows.get_dijkstra_map(flow_goals)
+	assert(door_distances == PathfindingOps.dijkstra_map(hpa_costs, 32, 32, flow_goals), "Repaired distances should match dijkstra_map")
+	assert(flows.get_flow_field(flow_goals) == PathfindingOps.flow_field_multi(hpa_costs, 32, 32, flow_goals), "Repaired flow should match flow_field_multi")
+	print("FlowFieldCache: ", flows.get_field_count(), " field, distance to west side ", door_distances[2 * 32 + 2])
+
 	print("\n=== CollisionOps ===")
 	# Test points in rect
 	var test_points = PackedVector2Array([
@@ -432,6 +790,25 @@ func _init():
 	print("Self-collision pairs: ", self_pairs)  # Should find [0, 1]
 	assert(self_pairs.size() == 2, "Should find 1 self-collision pair")
 
+	# Test broadphase self-collision (large set) matches the all-pairs result
+	var many_centers = PackedVector2Array()
+	for i in range(400):
+		many_centers.append(Vector2((i * 37) % 200, (i * 91) % 200))
+	var expected_pairs = PackedInt32Array()
+	for i in range(many_centers.size()):
+		for j in range(i + 1, many_centers.size()):
+			if many_centers[i].distance_squared_to(many_centers[j]) <= 36.0:
+				expected_pairs.append(i)
+				expected_pairs.append(j)
+	var broad_pairs = CollisionOps.circles_self_collision_uniform(many_centers, 3.0)
+	print("Broadphase self-collision pairs: ", broad_pairs.size() / 2)
+	assert(broad_pairs == expected_pairs, "Broadphase pairs should match all-pairs order")
+	var hash_for_pairs = SpatialHash2D.new()
+	hash_for_pairs.cell_size = 8.0
+	hash_for_pairs.build(many_centers)
+	var hashed_pairs = CollisionOps.circles_self_collision_uniform(many_centers, 3.0, hash_for_pairs)
+	assert(hashed_pairs == expected_pairs, "SpatialHash-backed pairs should match all-pairs order")
+
 	# Test ray first circle
 	var ray_centers = PackedVector2Array([Vector2(50, 0), Vector2(100, 0)])
 	var ray_radii = PackedFloat32Array([10.0, 10.0])
@@ -439,6 +816,57 @@ func _init():
 	print("Ray hit first circle: ", hit)  # Should be 0
 	assert(hit == 0, "Should hit first circle")
 
+	# Test batched first hits against the per-ray calls
+	var ray_origins = PackedVector2Array()
+	var ray_dirs = PackedVector2Array()
+	var ray_max = PackedFloat32Array()
+	for i in range(100):
+		ray_origins.append(Vector2(float(i % 13) * 10.0 - 20.0, float(i % 7) * 3.0 - 9.0))
+		ray_dirs.append(Vector2(cos(i * 0.37), sin(i * 0.37)))
+		ray_max.append(40.0 + float(i % 5) * 30.0)
+	var circle_hits = CollisionOps.ray_first_circles_batch(ray_origins, ray_dirs, ray_max, ray_centers, ray_radii)
+	var circle_ids: PackedInt32Array = circle_hits[0]
+	var circle_dists: PackedFloat32Array = circle_hits[1]
+	for i in range(100):
+		var expected_id = CollisionOps.ray_first_circle(ray_origins[i], ray_dirs[i], ray_max[i], ray_centers, ray_radii)
+		assert(circle_ids[i] == expected_id, "Batched circle hit should match ray_first_circle")
+		if expected_id != -1:
+			assert(circle_dists[i] == CollisionOps.ray_vs_circles(ray_origins[i], ray_dirs[i], ray_centers, ray_radii)[expected_id], "Batched circle distance should match")
+	var sphere_centers = PackedVector3Array([Vector3(50, 0, 0), Vector3(100, 5, 0), Vector3(30, 20, 10)])
+	var sphere_radii = PackedFloat32Array([10.0, 10.0, 8.0])
+	var sphere_origins = PackedVector3Array()
+	var sphere_dirs = PackedVector3Array()
+	for i in range(100):
+		sphere_origins.append(Vector3(ray_origins[i].x, ray_origins[i].y, float(i % 3) * 4.0 - 4.0))
+		sphere_dirs.append(Vector3(ray_dirs[i].x, ray_dirs[i].y, float(i % 4) * 0.1 - 0.15))
+	var sphere_hits = CollisionOps.ray_first_spheres_batch(sphere_origins, sphere_dirs, ray_max, sphere_centers, sphere_radii)
+	var sphere_ids: PackedInt32Array = sphere_hits[0]
+	for i in range(100):
+		assert(sphere_ids[i] == CollisionOps.ray_first_sphere(sphere_origins[i], sphere_dirs[i], ray_max[i], sphere_centers, sphere_radii), "Batched sphere hit should match ray_first_sphere")
+
+	# Enough shapes for the AABB tree path, with duplicates (ties), origins
+	# inside shapes and a zero direction
+	var field_centers = PackedVector2Array()
+	var field_radii = PackedFloat32Array()
+	var field_spheres = PackedVector3Array()
+	for i in range(300):
+		var p = Vector2(float((i * 37) % 101) - 50.0, float((i * 53) % 89) - 44.0)
+		if i >= 290:
+			p = field_centers[i - 290]
+		field_centers.append(p)
+		field_radii.append(1.0 + float(i % 4))
+		field_spheres.append(Vector3(p.x, p.y, float((i * 17) % 23) - 11.0))
+	ray_origins.set(0, field_centers[5])
+	ray_dirs.set(1, Vector2.ZERO)
+	var field_hits = CollisionOps.ray_first_circles_batch(ray_origins, ray_dirs, ray_max, field_centers, field_radii)
+	var field_sphere_hits = CollisionOps.ray_first_spheres_batch(sphere_origins, sphere_dirs, ray_max, field_spheres, field_radii)
+	for i in range(100):
+		var expected_id = CollisionOps.ray_first_circle(ray_origins[i], ray_dirs[i], ray_max[i], field_centers, field_radii)
+		assert(field_hits[0][i] == expected_id, "Tree-backed circle hit should match ray_first_circle")
+		if expected_id != -1:
+			assert(field_hits[1][i] == CollisionOps.ray_vs_circles(ray_origins[i], ray_dirs[i], field_centers, field_radii)[expected_id], "Tree-backed circle distance should match")
+		assert(field_sphere_hits[0][i] == CollisionOps.ray_first_sphere(sphere_origins[i], sphere_dirs[i], ray_max[i], field_spheres, field_radii), "Tree-backed sphere hit should match ray_first_sphere")
+
 	# Test segment intersection
 	var seg_starts_a = PackedVector2Array([Vector2(0, 0)])
 	var seg_ends_a = PackedVector2Array([Vector2(10, 10)])
@@ -476,6 +904,95 @@ func _init():
 	print("Square triangulation: ", tris.size() / 3, " triangles")
 	assert(tris.size() == 6, "Square should triangulate to 2 triangles (6 indices)")
 
+	# Test Delaunay with adjacency
+	var dt_points = PackedVector2Array([Vector2(0, 0), Vector2(10, 0), Vector2(10, 10), Vector2(0, 10), Vector2(4, 6)])
+	var dt_tris = GeometryOps.delaunay(dt_points)
+	assert(dt_tris.size() == 4 * 3, "5 points with a 4-point hull should give 4 triangles")
+	var dt_result = GeometryOps.delaunay_half_edges(dt_points)
+	var dt_half_edges: PackedInt32Array = dt_result[1]
+	assert(dt_result[0] == dt_tris, "Half-edge variant should return the same triangles")
+	var shared_edges = 0
+	for e in range(dt_half_edges.size()):
+		if dt_half_edges[e] != -1:
+			assert(dt_half_edges[dt_half_edges[e]] == e, "Half-edges should pair up")
+			shared_edges += 1
+	assert(shared_edges == 8, "4 interior edges, seen from both sides")
+	print("Delaunay: ", dt_tris.size() / 3, " triangles, ", shared_edges / 2, " interior edges")
+
+	# Test Delaunay and Voronoi on a grid with repeated points far apart in the input
+	var dup_grid = PackedVector2Array()
+	for y in range(6):
+		for x in range(6):
+			dup_grid.append(Vector2(x, y))
+	for y in range(5, -1, -1):
+		for x in range(0, 6, 2):
+			dup_grid.append(Vector2(x, y))
+	var dup_tris = GeometryOps.delaunay(dup_grid)
+	assert(dup_tris.size() == 25 * 2 * 3, "Repeated grid points should not add triangles")
+	var dup_cells = GeometryOps.voronoi_cells(dup_grid, Rect2(-0.5, -0.5, 6, 6))
+	assert(dup_cells.size() == dup_grid.size(), "Every point should get a cell")
+	for i in range(dup_cells.size()):
+		assert(abs(GeometryOps.polygon_area(dup_cells[i]) - 1.0) < 0.001, "Repeated points should share the unit cell")
+
+	# Test constrained Delaunay around a square obstacle
+	var room = PackedVector2Array([Vector2(0, 0), Vector2(100, 0), Vector2(100, 100), Vector2(0, 100)])
+	var pillar = PackedVector2Array([Vector2(40, 40), Vector2(40, 60), Vector2(60, 60), Vector2(60, 40)])
+	var cdt = GeometryOps.constrained_delaunay(room, [pillar])
+	var cdt_vertices: PackedVector2Array = cdt[0]
+	var cdt_tris: PackedInt32Array = cdt[1]
+	var cdt_area = 0.0
+	for i in range(0, cdt_tris.size(), 3):
+		cdt_area += GeometryOps.polygon_area(PackedVector2Array([cdt_vertices[cdt_tris[i]], cdt_vertices[cdt_tris[i + 1]], cdt_vertices[cdt_tris[i + 2]]]))
+	assert(cdt_vertices.size() == 8, "Vertices should be the room followed by the pillar")
+	assert(abs(cdt_area - 9600.0) < 0.01, "Triangles should cover the room minus the pillar")
+
+	# Test navigation mesh pathing around the obstacle
+	var nav = NavMesh2D.new()
+	assert(nav.build(room, [pillar]), "Navmesh should build")
+	assert(nav.find_triangle(Vector2(50, 50)) == -1, "Pillar should not be walkable")
+	assert(nav.find_triangle(Vector2(10, 50)) != -1, "Room should be walkable")
+	var nav_path = nav.find_path(Vector2(10, 50), Vector2(90, 50))
+	assert(nav_path.size() == 4, "Path should turn at two pillar corners")
+	assert(nav_path[1] == Vector2(40, 40) or nav_path[1] == Vector2(40, 60), "Path should hug the pillar")
+	print("NavMesh2D: ", nav.get_triangle_count(), " triangles, path ", nav_path)
+
+	# Test holes that share a corner: the shared point is welded into one vertex
+	var corner_a = PackedVector2Array([Vector2(30, 30), Vector2(30, 50), Vector2(50, 50), Vector2(50, 30)])
+	var corner_b = PackedVector2Array([Vector2(50, 50), Vector2(50, 70), Vector2(70, 70), Vector2(70, 50)])
+	var shared_cdt = GeometryOps.constrained_delaunay(room, [corner_a, corner_b])
+	var shared_vertices: PackedVector2Array = shared_cdt[0]
+	var shared_tris: PackedInt32Array = shared_cdt[1]
+	var shared_area = 0.0
+	for i in range(0, shared_tris.size(), 3):
+		shared_area += GeometryOps.polygon_area(PackedVector2Array([shared_vertices[shared_tris[i]], shared_vertices[shared_tris[i + 1]], shared_vertices[shared_tris[i + 2]]]))
+	assert(shared_vertices.size() == 11, "The shared corner should be one vertex")
+	assert(abs(shared_area - 9200.0) < 0.01, "Triangles should cover the room minus both holes")
+	var shared_nav = NavMesh2D.new()
+	assert(shared_nav.build(room, [corner_a, corner_b]), "Navmesh with holes sharing a corner should build")
+	assert(shared_nav.find_triangle(Vector2(40, 40)) == -1 and shared_nav.find_triangle(Vector2(60, 60)) == -1, "Both holes should be blocked")
+	var shared_path = shared_nav.find_path(Vector2(40, 60), Vector2(60, 40))
+	assert(shared_path.size() == 5, "Path should go around one hole, not through the shared corner")
+	for i in range(1, shared_path.size()):
+		assert(shared_path[i] != shared_path[i - 1], "Path should not repeat a corner")
+
+	# Test a hole touching the boundary at one of its vertices
+	var notched_room = PackedVector2Array([Vector2(0, 0), Vector2(50, 0), Vector2(100, 0), Vector2(100, 100), Vector2(0, 100)])
+	var notch = PackedVector2Array([Vector2(50, 0), Vector2(40, 20), Vector2(60, 20)])
+	var notched_nav = NavMesh2D.new()
+	assert(notched_nav.build(notched_room, [notch]), "Navmesh with a hole touching the boundary should build")
+	assert(notched_nav.get_vertices().size() == 7, "The touching point should be one vertex")
+	assert(notched_nav.find_triangle(Vector2(50, 10)) == -1, "The notch should not be walkable")
+	var notched_path = notched_nav.find_path(Vector2(30, 5), Vector2(70, 5))
+	assert(notched_path.size() == 4, "Path should go over the notch")
+	assert(notched_path[1] == Vector2(40, 20) and notched_path[2] == Vector2(60, 20), "Path should turn at the notch's corners")
+
+	# Test point lookup on the far edge of a mesh whose lookup grid is clamped
+	var strip = PackedVector2Array([Vector2(0, 0), Vector2(40960, 0), Vector2(40960, 0.001), Vector2(0, 0.001)])
+	var strip_nav = NavMesh2D.new()
+	assert(strip_nav.build(strip), "Thin strip should build")
+	assert(strip_nav.find_triangle(Vector2(40960, 0.0005)) != -1, "Far edge should be found")
+	assert(strip_nav.find_triangle(Vector2(40961, 0.0005)) == -1, "Past the far edge should not be found")
+
 	# Test simplification
 	var polyline = PackedVector2Array([
 		Vector2(0, 0), Vector2(1, 0.1), Vector2(2, 0), Vector2(3, 0.1), Vector2(4, 0),
@@ -515,5 +1032,186 @@ func _init():
 	assert(bounds.position.x == 0 and bounds.position.y == 0, "Bounds position should be (0, 0)")
 	assert(bounds.size.x == 10 and bounds.size.y == 10, "Bounds size should be (10, 10)")
 
+	print("\n=== InterpolationOps ===")
+	# Test batch easing against the per-curve functions
+	var ease_t = InterpolationOps.linspace(0.0, 1.0, 101)
+	var ease_scalar = InterpolationOps.ease_out_elastic(ease_t)
+	var ease_simd = InterpolationOps.ease_batch(InterpolationOps.EASE_OUT_ELASTIC, ease_t)
+	assert(ease_simd.size() == ease_t.size(), "ease_batch should return one value per t")
+	for i in range(ease_t.size()):
+		assert(abs(ease_simd[i] - ease_scalar[i]) < 1e-5, "ease_batch should match ease_out_elastic")
+	# Every EASE_* constant against the function of the same name
+	var ease_curves = [
+		[InterpolationOps.EASE_LINEAR, ease_t],
+		[InterpolationOps.EASE_IN_QUAD, InterpolationOps.ease_in_quad(ease_t)],
+		[InterpolationOps.EASE_OUT_QUAD, InterpolationOps.ease_out_quad(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_QUAD, InterpolationOps.ease_in_out_quad(ease_t)],
+		[InterpolationOps.EASE_IN_CUBIC, InterpolationOps.ease_in_cubic(ease_t)],
+		[InterpolationOps.EASE_OUT_CUBIC, InterpolationOps.ease_out_cubic(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_CUBIC, InterpolationOps.ease_in_out_cubic(ease_t)],
+		[InterpolationOps.EASE_IN_QUART, InterpolationOps.ease_in_quart(ease_t)],
+		[InterpolationOps.EASE_OUT_QUART, InterpolationOps.ease_out_quart(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_QUART, InterpolationOps.ease_in_out_quart(ease_t)],
+		[InterpolationOps.EASE_IN_QUINT, InterpolationOps.ease_in_quint(ease_t)],
+		[InterpolationOps.EASE_OUT_QUINT, InterpolationOps.ease_out_quint(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_QUINT, InterpolationOps.ease_in_out_quint(ease_t)],
+		[InterpolationOps.EASE_IN_SINE, InterpolationOps.ease_in_sine(ease_t)],
+		[InterpolationOps.EASE_OUT_SINE, InterpolationOps.ease_out_sine(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_SINE, InterpolationOps.ease_in_out_sine(ease_t)],
+		[InterpolationOps.EASE_IN_EXPO, InterpolationOps.ease_in_expo(ease_t)],
+		[InterpolationOps.EASE_OUT_EXPO, InterpolationOps.ease_out_expo(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_EXPO, InterpolationOps.ease_in_out_expo(ease_t)],
+		[InterpolationOps.EASE_IN_CIRC, InterpolationOps.ease_in_circ(ease_t)],
+		[InterpolationOps.EASE_OUT_CIRC, InterpolationOps.ease_out_circ(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_CIRC, InterpolationOps.ease_in_out_circ(ease_t)],
+		[InterpolationOps.EASE_IN_BACK, InterpolationOps.ease_in_back(ease_t)],
+		[InterpolationOps.EASE_OUT_BACK, InterpolationOps.ease_out_back(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_BACK, InterpolationOps.ease_in_out_back(ease_t)],
+		[InterpolationOps.EASE_IN_ELASTIC, InterpolationOps.ease_in_elastic(ease_t)],
+		[InterpolationOps.EASE_OUT_ELASTIC, ease_scalar],
+		[InterpolationOps.EASE_IN_OUT_ELASTIC, InterpolationOps.ease_in_out_elastic(ease_t)],
+		[InterpolationOps.EASE_IN_BOUNCE, InterpolationOps.ease_in_bounce(ease_t)],
+		[InterpolationOps.EASE_OUT_BOUNCE, InterpolationOps.ease_out_bounce(ease_t)],
+		[InterpolationOps.EASE_IN_OUT_BOUNCE, InterpolationOps.ease_in_out_bounce(ease_t)],
+		[InterpolationOps.EASE_SMOOTHSTEP, InterpolationOps.smoothstep(ease_t)],
+		[InterpolationOps.EASE_SMOOTHERSTEP, InterpolationOps.smootherstep(ease_t)],
+	]
+	assert(ease_curves.size() == InterpolationOps.EASE_SMOOTHERSTEP + 1, "Every ease type should be checked")
+	var ease_outside = PackedFloat32Array([-0.5, -1e9, 1.5, 1e9])
+	for curve in ease_curves:
+		var batch = InterpolationOps.ease_batch(curve[0], ease_t)
+		for i in range(ease_t.size()):
+			assert(abs(batch[i] - curve[1][i]) < 1e-5, "ease_batch type %d should match its function" % curve[0])
+		# t outside [0, 1] is clamped first
+		var clamped = InterpolationOps.ease_batch(curve[0], ease_outside)
+		for i in range(ease_outside.size()):
+			var edge = curve[1][0] if i < 2 else curve[1][ease_t.size() - 1]
+			assert(abs(clamped[i] - edge) < 1e-5, "ease_batch type %d should clamp t to [0, 1]" % curve[0])
+	print("ease_batch: ", ease_curves.size(), " curves, ", ease_simd.size(), " values each")
+
+	# Test arc-length spline: length of a straight line, constant-speed samples
+	var spline = Spline2D.new()
+	spline.set_points(PackedVector2Array([Vector2(0, 0), Vector2(50, 0), Vector2(100, 0)]))
+	assert(abs(spline.get_length() - 100.0) < 0.01, "Straight spline length should be 100")
+	var even = spline.sample_evenly(11)
+	for i in range(even.size()):
+		assert(abs(even[i].x - i * 10.0) < 0.05, "Samples should be evenly spaced by distance")
+	var curve = Spline2D.new()
+	curve.closed = true
+	curve.set_points(PackedVector2Array([Vector2(0, 0), Vector2(50, 0), Vector2(50, 50), Vector2(0, 50)]))
+	var loop = curve.sample_evenly(64)
+	var step = curve.get_length() / 64.0
+	for i in range(1, loop.size()):
+		assert(abs(loop[i].distance_to(loop[i - 1]) - step) < step * 0.02, "Closed spline should run at constant speed")
+	print("Spline2D: length ", curve.get_length(), " over ", curve.get_segment_count(), " segments")
+
+	print("\n=== Profiler ===")
+	# Test probe counters: only outermost calls count, frames roll on end_frame
+	if Profiler.is_available():
+		Profiler.reset()
+		Profiler.set_enabled(true, false)
+		var prof_points = PackedVector2Array([Vector2(0, 0), Vector2(5, 0), Vector2(100, 100)])
+		var prof_hash = SpatialHash2D.new()
+		prof_hash.cell_size = 10.0
+		prof_hash.build(prof_points)
+		prof_hash.query_radius_batch_uniform(prof_points, 10.0)
+		Profiler.end_frame()
+		Profiler.set_enabled(false)
+		var prof_stats = Profiler.get_stats()
+		assert(prof_stats["SpatialHash2D.build"]["calls"] == 1, "build should be counted once")
+		assert(prof_stats["SpatialHash2D.build"]["items"] == 3, "build should count its points")
+		assert(prof_stats["SpatialHash2D.query_radius_batch_uniform"]["frame_calls"] == 1, "Batch call should be in the frame")
+		assert(Profiler.get_frame_calls() == 2, "Nested query_radius calls should not add to the total")
+		prof_hash.build(prof_points)
+		assert(Profiler.get_stats()["SpatialHash2D.build"]["calls"] == 1, "Disabled profiler should not count")
+		# The broadphase paths return early but still record their output
+		Profiler.set_enabled(true, false)
+		var prof_pairs = CollisionOps.circles_self_collision_uniform(prof_points, 10.0, prof_hash)
+		Profiler.set_enabled(false)
+		assert(Profiler.get_stats()["CollisionOps.circles_self_collision_uniform"]["bytes"] == prof_pairs.size() * 4, "Hashed self-collision should record its pair bytes")
+		print("Profiler: ", Profiler.get_probe_names().size(), " probes, ", Profiler.get_frame_time_ms(), " ms")
+
+	print("\n=== KDTree2D ===")
+	# Test ties on a lattice resolve to the lowest index (points listed in reverse)
+	var lattice = PackedVector2Array()
+	for y in range(9, -1, -1):
+		for x in range(9, -1, -1):
+			lattice.append(Vector2(x, y))
+	var lattice_tree = KDTree2D.new()
+	lattice_tree.build(lattice)
+	# (4.5, 4.5) is equally far from (4, 4), (5, 4), (4, 5) and (5, 5): indices 55, 54, 45, 44
+	assert(lattice_tree.query_nearest_one(Vector2(4.5, 4.5)) == 44, "Tie should resolve to the lowest index")
+	assert(lattice_tree.query_nearest(Vector2(4.5, 4.5), 4) == PackedInt32Array([44, 45, 54, 55]), "Equal distances should be ordered by index")
+	assert(lattice_tree.query_nearest(Vector2(4.5, 4.5), 2) == PackedInt32Array([44, 45]), "K nearest should keep the lowest tied indices")
+	print("KDTree2D ties: ", lattice_tree.query_nearest(Vector2(4.5, 4.5), 4))
+
+	print("\n=== Snapshots ===")
+	# Test save/load round trips give the same query results without rebuilding
+	var snap_points = PackedVector2Array()
+	for i in range(200):
+		snap_points.append(Vector2(float((i * 37) % 500), float((i * 91) % 500)))
+	var snap_tree = KDTree2D.new()
+	snap_tree.build(snap_points)
+	var snap_data = snap_tree.save_snapshot()
+	var snap_loaded = KDTree2D.new()
+	assert(snap_loaded.load_snapshot(snap_data), "KDTree2D snapshot should load")
+	assert(snap_loaded.size() == 200, "Loaded tree should have every point")
+	assert(snap_loaded.query_nearest(Vector2(250, 250), 5) == snap_tree.query_nearest(Vector2(250, 250), 5), "Loaded tree should answer the same")
+	var snap_quad = QuadTree.new()
+	snap_quad.set_bounds(Rect2(0, 0, 500, 500))
+	snap_quad.build(snap_points)
+	snap_quad.remove(3)
+	var snap_quad_loaded = QuadTree.new()
+	assert(snap_quad_loaded.load_snapshot(snap_quad.save_snapshot()), "QuadTree snapshot should load")
+	assert(snap_quad_loaded.size() == 199, "Removed points should stay removed")
+	assert(snap_quad_loaded.query_rect(Rect2(0, 0, 250, 250)) == snap_quad.query_rect(Rect2(0, 0, 250, 250)), "Loaded quadtree should answer the same")
+	var snap_grid = PackedFloat32Array()
+	snap_grid.resize(64 * 64)
+	snap_grid.fill(1.0)
+	var snap_hpa = HierarchicalPathfinder.new()
+	snap_hpa.cluster_size = 16
+	snap_hpa.build(snap_grid, 64, 64)
+	var snap_hpa_loaded = HierarchicalPathfinder.new()
+	assert(snap_hpa_loaded.load_snapshot(snap_hpa.save_snapshot()), "HierarchicalPathfinder snapshot should load")
+	assert(snap_hpa_loaded.find_path(Vector2i(1, 1), Vector2i(60, 50)) == snap_hpa.find_path(Vector2i(1, 1), Vector2i(60, 50)), "Loaded graph should find the same path")
+	# Wrong class and damaged data are rejected, keeping the current state
+	assert(not snap_quad_loaded.load_snapshot(snap_data), "Snapshot from another class should be rejected")
+	assert(not snap_loaded.load_snapshot(snap_data.slice(0, snap_data.size() - 16)), "Truncated snapshot should be rejected")
+	assert(snap_loaded.size() == 200, "Failed load should keep the tree")
+	# Cycles in the tree links are rejected (single-precision layout: Node is a
+	# Rect2 then first_child, first_item, last_item, count, parent; Item is a
+	# Vector2 then index, next, prev, node)
+	var quad_data = snap_quad.save_snapshot()
+	var node_offset = 0
+	var node_size = 0
+	var node_count = 0
+	var item_offset = 0
+	var item_size = 0
+	for s in range(quad_data.decode_u32(12)):
+		var entry = 32 + 24 * s
+		if quad_data.decode_u32(entry) == 2:
+			node_size = quad_data.decode_u32(entry + 4)
+			node_offset = quad_data.decode_u64(entry + 8)
+			node_count = quad_data.decode_u64(entry + 16)
+		elif quad_data.decode_u32(entry) == 3:
+			item_size = quad_data.decode_u32(entry + 4)
+			item_offset = quad_data.decode_u64(entry + 8)
+	var cyclic_block = quad_data.duplicate()
+	var root_children = cyclic_block.decode_s32(node_offset + 16)
+	cyclic_block.encode_s32(node_offset + root_children * node_size + 16, root_children)
+	assert(not snap_quad_loaded.load_snapshot(cyclic_block), "Child block reached twice should be rejected")
+	var cyclic_items = quad_data.duplicate()
+	for n in range(node_count):
+		var node_at = node_offset + n * node_size
+		var first_item = cyclic_items.decode_s32(node_at + 20)
+		var last_item = cyclic_items.decode_s32(node_at + 24)
+		var is_leaf = cyclic_items.decode_s32(node_at + 16) == -1 and cyclic_items.decode_s32(node_at + 32) != -2
+		if is_leaf and first_item != last_item:
+			cyclic_items.encode_s32(item_offset + last_item * item_size + 12, first_item)
+			break
+	assert(not snap_quad_loaded.load_snapshot(cyclic_items), "Point list looping back should be rejected")
+	assert(snap_quad_loaded.size() == 199, "Rejected snapshots should keep the tree")
+	print("KDTree2D snapshot: ", snap_data.size(), " bytes")
+
 	print("\nAll tests passed!")
 	quit(0)
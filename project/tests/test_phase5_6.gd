@@ -15,6 +15,7 @@ func _init() -> void:
 	run_kdtree3d_tests()
 	run_quadtree_tests()
 	run_octree_tests()
+	run_dynamic_aabb_tree_tests()
 	run_interpolation_tests()
 	run_stat_tests()
 
@@ -68,6 +69,44 @@ func run_kdtree2d_tests() -> void:
 	check(in_radius.size() == 2, "Should find 2 items in radius 15")
 	pass_test()
 
+	# Test: large query_nearest_one_batch (multithreaded) keeps query order
+	current_test = "KDTree2D large batch order"
+	positions = PackedVector2Array()
+	var queries = PackedVector2Array()
+	for i in range(500):
+		positions.append(Vector2(i * 10.0, 0))
+		queries.append(Vector2((499 - i) * 10.0 + 1.0, 0))
+	kdtree.build(positions)
+
+	var targets = kdtree.query_nearest_one_batch(queries)
+	check(targets.size() == 500, "Should return one result per query")
+	var in_order = true
+	for i in range(500):
+		if targets[i] != 499 - i:
+			in_order = false
+	check(in_order, "Query i should find item 499 - i")
+	pass_test()
+
+	# Test: k nearest across many leaf buckets matches brute force
+	current_test = "KDTree2D query_nearest across leaves"
+	positions = PackedVector2Array()
+	for y in range(40):
+		for x in range(40):
+			positions.append(Vector2(x * 3.0 + y * 0.01, y * 3.0))
+	kdtree.build(positions)
+
+	var target = Vector2(61.3, 58.7)
+	var found = kdtree.query_nearest(target, 12)
+	var by_distance = []
+	for i in range(positions.size()):
+		by_distance.append([positions[i].distance_squared_to(target), i])
+	by_distance.sort()
+	check(found.size() == 12, "Should return 12 nearest")
+	for i in range(12):
+		check(found[i] == by_distance[i][1], "Neighbor %d should match brute force" % i)
+	check(kdtree.query_radius(target, 4.5).size() == by_distance.filter(func(d): return d[0] <= 4.5 * 4.5).size(), "Radius count should match brute force")
+	pass_test()
+
 	print("")
 
 
@@ -128,6 +167,42 @@ func run_quadtree_tests() -> void:
 	check(bounds.size() > 0, "Should have node bounds for visualization")
 	pass_test()
 
+	# Test: bulk build and one-by-one insert give the same tree
+	current_test = "QuadTree build matches insert"
+	var dense = PackedVector2Array()
+	for i in range(200):
+		dense.append(Vector2(fmod(i * 37.0, 1000.0), fmod(i * 91.0, 1000.0)))
+	var built = QuadTree.new()
+	built.set_bounds(Rect2(0, 0, 1000, 1000))
+	built.max_items_per_node = 4
+	built.build(dense)
+	var inserted = QuadTree.new()
+	inserted.set_bounds(Rect2(0, 0, 1000, 1000))
+	inserted.max_items_per_node = 4
+	for p in dense:
+		inserted.insert(p)
+	check(built.get_node_bounds().size() == inserted.get_node_bounds().size(), "Should have the same nodes")
+	var query = Rect2(100, 100, 500, 400)
+	check(built.query_rect(query) == inserted.query_rect(query), "Should return the same indices in the same order")
+	built.build(dense)
+	check(built.size() == 200, "Rebuild should keep every point")
+	pass_test()
+
+	# Test: update / remove without rebuilding
+	current_test = "QuadTree update and remove"
+	quadtree.build(positions)
+	quadtree.update(2, Vector2(150, 150))
+	check(quadtree.query_rect(Rect2(0, 0, 300, 300)).size() == 3, "Moved point should be found at its new position")
+	quadtree.remove(0)
+	check(quadtree.size() == 2, "Should have 2 items after remove")
+	check(not 0 in quadtree.query_rect(Rect2(0, 0, 300, 300)), "Removed point should not be found")
+	quadtree.update_many(PackedInt32Array([1, 2]), PackedVector2Array([Vector2(900, 900), Vector2(910, 910)]))
+	check(quadtree.query_rect(Rect2(850, 850, 100, 100)).size() == 2, "Batch-moved points should be found")
+	for i in range(200):
+		built.remove(i)
+	check(built.get_node_bounds().size() == 1, "Emptied tree should merge back to the root")
+	pass_test()
+
 	print("")
 
 
@@ -163,6 +238,53 @@ func run_octree_tests() -> void:
 	print("")
 
 
+func run_dynamic_aabb_tree_tests() -> void:
+	print("--- DynamicAABBTree Tests ---")
+
+	current_test = "DynamicAABBTree2D insert and query"
+	var tree = DynamicAABBTree2D.new()
+	var small = tree.insert(Rect2(0, 0, 10, 10))
+	var big = tree.insert(Rect2(50, 0, 200, 200))
+	var far = tree.insert(Rect2(1000, 1000, 5, 5))
+	check(tree.get_count() == 3, "Should have 3 proxies")
+	check(tree.query_point(Vector2(100, 100)) == PackedInt32Array([big]), "Point should only hit the big box")
+	check(tree.query_box(Rect2(5, 5, 50, 1)).size() == 2, "Box should overlap small and big")
+	pass_test()
+
+	current_test = "DynamicAABBTree2D move and remove"
+	check(not tree.move(small, Rect2(1, 1, 10, 10)), "Small move should stay inside the fat box")
+	check(tree.move(far, Rect2(100, 100, 5, 5)), "Large move should reinsert")
+	check(far in tree.query_point(Vector2(102, 102)), "Moved proxy should be found at its new box")
+	tree.remove(small)
+	check(tree.get_count() == 2, "Should have 2 proxies after remove")
+	check(tree.query_point(Vector2(5, 5)).size() == 0, "Removed proxy should not be found")
+	pass_test()
+
+	current_test = "DynamicAABBTree2D rays and pairs"
+	check(tree.ray_first(Vector2(0, 102), Vector2(1, 0), 500.0) == big, "Ray should hit the big box first")
+	check(tree.query_ray(Vector2(0, 102), Vector2(1, 0), 500.0).size() == 2, "Ray should pass through both boxes")
+	var first_hits = tree.ray_first_batch(PackedVector2Array([Vector2(0, 102), Vector2(0, -500)]),
+		PackedVector2Array([Vector2(1, 0), Vector2(1, 0)]), PackedFloat32Array([500.0, 500.0]))
+	check(first_hits[0] == PackedInt32Array([big, -1]), "Batch rays should match ray_first")
+	check(is_inf(first_hits[1][1]), "A ray that misses should report INF")
+	check(tree.query_pairs() == PackedInt32Array([min(big, far), max(big, far)]), "Overlapping boxes should form one pair")
+	var others = DynamicAABBTree2D.new()
+	var other = others.insert(Rect2(240, 0, 20, 20))
+	check(tree.query_pairs_with(others) == PackedInt32Array([big, other]), "Should pair across trees")
+	pass_test()
+
+	current_test = "DynamicAABBTree3D insert and query"
+	var tree3 = DynamicAABBTree3D.new()
+	var a = tree3.insert(AABB(Vector3.ZERO, Vector3(2, 2, 2)))
+	var b = tree3.insert(AABB(Vector3(1, 1, 1), Vector3(2, 2, 2)))
+	tree3.insert(AABB(Vector3(10, 10, 10), Vector3(1, 1, 1)))
+	check(tree3.query_pairs() == PackedInt32Array([a, b]), "First two boxes should overlap")
+	check(tree3.ray_first(Vector3(-5, 0.5, 0.5), Vector3(1, 0, 0), 100.0) == a, "Ray should hit the first box")
+	pass_test()
+
+	print("")
+
+
 func run_interpolation_tests() -> void:
 	print("--- InterpolationOps Tests ---")
 
@@ -295,6 +417,67 @@ func run_stat_tests() -> void:
 	check(outliers.size() > 0 and 9 in outliers, "Should detect index 9 (value 100) as outlier")
 	pass_test()
 
+	# Test: percentiles - one selection for several percentiles
+	current_test = "StatOps percentiles"
+	var unsorted = PackedFloat32Array([5.0, 1.0, 4.0, 2.0, 3.0])
+	var ps = StatOps.percentiles(unsorted, PackedFloat32Array([0.0, 25.0, 50.0, 87.5, 100.0]))
+	check(ps.size() == 5, "Should return 5 values")
+	check(abs(ps[0] - 1.0) < 0.001 and abs(ps[4] - 5.0) < 0.001, "0th / 100th should be min / max")
+	check(abs(ps[1] - 2.0) < 0.001 and abs(ps[2] - 3.0) < 0.001, "25th should be 2.0, 50th 3.0")
+	check(abs(ps[3] - 4.5) < 0.001, "87.5th should interpolate to 4.5")
+	pass_test()
+
+	# Test: describe - fused single pass
+	current_test = "StatOps describe"
+	var summary = StatOps.describe(values, StatOps.DESCRIBE_DEFAULT | StatOps.DESCRIBE_IN_RANGE, 2.0, 4.0)
+	check(summary["count"] == 5, "Count should be 5")
+	check(abs(summary["sum"] - 15.0) < 0.001, "Sum should be 15.0")
+	check(abs(summary["mean"] - 3.0) < 0.001, "Mean should be 3.0")
+	check(abs(summary["std_dev"] - StatOps.std_dev(values)) < 0.001, "Std dev should match std_dev()")
+	check(summary["min"] == 1.0 and summary["max"] == 5.0, "Min / max should be 1 / 5")
+	check(summary["in_range"] == 3, "3 values should be in [2, 4]")
+	check(not StatOps.describe(values, StatOps.DESCRIBE_MEAN).has("sum"), "Only requested keys")
+	pass_test()
+
+	# Test: describe_columns - interleaved rows
+	current_test = "StatOps describe_columns"
+	var rows = PackedFloat32Array([1.0, 10.0, 2.0, 20.0, 3.0, 30.0])
+	var columns = StatOps.describe_columns(rows, 2)
+	check(columns["count"] == 3, "Should have 3 rows")
+	check(abs(columns["mean"][0] - 2.0) < 0.001, "Column 0 mean should be 2")
+	check(abs(columns["mean"][1] - 20.0) < 0.001, "Column 1 mean should be 20")
+	check(columns["max"][1] == 30.0, "Column 1 max should be 30")
+	pass_test()
+
+	# Test: StreamingStats moments and exact percentiles while uncompressed
+	current_test = "StreamingStats push_batch"
+	var stream = StreamingStats.new()
+	stream.set_histogram(0.0, 5.0, 5)
+	stream.push_batch(unsorted)
+	check(stream.get_count() == 5, "Count should be 5")
+	check(abs(stream.get_mean() - 3.0) < 0.001, "Mean should be 3.0")
+	check(abs(stream.get_variance() - StatOps.variance(values)) < 0.001, "Variance should match StatOps")
+	check(abs(stream.get_median() - 3.0) < 0.001, "Median should be 3.0")
+	check(abs(stream.get_percentile(87.5) - 4.5) < 0.001, "Percentile should match StatOps")
+	var stream_hist = stream.get_histogram()
+	check(stream_hist.size() == 5 and stream_hist[4] == 2, "Values 4 and 5 should share the last bin")
+	pass_test()
+
+	# Test: StreamingStats merge
+	current_test = "StreamingStats merge"
+	var low = StreamingStats.new()
+	var high = StreamingStats.new()
+	for i in range(1000):
+		low.push(float(i))
+		high.push(float(i + 1000))
+	low.merge(high)
+	check(low.get_count() == 2000, "Merged count should be 2000")
+	check(abs(low.get_mean() - 999.5) < 0.01, "Merged mean should be 999.5")
+	check(low.get_min() == 0.0 and low.get_max() == 1999.0, "Merged min / max")
+	check(abs(low.get_percentile(90.0) - 1799.1) < 20.0, "p90 estimate should be near 1799")
+	check(low.get_centroid_count() <= 100, "Digest should stay within compression")
+	pass_test()
+
 	print("")
 
 
@@ -15,7 +15,10 @@ func _init() -> void:
 
 	run_spatial_hash_2d_tests()
 	run_spatial_hash_3d_tests()
+	run_spatial_grid_2d_tests()
+	run_spatial_grid_3d_tests()
 	run_array_ops_tests()
+	run_array_query_tests()
 
 	print("")
 	print("=" .repeat(60))
@@ -122,6 +125,46 @@ func run_spatial_hash_2d_tests() -> void:
 	check(spatial.count_in_radius(Vector2.ZERO, 10.0) == 2, "Should count 2 items in radius")
 	pass_test()
 
+	# Test: SpatialHash2D large batch (multithreaded) keeps query order
+	current_test = "SpatialHash2D large batch order"
+	spatial = SpatialHash2D.new()
+	positions = PackedVector2Array()
+	var origins = PackedVector2Array()
+	for i in range(500):
+		positions.append(Vector2(i * 4.0, 0))
+		origins.append(Vector2(i * 4.0, 0))
+	spatial.build(positions)
+
+	var batch = spatial.query_radius_batch_uniform(origins, 1.0)
+	check(batch.size() == 500, "Should return one result per origin")
+	var in_order = true
+	for i in range(500):
+		if batch[i].size() != 1 or batch[i][0] != i:
+			in_order = false
+	check(in_order, "Result i should contain only item i")
+	pass_test()
+
+	# Test: SpatialHash2D flat batch results match per-query results
+	current_test = "SpatialHash2D query_radius_batch_flat"
+	var neighbors = NeighborList.new()
+	var radii = PackedFloat32Array()
+	for i in range(500):
+		radii.append(float(i % 3) * 4.0 + 1.0)
+	var flat = spatial.query_radius_batch_flat(origins, radii, neighbors)
+	check(flat == neighbors, "Should fill the provided NeighborList")
+	check(neighbors.get_query_count() == 500, "Should store one entry per query")
+	var offsets = neighbors.get_offsets()
+	var indices = neighbors.get_indices()
+	check(offsets.size() == 501, "Offsets should have query_count + 1 entries")
+	check(offsets[500] == indices.size(), "Last offset should equal total count")
+	var flat_matches = true
+	for i in range(500):
+		var expected = spatial.query_radius(origins[i], radii[i])
+		if neighbors.get_neighbors(i) != expected:
+			flat_matches = false
+	check(flat_matches, "Flat results should match query_radius")
+	pass_test()
+
 	print("")
 
 
@@ -259,6 +302,142 @@ func run_spatial_hash_3d_tests() -> void:
 	print("")
 
 
+func run_spatial_grid_2d_tests() -> void:
+	print("--- SpatialGrid2D Tests ---")
+
+	# Test: SpatialGrid2D build and query
+	current_test = "SpatialGrid2D build and query"
+	var grid = SpatialGrid2D.new()
+	grid.cell_size = 50.0
+
+	var positions = PackedVector2Array([
+		Vector2(0, 0),
+		Vector2(100, 0),
+		Vector2(200, 0),
+		Vector2(30, 30),  # ~42.4 units from origin
+	])
+
+	grid.build(positions)
+	check(grid.get_count() == 4, "Should have 4 items")
+
+	var nearby = grid.query_radius(Vector2(0, 0), 60.0)
+	check(nearby.size() == 2, "Should find 2 items within radius 60 of origin")
+	check(0 in nearby, "Should include item at origin")
+	check(3 in nearby, "Should include item at (30, 30)")
+	check(grid.count_in_radius(Vector2.ZERO, 60.0) == 2, "Should count 2 items in radius")
+	check(grid.has_any_in_radius(Vector2(200, 0), 1.0), "Should find item at (200, 0)")
+	pass_test()
+
+	# Test: SpatialGrid2D query_rect
+	current_test = "SpatialGrid2D query_rect"
+	grid = SpatialGrid2D.new()
+	grid.build(PackedVector2Array([
+		Vector2(10, 10),
+		Vector2(90, 90),
+		Vector2(150, 150),
+	]))
+
+	var in_rect = grid.query_rect(Rect2(0, 0, 100, 100))
+	check(in_rect.size() == 2, "Should find 2 items in rect")
+	pass_test()
+
+	# Test: SpatialGrid2D query_nearest
+	current_test = "SpatialGrid2D query_nearest"
+	grid = SpatialGrid2D.new()
+	grid.cell_size = 10.0
+	grid.build(PackedVector2Array([
+		Vector2(100, 0),
+		Vector2(10, 0),
+		Vector2(50, 0),
+	]))
+
+	var nearest = grid.query_nearest(Vector2.ZERO, 2)
+	check(nearest.size() == 2, "Should return 2 nearest")
+	check(nearest[0] == 1, "Nearest should be index 1 (at 10,0)")
+	check(nearest[1] == 2, "Second nearest should be index 2 (at 50,0)")
+	check(grid.query_nearest_one(Vector2(90, 0)) == 0, "Nearest to (90,0) should be index 0")
+	pass_test()
+
+	# Test: SpatialGrid2D points outside bounds
+	current_test = "SpatialGrid2D points outside bounds"
+	grid = SpatialGrid2D.new()
+	grid.cell_size = 10.0
+	grid.bounds = Rect2(0, 0, 100, 100)
+	grid.build(PackedVector2Array([
+		Vector2(50, 50),
+		Vector2(-500, 50),
+	]))
+
+	nearby = grid.query_radius(Vector2(-495, 50), 10.0)
+	check(nearby.size() == 1 and nearby[0] == 1, "Should find clamped outlier")
+	check(grid.query_nearest_one(Vector2(-1000, 0)) == 1, "Nearest should be the outlier")
+	pass_test()
+
+	# Test: SpatialGrid2D rebuild
+	current_test = "SpatialGrid2D rebuild"
+	grid.build(PackedVector2Array([Vector2(1, 1)]))
+	check(grid.get_count() == 1, "Rebuild should replace previous items")
+	grid.clear()
+	check(grid.get_count() == 0, "Clear should remove all items")
+	check(grid.query_nearest_one(Vector2.ZERO) == -1, "Empty grid should return -1")
+	pass_test()
+
+	print("")
+
+
+func run_spatial_grid_3d_tests() -> void:
+	print("--- SpatialGrid3D Tests ---")
+
+	# Test: SpatialGrid3D build and query
+	current_test = "SpatialGrid3D build and query"
+	var grid = SpatialGrid3D.new()
+	grid.cell_size = 50.0
+
+	var positions = PackedVector3Array([
+		Vector3(0, 0, 0),
+		Vector3(100, 0, 0),
+		Vector3(0, 0, 30),
+		Vector3(0, 0, 100),
+	])
+
+	grid.build(positions)
+	check(grid.get_count() == 4, "Should have 4 items")
+
+	var nearby = grid.query_radius(Vector3.ZERO, 50.0)
+	check(nearby.size() == 2, "Should find 2 items within radius 50")
+	check(0 in nearby, "Should include item at origin")
+	check(2 in nearby, "Should include item at (0,0,30)")
+	pass_test()
+
+	# Test: SpatialGrid3D query_box
+	current_test = "SpatialGrid3D query_box"
+	grid.build(PackedVector3Array([
+		Vector3(10, 10, 10),
+		Vector3(90, 90, 90),
+		Vector3(150, 150, 150),
+	]))
+
+	var in_box = grid.query_box(AABB(Vector3.ZERO, Vector3(100, 100, 100)))
+	check(in_box.size() == 2, "Should find 2 items in box")
+	pass_test()
+
+	# Test: SpatialGrid3D query_nearest
+	current_test = "SpatialGrid3D query_nearest"
+	grid.build(PackedVector3Array([
+		Vector3(100, 0, 0),
+		Vector3(10, 0, 0),
+		Vector3(50, 0, 0),
+	]))
+
+	var nearest = grid.query_nearest(Vector3.ZERO, 2)
+	check(nearest.size() == 2, "Should return 2 nearest")
+	check(nearest[0] == 1, "Nearest should be index 1 (at 10,0,0)")
+	check(nearest[1] == 2, "Second nearest should be index 2 (at 50,0,0)")
+	pass_test()
+
+	print("")
+
+
 func run_array_ops_tests() -> void:
 	print("--- ArrayOps Tests ---")
 
@@ -316,6 +495,30 @@ func run_array_ops_tests() -> void:
 	check(indices[2] == 2, "Third index should be 2 (value 4.0)")
 	pass_test()
 
+	# Test: argsort_floats is stable, also through the radix path
+	current_test = "ArrayOps argsort_floats stable"
+	values = PackedFloat32Array()
+	for i in range(3000):
+		values.append(float((i * 7) % 5) - 2.0)
+	indices = ArrayOps.argsort_floats(values)
+	var stable = indices.size() == 3000
+	for i in range(1, indices.size()):
+		var a = values[indices[i - 1]]
+		var b = values[indices[i]]
+		if a > b or (a == b and indices[i - 1] > indices[i]):
+			stable = false
+	check(stable, "Should be sorted with equal values in index order")
+	check(ArrayOps.sort_floats(values, true)[0] == 2.0, "Descending should start with the max")
+	pass_test()
+
+	# Test: argtop_k_floats matches the head of argsort
+	current_test = "ArrayOps argtop_k_floats"
+	var top = ArrayOps.argtop_k_floats(values, 5)
+	check(top == ArrayOps.argsort_floats(values, true).slice(0, 5), "Should equal descending argsort head")
+	check(ArrayOps.top_k_floats(PackedFloat32Array([3.0, 9.0, 1.0, 7.0]), 2) == PackedFloat32Array([9.0, 7.0]), "Top 2 should be 9, 7")
+	check(ArrayOps.argtop_k_floats(values, 0).size() == 0, "k = 0 should be empty")
+	pass_test()
+
 	# Test: argsort_by_distance
 	current_test = "ArrayOps argsort_by_distance"
 	positions = PackedVector2Array([
@@ -329,6 +532,14 @@ func run_array_ops_tests() -> void:
 	check(indices[2] == 0, "Farthest should be index 0")
 	pass_test()
 
+	# Test: k_nearest_to_point
+	current_test = "ArrayOps k_nearest_to_point"
+	indices = ArrayOps.k_nearest_to_point(positions, Vector2.ZERO, 2)
+	check(indices.size() == 2, "Should keep 2 indices")
+	check(indices[0] == 1 and indices[1] == 2, "Should be the 2 nearest, nearest first")
+	check(ArrayOps.k_nearest_to_point(positions, Vector2.ZERO, 1, true)[0] == 0, "Farthest should be index 0")
+	pass_test()
+
 	# Test: sum_floats
 	current_test = "ArrayOps sum_floats"
 	values = PackedFloat32Array([1.0, 2.0, 3.0, 4.0])
@@ -392,6 +603,66 @@ func run_array_ops_tests() -> void:
 	print("")
 
 
+func run_array_query_tests() -> void:
+	print("\n--- ArrayQuery Tests ---")
+
+	var health := PackedFloat32Array([50.0, 0.0, 80.0, 30.0, 90.0])
+	var teams := PackedInt32Array([1, 1, 2, 1, 1])
+	var positions := PackedVector2Array([
+		Vector2(10, 0), Vector2(5, 0), Vector2(20, 0), Vector2(300, 0), Vector2(40, 0),
+	])
+
+	# Test: chained filters match the chained ArrayOps result
+	current_test = "ArrayQuery chained filters"
+	var query := ArrayQuery.new()
+	var hp := query.add_floats(health)
+	var team := query.add_ints(teams)
+	var pos := query.add_vector2(positions)
+	var dist := query.map_distance(pos, Vector2.ZERO)
+	query.filter_gt(hp, 0.0).filter_eq(team, 1).filter_lte(dist, 100.0)
+	check(query.get_indices() == PackedInt32Array([0, 4]), "Rows 0 and 4 should pass")
+	check(query.count() == 2, "Count should be 2")
+	check(query.select_floats(hp) == PackedFloat32Array([50.0, 90.0]), "Should select passing health")
+	check(is_equal_approx(query.sum(hp), 140.0), "Sum should be 140")
+	check(query.argmin(dist) == 0, "Nearest passing row should be 0")
+	check(query.argmax(hp) == 4, "Healthiest passing row should be 4")
+	pass_test()
+
+	# Test: set_indices restricts and orders the rows
+	current_test = "ArrayQuery set_indices"
+	query.clear_filters()
+	query.set_indices(PackedInt32Array([4, 3, 1, 99])).filter_gt(hp, 0.0)
+	check(query.get_indices() == PackedInt32Array([4, 3]), "Should keep the index order and skip row 99")
+	pass_test()
+
+	# Test: no survivors
+	current_test = "ArrayQuery empty result"
+	query.clear_filters()
+	query.filter_gt(hp, 1000.0)
+	check(query.count() == 0, "Nothing should pass")
+	check(query.argmin(hp) == -1, "argmin should be -1")
+	check(query.sum(hp) == 0.0, "Sum should be 0")
+	pass_test()
+
+	# Test: sums over many parallel blocks match a serial sum
+	current_test = "ArrayQuery large sum"
+	var values := PackedFloat32Array()
+	values.resize(100000)
+	var expected := 0.0
+	var magnitude := 0.0
+	for i in values.size():
+		values[i] = (1.0e6 if i % 7 == 0 else 1.0e-3 * (i % 13)) * (1.0 if i % 3 == 0 else -1.0)
+		expected += values[i]
+		magnitude += absf(values[i])
+	var big_query := ArrayQuery.new()
+	var big := big_query.add_floats(values)
+	var tolerance := magnitude * 1.0e-12
+	check(absf(big_query.sum(big) - expected) <= tolerance, "Sum should match the serial sum")
+	check(absf(big_query.mean(big) - expected / values.size()) <= tolerance / values.size(), "Mean should match the serial mean")
+	check(big_query.sum(big) == big_query.sum(big), "Repeated sums should be identical")
+	pass_test()
+
+
 func check(condition: bool, message: String) -> void:
 	if not condition:
 		print("  ✗ %s - FAILED: %s" % [current_test, message])
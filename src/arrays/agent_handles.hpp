@@ -0,0 +1,106 @@
+/**
+ * AgentHandles - Stable handles over a densely packed array, shared by
+ * AgentStore2D and AgentStore3D
+ *
+ * Agents live at dense indices 0..count-1, so every column stays a packed
+ * array that batch methods can read directly. Removing an agent moves the
+ * last agent into its index (swap-remove), which changes that agent's index
+ * but not its handle.
+ *
+ * A handle is (generation << 32) | slot. Each slot maps to the current dense
+ * index of its agent; removing the agent frees the slot and bumps its
+ * generation, so handles to removed agents are rejected even after the slot
+ * is reused.
+ *
+ * Usage (internal):
+ *   AgentHandles handles;
+ *   int64_t h = handles.add();          // New agent at index handles.size() - 1
+ *   int32_t i = handles.index_of(h);    // -1 if h was removed
+ *   int32_t moved_from = handles.remove_at(i);  // Caller moves column entries
+ */
+
+#ifndef AGENTITE_AGENT_HANDLES_HPP
+#define AGENTITE_AGENT_HANDLES_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class AgentHandles {
+public:
+    int32_t size() const { return static_cast<int32_t>(dense_slot.size()); }
+
+    // Add an agent at the end of the dense range and return its handle
+    int64_t add() {
+        int32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            slot = static_cast<int32_t>(slot_index.size());
+            slot_index.push_back(-1);
+            slot_generation.push_back(1);
+        }
+        slot_index[slot] = size();
+        dense_slot.push_back(slot);
+        return make_handle(slot);
+    }
+
+    // Dense index of a handle, or -1 if it is not a live agent
+    int32_t index_of(int64_t handle) const {
+        int64_t slot = handle & 0xFFFFFFFF;
+        uint32_t generation = static_cast<uint32_t>(static_cast<uint64_t>(handle) >> 32);
+        if (handle < 0 || slot >= static_cast<int64_t>(slot_index.size()) ||
+            slot_generation[slot] != generation) {
+            return -1;
+        }
+        return slot_index[slot];
+    }
+
+    int64_t handle_at(int32_t index) const {
+        return make_handle(dense_slot[index]);
+    }
+
+    // Remove the agent at index. The last agent moves into index; returns the
+    // index it moved from (equal to index when the removed agent was last).
+    int32_t remove_at(int32_t index) {
+        int32_t last = size() - 1;
+        int32_t slot = dense_slot[index];
+        dense_slot[index] = dense_slot[last];
+        slot_index[dense_slot[index]] = index;
+        dense_slot.pop_back();
+        release(slot);
+        return last;
+    }
+
+    // Remove every agent; all current handles become invalid
+    void clear() {
+        for (int32_t slot : dense_slot) {
+            release(slot);
+        }
+        dense_slot.clear();
+    }
+
+private:
+    std::vector<int32_t> slot_index;        // Dense index per slot, -1 when free
+    std::vector<uint32_t> slot_generation;  // Never 0, so a live handle is never 0
+    std::vector<int32_t> free_slots;
+    std::vector<int32_t> dense_slot;        // Slot of each dense index
+
+    int64_t make_handle(int32_t slot) const {
+        return static_cast<int64_t>((static_cast<uint64_t>(slot_generation[slot]) << 32) |
+                                    static_cast<uint32_t>(slot));
+    }
+
+    void release(int32_t slot) {
+        slot_index[slot] = -1;
+        // Stay below 2^31 so handles remain positive
+        slot_generation[slot] = slot_generation[slot] >= 0x7FFFFFFFu ? 1 : slot_generation[slot] + 1;
+        free_slots.push_back(slot);
+    }
+};
+
+}
+
+#endif // AGENTITE_AGENT_HANDLES_HPP
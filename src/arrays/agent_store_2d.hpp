@@ -0,0 +1,121 @@
+/**
+ * AgentStore2D - Persistent structure-of-arrays agent storage
+ *
+ * Owns one packed column per agent attribute: positions, velocities, radii
+ * and flags. Agents are kept densely packed at indices 0..count-1 and are
+ * addressed from script by stable handles; remove() swaps the last agent
+ * into the freed index, so indices change but handles stay valid.
+ *
+ * SpatialHash2D / SpatialGrid2D (build_from_store), BatchOps (*_store_2d)
+ * and CollisionOps (circles_self_collision_store) read the columns in place,
+ * so one store can feed every subsystem each frame without copying the
+ * arrays through script. Results that refer to agents are dense indices;
+ * use get_handle() to turn an index into a handle.
+ *
+ * Usage:
+ *   var store = AgentStore2D.new()
+ *   var id = store.add(Vector2(100, 100), Vector2(10, 0), 8.0)
+ *
+ *   # Every frame
+ *   BatchOps.limit_velocity_store_2d(store, max_speed)
+ *   BatchOps.apply_velocities_store_2d(store, delta)
+ *   spatial.build_from_store(store)
+ *   var pairs = CollisionOps.circles_self_collision_store(store, spatial)
+ */
+
+#ifndef AGENTITE_AGENT_STORE_2D_HPP
+#define AGENTITE_AGENT_STORE_2D_HPP
+
+#include "agent_handles.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class AgentStore2D : public RefCounted {
+    GDCLASS(AgentStore2D, RefCounted)
+
+private:
+    AgentHandles handles;
+    PackedVector2Array positions;
+    PackedVector2Array velocities;
+    PackedFloat32Array radii;
+    PackedInt32Array flags;
+
+    // Dense index of a handle; reports an error for removed handles
+    int32_t checked_index(int64_t handle, const char* method) const;
+    bool check_column_size(int64_t size, const char* method) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    AgentStore2D();
+    ~AgentStore2D();
+
+    // ========== AGENTS ==========
+
+    // Add one agent and return its handle
+    int64_t add(const Vector2& position, const Vector2& velocity, float radius, int32_t agent_flags);
+    // Add one agent per position; optional columns may be empty (zero) or match in size
+    PackedInt64Array add_batch(const PackedVector2Array& new_positions,
+                               const PackedVector2Array& new_velocities,
+                               const PackedFloat32Array& new_radii,
+                               const PackedInt32Array& new_flags);
+    // Swap-remove an agent; returns false for unknown handles
+    bool remove(int64_t handle);
+    void clear();
+
+    bool has(int64_t handle) const;
+    // Dense index of a handle, or -1
+    int32_t index_of(int64_t handle) const;
+    // Handle of the agent at a dense index, or -1
+    int64_t get_handle(int32_t index) const;
+    // Handles in dense order
+    PackedInt64Array get_handles() const;
+    int32_t get_count() const;
+
+    // ========== PER AGENT ==========
+
+    Vector2 get_position(int64_t handle) const;
+    void set_position(int64_t handle, const Vector2& value);
+    Vector2 get_velocity(int64_t handle) const;
+    void set_velocity(int64_t handle, const Vector2& value);
+    float get_radius(int64_t handle) const;
+    void set_radius(int64_t handle, float value);
+    int32_t get_agent_flags(int64_t handle) const;
+    void set_agent_flags(int64_t handle, int32_t value);
+
+    // ========== COLUMNS ==========
+
+    // Columns in dense order, as copy-on-write shares
+    PackedVector2Array get_positions() const;
+    PackedVector2Array get_velocities() const;
+    PackedFloat32Array get_radii() const;
+    PackedInt32Array get_flags() const;
+
+    // Overwrite a whole column; sizes must match get_count()
+    void set_positions(const PackedVector2Array& values);
+    void set_velocities(const PackedVector2Array& values);
+    void set_radii(const PackedFloat32Array& values);
+    void set_flags(const PackedInt32Array& values);
+
+    // Dense indices of agents whose flags contain every bit of mask
+    PackedInt32Array find_flags(int32_t mask) const;
+
+    // C++ API: the columns, for methods reading or updating the store in place
+    PackedVector2Array& position_column() { return positions; }
+    PackedVector2Array& velocity_column() { return velocities; }
+    PackedFloat32Array& radius_column() { return radii; }
+    PackedInt32Array& flag_column() { return flags; }
+};
+
+}
+
+#endif // AGENTITE_AGENT_STORE_2D_HPP
@@ -0,0 +1,286 @@
+/**
+ * AgentStore3D Implementation
+ */
+
+#include "agent_store_3d.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot {
+
+void AgentStore3D::_bind_methods() {
+    // Agents
+    ClassDB::bind_method(D_METHOD("add", "position", "velocity", "radius", "flags"),
+                         &AgentStore3D::add, DEFVAL(Vector3()), DEFVAL(0.0f), DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("add_batch", "positions", "velocities", "radii", "flags"),
+                         &AgentStore3D::add_batch, DEFVAL(PackedVector3Array()),
+                         DEFVAL(PackedFloat32Array()), DEFVAL(PackedInt32Array()));
+    ClassDB::bind_method(D_METHOD("remove", "handle"), &AgentStore3D::remove);
+    ClassDB::bind_method(D_METHOD("clear"), &AgentStore3D::clear);
+    ClassDB::bind_method(D_METHOD("has", "handle"), &AgentStore3D::has);
+    ClassDB::bind_method(D_METHOD("index_of", "handle"), &AgentStore3D::index_of);
+    ClassDB::bind_method(D_METHOD("get_handle", "index"), &AgentStore3D::get_handle);
+    ClassDB::bind_method(D_METHOD("get_handles"), &AgentStore3D::get_handles);
+    ClassDB::bind_method(D_METHOD("get_count"), &AgentStore3D::get_count);
+
+    // Per agent
+    ClassDB::bind_method(D_METHOD("get_position", "handle"), &AgentStore3D::get_position);
+    ClassDB::bind_method(D_METHOD("set_position", "handle", "value"), &AgentStore3D::set_position);
+    ClassDB::bind_method(D_METHOD("get_velocity", "handle"), &AgentStore3D::get_velocity);
+    ClassDB::bind_method(D_METHOD("set_velocity", "handle", "value"), &AgentStore3D::set_velocity);
+    ClassDB::bind_method(D_METHOD("get_radius", "handle"), &AgentStore3D::get_radius);
+    ClassDB::bind_method(D_METHOD("set_radius", "handle", "value"), &AgentStore3D::set_radius);
+    ClassDB::bind_method(D_METHOD("get_agent_flags", "handle"), &AgentStore3D::get_agent_flags);
+    ClassDB::bind_method(D_METHOD("set_agent_flags", "handle", "value"), &AgentStore3D::set_agent_flags);
+
+    // Columns
+    ClassDB::bind_method(D_METHOD("get_positions"), &AgentStore3D::get_positions);
+    ClassDB::bind_method(D_METHOD("get_velocities"), &AgentStore3D::get_velocities);
+    ClassDB::bind_method(D_METHOD("get_radii"), &AgentStore3D::get_radii);
+    ClassDB::bind_method(D_METHOD("get_flags"), &AgentStore3D::get_flags);
+    ClassDB::bind_method(D_METHOD("set_positions", "values"), &AgentStore3D::set_positions);
+    ClassDB::bind_method(D_METHOD("set_velocities", "values"), &AgentStore3D::set_velocities);
+    ClassDB::bind_method(D_METHOD("set_radii", "values"), &AgentStore3D::set_radii);
+    ClassDB::bind_method(D_METHOD("set_flags", "values"), &AgentStore3D::set_flags);
+    ClassDB::bind_method(D_METHOD("find_flags", "mask"), &AgentStore3D::find_flags);
+}
+
+AgentStore3D::AgentStore3D() {
+}
+
+AgentStore3D::~AgentStore3D() {
+}
+
+int32_t AgentStore3D::checked_index(int64_t handle, const char* method) const {
+    int32_t index = handles.index_of(handle);
+    if (index < 0) {
+        UtilityFunctions::push_error(String("AgentiteG: AgentStore3D.") + method + " got an invalid handle");
+    }
+    return index;
+}
+
+bool AgentStore3D::check_column_size(int64_t size, const char* method) const {
+    if (size != handles.size()) {
+        UtilityFunctions::push_error(String("AgentiteG: AgentStore3D.") + method + " size must match get_count()");
+        return false;
+    }
+    return true;
+}
+
+// ========== AGENTS ==========
+
+int64_t AgentStore3D::add(const Vector3& position, const Vector3& velocity, float radius, int32_t agent_flags) {
+    int64_t handle = handles.add();
+    positions.push_back(position);
+    velocities.push_back(velocity);
+    radii.push_back(radius);
+    flags.push_back(agent_flags);
+    return handle;
+}
+
+PackedInt64Array AgentStore3D::add_batch(const PackedVector3Array& new_positions,
+                                         const PackedVector3Array& new_velocities,
+                                         const PackedFloat32Array& new_radii,
+                                         const PackedInt32Array& new_flags) {
+    PackedInt64Array result;
+    int64_t count = new_positions.size();
+    if ((!new_velocities.is_empty() && new_velocities.size() != count) ||
+        (!new_radii.is_empty() && new_radii.size() != count) ||
+        (!new_flags.is_empty() && new_flags.size() != count)) {
+        UtilityFunctions::push_error("AgentiteG: AgentStore3D.add_batch columns must be empty or match positions in size");
+        return result;
+    }
+    if (count == 0) {
+        return result;
+    }
+
+    int64_t start = handles.size();
+    positions.resize(start + count);
+    velocities.resize(start + count);
+    radii.resize(start + count);
+    flags.resize(start + count);
+    result.resize(count);
+
+    Vector3* pos = positions.ptrw() + start;
+    Vector3* vel = velocities.ptrw() + start;
+    float* rad = radii.ptrw() + start;
+    int32_t* flg = flags.ptrw() + start;
+    int64_t* out = result.ptrw();
+    const Vector3* src_pos = new_positions.ptr();
+    const Vector3* src_vel = new_velocities.is_empty() ? nullptr : new_velocities.ptr();
+    const float* src_rad = new_radii.is_empty() ? nullptr : new_radii.ptr();
+    const int32_t* src_flg = new_flags.is_empty() ? nullptr : new_flags.ptr();
+
+    for (int64_t i = 0; i < count; i++) {
+        out[i] = handles.add();
+        pos[i] = src_pos[i];
+        vel[i] = src_vel ? src_vel[i] : Vector3();
+        rad[i] = src_rad ? src_rad[i] : 0.0f;
+        flg[i] = src_flg ? src_flg[i] : 0;
+    }
+    return result;
+}
+
+bool AgentStore3D::remove(int64_t handle) {
+    int32_t index = handles.index_of(handle);
+    if (index < 0) {
+        return false;
+    }
+    int32_t last = handles.remove_at(index);
+    if (last != index) {
+        positions.set(index, positions[last]);
+        velocities.set(index, velocities[last]);
+        radii.set(index, radii[last]);
+        flags.set(index, flags[last]);
+    }
+    positions.resize(last);
+    velocities.resize(last);
+    radii.resize(last);
+    flags.resize(last);
+    return true;
+}
+
+void AgentStore3D::clear() {
+    handles.clear();
+    positions.resize(0);
+    velocities.resize(0);
+    radii.resize(0);
+    flags.resize(0);
+}
+
+bool AgentStore3D::has(int64_t handle) const {
+    return handles.index_of(handle) >= 0;
+}
+
+int32_t AgentStore3D::index_of(int64_t handle) const {
+    return handles.index_of(handle);
+}
+
+int64_t AgentStore3D::get_handle(int32_t index) const {
+    if (index < 0 || index >= handles.size()) {
+        return -1;
+    }
+    return handles.handle_at(index);
+}
+
+PackedInt64Array AgentStore3D::get_handles() const {
+    PackedInt64Array result;
+    int32_t count = handles.size();
+    result.resize(count);
+    int64_t* out = result.ptrw();
+    for (int32_t i = 0; i < count; i++) {
+        out[i] = handles.handle_at(i);
+    }
+    return result;
+}
+
+int32_t AgentStore3D::get_count() const {
+    return handles.size();
+}
+
+// ========== PER AGENT ==========
+
+Vector3 AgentStore3D::get_position(int64_t handle) const {
+    int32_t index = checked_index(handle, "get_position");
+    return index < 0 ? Vector3() : positions[index];
+}
+
+void AgentStore3D::set_position(int64_t handle, const Vector3& value) {
+    int32_t index = checked_index(handle, "set_position");
+    if (index >= 0) {
+        positions.set(index, value);
+    }
+}
+
+Vector3 AgentStore3D::get_velocity(int64_t handle) const {
+    int32_t index = checked_index(handle, "get_velocity");
+    return index < 0 ? Vector3() : velocities[index];
+}
+
+void AgentStore3D::set_velocity(int64_t handle, const Vector3& value) {
+    int32_t index = checked_index(handle, "set_velocity");
+    if (index >= 0) {
+        velocities.set(index, value);
+    }
+}
+
+float AgentStore3D::get_radius(int64_t handle) const {
+    int32_t index = checked_index(handle, "get_radius");
+    return index < 0 ? 0.0f : radii[index];
+}
+
+void AgentStore3D::set_radius(int64_t handle, float value) {
+    int32_t index = checked_index(handle, "set_radius");
+    if (index >= 0) {
+        radii.set(index, value);
+    }
+}
+
+int32_t AgentStore3D::get_agent_flags(int64_t handle) const {
+    int32_t index = checked_index(handle, "get_agent_flags");
+    return index < 0 ? 0 : flags[index];
+}
+
+void AgentStore3D::set_agent_flags(int64_t handle, int32_t value) {
+    int32_t index = checked_index(handle, "set_agent_flags");
+    if (index >= 0) {
+        flags.set(index, value);
+    }
+}
+
+// ========== COLUMNS ==========
+
+PackedVector3Array AgentStore3D::get_positions() const {
+    return positions;
+}
+
+PackedVector3Array AgentStore3D::get_velocities() const {
+    return velocities;
+}
+
+PackedFloat32Array AgentStore3D::get_radii() const {
+    return radii;
+}
+
+PackedInt32Array AgentStore3D::get_flags() const {
+    return flags;
+}
+
+void AgentStore3D::set_positions(const PackedVector3Array& values) {
+    if (check_column_size(values.size(), "set_positions")) {
+        positions = values;
+    }
+}
+
+void AgentStore3D::set_velocities(const PackedVector3Array& values) {
+    if (check_column_size(values.size(), "set_velocities")) {
+        velocities = values;
+    }
+}
+
+void AgentStore3D::set_radii(const PackedFloat32Array& values) {
+    if (check_column_size(values.size(), "set_radii")) {
+        radii = values;
+    }
+}
+
+void AgentStore3D::set_flags(const PackedInt32Array& values) {
+    if (check_column_size(values.size(), "set_flags")) {
+        flags = values;
+    }
+}
+
+PackedInt32Array AgentStore3D::find_flags(int32_t mask) const {
+    PackedInt32Array result;
+    int32_t count = handles.size();
+    const int32_t* flg = flags.ptr();
+    for (int32_t i = 0; i < count; i++) {
+        if ((flg[i] & mask) == mask) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+}
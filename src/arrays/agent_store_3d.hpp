@@ -0,0 +1,110 @@
+/**
+ * AgentStore3D - Persistent structure-of-arrays agent storage (3D)
+ *
+ * The 3D counterpart of AgentStore2D: packed position, velocity, radius and
+ * flag columns addressed by stable handles, read in place by SpatialHash3D /
+ * SpatialGrid3D (build_from_store), BatchOps (*_store_3d) and CollisionOps
+ * (spheres_self_collision_store).
+ *
+ * Usage:
+ *   var store = AgentStore3D.new()
+ *   var id = store.add(Vector3(0, 10, 0), Vector3(5, 0, 0), 1.0)
+ *   spatial.build_from_store(store)
+ */
+
+#ifndef AGENTITE_AGENT_STORE_3D_HPP
+#define AGENTITE_AGENT_STORE_3D_HPP
+
+#include "agent_handles.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class AgentStore3D : public RefCounted {
+    GDCLASS(AgentStore3D, RefCounted)
+
+private:
+    AgentHandles handles;
+    PackedVector3Array positions;
+    PackedVector3Array velocities;
+    PackedFloat32Array radii;
+    PackedInt32Array flags;
+
+    // Dense index of a handle; reports an error for removed handles
+    int32_t checked_index(int64_t handle, const char* method) const;
+    bool check_column_size(int64_t size, const char* method) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    AgentStore3D();
+    ~AgentStore3D();
+
+    // ========== AGENTS ==========
+
+    // Add one agent and return its handle
+    int64_t add(const Vector3& position, const Vector3& velocity, float radius, int32_t agent_flags);
+    // Add one agent per position; optional columns may be empty (zero) or match in size
+    PackedInt64Array add_batch(const PackedVector3Array& new_positions,
+                               const PackedVector3Array& new_velocities,
+                               const PackedFloat32Array& new_radii,
+                               const PackedInt32Array& new_flags);
+    // Swap-remove an agent; returns false for unknown handles
+    bool remove(int64_t handle);
+    void clear();
+
+    bool has(int64_t handle) const;
+    // Dense index of a handle, or -1
+    int32_t index_of(int64_t handle) const;
+    // Handle of the agent at a dense index, or -1
+    int64_t get_handle(int32_t index) const;
+    // Handles in dense order
+    PackedInt64Array get_handles() const;
+    int32_t get_count() const;
+
+    // ========== PER AGENT ==========
+
+    Vector3 get_position(int64_t handle) const;
+    void set_position(int64_t handle, const Vector3& value);
+    Vector3 get_velocity(int64_t handle) const;
+    void set_velocity(int64_t handle, const Vector3& value);
+    float get_radius(int64_t handle) const;
+    void set_radius(int64_t handle, float value);
+    int32_t get_agent_flags(int64_t handle) const;
+    void set_agent_flags(int64_t handle, int32_t value);
+
+    // ========== COLUMNS ==========
+
+    // Columns in dense order, as copy-on-write shares
+    PackedVector3Array get_positions() const;
+    PackedVector3Array get_velocities() const;
+    PackedFloat32Array get_radii() const;
+    PackedInt32Array get_flags() const;
+
+    // Overwrite a whole column; sizes must match get_count()
+    void set_positions(const PackedVector3Array& values);
+    void set_velocities(const PackedVector3Array& values);
+    void set_radii(const PackedFloat32Array& values);
+    void set_flags(const PackedInt32Array& values);
+
+    // Dense indices of agents whose flags contain every bit of mask
+    PackedInt32Array find_flags(int32_t mask) const;
+
+    // C++ API: the columns, for methods reading or updating the store in place
+    PackedVector3Array& position_column() { return positions; }
+    PackedVector3Array& velocity_column() { return velocities; }
+    PackedFloat32Array& radius_column() { return radii; }
+    PackedInt32Array& flag_column() { return flags; }
+};
+
+}
+
+#endif // AGENTITE_AGENT_STORE_3D_HPP
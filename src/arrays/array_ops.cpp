@@ -3,6 +3,8 @@
  */
 
 #include "array_ops.hpp"
+#include "radix_sort.hpp"
+#include "core/parallel.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 
@@ -11,6 +13,7 @@
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <vector>
 
 namespace godot {
 
@@ -49,6 +52,14 @@ void ArrayOps::_bind_methods() {
     ClassDB::bind_static_method("ArrayOps", D_METHOD("reorder_vector2", "values", "indices"), &ArrayOps::reorder_vector2);
     ClassDB::bind_static_method("ArrayOps", D_METHOD("reorder_vector3", "values", "indices"), &ArrayOps::reorder_vector3);
 
+    // Top-k operations
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("top_k_floats", "values", "k", "largest"), &ArrayOps::top_k_floats, DEFVAL(true));
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("top_k_ints", "values", "k", "largest"), &ArrayOps::top_k_ints, DEFVAL(true));
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("argtop_k_floats", "values", "k", "largest"), &ArrayOps::argtop_k_floats, DEFVAL(true));
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("argtop_k_ints", "values", "k", "largest"), &ArrayOps::argtop_k_ints, DEFVAL(true));
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("k_nearest_to_point", "positions", "point", "k", "farthest"), &ArrayOps::k_nearest_to_point, DEFVAL(false));
+    ClassDB::bind_static_method("ArrayOps", D_METHOD("k_nearest_to_point_3d", "positions", "point", "k", "farthest"), &ArrayOps::k_nearest_to_point_3d, DEFVAL(false));
+
     // Reduce operations
     ClassDB::bind_static_method("ArrayOps", D_METHOD("sum_floats", "values"), &ArrayOps::sum_floats);
     ClassDB::bind_static_method("ArrayOps", D_METHOD("sum_ints", "values"), &ArrayOps::sum_ints);
@@ -281,15 +292,18 @@ PackedFloat32Array ArrayOps::sort_floats(const PackedFloat32Array& values, bool
     PackedFloat32Array result;
     result.resize(size);
 
-    // Copy data
+    // Radix sort on order-preserving keys; descending flips the keys
     const float* src = values.ptr();
-    float* dst = result.ptrw();
-    memcpy(dst, src, size * sizeof(float));
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
+    std::vector<uint32_t> keys(size);
+    for (int i = 0; i < size; i++) {
+        keys[i] = radix_sort::float_key(src[i]) ^ flip;
+    }
+    radix_sort::sort_keys(keys.data(), size);
 
-    if (descending) {
-        std::sort(dst, dst + size, std::greater<float>());
-    } else {
-        std::sort(dst, dst + size);
+    float* dst = result.ptrw();
+    for (int i = 0; i < size; i++) {
+        dst[i] = radix_sort::float_from_key(keys[i] ^ flip);
     }
     return result;
 }
@@ -299,113 +313,203 @@ PackedInt32Array ArrayOps::sort_ints(const PackedInt32Array& values, bool descen
     PackedInt32Array result;
     result.resize(size);
 
-    // Copy data
     const int32_t* src = values.ptr();
-    int32_t* dst = result.ptrw();
-    memcpy(dst, src, size * sizeof(int32_t));
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
+    std::vector<uint32_t> keys(size);
+    for (int i = 0; i < size; i++) {
+        keys[i] = radix_sort::int_key(src[i]) ^ flip;
+    }
+    radix_sort::sort_keys(keys.data(), size);
 
-    if (descending) {
-        std::sort(dst, dst + size, std::greater<int32_t>());
-    } else {
-        std::sort(dst, dst + size);
+    int32_t* dst = result.ptrw();
+    for (int i = 0; i < size; i++) {
+        dst[i] = radix_sort::int_from_key(keys[i] ^ flip);
     }
     return result;
 }
 
+// Sort indices 0..size-1 by their keys (stable: equal keys keep index order)
+static PackedInt32Array argsort_keys(std::vector<uint32_t>& keys) {
+    int size = static_cast<int>(keys.size());
+    PackedInt32Array result;
+    result.resize(size);
+    int32_t* indices = result.ptrw();
+    std::iota(indices, indices + size, 0);
+    radix_sort::sort_pairs(keys.data(), indices, size);
+    return result;
+}
+
 PackedInt32Array ArrayOps::argsort_floats(const PackedFloat32Array& values, bool descending) {
     int size = values.size();
-    std::vector<int32_t> indices(size);
-    std::iota(indices.begin(), indices.end(), 0);
-
     const float* data = values.ptr();
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
 
-    if (descending) {
-        std::sort(indices.begin(), indices.end(),
-            [data](int32_t a, int32_t b) { return data[a] > data[b]; });
-    } else {
-        std::sort(indices.begin(), indices.end(),
-            [data](int32_t a, int32_t b) { return data[a] < data[b]; });
+    std::vector<uint32_t> keys(size);
+    for (int i = 0; i < size; i++) {
+        keys[i] = radix_sort::float_key(data[i]) ^ flip;
     }
-
-    PackedInt32Array result;
-    result.resize(size);
-    memcpy(result.ptrw(), indices.data(), size * sizeof(int32_t));
-    return result;
+    return argsort_keys(keys);
 }
 
 PackedInt32Array ArrayOps::argsort_ints(const PackedInt32Array& values, bool descending) {
     int size = values.size();
-    std::vector<int32_t> indices(size);
-    std::iota(indices.begin(), indices.end(), 0);
-
     const int32_t* data = values.ptr();
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
 
-    if (descending) {
-        std::sort(indices.begin(), indices.end(),
-            [data](int32_t a, int32_t b) { return data[a] > data[b]; });
-    } else {
-        std::sort(indices.begin(), indices.end(),
-            [data](int32_t a, int32_t b) { return data[a] < data[b]; });
+    std::vector<uint32_t> keys(size);
+    for (int i = 0; i < size; i++) {
+        keys[i] = radix_sort::int_key(data[i]) ^ flip;
     }
-
-    PackedInt32Array result;
-    result.resize(size);
-    memcpy(result.ptrw(), indices.data(), size * sizeof(int32_t));
-    return result;
+    return argsort_keys(keys);
 }
 
 PackedInt32Array ArrayOps::argsort_by_distance(const PackedVector2Array& positions, const Vector2& origin, bool descending) {
     int size = positions.size();
-    std::vector<std::pair<float, int32_t>> dist_idx(size);
-
     const Vector2* data = positions.ptr();
-    for (int i = 0; i < size; i++) {
-        dist_idx[i] = {origin.distance_squared_to(data[i]), i};
-    }
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
 
-    if (descending) {
-        std::sort(dist_idx.begin(), dist_idx.end(),
-            [](const auto& a, const auto& b) { return a.first > b.first; });
-    } else {
-        std::sort(dist_idx.begin(), dist_idx.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
-    }
-
-    PackedInt32Array result;
-    result.resize(size);
-    int32_t* result_data = result.ptrw();
+    std::vector<uint32_t> keys(size);
     for (int i = 0; i < size; i++) {
-        result_data[i] = dist_idx[i].second;
+        keys[i] = radix_sort::float_key(origin.distance_squared_to(data[i])) ^ flip;
     }
-    return result;
+    return argsort_keys(keys);
 }
 
 PackedInt32Array ArrayOps::argsort_by_distance_3d(const PackedVector3Array& positions, const Vector3& origin, bool descending) {
     int size = positions.size();
-    std::vector<std::pair<float, int32_t>> dist_idx(size);
-
     const Vector3* data = positions.ptr();
+    uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
+
+    std::vector<uint32_t> keys(size);
     for (int i = 0; i < size; i++) {
-        dist_idx[i] = {origin.distance_squared_to(data[i]), i};
+        keys[i] = radix_sort::float_key(origin.distance_squared_to(data[i])) ^ flip;
     }
+    return argsort_keys(keys);
+}
 
-    if (descending) {
-        std::sort(dist_idx.begin(), dist_idx.end(),
-            [](const auto& a, const auto& b) { return a.first > b.first; });
-    } else {
-        std::sort(dist_idx.begin(), dist_idx.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
+// ========== TOP-K OPERATIONS ==========
+
+// Selection runs on 64-bit keys: the order-preserving radix key of the value
+// in the high half and the index in the low half, so equal values rank by
+// index and "best k" is always "k smallest keys".
+
+// A bounded heap is used while k is at most this fraction of the input;
+// beyond that, nth_element over all keys is cheaper
+static const int64_t TOP_K_HEAP_DIVISOR = 16;
+
+// Inputs from this many items are split across worker threads, each block
+// keeping its own heap, with at least this many items per block
+static const int64_t TOP_K_PARALLEL_MIN = 1 << 15;
+static const int64_t TOP_K_PARALLEL_BLOCK = 1 << 13;
+
+// Keep the k smallest keys of [begin, end) in a max-heap (worst on top)
+template <class KeyFn>
+static void top_k_heap(int64_t begin, int64_t end, int64_t k, const KeyFn& key_at, std::vector<uint64_t>& heap) {
+    heap.clear();
+    heap.reserve(k);
+    int64_t i = begin;
+    for (; i < end && static_cast<int64_t>(heap.size()) < k; i++) {
+        heap.push_back(key_at(i));
     }
+    std::make_heap(heap.begin(), heap.end());
+    for (; i < end; i++) {
+        uint64_t key = key_at(i);
+        if (key < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = key;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+}
 
+// Indices of the k smallest key_at(i) over [0, n), smallest first
+template <class KeyFn>
+static PackedInt32Array smallest_k(int64_t n, int64_t k, const KeyFn& key_at) {
     PackedInt32Array result;
-    result.resize(size);
-    int32_t* result_data = result.ptrw();
-    for (int i = 0; i < size; i++) {
-        result_data[i] = dist_idx[i].second;
+    if (k <= 0 || n == 0) return result;
+    k = std::min(k, n);
+
+    std::vector<uint64_t> best;
+    if (k * TOP_K_HEAP_DIVISOR > n) {
+        best.resize(n);
+        for (int64_t i = 0; i < n; i++) {
+            best[i] = key_at(i);
+        }
+        std::nth_element(best.begin(), best.begin() + (k - 1), best.end());
+        best.resize(k);
+    } else if (n >= TOP_K_PARALLEL_MIN && parallel::get_thread_count() > 1) {
+        // Fixed blocks, one local heap each, merged afterwards
+        int64_t block_count = std::min<int64_t>(parallel::get_thread_count() * 4, n / TOP_K_PARALLEL_BLOCK);
+        block_count = std::max<int64_t>(block_count, 1);
+        int64_t block_size = (n + block_count - 1) / block_count;
+        std::vector<std::vector<uint64_t>> heaps(block_count);
+        parallel::for_range(block_count, 1, [&](int64_t first, int64_t last) {
+            for (int64_t b = first; b < last; b++) {
+                top_k_heap(b * block_size, std::min(n, (b + 1) * block_size), k, key_at, heaps[b]);
+            }
+        });
+        for (const std::vector<uint64_t>& heap : heaps) {
+            best.insert(best.end(), heap.begin(), heap.end());
+        }
+        std::nth_element(best.begin(), best.begin() + (k - 1), best.end());
+        best.resize(k);
+    } else {
+        top_k_heap(0, n, k, key_at, best);
+    }
+    std::sort(best.begin(), best.end());
+
+    result.resize(k);
+    int32_t* dst = result.ptrw();
+    for (int64_t i = 0; i < k; i++) {
+        dst[i] = static_cast<int32_t>(best[i] & 0xFFFFFFFFu);
     }
     return result;
 }
 
+static inline uint64_t rank_key(uint32_t value_key, int64_t index) {
+    return (static_cast<uint64_t>(value_key) << 32) | static_cast<uint32_t>(index);
+}
+
+PackedInt32Array ArrayOps::argtop_k_floats(const PackedFloat32Array& values, int32_t k, bool largest) {
+    const float* data = values.ptr();
+    uint32_t flip = largest ? 0xFFFFFFFFu : 0u;
+    return smallest_k(values.size(), k, [data, flip](int64_t i) {
+        return rank_key(radix_sort::float_key(data[i]) ^ flip, i);
+    });
+}
+
+PackedInt32Array ArrayOps::argtop_k_ints(const PackedInt32Array& values, int32_t k, bool largest) {
+    const int32_t* data = values.ptr();
+    uint32_t flip = largest ? 0xFFFFFFFFu : 0u;
+    return smallest_k(values.size(), k, [data, flip](int64_t i) {
+        return rank_key(radix_sort::int_key(data[i]) ^ flip, i);
+    });
+}
+
+PackedFloat32Array ArrayOps::top_k_floats(const PackedFloat32Array& values, int32_t k, bool largest) {
+    return reorder_floats(values, argtop_k_floats(values, k, largest));
+}
+
+PackedInt32Array ArrayOps::top_k_ints(const PackedInt32Array& values, int32_t k, bool largest) {
+    return reorder_ints(values, argtop_k_ints(values, k, largest));
+}
+
+PackedInt32Array ArrayOps::k_nearest_to_point(const PackedVector2Array& positions, const Vector2& point, int32_t k, bool farthest) {
+    const Vector2* data = positions.ptr();
+    uint32_t flip = farthest ? 0xFFFFFFFFu : 0u;
+    return smallest_k(positions.size(), k, [data, point, flip](int64_t i) {
+        return rank_key(radix_sort::float_key(point.distance_squared_to(data[i])) ^ flip, i);
+    });
+}
+
+PackedInt32Array ArrayOps::k_nearest_to_point_3d(const PackedVector3Array& positions, const Vector3& point, int32_t k, bool farthest) {
+    const Vector3* data = positions.ptr();
+    uint32_t flip = farthest ? 0xFFFFFFFFu : 0u;
+    return smallest_k(positions.size(), k, [data, point, flip](int64_t i) {
+        return rank_key(radix_sort::float_key(point.distance_squared_to(data[i])) ^ flip, i);
+    });
+}
+
 // ========== REORDER OPERATIONS ==========
 
 PackedFloat32Array ArrayOps::reorder_floats(const PackedFloat32Array& values, const PackedInt32Array& indices) {
@@ -12,6 +12,10 @@
  *   var sorted = ArrayOps.sort_floats(values)
  *   var indices = ArrayOps.argsort_floats(values)
  *
+ *   # Top-k: the k best without sorting everything
+ *   var best = ArrayOps.argtop_k_floats(scores, 8)
+ *   var nearest = ArrayOps.k_nearest_to_point(positions, origin, 8)
+ *
  *   # Reduce: aggregation operations
  *   var total = ArrayOps.sum_floats(values)
  *   var min_idx = ArrayOps.argmin_floats(values)
@@ -80,6 +84,21 @@ public:
     static PackedVector2Array reorder_vector2(const PackedVector2Array& values, const PackedInt32Array& indices);
     static PackedVector3Array reorder_vector3(const PackedVector3Array& values, const PackedInt32Array& indices);
 
+    // ========== TOP-K OPERATIONS ==========
+
+    // The k largest (or smallest) values, best first. Same result as sorting and
+    // slicing, ties in index order, but only k items are ever kept in order.
+    static PackedFloat32Array top_k_floats(const PackedFloat32Array& values, int32_t k, bool largest = true);
+    static PackedInt32Array top_k_ints(const PackedInt32Array& values, int32_t k, bool largest = true);
+
+    // Indices of the k largest (or smallest) values, best first
+    static PackedInt32Array argtop_k_floats(const PackedFloat32Array& values, int32_t k, bool largest = true);
+    static PackedInt32Array argtop_k_ints(const PackedInt32Array& values, int32_t k, bool largest = true);
+
+    // Indices of the k positions nearest to (or farthest from) point, nearest first
+    static PackedInt32Array k_nearest_to_point(const PackedVector2Array& positions, const Vector2& point, int32_t k, bool farthest = false);
+    static PackedInt32Array k_nearest_to_point_3d(const PackedVector3Array& positions, const Vector3& point, int32_t k, bool farthest = false);
+
     // ========== REDUCE OPERATIONS ==========
 
     // Sum
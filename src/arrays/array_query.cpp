@@ -0,0 +1,644 @@
+/**
+ * ArrayQuery Implementation
+ */
+
+#include "array_query.hpp"
+#include "core/parallel.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace godot {
+
+// Rows per chunk: the survivor list and value scratch stay in L1
+static const int32_t QUERY_CHUNK = 1024;
+
+// Queries over this many rows run in parallel. Blocks are always this many rows,
+// whatever the thread count, so floating-point partial sums add up the same way
+// on every machine and in a serial run.
+static const int64_t QUERY_PARALLEL_MIN = 1 << 15;
+static const int64_t QUERY_PARALLEL_BLOCK = 1 << 13;
+
+void ArrayQuery::_bind_methods() {
+    // Columns
+    ClassDB::bind_method(D_METHOD("add_floats", "values"), &ArrayQuery::add_floats);
+    ClassDB::bind_method(D_METHOD("add_ints", "values"), &ArrayQuery::add_ints);
+    ClassDB::bind_method(D_METHOD("add_vector2", "values"), &ArrayQuery::add_vector2);
+    ClassDB::bind_method(D_METHOD("add_vector3", "values"), &ArrayQuery::add_vector3);
+
+    // Derived columns
+    ClassDB::bind_method(D_METHOD("map_distance", "column", "point"), &ArrayQuery::map_distance);
+    ClassDB::bind_method(D_METHOD("map_distance_3d", "column", "point"), &ArrayQuery::map_distance_3d);
+    ClassDB::bind_method(D_METHOD("map_dot", "column", "direction"), &ArrayQuery::map_dot);
+    ClassDB::bind_method(D_METHOD("map_dot_3d", "column", "direction"), &ArrayQuery::map_dot_3d);
+    ClassDB::bind_method(D_METHOD("map_scale", "column", "scale", "offset"), &ArrayQuery::map_scale, DEFVAL(0.0f));
+
+    // Rows and filters
+    ClassDB::bind_method(D_METHOD("set_indices", "indices"), &ArrayQuery::set_indices);
+    ClassDB::bind_method(D_METHOD("filter_gt", "column", "threshold"), &ArrayQuery::filter_gt);
+    ClassDB::bind_method(D_METHOD("filter_gte", "column", "threshold"), &ArrayQuery::filter_gte);
+    ClassDB::bind_method(D_METHOD("filter_lt", "column", "threshold"), &ArrayQuery::filter_lt);
+    ClassDB::bind_method(D_METHOD("filter_lte", "column", "threshold"), &ArrayQuery::filter_lte);
+    ClassDB::bind_method(D_METHOD("filter_range", "column", "min_val", "max_val"), &ArrayQuery::filter_range);
+    ClassDB::bind_method(D_METHOD("filter_eq", "column", "target", "epsilon"), &ArrayQuery::filter_eq, DEFVAL(0.0001));
+    ClassDB::bind_method(D_METHOD("filter_in_rect", "column", "rect"), &ArrayQuery::filter_in_rect);
+    ClassDB::bind_method(D_METHOD("filter_in_radius", "column", "origin", "radius"), &ArrayQuery::filter_in_radius);
+    ClassDB::bind_method(D_METHOD("filter_in_radius_3d", "column", "origin", "radius"), &ArrayQuery::filter_in_radius_3d);
+    ClassDB::bind_method(D_METHOD("clear_filters"), &ArrayQuery::clear_filters);
+    ClassDB::bind_method(D_METHOD("clear"), &ArrayQuery::clear);
+
+    // Results
+    ClassDB::bind_method(D_METHOD("get_indices"), &ArrayQuery::get_indices);
+    ClassDB::bind_method(D_METHOD("count"), &ArrayQuery::count);
+    ClassDB::bind_method(D_METHOD("select_floats", "column"), &ArrayQuery::select_floats);
+    ClassDB::bind_method(D_METHOD("select_ints", "column"), &ArrayQuery::select_ints);
+    ClassDB::bind_method(D_METHOD("select_vector2", "column"), &ArrayQuery::select_vector2);
+    ClassDB::bind_method(D_METHOD("select_vector3", "column"), &ArrayQuery::select_vector3);
+    ClassDB::bind_method(D_METHOD("sum", "column"), &ArrayQuery::sum);
+    ClassDB::bind_method(D_METHOD("mean", "column"), &ArrayQuery::mean);
+    ClassDB::bind_method(D_METHOD("min_value", "column"), &ArrayQuery::min_value);
+    ClassDB::bind_method(D_METHOD("max_value", "column"), &ArrayQuery::max_value);
+    ClassDB::bind_method(D_METHOD("argmin", "column"), &ArrayQuery::argmin);
+    ClassDB::bind_method(D_METHOD("argmax", "column"), &ArrayQuery::argmax);
+}
+
+ArrayQuery::ArrayQuery() {
+}
+
+ArrayQuery::~ArrayQuery() {
+}
+
+// ========== COLUMNS ==========
+
+int32_t ArrayQuery::add_column(Column column, int64_t size) {
+    if (row_count >= 0 && size != row_count) {
+        UtilityFunctions::push_error("AgentiteG: ArrayQuery columns must all have the same size");
+        failed = true;
+        return -1;
+    }
+    // clear_filters() drops the derived columns, so they must come after every input column
+    if (static_cast<int32_t>(columns.size()) != input_count) {
+        UtilityFunctions::push_error("AgentiteG: ArrayQuery input columns must be added before map_* columns");
+        failed = true;
+        return -1;
+    }
+    row_count = size;
+    columns.push_back(column);
+    input_count++;
+    return static_cast<int32_t>(columns.size() - 1);
+}
+
+int32_t ArrayQuery::add_floats(const PackedFloat32Array& values) {
+    Column column;
+    column.type = COLUMN_FLOATS;
+    column.floats = values;
+    return add_column(column, values.size());
+}
+
+int32_t ArrayQuery::add_ints(const PackedInt32Array& values) {
+    Column column;
+    column.type = COLUMN_INTS;
+    column.ints = values;
+    return add_column(column, values.size());
+}
+
+int32_t ArrayQuery::add_vector2(const PackedVector2Array& values) {
+    Column column;
+    column.type = COLUMN_VECTOR2;
+    column.vector2 = values;
+    return add_column(column, values.size());
+}
+
+int32_t ArrayQuery::add_vector3(const PackedVector3Array& values) {
+    Column column;
+    column.type = COLUMN_VECTOR3;
+    column.vector3 = values;
+    return add_column(column, values.size());
+}
+
+bool ArrayQuery::is_scalar(int32_t column) const {
+    ColumnType type = columns[column].type;
+    return type != COLUMN_VECTOR2 && type != COLUMN_VECTOR3;
+}
+
+bool ArrayQuery::check_column(int32_t column, const char* method, bool scalar, ColumnType type) const {
+    if (column < 0 || column >= static_cast<int32_t>(columns.size())) {
+        UtilityFunctions::push_error(String("AgentiteG: ArrayQuery.") + method + " got an unknown column id");
+        return false;
+    }
+    bool ok = scalar ? is_scalar(column) : columns[column].type == type;
+    if (!ok) {
+        UtilityFunctions::push_error(String("AgentiteG: ArrayQuery.") + method +
+                                     (scalar ? " needs a float or int column"
+                                             : type == COLUMN_VECTOR2 ? " needs a Vector2 column" : " needs a Vector3 column"));
+    }
+    return ok;
+}
+
+// ========== DERIVED COLUMNS ==========
+
+int32_t ArrayQuery::add_derived(ColumnType type, int32_t source, const Vector3& param, double scale, double offset) {
+    Column column;
+    column.type = type;
+    column.source = source;
+    column.param = param;
+    column.scale = scale;
+    column.offset = offset;
+    columns.push_back(column);
+    return static_cast<int32_t>(columns.size() - 1);
+}
+
+int32_t ArrayQuery::map_distance(int32_t column, const Vector2& point) {
+    if (!check_column(column, "map_distance", false, COLUMN_VECTOR2)) {
+        failed = true;
+        return -1;
+    }
+    return add_derived(COLUMN_DISTANCE_2D, column, Vector3(point.x, point.y, 0.0f), 1.0, 0.0);
+}
+
+int32_t ArrayQuery::map_distance_3d(int32_t column, const Vector3& point) {
+    if (!check_column(column, "map_distance_3d", false, COLUMN_VECTOR3)) {
+        failed = true;
+        return -1;
+    }
+    return add_derived(COLUMN_DISTANCE_3D, column, point, 1.0, 0.0);
+}
+
+int32_t ArrayQuery::map_dot(int32_t column, const Vector2& direction) {
+    if (!check_column(column, "map_dot", false, COLUMN_VECTOR2)) {
+        failed = true;
+        return -1;
+    }
+    return add_derived(COLUMN_DOT_2D, column, Vector3(direction.x, direction.y, 0.0f), 1.0, 0.0);
+}
+
+int32_t ArrayQuery::map_dot_3d(int32_t column, const Vector3& direction) {
+    if (!check_column(column, "map_dot_3d", false, COLUMN_VECTOR3)) {
+        failed = true;
+        return -1;
+    }
+    return add_derived(COLUMN_DOT_3D, column, direction, 1.0, 0.0);
+}
+
+int32_t ArrayQuery::map_scale(int32_t column, float scale, float offset) {
+    if (!check_column(column, "map_scale", true, COLUMN_FLOATS)) {
+        failed = true;
+        return -1;
+    }
+    return add_derived(COLUMN_SCALE, column, Vector3(), scale, offset);
+}
+
+// ========== ROWS AND FILTERS ==========
+
+Ref<ArrayQuery> ArrayQuery::set_indices(const PackedInt32Array& indices) {
+    start_rows = indices;
+    use_start_rows = true;
+    return Ref<ArrayQuery>(this);
+}
+
+Ref<ArrayQuery> ArrayQuery::add_stage(const char* method, bool scalar, ColumnType type, const Stage& stage) {
+    if (!check_column(stage.column, method, scalar, type)) {
+        failed = true;
+        return Ref<ArrayQuery>(this);
+    }
+    Stage added = stage;
+    // Float and derived columns compare in float precision, as the ArrayOps filters do
+    if (is_scalar(stage.column) && columns[stage.column].type != COLUMN_INTS) {
+        added.a = static_cast<float>(stage.a);
+        added.b = static_cast<float>(stage.b);
+    }
+    stages.push_back(added);
+    return Ref<ArrayQuery>(this);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_gt(int32_t column, double threshold) {
+    Stage stage;
+    stage.type = STAGE_GT;
+    stage.column = column;
+    stage.a = threshold;
+    return add_stage("filter_gt", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_gte(int32_t column, double threshold) {
+    Stage stage;
+    stage.type = STAGE_GTE;
+    stage.column = column;
+    stage.a = threshold;
+    return add_stage("filter_gte", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_lt(int32_t column, double threshold) {
+    Stage stage;
+    stage.type = STAGE_LT;
+    stage.column = column;
+    stage.a = threshold;
+    return add_stage("filter_lt", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_lte(int32_t column, double threshold) {
+    Stage stage;
+    stage.type = STAGE_LTE;
+    stage.column = column;
+    stage.a = threshold;
+    return add_stage("filter_lte", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_range(int32_t column, double min_val, double max_val) {
+    Stage stage;
+    stage.type = STAGE_RANGE;
+    stage.column = column;
+    stage.a = min_val;
+    stage.b = max_val;
+    return add_stage("filter_range", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_eq(int32_t column, double target, double epsilon) {
+    Stage stage;
+    stage.type = STAGE_EQ;
+    stage.column = column;
+    stage.a = target;
+    stage.b = epsilon;
+    return add_stage("filter_eq", true, COLUMN_FLOATS, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_in_rect(int32_t column, const Rect2& rect) {
+    Stage stage;
+    stage.type = STAGE_IN_RECT;
+    stage.column = column;
+    stage.rect = rect;
+    return add_stage("filter_in_rect", false, COLUMN_VECTOR2, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_in_radius(int32_t column, const Vector2& origin, float radius) {
+    Stage stage;
+    stage.type = STAGE_IN_RADIUS_2D;
+    stage.column = column;
+    stage.origin = Vector3(origin.x, origin.y, 0.0f);
+    stage.radius_sq = radius * radius;
+    return add_stage("filter_in_radius", false, COLUMN_VECTOR2, stage);
+}
+
+Ref<ArrayQuery> ArrayQuery::filter_in_radius_3d(int32_t column, const Vector3& origin, float radius) {
+    Stage stage;
+    stage.type = STAGE_IN_RADIUS_3D;
+    stage.column = column;
+    stage.origin = origin;
+    stage.radius_sq = radius * radius;
+    return add_stage("filter_in_radius_3d", false, COLUMN_VECTOR3, stage);
+}
+
+void ArrayQuery::clear_filters() {
+    columns.resize(input_count);
+    stages.clear();
+    start_rows = PackedInt32Array();
+    use_start_rows = false;
+    failed = false;
+}
+
+void ArrayQuery::clear() {
+    clear_filters();
+    columns.clear();
+    input_count = 0;
+    row_count = -1;
+}
+
+// ========== EXECUTION ==========
+
+void ArrayQuery::gather(int32_t column, const int32_t* rows, int32_t count, double* out) const {
+    const Column& col = columns[column];
+    switch (col.type) {
+        case COLUMN_FLOATS: {
+            const float* data = col.floats.ptr();
+            for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]];
+            break;
+        }
+        case COLUMN_INTS: {
+            const int32_t* data = col.ints.ptr();
+            for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]];
+            break;
+        }
+        case COLUMN_DISTANCE_2D: {
+            const Vector2* data = columns[col.source].vector2.ptr();
+            Vector2 point(col.param.x, col.param.y);
+            for (int32_t k = 0; k < count; k++) out[k] = point.distance_to(data[rows[k]]);
+            break;
+        }
+        case COLUMN_DISTANCE_3D: {
+            const Vector3* data = columns[col.source].vector3.ptr();
+            for (int32_t k = 0; k < count; k++) out[k] = col.param.distance_to(data[rows[k]]);
+            break;
+        }
+        case COLUMN_DOT_2D: {
+            const Vector2* data = columns[col.source].vector2.ptr();
+            Vector2 direction(col.param.x, col.param.y);
+            for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]].dot(direction);
+            break;
+        }
+        case COLUMN_DOT_3D: {
+            const Vector3* data = columns[col.source].vector3.ptr();
+            for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]].dot(col.param);
+            break;
+        }
+        case COLUMN_SCALE: {
+            gather(col.source, rows, count, out);
+            for (int32_t k = 0; k < count; k++) out[k] = static_cast<float>(out[k] * col.scale + col.offset);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Keep rows[k] where keep(k, row); branch-free so unpredictable filters stay cheap
+template <typename Keep>
+static int32_t compact(int32_t* rows, int32_t count, Keep keep) {
+    int32_t kept = 0;
+    for (int32_t k = 0; k < count; k++) {
+        int32_t row = rows[k];
+        bool match = keep(k, row);
+        rows[kept] = row;
+        kept += match ? 1 : 0;
+    }
+    return kept;
+}
+
+int32_t ArrayQuery::apply(const Stage& stage, int32_t* rows, int32_t count, double* scratch) const {
+    const Column& col = columns[stage.column];
+    switch (stage.type) {
+        case STAGE_IN_RECT: {
+            const Vector2* data = col.vector2.ptr();
+            const Rect2& rect = stage.rect;
+            return compact(rows, count, [&](int32_t, int32_t row) { return rect.has_point(data[row]); });
+        }
+        case STAGE_IN_RADIUS_2D: {
+            const Vector2* data = col.vector2.ptr();
+            Vector2 origin(stage.origin.x, stage.origin.y);
+            float radius_sq = stage.radius_sq;
+            return compact(rows, count, [&](int32_t, int32_t row) {
+                return origin.distance_squared_to(data[row]) <= radius_sq;
+            });
+        }
+        case STAGE_IN_RADIUS_3D: {
+            const Vector3* data = col.vector3.ptr();
+            const Vector3& origin = stage.origin;
+            float radius_sq = stage.radius_sq;
+            return compact(rows, count, [&](int32_t, int32_t row) {
+                return origin.distance_squared_to(data[row]) <= radius_sq;
+            });
+        }
+        default:
+            break;
+    }
+
+    gather(stage.column, rows, count, scratch);
+    double a = stage.a;
+    double b = stage.b;
+    switch (stage.type) {
+        case STAGE_GT:
+            return compact(rows, count, [&](int32_t k, int32_t) { return scratch[k] > a; });
+        case STAGE_GTE:
+            return compact(rows, count, [&](int32_t k, int32_t) { return scratch[k] >= a; });
+        case STAGE_LT:
+            return compact(rows, count, [&](int32_t k, int32_t) { return scratch[k] < a; });
+        case STAGE_LTE:
+            return compact(rows, count, [&](int32_t k, int32_t) { return scratch[k] <= a; });
+        case STAGE_RANGE:
+            return compact(rows, count, [&](int32_t k, int32_t) { return scratch[k] >= a && scratch[k] <= b; });
+        case STAGE_EQ:
+            return compact(rows, count, [&](int32_t k, int32_t) { return std::abs(scratch[k] - a) <= b; });
+        default:
+            return count;
+    }
+}
+
+int64_t ArrayQuery::plan_blocks() const {
+    int64_t domain = use_start_rows ? start_rows.size() : std::max<int64_t>(row_count, 0);
+    return std::max<int64_t>((domain + QUERY_PARALLEL_BLOCK - 1) / QUERY_PARALLEL_BLOCK, 1);
+}
+
+void ArrayQuery::execute(int64_t block_count, const ChunkSink& sink) const {
+    if (failed || row_count <= 0) {
+        return;
+    }
+    int64_t domain = use_start_rows ? start_rows.size() : row_count;
+    const int32_t* start = use_start_rows ? start_rows.ptr() : nullptr;
+    int64_t block_size = QUERY_PARALLEL_BLOCK;
+
+    auto run_blocks = [&](int64_t first, int64_t last) {
+        int32_t rows[QUERY_CHUNK];
+        double scratch[QUERY_CHUNK];
+        for (int64_t block = first; block < last; block++) {
+            int64_t end = std::min(domain, (block + 1) * block_size);
+            for (int64_t chunk = block * block_size; chunk < end; chunk += QUERY_CHUNK) {
+                int32_t size = static_cast<int32_t>(std::min<int64_t>(QUERY_CHUNK, end - chunk));
+                int32_t count = 0;
+                if (start) {
+                    for (int32_t k = 0; k < size; k++) {
+                        int32_t row = start[chunk + k];
+                        rows[count] = row;
+                        count += (row >= 0 && row < row_count) ? 1 : 0;
+                    }
+                } else {
+                    for (int32_t k = 0; k < size; k++) {
+                        rows[k] = static_cast<int32_t>(chunk + k);
+                    }
+                    count = size;
+                }
+
+                for (size_t s = 0; s < stages.size() && count > 0; s++) {
+                    count = apply(stages[s], rows, count, scratch);
+                }
+                if (count > 0) {
+                    sink(block, rows, count);
+                }
+            }
+        }
+    };
+
+    if (block_count > 1 && domain >= QUERY_PARALLEL_MIN && parallel::get_thread_count() > 1) {
+        parallel::for_range(block_count, 1, run_blocks);
+    } else {
+        run_blocks(0, block_count);
+    }
+}
+
+// Run the query, fill(rows, count, out) writes each chunk's output, blocks are joined in order
+template <typename Packed, typename T, typename Fill>
+Packed ArrayQuery::collect(Fill fill) const {
+    int64_t block_count = plan_blocks();
+    std::vector<std::vector<T>> parts(block_count);
+    execute(block_count, [&](int64_t block, const int32_t* rows, int32_t count) {
+        std::vector<T>& part = parts[block];
+        size_t at = part.size();
+        part.resize(at + count);
+        fill(rows, count, part.data() + at);
+    });
+
+    int64_t total = 0;
+    for (const std::vector<T>& part : parts) total += part.size();
+    Packed result;
+    result.resize(total);
+    T* dst = result.ptrw();
+    for (const std::vector<T>& part : parts) {
+        if (!part.empty()) {
+            std::memcpy(dst, part.data(), part.size() * sizeof(T));
+            dst += part.size();
+        }
+    }
+    return result;
+}
+
+// ========== RESULTS ==========
+
+PackedInt32Array ArrayQuery::get_indices() const {
+    return collect<PackedInt32Array, int32_t>([](const int32_t* rows, int32_t count, int32_t* out) {
+        std::memcpy(out, rows, count * sizeof(int32_t));
+    });
+}
+
+int64_t ArrayQuery::count() const {
+    int64_t block_count = plan_blocks();
+    std::vector<int64_t> counts(block_count, 0);
+    execute(block_count, [&](int64_t block, const int32_t*, int32_t count) {
+        counts[block] += count;
+    });
+    int64_t total = 0;
+    for (int64_t c : counts) total += c;
+    return total;
+}
+
+PackedFloat32Array ArrayQuery::select_floats(int32_t column) const {
+    if (!check_column(column, "select_floats", true, COLUMN_FLOATS)) return PackedFloat32Array();
+    return collect<PackedFloat32Array, float>([&](const int32_t* rows, int32_t count, float* out) {
+        double values[QUERY_CHUNK];
+        gather(column, rows, count, values);
+        for (int32_t k = 0; k < count; k++) out[k] = static_cast<float>(values[k]);
+    });
+}
+
+PackedInt32Array ArrayQuery::select_ints(int32_t column) const {
+    if (!check_column(column, "select_ints", false, COLUMN_INTS)) return PackedInt32Array();
+    const int32_t* data = columns[column].ints.ptr();
+    return collect<PackedInt32Array, int32_t>([&](const int32_t* rows, int32_t count, int32_t* out) {
+        for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]];
+    });
+}
+
+PackedVector2Array ArrayQuery::select_vector2(int32_t column) const {
+    if (!check_column(column, "select_vector2", false, COLUMN_VECTOR2)) return PackedVector2Array();
+    const Vector2* data = columns[column].vector2.ptr();
+    return collect<PackedVector2Array, Vector2>([&](const int32_t* rows, int32_t count, Vector2* out) {
+        for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]];
+    });
+}
+
+PackedVector3Array ArrayQuery::select_vector3(int32_t column) const {
+    if (!check_column(column, "select_vector3", false, COLUMN_VECTOR3)) return PackedVector3Array();
+    const Vector3* data = columns[column].vector3.ptr();
+    return collect<PackedVector3Array, Vector3>([&](const int32_t* rows, int32_t count, Vector3* out) {
+        for (int32_t k = 0; k < count; k++) out[k] = data[rows[k]];
+    });
+}
+
+double ArrayQuery::sum(int32_t column) const {
+    if (!check_column(column, "sum", true, COLUMN_FLOATS)) return 0.0;
+    int64_t block_count = plan_blocks();
+    std::vector<double> sums(block_count, 0.0);
+    execute(block_count, [&](int64_t block, const int32_t* rows, int32_t count) {
+        double values[QUERY_CHUNK];
+        gather(column, rows, count, values);
+        double total = 0.0;
+        for (int32_t k = 0; k < count; k++) total += values[k];
+        sums[block] += total;
+    });
+    double total = 0.0;
+    for (double s : sums) total += s;
+    return total;
+}
+
+double ArrayQuery::mean(int32_t column) const {
+    if (!check_column(column, "mean", true, COLUMN_FLOATS)) return 0.0;
+    int64_t block_count = plan_blocks();
+    std::vector<double> sums(block_count, 0.0);
+    std::vector<int64_t> counts(block_count, 0);
+    execute(block_count, [&](int64_t block, const int32_t* rows, int32_t count) {
+        double values[QUERY_CHUNK];
+        gather(column, rows, count, values);
+        double total = 0.0;
+        for (int32_t k = 0; k < count; k++) total += values[k];
+        sums[block] += total;
+        counts[block] += count;
+    });
+    double total = 0.0;
+    int64_t n = 0;
+    for (int64_t b = 0; b < block_count; b++) {
+        total += sums[b];
+        n += counts[b];
+    }
+    return n > 0 ? total / n : 0.0;
+}
+
+// Row of the smallest (or largest) value; the earliest row wins ties
+int32_t ArrayQuery::arg_best(int32_t column, bool largest) const {
+    int64_t block_count = plan_blocks();
+    std::vector<int32_t> best_rows(block_count, -1);
+    std::vector<double> best_values(block_count, 0.0);
+    double sign = largest ? -1.0 : 1.0;
+    execute(block_count, [&](int64_t block, const int32_t* rows, int32_t count) {
+        double values[QUERY_CHUNK];
+        gather(column, rows, count, values);
+        int32_t& best_row = best_rows[block];
+        double& best_value = best_values[block];
+        for (int32_t k = 0; k < count; k++) {
+            double value = values[k] * sign;
+            if (best_row < 0 || value < best_value) {
+                best_value = value;
+                best_row = rows[k];
+            }
+        }
+    });
+
+    int32_t best_row = -1;
+    double best_value = 0.0;
+    for (int64_t b = 0; b < block_count; b++) {
+        if (best_rows[b] >= 0 && (best_row < 0 || best_values[b] < best_value)) {
+            best_value = best_values[b];
+            best_row = best_rows[b];
+        }
+    }
+    return best_row;
+}
+
+double ArrayQuery::min_value(int32_t column) const {
+    if (!check_column(column, "min_value", true, COLUMN_FLOATS)) return 0.0;
+    int32_t row = arg_best(column, false);
+    if (row < 0) return 0.0;
+    double value;
+    gather(column, &row, 1, &value);
+    return value;
+}
+
+double ArrayQuery::max_value(int32_t column) const {
+    if (!check_column(column, "max_value", true, COLUMN_FLOATS)) return 0.0;
+    int32_t row = arg_best(column, true);
+    if (row < 0) return 0.0;
+    double value;
+    gather(column, &row, 1, &value);
+    return value;
+}
+
+int32_t ArrayQuery::argmin(int32_t column) const {
+    if (!check_column(column, "argmin", true, COLUMN_FLOATS)) return -1;
+    return arg_best(column, false);
+}
+
+int32_t ArrayQuery::argmax(int32_t column) const {
+    if (!check_column(column, "argmax", true, COLUMN_FLOATS)) return -1;
+    return arg_best(column, true);
+}
+
+}
@@ -0,0 +1,202 @@
+/**
+ * ArrayQuery - Fused filter / select / reduce pipeline over parallel arrays
+ *
+ * Chaining ArrayOps calls (filter, then select, then filter again, then sum)
+ * allocates and fills a packed array at every step. ArrayQuery instead
+ * records columns, derived values and filters, and runs them in one pass
+ * when a result is requested. Only the final result is allocated.
+ *
+ * Rows move through the filters in chunks: each chunk keeps a small list of
+ * surviving row indices, every filter compacts that list, and the result
+ * step reads only the survivors. Derived columns (distance to a point, dot
+ * with a direction, scale and offset) are computed for surviving rows only.
+ *
+ * Large inputs are split into contiguous blocks on the worker pool. Each
+ * block compacts its own survivors and the blocks are joined in order, so
+ * results are ordered and identical to a serial run. Blocks have a fixed
+ * size, so sum() and mean() add the same partial sums in the same order on
+ * any thread count (they can still differ from a plain left-to-right sum in
+ * the last bits).
+ *
+ * Usage:
+ *   var query = ArrayQuery.new()
+ *   var hp = query.add_floats(health)
+ *   var team = query.add_ints(teams)
+ *   var pos = query.add_vector2(positions)
+ *   var dist = query.map_distance(pos, player_pos)
+ *
+ *   query.filter_gt(hp, 0.0).filter_eq(team, ENEMY).filter_lte(dist, 300.0)
+ *
+ *   var targets = query.get_indices()     # Row indices, in row order
+ *   var nearest = query.argmin(dist)      # Closest living enemy in range
+ *   var total_hp = query.sum(hp)
+ */
+
+#ifndef AGENTITE_ARRAY_QUERY_HPP
+#define AGENTITE_ARRAY_QUERY_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace godot {
+
+class ArrayQuery : public RefCounted {
+    GDCLASS(ArrayQuery, RefCounted)
+
+private:
+    enum ColumnType {
+        COLUMN_FLOATS,
+        COLUMN_INTS,
+        COLUMN_VECTOR2,
+        COLUMN_VECTOR3,
+        // Derived float columns, computed per surviving row
+        COLUMN_DISTANCE_2D,
+        COLUMN_DISTANCE_3D,
+        COLUMN_DOT_2D,
+        COLUMN_DOT_3D,
+        COLUMN_SCALE,
+    };
+
+    struct Column {
+        ColumnType type;
+        PackedFloat32Array floats;
+        PackedInt32Array ints;
+        PackedVector2Array vector2;
+        PackedVector3Array vector3;
+        int32_t source = -1;  // Input column of a derived column
+        Vector3 param;        // Point or direction of a derived column
+        double scale = 1.0;
+        double offset = 0.0;
+    };
+
+    enum StageType {
+        STAGE_GT,
+        STAGE_GTE,
+        STAGE_LT,
+        STAGE_LTE,
+        STAGE_RANGE,
+        STAGE_EQ,
+        STAGE_IN_RECT,
+        STAGE_IN_RADIUS_2D,
+        STAGE_IN_RADIUS_3D,
+    };
+
+    struct Stage {
+        StageType type;
+        int32_t column;
+        double a = 0.0;  // Threshold, min or target
+        double b = 0.0;  // Max or epsilon
+        Vector3 origin;
+        float radius_sq = 0.0f;
+        Rect2 rect;
+    };
+
+    // Called with the surviving rows of each chunk, in row order
+    using ChunkSink = std::function<void(int64_t block, const int32_t* rows, int32_t count)>;
+
+    std::vector<Column> columns;  // Input columns, then derived columns
+    int32_t input_count = 0;
+    std::vector<Stage> stages;
+    int64_t row_count = -1;  // -1 until the first column is added
+    PackedInt32Array start_rows;
+    bool use_start_rows = false;
+    bool failed = false;  // A filter or map was rejected; results are empty until clear_filters()
+
+    int32_t add_column(Column column, int64_t size);
+    int32_t add_derived(ColumnType type, int32_t source, const Vector3& param, double scale, double offset);
+    bool is_scalar(int32_t column) const;
+    bool check_column(int32_t column, const char* method, bool scalar, ColumnType type) const;
+    Ref<ArrayQuery> add_stage(const char* method, bool scalar, ColumnType type, const Stage& stage);
+
+    // Values of a scalar column for the given rows
+    void gather(int32_t column, const int32_t* rows, int32_t count, double* out) const;
+    int32_t apply(const Stage& stage, int32_t* rows, int32_t count, double* scratch) const;
+    int64_t plan_blocks() const;
+    void execute(int64_t block_count, const ChunkSink& sink) const;
+
+    template <typename Packed, typename T, typename Fill>
+    Packed collect(Fill fill) const;
+    int32_t arg_best(int32_t column, bool largest) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    ArrayQuery();
+    ~ArrayQuery();
+
+    // === Columns ===
+    // All columns must have the same size. Each returns a column id.
+
+    int32_t add_floats(const PackedFloat32Array& values);
+    int32_t add_ints(const PackedInt32Array& values);
+    int32_t add_vector2(const PackedVector2Array& values);
+    int32_t add_vector3(const PackedVector3Array& values);
+
+    // === Derived Columns ===
+    // Float columns computed per surviving row; usable anywhere a float column is
+
+    int32_t map_distance(int32_t column, const Vector2& point);
+    int32_t map_distance_3d(int32_t column, const Vector3& point);
+    int32_t map_dot(int32_t column, const Vector2& direction);
+    int32_t map_dot_3d(int32_t column, const Vector3& direction);
+    int32_t map_scale(int32_t column, float scale, float offset = 0.0f);  // value * scale + offset
+
+    // === Rows ===
+
+    // Start from these rows, in this order, instead of all rows.
+    // Indices outside the columns are skipped.
+    Ref<ArrayQuery> set_indices(const PackedInt32Array& indices);
+
+    // === Filters ===
+    // Keep rows matching every filter. Each returns this query for chaining.
+
+    Ref<ArrayQuery> filter_gt(int32_t column, double threshold);
+    Ref<ArrayQuery> filter_gte(int32_t column, double threshold);
+    Ref<ArrayQuery> filter_lt(int32_t column, double threshold);
+    Ref<ArrayQuery> filter_lte(int32_t column, double threshold);
+    Ref<ArrayQuery> filter_range(int32_t column, double min_val, double max_val);  // Inclusive
+    Ref<ArrayQuery> filter_eq(int32_t column, double target, double epsilon = 0.0001);
+    Ref<ArrayQuery> filter_in_rect(int32_t column, const Rect2& rect);
+    Ref<ArrayQuery> filter_in_radius(int32_t column, const Vector2& origin, float radius);
+    Ref<ArrayQuery> filter_in_radius_3d(int32_t column, const Vector3& origin, float radius);
+
+    // Remove filters, set_indices and derived columns, keep input columns
+    void clear_filters();
+    // Remove everything
+    void clear();
+
+    // === Results ===
+    // Each runs the whole pipeline once.
+
+    PackedInt32Array get_indices() const;
+    int64_t count() const;
+
+    // Column values of the surviving rows, in row order
+    PackedFloat32Array select_floats(int32_t column) const;  // Any scalar column
+    PackedInt32Array select_ints(int32_t column) const;
+    PackedVector2Array select_vector2(int32_t column) const;
+    PackedVector3Array select_vector3(int32_t column) const;
+
+    // Reductions over a scalar column (0 / -1 when no row survives)
+    double sum(int32_t column) const;
+    double mean(int32_t column) const;
+    double min_value(int32_t column) const;
+    double max_value(int32_t column) const;
+    int32_t argmin(int32_t column) const;  // Row index; first one on ties
+    int32_t argmax(int32_t column) const;
+};
+
+}
+
+#endif // AGENTITE_ARRAY_QUERY_HPP
@@ -0,0 +1,208 @@
+/**
+ * RadixSort - LSD radix sort on 32-bit keys, shared by the ArrayOps sorts
+ *
+ * Floats and ints are mapped to unsigned keys that sort in the same order:
+ * - int: flip the sign bit
+ * - float: flip the sign bit of positives, all bits of negatives
+ * The keys are then sorted 8 bits at a time in four stable counting passes,
+ * carrying an index array along for argsorts. A pass whose digit is the same
+ * for every key (common for small ranges or distances) is skipped.
+ *
+ * Large inputs split each pass over the worker pool: every block counts its
+ * digits, the counts are turned into per-block output offsets, and every block
+ * scatters its own keys. Blocks are contiguous and keep their order, so the
+ * result is stable and identical to the serial sort.
+ *
+ * Below MIN_RADIX items the counting overhead dominates and a comparison sort
+ * is used instead (stable for argsorts, so equal keys keep index order either way).
+ *
+ * Usage (internal):
+ *   std::vector<uint32_t> keys(n);
+ *   std::vector<int32_t> indices(n);
+ *   for (i...) keys[i] = radix_sort::float_key(values[i]), indices[i] = i;
+ *   radix_sort::sort_pairs(keys.data(), indices.data(), n);
+ */
+
+#ifndef AGENTITE_RADIX_SORT_HPP
+#define AGENTITE_RADIX_SORT_HPP
+
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace godot {
+namespace radix_sort {
+
+static const int RADIX_BITS = 8;
+static const int BUCKETS = 1 << RADIX_BITS;
+static const int PASSES = 32 / RADIX_BITS;
+
+// Below this many items a comparison sort is faster
+static const int64_t MIN_RADIX = 1024;
+
+// Passes run in parallel from this many items, with at least this many per block
+static const int64_t PARALLEL_MIN = 1 << 16;
+static const int64_t PARALLEL_BLOCK = 1 << 14;
+
+// ========== KEYS ==========
+
+inline uint32_t float_key(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+inline float float_from_key(uint32_t key) {
+    uint32_t bits = key ^ ((key >> 31) ? 0x80000000u : 0xFFFFFFFFu);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint32_t int_key(int32_t value) {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+inline int32_t int_from_key(uint32_t key) {
+    return static_cast<int32_t>(key ^ 0x80000000u);
+}
+
+// ========== SORT ==========
+
+inline uint32_t digit(uint32_t key, int pass) {
+    return (key >> (pass * RADIX_BITS)) & (BUCKETS - 1);
+}
+
+// Stable LSD sort of keys (and values, when WITH_VALUES) in place
+template <bool WITH_VALUES>
+void radix(uint32_t* keys, int32_t* values, int64_t n) {
+    std::vector<uint32_t> key_scratch(n);
+    std::vector<int32_t> value_scratch(WITH_VALUES ? n : 0);
+    uint32_t* src_keys = keys;
+    uint32_t* dst_keys = key_scratch.data();
+    int32_t* src_values = values;
+    int32_t* dst_values = value_scratch.data();
+
+    int64_t block_count = 1;
+    if (n >= PARALLEL_MIN && parallel::get_thread_count() > 1) {
+        block_count = std::min<int64_t>(parallel::get_thread_count() * 4, n / PARALLEL_BLOCK);
+        block_count = std::max<int64_t>(block_count, 1);
+    }
+    int64_t block_size = (n + block_count - 1) / block_count;
+
+    // offsets[block * BUCKETS + bucket]: counts, then output positions
+    std::vector<int64_t> offsets(block_count * BUCKETS);
+
+    // A single block's digit counts do not change between passes: count all of them in one read
+    std::vector<int64_t> serial_counts;
+    if (block_count == 1) {
+        serial_counts.assign(PASSES * BUCKETS, 0);
+        for (int64_t i = 0; i < n; i++) {
+            for (int pass = 0; pass < PASSES; pass++) {
+                serial_counts[pass * BUCKETS + digit(keys[i], pass)]++;
+            }
+        }
+    }
+
+    for (int pass = 0; pass < PASSES; pass++) {
+        if (block_count == 1) {
+            std::copy(serial_counts.begin() + pass * BUCKETS, serial_counts.begin() + (pass + 1) * BUCKETS,
+                      offsets.begin());
+        } else {
+            std::fill(offsets.begin(), offsets.end(), 0);
+            parallel::for_range(block_count, 1, [&](int64_t first, int64_t last) {
+                for (int64_t b = first; b < last; b++) {
+                    int64_t* counts = offsets.data() + b * BUCKETS;
+                    int64_t end = std::min(n, (b + 1) * block_size);
+                    for (int64_t i = b * block_size; i < end; i++) {
+                        counts[digit(src_keys[i], pass)]++;
+                    }
+                }
+            });
+        }
+
+        // Skip the pass when every key has the same digit
+        bool trivial = false;
+        for (int d = 0; d < BUCKETS && !trivial; d++) {
+            int64_t total = 0;
+            for (int64_t b = 0; b < block_count; b++) {
+                total += offsets[b * BUCKETS + d];
+            }
+            trivial = total == n;
+        }
+        if (trivial) continue;
+
+        // Bucket-major, then block order: block b writes after earlier blocks' equal digits
+        int64_t position = 0;
+        for (int d = 0; d < BUCKETS; d++) {
+            for (int64_t b = 0; b < block_count; b++) {
+                int64_t count = offsets[b * BUCKETS + d];
+                offsets[b * BUCKETS + d] = position;
+                position += count;
+            }
+        }
+
+        auto scatter_blocks = [&](int64_t first, int64_t last) {
+            for (int64_t b = first; b < last; b++) {
+                int64_t* next = offsets.data() + b * BUCKETS;
+                int64_t end = std::min(n, (b + 1) * block_size);
+                for (int64_t i = b * block_size; i < end; i++) {
+                    int64_t to = next[digit(src_keys[i], pass)]++;
+                    dst_keys[to] = src_keys[i];
+                    if (WITH_VALUES) dst_values[to] = src_values[i];
+                }
+            }
+        };
+        if (block_count > 1) {
+            parallel::for_range(block_count, 1, scatter_blocks);
+        } else {
+            scatter_blocks(0, 1);
+        }
+
+        std::swap(src_keys, dst_keys);
+        if (WITH_VALUES) std::swap(src_values, dst_values);
+    }
+
+    // An odd number of executed passes leaves the result in the scratch buffers
+    if (src_keys != keys) {
+        std::memcpy(keys, src_keys, n * sizeof(uint32_t));
+        if (WITH_VALUES) std::memcpy(values, src_values, n * sizeof(int32_t));
+    }
+}
+
+// Sort keys ascending
+inline void sort_keys(uint32_t* keys, int64_t n) {
+    if (n < MIN_RADIX) {
+        std::sort(keys, keys + n);
+        return;
+    }
+    radix<false>(keys, nullptr, n);
+}
+
+// Sort keys ascending and apply the same order to values; stable
+inline void sort_pairs(uint32_t* keys, int32_t* values, int64_t n) {
+    if (n < MIN_RADIX) {
+        std::vector<std::pair<uint32_t, int32_t>> pairs(n);
+        for (int64_t i = 0; i < n; i++) {
+            pairs[i] = {keys[i], values[i]};
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        for (int64_t i = 0; i < n; i++) {
+            keys[i] = pairs[i].first;
+            values[i] = pairs[i].second;
+        }
+        return;
+    }
+    radix<true>(keys, values, n);
+}
+
+}
+}
+
+#endif // AGENTITE_RADIX_SORT_HPP
@@ -0,0 +1,97 @@
+/**
+ * Vector2Buffer / Vector3Buffer Implementation
+ */
+
+#include "vector_buffer.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+// ========== VECTOR2BUFFER ==========
+
+void Vector2Buffer::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_data", "data"), &Vector2Buffer::set_data);
+    ClassDB::bind_method(D_METHOD("get_data"), &Vector2Buffer::get_data);
+    ClassDB::bind_method(D_METHOD("size"), &Vector2Buffer::size);
+    ClassDB::bind_method(D_METHOD("resize", "size"), &Vector2Buffer::resize);
+    ClassDB::bind_method(D_METHOD("clear"), &Vector2Buffer::clear);
+}
+
+Vector2Buffer::Vector2Buffer() {
+}
+
+Vector2Buffer::~Vector2Buffer() {
+}
+
+void Vector2Buffer::set_data(const PackedVector2Array& data) {
+    values = data;
+}
+
+PackedVector2Array Vector2Buffer::get_data() const {
+    return values;
+}
+
+int64_t Vector2Buffer::size() const {
+    return values.size();
+}
+
+void Vector2Buffer::resize(int64_t size) {
+    int64_t old_size = values.size();
+    size = std::max<int64_t>(size, 0);
+    values.resize(size);
+    if (size > old_size) {
+        Vector2* ptr = values.ptrw();
+        std::fill(ptr + old_size, ptr + size, Vector2());
+    }
+}
+
+void Vector2Buffer::clear() {
+    values.resize(0);
+}
+
+// ========== VECTOR3BUFFER ==========
+
+void Vector3Buffer::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_data", "data"), &Vector3Buffer::set_data);
+    ClassDB::bind_method(D_METHOD("get_data"), &Vector3Buffer::get_data);
+    ClassDB::bind_method(D_METHOD("size"), &Vector3Buffer::size);
+    ClassDB::bind_method(D_METHOD("resize", "size"), &Vector3Buffer::resize);
+    ClassDB::bind_method(D_METHOD("clear"), &Vector3Buffer::clear);
+}
+
+Vector3Buffer::Vector3Buffer() {
+}
+
+Vector3Buffer::~Vector3Buffer() {
+}
+
+void Vector3Buffer::set_data(const PackedVector3Array& data) {
+    values = data;
+}
+
+PackedVector3Array Vector3Buffer::get_data() const {
+    return values;
+}
+
+int64_t Vector3Buffer::size() const {
+    return values.size();
+}
+
+void Vector3Buffer::resize(int64_t size) {
+    int64_t old_size = values.size();
+    size = std::max<int64_t>(size, 0);
+    values.resize(size);
+    if (size > old_size) {
+        Vector3* ptr = values.ptrw();
+        std::fill(ptr + old_size, ptr + size, Vector3());
+    }
+}
+
+void Vector3Buffer::clear() {
+    values.resize(0);
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * Vector2Buffer / Vector3Buffer - Caller-owned vector arrays for in-place batch updates
+ *
+ * Packed arrays are passed to native methods by value (copy-on-write), so a
+ * method cannot write into an array argument. Every batch method therefore
+ * allocates and returns a new array. A buffer holds the array inside an
+ * object, which is passed by reference: the BatchOps / MathOps *_in_place
+ * methods update it where it is, and the *_into methods write their result
+ * into it, reusing its memory once it has the right size.
+ *
+ * get_data() returns a copy-on-write share of the contents. While that share
+ * is alive, the next in-place write copies the array once, so read the data
+ * where it is needed instead of keeping it in a member.
+ *
+ * Usage:
+ *   var positions = Vector2Buffer.new()
+ *   var velocities = Vector2Buffer.new()
+ *   positions.set_data(start_positions)
+ *   velocities.resize(start_positions.size())
+ *
+ *   # Every frame
+ *   BatchOps.seek_batch_into(positions.get_data(), targets, max_speed, desired)
+ *   BatchOps.apply_accelerations_2d_in_place(velocities, desired.get_data(), delta)
+ *   BatchOps.limit_velocity_2d_in_place(velocities, max_speed)
+ *   BatchOps.apply_velocities_2d_in_place(positions, velocities.get_data(), delta)
+ */
+
+#ifndef AGENTITE_VECTOR_BUFFER_HPP
+#define AGENTITE_VECTOR_BUFFER_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class Vector2Buffer : public RefCounted {
+    GDCLASS(Vector2Buffer, RefCounted)
+
+private:
+    PackedVector2Array values;
+
+protected:
+    static void _bind_methods();
+
+public:
+    Vector2Buffer();
+    ~Vector2Buffer();
+
+    // Replace the contents (shares the array until the first write)
+    void set_data(const PackedVector2Array& data);
+    // Current contents, as a copy-on-write share
+    PackedVector2Array get_data() const;
+
+    int64_t size() const;
+    // New entries are Vector2.ZERO
+    void resize(int64_t size);
+    void clear();
+
+    // C++ API: the stored array, for methods writing into the buffer
+    PackedVector2Array& data() { return values; }
+};
+
+class Vector3Buffer : public RefCounted {
+    GDCLASS(Vector3Buffer, RefCounted)
+
+private:
+    PackedVector3Array values;
+
+protected:
+    static void _bind_methods();
+
+public:
+    Vector3Buffer();
+    ~Vector3Buffer();
+
+    void set_data(const PackedVector3Array& data);
+    PackedVector3Array get_data() const;
+
+    int64_t size() const;
+    void resize(int64_t size);
+    void clear();
+
+    PackedVector3Array& data() { return values; }
+};
+
+namespace vector_buffer {
+
+// Report a null buffer, or one whose size is not expected (expected < 0 skips the size check)
+template <typename Buffer>
+bool check(const Ref<Buffer>& buffer, const char* method, int64_t expected) {
+    if (buffer.is_null()) {
+        UtilityFunctions::push_error(String("AgentiteG: ") + method + " needs a buffer");
+        return false;
+    }
+    if (expected >= 0 && buffer->size() != expected) {
+        UtilityFunctions::push_error(String("AgentiteG: ") + method + " buffer and array sizes differ");
+        return false;
+    }
+    return true;
+}
+
+}
+
+}
+
+#endif // AGENTITE_VECTOR_BUFFER_HPP
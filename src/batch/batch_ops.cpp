@@ -3,9 +3,17 @@
  */
 
 #include "batch_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+#include "spatial/spatial_grid_2d.hpp"
+#include "spatial/spatial_grid_3d.hpp"
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
 
 namespace godot {
 
@@ -19,6 +27,22 @@ void BatchOps::_bind_methods() {
         &BatchOps::apply_accelerations_2d);
     ClassDB::bind_static_method("BatchOps", D_METHOD("apply_accelerations_3d", "velocities", "accelerations", "delta"),
         &BatchOps::apply_accelerations_3d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_velocities_2d_in_place", "positions", "velocities", "delta"),
+        &BatchOps::apply_velocities_2d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_velocities_3d_in_place", "positions", "velocities", "delta"),
+        &BatchOps::apply_velocities_3d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_accelerations_2d_in_place", "velocities", "accelerations", "delta"),
+        &BatchOps::apply_accelerations_2d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_accelerations_3d_in_place", "velocities", "accelerations", "delta"),
+        &BatchOps::apply_accelerations_3d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_velocities_store_2d", "store", "delta"),
+        &BatchOps::apply_velocities_store_2d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_velocities_store_3d", "store", "delta"),
+        &BatchOps::apply_velocities_store_3d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_accelerations_store_2d", "store", "accelerations", "delta"),
+        &BatchOps::apply_accelerations_store_2d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("apply_accelerations_store_3d", "store", "accelerations", "delta"),
+        &BatchOps::apply_accelerations_store_3d);
 
     // Steering behaviors
     ClassDB::bind_static_method("BatchOps", D_METHOD("seek_batch", "positions", "targets", "max_speed"),
@@ -33,32 +57,48 @@ void BatchOps::_bind_methods() {
         &BatchOps::arrive_batch);
     ClassDB::bind_static_method("BatchOps", D_METHOD("arrive_batch_3d", "positions", "targets", "max_speed", "slowing_radius"),
         &BatchOps::arrive_batch_3d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("seek_batch_into", "positions", "targets", "max_speed", "out"),
+        &BatchOps::seek_batch_into);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("seek_batch_3d_into", "positions", "targets", "max_speed", "out"),
+        &BatchOps::seek_batch_3d_into);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("flee_batch_into", "positions", "threats", "max_speed", "out"),
+        &BatchOps::flee_batch_into);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("flee_batch_3d_into", "positions", "threats", "max_speed", "out"),
+        &BatchOps::flee_batch_3d_into);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("arrive_batch_into", "positions", "targets", "max_speed", "slowing_radius", "out"),
+        &BatchOps::arrive_batch_into);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("arrive_batch_3d_into", "positions", "targets", "max_speed", "slowing_radius", "out"),
+        &BatchOps::arrive_batch_3d_into);
 
     // Flocking / Separation
-    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_2d", "positions", "radius", "strength"),
-        &BatchOps::separation_2d);
-    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_3d", "positions", "radius", "strength"),
-        &BatchOps::separation_3d);
-    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_2d_radii", "positions", "radii", "strength"),
-        &BatchOps::separation_2d_radii);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_2d", "positions", "radius", "strength", "spatial"),
+        &BatchOps::separation_2d, DEFVAL(Variant()));
+    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_3d", "positions", "radius", "strength", "spatial"),
+        &BatchOps::separation_3d, DEFVAL(Variant()));
+    ClassDB::bind_static_method("BatchOps", D_METHOD("separation_2d_radii", "positions", "radii", "strength", "spatial"),
+        &BatchOps::separation_2d_radii, DEFVAL(Variant()));
 
     // Cohesion
-    ClassDB::bind_static_method("BatchOps", D_METHOD("cohesion_2d", "positions", "radius", "strength"),
-        &BatchOps::cohesion_2d);
-    ClassDB::bind_static_method("BatchOps", D_METHOD("cohesion_3d", "positions", "radius", "strength"),
-        &BatchOps::cohesion_3d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("cohesion_2d", "positions", "radius", "strength", "spatial"),
+        &BatchOps::cohesion_2d, DEFVAL(Variant()));
+    ClassDB::bind_static_method("BatchOps", D_METHOD("cohesion_3d", "positions", "radius", "strength", "spatial"),
+        &BatchOps::cohesion_3d, DEFVAL(Variant()));
 
     // Alignment
-    ClassDB::bind_static_method("BatchOps", D_METHOD("alignment_2d", "positions", "velocities", "radius"),
-        &BatchOps::alignment_2d);
-    ClassDB::bind_static_method("BatchOps", D_METHOD("alignment_3d", "positions", "velocities", "radius"),
-        &BatchOps::alignment_3d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("alignment_2d", "positions", "velocities", "radius", "spatial"),
+        &BatchOps::alignment_2d, DEFVAL(Variant()));
+    ClassDB::bind_static_method("BatchOps", D_METHOD("alignment_3d", "positions", "velocities", "radius", "spatial"),
+        &BatchOps::alignment_3d, DEFVAL(Variant()));
 
     // Combined flocking
     ClassDB::bind_static_method("BatchOps", D_METHOD("flock_2d", "positions", "velocities",
         "separation_radius", "cohesion_radius", "alignment_radius",
-        "separation_strength", "cohesion_strength", "alignment_strength"),
-        &BatchOps::flock_2d);
+        "separation_strength", "cohesion_strength", "alignment_strength", "spatial"),
+        &BatchOps::flock_2d, DEFVAL(Variant()));
+    ClassDB::bind_static_method("BatchOps", D_METHOD("flock_3d", "positions", "velocities",
+        "separation_radius", "cohesion_radius", "alignment_radius",
+        "separation_strength", "cohesion_strength", "alignment_strength", "spatial"),
+        &BatchOps::flock_3d, DEFVAL(Variant()));
 
     // Wander
     ClassDB::bind_static_method("BatchOps", D_METHOD("wander_2d", "forward_directions", "wander_angles",
@@ -77,15 +117,37 @@ void BatchOps::_bind_methods() {
         &BatchOps::limit_velocity_3d);
     ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_range_2d", "velocities", "min_speed", "max_speed"),
         &BatchOps::limit_velocity_range_2d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_2d_in_place", "velocities", "max_speed"),
+        &BatchOps::limit_velocity_2d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_3d_in_place", "velocities", "max_speed"),
+        &BatchOps::limit_velocity_3d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_range_2d_in_place", "velocities", "min_speed", "max_speed"),
+        &BatchOps::limit_velocity_range_2d_in_place);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_store_2d", "store", "max_speed"),
+        &BatchOps::limit_velocity_store_2d);
+    ClassDB::bind_static_method("BatchOps", D_METHOD("limit_velocity_store_3d", "store", "max_speed"),
+        &BatchOps::limit_velocity_store_3d);
 }
 
 // ========== VELOCITY / POSITION UPDATES ==========
 
+// Kernels shared by the returning, *_in_place and *_into variants.
+// out may be the same array as any input.
+
+// out[i] = base[i] + rate[i] * delta
+template <typename V>
+static void integrate(const V* base, const V* rate, float delta, V* out, int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        out[i] = base[i] + rate[i] * delta;
+    }
+}
+
 PackedVector2Array BatchOps::apply_velocities_2d(
     const PackedVector2Array& positions,
     const PackedVector2Array& velocities,
     float delta
 ) {
+    AGENTITE_PROFILE("BatchOps.apply_velocities_2d", positions.size());
     int64_t count = positions.size();
     if (count == 0 || velocities.size() != count) {
         return PackedVector2Array();
@@ -93,15 +155,8 @@ PackedVector2Array BatchOps::apply_velocities_2d(
 
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* pos_ptr = positions.ptr();
-    const Vector2* vel_ptr = velocities.ptr();
-    Vector2* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        res_ptr[i] = pos_ptr[i] + vel_ptr[i] * delta;
-    }
-
+    integrate(positions.ptr(), velocities.ptr(), delta, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -110,6 +165,7 @@ PackedVector3Array BatchOps::apply_velocities_3d(
     const PackedVector3Array& velocities,
     float delta
 ) {
+    AGENTITE_PROFILE("BatchOps.apply_velocities_3d", positions.size());
     int64_t count = positions.size();
     if (count == 0 || velocities.size() != count) {
         return PackedVector3Array();
@@ -117,15 +173,8 @@ PackedVector3Array BatchOps::apply_velocities_3d(
 
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* pos_ptr = positions.ptr();
-    const Vector3* vel_ptr = velocities.ptr();
-    Vector3* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        res_ptr[i] = pos_ptr[i] + vel_ptr[i] * delta;
-    }
-
+    integrate(positions.ptr(), velocities.ptr(), delta, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
     return result;
 }
 
@@ -134,6 +183,7 @@ PackedVector2Array BatchOps::apply_accelerations_2d(
     const PackedVector2Array& accelerations,
     float delta
 ) {
+    AGENTITE_PROFILE("BatchOps.apply_accelerations_2d", velocities.size());
     int64_t count = velocities.size();
     if (count == 0 || accelerations.size() != count) {
         return PackedVector2Array();
@@ -141,15 +191,8 @@ PackedVector2Array BatchOps::apply_accelerations_2d(
 
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* vel_ptr = velocities.ptr();
-    const Vector2* acc_ptr = accelerations.ptr();
-    Vector2* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        res_ptr[i] = vel_ptr[i] + acc_ptr[i] * delta;
-    }
-
+    integrate(velocities.ptr(), accelerations.ptr(), delta, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -158,6 +201,7 @@ PackedVector3Array BatchOps::apply_accelerations_3d(
     const PackedVector3Array& accelerations,
     float delta
 ) {
+    AGENTITE_PROFILE("BatchOps.apply_accelerations_3d", velocities.size());
     int64_t count = velocities.size();
     if (count == 0 || accelerations.size() != count) {
         return PackedVector3Array();
@@ -165,47 +209,148 @@ PackedVector3Array BatchOps::apply_accelerations_3d(
 
     PackedVector3Array result;
     result.resize(count);
+    integrate(velocities.ptr(), accelerations.ptr(), delta, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
+    return result;
+}
 
-    const Vector3* vel_ptr = velocities.ptr();
-    const Vector3* acc_ptr = accelerations.ptr();
-    Vector3* res_ptr = result.ptrw();
+// buffer[i] += rate[i] * delta, in the buffer's own memory
+template <typename Buffer, typename PackedVec>
+static void integrate_in_place(const Ref<Buffer>& buffer, const PackedVec& rate, float delta, const char* method) {
+    if (!vector_buffer::check(buffer, method, rate.size())) {
+        return;
+    }
+    auto* ptr = buffer->data().ptrw();
+    integrate(ptr, rate.ptr(), delta, ptr, rate.size());
+}
 
-    for (int64_t i = 0; i < count; ++i) {
-        res_ptr[i] = vel_ptr[i] + acc_ptr[i] * delta;
+void BatchOps::apply_velocities_2d_in_place(const Ref<Vector2Buffer>& positions, const PackedVector2Array& velocities, float delta) {
+    integrate_in_place(positions, velocities, delta, "apply_velocities_2d_in_place");
+}
+
+void BatchOps::apply_velocities_3d_in_place(const Ref<Vector3Buffer>& positions, const PackedVector3Array& velocities, float delta) {
+    integrate_in_place(positions, velocities, delta, "apply_velocities_3d_in_place");
+}
+
+void BatchOps::apply_accelerations_2d_in_place(const Ref<Vector2Buffer>& velocities, const PackedVector2Array& accelerations, float delta) {
+    integrate_in_place(velocities, accelerations, delta, "apply_accelerations_2d_in_place");
+}
+
+void BatchOps::apply_accelerations_3d_in_place(const Ref<Vector3Buffer>& velocities, const PackedVector3Array& accelerations, float delta) {
+    integrate_in_place(velocities, accelerations, delta, "apply_accelerations_3d_in_place");
+}
+
+// Report a null store, or a rate array whose size is not the store's count (expected < 0 skips the size check)
+template <typename Store>
+static bool check_store(const Ref<Store>& store, const char* method, int64_t expected) {
+    if (store.is_null()) {
+        UtilityFunctions::push_error(String("AgentiteG: BatchOps.") + method + " needs a store");
+        return false;
+    }
+    if (expected >= 0 && store->get_count() != expected) {
+        UtilityFunctions::push_error(String("AgentiteG: BatchOps.") + method + " store and array sizes differ");
+        return false;
     }
+    return true;
+}
 
-    return result;
+template <typename Store>
+static void apply_velocities_store(const Ref<Store>& store, float delta, const char* method) {
+    if (!check_store(store, method, -1)) {
+        return;
+    }
+    auto* pos = store->position_column().ptrw();
+    integrate(pos, store->velocity_column().ptr(), delta, pos, store->get_count());
+}
+
+template <typename Store, typename PackedVec>
+static void apply_accelerations_store(const Ref<Store>& store, const PackedVec& accelerations, float delta, const char* method) {
+    if (!check_store(store, method, accelerations.size())) {
+        return;
+    }
+    auto* vel = store->velocity_column().ptrw();
+    integrate(vel, accelerations.ptr(), delta, vel, accelerations.size());
+}
+
+void BatchOps::apply_velocities_store_2d(const Ref<AgentStore2D>& store, float delta) {
+    apply_velocities_store(store, delta, "apply_velocities_store_2d");
+}
+
+void BatchOps::apply_velocities_store_3d(const Ref<AgentStore3D>& store, float delta) {
+    apply_velocities_store(store, delta, "apply_velocities_store_3d");
+}
+
+void BatchOps::apply_accelerations_store_2d(const Ref<AgentStore2D>& store, const PackedVector2Array& accelerations, float delta) {
+    apply_accelerations_store(store, accelerations, delta, "apply_accelerations_store_2d");
+}
+
+void BatchOps::apply_accelerations_store_3d(const Ref<AgentStore3D>& store, const PackedVector3Array& accelerations, float delta) {
+    apply_accelerations_store(store, accelerations, delta, "apply_accelerations_store_3d");
 }
 
 // ========== STEERING BEHAVIORS ==========
 
+// out[i] = (to[i] - from[i]).normalized() * max_speed (seek; flee swaps from and to)
+template <typename V>
+static void seek(const V* from, const V* to, float max_speed, V* out, int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        V direction = to[i] - from[i];
+        float length = direction.length();
+        if (length > 0.0001f) {
+            out[i] = (direction / length) * max_speed;
+        } else {
+            out[i] = V();
+        }
+    }
+}
+
+template <typename V>
+static void arrive(const V* positions, const V* targets, float max_speed, float slowing_radius, V* out, int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        V to_target = targets[i] - positions[i];
+        float distance = to_target.length();
+
+        if (distance < 0.0001f) {
+            out[i] = V();
+        } else {
+            float speed;
+            if (distance < slowing_radius) {
+                // Ramp down speed as we get closer
+                speed = max_speed * (distance / slowing_radius);
+            } else {
+                speed = max_speed;
+            }
+            out[i] = (to_target / distance) * speed;
+        }
+    }
+}
+
+// Report positions and other (targets or threats) of different lengths
+template <typename PackedVec>
+static bool sizes_match(const PackedVec& positions, const PackedVec& other, const char* method, const char* other_name) {
+    if (positions.size() != other.size()) {
+        UtilityFunctions::push_error(String("AgentiteG: BatchOps.") + method + " positions and " + other_name +
+                                     " arrays must have same size");
+        return false;
+    }
+    return true;
+}
+
 PackedVector2Array BatchOps::seek_batch(
     const PackedVector2Array& positions,
     const PackedVector2Array& targets,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.seek_batch", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || targets.size() != count) {
+    if (!sizes_match(positions, targets, "seek_batch", "targets") || count == 0) {
         return PackedVector2Array();
     }
 
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* pos_ptr = positions.ptr();
-    const Vector2* tgt_ptr = targets.ptr();
-    Vector2* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector2 direction = tgt_ptr[i] - pos_ptr[i];
-        float length = direction.length();
-        if (length > 0.0001f) {
-            res_ptr[i] = (direction / length) * max_speed;
-        } else {
-            res_ptr[i] = Vector2();
-        }
-    }
-
+    seek(positions.ptr(), targets.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -214,28 +359,16 @@ PackedVector3Array BatchOps::seek_batch_3d(
     const PackedVector3Array& targets,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.seek_batch_3d", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || targets.size() != count) {
+    if (!sizes_match(positions, targets, "seek_batch_3d", "targets") || count == 0) {
         return PackedVector3Array();
     }
 
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* pos_ptr = positions.ptr();
-    const Vector3* tgt_ptr = targets.ptr();
-    Vector3* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector3 direction = tgt_ptr[i] - pos_ptr[i];
-        float length = direction.length();
-        if (length > 0.0001f) {
-            res_ptr[i] = (direction / length) * max_speed;
-        } else {
-            res_ptr[i] = Vector3();
-        }
-    }
-
+    seek(positions.ptr(), targets.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
     return result;
 }
 
@@ -244,28 +377,16 @@ PackedVector2Array BatchOps::flee_batch(
     const PackedVector2Array& threats,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.flee_batch", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || threats.size() != count) {
+    if (!sizes_match(positions, threats, "flee_batch", "threats") || count == 0) {
         return PackedVector2Array();
     }
 
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* pos_ptr = positions.ptr();
-    const Vector2* thr_ptr = threats.ptr();
-    Vector2* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector2 direction = pos_ptr[i] - thr_ptr[i];
-        float length = direction.length();
-        if (length > 0.0001f) {
-            res_ptr[i] = (direction / length) * max_speed;
-        } else {
-            res_ptr[i] = Vector2();
-        }
-    }
-
+    seek(threats.ptr(), positions.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -274,28 +395,16 @@ PackedVector3Array BatchOps::flee_batch_3d(
     const PackedVector3Array& threats,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.flee_batch_3d", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || threats.size() != count) {
+    if (!sizes_match(positions, threats, "flee_batch_3d", "threats") || count == 0) {
         return PackedVector3Array();
     }
 
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* pos_ptr = positions.ptr();
-    const Vector3* thr_ptr = threats.ptr();
-    Vector3* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector3 direction = pos_ptr[i] - thr_ptr[i];
-        float length = direction.length();
-        if (length > 0.0001f) {
-            res_ptr[i] = (direction / length) * max_speed;
-        } else {
-            res_ptr[i] = Vector3();
-        }
-    }
-
+    seek(threats.ptr(), positions.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
     return result;
 }
 
@@ -305,36 +414,16 @@ PackedVector2Array BatchOps::arrive_batch(
     float max_speed,
     float slowing_radius
 ) {
+    AGENTITE_PROFILE("BatchOps.arrive_batch", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || targets.size() != count) {
+    if (!sizes_match(positions, targets, "arrive_batch", "targets") || count == 0) {
         return PackedVector2Array();
     }
 
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* pos_ptr = positions.ptr();
-    const Vector2* tgt_ptr = targets.ptr();
-    Vector2* res_ptr = result.ptrw();
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector2 to_target = tgt_ptr[i] - pos_ptr[i];
-        float distance = to_target.length();
-
-        if (distance < 0.0001f) {
-            res_ptr[i] = Vector2();
-        } else {
-            float speed;
-            if (distance < slowing_radius) {
-                // Ramp down speed as we get closer
-                speed = max_speed * (distance / slowing_radius);
-            } else {
-                speed = max_speed;
-            }
-            res_ptr[i] = (to_target / distance) * speed;
-        }
-    }
-
+    arrive(positions.ptr(), targets.ptr(), max_speed, slowing_radius, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -344,36 +433,129 @@ PackedVector3Array BatchOps::arrive_batch_3d(
     float max_speed,
     float slowing_radius
 ) {
+    AGENTITE_PROFILE("BatchOps.arrive_batch_3d", positions.size());
     int64_t count = positions.size();
-    if (count == 0 || targets.size() != count) {
+    if (!sizes_match(positions, targets, "arrive_batch_3d", "targets") || count == 0) {
         return PackedVector3Array();
     }
 
     PackedVector3Array result;
     result.resize(count);
+    arrive(positions.ptr(), targets.ptr(), max_speed, slowing_radius, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
+    return result;
+}
 
-    const Vector3* pos_ptr = positions.ptr();
-    const Vector3* tgt_ptr = targets.ptr();
-    Vector3* res_ptr = result.ptrw();
+// Size out to match positions and return its memory. On mismatched inputs the
+// error is reported like the returning variant and out is left unchanged.
+template <typename V, typename Buffer, typename PackedVec>
+static V* prepare_out(const Ref<Buffer>& out, const PackedVec& positions, const PackedVec& other,
+                      const char* method, const char* other_name) {
+    if (!vector_buffer::check(out, method, -1) || !sizes_match(positions, other, method, other_name)) {
+        return nullptr;
+    }
+    out->data().resize(positions.size());
+    return positions.size() > 0 ? out->data().ptrw() : nullptr;
+}
 
-    for (int64_t i = 0; i < count; ++i) {
-        Vector3 to_target = tgt_ptr[i] - pos_ptr[i];
-        float distance = to_target.length();
+void BatchOps::seek_batch_into(const PackedVector2Array& positions, const PackedVector2Array& targets,
+                               float max_speed, const Ref<Vector2Buffer>& out) {
+    if (Vector2* dst = prepare_out<Vector2>(out, positions, targets, "seek_batch_into", "targets")) {
+        seek(positions.ptr(), targets.ptr(), max_speed, dst, positions.size());
+    }
+}
 
-        if (distance < 0.0001f) {
-            res_ptr[i] = Vector3();
-        } else {
-            float speed;
-            if (distance < slowing_radius) {
-                speed = max_speed * (distance / slowing_radius);
-            } else {
-                speed = max_speed;
+void BatchOps::seek_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& targets,
+                                  float max_speed, const Ref<Vector3Buffer>& out) {
+    if (Vector3* dst = prepare_out<Vector3>(out, positions, targets, "seek_batch_3d_into", "targets")) {
+        seek(positions.ptr(), targets.ptr(), max_speed, dst, positions.size());
+    }
+}
+
+void BatchOps::flee_batch_into(const PackedVector2Array& positions, const PackedVector2Array& threats,
+                               float max_speed, const Ref<Vector2Buffer>& out) {
+    if (Vector2* dst = prepare_out<Vector2>(out, positions, threats, "flee_batch_into", "threats")) {
+        seek(threats.ptr(), positions.ptr(), max_speed, dst, positions.size());
+    }
+}
+
+void BatchOps::flee_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& threats,
+                                  float max_speed, const Ref<Vector3Buffer>& out) {
+    if (Vector3* dst = prepare_out<Vector3>(out, positions, threats, "flee_batch_3d_into", "threats")) {
+        seek(threats.ptr(), positions.ptr(), max_speed, dst, positions.size());
+    }
+}
+
+void BatchOps::arrive_batch_into(const PackedVector2Array& positions, const PackedVector2Array& targets,
+                                 float max_speed, float slowing_radius, const Ref<Vector2Buffer>& out) {
+    if (Vector2* dst = prepare_out<Vector2>(out, positions, targets, "arrive_batch_into", "targets")) {
+        arrive(positions.ptr(), targets.ptr(), max_speed, slowing_radius, dst, positions.size());
+    }
+}
+
+void BatchOps::arrive_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& targets,
+                                    float max_speed, float slowing_radius, const Ref<Vector3Buffer>& out) {
+    if (Vector3* dst = prepare_out<Vector3>(out, positions, targets, "arrive_batch_3d_into", "targets")) {
+        arrive(positions.ptr(), targets.ptr(), max_speed, slowing_radius, dst, positions.size());
+    }
+}
+
+// ========== NEIGHBOR SEARCH ==========
+
+// Below this many agents the all-pairs loop beats building a neighbor grid
+static const int64_t NEIGHBOR_GRID_MIN = 128;
+
+// Run body(i, neighbors, neighbor_count) for every agent, across worker threads.
+// neighbors holds candidate indices in ascending order (it may include i and agents
+// outside the radius), so loops over it add up exactly like an all-pairs loop.
+// Candidates within search_radius(i) come from spatial when given, from an internal
+// Grid for large sets, and otherwise every agent is a candidate.
+// Returns false (after reporting an error) if spatial does not match positions.
+template <typename Grid, typename Spatial, typename PackedVec, typename Radius, typename Body>
+static bool for_each_neighborhood(const Ref<Spatial>& spatial, const PackedVec& positions,
+                                  float max_search_radius, const Radius& search_radius,
+                                  const Body& body) {
+    int64_t count = positions.size();
+    const auto* pos_ptr = positions.ptr();
+
+    if (spatial.is_valid() && spatial->get_count() != count) {
+        UtilityFunctions::push_error("AgentiteG: spatial index must be built from the same positions");
+        return false;
+    }
+
+    if (spatial.is_null() && count < NEIGHBOR_GRID_MIN) {
+        std::vector<int32_t> everyone(count);
+        std::iota(everyone.begin(), everyone.end(), 0);
+        parallel::for_range(count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                body(i, everyone.data(), static_cast<int32_t>(count));
             }
-            res_ptr[i] = (to_target / distance) * speed;
-        }
+        });
+        return true;
     }
 
-    return result;
+    Ref<Grid> grid;
+    if (spatial.is_null()) {
+        grid.instantiate();
+        grid->set_cell_size(max_search_radius);
+        grid->build(positions);
+    }
+
+    parallel::for_range(count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        std::vector<int32_t> candidates;
+        for (int64_t i = begin; i < end; ++i) {
+            candidates.clear();
+            float radius = std::max(search_radius(i), std::numeric_limits<float>::min());
+            if (spatial.is_valid()) {
+                spatial->collect_radius(pos_ptr[i], radius, candidates);
+            } else {
+                grid->collect_radius(pos_ptr[i], radius, candidates);
+            }
+            std::sort(candidates.begin(), candidates.end());
+            body(i, candidates.data(), static_cast<int32_t>(candidates.size()));
+        }
+    });
+    return true;
 }
 
 // ========== FLOCKING / SEPARATION ==========
@@ -381,8 +563,10 @@ PackedVector3Array BatchOps::arrive_batch_3d(
 PackedVector2Array BatchOps::separation_2d(
     const PackedVector2Array& positions,
     float radius,
-    float strength
+    float strength,
+    const Ref<SpatialHash2D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.separation_2d", positions.size());
     int64_t count = positions.size();
     if (count == 0) {
         return PackedVector2Array();
@@ -395,12 +579,16 @@ PackedVector2Array BatchOps::separation_2d(
     Vector2* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid2D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector2 force;
         const Vector2& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             Vector2 diff = my_pos - pos_ptr[j];
@@ -415,16 +603,18 @@ PackedVector2Array BatchOps::separation_2d(
         }
 
         res_ptr[i] = force;
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector2Array();
 }
 
 PackedVector3Array BatchOps::separation_3d(
     const PackedVector3Array& positions,
     float radius,
-    float strength
+    float strength,
+    const Ref<SpatialHash3D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.separation_3d", positions.size());
     int64_t count = positions.size();
     if (count == 0) {
         return PackedVector3Array();
@@ -437,12 +627,16 @@ PackedVector3Array BatchOps::separation_3d(
     Vector3* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid3D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector3 force;
         const Vector3& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             Vector3 diff = my_pos - pos_ptr[j];
@@ -456,16 +650,18 @@ PackedVector3Array BatchOps::separation_3d(
         }
 
         res_ptr[i] = force;
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector3Array();
 }
 
 PackedVector2Array BatchOps::separation_2d_radii(
     const PackedVector2Array& positions,
     const PackedFloat32Array& radii,
-    float strength
+    float strength,
+    const Ref<SpatialHash2D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.separation_2d_radii", positions.size());
     int64_t count = positions.size();
     if (count == 0 || radii.size() != count) {
         return PackedVector2Array();
@@ -478,12 +674,21 @@ PackedVector2Array BatchOps::separation_2d_radii(
     const float* rad_ptr = radii.ptr();
     Vector2* res_ptr = result.ptrw();
 
+    // A neighbor j matters within |r_i + r_j|, which never exceeds |r_i| + max |r|
+    float max_radius = 0.0f;
     for (int64_t i = 0; i < count; ++i) {
+        max_radius = std::max(max_radius, std::abs(rad_ptr[i]));
+    }
+
+    bool ok = for_each_neighborhood<SpatialGrid2D>(spatial, positions, 2.0f * max_radius,
+        [&](int64_t i) { return std::abs(rad_ptr[i]) + max_radius; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector2 force;
         const Vector2& my_pos = pos_ptr[i];
         float my_radius = rad_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             float combined_radius = my_radius + rad_ptr[j];
@@ -500,9 +705,9 @@ PackedVector2Array BatchOps::separation_2d_radii(
         }
 
         res_ptr[i] = force;
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector2Array();
 }
 
 // ========== COHESION ==========
@@ -510,8 +715,10 @@ PackedVector2Array BatchOps::separation_2d_radii(
 PackedVector2Array BatchOps::cohesion_2d(
     const PackedVector2Array& positions,
     float radius,
-    float strength
+    float strength,
+    const Ref<SpatialHash2D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.cohesion_2d", positions.size());
     int64_t count = positions.size();
     if (count == 0) {
         return PackedVector2Array();
@@ -524,13 +731,17 @@ PackedVector2Array BatchOps::cohesion_2d(
     Vector2* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid2D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector2 center_of_mass;
         int neighbor_count = 0;
         const Vector2& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             float dist_sq = (my_pos - pos_ptr[j]).length_squared();
@@ -552,16 +763,18 @@ PackedVector2Array BatchOps::cohesion_2d(
         } else {
             res_ptr[i] = Vector2();
         }
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector2Array();
 }
 
 PackedVector3Array BatchOps::cohesion_3d(
     const PackedVector3Array& positions,
     float radius,
-    float strength
+    float strength,
+    const Ref<SpatialHash3D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.cohesion_3d", positions.size());
     int64_t count = positions.size();
     if (count == 0) {
         return PackedVector3Array();
@@ -574,13 +787,17 @@ PackedVector3Array BatchOps::cohesion_3d(
     Vector3* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid3D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector3 center_of_mass;
         int neighbor_count = 0;
         const Vector3& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             float dist_sq = (my_pos - pos_ptr[j]).length_squared();
@@ -602,9 +819,9 @@ PackedVector3Array BatchOps::cohesion_3d(
         } else {
             res_ptr[i] = Vector3();
         }
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector3Array();
 }
 
 // ========== ALIGNMENT ==========
@@ -612,8 +829,10 @@ PackedVector3Array BatchOps::cohesion_3d(
 PackedVector2Array BatchOps::alignment_2d(
     const PackedVector2Array& positions,
     const PackedVector2Array& velocities,
-    float radius
+    float radius,
+    const Ref<SpatialHash2D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.alignment_2d", positions.size());
     int64_t count = positions.size();
     if (count == 0 || velocities.size() != count) {
         return PackedVector2Array();
@@ -627,13 +846,17 @@ PackedVector2Array BatchOps::alignment_2d(
     Vector2* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid2D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector2 avg_velocity;
         int neighbor_count = 0;
         const Vector2& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             float dist_sq = (my_pos - pos_ptr[j]).length_squared();
@@ -648,16 +871,18 @@ PackedVector2Array BatchOps::alignment_2d(
         } else {
             res_ptr[i] = vel_ptr[i];  // Keep current velocity if no neighbors
         }
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector2Array();
 }
 
 PackedVector3Array BatchOps::alignment_3d(
     const PackedVector3Array& positions,
     const PackedVector3Array& velocities,
-    float radius
+    float radius,
+    const Ref<SpatialHash3D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.alignment_3d", positions.size());
     int64_t count = positions.size();
     if (count == 0 || velocities.size() != count) {
         return PackedVector3Array();
@@ -671,13 +896,17 @@ PackedVector3Array BatchOps::alignment_3d(
     Vector3* res_ptr = result.ptrw();
 
     float radius_sq = radius * radius;
+    float search = std::abs(radius);
 
-    for (int64_t i = 0; i < count; ++i) {
+    bool ok = for_each_neighborhood<SpatialGrid3D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector3 avg_velocity;
         int neighbor_count = 0;
         const Vector3& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             float dist_sq = (my_pos - pos_ptr[j]).length_squared();
@@ -692,9 +921,9 @@ PackedVector3Array BatchOps::alignment_3d(
         } else {
             res_ptr[i] = vel_ptr[i];
         }
-    }
+    });
 
-    return result;
+    return ok ? result : PackedVector3Array();
 }
 
 // ========== COMBINED FLOCKING ==========
@@ -707,8 +936,10 @@ PackedVector2Array BatchOps::flock_2d(
     float alignment_radius,
     float separation_strength,
     float cohesion_strength,
-    float alignment_strength
+    float alignment_strength,
+    const Ref<SpatialHash2D>& spatial
 ) {
+    AGENTITE_PROFILE("BatchOps.flock_2d", positions.size());
     int64_t count = positions.size();
     if (count == 0 || velocities.size() != count) {
         return PackedVector2Array();
@@ -725,7 +956,12 @@ PackedVector2Array BatchOps::flock_2d(
     float coh_radius_sq = cohesion_radius * cohesion_radius;
     float align_radius_sq = alignment_radius * alignment_radius;
 
-    for (int64_t i = 0; i < count; ++i) {
+    // One neighbor search out to the largest radius feeds all three behaviors
+    float search = std::max({std::abs(separation_radius), std::abs(cohesion_radius), std::abs(alignment_radius)});
+
+    bool ok = for_each_neighborhood<SpatialGrid2D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
         Vector2 separation_force;
         Vector2 cohesion_center;
         Vector2 alignment_velocity;
@@ -735,7 +971,8 @@ PackedVector2Array BatchOps::flock_2d(
 
         const Vector2& my_pos = pos_ptr[i];
 
-        for (int64_t j = 0; j < count; ++j) {
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
             if (i == j) continue;
 
             Vector2 diff = my_pos - pos_ptr[j];
@@ -787,9 +1024,106 @@ PackedVector2Array BatchOps::flock_2d(
         }
 
         res_ptr[i] = total_force;
+    });
+
+    return ok ? result : PackedVector2Array();
+}
+
+PackedVector3Array BatchOps::flock_3d(
+    const PackedVector3Array& positions,
+    const PackedVector3Array& velocities,
+    float separation_radius,
+    float cohesion_radius,
+    float alignment_radius,
+    float separation_strength,
+    float cohesion_strength,
+    float alignment_strength,
+    const Ref<SpatialHash3D>& spatial
+) {
+    AGENTITE_PROFILE("BatchOps.flock_3d", positions.size());
+    int64_t count = positions.size();
+    if (count == 0 || velocities.size() != count) {
+        return PackedVector3Array();
     }
 
-    return result;
+    PackedVector3Array result;
+    result.resize(count);
+
+    const Vector3* pos_ptr = positions.ptr();
+    const Vector3* vel_ptr = velocities.ptr();
+    Vector3* res_ptr = result.ptrw();
+
+    float sep_radius_sq = separation_radius * separation_radius;
+    float coh_radius_sq = cohesion_radius * cohesion_radius;
+    float align_radius_sq = alignment_radius * alignment_radius;
+
+    float search = std::max({std::abs(separation_radius), std::abs(cohesion_radius), std::abs(alignment_radius)});
+
+    bool ok = for_each_neighborhood<SpatialGrid3D>(spatial, positions, search,
+        [&](int64_t) { return search; },
+        [&](int64_t i, const int32_t* neighbors, int32_t neighbor_total) {
+        Vector3 separation_force;
+        Vector3 cohesion_center;
+        Vector3 alignment_velocity;
+        int sep_count = 0;
+        int coh_count = 0;
+        int align_count = 0;
+
+        const Vector3& my_pos = pos_ptr[i];
+
+        for (int32_t k = 0; k < neighbor_total; ++k) {
+            int64_t j = neighbors[k];
+            if (i == j) continue;
+
+            Vector3 diff = my_pos - pos_ptr[j];
+            float dist_sq = diff.length_squared();
+
+            // Separation
+            if (dist_sq < sep_radius_sq && dist_sq > 0.0001f) {
+                float dist = std::sqrt(dist_sq);
+                float factor = (separation_radius - dist) / separation_radius;
+                separation_force += (diff / dist) * factor;
+                sep_count++;
+            }
+
+            // Cohesion
+            if (dist_sq < coh_radius_sq) {
+                cohesion_center += pos_ptr[j];
+                coh_count++;
+            }
+
+            // Alignment
+            if (dist_sq < align_radius_sq) {
+                alignment_velocity += vel_ptr[j];
+                align_count++;
+            }
+        }
+
+        Vector3 total_force;
+
+        if (sep_count > 0) {
+            total_force += separation_force * separation_strength;
+        }
+
+        if (coh_count > 0) {
+            cohesion_center /= static_cast<float>(coh_count);
+            Vector3 direction = cohesion_center - my_pos;
+            float dist = direction.length();
+            if (dist > 0.0001f) {
+                total_force += (direction / dist) * cohesion_strength;
+            }
+        }
+
+        if (align_count > 0) {
+            alignment_velocity /= static_cast<float>(align_count);
+            Vector3 align_diff = alignment_velocity - vel_ptr[i];
+            total_force += align_diff * alignment_strength;
+        }
+
+        res_ptr[i] = total_force;
+    });
+
+    return ok ? result : PackedVector3Array();
 }
 
 // ========== WANDER ==========
@@ -801,6 +1135,7 @@ PackedVector2Array BatchOps::wander_2d(
     float circle_radius,
     float angle_change
 ) {
+    AGENTITE_PROFILE("BatchOps.wander_2d", forward_directions.size());
     int64_t count = forward_directions.size();
     if (count == 0 || wander_angles.size() != count) {
         return PackedVector2Array();
@@ -835,6 +1170,7 @@ PackedVector2Array BatchOps::wander_2d(
         res_ptr[i] = (circle_center + displacement).normalized();
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -848,6 +1184,7 @@ PackedVector2Array BatchOps::avoid_circles_2d(
     float lookahead_distance,
     float avoidance_strength
 ) {
+    AGENTITE_PROFILE("BatchOps.avoid_circles_2d", positions.size());
     int64_t entity_count = positions.size();
     int64_t obstacle_count = obstacle_centers.size();
 
@@ -913,39 +1250,61 @@ PackedVector2Array BatchOps::avoid_circles_2d(
         res_ptr[i] = avoidance_force;
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
 // ========== VELOCITY LIMITING ==========
 
-PackedVector2Array BatchOps::limit_velocity_2d(
-    const PackedVector2Array& velocities,
-    float max_speed
-) {
-    int64_t count = velocities.size();
-    if (count == 0) {
-        return PackedVector2Array();
-    }
+template <typename V>
+static void limit_velocity(const V* velocities, float max_speed, V* out, int64_t count) {
+    float max_speed_sq = max_speed * max_speed;
 
-    PackedVector2Array result;
-    result.resize(count);
+    for (int64_t i = 0; i < count; ++i) {
+        V vel = velocities[i];
+        float speed_sq = vel.length_squared();
 
-    const Vector2* vel_ptr = velocities.ptr();
-    Vector2* res_ptr = result.ptrw();
+        if (speed_sq > max_speed_sq) {
+            out[i] = vel.normalized() * max_speed;
+        } else {
+            out[i] = vel;
+        }
+    }
+}
 
+template <typename V>
+static void limit_velocity_range(const V* velocities, float min_speed, float max_speed, V* out, int64_t count) {
+    float min_speed_sq = min_speed * min_speed;
     float max_speed_sq = max_speed * max_speed;
 
     for (int64_t i = 0; i < count; ++i) {
-        Vector2 vel = vel_ptr[i];
+        V vel = velocities[i];
         float speed_sq = vel.length_squared();
 
         if (speed_sq > max_speed_sq) {
-            res_ptr[i] = vel.normalized() * max_speed;
+            out[i] = vel.normalized() * max_speed;
+        } else if (speed_sq > 0.0001f && speed_sq < min_speed_sq) {
+            out[i] = vel.normalized() * min_speed;
         } else {
-            res_ptr[i] = vel;
+            out[i] = vel;
         }
     }
+}
 
+PackedVector2Array BatchOps::limit_velocity_2d(
+    const PackedVector2Array& velocities,
+    float max_speed
+) {
+    AGENTITE_PROFILE("BatchOps.limit_velocity_2d", velocities.size());
+    int64_t count = velocities.size();
+    if (count == 0) {
+        return PackedVector2Array();
+    }
+
+    PackedVector2Array result;
+    result.resize(count);
+    limit_velocity(velocities.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -953,6 +1312,7 @@ PackedVector3Array BatchOps::limit_velocity_3d(
     const PackedVector3Array& velocities,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.limit_velocity_3d", velocities.size());
     int64_t count = velocities.size();
     if (count == 0) {
         return PackedVector3Array();
@@ -960,23 +1320,8 @@ PackedVector3Array BatchOps::limit_velocity_3d(
 
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* vel_ptr = velocities.ptr();
-    Vector3* res_ptr = result.ptrw();
-
-    float max_speed_sq = max_speed * max_speed;
-
-    for (int64_t i = 0; i < count; ++i) {
-        Vector3 vel = vel_ptr[i];
-        float speed_sq = vel.length_squared();
-
-        if (speed_sq > max_speed_sq) {
-            res_ptr[i] = vel.normalized() * max_speed;
-        } else {
-            res_ptr[i] = vel;
-        }
-    }
-
+    limit_velocity(velocities.ptr(), max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector3));
     return result;
 }
 
@@ -985,6 +1330,7 @@ PackedVector2Array BatchOps::limit_velocity_range_2d(
     float min_speed,
     float max_speed
 ) {
+    AGENTITE_PROFILE("BatchOps.limit_velocity_range_2d", velocities.size());
     int64_t count = velocities.size();
     if (count == 0) {
         return PackedVector2Array();
@@ -992,27 +1338,49 @@ PackedVector2Array BatchOps::limit_velocity_range_2d(
 
     PackedVector2Array result;
     result.resize(count);
+    limit_velocity_range(velocities.ptr(), min_speed, max_speed, result.ptrw(), count);
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
+    return result;
+}
 
-    const Vector2* vel_ptr = velocities.ptr();
-    Vector2* res_ptr = result.ptrw();
+void BatchOps::limit_velocity_2d_in_place(const Ref<Vector2Buffer>& velocities, float max_speed) {
+    if (!vector_buffer::check(velocities, "limit_velocity_2d_in_place", -1)) {
+        return;
+    }
+    Vector2* ptr = velocities->data().ptrw();
+    limit_velocity(ptr, max_speed, ptr, velocities->size());
+}
 
-    float min_speed_sq = min_speed * min_speed;
-    float max_speed_sq = max_speed * max_speed;
+void BatchOps::limit_velocity_3d_in_place(const Ref<Vector3Buffer>& velocities, float max_speed) {
+    if (!vector_buffer::check(velocities, "limit_velocity_3d_in_place", -1)) {
+        return;
+    }
+    Vector3* ptr = velocities->data().ptrw();
+    limit_velocity(ptr, max_speed, ptr, velocities->size());
+}
 
-    for (int64_t i = 0; i < count; ++i) {
-        Vector2 vel = vel_ptr[i];
-        float speed_sq = vel.length_squared();
+void BatchOps::limit_velocity_range_2d_in_place(const Ref<Vector2Buffer>& velocities, float min_speed, float max_speed) {
+    if (!vector_buffer::check(velocities, "limit_velocity_range_2d_in_place", -1)) {
+        return;
+    }
+    Vector2* ptr = velocities->data().ptrw();
+    limit_velocity_range(ptr, min_speed, max_speed, ptr, velocities->size());
+}
 
-        if (speed_sq > max_speed_sq) {
-            res_ptr[i] = vel.normalized() * max_speed;
-        } else if (speed_sq > 0.0001f && speed_sq < min_speed_sq) {
-            res_ptr[i] = vel.normalized() * min_speed;
-        } else {
-            res_ptr[i] = vel;
-        }
+void BatchOps::limit_velocity_store_2d(const Ref<AgentStore2D>& store, float max_speed) {
+    if (!check_store(store, "limit_velocity_store_2d", -1)) {
+        return;
     }
+    Vector2* ptr = store->velocity_column().ptrw();
+    limit_velocity(ptr, max_speed, ptr, store->get_count());
+}
 
-    return result;
+void BatchOps::limit_velocity_store_3d(const Ref<AgentStore3D>& store, float max_speed) {
+    if (!check_store(store, "limit_velocity_store_3d", -1)) {
+        return;
+    }
+    Vector3* ptr = store->velocity_column().ptrw();
+    limit_velocity(ptr, max_speed, ptr, store->get_count());
 }
 
 }
@@ -21,6 +21,12 @@
 #ifndef AGENTITE_BATCH_OPS_HPP
 #define AGENTITE_BATCH_OPS_HPP
 
+#include "arrays/agent_store_2d.hpp"
+#include "arrays/agent_store_3d.hpp"
+#include "arrays/vector_buffer.hpp"
+#include "spatial/spatial_hash_2d.hpp"
+#include "spatial/spatial_hash_3d.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
@@ -62,6 +68,19 @@ public:
         float delta
     );
 
+    // In-place variants: update the buffer's own memory (sizes must match)
+    static void apply_velocities_2d_in_place(const Ref<Vector2Buffer>& positions, const PackedVector2Array& velocities, float delta);
+    static void apply_velocities_3d_in_place(const Ref<Vector3Buffer>& positions, const PackedVector3Array& velocities, float delta);
+    static void apply_accelerations_2d_in_place(const Ref<Vector2Buffer>& velocities, const PackedVector2Array& accelerations, float delta);
+    static void apply_accelerations_3d_in_place(const Ref<Vector3Buffer>& velocities, const PackedVector3Array& accelerations, float delta);
+
+    // Store variants: update an AgentStore's columns in place
+    // (positions += velocities * delta; velocities += accelerations * delta)
+    static void apply_velocities_store_2d(const Ref<AgentStore2D>& store, float delta);
+    static void apply_velocities_store_3d(const Ref<AgentStore3D>& store, float delta);
+    static void apply_accelerations_store_2d(const Ref<AgentStore2D>& store, const PackedVector2Array& accelerations, float delta);
+    static void apply_accelerations_store_3d(const Ref<AgentStore3D>& store, const PackedVector3Array& accelerations, float delta);
+
     // ========== STEERING BEHAVIORS ==========
     // All steering methods return desired velocity vectors (not accelerations)
     // To get acceleration: (desired - current_velocity).limit(max_force)
@@ -107,27 +126,47 @@ public:
         float slowing_radius
     );
 
+    // *_into variants: write the desired velocities into out, reusing its memory
+    static void seek_batch_into(const PackedVector2Array& positions, const PackedVector2Array& targets,
+                                float max_speed, const Ref<Vector2Buffer>& out);
+    static void seek_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& targets,
+                                   float max_speed, const Ref<Vector3Buffer>& out);
+    static void flee_batch_into(const PackedVector2Array& positions, const PackedVector2Array& threats,
+                                float max_speed, const Ref<Vector2Buffer>& out);
+    static void flee_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& threats,
+                                   float max_speed, const Ref<Vector3Buffer>& out);
+    static void arrive_batch_into(const PackedVector2Array& positions, const PackedVector2Array& targets,
+                                  float max_speed, float slowing_radius, const Ref<Vector2Buffer>& out);
+    static void arrive_batch_3d_into(const PackedVector3Array& positions, const PackedVector3Array& targets,
+                                     float max_speed, float slowing_radius, const Ref<Vector3Buffer>& out);
+
     // ========== FLOCKING / SEPARATION ==========
     // Separation: repel from nearby entities
     // Returns separation force for each entity
-    // Uses brute force O(n^2) - for large counts, use spatial hash version
+    //
+    // All flocking methods only visit neighbors within their radius: through the
+    // optional spatial hash (built from the same positions this frame), or through
+    // an internal grid for 128+ entities. Results match the all-pairs loop exactly.
 
     static PackedVector2Array separation_2d(
         const PackedVector2Array& positions,
         float radius,
-        float strength
+        float strength,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>()
     );
     static PackedVector3Array separation_3d(
         const PackedVector3Array& positions,
         float radius,
-        float strength
+        float strength,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>()
     );
 
     // Separation with different radii per entity
     static PackedVector2Array separation_2d_radii(
         const PackedVector2Array& positions,
         const PackedFloat32Array& radii,
-        float strength
+        float strength,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>()
     );
 
     // ========== COHESION ==========
@@ -137,12 +176,14 @@ public:
     static PackedVector2Array cohesion_2d(
         const PackedVector2Array& positions,
         float radius,
-        float strength
+        float strength,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>()
     );
     static PackedVector3Array cohesion_3d(
         const PackedVector3Array& positions,
         float radius,
-        float strength
+        float strength,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>()
     );
 
     // ========== ALIGNMENT ==========
@@ -152,17 +193,20 @@ public:
     static PackedVector2Array alignment_2d(
         const PackedVector2Array& positions,
         const PackedVector2Array& velocities,
-        float radius
+        float radius,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>()
     );
     static PackedVector3Array alignment_3d(
         const PackedVector3Array& positions,
         const PackedVector3Array& velocities,
-        float radius
+        float radius,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>()
     );
 
     // ========== COMBINED FLOCKING ==========
     // Boids-style flocking: separation + cohesion + alignment
     // Returns combined steering force
+    // One neighbor search out to the largest radius feeds all three behaviors
 
     static PackedVector2Array flock_2d(
         const PackedVector2Array& positions,
@@ -172,7 +216,19 @@ public:
         float alignment_radius,
         float separation_strength,
         float cohesion_strength,
-        float alignment_strength
+        float alignment_strength,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>()
+    );
+    static PackedVector3Array flock_3d(
+        const PackedVector3Array& positions,
+        const PackedVector3Array& velocities,
+        float separation_radius,
+        float cohesion_radius,
+        float alignment_radius,
+        float separation_strength,
+        float cohesion_strength,
+        float alignment_strength,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>()
     );
 
     // ========== WANDER ==========
@@ -218,6 +274,13 @@ public:
         float min_speed,
         float max_speed
     );
+
+    // In-place variants
+    static void limit_velocity_2d_in_place(const Ref<Vector2Buffer>& velocities, float max_speed);
+    static void limit_velocity_3d_in_place(const Ref<Vector3Buffer>& velocities, float max_speed);
+    static void limit_velocity_range_2d_in_place(const Ref<Vector2Buffer>& velocities, float min_speed, float max_speed);
+    static void limit_velocity_store_2d(const Ref<AgentStore2D>& store, float max_speed);
+    static void limit_velocity_store_3d(const Ref<AgentStore3D>& store, float max_speed);
 };
 
 }
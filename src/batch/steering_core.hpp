@@ -0,0 +1,414 @@
+/**
+ * SteeringCore - Agent state and the fused steering step shared by
+ * SteeringIntegrator2D and SteeringIntegrator3D
+ *
+ * Positions, velocities and targets are stored as structure of arrays (one
+ * float array per axis). step() runs one loop over the agents that adds up
+ * the weighted behaviors, clamps the steering force, then integrates
+ * velocity and position. This replaces the chain of seek_batch,
+ * separation_2d, avoid_circles_2d, apply_accelerations_2d,
+ * limit_velocity_2d and apply_velocities_2d with a single pass:
+ *
+ *   steering = seek_weight * seek (or arrive, if arrive_radius > 0)
+ *            + separation(strength = separation_weight)
+ *            + avoidance(strength = avoidance_weight)
+ *   steering = clamp_length(steering, max_force)       (if max_force > 0)
+ *   velocity = limit(velocity + steering * delta, max_speed)
+ *   position = position + velocity * delta
+ *
+ * Every behavior reads the state from the start of the step and results go
+ * to a second set of arrays, so the order agents are processed in does not
+ * matter and a threaded step is identical to a serial one.
+ *
+ * Separation neighbors come from a uniform grid rebuilt every step: agents
+ * are counting-sorted by cell and their positions copied in cell order, so
+ * the neighbor scan of each row of cells reads one contiguous range. When
+ * separating, the step walks the grid cell by cell, so the cells an agent
+ * scans were mostly just read for the previous cell.
+ *
+ * Usage (internal):
+ *   SteeringCore<2> core;
+ *   core.resize(count);
+ *   core.position[0][i] = x; core.position[1][i] = y;
+ *   core.step(delta);
+ */
+
+#ifndef AGENTITE_STEERING_CORE_HPP
+#define AGENTITE_STEERING_CORE_HPP
+
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace godot {
+
+// Minimum number of agents (or separation grid cells) per chunk in a threaded step
+static const int64_t STEERING_CHUNK = 256;
+static const int64_t STEERING_CELL_CHUNK = 1024;
+
+template <int D>
+class SteeringCore {
+public:
+    struct Config {
+        float max_speed = 100.0f;
+        float max_force = 0.0f;  // 0 = unclamped
+        float seek_weight = 1.0f;
+        float arrive_radius = 0.0f;  // 0 = seek at full speed
+        float separation_radius = 0.0f;
+        float separation_weight = 0.0f;
+        float avoidance_lookahead = 0.0f;
+        float avoidance_weight = 0.0f;
+        bool threaded = true;
+    };
+
+    Config config;
+
+    std::vector<float> position[D];
+    std::vector<float> velocity[D];
+    std::vector<float> target[D];  // Empty when seeking is off
+    std::vector<float> obstacle_center[D];
+    std::vector<float> obstacle_radius;
+
+    int64_t size() const { return static_cast<int64_t>(position[0].size()); }
+    bool has_targets() const { return !target[0].empty(); }
+
+    // Resize the agent arrays; new agents are at the origin and stopped
+    void resize(int64_t count) {
+        for (int d = 0; d < D; d++) {
+            position[d].resize(count, 0.0f);
+            velocity[d].resize(count, 0.0f);
+        }
+    }
+
+    void clear() {
+        for (int d = 0; d < D; d++) {
+            position[d].clear();
+            velocity[d].clear();
+            target[d].clear();
+            obstacle_center[d].clear();
+        }
+        obstacle_radius.clear();
+    }
+
+    void step(float delta) {
+        int64_t count = size();
+        if (count == 0) {
+            return;
+        }
+
+        bool separating = config.separation_weight != 0.0f && config.separation_radius > 0.0f;
+        if (separating) {
+            build_grid();
+        }
+
+        for (int d = 0; d < D; d++) {
+            next_position[d].resize(count);
+            next_velocity[d].resize(count);
+        }
+
+        if (separating) {
+            // Walk the grid cell by cell: agents of one cell share their neighbor rows,
+            // and neighboring cells were just read by the previous cell
+            int64_t cell_total = static_cast<int64_t>(cell_start.size()) - 1;
+            run(cell_total, STEERING_CELL_CHUNK, [&](int64_t begin, int64_t end) {
+                for (int64_t c = begin; c < end; c++) {
+                    if (cell_start[c] == cell_start[c + 1]) continue;
+                    CellRange range = cell_range(c);
+                    for (int32_t k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                        step_agent(cell_agent[k], delta, &range);
+                    }
+                }
+            });
+        } else {
+            run(count, STEERING_CHUNK, [&](int64_t begin, int64_t end) {
+                for (int64_t i = begin; i < end; i++) {
+                    step_agent(i, delta, nullptr);
+                }
+            });
+        }
+
+        for (int d = 0; d < D; d++) {
+            std::swap(position[d], next_position[d]);
+            std::swap(velocity[d], next_velocity[d]);
+        }
+    }
+
+private:
+    std::vector<float> next_position[D];
+    std::vector<float> next_velocity[D];
+
+    // Separation grid: agents counting-sorted by cell
+    float cell_size = 1.0f;
+    float inv_cell_size = 1.0f;
+    float grid_min[D];
+    int64_t grid_dims[D];
+    float last_cell[D];  // grid_dims - 1, for clamping
+    std::vector<int32_t> cell_start;  // Cell c holds sorted slots [cell_start[c], cell_start[c + 1])
+    std::vector<int32_t> cell_agent;  // Agent index of each sorted slot
+    std::vector<float> cell_position[D];
+    std::vector<int32_t> agent_cell;  // Build scratch, kept to reuse its memory
+    std::vector<int32_t> cell_next;
+
+    // Neighbor cells of one cell: rows along y (and z), each a run of cells along x.
+    // Unused axes collapse to a single row.
+    struct CellRange {
+        int64_t lo[3] = {0, 0, 0};
+        int64_t hi[3] = {0, 0, 0};
+        int64_t stride[3] = {0, 0, 0};
+    };
+
+    template <typename Body>
+    void run(int64_t count, int64_t min_chunk, const Body& body) const {
+        if (config.threaded) {
+            parallel::for_range(count, min_chunk, body);
+        } else {
+            body(0, count);
+        }
+    }
+
+    CellRange cell_range(int64_t cell) const {
+        CellRange range;
+        int64_t stride = 1;
+        for (int d = 0; d < D; d++) {
+            int64_t c = cell % grid_dims[d];
+            cell /= grid_dims[d];
+            range.lo[d] = std::max<int64_t>(c - 1, 0);
+            range.hi[d] = std::min<int64_t>(c + 1, grid_dims[d] - 1);
+            range.stride[d] = stride;
+            stride *= grid_dims[d];
+        }
+        return range;
+    }
+
+    // Branch-free: random positions would mispredict every bounds check
+    int64_t cell_coord(float value, int d) const {
+        float c = (value - grid_min[d]) * inv_cell_size;
+        c = std::min(std::max(0.0f, c), last_cell[d]);  // max(0, NaN) is 0
+        return static_cast<int64_t>(c);
+    }
+
+    void build_grid() {
+        int64_t count = size();
+        float grid_max[D];
+        for (int d = 0; d < D; d++) {
+            // NaN positions compare false and are left out of the bounds
+            float lo = std::numeric_limits<float>::max();
+            float hi = std::numeric_limits<float>::lowest();
+            for (float value : position[d]) {
+                lo = std::min(value, lo);
+                hi = std::max(value, hi);
+            }
+            grid_min[d] = std::min(lo, hi);
+            grid_max[d] = hi;
+        }
+
+        // A cell at least as large as the radius keeps every neighbor within one cell.
+        // The small margin absorbs rounding in cell_coord: a pair it could still split
+        // is right at the radius, where the separation force is zero anyway.
+        // Grow the cells when sparse, far-apart agents would need too many of them.
+        double cell_limit = static_cast<double>(count) * 4.0 + 64.0;
+        cell_size = config.separation_radius * 1.001f;
+        double cells = 1.0;
+        for (int attempt = 0; attempt < 8; attempt++) {
+            cells = 1.0;
+            for (int d = 0; d < D; d++) {
+                double extent = static_cast<double>(grid_max[d]) - grid_min[d];
+                cells *= std::floor(extent / cell_size) + 1.0;
+            }
+            if (cells <= cell_limit) break;
+            cell_size *= static_cast<float>(std::pow(cells / cell_limit, 1.0 / D)) * 1.01f;
+        }
+        if (!(cells <= cell_limit)) {
+            // Non-finite positions: everything in one cell
+            cell_size = std::numeric_limits<float>::max();
+        }
+
+        int64_t cell_total = 1;
+        for (int d = 0; d < D; d++) {
+            double extent = static_cast<double>(grid_max[d]) - grid_min[d];
+            double dims = std::floor(extent / cell_size) + 1.0;
+            grid_dims[d] = dims >= 1.0 && dims <= cell_limit ? static_cast<int64_t>(dims) : 1;
+            last_cell[d] = static_cast<float>(grid_dims[d] - 1);
+            cell_total *= grid_dims[d];
+        }
+        inv_cell_size = cell_size < std::numeric_limits<float>::max() ? 1.0f / cell_size : 0.0f;
+
+        agent_cell.resize(count);
+        cell_start.assign(cell_total + 1, 0);
+        for (int64_t i = 0; i < count; i++) {
+            int64_t cell = 0;
+            for (int d = D - 1; d >= 0; d--) {
+                cell = cell * grid_dims[d] + cell_coord(position[d][i], d);
+            }
+            agent_cell[i] = static_cast<int32_t>(cell);
+            cell_start[cell + 1]++;
+        }
+        for (int64_t c = 0; c < cell_total; c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+
+        cell_agent.resize(count);
+        for (int d = 0; d < D; d++) {
+            cell_position[d].resize(count);
+        }
+        cell_next.assign(cell_start.begin(), cell_start.end() - 1);
+        for (int64_t i = 0; i < count; i++) {
+            int32_t slot = cell_next[agent_cell[i]]++;
+            cell_agent[slot] = static_cast<int32_t>(i);
+            for (int d = 0; d < D; d++) {
+                cell_position[d][slot] = position[d][i];
+            }
+        }
+    }
+
+    static float length(const float* v) {
+        float sq = 0.0f;
+        for (int d = 0; d < D; d++) sq += v[d] * v[d];
+        return std::sqrt(sq);
+    }
+
+    void add_seek(const float* p, int64_t i, float* steering) const {
+        float to[D];
+        for (int d = 0; d < D; d++) to[d] = target[d][i] - p[d];
+        float distance = length(to);
+        if (distance <= 0.0001f) return;
+
+        float speed = config.max_speed;
+        if (config.arrive_radius > 0.0f && distance < config.arrive_radius) {
+            speed = config.max_speed * (distance / config.arrive_radius);
+        }
+        for (int d = 0; d < D; d++) steering[d] += (to[d] / distance) * speed * config.seek_weight;
+    }
+
+    void add_separation(const float* p, const CellRange& range, float* steering) const {
+        float radius = config.separation_radius;
+        float radius_sq = radius * radius;
+        float strength = config.separation_weight;
+
+        const float* cell_pos[D];
+        for (int d = 0; d < D; d++) cell_pos[d] = cell_position[d].data();
+        const int32_t* starts = cell_start.data();
+        float inv_radius = 1.0f / radius;
+
+        float force[D] = {};
+        for (int64_t z = range.lo[2]; z <= range.hi[2]; z++) {
+            for (int64_t y = range.lo[1]; y <= range.hi[1]; y++) {
+                // Cells along x are adjacent, so their agents form one contiguous range
+                int64_t row = y * range.stride[1] + z * range.stride[2];
+                int32_t first = starts[row + range.lo[0]];
+                int32_t last = starts[row + range.hi[0] + 1];
+                for (int32_t k = first; k < last; k++) {
+                    float diff[D];
+                    float dist_sq = 0.0f;
+                    for (int d = 0; d < D; d++) {
+                        diff[d] = p[d] - cell_pos[d][k];
+                        dist_sq += diff[d] * diff[d];
+                    }
+                    // The agent itself (and any agent at the same spot) fails the lower bound
+                    bool inside = dist_sq < radius_sq && dist_sq > 0.0001f;
+                    float dist = std::sqrt(dist_sq);
+                    // Force inversely proportional to distance
+                    float scale = inside ? (radius - dist) * inv_radius * strength / dist : 0.0f;
+                    for (int d = 0; d < D; d++) force[d] += diff[d] * scale;
+                }
+            }
+        }
+        for (int d = 0; d < D; d++) steering[d] += force[d];
+    }
+
+    void add_avoidance(const float* p, const float* v, float* steering) const {
+        float speed = length(v);
+        if (speed < 0.0001f) return;
+
+        float lookahead = config.avoidance_lookahead;
+        float ahead[D];
+        float ahead_half[D];
+        for (int d = 0; d < D; d++) {
+            float direction = v[d] / speed;
+            ahead[d] = p[d] + direction * lookahead;
+            ahead_half[d] = p[d] + direction * (lookahead * 0.5f);
+        }
+
+        // Closest obstacle that the look-ahead points are inside of
+        float closest_sq = lookahead * lookahead * 4.0f;
+        int64_t closest = -1;
+        int64_t obstacle_count = static_cast<int64_t>(obstacle_radius.size());
+        for (int64_t j = 0; j < obstacle_count; j++) {
+            float ahead_sq = 0.0f;
+            float half_sq = 0.0f;
+            float center_sq = 0.0f;
+            for (int d = 0; d < D; d++) {
+                float c = obstacle_center[d][j];
+                ahead_sq += (ahead[d] - c) * (ahead[d] - c);
+                half_sq += (ahead_half[d] - c) * (ahead_half[d] - c);
+                center_sq += (p[d] - c) * (p[d] - c);
+            }
+            float radius_sq = obstacle_radius[j] * obstacle_radius[j];
+            if ((ahead_sq < radius_sq || half_sq < radius_sq) && center_sq < closest_sq) {
+                closest_sq = center_sq;
+                closest = j;
+            }
+        }
+        if (closest < 0) return;
+
+        // Steer away from the obstacle's center
+        float away[D];
+        for (int d = 0; d < D; d++) away[d] = ahead[d] - obstacle_center[d][closest];
+        float away_length = length(away);
+        if (away_length > 0.0001f) {
+            for (int d = 0; d < D; d++) steering[d] += (away[d] / away_length) * config.avoidance_weight;
+        }
+    }
+
+    // Integrate agent i; cells is its neighbor range when separating
+    void step_agent(int64_t i, float delta, const CellRange* cells) {
+        float p[D];
+        float v[D];
+        float steering[D] = {};
+        for (int d = 0; d < D; d++) {
+            p[d] = position[d][i];
+            v[d] = velocity[d][i];
+        }
+
+        if (config.seek_weight != 0.0f && has_targets()) {
+            add_seek(p, i, steering);
+        }
+        if (cells) {
+            add_separation(p, *cells, steering);
+        }
+        if (config.avoidance_weight != 0.0f && !obstacle_radius.empty()) {
+            add_avoidance(p, v, steering);
+        }
+
+        if (config.max_force > 0.0f) {
+            float force = length(steering);
+            if (force > config.max_force) {
+                for (int d = 0; d < D; d++) steering[d] = steering[d] / force * config.max_force;
+            }
+        }
+
+        float speed_sq = 0.0f;
+        for (int d = 0; d < D; d++) {
+            v[d] += steering[d] * delta;
+            speed_sq += v[d] * v[d];
+        }
+        if (speed_sq > config.max_speed * config.max_speed) {
+            float speed = std::sqrt(speed_sq);
+            for (int d = 0; d < D; d++) v[d] = v[d] / speed * config.max_speed;
+        }
+
+        for (int d = 0; d < D; d++) {
+            next_velocity[d][i] = v[d];
+            next_position[d][i] = p[d] + v[d] * delta;
+        }
+    }
+};
+
+}
+
+#endif // AGENTITE_STEERING_CORE_HPP
@@ -0,0 +1,248 @@
+/**
+ * SteeringIntegrator2D Implementation
+ */
+
+#include "steering_integrator_2d.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+void SteeringIntegrator2D::_bind_methods() {
+    // Agents
+    ClassDB::bind_method(D_METHOD("set_agents", "positions", "velocities"), &SteeringIntegrator2D::set_agents,
+                         DEFVAL(PackedVector2Array()));
+    ClassDB::bind_method(D_METHOD("set_positions", "positions"), &SteeringIntegrator2D::set_positions);
+    ClassDB::bind_method(D_METHOD("set_velocities", "velocities"), &SteeringIntegrator2D::set_velocities);
+    ClassDB::bind_method(D_METHOD("set_targets", "targets"), &SteeringIntegrator2D::set_targets);
+    ClassDB::bind_method(D_METHOD("set_obstacles", "centers", "radii"), &SteeringIntegrator2D::set_obstacles);
+    ClassDB::bind_method(D_METHOD("get_positions"), &SteeringIntegrator2D::get_positions);
+    ClassDB::bind_method(D_METHOD("get_velocities"), &SteeringIntegrator2D::get_velocities);
+    ClassDB::bind_method(D_METHOD("get_count"), &SteeringIntegrator2D::get_count);
+    ClassDB::bind_method(D_METHOD("clear"), &SteeringIntegrator2D::clear);
+
+    // Step
+    ClassDB::bind_method(D_METHOD("step", "delta"), &SteeringIntegrator2D::step);
+
+    // Behavior settings
+    ClassDB::bind_method(D_METHOD("set_max_speed", "max_speed"), &SteeringIntegrator2D::set_max_speed);
+    ClassDB::bind_method(D_METHOD("get_max_speed"), &SteeringIntegrator2D::get_max_speed);
+    ClassDB::bind_method(D_METHOD("set_max_force", "max_force"), &SteeringIntegrator2D::set_max_force);
+    ClassDB::bind_method(D_METHOD("get_max_force"), &SteeringIntegrator2D::get_max_force);
+    ClassDB::bind_method(D_METHOD("set_seek_weight", "seek_weight"), &SteeringIntegrator2D::set_seek_weight);
+    ClassDB::bind_method(D_METHOD("get_seek_weight"), &SteeringIntegrator2D::get_seek_weight);
+    ClassDB::bind_method(D_METHOD("set_arrive_radius", "arrive_radius"), &SteeringIntegrator2D::set_arrive_radius);
+    ClassDB::bind_method(D_METHOD("get_arrive_radius"), &SteeringIntegrator2D::get_arrive_radius);
+    ClassDB::bind_method(D_METHOD("set_separation_radius", "separation_radius"), &SteeringIntegrator2D::set_separation_radius);
+    ClassDB::bind_method(D_METHOD("get_separation_radius"), &SteeringIntegrator2D::get_separation_radius);
+    ClassDB::bind_method(D_METHOD("set_separation_weight", "separation_weight"), &SteeringIntegrator2D::set_separation_weight);
+    ClassDB::bind_method(D_METHOD("get_separation_weight"), &SteeringIntegrator2D::get_separation_weight);
+    ClassDB::bind_method(D_METHOD("set_avoidance_lookahead", "avoidance_lookahead"), &SteeringIntegrator2D::set_avoidance_lookahead);
+    ClassDB::bind_method(D_METHOD("get_avoidance_lookahead"), &SteeringIntegrator2D::get_avoidance_lookahead);
+    ClassDB::bind_method(D_METHOD("set_avoidance_weight", "avoidance_weight"), &SteeringIntegrator2D::set_avoidance_weight);
+    ClassDB::bind_method(D_METHOD("get_avoidance_weight"), &SteeringIntegrator2D::get_avoidance_weight);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &SteeringIntegrator2D::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &SteeringIntegrator2D::get_threaded);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_speed"), "set_max_speed", "get_max_speed");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_force"), "set_max_force", "get_max_force");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "seek_weight"), "set_seek_weight", "get_seek_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "arrive_radius"), "set_arrive_radius", "get_arrive_radius");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "separation_radius"), "set_separation_radius", "get_separation_radius");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "separation_weight"), "set_separation_weight", "get_separation_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "avoidance_lookahead"), "set_avoidance_lookahead", "get_avoidance_lookahead");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "avoidance_weight"), "set_avoidance_weight", "get_avoidance_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+}
+
+SteeringIntegrator2D::SteeringIntegrator2D() {
+}
+
+SteeringIntegrator2D::~SteeringIntegrator2D() {
+}
+
+// ========== AGENTS ==========
+
+void SteeringIntegrator2D::set_agents(const PackedVector2Array& positions, const PackedVector2Array& velocities) {
+    int64_t count = positions.size();
+    if (!velocities.is_empty() && velocities.size() != count) {
+        UtilityFunctions::push_error("AgentiteG: set_agents positions and velocities sizes differ");
+        return;
+    }
+
+    if (count != core.size()) {
+        for (int d = 0; d < 2; d++) {
+            core.target[d].clear();
+        }
+    }
+    core.resize(count);
+    set_positions(positions);
+    if (velocities.is_empty()) {
+        for (int d = 0; d < 2; d++) {
+            std::fill(core.velocity[d].begin(), core.velocity[d].end(), 0.0f);
+        }
+    } else {
+        set_velocities(velocities);
+    }
+}
+
+void SteeringIntegrator2D::set_positions(const PackedVector2Array& positions) {
+    if (positions.size() != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_positions size must match the agent count");
+        return;
+    }
+    const Vector2* src = positions.ptr();
+    for (int64_t i = 0; i < core.size(); i++) {
+        core.position[0][i] = src[i].x;
+        core.position[1][i] = src[i].y;
+    }
+}
+
+void SteeringIntegrator2D::set_velocities(const PackedVector2Array& velocities) {
+    if (velocities.size() != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_velocities size must match the agent count");
+        return;
+    }
+    const Vector2* src = velocities.ptr();
+    for (int64_t i = 0; i < core.size(); i++) {
+        core.velocity[0][i] = src[i].x;
+        core.velocity[1][i] = src[i].y;
+    }
+}
+
+void SteeringIntegrator2D::set_targets(const PackedVector2Array& targets) {
+    int64_t count = targets.size();
+    if (count != 0 && count != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_targets size must match the agent count");
+        return;
+    }
+    const Vector2* src = targets.ptr();
+    core.target[0].resize(count);
+    core.target[1].resize(count);
+    for (int64_t i = 0; i < count; i++) {
+        core.target[0][i] = src[i].x;
+        core.target[1][i] = src[i].y;
+    }
+}
+
+void SteeringIntegrator2D::set_obstacles(const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+    int64_t count = centers.size();
+    if (radii.size() != count) {
+        UtilityFunctions::push_error("AgentiteG: set_obstacles centers and radii sizes differ");
+        return;
+    }
+    const Vector2* src = centers.ptr();
+    core.obstacle_center[0].resize(count);
+    core.obstacle_center[1].resize(count);
+    core.obstacle_radius.assign(radii.ptr(), radii.ptr() + count);
+    for (int64_t i = 0; i < count; i++) {
+        core.obstacle_center[0][i] = src[i].x;
+        core.obstacle_center[1][i] = src[i].y;
+    }
+}
+
+PackedVector2Array SteeringIntegrator2D::get_positions() const {
+    PackedVector2Array result;
+    result.resize(core.size());
+    Vector2* dst = result.ptrw();
+    for (int64_t i = 0; i < core.size(); i++) {
+        dst[i] = Vector2(core.position[0][i], core.position[1][i]);
+    }
+    return result;
+}
+
+PackedVector2Array SteeringIntegrator2D::get_velocities() const {
+    PackedVector2Array result;
+    result.resize(core.size());
+    Vector2* dst = result.ptrw();
+    for (int64_t i = 0; i < core.size(); i++) {
+        dst[i] = Vector2(core.velocity[0][i], core.velocity[1][i]);
+    }
+    return result;
+}
+
+int64_t SteeringIntegrator2D::get_count() const {
+    return core.size();
+}
+
+void SteeringIntegrator2D::clear() {
+    core.clear();
+}
+
+// ========== STEP ==========
+
+void SteeringIntegrator2D::step(float delta) {
+    AGENTITE_PROFILE("SteeringIntegrator2D.step", get_count());
+    core.step(delta);
+}
+
+// ========== BEHAVIOR SETTINGS ==========
+
+void SteeringIntegrator2D::set_max_speed(float p_max_speed) {
+    core.config.max_speed = p_max_speed;
+}
+float SteeringIntegrator2D::get_max_speed() const {
+    return core.config.max_speed;
+}
+
+void SteeringIntegrator2D::set_max_force(float p_max_force) {
+    core.config.max_force = p_max_force;
+}
+float SteeringIntegrator2D::get_max_force() const {
+    return core.config.max_force;
+}
+
+void SteeringIntegrator2D::set_seek_weight(float p_seek_weight) {
+    core.config.seek_weight = p_seek_weight;
+}
+float SteeringIntegrator2D::get_seek_weight() const {
+    return core.config.seek_weight;
+}
+
+void SteeringIntegrator2D::set_arrive_radius(float p_arrive_radius) {
+    core.config.arrive_radius = p_arrive_radius;
+}
+float SteeringIntegrator2D::get_arrive_radius() const {
+    return core.config.arrive_radius;
+}
+
+void SteeringIntegrator2D::set_separation_radius(float p_separation_radius) {
+    core.config.separation_radius = p_separation_radius;
+}
+float SteeringIntegrator2D::get_separation_radius() const {
+    return core.config.separation_radius;
+}
+
+void SteeringIntegrator2D::set_separation_weight(float p_separation_weight) {
+    core.config.separation_weight = p_separation_weight;
+}
+float SteeringIntegrator2D::get_separation_weight() const {
+    return core.config.separation_weight;
+}
+
+void SteeringIntegrator2D::set_avoidance_lookahead(float p_avoidance_lookahead) {
+    core.config.avoidance_lookahead = p_avoidance_lookahead;
+}
+float SteeringIntegrator2D::get_avoidance_lookahead() const {
+    return core.config.avoidance_lookahead;
+}
+
+void SteeringIntegrator2D::set_avoidance_weight(float p_avoidance_weight) {
+    core.config.avoidance_weight = p_avoidance_weight;
+}
+float SteeringIntegrator2D::get_avoidance_weight() const {
+    return core.config.avoidance_weight;
+}
+
+void SteeringIntegrator2D::set_threaded(bool p_threaded) {
+    core.config.threaded = p_threaded;
+}
+bool SteeringIntegrator2D::get_threaded() const {
+    return core.config.threaded;
+}
+
+}
@@ -0,0 +1,254 @@
+/**
+ * SteeringIntegrator3D Implementation
+ */
+
+#include "steering_integrator_3d.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+void SteeringIntegrator3D::_bind_methods() {
+    // Agents
+    ClassDB::bind_method(D_METHOD("set_agents", "positions", "velocities"), &SteeringIntegrator3D::set_agents,
+                         DEFVAL(PackedVector3Array()));
+    ClassDB::bind_method(D_METHOD("set_positions", "positions"), &SteeringIntegrator3D::set_positions);
+    ClassDB::bind_method(D_METHOD("set_velocities", "velocities"), &SteeringIntegrator3D::set_velocities);
+    ClassDB::bind_method(D_METHOD("set_targets", "targets"), &SteeringIntegrator3D::set_targets);
+    ClassDB::bind_method(D_METHOD("set_obstacles", "centers", "radii"), &SteeringIntegrator3D::set_obstacles);
+    ClassDB::bind_method(D_METHOD("get_positions"), &SteeringIntegrator3D::get_positions);
+    ClassDB::bind_method(D_METHOD("get_velocities"), &SteeringIntegrator3D::get_velocities);
+    ClassDB::bind_method(D_METHOD("get_count"), &SteeringIntegrator3D::get_count);
+    ClassDB::bind_method(D_METHOD("clear"), &SteeringIntegrator3D::clear);
+
+    // Step
+    ClassDB::bind_method(D_METHOD("step", "delta"), &SteeringIntegrator3D::step);
+
+    // Behavior settings
+    ClassDB::bind_method(D_METHOD("set_max_speed", "max_speed"), &SteeringIntegrator3D::set_max_speed);
+    ClassDB::bind_method(D_METHOD("get_max_speed"), &SteeringIntegrator3D::get_max_speed);
+    ClassDB::bind_method(D_METHOD("set_max_force", "max_force"), &SteeringIntegrator3D::set_max_force);
+    ClassDB::bind_method(D_METHOD("get_max_force"), &SteeringIntegrator3D::get_max_force);
+    ClassDB::bind_method(D_METHOD("set_seek_weight", "seek_weight"), &SteeringIntegrator3D::set_seek_weight);
+    ClassDB::bind_method(D_METHOD("get_seek_weight"), &SteeringIntegrator3D::get_seek_weight);
+    ClassDB::bind_method(D_METHOD("set_arrive_radius", "arrive_radius"), &SteeringIntegrator3D::set_arrive_radius);
+    ClassDB::bind_method(D_METHOD("get_arrive_radius"), &SteeringIntegrator3D::get_arrive_radius);
+    ClassDB::bind_method(D_METHOD("set_separation_radius", "separation_radius"), &SteeringIntegrator3D::set_separation_radius);
+    ClassDB::bind_method(D_METHOD("get_separation_radius"), &SteeringIntegrator3D::get_separation_radius);
+    ClassDB::bind_method(D_METHOD("set_separation_weight", "separation_weight"), &SteeringIntegrator3D::set_separation_weight);
+    ClassDB::bind_method(D_METHOD("get_separation_weight"), &SteeringIntegrator3D::get_separation_weight);
+    ClassDB::bind_method(D_METHOD("set_avoidance_lookahead", "avoidance_lookahead"), &SteeringIntegrator3D::set_avoidance_lookahead);
+    ClassDB::bind_method(D_METHOD("get_avoidance_lookahead"), &SteeringIntegrator3D::get_avoidance_lookahead);
+    ClassDB::bind_method(D_METHOD("set_avoidance_weight", "avoidance_weight"), &SteeringIntegrator3D::set_avoidance_weight);
+    ClassDB::bind_method(D_METHOD("get_avoidance_weight"), &SteeringIntegrator3D::get_avoidance_weight);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &SteeringIntegrator3D::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &SteeringIntegrator3D::get_threaded);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_speed"), "set_max_speed", "get_max_speed");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_force"), "set_max_force", "get_max_force");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "seek_weight"), "set_seek_weight", "get_seek_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "arrive_radius"), "set_arrive_radius", "get_arrive_radius");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "separation_radius"), "set_separation_radius", "get_separation_radius");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "separation_weight"), "set_separation_weight", "get_separation_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "avoidance_lookahead"), "set_avoidance_lookahead", "get_avoidance_lookahead");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "avoidance_weight"), "set_avoidance_weight", "get_avoidance_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+}
+
+SteeringIntegrator3D::SteeringIntegrator3D() {
+}
+
+SteeringIntegrator3D::~SteeringIntegrator3D() {
+}
+
+// ========== AGENTS ==========
+
+void SteeringIntegrator3D::set_agents(const PackedVector3Array& positions, const PackedVector3Array& velocities) {
+    int64_t count = positions.size();
+    if (!velocities.is_empty() && velocities.size() != count) {
+        UtilityFunctions::push_error("AgentiteG: set_agents positions and velocities sizes differ");
+        return;
+    }
+
+    if (count != core.size()) {
+        for (int d = 0; d < 3; d++) {
+            core.target[d].clear();
+        }
+    }
+    core.resize(count);
+    set_positions(positions);
+    if (velocities.is_empty()) {
+        for (int d = 0; d < 3; d++) {
+            std::fill(core.velocity[d].begin(), core.velocity[d].end(), 0.0f);
+        }
+    } else {
+        set_velocities(velocities);
+    }
+}
+
+void SteeringIntegrator3D::set_positions(const PackedVector3Array& positions) {
+    if (positions.size() != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_positions size must match the agent count");
+        return;
+    }
+    const Vector3* src = positions.ptr();
+    for (int64_t i = 0; i < core.size(); i++) {
+        core.position[0][i] = src[i].x;
+        core.position[1][i] = src[i].y;
+        core.position[2][i] = src[i].z;
+    }
+}
+
+void SteeringIntegrator3D::set_velocities(const PackedVector3Array& velocities) {
+    if (velocities.size() != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_velocities size must match the agent count");
+        return;
+    }
+    const Vector3* src = velocities.ptr();
+    for (int64_t i = 0; i < core.size(); i++) {
+        core.velocity[0][i] = src[i].x;
+        core.velocity[1][i] = src[i].y;
+        core.velocity[2][i] = src[i].z;
+    }
+}
+
+void SteeringIntegrator3D::set_targets(const PackedVector3Array& targets) {
+    int64_t count = targets.size();
+    if (count != 0 && count != core.size()) {
+        UtilityFunctions::push_error("AgentiteG: set_targets size must match the agent count");
+        return;
+    }
+    const Vector3* src = targets.ptr();
+    core.target[0].resize(count);
+    core.target[1].resize(count);
+    core.target[2].resize(count);
+    for (int64_t i = 0; i < count; i++) {
+        core.target[0][i] = src[i].x;
+        core.target[1][i] = src[i].y;
+        core.target[2][i] = src[i].z;
+    }
+}
+
+void SteeringIntegrator3D::set_obstacles(const PackedVector3Array& centers, const PackedFloat32Array& radii) {
+    int64_t count = centers.size();
+    if (radii.size() != count) {
+        UtilityFunctions::push_error("AgentiteG: set_obstacles centers and radii sizes differ");
+        return;
+    }
+    const Vector3* src = centers.ptr();
+    core.obstacle_center[0].resize(count);
+    core.obstacle_center[1].resize(count);
+    core.obstacle_center[2].resize(count);
+    core.obstacle_radius.assign(radii.ptr(), radii.ptr() + count);
+    for (int64_t i = 0; i < count; i++) {
+        core.obstacle_center[0][i] = src[i].x;
+        core.obstacle_center[1][i] = src[i].y;
+        core.obstacle_center[2][i] = src[i].z;
+    }
+}
+
+PackedVector3Array SteeringIntegrator3D::get_positions() const {
+    PackedVector3Array result;
+    result.resize(core.size());
+    Vector3* dst = result.ptrw();
+    for (int64_t i = 0; i < core.size(); i++) {
+        dst[i] = Vector3(core.position[0][i], core.position[1][i], core.position[2][i]);
+    }
+    return result;
+}
+
+PackedVector3Array SteeringIntegrator3D::get_velocities() const {
+    PackedVector3Array result;
+    result.resize(core.size());
+    Vector3* dst = result.ptrw();
+    for (int64_t i = 0; i < core.size(); i++) {
+        dst[i] = Vector3(core.velocity[0][i], core.velocity[1][i], core.velocity[2][i]);
+    }
+    return result;
+}
+
+int64_t SteeringIntegrator3D::get_count() const {
+    return core.size();
+}
+
+void SteeringIntegrator3D::clear() {
+    core.clear();
+}
+
+// ========== STEP ==========
+
+void SteeringIntegrator3D::step(float delta) {
+    AGENTITE_PROFILE("SteeringIntegrator3D.step", get_count());
+    core.step(delta);
+}
+
+// ========== BEHAVIOR SETTINGS ==========
+
+void SteeringIntegrator3D::set_max_speed(float p_max_speed) {
+    core.config.max_speed = p_max_speed;
+}
+float SteeringIntegrator3D::get_max_speed() const {
+    return core.config.max_speed;
+}
+
+void SteeringIntegrator3D::set_max_force(float p_max_force) {
+    core.config.max_force = p_max_force;
+}
+float SteeringIntegrator3D::get_max_force() const {
+    return core.config.max_force;
+}
+
+void SteeringIntegrator3D::set_seek_weight(float p_seek_weight) {
+    core.config.seek_weight = p_seek_weight;
+}
+float SteeringIntegrator3D::get_seek_weight() const {
+    return core.config.seek_weight;
+}
+
+void SteeringIntegrator3D::set_arrive_radius(float p_arrive_radius) {
+    core.config.arrive_radius = p_arrive_radius;
+}
+float SteeringIntegrator3D::get_arrive_radius() const {
+    return core.config.arrive_radius;
+}
+
+void SteeringIntegrator3D::set_separation_radius(float p_separation_radius) {
+    core.config.separation_radius = p_separation_radius;
+}
+float SteeringIntegrator3D::get_separation_radius() const {
+    return core.config.separation_radius;
+}
+
+void SteeringIntegrator3D::set_separation_weight(float p_separation_weight) {
+    core.config.separation_weight = p_separation_weight;
+}
+float SteeringIntegrator3D::get_separation_weight() const {
+    return core.config.separation_weight;
+}
+
+void SteeringIntegrator3D::set_avoidance_lookahead(float p_avoidance_lookahead) {
+    core.config.avoidance_lookahead = p_avoidance_lookahead;
+}
+float SteeringIntegrator3D::get_avoidance_lookahead() const {
+    return core.config.avoidance_lookahead;
+}
+
+void SteeringIntegrator3D::set_avoidance_weight(float p_avoidance_weight) {
+    core.config.avoidance_weight = p_avoidance_weight;
+}
+float SteeringIntegrator3D::get_avoidance_weight() const {
+    return core.config.avoidance_weight;
+}
+
+void SteeringIntegrator3D::set_threaded(bool p_threaded) {
+    core.config.threaded = p_threaded;
+}
+bool SteeringIntegrator3D::get_threaded() const {
+    return core.config.threaded;
+}
+
+}
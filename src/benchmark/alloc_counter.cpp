@@ -0,0 +1,68 @@
+/**
+ * AllocCounter Implementation
+ *
+ * Only built with benchmarks=yes (see SConstruct); release builds keep the
+ * standard operator new.
+ */
+
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace godot {
+namespace alloc_counter {
+
+static std::atomic<uint64_t> allocations{0};
+
+uint64_t count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+static void* allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        void* p = std::malloc(size);
+        if (p) {
+            return p;
+        }
+        // godot-cpp builds without exceptions, so there is no bad_alloc to throw
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            std::abort();
+        }
+        handler();
+    }
+}
+
+}
+}
+
+// The nothrow and array forms forward here by default; aligned forms are not counted
+void* operator new(std::size_t size) {
+    return godot::alloc_counter::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return godot::alloc_counter::allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
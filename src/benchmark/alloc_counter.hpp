@@ -0,0 +1,32 @@
+/**
+ * AllocCounter - Heap allocation count for NativeBenchmark
+ *
+ * Benchmark builds (scons benchmarks=yes) replace the global operator new
+ * with a version that counts calls before forwarding to malloc. They are
+ * written as libagentiteg.benchmark.*, which agentiteg.gdextension never
+ * loads, so the counting allocator only runs under the benchmark runner. Counts
+ * cover the library's own C++ allocations (std containers, scratch
+ * buffers). Packed*Array storage is allocated by the engine and is not
+ * included.
+ *
+ * Usage (internal):
+ *   uint64_t before = alloc_counter::count();
+ *   run();
+ *   uint64_t allocations = alloc_counter::count() - before;
+ */
+
+#ifndef AGENTITE_ALLOC_COUNTER_HPP
+#define AGENTITE_ALLOC_COUNTER_HPP
+
+#include <cstdint>
+
+namespace godot {
+namespace alloc_counter {
+
+// Number of operator new calls so far, from all threads
+uint64_t count();
+
+}
+}
+
+#endif // AGENTITE_ALLOC_COUNTER_HPP
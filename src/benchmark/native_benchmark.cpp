@@ -0,0 +1,481 @@
+/**
+ * NativeBenchmark Implementation
+ */
+
+#include "native_benchmark.hpp"
+#include "alloc_counter.hpp"
+#include "collision/collision_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/simd.hpp"
+#include "geometry/geometry_ops.hpp"
+#include "noise/noise_ops.hpp"
+#include "pathfinding/pathfinding_context.hpp"
+#include "pathfinding/pathfinding_ops.hpp"
+#include "random/random_core.hpp"
+#include "spatial/dynamic_aabb_tree_2d.hpp"
+#include "spatial/kd_tree_2d.hpp"
+#include "spatial/neighbor_list.hpp"
+#include "spatial/quad_tree.hpp"
+#include "spatial/spatial_grid_2d.hpp"
+#include "spatial/spatial_hash_2d.hpp"
+#include "stats/stat_ops.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace godot {
+
+// Inputs are the same on every run and machine
+static const int64_t BENCH_SEED = 0x5EED;
+
+// Points are spread at a constant density: about one per SPACING^2 area,
+// so a query of QUERY_RADIUS finds about 12 neighbors at every size
+static const float SPACING = 10.0f;
+static const float QUERY_RADIUS = 20.0f;
+
+// Single queries timed per operation by the per-query cases
+static const int64_t QUERY_COUNT = 1024;
+
+using Operation = std::function<void()>;
+
+struct Case {
+    const char* name;
+    // Builds the inputs for size and returns the timed operation;
+    // sets items to the number of elements one operation processes
+    std::function<Operation(int64_t size, int64_t& items)> setup;
+};
+
+// ========== INPUTS ==========
+
+static float unit_float(uint32_t bits) {
+    return (bits >> 8) * (1.0f / 16777216.0f);
+}
+
+static float extent_for(int64_t count) {
+    return std::sqrt(static_cast<float>(count)) * SPACING;
+}
+
+static PackedVector2Array random_points(int64_t count, uint32_t stream) {
+    rng::Key key(BENCH_SEED, stream);
+    float extent = extent_for(count);
+    PackedVector2Array points;
+    points.resize(count);
+    Vector2* dst = points.ptrw();
+    for (int64_t i = 0; i < count; i++) {
+        rng::Block b = key.block(rng::KIND_UNIFORM, static_cast<uint64_t>(i));
+        dst[i] = Vector2(unit_float(b.w[0]) * extent, unit_float(b.w[1]) * extent);
+    }
+    return points;
+}
+
+static PackedFloat32Array random_values(int64_t count, float lo, float hi, uint32_t stream) {
+    rng::Key key(BENCH_SEED, stream);
+    PackedFloat32Array values;
+    values.resize(count);
+    float* dst = values.ptrw();
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = lo + unit_float(key.block(rng::KIND_UNIFORM, static_cast<uint64_t>(i)).w[0]) * (hi - lo);
+    }
+    return values;
+}
+
+// Side of a square grid with about count cells
+static int32_t grid_side(int64_t count) {
+    return std::max<int32_t>(2, static_cast<int32_t>(std::lround(std::sqrt(static_cast<double>(count)))));
+}
+
+// ========== CASES ==========
+
+static std::vector<Case> make_cases() {
+    std::vector<Case> cases;
+
+    // Spatial structures
+
+    cases.push_back({"spatial_hash_2d/build", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<SpatialHash2D> hash;
+        hash.instantiate();
+        hash->set_cell_size(QUERY_RADIUS);
+        items = n;
+        return [points, hash]() { hash->build(points); };
+    }});
+    cases.push_back({"spatial_hash_2d/query_radius_batch", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<SpatialHash2D> hash;
+        hash.instantiate();
+        hash->set_cell_size(QUERY_RADIUS);
+        hash->build(points);
+        Ref<NeighborList> out;
+        out.instantiate();
+        items = n;
+        return [points, hash, out]() { hash->query_radius_batch_uniform_flat(points, QUERY_RADIUS, out); };
+    }});
+    cases.push_back({"spatial_grid_2d/build", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<SpatialGrid2D> grid;
+        grid.instantiate();
+        grid->set_cell_size(QUERY_RADIUS);
+        items = n;
+        return [points, grid]() { grid->build(points); };
+    }});
+    cases.push_back({"spatial_grid_2d/query_radius_batch", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<SpatialGrid2D> grid;
+        grid.instantiate();
+        grid->set_cell_size(QUERY_RADIUS);
+        grid->build(points);
+        Ref<NeighborList> out;
+        out.instantiate();
+        items = n;
+        return [points, grid, out]() { grid->query_radius_batch_uniform_flat(points, QUERY_RADIUS, out); };
+    }});
+    cases.push_back({"kd_tree_2d/build", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<KDTree2D> tree;
+        tree.instantiate();
+        items = n;
+        return [points, tree]() { tree->build(points); };
+    }});
+    cases.push_back({"kd_tree_2d/query_nearest_batch", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<KDTree2D> tree;
+        tree.instantiate();
+        tree->build(points);
+        Ref<NeighborList> out;
+        out.instantiate();
+        items = n;
+        return [points, tree, out]() { tree->query_nearest_batch_flat(points, 8, out); };
+    }});
+    cases.push_back({"quad_tree/build", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<QuadTree> tree;
+        tree.instantiate();
+        tree->set_bounds(Rect2(0, 0, extent_for(n), extent_for(n)));
+        items = n;
+        return [points, tree]() { tree->build(points); };
+    }});
+    cases.push_back({"quad_tree/query_radius", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        PackedVector2Array origins = random_points(QUERY_COUNT, 2);
+        // Origins spread over the same area as the points
+        float scale = extent_for(n) / extent_for(QUERY_COUNT);
+        for (int64_t i = 0; i < QUERY_COUNT; i++) {
+            origins.set(i, origins[i] * scale);
+        }
+        Ref<QuadTree> tree;
+        tree.instantiate();
+        tree->set_bounds(Rect2(0, 0, extent_for(n), extent_for(n)));
+        tree->build(points);
+        items = QUERY_COUNT;
+        return [origins, tree]() {
+            const Vector2* o = origins.ptr();
+            for (int64_t i = 0; i < QUERY_COUNT; i++) {
+                tree->query_radius(o[i], QUERY_RADIUS);
+            }
+        };
+    }});
+    cases.push_back({"dynamic_aabb_tree_2d/insert", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<DynamicAABBTree2D> tree;
+        tree.instantiate();
+        items = n;
+        return [points, tree]() {
+            tree->clear();
+            const Vector2* p = points.ptr();
+            for (int64_t i = 0; i < points.size(); i++) {
+                tree->insert(Rect2(p[i], Vector2(SPACING, SPACING)));
+            }
+        };
+    }});
+    cases.push_back({"dynamic_aabb_tree_2d/query_pairs", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        Ref<DynamicAABBTree2D> tree;
+        tree.instantiate();
+        const Vector2* p = points.ptr();
+        for (int64_t i = 0; i < points.size(); i++) {
+            tree->insert(Rect2(p[i], Vector2(SPACING, SPACING)));
+        }
+        items = n;
+        return [tree]() { tree->query_pairs(); };
+    }});
+
+    // Pathfinding: an open grid of about size cells with costs 1-4
+
+    cases.push_back({"pathfinding_ops/astar_grid", [](int64_t n, int64_t& items) -> Operation {
+        int32_t side = grid_side(n);
+        PackedFloat32Array costs = random_values(static_cast<int64_t>(side) * side, 1.0f, 4.0f, 3);
+        Ref<PathfindingContext> context;
+        context.instantiate();
+        items = static_cast<int64_t>(side) * side;
+        return [costs, side, context]() {
+            PathfindingOps::astar_grid(costs, side, side, Vector2i(0, 0), Vector2i(side - 1, side - 1), true, context);
+        };
+    }});
+    cases.push_back({"pathfinding_ops/dijkstra_map_single", [](int64_t n, int64_t& items) -> Operation {
+        int32_t side = grid_side(n);
+        PackedFloat32Array costs = random_values(static_cast<int64_t>(side) * side, 1.0f, 4.0f, 3);
+        Ref<PathfindingContext> context;
+        context.instantiate();
+        items = static_cast<int64_t>(side) * side;
+        return [costs, side, context]() {
+            PathfindingOps::dijkstra_map_single(costs, side, side, Vector2i(side / 2, side / 2), context);
+        };
+    }});
+
+    // Noise grids of about size cells
+
+    cases.push_back({"noise_ops/perlin_2d_grid", [](int64_t n, int64_t& items) -> Operation {
+        int32_t side = grid_side(n);
+        Ref<NoiseOps> noise;
+        noise.instantiate();
+        noise->set_seed(static_cast<int>(BENCH_SEED));
+        items = static_cast<int64_t>(side) * side;
+        return [noise, side]() { noise->perlin_2d_grid(Vector2(0, 0), Vector2(0.05f, 0.05f), side, side); };
+    }});
+    cases.push_back({"noise_ops/fbm_2d_grid", [](int64_t n, int64_t& items) -> Operation {
+        int32_t side = grid_side(n);
+        Ref<NoiseOps> noise;
+        noise.instantiate();
+        noise->set_seed(static_cast<int>(BENCH_SEED));
+        items = static_cast<int64_t>(side) * side;
+        return [noise, side]() { noise->fbm_2d_grid(Vector2(0, 0), Vector2(0.05f, 0.05f), side, side); };
+    }});
+
+    // Collision, geometry and statistics
+
+    cases.push_back({"collision_ops/circles_self_collision", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array centers = random_points(n, 1);
+        items = n;
+        return [centers]() { CollisionOps::circles_self_collision_uniform(centers, SPACING * 0.5f); };
+    }});
+    cases.push_back({"geometry_ops/delaunay", [](int64_t n, int64_t& items) -> Operation {
+        PackedVector2Array points = random_points(n, 1);
+        items = n;
+        return [points]() { GeometryOps::delaunay(points); };
+    }});
+    cases.push_back({"stat_ops/describe", [](int64_t n, int64_t& items) -> Operation {
+        PackedFloat32Array values = random_values(n, 0.0f, 100.0f, 4);
+        items = n;
+        return [values]() {
+            StatOps::describe(values, StatOps::DESCRIBE_DEFAULT | StatOps::DESCRIBE_IN_RANGE, 25.0f, 75.0f);
+        };
+    }});
+    cases.push_back({"stat_ops/percentiles", [](int64_t n, int64_t& items) -> Operation {
+        PackedFloat32Array values = random_values(n, 0.0f, 100.0f, 4);
+        PackedFloat32Array ps;
+        ps.push_back(5.0f);
+        ps.push_back(50.0f);
+        ps.push_back(95.0f);
+        items = n;
+        return [values, ps]() { StatOps::percentiles(values, ps); };
+    }});
+
+    return cases;
+}
+
+static const std::vector<Case>& cases() {
+    static const std::vector<Case> list = make_cases();
+    return list;
+}
+
+// ========== NATIVE BENCHMARK ==========
+
+void NativeBenchmark::_bind_methods() {
+    // Settings
+    ClassDB::bind_method(D_METHOD("set_min_time", "min_time"), &NativeBenchmark::set_min_time);
+    ClassDB::bind_method(D_METHOD("get_min_time"), &NativeBenchmark::get_min_time);
+    ClassDB::bind_method(D_METHOD("set_repetitions", "repetitions"), &NativeBenchmark::set_repetitions);
+    ClassDB::bind_method(D_METHOD("get_repetitions"), &NativeBenchmark::get_repetitions);
+    ClassDB::bind_method(D_METHOD("set_sizes", "sizes"), &NativeBenchmark::set_sizes);
+    ClassDB::bind_method(D_METHOD("get_sizes"), &NativeBenchmark::get_sizes);
+    ClassDB::bind_method(D_METHOD("set_filter", "filter"), &NativeBenchmark::set_filter);
+    ClassDB::bind_method(D_METHOD("get_filter"), &NativeBenchmark::get_filter);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_time"), "set_min_time", "get_min_time");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "repetitions"), "set_repetitions", "get_repetitions");
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "sizes"), "set_sizes", "get_sizes");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "filter"), "set_filter", "get_filter");
+
+    // Running
+    ClassDB::bind_method(D_METHOD("list_cases"), &NativeBenchmark::list_cases);
+    ClassDB::bind_method(D_METHOD("run"), &NativeBenchmark::run);
+    ClassDB::bind_static_method("NativeBenchmark", D_METHOD("compare", "report", "baseline", "tolerance"), &NativeBenchmark::compare, DEFVAL(0.15));
+}
+
+NativeBenchmark::NativeBenchmark() {
+    sizes.push_back(1000);
+    sizes.push_back(10000);
+    sizes.push_back(100000);
+}
+
+NativeBenchmark::~NativeBenchmark() {
+}
+
+// ========== SETTINGS ==========
+
+void NativeBenchmark::set_min_time(double p_min_time) {
+    min_time = std::max(p_min_time, 0.0);
+}
+
+double NativeBenchmark::get_min_time() const {
+    return min_time;
+}
+
+void NativeBenchmark::set_repetitions(int32_t p_repetitions) {
+    repetitions = std::max(p_repetitions, 1);
+}
+
+int32_t NativeBenchmark::get_repetitions() const {
+    return repetitions;
+}
+
+void NativeBenchmark::set_sizes(const PackedInt32Array& p_sizes) {
+    sizes = p_sizes;
+}
+
+PackedInt32Array NativeBenchmark::get_sizes() const {
+    return sizes;
+}
+
+void NativeBenchmark::set_filter(const String& p_filter) {
+    filter = p_filter;
+}
+
+String NativeBenchmark::get_filter() const {
+    return filter;
+}
+
+// ========== RUNNING ==========
+
+// Time op: double the iteration count until one run takes min_time, then
+// repeat that run and keep the fastest
+static Dictionary measure(const Operation& op, int64_t items, double min_time, int32_t repetitions) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up (caches, lazily built tables, worker threads)
+    op();
+
+    int64_t iterations = 1;
+    double best = std::numeric_limits<double>::infinity();
+    uint64_t allocations = 0;
+    for (int32_t rep = 0; rep < repetitions;) {
+        uint64_t alloc_start = alloc_counter::count();
+        Clock::time_point start = Clock::now();
+        for (int64_t i = 0; i < iterations; i++) {
+            op();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t alloc_count = alloc_counter::count() - alloc_start;
+
+        if (elapsed < min_time && iterations < (int64_t(1) << 30)) {
+            // Aim 20% past min_time, at most 10x more per step
+            double target = elapsed > 0.0 ? min_time * 1.2 / elapsed : 10.0;
+            iterations = static_cast<int64_t>(iterations * std::min(std::max(target, 2.0), 10.0));
+            continue;
+        }
+        double per_op = elapsed / iterations;
+        if (per_op < best) {
+            best = per_op;
+            allocations = alloc_count / iterations;
+        }
+        rep++;
+    }
+
+    Dictionary result;
+    result["iterations"] = iterations;
+    result["ns_per_op"] = best * 1e9;
+    result["items_per_second"] = best > 0.0 ? items / best : 0.0;
+    result["allocations_per_op"] = static_cast<int64_t>(allocations);
+    return result;
+}
+
+PackedStringArray NativeBenchmark::list_cases() const {
+    PackedStringArray names;
+    for (const Case& c : cases()) {
+        String name(c.name);
+        if (filter.is_empty() || name.find(filter) != -1) {
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+Dictionary NativeBenchmark::run() const {
+    Array results;
+    for (const Case& c : cases()) {
+        String name(c.name);
+        if (!filter.is_empty() && name.find(filter) == -1) {
+            continue;
+        }
+        for (int64_t s = 0; s < sizes.size(); s++) {
+            int64_t size = sizes[s];
+            if (size <= 0) {
+                continue;
+            }
+            int64_t items = size;
+            Operation op = c.setup(size, items);
+            Dictionary result = measure(op, items, min_time, repetitions);
+            result["name"] = name;
+            result["size"] = size;
+            results.push_back(result);
+        }
+    }
+
+    Dictionary report;
+    report["format"] = 1;
+    report["simd_level"] = String(simd::get_level_name(simd::get_level()));
+    report["threads"] = parallel::get_thread_count();
+    report["results"] = results;
+    return report;
+}
+
+Array NativeBenchmark::compare(const Dictionary& report, const Dictionary& baseline, double tolerance) {
+    // Baseline timings by name, then size (sizes read back from JSON are floats)
+    Dictionary baseline_ns;
+    Array baseline_results = baseline.get("results", Array());
+    for (int64_t i = 0; i < baseline_results.size(); i++) {
+        Dictionary r = baseline_results[i];
+        String name = r["name"];
+        if (!baseline_ns.has(name)) {
+            baseline_ns[name] = Dictionary();
+        }
+        Dictionary by_size = baseline_ns[name];
+        by_size[static_cast<int64_t>(r["size"])] = r["ns_per_op"];
+    }
+
+    Array regressions;
+    Array results = report.get("results", Array());
+    for (int64_t i = 0; i < results.size(); i++) {
+        Dictionary r = results[i];
+        String name = r["name"];
+        int64_t size = r["size"];
+        if (!baseline_ns.has(name)) {
+            continue;
+        }
+        Dictionary by_size = baseline_ns[name];
+        if (!by_size.has(size)) {
+            continue;
+        }
+        double before = by_size[size];
+        double now = r["ns_per_op"];
+        if (before > 0.0 && now > before * (1.0 + tolerance)) {
+            Dictionary regression;
+            regression["name"] = r["name"];
+            regression["size"] = r["size"];
+            regression["baseline_ns"] = before;
+            regression["current_ns"] = now;
+            regression["ratio"] = now / before;
+            regressions.push_back(regression);
+        }
+    }
+    return regressions;
+}
+
+}
@@ -0,0 +1,80 @@
+/**
+ * NativeBenchmark - Timing harness for the Ops classes, run in native code
+ *
+ * project/benchmarks/benchmark_runner.gd times calls from GDScript, so its
+ * numbers include the call overhead and the loop around each call.
+ * NativeBenchmark times the same C++ entry points from C++: each case
+ * builds its inputs once, then calls the method in a tight loop until
+ * min_time has passed, repeated `repetitions` times, keeping the fastest
+ * run. Results list ns/op, items/s and heap allocations per op for every
+ * case at every input size.
+ *
+ * Only built with `scons benchmarks=yes`. `scons benchmark` builds it and
+ * runs project/benchmarks/native_benchmark.gd, which writes the results as
+ * JSON and compares them against a stored baseline.
+ *
+ * Usage:
+ *   var bench = NativeBenchmark.new()
+ *   bench.sizes = PackedInt32Array([1000, 10000, 100000])
+ *   bench.filter = "spatial"
+ *   var report = bench.run()
+ *   var regressions = NativeBenchmark.compare(report, baseline, 0.15)
+ */
+
+#ifndef AGENTITE_NATIVE_BENCHMARK_HPP
+#define AGENTITE_NATIVE_BENCHMARK_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class NativeBenchmark : public RefCounted {
+    GDCLASS(NativeBenchmark, RefCounted)
+
+private:
+    double min_time = 0.2;
+    int32_t repetitions = 3;
+    PackedInt32Array sizes;
+    String filter;
+
+protected:
+    static void _bind_methods();
+
+public:
+    NativeBenchmark();
+    ~NativeBenchmark();
+
+    // ========== SETTINGS ==========
+
+    void set_min_time(double p_min_time);  // Seconds per timed run
+    double get_min_time() const;
+    void set_repetitions(int32_t p_repetitions);  // Timed runs per case, fastest kept
+    int32_t get_repetitions() const;
+    void set_sizes(const PackedInt32Array& p_sizes);  // Input sizes, each case runs at every size
+    PackedInt32Array get_sizes() const;
+    void set_filter(const String& p_filter);  // Only cases whose name contains this
+    String get_filter() const;
+
+    // ========== RUNNING ==========
+
+    PackedStringArray list_cases() const;
+
+    // {"format", "simd_level", "threads", "results": [{"name", "size", "iterations",
+    //  "ns_per_op", "items_per_second", "allocations_per_op"}, ...]}
+    Dictionary run() const;
+
+    // Results of report slower than the same case and size in baseline by more
+    // than tolerance (0.15 = 15%): [{"name", "size", "baseline_ns", "current_ns", "ratio"}, ...]
+    static Array compare(const Dictionary& report, const Dictionary& baseline, double tolerance);
+};
+
+}
+
+#endif // AGENTITE_NATIVE_BENCHMARK_HPP
@@ -3,12 +3,20 @@
  */
 
 #include "collision_ops.hpp"
+#include "spatial/aabb_tree_core.hpp"
+#include "spatial/neighbor_list.hpp"
+#include "spatial/spatial_grid_2d.hpp"
+#include "spatial/spatial_grid_3d.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace godot {
 
@@ -29,10 +37,12 @@ void CollisionOps::_bind_methods() {
     ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_vs_spheres_uniform", "centers_a", "radius_a", "centers_b", "radius_b"), &CollisionOps::spheres_vs_spheres_uniform);
 
     // Self-collision
-    ClassDB::bind_static_method("CollisionOps", D_METHOD("circles_self_collision", "centers", "radii"), &CollisionOps::circles_self_collision);
-    ClassDB::bind_static_method("CollisionOps", D_METHOD("circles_self_collision_uniform", "centers", "radius"), &CollisionOps::circles_self_collision_uniform);
-    ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_self_collision", "centers", "radii"), &CollisionOps::spheres_self_collision);
-    ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_self_collision_uniform", "centers", "radius"), &CollisionOps::spheres_self_collision_uniform);
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("circles_self_collision", "centers", "radii", "spatial"), &CollisionOps::circles_self_collision, DEFVAL(Variant()));
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("circles_self_collision_uniform", "centers", "radius", "spatial"), &CollisionOps::circles_self_collision_uniform, DEFVAL(Variant()));
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_self_collision", "centers", "radii", "spatial"), &CollisionOps::spheres_self_collision, DEFVAL(Variant()));
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_self_collision_uniform", "centers", "radius", "spatial"), &CollisionOps::spheres_self_collision_uniform, DEFVAL(Variant()));
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("circles_self_collision_store", "store", "spatial"), &CollisionOps::circles_self_collision_store, DEFVAL(Variant()));
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("spheres_self_collision_store", "store", "spatial"), &CollisionOps::spheres_self_collision_store, DEFVAL(Variant()));
 
     // Ray intersection
     ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_vs_circles", "origin", "direction", "centers", "radii"), &CollisionOps::ray_vs_circles);
@@ -41,6 +51,8 @@ void CollisionOps::_bind_methods() {
     ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_vs_spheres", "origin", "direction", "centers", "radii"), &CollisionOps::ray_vs_spheres);
     ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_first_circle", "origin", "direction", "max_distance", "centers", "radii"), &CollisionOps::ray_first_circle);
     ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_first_sphere", "origin", "direction", "max_distance", "centers", "radii"), &CollisionOps::ray_first_sphere);
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_first_circles_batch", "origins", "directions", "max_distances", "centers", "radii"), &CollisionOps::ray_first_circles_batch);
+    ClassDB::bind_static_method("CollisionOps", D_METHOD("ray_first_spheres_batch", "origins", "directions", "max_distances", "centers", "radii"), &CollisionOps::ray_first_spheres_batch);
 
     // Segment intersection
     ClassDB::bind_static_method("CollisionOps", D_METHOD("segments_intersect", "starts_a", "ends_a", "starts_b", "ends_b"), &CollisionOps::segments_intersect);
@@ -56,6 +68,7 @@ void CollisionOps::_bind_methods() {
 // ========== POINT CONTAINMENT TESTS ==========
 
 PackedInt32Array CollisionOps::points_in_rect(const PackedVector2Array& points, const Rect2& rect) {
+    AGENTITE_PROFILE("CollisionOps.points_in_rect", points.size());
     PackedInt32Array result;
     int32_t count = points.size();
     const Vector2* p = points.ptr();
@@ -72,10 +85,12 @@ PackedInt32Array CollisionOps::points_in_rect(const PackedVector2Array& points,
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::points_in_circle(const PackedVector2Array& points, const Vector2& center, float radius) {
+    AGENTITE_PROFILE("CollisionOps.points_in_circle", points.size());
     PackedInt32Array result;
     int32_t count = points.size();
     const Vector2* p = points.ptr();
@@ -89,10 +104,12 @@ PackedInt32Array CollisionOps::points_in_circle(const PackedVector2Array& points
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::points_in_polygon(const PackedVector2Array& points, const PackedVector2Array& polygon) {
+    AGENTITE_PROFILE("CollisionOps.points_in_polygon", points.size());
     PackedInt32Array result;
     int32_t point_count = points.size();
     int32_t poly_count = polygon.size();
@@ -125,10 +142,12 @@ PackedInt32Array CollisionOps::points_in_polygon(const PackedVector2Array& point
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::points_in_aabb(const PackedVector3Array& points, const AABB& box) {
+    AGENTITE_PROFILE("CollisionOps.points_in_aabb", points.size());
     PackedInt32Array result;
     int32_t count = points.size();
     const Vector3* p = points.ptr();
@@ -144,10 +163,12 @@ PackedInt32Array CollisionOps::points_in_aabb(const PackedVector3Array& points,
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::points_in_sphere(const PackedVector3Array& points, const Vector3& center, float radius) {
+    AGENTITE_PROFILE("CollisionOps.points_in_sphere", points.size());
     PackedInt32Array result;
     int32_t count = points.size();
     const Vector3* p = points.ptr();
@@ -162,6 +183,7 @@ PackedInt32Array CollisionOps::points_in_sphere(const PackedVector3Array& points
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
@@ -170,6 +192,7 @@ PackedInt32Array CollisionOps::points_in_sphere(const PackedVector3Array& points
 PackedInt32Array CollisionOps::circles_vs_circles(
     const PackedVector2Array& centers_a, const PackedFloat32Array& radii_a,
     const PackedVector2Array& centers_b, const PackedFloat32Array& radii_b) {
+    AGENTITE_PROFILE("CollisionOps.circles_vs_circles", centers_a.size() * centers_b.size());
 
     PackedInt32Array result;
     int32_t count_a = std::min(centers_a.size(), radii_a.size());
@@ -193,12 +216,14 @@ PackedInt32Array CollisionOps::circles_vs_circles(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::circles_vs_circles_uniform(
     const PackedVector2Array& centers_a, float radius_a,
     const PackedVector2Array& centers_b, float radius_b) {
+    AGENTITE_PROFILE("CollisionOps.circles_vs_circles_uniform", centers_a.size() * centers_b.size());
 
     PackedInt32Array result;
     int32_t count_a = centers_a.size();
@@ -221,12 +246,14 @@ PackedInt32Array CollisionOps::circles_vs_circles_uniform(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::aabb_vs_aabb_2d(
     const PackedVector2Array& mins_a, const PackedVector2Array& maxs_a,
     const PackedVector2Array& mins_b, const PackedVector2Array& maxs_b) {
+    AGENTITE_PROFILE("CollisionOps.aabb_vs_aabb_2d", mins_a.size() * mins_b.size());
 
     PackedInt32Array result;
     int32_t count_a = std::min(mins_a.size(), maxs_a.size());
@@ -247,12 +274,14 @@ PackedInt32Array CollisionOps::aabb_vs_aabb_2d(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::aabb_vs_aabb_3d(
     const PackedVector3Array& mins_a, const PackedVector3Array& maxs_a,
     const PackedVector3Array& mins_b, const PackedVector3Array& maxs_b) {
+    AGENTITE_PROFILE("CollisionOps.aabb_vs_aabb_3d", mins_a.size() * mins_b.size());
 
     PackedInt32Array result;
     int32_t count_a = std::min(mins_a.size(), maxs_a.size());
@@ -274,12 +303,14 @@ PackedInt32Array CollisionOps::aabb_vs_aabb_3d(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::spheres_vs_spheres(
     const PackedVector3Array& centers_a, const PackedFloat32Array& radii_a,
     const PackedVector3Array& centers_b, const PackedFloat32Array& radii_b) {
+    AGENTITE_PROFILE("CollisionOps.spheres_vs_spheres", centers_a.size() * centers_b.size());
 
     PackedInt32Array result;
     int32_t count_a = std::min(centers_a.size(), radii_a.size());
@@ -304,12 +335,14 @@ PackedInt32Array CollisionOps::spheres_vs_spheres(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::spheres_vs_spheres_uniform(
     const PackedVector3Array& centers_a, float radius_a,
     const PackedVector3Array& centers_b, float radius_b) {
+    AGENTITE_PROFILE("CollisionOps.spheres_vs_spheres_uniform", centers_a.size() * centers_b.size());
 
     PackedInt32Array result;
     int32_t count_a = centers_a.size();
@@ -333,13 +366,96 @@ PackedInt32Array CollisionOps::spheres_vs_spheres_uniform(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 // ========== SELF-COLLISION ==========
 
+// Below this many shapes the all-pairs loop beats building a broadphase grid
+static const int32_t SELF_COLLISION_BROADPHASE_MIN = 128;
+
+// Largest |radius| among the shapes (radii may be null for a uniform radius)
+static float max_abs_radius(const float* r, float uniform_radius, int32_t count) {
+    if (!r) {
+        return std::abs(uniform_radius);
+    }
+    float max_r = 0.0f;
+    for (int32_t i = 0; i < count; i++) {
+        float ar = std::abs(r[i]);
+        if (ar > max_r) {
+            max_r = ar;
+        }
+    }
+    return max_r;
+}
+
+// Self-collision through a neighbor index (SpatialHash or SpatialGrid built from
+// the same centers). Produces exactly what the all-pairs loops produce: pairs
+// with i < j, ordered by i then j. radii may be null for a uniform radius.
+template <typename Index, typename Vec>
+static PackedInt32Array self_collision_pairs(const Index& index, const Vec* c,
+                                             const float* r, float uniform_radius,
+                                             int32_t count) {
+    // Largest |radius| bounds the search; negative radii square like the loops do
+    float max_r = max_abs_radius(r, uniform_radius, count);
+
+    // Collect each shape's overlapping later shapes, sorted, across worker threads
+    Ref<NeighborList> later;
+    later.instantiate();
+    later->fill(count, [&](int32_t i, std::vector<int32_t>& hits) {
+        size_t first = hits.size();
+        float ri = r ? r[i] : uniform_radius;
+        float search = std::max(std::abs(ri) + max_r, std::numeric_limits<float>::min());
+        index.collect_radius(c[i], search, hits);
+
+        size_t keep = first;
+        for (size_t h = first; h < hits.size(); h++) {
+            int32_t j = hits[h];
+            if (j <= i || j >= count) {
+                continue;
+            }
+            float combined_r = ri + (r ? r[j] : uniform_radius);
+            if ((c[i] - c[j]).length_squared() <= combined_r * combined_r) {
+                hits[keep++] = j;
+            }
+        }
+        hits.resize(keep);
+        std::sort(hits.begin() + first, hits.end());
+    });
+
+    // Expand to the flat [i0, j0, i1, j1, ...] format
+    PackedInt32Array result;
+    PackedInt32Array offsets = later->get_offsets();
+    PackedInt32Array js = later->get_indices();
+    const int32_t* offsets_ptr = offsets.ptr();
+    const int32_t* js_ptr = js.ptr();
+    result.resize(js.size() * 2);
+    int32_t* out = result.ptrw();
+    for (int32_t i = 0; i < count; i++) {
+        for (int32_t h = offsets_ptr[i]; h < offsets_ptr[i + 1]; h++) {
+            *out++ = i;
+            *out++ = js_ptr[h];
+        }
+    }
+
+    return result;
+}
+
+// Validate a caller-provided spatial index against the centers it should hold
+template <typename Spatial>
+static bool check_spatial_count(const Ref<Spatial>& spatial, int32_t count) {
+    if (spatial->get_count() != count) {
+        UtilityFunctions::push_error("AgentiteG: spatial index must be built from the same centers");
+        return false;
+    }
+    return true;
+}
+
 PackedInt32Array CollisionOps::circles_self_collision(
-    const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+    const PackedVector2Array& centers, const PackedFloat32Array& radii,
+    const Ref<SpatialHash2D>& spatial) {
+    AGENTITE_PROFILE("CollisionOps.circles_self_collision", centers.size());
 
     PackedInt32Array result;
     int32_t count = std::min(centers.size(), radii.size());
@@ -347,6 +463,25 @@ PackedInt32Array CollisionOps::circles_self_collision(
     const Vector2* c = centers.ptr();
     const float* r = radii.ptr();
 
+    if (spatial.is_valid()) {
+        if (!check_spatial_count(spatial, centers.size())) {
+            return result;
+        }
+        result = self_collision_pairs(*spatial.ptr(), c, r, 0.0f, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
+    if (count >= SELF_COLLISION_BROADPHASE_MIN) {
+        Ref<SpatialGrid2D> grid;
+        grid.instantiate();
+        grid->set_cell_size(2.0f * max_abs_radius(r, 0.0f, count));
+        grid->build(centers);
+        result = self_collision_pairs(*grid.ptr(), c, r, 0.0f, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
     for (int32_t i = 0; i < count; i++) {
         for (int32_t j = i + 1; j < count; j++) {
             float dx = c[i].x - c[j].x;
@@ -360,17 +495,39 @@ PackedInt32Array CollisionOps::circles_self_collision(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::circles_self_collision_uniform(
-    const PackedVector2Array& centers, float radius) {
+    const PackedVector2Array& centers, float radius,
+    const Ref<SpatialHash2D>& spatial) {
+    AGENTITE_PROFILE("CollisionOps.circles_self_collision_uniform", centers.size());
 
     PackedInt32Array result;
     int32_t count = centers.size();
 
     const Vector2* c = centers.ptr();
 
+    if (spatial.is_valid()) {
+        if (!check_spatial_count(spatial, count)) {
+            return result;
+        }
+        result = self_collision_pairs(*spatial.ptr(), c, nullptr, radius, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
+    if (count >= SELF_COLLISION_BROADPHASE_MIN) {
+        Ref<SpatialGrid2D> grid;
+        grid.instantiate();
+        grid->set_cell_size(2.0f * max_abs_radius(nullptr, radius, count));
+        grid->build(centers);
+        result = self_collision_pairs(*grid.ptr(), c, nullptr, radius, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
     float diameter = 2.0f * radius;
     float diameter_sq = diameter * diameter;
 
@@ -385,11 +542,14 @@ PackedInt32Array CollisionOps::circles_self_collision_uniform(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::spheres_self_collision(
-    const PackedVector3Array& centers, const PackedFloat32Array& radii) {
+    const PackedVector3Array& centers, const PackedFloat32Array& radii,
+    const Ref<SpatialHash3D>& spatial) {
+    AGENTITE_PROFILE("CollisionOps.spheres_self_collision", centers.size());
 
     PackedInt32Array result;
     int32_t count = std::min(centers.size(), radii.size());
@@ -397,6 +557,25 @@ PackedInt32Array CollisionOps::spheres_self_collision(
     const Vector3* c = centers.ptr();
     const float* r = radii.ptr();
 
+    if (spatial.is_valid()) {
+        if (!check_spatial_count(spatial, centers.size())) {
+            return result;
+        }
+        result = self_collision_pairs(*spatial.ptr(), c, r, 0.0f, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
+    if (count >= SELF_COLLISION_BROADPHASE_MIN) {
+        Ref<SpatialGrid3D> grid;
+        grid.instantiate();
+        grid->set_cell_size(2.0f * max_abs_radius(r, 0.0f, count));
+        grid->build(centers);
+        result = self_collision_pairs(*grid.ptr(), c, r, 0.0f, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
     for (int32_t i = 0; i < count; i++) {
         for (int32_t j = i + 1; j < count; j++) {
             float dx = c[i].x - c[j].x;
@@ -411,17 +590,39 @@ PackedInt32Array CollisionOps::spheres_self_collision(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::spheres_self_collision_uniform(
-    const PackedVector3Array& centers, float radius) {
+    const PackedVector3Array& centers, float radius,
+    const Ref<SpatialHash3D>& spatial) {
+    AGENTITE_PROFILE("CollisionOps.spheres_self_collision_uniform", centers.size());
 
     PackedInt32Array result;
     int32_t count = centers.size();
 
     const Vector3* c = centers.ptr();
 
+    if (spatial.is_valid()) {
+        if (!check_spatial_count(spatial, count)) {
+            return result;
+        }
+        result = self_collision_pairs(*spatial.ptr(), c, nullptr, radius, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
+    if (count >= SELF_COLLISION_BROADPHASE_MIN) {
+        Ref<SpatialGrid3D> grid;
+        grid.instantiate();
+        grid->set_cell_size(2.0f * max_abs_radius(nullptr, radius, count));
+        grid->build(centers);
+        result = self_collision_pairs(*grid.ptr(), c, nullptr, radius, count);
+        profile_scope.add_bytes(result.size() * sizeof(int32_t));
+        return result;
+    }
+
     float diameter = 2.0f * radius;
     float diameter_sq = diameter * diameter;
 
@@ -437,9 +638,30 @@ PackedInt32Array CollisionOps::spheres_self_collision_uniform(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
+PackedInt32Array CollisionOps::circles_self_collision_store(
+    const Ref<AgentStore2D>& store, const Ref<SpatialHash2D>& spatial) {
+
+    if (store.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: circles_self_collision_store needs a store");
+        return PackedInt32Array();
+    }
+    return circles_self_collision(store->position_column(), store->radius_column(), spatial);
+}
+
+PackedInt32Array CollisionOps::spheres_self_collision_store(
+    const Ref<AgentStore3D>& store, const Ref<SpatialHash3D>& spatial) {
+
+    if (store.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: spheres_self_collision_store needs a store");
+        return PackedInt32Array();
+    }
+    return spheres_self_collision(store->position_column(), store->radius_column(), spatial);
+}
+
 // ========== RAY INTERSECTION ==========
 
 // Helper: Ray-circle intersection, returns distance or INF
@@ -488,6 +710,7 @@ static float ray_circle_intersection(
 PackedFloat32Array CollisionOps::ray_vs_circles(
     const Vector2& origin, const Vector2& direction,
     const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+    AGENTITE_PROFILE("CollisionOps.ray_vs_circles", centers.size());
 
     int32_t count = std::min(centers.size(), radii.size());
     PackedFloat32Array result;
@@ -506,12 +729,14 @@ PackedFloat32Array CollisionOps::ray_vs_circles(
         dst[i] = ray_circle_intersection(origin.x, origin.y, dx, dy, c[i].x, c[i].y, r[i]);
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(float));
     return result;
 }
 
 PackedFloat32Array CollisionOps::ray_vs_circles_uniform(
     const Vector2& origin, const Vector2& direction,
     const PackedVector2Array& centers, float radius) {
+    AGENTITE_PROFILE("CollisionOps.ray_vs_circles_uniform", centers.size());
 
     int32_t count = centers.size();
     PackedFloat32Array result;
@@ -529,12 +754,14 @@ PackedFloat32Array CollisionOps::ray_vs_circles_uniform(
         dst[i] = ray_circle_intersection(origin.x, origin.y, dx, dy, c[i].x, c[i].y, radius);
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(float));
     return result;
 }
 
 PackedFloat32Array CollisionOps::ray_vs_aabbs_2d(
     const Vector2& origin, const Vector2& direction,
     const PackedVector2Array& mins, const PackedVector2Array& maxs) {
+    AGENTITE_PROFILE("CollisionOps.ray_vs_aabbs_2d", mins.size());
 
     int32_t count = std::min(mins.size(), maxs.size());
     PackedFloat32Array result;
@@ -568,6 +795,7 @@ PackedFloat32Array CollisionOps::ray_vs_aabbs_2d(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(float));
     return result;
 }
 
@@ -613,6 +841,7 @@ static float ray_sphere_intersection(
 PackedFloat32Array CollisionOps::ray_vs_spheres(
     const Vector3& origin, const Vector3& direction,
     const PackedVector3Array& centers, const PackedFloat32Array& radii) {
+    AGENTITE_PROFILE("CollisionOps.ray_vs_spheres", centers.size());
 
     int32_t count = std::min(centers.size(), radii.size());
     PackedFloat32Array result;
@@ -633,27 +862,41 @@ PackedFloat32Array CollisionOps::ray_vs_spheres(
                                          c[i].x, c[i].y, c[i].z, r[i]);
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(float));
     return result;
 }
 
-int CollisionOps::ray_first_circle(
-    const Vector2& origin, const Vector2& direction, float max_distance,
-    const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+// Helper: nearest circle hit closer than max_distance along a normalized direction.
+// Returns its index (best_dist set to the distance), or -1 if none.
+static int first_circle_hit(
+    float ox, float oy, float dx, float dy, float max_distance,
+    const Vector2* c, const float* r, int32_t count, float& best_dist) {
 
-    int32_t count = std::min(centers.size(), radii.size());
-    const Vector2* c = centers.ptr();
-    const float* r = radii.ptr();
+    int best_index = -1;
+    best_dist = max_distance;
 
-    // Normalize direction
-    float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-    float dx = len > 0.0f ? direction.x / len : 0.0f;
-    float dy = len > 0.0f ? direction.y / len : 0.0f;
+    for (int32_t i = 0; i < count; i++) {
+        float dist = ray_circle_intersection(ox, oy, dx, dy, c[i].x, c[i].y, r[i]);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best_index = i;
+        }
+    }
+
+    return best_index;
+}
+
+// Helper: nearest sphere hit, as first_circle_hit
+static int first_sphere_hit(
+    float ox, float oy, float oz, float dx, float dy, float dz, float max_distance,
+    const Vector3* c, const float* r, int32_t count, float& best_dist) {
 
     int best_index = -1;
-    float best_dist = max_distance;
+    best_dist = max_distance;
 
     for (int32_t i = 0; i < count; i++) {
-        float dist = ray_circle_intersection(origin.x, origin.y, dx, dy, c[i].x, c[i].y, r[i]);
+        float dist = ray_sphere_intersection(ox, oy, oz, dx, dy, dz,
+                                             c[i].x, c[i].y, c[i].z, r[i]);
         if (dist < best_dist) {
             best_dist = dist;
             best_index = i;
@@ -663,13 +906,100 @@ int CollisionOps::ray_first_circle(
     return best_index;
 }
 
+// Batches with at least this many shapes and rays find first hits through an
+// AABB tree of the shapes instead of testing every ray against every shape
+static const int32_t RAY_TREE_MIN_SHAPES = 64;
+static const int32_t RAY_TREE_MIN_RAYS = 16;
+
+// Exact nearest-hit search over many circles or spheres for many rays. Shapes
+// go into an AABBTreeCore by their bounds; each ray walks the tree nearest box
+// first, runs the exact test on the shapes whose box it enters, and prunes
+// boxes that start past the nearest exact hit. Ties go to the lower index and
+// hits must be closer than max_distance, as in first_circle_hit, so results
+// match the all-shapes loop. Shapes with non-finite bounds stay out of the
+// tree and are tested against every ray.
+template <int D>
+class RayShapeTree {
+public:
+    using Box = typename AABBTreeCore<D>::Box;
+
+    void add(int32_t index, const float* center, float radius) {
+        Box box;
+        float r = std::abs(radius);
+        bool finite = std::isfinite(r);
+        for (int a = 0; a < D; a++) {
+            // Widen by a few ulps of the coordinates so rounding in the exact
+            // test can never put a hit before its box's entry distance
+            float pad = (std::abs(center[a]) + r) * 1e-5f;
+            box.lo[a] = center[a] - r - pad;
+            box.hi[a] = center[a] + r + pad;
+            finite = finite && std::isfinite(box.lo[a]) && std::isfinite(box.hi[a]);
+        }
+        if (!finite) {
+            loose.push_back(index);
+            return;
+        }
+        int32_t id = tree.create(box, 0.0f);
+        if (id >= static_cast<int32_t>(shape_of.size())) {
+            shape_of.resize(id + 1, -1);
+        }
+        shape_of[id] = index;
+    }
+
+    // dist(i) is the exact distance to shape i (INF if missed)
+    template <typename Dist>
+    int32_t first_hit(const float* origin, const float* direction, float max_distance,
+                      const Dist& dist, float& best_dist) const {
+        int32_t best_index = -1;
+        best_dist = max_distance;
+        auto consider = [&](int32_t index) {
+            float d = dist(index);
+            if (d < max_distance && (best_index == -1 || d < best_dist || (d == best_dist && index < best_index))) {
+                best_dist = d;
+                best_index = index;
+            }
+        };
+        for (int32_t index : loose) {
+            consider(index);
+        }
+        tree.ray_entry(origin, direction, slack(max_distance), [&](int32_t id, float) {
+            consider(shape_of[id]);
+            return slack(best_dist);
+        });
+        return best_index;
+    }
+
+private:
+    AABBTreeCore<D> tree;
+    std::vector<int32_t> shape_of;  // Shape index of each tree proxy
+    std::vector<int32_t> loose;     // Shapes with non-finite bounds
+
+    // Prune a little past t: box entry and exact distance round differently
+    static float slack(float t) {
+        return t + std::abs(t) * 1e-5f + 1e-5f;
+    }
+};
+
+int CollisionOps::ray_first_circle(
+    const Vector2& origin, const Vector2& direction, float max_distance,
+    const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+
+    int32_t count = std::min(centers.size(), radii.size());
+
+    // Normalize direction
+    float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    float dx = len > 0.0f ? direction.x / len : 0.0f;
+    float dy = len > 0.0f ? direction.y / len : 0.0f;
+
+    float best_dist;
+    return first_circle_hit(origin.x, origin.y, dx, dy, max_distance, centers.ptr(), radii.ptr(), count, best_dist);
+}
+
 int CollisionOps::ray_first_sphere(
     const Vector3& origin, const Vector3& direction, float max_distance,
     const PackedVector3Array& centers, const PackedFloat32Array& radii) {
 
     int32_t count = std::min(centers.size(), radii.size());
-    const Vector3* c = centers.ptr();
-    const float* r = radii.ptr();
 
     // Normalize direction
     float len = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
@@ -677,19 +1007,141 @@ int CollisionOps::ray_first_sphere(
     float dy = len > 0.0f ? direction.y / len : 0.0f;
     float dz = len > 0.0f ? direction.z / len : 0.0f;
 
-    int best_index = -1;
-    float best_dist = max_distance;
+    float best_dist;
+    return first_sphere_hit(origin.x, origin.y, origin.z, dx, dy, dz, max_distance,
+                            centers.ptr(), radii.ptr(), count, best_dist);
+}
 
-    for (int32_t i = 0; i < count; i++) {
-        float dist = ray_sphere_intersection(origin.x, origin.y, origin.z, dx, dy, dz,
-                                             c[i].x, c[i].y, c[i].z, r[i]);
-        if (dist < best_dist) {
-            best_dist = dist;
-            best_index = i;
+Array CollisionOps::ray_first_circles_batch(
+    const PackedVector2Array& origins, const PackedVector2Array& directions,
+    const PackedFloat32Array& max_distances,
+    const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+    AGENTITE_PROFILE("CollisionOps.ray_first_circles_batch", origins.size());
+    Array result;
+    int32_t ray_count = origins.size();
+    if (directions.size() != ray_count || max_distances.size() != ray_count) {
+        UtilityFunctions::push_error("AgentiteG: origins, directions and max_distances arrays must have same size");
+        return result;
+    }
+
+    int32_t count = std::min(centers.size(), radii.size());
+    PackedInt32Array ids;
+    PackedFloat32Array distances;
+    ids.resize(ray_count);
+    distances.resize(ray_count);
+
+    const Vector2* origins_ptr = origins.ptr();
+    const Vector2* directions_ptr = directions.ptr();
+    const float* max_ptr = max_distances.ptr();
+    const Vector2* c = centers.ptr();
+    const float* r = radii.ptr();
+    int32_t* ids_ptr = ids.ptrw();
+    float* distances_ptr = distances.ptrw();
+
+    // Large batches search an AABB tree of the circles; small ones test every
+    // circle. Both give exactly what ray_first_circle gives for each ray, and
+    // rays are independent, so they run across worker threads.
+    bool use_tree = count >= RAY_TREE_MIN_SHAPES && ray_count >= RAY_TREE_MIN_RAYS;
+    RayShapeTree<2> shapes;
+    if (use_tree) {
+        for (int32_t j = 0; j < count; j++) {
+            const float center[2] = {static_cast<float>(c[j].x), static_cast<float>(c[j].y)};
+            shapes.add(j, center, r[j]);
         }
     }
 
-    return best_index;
+    parallel::for_range(ray_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const Vector2& direction = directions_ptr[i];
+            float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+            float dx = len > 0.0f ? direction.x / len : 0.0f;
+            float dy = len > 0.0f ? direction.y / len : 0.0f;
+            float ox = origins_ptr[i].x;
+            float oy = origins_ptr[i].y;
+
+            float best_dist;
+            if (use_tree && len > 0.0f) {
+                const float o[2] = {ox, oy};
+                const float d[2] = {dx, dy};
+                ids_ptr[i] = shapes.first_hit(o, d, max_ptr[i], [&](int32_t j) {
+                    return ray_circle_intersection(ox, oy, dx, dy, c[j].x, c[j].y, r[j]);
+                }, best_dist);
+            } else {
+                ids_ptr[i] = first_circle_hit(ox, oy, dx, dy, max_ptr[i], c, r, count, best_dist);
+            }
+            distances_ptr[i] = ids_ptr[i] != -1 ? best_dist : std::numeric_limits<float>::infinity();
+        }
+    });
+
+    profile_scope.add_bytes(ids.size() * (sizeof(int32_t) + sizeof(float)));
+    result.append(ids);
+    result.append(distances);
+    return result;
+}
+
+Array CollisionOps::ray_first_spheres_batch(
+    const PackedVector3Array& origins, const PackedVector3Array& directions,
+    const PackedFloat32Array& max_distances,
+    const PackedVector3Array& centers, const PackedFloat32Array& radii) {
+    AGENTITE_PROFILE("CollisionOps.ray_first_spheres_batch", origins.size());
+    Array result;
+    int32_t ray_count = origins.size();
+    if (directions.size() != ray_count || max_distances.size() != ray_count) {
+        UtilityFunctions::push_error("AgentiteG: origins, directions and max_distances arrays must have same size");
+        return result;
+    }
+
+    int32_t count = std::min(centers.size(), radii.size());
+    PackedInt32Array ids;
+    PackedFloat32Array distances;
+    ids.resize(ray_count);
+    distances.resize(ray_count);
+
+    const Vector3* origins_ptr = origins.ptr();
+    const Vector3* directions_ptr = directions.ptr();
+    const float* max_ptr = max_distances.ptr();
+    const Vector3* c = centers.ptr();
+    const float* r = radii.ptr();
+    int32_t* ids_ptr = ids.ptrw();
+    float* distances_ptr = distances.ptrw();
+
+    // Same split as ray_first_circles_batch
+    bool use_tree = count >= RAY_TREE_MIN_SHAPES && ray_count >= RAY_TREE_MIN_RAYS;
+    RayShapeTree<3> shapes;
+    if (use_tree) {
+        for (int32_t j = 0; j < count; j++) {
+            const float center[3] = {static_cast<float>(c[j].x), static_cast<float>(c[j].y), static_cast<float>(c[j].z)};
+            shapes.add(j, center, r[j]);
+        }
+    }
+
+    parallel::for_range(ray_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const Vector3& direction = directions_ptr[i];
+            float len = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+            float dx = len > 0.0f ? direction.x / len : 0.0f;
+            float dy = len > 0.0f ? direction.y / len : 0.0f;
+            float dz = len > 0.0f ? direction.z / len : 0.0f;
+
+            float best_dist;
+            const Vector3& o = origins_ptr[i];
+            if (use_tree && len > 0.0f) {
+                const float origin[3] = {static_cast<float>(o.x), static_cast<float>(o.y), static_cast<float>(o.z)};
+                const float d[3] = {dx, dy, dz};
+                ids_ptr[i] = shapes.first_hit(origin, d, max_ptr[i], [&](int32_t j) {
+                    return ray_sphere_intersection(o.x, o.y, o.z, dx, dy, dz, c[j].x, c[j].y, c[j].z, r[j]);
+                }, best_dist);
+            } else {
+                ids_ptr[i] = first_sphere_hit(o.x, o.y, o.z, dx, dy, dz, max_ptr[i], c, r, count, best_dist);
+            }
+            distances_ptr[i] = ids_ptr[i] != -1 ? best_dist : std::numeric_limits<float>::infinity();
+        }
+    });
+
+    profile_scope.add_bytes(ids.size() * (sizeof(int32_t) + sizeof(float)));
+    result.append(ids);
+    result.append(distances);
+    return result;
 }
 
 // ========== SEGMENT INTERSECTION ==========
@@ -732,6 +1184,7 @@ static bool segments_intersect_impl(
 PackedInt32Array CollisionOps::segments_intersect(
     const PackedVector2Array& starts_a, const PackedVector2Array& ends_a,
     const PackedVector2Array& starts_b, const PackedVector2Array& ends_b) {
+    AGENTITE_PROFILE("CollisionOps.segments_intersect", starts_a.size() * starts_b.size());
 
     PackedInt32Array result;
     int32_t count_a = std::min(starts_a.size(), ends_a.size());
@@ -752,6 +1205,7 @@ PackedInt32Array CollisionOps::segments_intersect(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
@@ -784,6 +1238,7 @@ PackedVector2Array CollisionOps::segment_intersection_points(
 
 PackedInt32Array CollisionOps::segments_self_intersect(
     const PackedVector2Array& starts, const PackedVector2Array& ends) {
+    AGENTITE_PROFILE("CollisionOps.segments_self_intersect", starts.size());
 
     PackedInt32Array result;
     int32_t count = std::min(starts.size(), ends.size());
@@ -801,6 +1256,7 @@ PackedInt32Array CollisionOps::segments_self_intersect(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
@@ -809,6 +1265,7 @@ PackedInt32Array CollisionOps::segments_self_intersect(
 PackedVector2Array CollisionOps::closest_points_on_segments(
     const PackedVector2Array& points,
     const PackedVector2Array& seg_starts, const PackedVector2Array& seg_ends) {
+    AGENTITE_PROFILE("CollisionOps.closest_points_on_segments", points.size());
 
     int32_t point_count = points.size();
     int32_t seg_count = std::min(seg_starts.size(), seg_ends.size());
@@ -840,12 +1297,14 @@ PackedVector2Array CollisionOps::closest_points_on_segments(
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
 PackedInt32Array CollisionOps::closest_circle_indices(
     const PackedVector2Array& points,
     const PackedVector2Array& centers, const PackedFloat32Array& radii) {
+    AGENTITE_PROFILE("CollisionOps.closest_circle_indices", points.size());
 
     int32_t point_count = points.size();
     int32_t circle_count = std::min(centers.size(), radii.size());
@@ -875,12 +1334,14 @@ PackedInt32Array CollisionOps::closest_circle_indices(
         dst[i] = best_idx;
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array CollisionOps::closest_circle_indices_uniform(
     const PackedVector2Array& points,
     const PackedVector2Array& centers, float radius) {
+    AGENTITE_PROFILE("CollisionOps.closest_circle_indices_uniform", points.size());
 
     int32_t point_count = points.size();
     int32_t circle_count = centers.size();
@@ -909,6 +1370,7 @@ PackedInt32Array CollisionOps::closest_circle_indices_uniform(
         dst[i] = best_idx;
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
@@ -19,6 +19,11 @@
 #ifndef AGENTITE_COLLISION_OPS_HPP
 #define AGENTITE_COLLISION_OPS_HPP
 
+#include "arrays/agent_store_2d.hpp"
+#include "arrays/agent_store_3d.hpp"
+#include "spatial/spatial_hash_2d.hpp"
+#include "spatial/spatial_hash_3d.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
@@ -28,6 +33,7 @@
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/array.hpp>
 
 namespace godot {
 
@@ -92,23 +98,38 @@ public:
 
     // ========== SELF-COLLISION ==========
     // Returns collision pairs within the same set
-    // Each pair appears once (not duplicated as [i,j] and [j,i])
+    // Each pair appears once as [i, j] with i < j, ordered by i then j
+    // Large sets use a grid broadphase; pass a SpatialHash built from the same
+    // centers this frame to reuse it instead
 
     // Circle self-collision (different radii)
     static PackedInt32Array circles_self_collision(
-        const PackedVector2Array& centers, const PackedFloat32Array& radii);
+        const PackedVector2Array& centers, const PackedFloat32Array& radii,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>());
 
     // Circle self-collision (uniform radius)
     static PackedInt32Array circles_self_collision_uniform(
-        const PackedVector2Array& centers, float radius);
+        const PackedVector2Array& centers, float radius,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>());
 
     // Sphere self-collision (different radii)
     static PackedInt32Array spheres_self_collision(
-        const PackedVector3Array& centers, const PackedFloat32Array& radii);
+        const PackedVector3Array& centers, const PackedFloat32Array& radii,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>());
 
     // Sphere self-collision (uniform radius)
     static PackedInt32Array spheres_self_collision_uniform(
-        const PackedVector3Array& centers, float radius);
+        const PackedVector3Array& centers, float radius,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>());
+
+    // Self-collision of an AgentStore's position and radius columns
+    // Pairs are dense store indices (AgentStore.get_handle() maps them to handles)
+    static PackedInt32Array circles_self_collision_store(
+        const Ref<AgentStore2D>& store,
+        const Ref<SpatialHash2D>& spatial = Ref<SpatialHash2D>());
+    static PackedInt32Array spheres_self_collision_store(
+        const Ref<AgentStore3D>& store,
+        const Ref<SpatialHash3D>& spatial = Ref<SpatialHash3D>());
 
     // ========== RAY INTERSECTION ==========
 
@@ -142,6 +163,19 @@ public:
         const Vector3& origin, const Vector3& direction, float max_distance,
         const PackedVector3Array& centers, const PackedFloat32Array& radii);
 
+    // ray_first_circle for many rays (one per origin, direction, max_distance)
+    // Returns [ids: PackedInt32Array (-1 if none), distances: PackedFloat32Array (INF if none)]
+    static Array ray_first_circles_batch(
+        const PackedVector2Array& origins, const PackedVector2Array& directions,
+        const PackedFloat32Array& max_distances,
+        const PackedVector2Array& centers, const PackedFloat32Array& radii);
+
+    // ray_first_sphere for many rays, returning [ids, distances] as above
+    static Array ray_first_spheres_batch(
+        const PackedVector3Array& origins, const PackedVector3Array& directions,
+        const PackedFloat32Array& max_distances,
+        const PackedVector3Array& centers, const PackedFloat32Array& radii);
+
     // ========== SEGMENT INTERSECTION ==========
 
     // Check which segment pairs intersect
@@ -0,0 +1,192 @@
+/**
+ * Parallel Implementation
+ */
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define AGENTITE_NO_THREADS
+#endif
+
+namespace godot {
+namespace parallel {
+
+// Upper bound on worker threads, regardless of core count
+static const int32_t MAX_WORKERS = 31;
+
+// Set while a thread is executing chunks, so nested loops run inline
+static thread_local bool in_parallel_loop = false;
+
+struct Job {
+    const std::function<void(int64_t, int64_t)>* body = nullptr;
+    int64_t count = 0;
+    int64_t chunk = 1;
+    std::atomic<int64_t> next{0};
+};
+
+bool is_inside_loop() {
+    return in_parallel_loop;
+}
+
+static void run_chunks(Job& job) {
+    bool was_inside = in_parallel_loop;
+    in_parallel_loop = true;
+    while (true) {
+        int64_t begin = job.next.fetch_add(job.chunk);
+        if (begin >= job.count) {
+            break;
+        }
+        (*job.body)(begin, std::min(begin + job.chunk, job.count));
+    }
+    in_parallel_loop = was_inside;
+}
+
+class WorkerPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    Job* current = nullptr;
+    uint64_t generation = 0;
+    int32_t busy = 0;
+    bool stopping = false;
+
+    void worker_loop(uint64_t seen) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            Job* job = current;
+            lock.unlock();
+
+            run_chunks(*job);
+
+            lock.lock();
+            if (--busy == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+    // Serializes submissions; a second concurrent caller runs serially instead
+    std::mutex submit_mutex;
+
+    ~WorkerPool() {
+        stop();
+    }
+
+    int32_t worker_count() const {
+        return static_cast<int32_t>(threads.size());
+    }
+
+    void start() {
+        if (!threads.empty()) {
+            return;
+        }
+#ifndef AGENTITE_NO_THREADS
+        int32_t hw = static_cast<int32_t>(std::thread::hardware_concurrency());
+        int32_t workers = std::min(MAX_WORKERS, std::max(0, hw - 1));
+        stopping = false;
+        threads.reserve(workers);
+        for (int32_t i = 0; i < workers; i++) {
+            threads.emplace_back(&WorkerPool::worker_loop, this, generation);
+        }
+#endif
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        threads.clear();
+        stopping = false;
+    }
+
+    void run(Job& job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &job;
+            busy = static_cast<int32_t>(threads.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        // The calling thread works too
+        run_chunks(job);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]() { return busy == 0; });
+        current = nullptr;
+    }
+};
+
+static WorkerPool& get_pool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+int32_t get_thread_count() {
+    WorkerPool& pool = get_pool();
+    std::lock_guard<std::mutex> lock(pool.submit_mutex);
+    pool.start();
+    return pool.worker_count() + 1;
+}
+
+void for_range(int64_t count, int64_t min_chunk, const std::function<void(int64_t, int64_t)>& body) {
+    if (count <= 0) {
+        return;
+    }
+    min_chunk = std::max<int64_t>(1, min_chunk);
+
+    if (count < min_chunk * 2 || in_parallel_loop) {
+        body(0, count);
+        return;
+    }
+
+    WorkerPool& pool = get_pool();
+    std::unique_lock<std::mutex> submit(pool.submit_mutex, std::try_to_lock);
+    if (!submit.owns_lock()) {
+        body(0, count);
+        return;
+    }
+
+    pool.start();
+    int32_t threads = pool.worker_count() + 1;
+    if (threads <= 1) {
+        body(0, count);
+        return;
+    }
+
+    // A few chunks per thread so faster threads can pick up slack
+    Job job;
+    job.body = &body;
+    job.count = count;
+    job.chunk = std::max(min_chunk, (count + threads * 4 - 1) / (threads * 4));
+    pool.run(job);
+}
+
+void shutdown() {
+    WorkerPool& pool = get_pool();
+    std::lock_guard<std::mutex> lock(pool.submit_mutex);
+    pool.stop();
+}
+
+}
+}
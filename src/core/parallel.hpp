@@ -0,0 +1,52 @@
+/**
+ * Parallel - Internal worker pool for data-parallel loops
+ *
+ * Splits an index range into contiguous chunks and runs them on a small,
+ * persistent pool of worker threads, with the calling thread taking part.
+ * Chunks are claimed dynamically, so uneven per-item cost still balances.
+ *
+ * The range is only split, never reordered: callers write each item's
+ * result into a preallocated slot, so output order matches input order.
+ *
+ * Runs serially on the calling thread when:
+ * - the range is smaller than two chunks
+ * - the machine has a single hardware thread
+ * - called from inside another parallel loop (no nested fan-out)
+ * - another thread is already running a parallel loop
+ *
+ * Usage (internal):
+ *   std::vector<PackedInt32Array> out(count);
+ *   parallel::for_range(count, 32, [&](int64_t begin, int64_t end) {
+ *       for (int64_t i = begin; i < end; i++) out[i] = query(i);
+ *   });
+ */
+
+#ifndef AGENTITE_PARALLEL_HPP
+#define AGENTITE_PARALLEL_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace godot {
+namespace parallel {
+
+// Minimum number of spatial queries per chunk for batch query methods
+static constexpr int64_t QUERY_CHUNK = 32;
+
+// Number of threads (including the caller) a parallel loop may use
+int32_t get_thread_count();
+
+// Run body(begin, end) over sub-ranges covering [0, count)
+// Each chunk holds at least min_chunk items
+void for_range(int64_t count, int64_t min_chunk, const std::function<void(int64_t, int64_t)>& body);
+
+// True while the current thread is running chunks of a parallel loop
+bool is_inside_loop();
+
+// Stop and join the worker threads (restarted lazily on next use)
+void shutdown();
+
+}
+}
+
+#endif // AGENTITE_PARALLEL_HPP
@@ -0,0 +1,215 @@
+/**
+ * Profiler Implementation
+ */
+
+#include "profiler.hpp"
+#include "profiling.hpp"
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+namespace godot {
+
+enum MonitorField {
+    MONITOR_MS,
+    MONITOR_CALLS,
+};
+
+static const int64_t MONITOR_TOTAL = -1;
+
+static bool monitors_enabled = false;
+static int64_t monitored_probes = 0;  // Probes [0, n) have monitors
+
+static double read_monitor(int64_t probe_index, int64_t field) {
+    uint64_t calls = 0;
+    uint64_t ns = 0;
+    if (probe_index == MONITOR_TOTAL) {
+        profiling::Totals t = profiling::frame_total();
+        calls = t.calls;
+        ns = t.ns;
+    } else if (profiling::Probe* p = profiling::probe_at(probe_index)) {
+        calls = p->frame_calls;
+        ns = p->frame_ns;
+    }
+    return field == MONITOR_MS ? static_cast<double>(ns) / 1e6 : static_cast<double>(calls);
+}
+
+static String monitor_id(const String& name, int64_t field) {
+    return String("AgentiteG/") + name + (field == MONITOR_MS ? " (ms)" : " (calls)");
+}
+
+static void add_monitor(Performance* performance, const String& name, int64_t probe_index, int64_t field) {
+    StringName id = monitor_id(name, field);
+    if (performance->has_custom_monitor(id)) {
+        return;
+    }
+    Array args;
+    args.push_back(probe_index);
+    args.push_back(field);
+    performance->add_custom_monitor(id, callable_mp_static(&read_monitor), args);
+}
+
+static void remove_monitor(Performance* performance, const String& name, int64_t field) {
+    StringName id = monitor_id(name, field);
+    if (performance->has_custom_monitor(id)) {
+        performance->remove_custom_monitor(id);
+    }
+}
+
+// Add monitors for probes registered since the last call
+static void sync_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (!performance) {
+        return;
+    }
+    add_monitor(performance, "Total", MONITOR_TOTAL, MONITOR_MS);
+    add_monitor(performance, "Total", MONITOR_TOTAL, MONITOR_CALLS);
+    int64_t count = profiling::probe_count();
+    for (int64_t i = monitored_probes; i < count; i++) {
+        String name = profiling::probe_at(i)->name;
+        add_monitor(performance, name, i, MONITOR_MS);
+        add_monitor(performance, name, i, MONITOR_CALLS);
+    }
+    monitored_probes = count;
+}
+
+static void clear_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (!performance) {
+        return;
+    }
+    remove_monitor(performance, "Total", MONITOR_MS);
+    remove_monitor(performance, "Total", MONITOR_CALLS);
+    for (int64_t i = 0; i < monitored_probes; i++) {
+        String name = profiling::probe_at(i)->name;
+        remove_monitor(performance, name, MONITOR_MS);
+        remove_monitor(performance, name, MONITOR_CALLS);
+    }
+    monitored_probes = 0;
+}
+
+static SceneTree* get_scene_tree() {
+    Engine* engine = Engine::get_singleton();
+    return engine ? Object::cast_to<SceneTree>(engine->get_main_loop()) : nullptr;
+}
+
+static Callable frame_callable() {
+    return callable_mp_static(&Profiler::end_frame);
+}
+
+void Profiler::_bind_methods() {
+    // Control
+    ClassDB::bind_static_method("Profiler", D_METHOD("set_enabled", "enabled", "monitors"), &Profiler::set_enabled, DEFVAL(true));
+    ClassDB::bind_static_method("Profiler", D_METHOD("is_enabled"), &Profiler::is_enabled);
+    ClassDB::bind_static_method("Profiler", D_METHOD("is_available"), &Profiler::is_available);
+    ClassDB::bind_static_method("Profiler", D_METHOD("reset"), &Profiler::reset);
+    ClassDB::bind_static_method("Profiler", D_METHOD("end_frame"), &Profiler::end_frame);
+
+    // Results
+    ClassDB::bind_static_method("Profiler", D_METHOD("get_probe_names"), &Profiler::get_probe_names);
+    ClassDB::bind_static_method("Profiler", D_METHOD("get_stats"), &Profiler::get_stats);
+    ClassDB::bind_static_method("Profiler", D_METHOD("get_frame_time_ms"), &Profiler::get_frame_time_ms);
+    ClassDB::bind_static_method("Profiler", D_METHOD("get_frame_calls"), &Profiler::get_frame_calls);
+}
+
+// ========== CONTROL ==========
+
+void Profiler::set_enabled(bool enabled, bool monitors) {
+    if (!is_available()) {
+        return;
+    }
+    profiling::set_enabled(enabled);
+
+    SceneTree* tree = get_scene_tree();
+    Callable on_frame = frame_callable();
+    if (enabled) {
+        if (tree && !tree->is_connected("process_frame", on_frame)) {
+            tree->connect("process_frame", on_frame);
+        }
+    } else if (tree && tree->is_connected("process_frame", on_frame)) {
+        tree->disconnect("process_frame", on_frame);
+    }
+
+    monitors_enabled = enabled && monitors;
+    if (monitors_enabled) {
+        sync_monitors();
+    } else {
+        clear_monitors();
+    }
+}
+
+bool Profiler::is_enabled() {
+    return profiling::is_enabled();
+}
+
+bool Profiler::is_available() {
+#ifdef AGENTITE_NO_PROFILING
+    return false;
+#else
+    return true;
+#endif
+}
+
+void Profiler::reset() {
+    profiling::reset();
+}
+
+void Profiler::end_frame() {
+    profiling::end_frame();
+    if (monitors_enabled && profiling::probe_count() != monitored_probes) {
+        sync_monitors();
+    }
+}
+
+// ========== RESULTS ==========
+
+PackedStringArray Profiler::get_probe_names() {
+    PackedStringArray names;
+    int64_t count = profiling::probe_count();
+    for (int64_t i = 0; i < count; i++) {
+        names.push_back(profiling::probe_at(i)->name);
+    }
+    return names;
+}
+
+Dictionary Profiler::get_stats() {
+    Dictionary stats;
+    int64_t count = profiling::probe_count();
+    for (int64_t i = 0; i < count; i++) {
+        const profiling::Probe* p = profiling::probe_at(i);
+        Dictionary entry;
+        entry["calls"] = static_cast<int64_t>(p->calls.load(std::memory_order_relaxed));
+        entry["total_ns"] = static_cast<int64_t>(p->total_ns.load(std::memory_order_relaxed));
+        entry["max_ns"] = static_cast<int64_t>(p->max_ns.load(std::memory_order_relaxed));
+        entry["items"] = static_cast<int64_t>(p->items.load(std::memory_order_relaxed));
+        entry["bytes"] = static_cast<int64_t>(p->bytes.load(std::memory_order_relaxed));
+        entry["frame_calls"] = static_cast<int64_t>(p->frame_calls);
+        entry["frame_ns"] = static_cast<int64_t>(p->frame_ns);
+        entry["frame_max_ns"] = static_cast<int64_t>(p->frame_max_ns);
+        entry["frame_items"] = static_cast<int64_t>(p->frame_items);
+        entry["frame_bytes"] = static_cast<int64_t>(p->frame_bytes);
+        stats[String(p->name)] = entry;
+    }
+    return stats;
+}
+
+double Profiler::get_frame_time_ms() {
+    return static_cast<double>(profiling::frame_total().ns) / 1e6;
+}
+
+int64_t Profiler::get_frame_calls() {
+    return static_cast<int64_t>(profiling::frame_total().calls);
+}
+
+void Profiler::shutdown() {
+    if (!profiling::is_enabled() && !monitors_enabled) {
+        return;
+    }
+    set_enabled(false);
+}
+
+}
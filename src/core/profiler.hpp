@@ -0,0 +1,74 @@
+/**
+ * Profiler - Opt-in timing of AgentiteG calls, with Performance monitors
+ *
+ * The spatial, pathfinding, collision and batch entry points carry probes
+ * that count calls, time, items and result bytes. Profiler turns them on,
+ * reads them, and registers custom monitors with the Performance singleton
+ * so they appear in the debugger's Monitors tab:
+ *
+ *   AgentiteG/Total (ms)                    time in AgentiteG last frame
+ *   AgentiteG/Total (calls)
+ *   AgentiteG/SpatialHash2D.build (ms)      one pair per probe that has run
+ *   AgentiteG/SpatialHash2D.build (calls)
+ *
+ * Frames end on SceneTree's process_frame signal. With a custom MainLoop,
+ * call end_frame() once per frame instead.
+ *
+ * Usage:
+ *   Profiler.set_enabled(true)
+ *   ...
+ *   var ms = Profiler.get_frame_time_ms()
+ *   var stats = Profiler.get_stats()  # For telemetry export
+ */
+
+#ifndef AGENTITE_PROFILER_HPP
+#define AGENTITE_PROFILER_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+namespace godot {
+
+class Profiler : public RefCounted {
+    GDCLASS(Profiler, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    // ========== CONTROL ==========
+
+    // Start/stop counting. With monitors, also adds/removes the Performance monitors.
+    static void set_enabled(bool enabled, bool monitors = true);
+    static bool is_enabled();
+
+    // False when built with profiling=no (probes compiled out)
+    static bool is_available();
+
+    // Zero all counters
+    static void reset();
+
+    // Close the current frame (automatic when the main loop is a SceneTree)
+    static void end_frame();
+
+    // ========== RESULTS ==========
+
+    // Names of the probes that have run at least once
+    static PackedStringArray get_probe_names();
+
+    // {probe_name: {"calls", "total_ns", "max_ns", "items", "bytes",
+    //   "frame_calls", "frame_ns", "frame_max_ns", "frame_items", "frame_bytes"}}
+    static Dictionary get_stats();
+
+    // Outermost AgentiteG calls over the last complete frame
+    static double get_frame_time_ms();
+    static int64_t get_frame_calls();
+
+    // Remove monitors and the frame hook; called on module shutdown
+    static void shutdown();
+};
+
+}
+
+#endif // AGENTITE_PROFILER_HPP
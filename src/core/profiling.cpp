@@ -0,0 +1,176 @@
+/**
+ * Profiling Implementation
+ */
+
+#include "profiling.hpp"
+#include "parallel.hpp"
+
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace godot {
+namespace profiling {
+
+std::atomic<bool> enabled_flag{false};
+
+// Set while the outermost scope on this thread is open
+static thread_local bool in_scope = false;
+
+static std::atomic<uint64_t> top_calls{0};
+static std::atomic<uint64_t> top_ns{0};
+static Totals top_mark;
+static Totals top_frame;
+
+static std::mutex& registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<Probe*>& registry() {
+    static std::vector<Probe*> probes;
+    return probes;
+}
+
+static uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static void update_max(std::atomic<uint64_t>& slot, uint64_t value) {
+    uint64_t seen = slot.load(std::memory_order_relaxed);
+    while (value > seen && !slot.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+static bool name_taken(const char* p_name) {
+    for (const Probe* p : registry()) {
+        if (std::strcmp(p->name, p_name) == 0) return true;
+    }
+    return false;
+}
+
+Probe::Probe(const char* p_name) : name(p_name) {
+    bool duplicate = false;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        if (name_taken(p_name)) {
+            duplicate = true;
+            int copy = 2;
+            do {
+                unique_name = std::string(p_name) + " #" + std::to_string(copy++);
+            } while (name_taken(unique_name.c_str()));
+            name = unique_name.c_str();
+        }
+        registry().push_back(this);
+    }
+    if (duplicate) {
+        UtilityFunctions::push_error(String("AgentiteG: profiling probe \"") + p_name +
+                                     "\" is used by more than one entry point, registered as \"" + name + "\"");
+    }
+}
+
+void set_enabled(bool p_enabled) {
+    enabled_flag.store(p_enabled, std::memory_order_relaxed);
+}
+
+bool begin(uint64_t& start) {
+    if (in_scope || parallel::is_inside_loop()) {
+        return false;
+    }
+    in_scope = true;
+    start = now_ns();
+    return true;
+}
+
+void end(Probe& probe, uint64_t start, uint64_t items, uint64_t bytes) {
+    uint64_t elapsed = now_ns() - start;
+    in_scope = false;
+
+    probe.calls.fetch_add(1, std::memory_order_relaxed);
+    probe.total_ns.fetch_add(elapsed, std::memory_order_relaxed);
+    probe.items.fetch_add(items, std::memory_order_relaxed);
+    if (bytes > 0) {
+        probe.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    update_max(probe.max_ns, elapsed);
+    update_max(probe.window_max_ns, elapsed);
+
+    top_calls.fetch_add(1, std::memory_order_relaxed);
+    top_ns.fetch_add(elapsed, std::memory_order_relaxed);
+}
+
+int64_t probe_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    return static_cast<int64_t>(registry().size());
+}
+
+Probe* probe_at(int64_t index) {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    if (index < 0 || index >= static_cast<int64_t>(registry().size())) {
+        return nullptr;
+    }
+    return registry()[index];
+}
+
+void end_frame() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (Probe* p : registry()) {
+        uint64_t calls = p->calls.load(std::memory_order_relaxed);
+        uint64_t ns = p->total_ns.load(std::memory_order_relaxed);
+        uint64_t items = p->items.load(std::memory_order_relaxed);
+        uint64_t bytes = p->bytes.load(std::memory_order_relaxed);
+
+        p->frame_calls = calls - p->mark_calls;
+        p->frame_ns = ns - p->mark_ns;
+        p->frame_items = items - p->mark_items;
+        p->frame_bytes = bytes - p->mark_bytes;
+        p->frame_max_ns = p->window_max_ns.exchange(0, std::memory_order_relaxed);
+
+        p->mark_calls = calls;
+        p->mark_ns = ns;
+        p->mark_items = items;
+        p->mark_bytes = bytes;
+    }
+
+    Totals now = total();
+    top_frame.calls = now.calls - top_mark.calls;
+    top_frame.ns = now.ns - top_mark.ns;
+    top_mark = now;
+}
+
+void reset() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (Probe* p : registry()) {
+        p->calls.store(0, std::memory_order_relaxed);
+        p->total_ns.store(0, std::memory_order_relaxed);
+        p->max_ns.store(0, std::memory_order_relaxed);
+        p->items.store(0, std::memory_order_relaxed);
+        p->bytes.store(0, std::memory_order_relaxed);
+        p->window_max_ns.store(0, std::memory_order_relaxed);
+        p->mark_calls = p->mark_ns = p->mark_items = p->mark_bytes = 0;
+        p->frame_calls = p->frame_ns = p->frame_max_ns = p->frame_items = p->frame_bytes = 0;
+    }
+    top_calls.store(0, std::memory_order_relaxed);
+    top_ns.store(0, std::memory_order_relaxed);
+    top_mark = Totals();
+    top_frame = Totals();
+}
+
+Totals total() {
+    Totals t;
+    t.calls = top_calls.load(std::memory_order_relaxed);
+    t.ns = top_ns.load(std::memory_order_relaxed);
+    return t;
+}
+
+Totals frame_total() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    return top_frame;
+}
+
+}
+}
@@ -0,0 +1,163 @@
+/**
+ * Profiling - Internal scoped timers and counters for hot entry points
+ *
+ * Each instrumented entry point owns a Probe that counts calls, total and
+ * maximum time, items processed and bytes of result buffers it allocated.
+ * Counting is off until Profiler.set_enabled(true); while off, a Scope
+ * costs one relaxed atomic load and a branch. Building with
+ * `scons profiling=no` compiles the probes out entirely.
+ *
+ * Probes register themselves the first time their entry point runs, so
+ * only entry points that are actually used show up. Names must be unique
+ * per call site (e.g. "DynamicAABBTree2D.query_box", not "query_box"): a
+ * second probe with a taken name reports an error and registers as
+ * "<name> #2", so the two never share a monitor.
+ *
+ * Only the outermost scope on a thread records. An entry point called by
+ * another one (e.g. query_radius inside query_radius_batch), directly or
+ * from the workers of a parallel loop, is counted as part of the caller.
+ * Probe times therefore add up to the time spent in AgentiteG, and batch
+ * calls don't contend on the counters of their per-item helpers.
+ *
+ * The frame boundary (Profiler.end_frame, called on SceneTree's
+ * process_frame) snapshots per-frame values for the Performance monitors.
+ *
+ * Usage (internal):
+ *   PackedInt32Array SpatialHash2D::query_radius(Vector2 origin, float radius) const {
+ *       AGENTITE_PROFILE("SpatialHash2D.query_radius", 1);
+ *       ...
+ *       profile_scope.add_bytes(result.size() * sizeof(int32_t));
+ *       return result;
+ *   }
+ */
+
+#ifndef AGENTITE_PROFILING_HPP
+#define AGENTITE_PROFILING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace godot {
+namespace profiling {
+
+// Cumulative counters for one entry point. Frame values are written by
+// end_frame() on the main thread only.
+struct Probe {
+    const char* name;
+    std::string unique_name;  // Storage for name when p_name was already taken
+
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> window_max_ns{0};  // Max since the last frame boundary
+
+    // Counter values at the last frame boundary
+    uint64_t mark_calls = 0;
+    uint64_t mark_ns = 0;
+    uint64_t mark_items = 0;
+    uint64_t mark_bytes = 0;
+
+    // Deltas over the last complete frame
+    uint64_t frame_calls = 0;
+    uint64_t frame_ns = 0;
+    uint64_t frame_max_ns = 0;
+    uint64_t frame_items = 0;
+    uint64_t frame_bytes = 0;
+
+    explicit Probe(const char* p_name);
+};
+
+// Totals over all probes
+struct Totals {
+    uint64_t calls = 0;
+    uint64_t ns = 0;
+};
+
+extern std::atomic<bool> enabled_flag;
+
+inline bool is_enabled() {
+    return enabled_flag.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool p_enabled);
+
+// Start timing if this is the outermost scope on the current thread
+// (only called while enabled); end() must follow a successful begin()
+bool begin(uint64_t& start);
+void end(Probe& probe, uint64_t start, uint64_t items, uint64_t bytes);
+
+// Registry access (probe indices are stable for the life of the library)
+int64_t probe_count();
+Probe* probe_at(int64_t index);
+
+// Roll per-frame values from the counters (main thread)
+void end_frame();
+
+// Zero all counters and frame values
+void reset();
+
+Totals total();        // Since the last reset
+Totals frame_total();  // Over the last complete frame
+
+#ifndef AGENTITE_NO_PROFILING
+
+class Scope {
+private:
+    Probe* probe = nullptr;  // Null when off at entry or nested
+    uint64_t start = 0;
+    uint64_t items = 0;
+    uint64_t bytes = 0;
+
+public:
+    Scope(Probe& p_probe, int64_t p_items) {
+        if (is_enabled() && begin(start)) {
+            probe = &p_probe;
+            items = p_items > 0 ? static_cast<uint64_t>(p_items) : 0;
+        }
+    }
+
+    ~Scope() {
+        if (probe) {
+            end(*probe, start, items, bytes);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Bytes of result buffers allocated by the call
+    void add_bytes(int64_t p_bytes) {
+        bytes += p_bytes > 0 ? static_cast<uint64_t>(p_bytes) : 0;
+    }
+
+    // Items only known after the work (e.g. pairs found)
+    void add_items(int64_t p_items) {
+        items += p_items > 0 ? static_cast<uint64_t>(p_items) : 0;
+    }
+};
+
+// Declares a Probe for the enclosing function and a Scope named profile_scope
+#define AGENTITE_PROFILE(p_name, p_items) \
+    static ::godot::profiling::Probe agentite_probe(p_name); \
+    ::godot::profiling::Scope profile_scope(agentite_probe, static_cast<int64_t>(p_items))
+
+#else
+
+class Scope {
+public:
+    Scope() {}
+    void add_bytes(int64_t) {}
+    void add_items(int64_t) {}
+};
+
+#define AGENTITE_PROFILE(p_name, p_items) ::godot::profiling::Scope profile_scope
+
+#endif
+
+}
+}
+
+#endif // AGENTITE_PROFILING_HPP
@@ -0,0 +1,235 @@
+/**
+ * SIMD Implementation (scalar, SSE2 and NEON levels, CPU detection)
+ */
+
+#include "simd.hpp"
+#include "simd_kernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define AGENTITE_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AGENTITE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace godot {
+namespace simd {
+namespace {
+
+// ========== SSE2 ==========
+
+#ifdef AGENTITE_SIMD_SSE2
+struct Sse2 {
+    using T = __m128;
+    static constexpr int64_t WIDTH = 4;
+
+    static T load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, T v) { _mm_storeu_ps(p, v); }
+    static T set1(float v) { return _mm_set1_ps(v); }
+    static T add(T a, T b) { return _mm_add_ps(a, b); }
+    static T sub(T a, T b) { return _mm_sub_ps(a, b); }
+    static T mul(T a, T b) { return _mm_mul_ps(a, b); }
+    static T div(T a, T b) { return _mm_div_ps(a, b); }
+    static T sqrt(T a) { return _mm_sqrt_ps(a); }
+    static T zero_unless_positive(T c, T v) { return _mm_and_ps(_mm_cmpgt_ps(c, _mm_setzero_ps()), v); }
+    static T min(T a, T b) { return _mm_min_ps(a, b); }
+    static T max(T a, T b) { return _mm_max_ps(a, b); }
+    static T select_lt(T a, T b, T x, T y) {
+        T mask = _mm_cmplt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+    }
+    // Converts with the default round-to-nearest-even mode; |a| < 2^31
+    static T round(T a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+    static T pow2i(T n) {
+        __m128i e = _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+    }
+
+    // No hardware gather; the noise kernels run the scalar version
+    static constexpr bool FAST_GATHER = false;
+
+    static void load2(const float* p, T& x, T& y) {
+        T lo = _mm_loadu_ps(p);      // x0 y0 x1 y1
+        T hi = _mm_loadu_ps(p + 4);  // x2 y2 x3 y3
+        x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    static void store2(float* p, T x, T y) {
+        _mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+    }
+
+    static void load3(const float* p, T& x, T& y, T& z) {
+        T l0 = _mm_loadu_ps(p);      // x0 y0 z0 x1
+        T l1 = _mm_loadu_ps(p + 4);  // y1 z1 x2 y2
+        T l2 = _mm_loadu_ps(p + 8);  // z2 x3 y3 z3
+
+        T t = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(1, 0, 3, 2));  // x2 y2 z2 x3
+        x = _mm_shuffle_ps(l0, t, _MM_SHUFFLE(3, 0, 3, 0));
+
+        T y01 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(0, 0, 1, 1));  // y0 y0 y1 y1
+        T y23 = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(2, 2, 3, 3));  // y2 y2 y3 y3
+        y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+
+        T z01 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(1, 1, 2, 2));  // z0 z0 z1 z1
+        T z23 = _mm_shuffle_ps(l2, l2, _MM_SHUFFLE(3, 3, 0, 0));  // z2 z2 z3 z3
+        z = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+    }
+};
+#endif
+
+// ========== NEON ==========
+
+#ifdef AGENTITE_SIMD_NEON
+struct Neon {
+    using T = float32x4_t;
+    static constexpr int64_t WIDTH = 4;
+
+    static T load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, T v) { vst1q_f32(p, v); }
+    static T set1(float v) { return vdupq_n_f32(v); }
+    static T add(T a, T b) { return vaddq_f32(a, b); }
+    static T sub(T a, T b) { return vsubq_f32(a, b); }
+    static T mul(T a, T b) { return vmulq_f32(a, b); }
+    static T div(T a, T b) { return vdivq_f32(a, b); }
+    static T sqrt(T a) { return vsqrtq_f32(a); }
+    static T zero_unless_positive(T c, T v) {
+        uint32x4_t mask = vcgtq_f32(c, vdupq_n_f32(0.0f));
+        return vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(v)));
+    }
+    // Compare and select rather than vminq / vmaxq, so NaN and signed zero
+    // pick the same operand as the scalar version
+    static T min(T a, T b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+    static T max(T a, T b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+    static T select_lt(T a, T b, T x, T y) { return vbslq_f32(vcltq_f32(a, b), x, y); }
+    static T round(T a) { return vrndnq_f32(a); }
+    static T pow2i(T n) {
+        int32x4_t e = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+        return vreinterpretq_f32_s32(vshlq_n_s32(e, 23));
+    }
+
+    // No hardware gather; the noise kernels run the scalar version
+    static constexpr bool FAST_GATHER = false;
+
+    static void load2(const float* p, T& x, T& y) {
+        float32x4x2_t v = vld2q_f32(p);
+        x = v.val[0];
+        y = v.val[1];
+    }
+
+    static void store2(float* p, T x, T y) {
+        float32x4x2_t v;
+        v.val[0] = x;
+        v.val[1] = y;
+        vst2q_f32(p, v);
+    }
+
+    static void load3(const float* p, T& x, T& y, T& z) {
+        float32x4x3_t v = vld3q_f32(p);
+        x = v.val[0];
+        y = v.val[1];
+        z = v.val[2];
+    }
+};
+#endif
+
+// ========== DETECTION ==========
+
+bool cpu_has_avx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+
+    // The OS must save the YMM registers
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+Level detect_level() {
+    if (cpu_has_avx2() && get_avx2_kernels()) return LEVEL_AVX2;
+    if (get_sse2_kernels()) return LEVEL_SSE2;
+    if (get_neon_kernels()) return LEVEL_NEON;
+    return LEVEL_SCALAR;
+}
+
+}
+
+// ========== TABLES ==========
+
+const Kernels* get_scalar_kernels() {
+    static constexpr Kernels table = make_kernels<Lane>();
+    return &table;
+}
+
+const Kernels* get_sse2_kernels() {
+#ifdef AGENTITE_SIMD_SSE2
+    static constexpr Kernels table = make_kernels<Sse2>();
+    return &table;
+#else
+    return nullptr;
+#endif
+}
+
+const Kernels* get_neon_kernels() {
+#ifdef AGENTITE_SIMD_NEON
+    static constexpr Kernels table = make_kernels<Neon>();
+    return &table;
+#else
+    return nullptr;
+#endif
+}
+
+Level get_level() {
+    static const Level level = detect_level();
+    return level;
+}
+
+const char* get_level_name(Level level) {
+    switch (level) {
+        case LEVEL_SSE2: return "sse2";
+        case LEVEL_AVX2: return "avx2";
+        case LEVEL_NEON: return "neon";
+        default: return "scalar";
+    }
+}
+
+const Kernels& kernels() {
+    static const Kernels* table = kernels_for(get_level());
+    return *table;
+}
+
+const Kernels* kernels_for(Level level) {
+    switch (level) {
+        case LEVEL_SCALAR: return get_scalar_kernels();
+        case LEVEL_SSE2: return get_sse2_kernels();
+        case LEVEL_AVX2: return cpu_has_avx2() ? get_avx2_kernels() : nullptr;
+        case LEVEL_NEON: return get_neon_kernels();
+    }
+    return nullptr;
+}
+
+}
+}
@@ -0,0 +1,107 @@
+/**
+ * SIMD - Runtime-dispatched vector kernels for batch math and noise
+ *
+ * Each kernel exists in a scalar version and in SSE2 (x86_64 baseline),
+ * AVX2 (x86_64, used when the CPU supports it) and NEON (arm64) versions.
+ * The best version for the running CPU is picked once, on first use.
+ *
+ * All versions perform the same IEEE operations in the same order
+ * (no FMA, no approximate reciprocals), so every level returns results
+ * bit-identical to the scalar loop.
+ *
+ * Kernels work on raw float arrays, either as separate x/y(/z) arrays
+ * (SoA) or as interleaved Vector2/Vector3 data (AoS). The AVX2 versions
+ * live in simd_avx2.cpp, which is the only file built with AVX2 enabled.
+ * Nothing here includes godot-cpp, so no engine code is compiled for AVX2.
+ *
+ * Usage (internal):
+ *   const simd::Kernels& k = simd::kernels();
+ *   k.distance_2d_soa(ax, ay, bx, by, out, count);
+ */
+
+#ifndef AGENTITE_SIMD_HPP
+#define AGENTITE_SIMD_HPP
+
+#include <cstdint>
+
+namespace godot {
+namespace simd {
+
+enum Level {
+    LEVEL_SCALAR,
+    LEVEL_SSE2,
+    LEVEL_AVX2,
+    LEVEL_NEON,
+};
+
+// Easing curves for Kernels::ease, in the order of InterpolationOps::EaseType
+enum Ease {
+    EASE_LINEAR,
+    EASE_IN_QUAD, EASE_OUT_QUAD, EASE_IN_OUT_QUAD,
+    EASE_IN_CUBIC, EASE_OUT_CUBIC, EASE_IN_OUT_CUBIC,
+    EASE_IN_QUART, EASE_OUT_QUART, EASE_IN_OUT_QUART,
+    EASE_IN_QUINT, EASE_OUT_QUINT, EASE_IN_OUT_QUINT,
+    EASE_IN_SINE, EASE_OUT_SINE, EASE_IN_OUT_SINE,
+    EASE_IN_EXPO, EASE_OUT_EXPO, EASE_IN_OUT_EXPO,
+    EASE_IN_CIRC, EASE_OUT_CIRC, EASE_IN_OUT_CIRC,
+    EASE_IN_BACK, EASE_OUT_BACK, EASE_IN_OUT_BACK,
+    EASE_IN_ELASTIC, EASE_OUT_ELASTIC, EASE_IN_OUT_ELASTIC,
+    EASE_IN_BOUNCE, EASE_OUT_BOUNCE, EASE_IN_OUT_BOUNCE,
+    EASE_SMOOTHSTEP, EASE_SMOOTHERSTEP,
+    EASE_COUNT,
+};
+
+// 2D affine transform as x' = m[0] * x + m[2] * y + m[4], y' = m[1] * x + m[3] * y + m[5]
+// (the column order of Transform2D)
+struct Kernels {
+    // SoA: separate coordinate arrays
+    void (*length_2d_soa)(const float* x, const float* y, float* out, int64_t count);
+    void (*normalize_2d_soa)(const float* x, const float* y, float* out_x, float* out_y, int64_t count);
+    void (*distance_2d_soa)(const float* ax, const float* ay, const float* bx, const float* by,
+                            float* out, int64_t count);
+    void (*dot_3d_soa)(const float* ax, const float* ay, const float* az,
+                       const float* bx, const float* by, const float* bz, float* out, int64_t count);
+    void (*transform_2d_soa)(const float* m, const float* x, const float* y,
+                             float* out_x, float* out_y, int64_t count);
+
+    // Distances from one point to count points: out[j] = |(bx[j], by[j]) - (px, py)|
+    void (*distance_row_2d)(float px, float py, const float* bx, const float* by, float* out, int64_t count);
+
+    // AoS: interleaved x, y (2D) or x, y, z (3D) floats, count vectors
+    void (*normalize_2d_aos)(const float* v, float* out, int64_t count);
+    void (*distance_2d_aos)(const float* a, const float* b, float* out, int64_t count);
+    void (*dot_3d_aos)(const float* a, const float* b, float* out, int64_t count);
+    void (*transform_2d_aos)(const float* m, const float* v, float* out, int64_t count);
+
+    // Noise along one grid row: out[i] = noise(x[i], y), x and y already scaled by frequency
+    // perm is the 512-entry NoiseOps permutation table widened to int32
+    void (*perlin_2d_row)(const int32_t* perm, const float* x, float y, float* out, int64_t count);
+    void (*simplex_2d_row)(const int32_t* perm, const float* x, float y, float* out, int64_t count);
+    void (*worley_2d_row)(const int32_t* perm, const float* x, float y, float* out, int64_t count);
+
+    // Easing: out[i] = curve(clamp(t[i], 0, 1)) for an Ease type
+    // sin and exp2 are polynomial approximations (max error ~1e-6), so every
+    // level returns the same values
+    void (*ease)(int32_t type, const float* t, float* out, int64_t count);
+};
+
+// Level picked for this CPU
+Level get_level();
+const char* get_level_name(Level level);
+
+// Kernels for this CPU
+const Kernels& kernels();
+
+// Kernels for a specific level, or nullptr if this CPU or build lacks it (for tests)
+const Kernels* kernels_for(Level level);
+
+// Per-level tables (nullptr when the level is not compiled in)
+const Kernels* get_scalar_kernels();
+const Kernels* get_sse2_kernels();
+const Kernels* get_avx2_kernels();
+const Kernels* get_neon_kernels();
+
+}
+}
+
+#endif // AGENTITE_SIMD_HPP
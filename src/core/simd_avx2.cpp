@@ -0,0 +1,132 @@
+/**
+ * SIMD Implementation (AVX2 level)
+ *
+ * The only file built with AVX2 enabled (see SConstruct). Its kernels are
+ * called only after simd.cpp has checked that the CPU supports AVX2.
+ * Builds without AVX2 support compile this file to an empty table.
+ */
+
+#include "simd.hpp"
+
+#ifdef __AVX2__
+#include "simd_kernels.hpp"
+
+#include <immintrin.h>
+#endif
+
+namespace godot {
+namespace simd {
+
+#ifdef __AVX2__
+namespace {
+
+struct Avx2 {
+    using T = __m256;
+    static constexpr int64_t WIDTH = 8;
+
+    static T load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, T v) { _mm256_storeu_ps(p, v); }
+    static T set1(float v) { return _mm256_set1_ps(v); }
+    static T add(T a, T b) { return _mm256_add_ps(a, b); }
+    static T sub(T a, T b) { return _mm256_sub_ps(a, b); }
+    static T mul(T a, T b) { return _mm256_mul_ps(a, b); }
+    static T div(T a, T b) { return _mm256_div_ps(a, b); }
+    static T sqrt(T a) { return _mm256_sqrt_ps(a); }
+
+    static constexpr bool FAST_GATHER = true;
+    static T zero_unless_positive(T c, T v) {
+        return _mm256_and_ps(_mm256_cmp_ps(c, _mm256_setzero_ps(), _CMP_GT_OQ), v);
+    }
+    static T min(T a, T b) { return _mm256_min_ps(a, b); }
+    static T max(T a, T b) { return _mm256_max_ps(a, b); }
+    static T select_lt(T a, T b, T x, T y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    static T round(T a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static T pow2i(T n) {
+        __m256i e = _mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+    }
+
+    static void load2(const float* p, T& x, T& y) {
+        T a = _mm256_loadu_ps(p);      // v0 v1 | v2 v3
+        T b = _mm256_loadu_ps(p + 8);  // v4 v5 | v6 v7
+        T lo = _mm256_permute2f128_ps(a, b, 0x20);  // v0 v1 | v4 v5
+        T hi = _mm256_permute2f128_ps(a, b, 0x31);  // v2 v3 | v6 v7
+        x = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    static void store2(float* p, T x, T y) {
+        T lo = _mm256_unpacklo_ps(x, y);  // v0 v1 | v4 v5
+        T hi = _mm256_unpackhi_ps(x, y);  // v2 v3 | v6 v7
+        _mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+
+    // Two 4-wide transposes (see Sse2::load3 in simd.cpp)
+    static void load3(const float* p, T& x, T& y, T& z) {
+        __m128 x0, y0, z0, x1, y1, z1;
+        load3_half(p, x0, y0, z0);
+        load3_half(p + 12, x1, y1, z1);
+        x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+        y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+        z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+    }
+
+    static void load3_half(const float* p, __m128& x, __m128& y, __m128& z) {
+        __m128 l0 = _mm_loadu_ps(p);
+        __m128 l1 = _mm_loadu_ps(p + 4);
+        __m128 l2 = _mm_loadu_ps(p + 8);
+
+        __m128 t = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(1, 0, 3, 2));
+        x = _mm_shuffle_ps(l0, t, _MM_SHUFFLE(3, 0, 3, 0));
+
+        __m128 y01 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(0, 0, 1, 1));
+        __m128 y23 = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(2, 2, 3, 3));
+        y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+
+        __m128 z01 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(1, 1, 2, 2));
+        __m128 z23 = _mm_shuffle_ps(l2, l2, _MM_SHUFFLE(3, 3, 0, 0));
+        z = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    using I = __m256i;
+    static I set1i(int32_t v) { return _mm256_set1_epi32(v); }
+    static I iadd(I a, I b) { return _mm256_add_epi32(a, b); }
+    static I isub(I a, I b) { return _mm256_sub_epi32(a, b); }
+    static I iand(I a, I b) { return _mm256_and_si256(a, b); }
+    static I ishr(I a, int n) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+    static I floor_int(T x) {
+        I xi = _mm256_cvttps_epi32(x);
+        T below = _mm256_cmp_ps(x, _mm256_cvtepi32_ps(xi), _CMP_LT_OQ);
+        return _mm256_add_epi32(xi, _mm256_castps_si256(below));
+    }
+    static T to_float(I a) { return _mm256_cvtepi32_ps(a); }
+    static I gather(const int32_t* table, I index) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 4);
+    }
+    static T gatherf(const float* table, I index) { return _mm256_i32gather_ps(table, index, 4); }
+    static T lookup8(const float* table, I index) { return _mm256_permutevar8x32_ps(_mm256_loadu_ps(table), index); }
+    static I gt_int(T a, T b) {
+        return _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)), _mm256_set1_epi32(1));
+    }
+    static T zero_unless_non_negative(T c, T v) {
+        return _mm256_and_ps(_mm256_cmp_ps(c, _mm256_setzero_ps(), _CMP_GE_OQ), v);
+    }
+    // vminps returns its second operand unless a < b, matching the scalar compare
+    static T min_lt(T a, T b) { return _mm256_min_ps(a, b); }
+};
+
+}
+#endif
+
+const Kernels* get_avx2_kernels() {
+#ifdef __AVX2__
+    static constexpr Kernels table = make_kernels<Avx2>();
+    return &table;
+#else
+    return nullptr;
+#endif
+}
+
+}
+}
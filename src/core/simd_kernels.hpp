@@ -0,0 +1,680 @@
+/**
+ * SIMD Kernels - Kernel bodies shared by every instruction set
+ *
+ * Each kernel is written once against a small vector interface V:
+ *   T, WIDTH, load, store, set1, add, sub, mul, div, sqrt,
+ *   zero_unless_positive(c, v) (v where c > 0, else 0),
+ *   min(a, b) (a < b ? a : b), max(a, b) (a > b ? a : b),
+ *   select_lt(a, b, x, y) (a < b ? x : y),
+ *   round (to nearest, ties to even), pow2i(n) (2^n for integer-valued n),
+ *   load2 / store2 (deinterleave / interleave WIDTH Vector2s),
+ *   load3 (deinterleave WIDTH Vector3s),
+ *   FAST_GATHER (true if the level has hardware gathers)
+ * and instantiated by simd.cpp (scalar, SSE2, NEON) and simd_avx2.cpp (AVX2).
+ * The leftover elements after the last full vector run through Lane, the
+ * one-element scalar version, so every level applies the same formula.
+ *
+ * The noise kernels are mostly table lookups, so only levels with
+ * FAST_GATHER run them vectorized. Those levels also provide a 32-bit
+ * integer vector I:
+ *   set1i, iadd, isub, iand, ishr, floor_int, to_float,
+ *   gather / gatherf (table lookups), lookup8 (8-entry table lookup),
+ *   gt_int (1 where a > b, else 0), zero_unless_non_negative(c, v),
+ *   min_lt(a, b) (a < b ? a : b)
+ *
+ * Internal to those two files. Everything is in an anonymous namespace so
+ * each file keeps its own copy, compiled with its own instruction set.
+ */
+
+#ifndef AGENTITE_SIMD_KERNELS_HPP
+#define AGENTITE_SIMD_KERNELS_HPP
+
+#include "simd.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace godot {
+namespace simd {
+namespace {
+
+// One element at a time (the scalar level, and the tail of every other level)
+struct Lane {
+    using T = float;
+    static constexpr int64_t WIDTH = 1;
+
+    static T load(const float* p) { return *p; }
+    static void store(float* p, T v) { *p = v; }
+    static T set1(float v) { return v; }
+    static T add(T a, T b) { return a + b; }
+    static T sub(T a, T b) { return a - b; }
+    static T mul(T a, T b) { return a * b; }
+    static T div(T a, T b) { return a / b; }
+    static T sqrt(T a) { return std::sqrt(a); }
+    static T zero_unless_positive(T c, T v) { return c > 0.0f ? v : 0.0f; }
+    static T min(T a, T b) { return a < b ? a : b; }
+    static T max(T a, T b) { return a > b ? a : b; }
+    static T select_lt(T a, T b, T x, T y) { return a < b ? x : y; }
+    static T round(T a) { return std::nearbyint(a); }
+    static T pow2i(T n) {
+        uint32_t bits = static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    static void load2(const float* p, T& x, T& y) { x = p[0]; y = p[1]; }
+    static void store2(float* p, T x, T y) { p[0] = x; p[1] = y; }
+    static void load3(const float* p, T& x, T& y, T& z) { x = p[0]; y = p[1]; z = p[2]; }
+
+    using I = int32_t;
+    static I set1i(int32_t v) { return v; }
+    static I iadd(I a, I b) { return a + b; }
+    static I isub(I a, I b) { return a - b; }
+    static I iand(I a, I b) { return a & b; }
+    static I ishr(I a, int n) { return a >> n; }
+    static I floor_int(T x) {
+        int32_t xi = static_cast<int32_t>(x);
+        return x < xi ? xi - 1 : xi;
+    }
+    static T to_float(I a) { return static_cast<float>(a); }
+    static I gather(const int32_t* table, I index) { return table[index]; }
+    static T gatherf(const float* table, I index) { return table[index]; }
+    static T lookup8(const float* table, I index) { return table[index]; }
+    static constexpr bool FAST_GATHER = true;
+    static I gt_int(T a, T b) { return a > b ? 1 : 0; }
+    static T zero_unless_non_negative(T c, T v) { return c >= 0.0f ? v : 0.0f; }
+    static T min_lt(T a, T b) { return a < b ? a : b; }
+};
+
+// ========== SOA KERNELS ==========
+
+template <class V>
+void length_2d_soa(const float* x, const float* y, float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T vx = V::load(x + i);
+        typename V::T vy = V::load(y + i);
+        V::store(out + i, V::sqrt(V::add(V::mul(vx, vx), V::mul(vy, vy))));
+    }
+    if constexpr (V::WIDTH > 1) {
+        length_2d_soa<Lane>(x + i, y + i, out + i, count - i);
+    }
+}
+
+template <class V>
+void normalize_2d_soa(const float* x, const float* y, float* out_x, float* out_y, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T vx = V::load(x + i);
+        typename V::T vy = V::load(y + i);
+        typename V::T len_sq = V::add(V::mul(vx, vx), V::mul(vy, vy));
+        typename V::T inv_len = V::div(V::set1(1.0f), V::sqrt(len_sq));
+        V::store(out_x + i, V::zero_unless_positive(len_sq, V::mul(vx, inv_len)));
+        V::store(out_y + i, V::zero_unless_positive(len_sq, V::mul(vy, inv_len)));
+    }
+    if constexpr (V::WIDTH > 1) {
+        normalize_2d_soa<Lane>(x + i, y + i, out_x + i, out_y + i, count - i);
+    }
+}
+
+template <class V>
+void distance_2d_soa(const float* ax, const float* ay, const float* bx, const float* by,
+                     float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T dx = V::sub(V::load(bx + i), V::load(ax + i));
+        typename V::T dy = V::sub(V::load(by + i), V::load(ay + i));
+        V::store(out + i, V::sqrt(V::add(V::mul(dx, dx), V::mul(dy, dy))));
+    }
+    if constexpr (V::WIDTH > 1) {
+        distance_2d_soa<Lane>(ax + i, ay + i, bx + i, by + i, out + i, count - i);
+    }
+}
+
+template <class V>
+void dot_3d_soa(const float* ax, const float* ay, const float* az,
+                const float* bx, const float* by, const float* bz, float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T d = V::add(V::add(V::mul(V::load(ax + i), V::load(bx + i)),
+                                        V::mul(V::load(ay + i), V::load(by + i))),
+                                 V::mul(V::load(az + i), V::load(bz + i)));
+        V::store(out + i, d);
+    }
+    if constexpr (V::WIDTH > 1) {
+        dot_3d_soa<Lane>(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+    }
+}
+
+template <class V>
+void transform_2d_soa(const float* m, const float* x, const float* y,
+                      float* out_x, float* out_y, int64_t count) {
+    typename V::T m0 = V::set1(m[0]), m1 = V::set1(m[1]), m2 = V::set1(m[2]);
+    typename V::T m3 = V::set1(m[3]), m4 = V::set1(m[4]), m5 = V::set1(m[5]);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T vx = V::load(x + i);
+        typename V::T vy = V::load(y + i);
+        V::store(out_x + i, V::add(V::add(V::mul(m0, vx), V::mul(m2, vy)), m4));
+        V::store(out_y + i, V::add(V::add(V::mul(m1, vx), V::mul(m3, vy)), m5));
+    }
+    if constexpr (V::WIDTH > 1) {
+        transform_2d_soa<Lane>(m, x + i, y + i, out_x + i, out_y + i, count - i);
+    }
+}
+
+template <class V>
+void distance_row_2d(float px, float py, const float* bx, const float* by, float* out, int64_t count) {
+    typename V::T vpx = V::set1(px);
+    typename V::T vpy = V::set1(py);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T dx = V::sub(V::load(bx + i), vpx);
+        typename V::T dy = V::sub(V::load(by + i), vpy);
+        V::store(out + i, V::sqrt(V::add(V::mul(dx, dx), V::mul(dy, dy))));
+    }
+    if constexpr (V::WIDTH > 1) {
+        distance_row_2d<Lane>(px, py, bx + i, by + i, out + i, count - i);
+    }
+}
+
+// ========== AOS KERNELS ==========
+
+template <class V>
+void normalize_2d_aos(const float* v, float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T vx, vy;
+        V::load2(v + i * 2, vx, vy);
+        typename V::T len_sq = V::add(V::mul(vx, vx), V::mul(vy, vy));
+        typename V::T inv_len = V::div(V::set1(1.0f), V::sqrt(len_sq));
+        V::store2(out + i * 2,
+                  V::zero_unless_positive(len_sq, V::mul(vx, inv_len)),
+                  V::zero_unless_positive(len_sq, V::mul(vy, inv_len)));
+    }
+    if constexpr (V::WIDTH > 1) {
+        normalize_2d_aos<Lane>(v + i * 2, out + i * 2, count - i);
+    }
+}
+
+template <class V>
+void distance_2d_aos(const float* a, const float* b, float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T ax, ay, bx, by;
+        V::load2(a + i * 2, ax, ay);
+        V::load2(b + i * 2, bx, by);
+        typename V::T dx = V::sub(bx, ax);
+        typename V::T dy = V::sub(by, ay);
+        V::store(out + i, V::sqrt(V::add(V::mul(dx, dx), V::mul(dy, dy))));
+    }
+    if constexpr (V::WIDTH > 1) {
+        distance_2d_aos<Lane>(a + i * 2, b + i * 2, out + i, count - i);
+    }
+}
+
+template <class V>
+void dot_3d_aos(const float* a, const float* b, float* out, int64_t count) {
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T ax, ay, az, bx, by, bz;
+        V::load3(a + i * 3, ax, ay, az);
+        V::load3(b + i * 3, bx, by, bz);
+        V::store(out + i, V::add(V::add(V::mul(ax, bx), V::mul(ay, by)), V::mul(az, bz)));
+    }
+    if constexpr (V::WIDTH > 1) {
+        dot_3d_aos<Lane>(a + i * 3, b + i * 3, out + i, count - i);
+    }
+}
+
+template <class V>
+void transform_2d_aos(const float* m, const float* v, float* out, int64_t count) {
+    typename V::T m0 = V::set1(m[0]), m1 = V::set1(m[1]), m2 = V::set1(m[2]);
+    typename V::T m3 = V::set1(m[3]), m4 = V::set1(m[4]), m5 = V::set1(m[5]);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T vx, vy;
+        V::load2(v + i * 2, vx, vy);
+        V::store2(out + i * 2,
+                  V::add(V::add(V::mul(m0, vx), V::mul(m2, vy)), m4),
+                  V::add(V::add(V::mul(m1, vx), V::mul(m3, vy)), m5));
+    }
+    if constexpr (V::WIDTH > 1) {
+        transform_2d_aos<Lane>(m, v + i * 2, out + i * 2, count - i);
+    }
+}
+
+// ========== NOISE KERNELS ==========
+// Same arithmetic, in the same order, as the scalar functions in NoiseOps
+
+// 2D gradient vectors of NoiseOps, split by component
+static const float NOISE_GRAD2_X[8] = {1, 0, -1, 0, 1, -1, 1, -1};
+static const float NOISE_GRAD2_Y[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+
+// Simplex skew factors (as in NoiseOps)
+static const float NOISE_F2 = 0.3660254037844386f;
+static const float NOISE_G2 = 0.21132486540518713f;
+
+template <class V>
+typename V::T noise_fade(typename V::T t) {
+    // t * t * t * (t * (t * 6 - 15) + 10)
+    typename V::T inner = V::add(V::mul(t, V::sub(V::mul(t, V::set1(6.0f)), V::set1(15.0f))), V::set1(10.0f));
+    return V::mul(V::mul(V::mul(t, t), t), inner);
+}
+
+template <class V>
+typename V::T noise_lerp(typename V::T a, typename V::T b, typename V::T t) {
+    return V::add(a, V::mul(t, V::sub(b, a)));
+}
+
+template <class V>
+typename V::T noise_grad2(typename V::I hash, typename V::T x, typename V::T y) {
+    typename V::I h = V::iand(hash, V::set1i(7));
+    return V::add(V::mul(V::lookup8(NOISE_GRAD2_X, h), x), V::mul(V::lookup8(NOISE_GRAD2_Y, h), y));
+}
+
+template <class V>
+void perlin_2d_row(const int32_t* perm, const float* x, float y, float* out, int64_t count) {
+    using T = typename V::T;
+    using I = typename V::I;
+
+    // The row's y terms are shared by every sample
+    T py = V::set1(y);
+    I fy_int = V::floor_int(py);
+    I Y = V::iand(fy_int, V::set1i(255));
+    T fy = V::sub(py, V::to_float(fy_int));
+    T fy1 = V::sub(fy, V::set1(1.0f));
+    T v = noise_fade<V>(fy);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        T px = V::load(x + i);
+        I fx_int = V::floor_int(px);
+        I X = V::iand(fx_int, V::set1i(255));
+        T fx = V::sub(px, V::to_float(fx_int));
+        T fx1 = V::sub(fx, V::set1(1.0f));
+        T u = noise_fade<V>(fx);
+
+        I A = V::iadd(V::gather(perm, X), Y);
+        I B = V::iadd(V::gather(perm, V::iadd(X, V::set1i(1))), Y);
+        I A1 = V::iadd(A, V::set1i(1));
+        I B1 = V::iadd(B, V::set1i(1));
+
+        T lower = noise_lerp<V>(noise_grad2<V>(V::gather(perm, A), fx, fy), noise_grad2<V>(V::gather(perm, B), fx1, fy), u);
+        T upper = noise_lerp<V>(noise_grad2<V>(V::gather(perm, A1), fx, fy1), noise_grad2<V>(V::gather(perm, B1), fx1, fy1), u);
+        V::store(out + i, noise_lerp<V>(lower, upper, v));
+    }
+    if constexpr (V::WIDTH > 1) {
+        perlin_2d_row<Lane>(perm, x + i, y, out + i, count - i);
+    }
+}
+
+template <class V>
+void simplex_2d_row(const int32_t* perm, const float* x, float y, float* out, int64_t count) {
+    using T = typename V::T;
+    using I = typename V::I;
+
+    T py = V::set1(y);
+    T g2 = V::set1(NOISE_G2);
+    T g2_2 = V::set1(2.0f * NOISE_G2);
+    T half = V::set1(0.5f);
+    T one = V::set1(1.0f);
+    I one_i = V::set1i(1);
+    I mask_255 = V::set1i(255);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        T px = V::load(x + i);
+        T s = V::mul(V::add(px, py), V::set1(NOISE_F2));
+        I ci = V::floor_int(V::add(px, s));
+        I cj = V::floor_int(V::add(py, s));
+
+        T t = V::mul(V::to_float(V::iadd(ci, cj)), g2);
+        T x0 = V::sub(px, V::sub(V::to_float(ci), t));
+        T y0 = V::sub(py, V::sub(V::to_float(cj), t));
+
+        I i1 = V::gt_int(x0, y0);
+        I j1 = V::isub(one_i, i1);
+
+        T x1 = V::add(V::sub(x0, V::to_float(i1)), g2);
+        T y1 = V::add(V::sub(y0, V::to_float(j1)), g2);
+        T x2 = V::add(V::sub(x0, one), g2_2);
+        T y2 = V::add(V::sub(y0, one), g2_2);
+
+        I ii = V::iand(ci, mask_255);
+        I jj = V::iand(cj, mask_255);
+
+        I h0 = V::gather(perm, V::iadd(ii, V::gather(perm, jj)));
+        I h1 = V::gather(perm, V::iadd(V::iadd(ii, i1), V::gather(perm, V::iadd(jj, j1))));
+        I h2 = V::gather(perm, V::iadd(V::iadd(ii, one_i), V::gather(perm, V::iadd(jj, one_i))));
+
+        T t0 = V::sub(V::sub(half, V::mul(x0, x0)), V::mul(y0, y0));
+        T t1 = V::sub(V::sub(half, V::mul(x1, x1)), V::mul(y1, y1));
+        T t2 = V::sub(V::sub(half, V::mul(x2, x2)), V::mul(y2, y2));
+        T q0 = V::mul(t0, t0);
+        T q1 = V::mul(t1, t1);
+        T q2 = V::mul(t2, t2);
+
+        T n0 = V::zero_unless_non_negative(t0, V::mul(V::mul(q0, q0), noise_grad2<V>(h0, x0, y0)));
+        T n1 = V::zero_unless_non_negative(t1, V::mul(V::mul(q1, q1), noise_grad2<V>(h1, x1, y1)));
+        T n2 = V::zero_unless_non_negative(t2, V::mul(V::mul(q2, q2), noise_grad2<V>(h2, x2, y2)));
+
+        V::store(out + i, V::mul(V::set1(70.0f), V::add(V::add(n0, n1), n2)));
+    }
+    if constexpr (V::WIDTH > 1) {
+        simplex_2d_row<Lane>(perm, x + i, y, out + i, count - i);
+    }
+}
+
+template <class V>
+void worley_2d_row(const int32_t* perm, const float* x, float y, float* out, int64_t count) {
+    using T = typename V::T;
+    using I = typename V::I;
+
+    T py = V::set1(y);
+    I yi = V::floor_int(py);
+    I mask_15 = V::set1i(15);
+    I mask_255 = V::set1i(255);
+    T fifteen = V::set1(15.0f);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        T px = V::load(x + i);
+        I xi = V::floor_int(px);
+        T min_dist = V::set1(999999.0f);
+
+        // 3x3 neighborhood, in the scalar order
+        for (int dy = -1; dy <= 1; dy++) {
+            I cy = V::iadd(yi, V::set1i(dy));
+            for (int dx = -1; dx <= 1; dx++) {
+                I cx = V::iadd(xi, V::set1i(dx));
+
+                I h = V::gather(perm, V::iand(V::iadd(V::gather(perm, V::iand(cx, mask_255)), V::iand(cy, mask_255)), mask_255));
+
+                T fx = V::add(V::to_float(cx), V::div(V::to_float(V::iand(h, mask_15)), fifteen));
+                T fy = V::add(V::to_float(cy), V::div(V::to_float(V::iand(V::ishr(h, 4), mask_15)), fifteen));
+
+                T dist_x = V::sub(px, fx);
+                T dist_y = V::sub(py, fy);
+                T dist = V::add(V::mul(dist_x, dist_x), V::mul(dist_y, dist_y));
+                min_dist = V::min_lt(dist, min_dist);
+            }
+        }
+
+        V::store(out + i, V::sqrt(min_dist));
+    }
+    if constexpr (V::WIDTH > 1) {
+        worley_2d_row<Lane>(perm, x + i, y, out + i, count - i);
+    }
+}
+
+// ========== EASING KERNELS ==========
+// Same curves as the InterpolationOps ease_* functions. sin and exp2 are
+// polynomials built from the basic ops, so every level matches Lane.
+
+static const float EASE_PI = 3.14159265358979323846f;
+// pi split in two for range reduction: PI_A has few mantissa bits, so k * PI_A is exact
+static const float EASE_PI_A = 3.140625f;
+static const float EASE_PI_B = 9.67653589793e-4f;
+static const float EASE_BACK_C1 = 1.70158f;
+static const float EASE_BACK_C2 = EASE_BACK_C1 * 1.525f;
+static const float EASE_BACK_C3 = EASE_BACK_C1 + 1.0f;
+
+// sin(x) for |x| up to a few hundred
+template <class V>
+typename V::T ease_sin(typename V::T x) {
+    using T = typename V::T;
+    // x = k * pi + r, |r| <= pi / 2, sin(x) = (-1)^k sin(r)
+    T k = V::round(V::mul(x, V::set1(1.0f / EASE_PI)));
+    T r = V::sub(V::sub(x, V::mul(k, V::set1(EASE_PI_A))), V::mul(k, V::set1(EASE_PI_B)));
+    // k / 2 - round(k / 2) is 0 for even k and +-0.5 for odd k
+    T half_k = V::mul(k, V::set1(0.5f));
+    T odd = V::sub(half_k, V::round(half_k));
+    T sign = V::sub(V::set1(1.0f), V::mul(V::set1(8.0f), V::mul(odd, odd)));
+
+    // Taylor series to r^11 (error < 6e-8 on [-pi/2, pi/2])
+    T r2 = V::mul(r, r);
+    T p = V::set1(-2.5052108e-8f);
+    p = V::add(V::mul(p, r2), V::set1(2.7557319e-6f));
+    p = V::add(V::mul(p, r2), V::set1(-1.9841270e-4f));
+    p = V::add(V::mul(p, r2), V::set1(8.3333333e-3f));
+    p = V::add(V::mul(p, r2), V::set1(-1.6666667e-1f));
+    p = V::add(V::mul(p, r2), V::set1(1.0f));
+    return V::mul(V::mul(r, p), sign);
+}
+
+// 2^x for x in [-126, 127]
+template <class V>
+typename V::T ease_exp2(typename V::T x) {
+    using T = typename V::T;
+    T n = V::round(x);
+    // 2^f = e^(f ln 2), |f ln 2| <= 0.347, Taylor series to degree 7
+    T f = V::mul(V::sub(x, n), V::set1(0.69314718f));
+    T p = V::set1(1.9841270e-4f);
+    p = V::add(V::mul(p, f), V::set1(1.3888889e-3f));
+    p = V::add(V::mul(p, f), V::set1(8.3333333e-3f));
+    p = V::add(V::mul(p, f), V::set1(4.1666667e-2f));
+    p = V::add(V::mul(p, f), V::set1(1.6666667e-1f));
+    p = V::add(V::mul(p, f), V::set1(0.5f));
+    p = V::add(V::mul(p, f), V::set1(1.0f));
+    p = V::add(V::mul(p, f), V::set1(1.0f));
+    return V::mul(p, V::pow2i(n));
+}
+
+template <class V>
+typename V::T ease_bounce_out(typename V::T x) {
+    using T = typename V::T;
+    const float d1 = 2.75f;
+    T n1 = V::set1(7.5625f);
+    T x0 = x;
+    T x1 = V::sub(x, V::set1(1.5f / d1));
+    T x2 = V::sub(x, V::set1(2.25f / d1));
+    T x3 = V::sub(x, V::set1(2.625f / d1));
+    T b0 = V::mul(V::mul(n1, x0), x0);
+    T b1 = V::add(V::mul(V::mul(n1, x1), x1), V::set1(0.75f));
+    T b2 = V::add(V::mul(V::mul(n1, x2), x2), V::set1(0.9375f));
+    T b3 = V::add(V::mul(V::mul(n1, x3), x3), V::set1(0.984375f));
+    T result = V::select_lt(x, V::set1(2.5f / d1), b2, b3);
+    result = V::select_lt(x, V::set1(2.0f / d1), b1, result);
+    return V::select_lt(x, V::set1(1.0f / d1), b0, result);
+}
+
+// x^n for small n
+template <class V, int N>
+typename V::T ease_pow(typename V::T x) {
+    typename V::T result = x;
+    for (int i = 1; i < N; i++) {
+        result = V::mul(result, x);
+    }
+    return result;
+}
+
+// Polynomial in / out / in-out for x^N
+template <class V, int N>
+typename V::T ease_poly(int mode, typename V::T x) {
+    using T = typename V::T;
+    T one = V::set1(1.0f);
+    if (mode == 0) {
+        return ease_pow<V, N>(x);
+    }
+    if (mode == 1) {
+        return V::sub(one, ease_pow<V, N>(V::sub(one, x)));
+    }
+    // 2^(N-1) x^N below 0.5, 1 - (2 - 2x)^N / 2 above
+    T low = V::mul(V::set1(static_cast<float>(1 << (N - 1))), ease_pow<V, N>(x));
+    T f = V::add(V::mul(V::set1(-2.0f), x), V::set1(2.0f));
+    T high = V::sub(one, V::div(ease_pow<V, N>(f), V::set1(2.0f)));
+    return V::select_lt(x, V::set1(0.5f), low, high);
+}
+
+template <class V, int TYPE>
+typename V::T ease_value(typename V::T x) {
+    using T = typename V::T;
+    T zero = V::set1(0.0f);
+    T one = V::set1(1.0f);
+    T half = V::set1(0.5f);
+    T two = V::set1(2.0f);
+
+    if constexpr (TYPE == EASE_LINEAR) {
+        return x;
+    } else if constexpr (TYPE >= EASE_IN_QUAD && TYPE <= EASE_IN_OUT_QUINT) {
+        constexpr int N = 2 + (TYPE - EASE_IN_QUAD) / 3;
+        return ease_poly<V, N>((TYPE - EASE_IN_QUAD) % 3, x);
+    } else if constexpr (TYPE == EASE_IN_SINE) {
+        // 1 - cos(a) = 2 sin^2(a / 2), exact at 0
+        T s = ease_sin<V>(V::mul(x, V::set1(0.25f * EASE_PI)));
+        return V::mul(two, V::mul(s, s));
+    } else if constexpr (TYPE == EASE_OUT_SINE) {
+        return ease_sin<V>(V::mul(x, V::set1(0.5f * EASE_PI)));
+    } else if constexpr (TYPE == EASE_IN_OUT_SINE) {
+        T s = ease_sin<V>(V::mul(x, V::set1(0.5f * EASE_PI)));
+        return V::mul(s, s);
+    } else if constexpr (TYPE == EASE_IN_EXPO) {
+        T value = ease_exp2<V>(V::sub(V::mul(V::set1(10.0f), x), V::set1(10.0f)));
+        return V::select_lt(zero, x, value, zero);
+    } else if constexpr (TYPE == EASE_OUT_EXPO) {
+        T value = V::sub(one, ease_exp2<V>(V::mul(V::set1(-10.0f), x)));
+        return V::select_lt(x, one, value, one);
+    } else if constexpr (TYPE == EASE_IN_OUT_EXPO) {
+        T low = V::div(ease_exp2<V>(V::sub(V::mul(V::set1(20.0f), x), V::set1(10.0f))), two);
+        T high = V::div(V::sub(two, ease_exp2<V>(V::add(V::mul(V::set1(-20.0f), x), V::set1(10.0f)))), two);
+        T value = V::select_lt(x, half, low, high);
+        return V::select_lt(zero, x, V::select_lt(x, one, value, one), zero);
+    } else if constexpr (TYPE == EASE_IN_CIRC) {
+        return V::sub(one, V::sqrt(V::sub(one, V::mul(x, x))));
+    } else if constexpr (TYPE == EASE_OUT_CIRC) {
+        T f = V::sub(x, one);
+        return V::sqrt(V::sub(one, V::mul(f, f)));
+    } else if constexpr (TYPE == EASE_IN_OUT_CIRC) {
+        // Each side clamps its sqrt argument, as the other side's is negative
+        T low = V::div(V::sub(one, V::sqrt(V::max(zero, V::sub(one, V::mul(V::set1(4.0f), V::mul(x, x)))))), two);
+        T f = V::add(V::mul(V::set1(-2.0f), x), two);
+        T high = V::div(V::add(V::sqrt(V::max(zero, V::sub(one, V::mul(f, f)))), one), two);
+        return V::select_lt(x, half, low, high);
+    } else if constexpr (TYPE == EASE_IN_BACK) {
+        T x2 = V::mul(x, x);
+        return V::sub(V::mul(V::mul(V::set1(EASE_BACK_C3), x2), x), V::mul(V::set1(EASE_BACK_C1), x2));
+    } else if constexpr (TYPE == EASE_OUT_BACK) {
+        T f = V::sub(x, one);
+        T f2 = V::mul(f, f);
+        return V::add(V::add(one, V::mul(V::mul(V::set1(EASE_BACK_C3), f2), f)), V::mul(V::set1(EASE_BACK_C1), f2));
+    } else if constexpr (TYPE == EASE_IN_OUT_BACK) {
+        T c2 = V::set1(EASE_BACK_C2);
+        T c2_1 = V::set1(EASE_BACK_C2 + 1.0f);
+        T f = V::mul(two, x);
+        T low = V::div(V::mul(V::mul(f, f), V::sub(V::mul(c2_1, f), c2)), two);
+        T g = V::sub(V::mul(two, x), two);
+        T high = V::div(V::add(V::mul(V::mul(g, g), V::add(V::mul(c2_1, g), c2)), two), two);
+        return V::select_lt(x, half, low, high);
+    } else if constexpr (TYPE == EASE_IN_ELASTIC) {
+        T c4 = V::set1((2.0f * EASE_PI) / 3.0f);
+        T wave = ease_sin<V>(V::mul(V::sub(V::mul(x, V::set1(10.0f)), V::set1(10.75f)), c4));
+        T value = V::sub(zero, V::mul(ease_exp2<V>(V::sub(V::mul(V::set1(10.0f), x), V::set1(10.0f))), wave));
+        return V::select_lt(zero, x, V::select_lt(x, one, value, one), zero);
+    } else if constexpr (TYPE == EASE_OUT_ELASTIC) {
+        T c4 = V::set1((2.0f * EASE_PI) / 3.0f);
+        T wave = ease_sin<V>(V::mul(V::sub(V::mul(x, V::set1(10.0f)), V::set1(0.75f)), c4));
+        T value = V::add(V::mul(ease_exp2<V>(V::mul(V::set1(-10.0f), x)), wave), one);
+        return V::select_lt(zero, x, V::select_lt(x, one, value, one), zero);
+    } else if constexpr (TYPE == EASE_IN_OUT_ELASTIC) {
+        T c5 = V::set1((2.0f * EASE_PI) / 4.5f);
+        T wave = ease_sin<V>(V::mul(V::sub(V::mul(V::set1(20.0f), x), V::set1(11.125f)), c5));
+        T low = V::div(V::sub(zero, V::mul(ease_exp2<V>(V::sub(V::mul(V::set1(20.0f), x), V::set1(10.0f))), wave)), two);
+        T high = V::add(V::div(V::mul(ease_exp2<V>(V::add(V::mul(V::set1(-20.0f), x), V::set1(10.0f))), wave), two), one);
+        T value = V::select_lt(x, half, low, high);
+        return V::select_lt(zero, x, V::select_lt(x, one, value, one), zero);
+    } else if constexpr (TYPE == EASE_IN_BOUNCE) {
+        return V::sub(one, ease_bounce_out<V>(V::sub(one, x)));
+    } else if constexpr (TYPE == EASE_OUT_BOUNCE) {
+        return ease_bounce_out<V>(x);
+    } else if constexpr (TYPE == EASE_IN_OUT_BOUNCE) {
+        T low = V::div(V::sub(one, ease_bounce_out<V>(V::sub(one, V::mul(two, x)))), two);
+        T high = V::div(V::add(one, ease_bounce_out<V>(V::sub(V::mul(two, x), one))), two);
+        return V::select_lt(x, half, low, high);
+    } else if constexpr (TYPE == EASE_SMOOTHSTEP) {
+        return V::mul(V::mul(x, x), V::sub(V::set1(3.0f), V::mul(two, x)));
+    } else {
+        // Smootherstep
+        T inner = V::add(V::mul(x, V::sub(V::mul(x, V::set1(6.0f)), V::set1(15.0f))), V::set1(10.0f));
+        return V::mul(V::mul(V::mul(x, x), x), inner);
+    }
+}
+
+template <class V, int TYPE>
+void ease_loop(const float* t, float* out, int64_t count) {
+    typename V::T zero = V::set1(0.0f);
+    typename V::T one = V::set1(1.0f);
+
+    int64_t i = 0;
+    for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        typename V::T x = V::min(V::max(V::load(t + i), zero), one);
+        V::store(out + i, ease_value<V, TYPE>(x));
+    }
+    if constexpr (V::WIDTH > 1) {
+        ease_loop<Lane, TYPE>(t + i, out + i, count - i);
+    }
+}
+
+// One instantiation per type, indexed by type
+template <class V, int... TYPES>
+constexpr void fill_ease_table(void (*table[])(const float*, float*, int64_t), std::integer_sequence<int, TYPES...>) {
+    ((table[TYPES] = &ease_loop<V, TYPES>), ...);
+}
+
+template <class V>
+void ease(int32_t type, const float* t, float* out, int64_t count) {
+    using Loop = void (*)(const float*, float*, int64_t);
+    struct Table {
+        Loop loops[EASE_COUNT] = {};
+        constexpr Table() {
+            fill_ease_table<V>(loops, std::make_integer_sequence<int, EASE_COUNT>());
+        }
+    };
+    static constexpr Table table;
+    if (type < 0 || type >= EASE_COUNT) {
+        return;
+    }
+    table.loops[type](t, out, count);
+}
+
+// ========== TABLE ==========
+
+// constexpr so each table is constant-initialized: no code runs to build it,
+// and the AVX2 table can be referenced on CPUs without AVX2
+template <class V>
+constexpr Kernels make_kernels() {
+    Kernels k{};
+    k.length_2d_soa = &length_2d_soa<V>;
+    k.normalize_2d_soa = &normalize_2d_soa<V>;
+    k.distance_2d_soa = &distance_2d_soa<V>;
+    k.dot_3d_soa = &dot_3d_soa<V>;
+    k.transform_2d_soa = &transform_2d_soa<V>;
+    k.distance_row_2d = &distance_row_2d<V>;
+    k.normalize_2d_aos = &normalize_2d_aos<V>;
+    k.distance_2d_aos = &distance_2d_aos<V>;
+    k.dot_3d_aos = &dot_3d_aos<V>;
+    k.transform_2d_aos = &transform_2d_aos<V>;
+    if constexpr (V::FAST_GATHER) {
+        k.perlin_2d_row = &perlin_2d_row<V>;
+        k.simplex_2d_row = &simplex_2d_row<V>;
+        k.worley_2d_row = &worley_2d_row<V>;
+    } else {
+        k.perlin_2d_row = &perlin_2d_row<Lane>;
+        k.simplex_2d_row = &simplex_2d_row<Lane>;
+        k.worley_2d_row = &worley_2d_row<Lane>;
+    }
+    k.ease = &ease<V>;
+    return k;
+}
+
+}
+}
+}
+
+#endif // AGENTITE_SIMD_KERNELS_HPP
@@ -0,0 +1,156 @@
+/**
+ * Snapshot Implementation
+ */
+
+#include "snapshot.hpp"
+
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot {
+namespace snapshot {
+
+static uint64_t align_up(uint64_t value) {
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void Writer::add_raw(uint32_t tag, uint32_t element_size, uint64_t count, const void* data) {
+    Pending p;
+    p.tag = tag;
+    p.element_size = element_size;
+    p.count = count;
+    p.data = data;
+    sections.push_back(p);
+}
+
+const void* Writer::keep(const void* data, size_t bytes) {
+    owned.emplace_back(bytes);
+    if (bytes > 0) {
+        std::memcpy(owned.back().data(), data, bytes);
+    }
+    return owned.back().data();
+}
+
+PackedByteArray Writer::finish() const {
+    uint64_t table_end = sizeof(Header) + sections.size() * sizeof(Section);
+    std::vector<Section> table(sections.size());
+    uint64_t offset = align_up(table_end);
+    for (size_t i = 0; i < sections.size(); i++) {
+        table[i].tag = sections[i].tag;
+        table[i].element_size = sections[i].element_size;
+        table[i].offset = offset;
+        table[i].count = sections[i].count;
+        offset = align_up(offset + sections[i].count * sections[i].element_size);
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.format_version = FORMAT_VERSION;
+    header.kind = kind;
+    header.kind_version = kind_version;
+    header.section_count = static_cast<uint32_t>(sections.size());
+    header.total_size = offset;
+    header.reserved = 0;
+
+    PackedByteArray result;
+    result.resize(static_cast<int64_t>(offset));
+    uint8_t* out = result.ptrw();
+    std::memset(out, 0, static_cast<size_t>(offset));
+    std::memcpy(out, &header, sizeof(Header));
+    if (!table.empty()) {
+        std::memcpy(out + sizeof(Header), table.data(), table.size() * sizeof(Section));
+    }
+    for (size_t i = 0; i < sections.size(); i++) {
+        uint64_t bytes = sections[i].count * sections[i].element_size;
+        if (bytes > 0) {
+            std::memcpy(out + table[i].offset, sections[i].data, static_cast<size_t>(bytes));
+        }
+    }
+    return result;
+}
+
+bool Reader::fail(const char* message) const {
+    UtilityFunctions::push_error(String("AgentiteG: ") + class_name + ".load_snapshot: " + message);
+    return false;
+}
+
+bool Reader::open(const PackedByteArray& data, Kind kind, uint32_t kind_version, const char* p_class_name) {
+    class_name = p_class_name;
+    bytes = data;
+    base = nullptr;
+    table = nullptr;
+    section_count = 0;
+
+    uint64_t size = static_cast<uint64_t>(bytes.size());
+    if (size < sizeof(Header)) {
+        return fail("data is too short to be a snapshot");
+    }
+    const uint8_t* ptr = bytes.ptr();
+
+    Header header;
+    std::memcpy(&header, ptr, sizeof(Header));
+    if (header.magic != MAGIC) {
+        return fail("data is not an AgentiteG snapshot");
+    }
+    if (header.format_version != FORMAT_VERSION) {
+        return fail("unsupported snapshot format version");
+    }
+    if (header.kind != kind) {
+        return fail("snapshot was saved by a different class");
+    }
+    if (header.kind_version != kind_version) {
+        return fail("snapshot was saved by an incompatible version of this class");
+    }
+    if (header.total_size != size) {
+        return fail("snapshot is truncated or has trailing data");
+    }
+    if (header.section_count > (size - sizeof(Header)) / sizeof(Section)) {
+        return fail("section table is out of bounds");
+    }
+
+    // Sections are 16-byte aligned relative to the blob; Godot's packed
+    // arrays are allocated with at least that alignment
+    const Section* sections = reinterpret_cast<const Section*>(ptr + sizeof(Header));
+    for (uint32_t i = 0; i < header.section_count; i++) {
+        const Section& s = sections[i];
+        if (s.offset % ALIGNMENT != 0 || s.offset > size || s.element_size == 0) {
+            return fail("section is misaligned or out of bounds");
+        }
+        if (s.count > (size - s.offset) / s.element_size) {
+            return fail("section is out of bounds");
+        }
+    }
+
+    base = ptr;
+    table = sections;
+    section_count = header.section_count;
+    return true;
+}
+
+const Section* Reader::find(uint32_t tag, uint32_t element_size) const {
+    for (uint32_t i = 0; i < section_count; i++) {
+        if (table[i].tag == tag) {
+            if (table[i].element_size != element_size) {
+                fail("section element size differs from this build");
+                return nullptr;
+            }
+            return &table[i];
+        }
+    }
+    fail("snapshot is missing a section");
+    return nullptr;
+}
+
+bool Reader::check_offsets(const std::vector<int64_t>& offsets, uint64_t count, uint64_t total) const {
+    if (offsets.size() != count + 1 || offsets[0] != 0 || offsets[count] != static_cast<int64_t>(total)) {
+        return fail("list offsets don't match their data");
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        if (offsets[i + 1] < offsets[i]) {
+            return fail("list offsets don't match their data");
+        }
+    }
+    return true;
+}
+
+}
+}
@@ -0,0 +1,243 @@
+/**
+ * Snapshot - Flat binary format for saving built structures
+ *
+ * save_snapshot()/load_snapshot() on the spatial indexes and pathfinding
+ * caches write their internal arrays into one PackedByteArray:
+ *
+ *   Header   32 bytes   magic "AGSN", format version, kind, kind version,
+ *                       section count, total size
+ *   Table    24 bytes   per section: tag, element size, offset, count
+ *   Data                each section's elements, 16-byte aligned
+ *
+ * Sections hold fixed-size little-endian PODs (no pointers; links between
+ * elements are indices). Offsets are from the start of the blob, so the
+ * data is position independent and can be read in place from any buffer
+ * (including a memory-mapped file) without fix-up. Loading copies each
+ * section with one memcpy; nothing is re-sorted, re-hashed or re-searched.
+ *
+ * Every section records its element size, so a snapshot from a build with
+ * a different layout (e.g. double-precision Vector2) is rejected instead of
+ * misread. The kind version changes whenever a class's layout changes.
+ *
+ * Usage (internal):
+ *   snapshot::Writer w(snapshot::KIND_KD_TREE_2D, 1);
+ *   w.add_value(TAG_INFO, info);
+ *   w.add(TAG_IDS, ids);
+ *   PackedByteArray data = w.finish();
+ *
+ *   snapshot::Reader r;
+ *   if (!r.open(data, snapshot::KIND_KD_TREE_2D, 1, "KDTree2D")) return false;
+ *   if (!r.read_value(TAG_INFO, info) || !r.read(TAG_IDS, ids)) return false;
+ */
+
+#ifndef AGENTITE_SNAPSHOT_HPP
+#define AGENTITE_SNAPSHOT_HPP
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+namespace godot {
+namespace snapshot {
+
+static constexpr uint32_t MAGIC = 0x4E534741;  // "AGSN" read as little-endian uint32
+static constexpr uint16_t FORMAT_VERSION = 1;
+static constexpr uint64_t ALIGNMENT = 16;
+
+enum Kind : uint16_t {
+    KIND_KD_TREE_2D = 1,
+    KIND_KD_TREE_3D = 2,
+    KIND_QUAD_TREE = 3,
+    KIND_OCTREE = 4,
+    KIND_SPATIAL_HASH_2D = 5,
+    KIND_SPATIAL_HASH_3D = 6,
+    KIND_HIERARCHICAL_PATHFINDER = 7,
+    KIND_FLOW_FIELD_CACHE = 8,
+    KIND_CONNECTED_COMPONENTS = 9,
+};
+
+struct Header {
+    uint32_t magic;
+    uint16_t format_version;
+    uint16_t kind;
+    uint32_t kind_version;
+    uint32_t section_count;
+    uint64_t total_size;
+    uint64_t reserved;
+};
+
+struct Section {
+    uint32_t tag;
+    uint32_t element_size;
+    uint64_t offset;
+    uint64_t count;
+};
+
+static_assert(sizeof(Header) == 32, "Snapshot header must stay 32 bytes");
+static_assert(sizeof(Section) == 24, "Snapshot section entry must stay 24 bytes");
+
+class Writer {
+private:
+    struct Pending {
+        uint32_t tag;
+        uint32_t element_size;
+        uint64_t count;
+        const void* data;
+    };
+
+    uint16_t kind;
+    uint32_t kind_version;
+    std::vector<Pending> sections;
+    std::deque<std::vector<uint8_t>> owned;  // Data built by the writer itself
+
+    void add_raw(uint32_t tag, uint32_t element_size, uint64_t count, const void* data);
+    const void* keep(const void* data, size_t bytes);
+
+public:
+    Writer(Kind p_kind, uint32_t p_kind_version) : kind(p_kind), kind_version(p_kind_version) {}
+
+    // Add count elements; data must stay valid until finish()
+    template <typename T>
+    void add(uint32_t tag, const T* data, uint64_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+        add_raw(tag, sizeof(T), count, data);
+    }
+
+    template <typename T>
+    void add(uint32_t tag, const std::vector<T>& values) {
+        add(tag, values.data(), values.size());
+    }
+
+    // Add one element (copied now)
+    template <typename T>
+    void add_value(uint32_t tag, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+        add_raw(tag, sizeof(T), 1, keep(&value, sizeof(T)));
+    }
+
+    // Add a list of lists as two sections: tag = offsets (count + 1 int64), tag + 1 = elements
+    template <typename T, typename Get>
+    void add_jagged(uint32_t tag, uint64_t count, Get get) {
+        std::vector<int64_t> offsets(count + 1, 0);
+        for (uint64_t i = 0; i < count; i++) {
+            offsets[i + 1] = offsets[i] + static_cast<int64_t>(get(i).size());
+        }
+        std::vector<T> flat;
+        flat.reserve(static_cast<size_t>(offsets[count]));
+        for (uint64_t i = 0; i < count; i++) {
+            const std::vector<T>& list = get(i);
+            flat.insert(flat.end(), list.begin(), list.end());
+        }
+        add(tag, static_cast<const int64_t*>(keep(offsets.data(), offsets.size() * sizeof(int64_t))), offsets.size());
+        add(tag + 1, static_cast<const T*>(keep(flat.data(), flat.size() * sizeof(T))), flat.size());
+    }
+
+    PackedByteArray finish() const;
+};
+
+class Reader {
+private:
+    PackedByteArray bytes;  // Keeps the data alive while reading
+    const uint8_t* base = nullptr;
+    const Section* table = nullptr;
+    uint32_t section_count = 0;
+    const char* class_name = "";
+
+    const Section* find(uint32_t tag, uint32_t element_size) const;
+
+public:
+    // Validate the header and section table. Pushes an error and returns false on mismatch.
+    bool open(const PackedByteArray& data, Kind kind, uint32_t kind_version, const char* p_class_name);
+
+    // Copy a section into out. False (with an error) if missing or the element size differs.
+    template <typename T>
+    bool read(uint32_t tag, std::vector<T>& out) const {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+        const Section* s = find(tag, sizeof(T));
+        if (!s) return false;
+        out.resize(static_cast<size_t>(s->count));
+        if (s->count > 0) {
+            std::memcpy(out.data(), base + s->offset, static_cast<size_t>(s->count) * sizeof(T));
+        }
+        return true;
+    }
+
+    // Copy a section into a Godot packed array (e.g. PackedVector2Array with T = Vector2)
+    template <typename T, typename Packed>
+    bool read_packed(uint32_t tag, Packed& out) const {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+        const Section* s = find(tag, sizeof(T));
+        if (!s) return false;
+        out.resize(static_cast<int64_t>(s->count));
+        if (s->count > 0) {
+            std::memcpy(out.ptrw(), base + s->offset, static_cast<size_t>(s->count) * sizeof(T));
+        }
+        return true;
+    }
+
+    // Copy into a caller-provided buffer of exactly count elements
+    template <typename T>
+    bool read_into(uint32_t tag, T* out, uint64_t count) const;
+
+    // Elements of a section of exactly count elements, read in place (valid while the
+    // reader lives). Null (with an error) on mismatch.
+    template <typename T>
+    const T* view(uint32_t tag, uint64_t count) const;
+
+    template <typename T>
+    bool read_value(uint32_t tag, T& out) const {
+        return read_into(tag, &out, 1);
+    }
+
+    // Read a list of lists written by Writer::add_jagged; set(i) returns the list to fill
+    template <typename T, typename Set>
+    bool read_jagged(uint32_t tag, uint64_t count, Set set) const {
+        std::vector<int64_t> offsets;
+        std::vector<T> flat;
+        if (!read(tag, offsets) || !read(tag + 1, flat)) return false;
+        if (!check_offsets(offsets, count, flat.size())) return false;
+        for (uint64_t i = 0; i < count; i++) {
+            set(i).assign(flat.begin() + offsets[i], flat.begin() + offsets[i + 1]);
+        }
+        return true;
+    }
+
+    // Offsets must start at 0, never decrease and end at total
+    bool check_offsets(const std::vector<int64_t>& offsets, uint64_t count, uint64_t total) const;
+
+    // Push "AgentiteG: <class>.load_snapshot: <message>" and return false
+    bool fail(const char* message) const;
+};
+
+template <typename T>
+bool Reader::read_into(uint32_t tag, T* out, uint64_t count) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+    const Section* s = find(tag, sizeof(T));
+    if (!s) return false;
+    if (s->count != count) return fail("section has the wrong length");
+    if (count > 0) {
+        std::memcpy(out, base + s->offset, static_cast<size_t>(count) * sizeof(T));
+    }
+    return true;
+}
+
+template <typename T>
+const T* Reader::view(uint32_t tag, uint64_t count) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections hold plain data only");
+    const Section* s = find(tag, sizeof(T));
+    if (!s) return nullptr;
+    if (s->count != count) {
+        fail("section has the wrong length");
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(base + s->offset);
+}
+
+}
+}
+
+#endif // AGENTITE_SNAPSHOT_HPP
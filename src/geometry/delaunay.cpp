@@ -0,0 +1,761 @@
+/**
+ * Delaunay Implementation
+ */
+
+#include "delaunay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace godot {
+
+// ========== PREDICATES ==========
+
+// Points closer than this are treated as duplicates
+static const double DUPLICATE_EPSILON = 1.1102230246251565e-16;  // 2^-53
+
+// True if r lies to the right of p -> q (the sweep's outside test)
+static inline bool orient(double px, double py, double qx, double qy, double rx, double ry) {
+    return (qy - py) * (rx - qx) - (qx - px) * (ry - qy) < 0.0;
+}
+
+// True if p lies inside the circumcircle of a, b, c
+static inline bool in_circle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+    double dx = ax - px;
+    double dy = ay - py;
+    double ex = bx - px;
+    double ey = by - py;
+    double fx = cx - px;
+    double fy = cy - py;
+
+    double ap = dx * dx + dy * dy;
+    double bp = ex * ex + ey * ey;
+    double cp = fx * fx + fy * fy;
+
+    return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) < 0.0;
+}
+
+// Squared circumradius of a, b, c (infinite when collinear)
+static inline double circumradius_sq(double ax, double ay, double bx, double by, double cx, double cy) {
+    double dx = bx - ax;
+    double dy = by - ay;
+    double ex = cx - ax;
+    double ey = cy - ay;
+
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = 0.5 / (dx * ey - dy * ex);
+
+    double x = (ey * bl - dy * cl) * d;
+    double y = (dx * cl - ex * bl) * d;
+    double r = x * x + y * y;
+    return std::isfinite(r) ? r : std::numeric_limits<double>::infinity();
+}
+
+static inline void circumcenter(double ax, double ay, double bx, double by, double cx, double cy,
+                                double& out_x, double& out_y) {
+    double dx = bx - ax;
+    double dy = by - ay;
+    double ex = cx - ax;
+    double ey = cy - ay;
+
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = 0.5 / (dx * ey - dy * ex);
+
+    out_x = ax + (ey * bl - dy * cl) * d;
+    out_y = ay + (dx * cl - ex * bl) * d;
+}
+
+// Monotonic in the angle of (dx, dy), in [0, 1)
+static inline double pseudo_angle(double dx, double dy) {
+    double sum = std::abs(dx) + std::abs(dy);
+    if (sum == 0.0) return 0.0;
+    double p = dx / sum;
+    return (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+}
+
+// Twice the signed area of (a, b, c): positive when c lies left of a -> b
+static inline double cross_at(const std::vector<double>& c, int32_t a, int32_t b, int32_t p) {
+    return (c[2 * b] - c[2 * a]) * (c[2 * p + 1] - c[2 * a + 1]) - (c[2 * b + 1] - c[2 * a + 1]) * (c[2 * p] - c[2 * a]);
+}
+
+// True if p lies on the ray from a through b (collinear and ahead of a)
+static inline bool ahead_on_line(const std::vector<double>& c, int32_t a, int32_t b, int32_t p) {
+    if (cross_at(c, a, b, p) != 0.0) return false;
+    return (c[2 * p] - c[2 * a]) * (c[2 * b] - c[2 * a]) + (c[2 * p + 1] - c[2 * a + 1]) * (c[2 * b + 1] - c[2 * a + 1]) > 0.0;
+}
+
+static inline double dist_sq(double ax, double ay, double bx, double by) {
+    double dx = ax - bx;
+    double dy = ay - by;
+    return dx * dx + dy * dy;
+}
+
+// ========== BUILD ==========
+
+void DelaunayTriangulation::build(const Vector2* points, int32_t count) {
+    triangles.clear();
+    half_edges.clear();
+    hull.clear();
+    constrained.clear();
+    representative.assign(std::max<int32_t>(count, 0), -1);
+
+    if (count <= 0) return;
+
+    coords.resize(static_cast<size_t>(count) * 2);
+    double min_x = std::numeric_limits<double>::infinity();
+    double min_y = min_x;
+    double max_x = -min_x;
+    double max_y = -min_x;
+    for (int32_t i = 0; i < count; i++) {
+        double x = points[i].x;
+        double y = points[i].y;
+        coords[2 * i] = x;
+        coords[2 * i + 1] = y;
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+    double cx = (min_x + max_x) / 2.0;
+    double cy = (min_y + max_y) / 2.0;
+
+    // Exact duplicates map onto the lowest index at their position and are
+    // left out of the sweep (copies need not be adjacent in sweep order)
+    std::vector<int32_t> first_of(count);
+    {
+        std::vector<int32_t> by_position(count);
+        for (int32_t i = 0; i < count; i++) by_position[i] = i;
+        std::sort(by_position.begin(), by_position.end(), [&](int32_t a, int32_t b) {
+            if (coords[2 * a] != coords[2 * b]) return coords[2 * a] < coords[2 * b];
+            if (coords[2 * a + 1] != coords[2 * b + 1]) return coords[2 * a + 1] < coords[2 * b + 1];
+            return a < b;
+        });
+        for (int32_t k = 0; k < count; k++) {
+            int32_t i = by_position[k];
+            int32_t p = k > 0 ? by_position[k - 1] : -1;
+            bool repeat = p != -1 && coords[2 * i] == coords[2 * p] && coords[2 * i + 1] == coords[2 * p + 1];
+            first_of[i] = repeat ? first_of[p] : i;
+        }
+    }
+
+    // Seed triangle: the point nearest the center, its nearest neighbor,
+    // and the point forming the smallest circumcircle with both
+    int32_t i0 = 0;
+    double min_dist = std::numeric_limits<double>::infinity();
+    for (int32_t i = 0; i < count; i++) {
+        double d = dist_sq(cx, cy, coords[2 * i], coords[2 * i + 1]);
+        if (d < min_dist) {
+            i0 = i;
+            min_dist = d;
+        }
+    }
+    double i0x = coords[2 * i0];
+    double i0y = coords[2 * i0 + 1];
+
+    int32_t i1 = -1;
+    min_dist = std::numeric_limits<double>::infinity();
+    for (int32_t i = 0; i < count; i++) {
+        if (i == i0) continue;
+        double d = dist_sq(i0x, i0y, coords[2 * i], coords[2 * i + 1]);
+        if (d < min_dist && d > 0.0) {
+            i1 = i;
+            min_dist = d;
+        }
+    }
+
+    int32_t i2 = -1;
+    double min_radius = std::numeric_limits<double>::infinity();
+    if (i1 != -1) {
+        double i1x = coords[2 * i1];
+        double i1y = coords[2 * i1 + 1];
+        for (int32_t i = 0; i < count; i++) {
+            if (i == i0 || i == i1) continue;
+            double r = circumradius_sq(i0x, i0y, i1x, i1y, coords[2 * i], coords[2 * i + 1]);
+            if (r < min_radius) {
+                i2 = i;
+                min_radius = r;
+            }
+        }
+    }
+
+    std::vector<int32_t> ids(count);
+    for (int32_t i = 0; i < count; i++) ids[i] = i;
+    std::vector<double> dists(count);
+
+    if (i2 == -1) {
+        // Collinear (or fewer than 3 distinct points): no triangles, the
+        // hull lists the distinct points in order along the line
+        for (int32_t i = 0; i < count; i++) {
+            double d = coords[2 * i] - coords[0];
+            dists[i] = (d != 0.0) ? d : coords[2 * i + 1] - coords[1];
+        }
+        std::sort(ids.begin(), ids.end(), [&](int32_t a, int32_t b) {
+            return dists[a] < dists[b] || (dists[a] == dists[b] && a < b);
+        });
+
+        double last = -std::numeric_limits<double>::infinity();
+        for (int32_t id : ids) {
+            if (dists[id] > last) {
+                hull.push_back(id);
+                last = dists[id];
+            }
+            representative[id] = hull.back();
+        }
+        return;
+    }
+
+    double i1x = coords[2 * i1];
+    double i1y = coords[2 * i1 + 1];
+    double i2x = coords[2 * i2];
+    double i2y = coords[2 * i2 + 1];
+
+    // The sweep expects the seed triangle in this orientation
+    if (orient(i0x, i0y, i1x, i1y, i2x, i2y)) {
+        std::swap(i1, i2);
+        std::swap(i1x, i2x);
+        std::swap(i1y, i2y);
+    }
+
+    circumcenter(i0x, i0y, i1x, i1y, i2x, i2y, center_x, center_y);
+
+    for (int32_t i = 0; i < count; i++) {
+        dists[i] = dist_sq(coords[2 * i], coords[2 * i + 1], center_x, center_y);
+    }
+    std::sort(ids.begin(), ids.end(), [&](int32_t a, int32_t b) {
+        return dists[a] < dists[b] || (dists[a] == dists[b] && a < b);
+    });
+
+    // At most 2n - 5 triangles
+    int32_t max_triangles = std::max(2 * count - 5, 1);
+    triangles.reserve(static_cast<size_t>(max_triangles) * 3);
+    half_edges.reserve(static_cast<size_t>(max_triangles) * 3);
+
+    hash_size = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    hull_prev.assign(count, -1);
+    hull_next.assign(count, -1);
+    hull_tri.assign(count, -1);
+    hull_hash.assign(hash_size, -1);
+    edge_stack.clear();
+
+    // Seed triangle as the initial hull
+    hull_start = i0;
+    int32_t hull_size = 3;
+    hull_next[i0] = hull_prev[i2] = i1;
+    hull_next[i1] = hull_prev[i0] = i2;
+    hull_next[i2] = hull_prev[i1] = i0;
+    hull_tri[i0] = 0;
+    hull_tri[i1] = 1;
+    hull_tri[i2] = 2;
+    hull_hash[hash_key(i0x, i0y)] = i0;
+    hull_hash[hash_key(i1x, i1y)] = i1;
+    hull_hash[hash_key(i2x, i2y)] = i2;
+    add_triangle(i0, i1, i2, -1, -1, -1);
+
+    double xp = 0.0;
+    double yp = 0.0;
+    int32_t last = -1;
+    for (int32_t k = 0; k < count; k++) {
+        int32_t i = ids[k];
+        double x = coords[2 * i];
+        double y = coords[2 * i + 1];
+
+        if (first_of[i] != i) continue;
+
+        // Near-duplicates map onto the point they repeat
+        if (last != -1 && std::abs(x - xp) <= DUPLICATE_EPSILON && std::abs(y - yp) <= DUPLICATE_EPSILON) {
+            representative[i] = representative[last];
+            continue;
+        }
+        xp = x;
+        yp = y;
+        last = i;
+
+        if (i == i0 || i == i1 || i == i2) {
+            representative[i] = i;
+            continue;
+        }
+
+        // Find a hull edge visible from the point, starting near its angle
+        int32_t start = 0;
+        for (int32_t j = 0, key = hash_key(x, y); j < hash_size; j++) {
+            start = hull_hash[(key + j) % hash_size];
+            if (start != -1 && start != hull_next[start]) break;
+        }
+
+        start = hull_prev[start];
+        int32_t e = start;
+        int32_t q = hull_next[e];
+        while (!orient(x, y, coords[2 * e], coords[2 * e + 1], coords[2 * q], coords[2 * q + 1])) {
+            e = q;
+            if (e == start) {
+                e = -1;
+                break;
+            }
+            q = hull_next[e];
+        }
+        if (e == -1) continue;  // Degenerate (near-duplicate of a hull point)
+
+        representative[i] = i;
+
+        // First triangle from the point, then flip until Delaunay
+        int32_t t = add_triangle(e, i, hull_next[e], -1, -1, hull_tri[e]);
+        hull_tri[i] = legalize(t + 2);
+        hull_tri[e] = t;
+        hull_size++;
+
+        // Walk forward along the hull, adding triangles
+        int32_t n = hull_next[e];
+        q = hull_next[n];
+        while (orient(x, y, coords[2 * n], coords[2 * n + 1], coords[2 * q], coords[2 * q + 1])) {
+            t = add_triangle(n, i, q, hull_tri[i], -1, hull_tri[n]);
+            hull_tri[i] = legalize(t + 2);
+            hull_next[n] = n;  // Removed from the hull
+            hull_size--;
+            n = q;
+            q = hull_next[n];
+        }
+
+        // Walk backward from the other side
+        if (e == start) {
+            q = hull_prev[e];
+            while (orient(x, y, coords[2 * q], coords[2 * q + 1], coords[2 * e], coords[2 * e + 1])) {
+                t = add_triangle(q, i, e, -1, hull_tri[e], hull_tri[q]);
+                legalize(t + 2);
+                hull_tri[q] = t;
+                hull_next[e] = e;  // Removed from the hull
+                hull_size--;
+                e = q;
+                q = hull_prev[e];
+            }
+        }
+
+        // Splice the point into the hull
+        hull_start = hull_prev[i] = e;
+        hull_next[e] = hull_prev[n] = i;
+        hull_next[i] = n;
+
+        hull_hash[hash_key(x, y)] = i;
+        hull_hash[hash_key(coords[2 * e], coords[2 * e + 1])] = e;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        if (first_of[i] != i) representative[i] = representative[first_of[i]];
+    }
+
+    hull.resize(hull_size);
+    for (int32_t i = 0, e = hull_start; i < hull_size; i++) {
+        hull[i] = e;
+        e = hull_next[e];
+    }
+
+    flip_winding();
+}
+
+// ========== INTERNALS ==========
+
+int32_t DelaunayTriangulation::hash_key(double x, double y) const {
+    int32_t key = static_cast<int32_t>(std::floor(pseudo_angle(x - center_x, y - center_y) * hash_size));
+    return ((key % hash_size) + hash_size) % hash_size;
+}
+
+int32_t DelaunayTriangulation::add_triangle(int32_t i0, int32_t i1, int32_t i2, int32_t a, int32_t b, int32_t c) {
+    int32_t t = static_cast<int32_t>(triangles.size());
+    triangles.push_back(i0);
+    triangles.push_back(i1);
+    triangles.push_back(i2);
+    half_edges.push_back(-1);
+    half_edges.push_back(-1);
+    half_edges.push_back(-1);
+    link(t, a);
+    link(t + 1, b);
+    link(t + 2, c);
+    return t;
+}
+
+void DelaunayTriangulation::link(int32_t a, int32_t b) {
+    half_edges[a] = b;
+    if (b != -1) half_edges[b] = a;
+}
+
+// Flip edges from half-edge a until the Delaunay condition holds around it
+// Returns the half-edge that ends up opposite a's triangle corner
+int32_t DelaunayTriangulation::legalize(int32_t a) {
+    int32_t ar = 0;
+
+    while (true) {
+        int32_t b = half_edges[a];
+        int32_t a0 = a - a % 3;
+        ar = a0 + (a + 2) % 3;
+
+        if (b == -1) {
+            if (edge_stack.empty()) break;
+            a = edge_stack.back();
+            edge_stack.pop_back();
+            continue;
+        }
+
+        int32_t b0 = b - b % 3;
+        int32_t al = a0 + (a + 1) % 3;
+        int32_t bl = b0 + (b + 2) % 3;
+
+        int32_t p0 = triangles[ar];
+        int32_t pr = triangles[a];
+        int32_t pl = triangles[al];
+        int32_t p1 = triangles[bl];
+
+        bool illegal = in_circle(coords[2 * p0], coords[2 * p0 + 1], coords[2 * pr], coords[2 * pr + 1],
+                                 coords[2 * pl], coords[2 * pl + 1], coords[2 * p1], coords[2 * p1 + 1]);
+
+        if (illegal) {
+            triangles[a] = p1;
+            triangles[b] = p0;
+
+            // Keep the hull's triangle references valid
+            int32_t hbl = half_edges[bl];
+            if (hbl == -1) {
+                int32_t e = hull_start;
+                do {
+                    if (hull_tri[e] == bl) {
+                        hull_tri[e] = a;
+                        break;
+                    }
+                    e = hull_prev[e];
+                } while (e != hull_start);
+            }
+
+            link(a, hbl);
+            link(b, half_edges[ar]);
+            link(ar, bl);
+
+            edge_stack.push_back(b0 + (b + 1) % 3);
+        } else {
+            if (edge_stack.empty()) break;
+            a = edge_stack.back();
+            edge_stack.pop_back();
+        }
+    }
+
+    return ar;
+}
+
+// The sweep builds clockwise triangles; reverse them to counter-clockwise
+// like the rest of GeometryOps. Reversing (v0, v1, v2) to
+// (v0, v2, v1) moves half-edge k of a triangle to slot 2 - k.
+void DelaunayTriangulation::flip_winding() {
+    int32_t size = static_cast<int32_t>(triangles.size());
+    std::vector<int32_t> flipped(size);
+    for (int32_t e = 0; e < size; e++) {
+        int32_t opposite = half_edges[e];
+        flipped[e - e % 3 + (2 - e % 3)] = (opposite == -1) ? -1 : opposite - opposite % 3 + (2 - opposite % 3);
+    }
+    half_edges.swap(flipped);
+
+    for (int32_t t = 0; t < size; t += 3) {
+        std::swap(triangles[t + 1], triangles[t + 2]);
+    }
+}
+
+
+// ========== CONSTRAINTS ==========
+
+bool DelaunayTriangulation::build_constrained(const Vector2* points, int32_t count, const std::vector<int32_t>& edges) {
+    build(points, count);
+    if (triangles.empty()) return edges.empty();
+
+    constrained.assign(triangles.size(), 0);
+    vertex_edge.assign(count, -1);
+    for (int32_t e = 0; e < static_cast<int32_t>(triangles.size()); e++) {
+        vertex_edge[triangles[e]] = e;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i + 1 < edges.size(); i += 2) {
+        int32_t a = edges[i];
+        int32_t b = edges[i + 1];
+        if (a < 0 || a >= count || b < 0 || b >= count || representative[a] < 0 || representative[b] < 0) {
+            ok = false;
+            continue;
+        }
+        if (!insert_edge(representative[a], representative[b])) ok = false;
+    }
+
+    remove_outside();
+    hull.clear();
+    return ok;
+}
+
+// Half-edges leaving v, in counter-clockwise order (into fan)
+void DelaunayTriangulation::collect_fan(int32_t v) {
+    fan.clear();
+    int32_t start = vertex_edge[v];
+
+    // Rotate clockwise to the hull (or all the way around)
+    int32_t e = start;
+    while (half_edges[e] != -1) {
+        int32_t n = next_half_edge(half_edges[e]);
+        if (n == start) break;
+        e = n;
+    }
+
+    int32_t first = e;
+    do {
+        fan.push_back(e);
+        int32_t incoming = half_edges[prev_half_edge(e)];
+        if (incoming == -1) break;
+        e = incoming;
+    } while (e != first);
+}
+
+// A half-edge of the edge between from and to (either direction), or -1
+int32_t DelaunayTriangulation::find_half_edge(int32_t from, int32_t to) {
+    collect_fan(from);
+    for (int32_t e : fan) {
+        if (triangles[next_half_edge(e)] == to) return e;
+        if (triangles[prev_half_edge(e)] == to) return prev_half_edge(e);
+    }
+    return -1;
+}
+
+// Replace the diagonal of the quad around interior half-edge e
+// (p, q, r) + (q, p, s) becomes (s, r, p) + (r, s, q); e then runs s -> r
+void DelaunayTriangulation::flip(int32_t e) {
+    int32_t o = half_edges[e];
+    int32_t e1 = next_half_edge(e);
+    int32_t e2 = prev_half_edge(e);
+    int32_t o1 = next_half_edge(o);
+    int32_t o2 = prev_half_edge(o);
+
+    int32_t p = triangles[e];
+    int32_t q = triangles[e1];
+    int32_t r = triangles[e2];
+    int32_t s = triangles[o2];
+
+    int32_t h_e1 = half_edges[e1];
+    int32_t h_e2 = half_edges[e2];
+    int32_t h_o1 = half_edges[o1];
+    int32_t h_o2 = half_edges[o2];
+    uint8_t c_e1 = constrained[e1];
+    uint8_t c_e2 = constrained[e2];
+    uint8_t c_o1 = constrained[o1];
+    uint8_t c_o2 = constrained[o2];
+
+    triangles[e] = s;
+    triangles[e1] = r;
+    triangles[e2] = p;
+    triangles[o] = r;
+    triangles[o1] = s;
+    triangles[o2] = q;
+
+    link(e, o);
+    link(e1, h_e2);
+    link(e2, h_o1);
+    link(o1, h_o2);
+    link(o2, h_e1);
+
+    constrained[e] = 0;
+    constrained[o] = 0;
+    constrained[e1] = c_e2;
+    constrained[e2] = c_o1;
+    constrained[o1] = c_o2;
+    constrained[o2] = c_e1;
+
+    vertex_edge[p] = e2;
+    vertex_edge[q] = o2;
+    vertex_edge[r] = e1;
+    vertex_edge[s] = o1;
+}
+
+// Force the segment a -> b into the triangulation. Vertices lying exactly
+// on the segment split it into pieces, each inserted in turn.
+bool DelaunayTriangulation::insert_edge(int32_t a, int32_t b) {
+    std::vector<int32_t> crossed;
+    std::vector<int32_t> created;
+
+    while (a != b) {
+        // Look around a for b, a vertex on the segment, or the first crossed edge
+        int32_t stop = -1;
+        int32_t crossing = -1;
+        collect_fan(a);
+        for (int32_t e : fan) {
+            int32_t q = triangles[next_half_edge(e)];
+            int32_t r = triangles[prev_half_edge(e)];
+            if (q == b || ahead_on_line(coords, a, b, q)) {
+                constrained[e] = 1;
+                if (half_edges[e] != -1) constrained[half_edges[e]] = 1;
+                stop = q;
+                break;
+            }
+            if (r == b || ahead_on_line(coords, a, b, r)) {
+                int32_t in = prev_half_edge(e);
+                constrained[in] = 1;
+                if (half_edges[in] != -1) constrained[half_edges[in]] = 1;
+                stop = r;
+                break;
+            }
+            if (cross_at(coords, a, q, b) > 0.0 && cross_at(coords, a, r, b) < 0.0) {
+                crossing = next_half_edge(e);
+                break;
+            }
+        }
+        if (stop != -1) {
+            a = stop;
+            continue;
+        }
+        if (crossing == -1) return false;
+
+        // Walk along the segment, collecting the crossed edges as vertex pairs
+        crossed.clear();
+        int32_t e = crossing;
+        while (true) {
+            if (constrained[e]) return false;  // Crosses another constraint
+            int32_t o = half_edges[e];
+            if (o == -1) return false;
+            crossed.push_back(triangles[e]);
+            crossed.push_back(triangles[next_half_edge(e)]);
+
+            int32_t v = triangles[prev_half_edge(o)];
+            double side = cross_at(coords, a, b, v);
+            if (v == b || side == 0.0) {
+                stop = v;
+                break;
+            }
+            double side_q = cross_at(coords, a, b, triangles[next_half_edge(o)]);
+            e = ((side_q > 0.0) != (side > 0.0)) ? next_half_edge(o) : prev_half_edge(o);
+        }
+
+        // Flip crossed edges until none remain; an edge whose quad is not
+        // convex waits for its neighbors to be flipped first
+        created.clear();
+        size_t head = 0;
+        size_t budget = 64 + crossed.size() * crossed.size();
+        while (head < crossed.size()) {
+            if (budget-- == 0) return false;
+            int32_t u = crossed[head];
+            int32_t w = crossed[head + 1];
+            head += 2;
+
+            int32_t h = find_half_edge(u, w);
+            if (h == -1 || half_edges[h] == -1) return false;
+            int32_t r = triangles[prev_half_edge(h)];
+            int32_t s = triangles[prev_half_edge(half_edges[h])];
+
+            double su = cross_at(coords, r, s, u);
+            double sw = cross_at(coords, r, s, w);
+            if (!((su > 0.0 && sw < 0.0) || (su < 0.0 && sw > 0.0))) {
+                crossed.push_back(u);
+                crossed.push_back(w);
+                continue;
+            }
+
+            flip(h);
+            double sr = cross_at(coords, a, stop, r);
+            double ss = cross_at(coords, a, stop, s);
+            bool still_crossing = r != a && s != a && r != stop && s != stop &&
+                                  ((sr > 0.0 && ss < 0.0) || (sr < 0.0 && ss > 0.0));
+            if (still_crossing) {
+                crossed.push_back(s);
+                crossed.push_back(r);
+            } else {
+                created.push_back(s);
+                created.push_back(r);
+            }
+        }
+
+        int32_t h = find_half_edge(a, stop);
+        if (h == -1) return false;
+        constrained[h] = 1;
+        if (half_edges[h] != -1) constrained[half_edges[h]] = 1;
+
+        // Restore the Delaunay condition on the new, unconstrained edges
+        bool swapped = true;
+        while (swapped) {
+            swapped = false;
+            for (size_t i = 0; i < created.size(); i += 2) {
+                int32_t g = find_half_edge(created[i], created[i + 1]);
+                if (g == -1 || half_edges[g] == -1 || constrained[g]) continue;
+                int32_t p = triangles[g];
+                int32_t q = triangles[next_half_edge(g)];
+                int32_t r = triangles[prev_half_edge(g)];
+                int32_t s = triangles[prev_half_edge(half_edges[g])];
+
+                // in_circle expects clockwise triangles
+                if (in_circle(coords[2 * p], coords[2 * p + 1], coords[2 * r], coords[2 * r + 1],
+                              coords[2 * q], coords[2 * q + 1], coords[2 * s], coords[2 * s + 1])) {
+                    flip(g);
+                    created[i] = s;
+                    created[i + 1] = r;
+                    swapped = true;
+                }
+            }
+        }
+
+        a = stop;
+    }
+    return true;
+}
+
+// Keep the triangles enclosed by an odd number of constraint outlines:
+// flood from the hull, counting constraint edges crossed
+void DelaunayTriangulation::remove_outside() {
+    int32_t size = static_cast<int32_t>(triangles.size());
+    int32_t tri_count = size / 3;
+    std::vector<int32_t> depth(tri_count, -1);
+    std::vector<int32_t> frontier;
+    std::vector<int32_t> next_frontier;
+    std::vector<int32_t> stack;
+
+    for (int32_t e = 0; e < size; e++) {
+        if (half_edges[e] != -1) continue;
+        (constrained[e] ? next_frontier : frontier).push_back(e / 3);
+    }
+
+    for (int32_t level = 0; !frontier.empty() || !next_frontier.empty(); level++) {
+        stack.swap(frontier);
+        frontier.clear();
+        while (!stack.empty()) {
+            int32_t t = stack.back();
+            stack.pop_back();
+            if (depth[t] != -1) continue;
+            depth[t] = level;
+            for (int32_t k = 0; k < 3; k++) {
+                int32_t o = half_edges[3 * t + k];
+                if (o == -1 || depth[o / 3] != -1) continue;
+                (constrained[3 * t + k] ? frontier : stack).push_back(o / 3);
+            }
+        }
+        // frontier now holds the triangles one constraint deeper
+        std::swap(frontier, next_frontier);
+        for (int32_t t : next_frontier) frontier.push_back(t);
+        next_frontier.clear();
+    }
+
+    // Compact the surviving triangles and remap their half-edges
+    std::vector<int32_t> remap(tri_count, -1);
+    int32_t kept = 0;
+    for (int32_t t = 0; t < tri_count; t++) {
+        if (depth[t] % 2 == 1) remap[t] = kept++;
+    }
+
+    std::vector<int32_t> new_triangles(static_cast<size_t>(kept) * 3);
+    std::vector<int32_t> new_half_edges(static_cast<size_t>(kept) * 3);
+    std::vector<uint8_t> new_constrained(static_cast<size_t>(kept) * 3);
+    for (int32_t t = 0; t < tri_count; t++) {
+        int32_t nt = remap[t];
+        if (nt == -1) continue;
+        for (int32_t k = 0; k < 3; k++) {
+            int32_t e = 3 * t + k;
+            int32_t o = half_edges[e];
+            new_triangles[3 * nt + k] = triangles[e];
+            new_half_edges[3 * nt + k] = (o == -1 || remap[o / 3] == -1) ? -1 : 3 * remap[o / 3] + o % 3;
+            new_constrained[3 * nt + k] = constrained[e];
+        }
+    }
+    triangles.swap(new_triangles);
+    half_edges.swap(new_half_edges);
+    constrained.swap(new_constrained);
+}
+
+}
@@ -0,0 +1,98 @@
+/**
+ * Delaunay - Sweep-hull Delaunay triangulation with half-edge adjacency
+ *
+ * Internal helper behind GeometryOps.delaunay and the Voronoi functions.
+ * Points are sorted by distance from a seed triangle's circumcenter and
+ * added one at a time outside a growing convex hull; edges are flipped
+ * until every triangle is Delaunay. Expected O(n log n).
+ *
+ * Half-edge e runs from triangles[e] to triangles[next_half_edge(e)] and
+ * belongs to triangle e / 3. half_edges[e] is the opposite half-edge in the
+ * neighboring triangle, or -1 on the convex hull.
+ *
+ * Triangles are counter-clockwise (positive signed area), like convex_hull.
+ *
+ * build_constrained() additionally forces a set of edges (polygon outlines)
+ * into the triangulation by flipping the edges they cross (Sloan's method),
+ * then keeps only the triangles inside the outlines (even-odd nesting, so
+ * holes and islands inside holes work).
+ *
+ * Usage (internal):
+ *   DelaunayTriangulation dt;
+ *   dt.build(points.ptr(), points.size());
+ *   for (int32_t e = 0; e < (int32_t)dt.triangles.size(); e++) { ... dt.half_edges[e] ... }
+ */
+
+#ifndef AGENTITE_DELAUNAY_HPP
+#define AGENTITE_DELAUNAY_HPP
+
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class DelaunayTriangulation {
+public:
+    // Vertex indices, three per triangle
+    std::vector<int32_t> triangles;
+
+    // Opposite half-edge for each half-edge, -1 on the hull
+    std::vector<int32_t> half_edges;
+
+    // Convex hull, as point indices in order. When every point is collinear
+    // there are no triangles and this lists the distinct points along the line.
+    // Empty after build_constrained().
+    std::vector<int32_t> hull;
+
+    // For each input point, the triangulated point at the same position
+    // (itself when it was inserted), or -1 if it was dropped as degenerate
+    std::vector<int32_t> representative;
+
+    // Per half-edge: 1 if it lies on a constraint edge
+    std::vector<uint8_t> constrained;
+
+    // Triangulate count points (replaces any previous result)
+    void build(const Vector2* points, int32_t count);
+
+    // Triangulate count points with edges (index pairs) forced in, keeping
+    // only the triangles enclosed by them. Returns false if an edge could not
+    // be inserted (it crosses another edge or uses a degenerate point).
+    bool build_constrained(const Vector2* points, int32_t count, const std::vector<int32_t>& edges);
+
+    static int32_t next_half_edge(int32_t e) { return (e % 3 == 2) ? e - 2 : e + 1; }
+    static int32_t prev_half_edge(int32_t e) { return (e % 3 == 0) ? e + 2 : e - 1; }
+
+private:
+    std::vector<double> coords;
+    std::vector<int32_t> hull_prev;
+    std::vector<int32_t> hull_next;
+    std::vector<int32_t> hull_tri;
+    std::vector<int32_t> hull_hash;
+    std::vector<int32_t> edge_stack;
+    int32_t hull_start = 0;
+    int32_t hash_size = 0;
+    double center_x = 0.0;
+    double center_y = 0.0;
+
+    int32_t hash_key(double x, double y) const;
+    int32_t add_triangle(int32_t i0, int32_t i1, int32_t i2, int32_t a, int32_t b, int32_t c);
+    void link(int32_t a, int32_t b);
+    int32_t legalize(int32_t a);
+    void flip_winding();
+
+    // Constraint insertion (on the counter-clockwise triangles)
+    std::vector<int32_t> vertex_edge;  // One half-edge leaving each vertex
+    std::vector<int32_t> fan;
+
+    void collect_fan(int32_t v);
+    int32_t find_half_edge(int32_t from, int32_t to);
+    void flip(int32_t e);
+    bool insert_edge(int32_t a, int32_t b);
+    void remove_outside();
+};
+
+}
+
+#endif // AGENTITE_DELAUNAY_HPP
@@ -3,6 +3,8 @@
  */
 
 #include "geometry_ops.hpp"
+#include "delaunay.hpp"
+#include "core/parallel.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -10,6 +12,7 @@
 #include <algorithm>
 #include <cmath>
 #include <vector>
+#include <map>
 #include <queue>
 #include <limits>
 
@@ -23,6 +26,8 @@ void GeometryOps::_bind_methods() {
     // Triangulation
     ClassDB::bind_static_method("GeometryOps", D_METHOD("triangulate", "polygon"), &GeometryOps::triangulate);
     ClassDB::bind_static_method("GeometryOps", D_METHOD("delaunay", "points"), &GeometryOps::delaunay);
+    ClassDB::bind_static_method("GeometryOps", D_METHOD("delaunay_half_edges", "points"), &GeometryOps::delaunay_half_edges);
+    ClassDB::bind_static_method("GeometryOps", D_METHOD("constrained_delaunay", "boundary", "holes"), &GeometryOps::constrained_delaunay, DEFVAL(Array()));
 
     // Voronoi
     ClassDB::bind_static_method("GeometryOps", D_METHOD("voronoi_cells", "points", "bounds"), &GeometryOps::voronoi_cells);
@@ -275,131 +280,139 @@ PackedInt32Array GeometryOps::delaunay(const PackedVector2Array& points) {
         return result;
     }
 
-    const Vector2* p = points.ptr();
+    DelaunayTriangulation dt;
+    dt.build(points.ptr(), n);
 
-    // Bowyer-Watson algorithm
-    // Start with super-triangle containing all points
-    float min_x = p[0].x, max_x = p[0].x;
-    float min_y = p[0].y, max_y = p[0].y;
-    for (int32_t i = 1; i < n; i++) {
-        min_x = std::fmin(min_x, p[i].x);
-        max_x = std::fmax(max_x, p[i].x);
-        min_y = std::fmin(min_y, p[i].y);
-        max_y = std::fmax(max_y, p[i].y);
-    }
+    result.resize(dt.triangles.size());
+    std::copy(dt.triangles.begin(), dt.triangles.end(), result.ptrw());
 
-    float dx = max_x - min_x;
-    float dy = max_y - min_y;
-    float delta = std::fmax(dx, dy) * 2.0f;
+    return result;
+}
 
-    // Super-triangle vertices (indices n, n+1, n+2)
-    Vector2 st0(min_x - delta, min_y - delta);
-    Vector2 st1(min_x + dx / 2, max_y + delta * 2);
-    Vector2 st2(max_x + delta, min_y - delta);
+Array GeometryOps::delaunay_half_edges(const PackedVector2Array& points) {
+    PackedInt32Array triangles;
+    PackedInt32Array half_edges;
+    int32_t n = points.size();
 
-    // Store all vertices
-    std::vector<Vector2> vertices(n + 3);
-    for (int32_t i = 0; i < n; i++) {
-        vertices[i] = p[i];
+    if (n >= 3) {
+        DelaunayTriangulation dt;
+        dt.build(points.ptr(), n);
+
+        triangles.resize(dt.triangles.size());
+        std::copy(dt.triangles.begin(), dt.triangles.end(), triangles.ptrw());
+        half_edges.resize(dt.half_edges.size());
+        std::copy(dt.half_edges.begin(), dt.half_edges.end(), half_edges.ptrw());
     }
-    vertices[n] = st0;
-    vertices[n + 1] = st1;
-    vertices[n + 2] = st2;
-
-    // Triangle: indices of 3 vertices
-    struct Triangle {
-        int32_t v[3];
-        bool bad;
-    };
 
-    std::vector<Triangle> triangles;
-    triangles.push_back({n, n + 1, n + 2, false});
+    Array result;
+    result.push_back(triangles);
+    result.push_back(half_edges);
+    return result;
+}
 
-    // Add points one at a time
-    for (int32_t i = 0; i < n; i++) {
-        Vector2 point = vertices[i];
-
-        // Find triangles whose circumcircle contains the point
-        for (auto& tri : triangles) {
-            if (tri.bad) continue;
-
-            // Compute circumcircle
-            Vector2 a = vertices[tri.v[0]];
-            Vector2 b = vertices[tri.v[1]];
-            Vector2 c = vertices[tri.v[2]];
-
-            float ax = a.x - point.x;
-            float ay = a.y - point.y;
-            float bx = b.x - point.x;
-            float by = b.y - point.y;
-            float cx = c.x - point.x;
-            float cy = c.y - point.y;
-
-            float det = (ax * ax + ay * ay) * (bx * cy - cx * by) -
-                        (bx * bx + by * by) * (ax * cy - cx * ay) +
-                        (cx * cx + cy * cy) * (ax * by - bx * ay);
-
-            if (det > 0) {
-                tri.bad = true;
-            }
-        }
+static Array make_triangulation_result(const PackedVector2Array& vertices, const PackedInt32Array& triangles,
+                                       const PackedInt32Array& half_edges) {
+    Array result;
+    result.push_back(vertices);
+    result.push_back(triangles);
+    result.push_back(half_edges);
+    return result;
+}
 
-        // Find boundary of bad triangles (polygon hole)
-        std::vector<std::pair<int32_t, int32_t>> polygon;
-        for (const auto& tri : triangles) {
-            if (!tri.bad) continue;
-
-            for (int e = 0; e < 3; e++) {
-                int32_t v0 = tri.v[e];
-                int32_t v1 = tri.v[(e + 1) % 3];
-
-                // Check if edge is shared with another bad triangle
-                bool shared = false;
-                for (const auto& other : triangles) {
-                    if (&tri == &other || !other.bad) continue;
-
-                    for (int e2 = 0; e2 < 3; e2++) {
-                        if ((other.v[e2] == v0 && other.v[(e2 + 1) % 3] == v1) ||
-                            (other.v[e2] == v1 && other.v[(e2 + 1) % 3] == v0)) {
-                            shared = true;
-                            break;
-                        }
-                    }
-                    if (shared) break;
-                }
+Array GeometryOps::constrained_delaunay(const PackedVector2Array& boundary, const Array& holes) {
+    PackedVector2Array vertices;
+    PackedInt32Array triangles;
+    PackedInt32Array half_edges;
 
-                if (!shared) {
-                    polygon.push_back({v0, v1});
-                }
-            }
-        }
+    if (boundary.size() < 3) {
+        UtilityFunctions::push_error("AgentiteG: constrained_delaunay boundary needs at least 3 points");
+        return make_triangulation_result(vertices, triangles, half_edges);
+    }
 
-        // Remove bad triangles
-        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
-                                        [](const Triangle& t) { return t.bad; }),
-                        triangles.end());
+    // Each outline contributes its points and a closed loop of edges. A point
+    // already added (e.g. a corner shared by two holes) is welded onto the
+    // existing vertex so both outlines meet at one index.
+    std::vector<int32_t> edges;
+    std::map<std::pair<real_t, real_t>, int32_t> vertex_at;
+    std::vector<int32_t> loop;
+    auto add_outline = [&](const PackedVector2Array& outline) {
+        int32_t n = outline.size();
+        loop.resize(n);
+        for (int32_t i = 0; i < n; i++) {
+            auto inserted = vertex_at.emplace(std::make_pair(outline[i].x, outline[i].y), vertices.size());
+            if (inserted.second) vertices.push_back(outline[i]);
+            loop[i] = inserted.first->second;
+        }
+        for (int32_t i = 0; i < n; i++) {
+            int32_t a = loop[i];
+            int32_t b = loop[(i + 1) % n];
+            if (a == b) continue;
+            edges.push_back(a);
+            edges.push_back(b);
+        }
+    };
 
-        // Add new triangles
-        for (const auto& edge : polygon) {
-            triangles.push_back({edge.first, edge.second, i, false});
+    add_outline(boundary);
+    for (int64_t h = 0; h < holes.size(); h++) {
+        PackedVector2Array hole = holes[h];
+        if (hole.size() < 3) {
+            UtilityFunctions::push_error("AgentiteG: constrained_delaunay hole needs at least 3 points");
+            return make_triangulation_result(PackedVector2Array(), triangles, half_edges);
         }
+        add_outline(hole);
     }
 
-    // Remove triangles connected to super-triangle
-    for (const auto& tri : triangles) {
-        if (tri.v[0] >= n || tri.v[1] >= n || tri.v[2] >= n) {
-            continue;
-        }
-        result.push_back(tri.v[0]);
-        result.push_back(tri.v[1]);
-        result.push_back(tri.v[2]);
+    DelaunayTriangulation dt;
+    if (!dt.build_constrained(vertices.ptr(), vertices.size(), edges)) {
+        UtilityFunctions::push_error("AgentiteG: constrained_delaunay outlines must not cross each other");
+        return make_triangulation_result(PackedVector2Array(), triangles, half_edges);
     }
 
-    return result;
+    triangles.resize(dt.triangles.size());
+    std::copy(dt.triangles.begin(), dt.triangles.end(), triangles.ptrw());
+
+    // Walls (constrained edges) have no neighbor to walk into
+    half_edges.resize(dt.half_edges.size());
+    int32_t* he = half_edges.ptrw();
+    for (size_t e = 0; e < dt.half_edges.size(); e++) {
+        he[e] = dt.constrained[e] ? -1 : dt.half_edges[e];
+    }
+
+    return make_triangulation_result(vertices, triangles, half_edges);
 }
 
 // ========== VORONOI ==========
 
+// Minimum cells per chunk when Voronoi cells are clipped in parallel
+static const int64_t VORONOI_CHUNK = 64;
+
+// Helper: clip a convex cell to the half-plane on site's side of the bisector with other
+static void clip_to_bisector(std::vector<Vector2>& cell, std::vector<Vector2>& scratch,
+                             const Vector2& site, const Vector2& other) {
+    Vector2 mid((site.x + other.x) / 2, (site.y + other.y) / 2);
+    Vector2 normal(other.x - site.x, other.y - site.y);
+
+    scratch.clear();
+    for (size_t k = 0; k < cell.size(); k++) {
+        Vector2 a = cell[k];
+        Vector2 b = cell[(k + 1) % cell.size()];
+
+        float da = (a.x - mid.x) * normal.x + (a.y - mid.y) * normal.y;
+        float db = (b.x - mid.x) * normal.x + (b.y - mid.y) * normal.y;
+
+        if (da <= 0) {
+            scratch.push_back(a);
+        }
+
+        if ((da < 0 && db > 0) || (da > 0 && db < 0)) {
+            // Intersection
+            float t = da / (da - db);
+            scratch.push_back(Vector2(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)));
+        }
+    }
+    cell.swap(scratch);
+}
+
 Array GeometryOps::voronoi_cells(const PackedVector2Array& points, const Rect2& bounds) {
     Array result;
     int32_t n = points.size();
@@ -408,56 +421,89 @@ Array GeometryOps::voronoi_cells(const PackedVector2Array& points, const Rect2&
         return result;
     }
 
-    // Simple brute-force Voronoi using clipping
-    // For each point, compute its cell by intersecting half-planes
-
     const Vector2* p = points.ptr();
     Vector2 bounds_min = bounds.position;
     Vector2 bounds_max = bounds.position + bounds.size;
 
-    for (int32_t i = 0; i < n; i++) {
-        // Start with bounding box as cell
-        std::vector<Vector2> cell;
-        cell.push_back(Vector2(bounds_min.x, bounds_min.y));
-        cell.push_back(Vector2(bounds_max.x, bounds_min.y));
-        cell.push_back(Vector2(bounds_max.x, bounds_max.y));
-        cell.push_back(Vector2(bounds_min.x, bounds_max.y));
-
-        // Clip by half-plane for each other point
-        for (int32_t j = 0; j < n && cell.size() >= 3; j++) {
-            if (i == j) continue;
-
-            // Perpendicular bisector
-            Vector2 mid((p[i].x + p[j].x) / 2, (p[i].y + p[j].y) / 2);
-            Vector2 normal(p[j].x - p[i].x, p[j].y - p[i].y);
-
-            // Clip cell by half-plane (keep points on i's side)
-            std::vector<Vector2> new_cell;
-            for (size_t k = 0; k < cell.size(); k++) {
-                Vector2 a = cell[k];
-                Vector2 b = cell[(k + 1) % cell.size()];
-
-                float da = (a.x - mid.x) * normal.x + (a.y - mid.y) * normal.y;
-                float db = (b.x - mid.x) * normal.x + (b.y - mid.y) * normal.y;
-
-                if (da <= 0) {
-                    new_cell.push_back(a);
-                }
+    // Voronoi neighbors are exactly the Delaunay neighbors, so each cell is
+    // the bounds clipped by the bisectors of its triangulation edges
+    DelaunayTriangulation dt;
+    dt.build(p, n);
+
+    // Neighbor lists (CSR) from the half-edges; hull edges have no twin,
+    // so they are added in both directions
+    std::vector<int32_t> neighbor_start(n + 1, 0);
+    std::vector<int32_t> neighbors;
+    int32_t edge_count = static_cast<int32_t>(dt.triangles.size());
+    if (edge_count > 0) {
+        for (int32_t e = 0; e < edge_count; e++) {
+            neighbor_start[dt.triangles[e] + 1]++;
+            if (dt.half_edges[e] == -1) {
+                neighbor_start[dt.triangles[DelaunayTriangulation::next_half_edge(e)] + 1]++;
+            }
+        }
+        for (int32_t i = 0; i < n; i++) {
+            neighbor_start[i + 1] += neighbor_start[i];
+        }
+        neighbors.resize(neighbor_start[n]);
+        std::vector<int32_t> fill(neighbor_start.begin(), neighbor_start.end() - 1);
+        for (int32_t e = 0; e < edge_count; e++) {
+            int32_t a = dt.triangles[e];
+            int32_t b = dt.triangles[DelaunayTriangulation::next_half_edge(e)];
+            neighbors[fill[a]++] = b;
+            if (dt.half_edges[e] == -1) {
+                neighbors[fill[b]++] = a;
+            }
+        }
+    } else {
+        // Collinear points: neighbors are the adjacent points along the line
+        int32_t hull_size = static_cast<int32_t>(dt.hull.size());
+        for (int32_t k = 0; k < hull_size; k++) {
+            int32_t id = dt.hull[k];
+            neighbor_start[id + 1] = (k > 0 ? 1 : 0) + (k + 1 < hull_size ? 1 : 0);
+        }
+        for (int32_t i = 0; i < n; i++) {
+            neighbor_start[i + 1] += neighbor_start[i];
+        }
+        neighbors.resize(neighbor_start[n]);
+        for (int32_t k = 0; k < hull_size; k++) {
+            int32_t slot = neighbor_start[dt.hull[k]];
+            if (k > 0) neighbors[slot++] = dt.hull[k - 1];
+            if (k + 1 < hull_size) neighbors[slot] = dt.hull[k + 1];
+        }
+    }
 
-                if ((da < 0 && db > 0) || (da > 0 && db < 0)) {
-                    // Intersection
-                    float t = da / (da - db);
-                    new_cell.push_back(Vector2(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)));
+    std::vector<std::vector<Vector2>> cells(n);
+    parallel::for_range(n, VORONOI_CHUNK, [&](int64_t begin, int64_t end) {
+        std::vector<Vector2> scratch;
+        for (int64_t i = begin; i < end; i++) {
+            // Start with bounding box as cell
+            std::vector<Vector2>& cell = cells[i];
+            cell.push_back(Vector2(bounds_min.x, bounds_min.y));
+            cell.push_back(Vector2(bounds_max.x, bounds_min.y));
+            cell.push_back(Vector2(bounds_max.x, bounds_max.y));
+            cell.push_back(Vector2(bounds_min.x, bounds_max.y));
+
+            // Duplicates share the cell of the point they repeat
+            int32_t site = dt.representative[i];
+            if (site != -1) {
+                for (int32_t k = neighbor_start[site]; k < neighbor_start[site + 1] && cell.size() >= 3; k++) {
+                    clip_to_bisector(cell, scratch, p[i], p[neighbors[k]]);
+                }
+            } else {
+                // Dropped as degenerate: clip against every other point
+                for (int32_t j = 0; j < n && cell.size() >= 3; j++) {
+                    if (j == i) continue;
+                    clip_to_bisector(cell, scratch, p[i], p[j]);
                 }
             }
-            cell = new_cell;
         }
+    });
 
+    for (int32_t i = 0; i < n; i++) {
         PackedVector2Array cell_array;
-        cell_array.resize(cell.size());
-        for (size_t k = 0; k < cell.size(); k++) {
-            cell_array[k] = cell[k];
-        }
+        cell_array.resize(cells[i].size());
+        std::copy(cells[i].begin(), cells[i].end(), cell_array.ptrw());
         result.push_back(cell_array);
     }
 
@@ -52,13 +52,28 @@ public:
     // Returns indices [i0, i1, i2, i3, i4, i5, ...] forming triangles
     static PackedInt32Array triangulate(const PackedVector2Array& polygon);
 
-    // Delaunay triangulation of a point set
+    // Delaunay triangulation of a point set (sweep-hull, O(n log n))
     // Returns indices [i0, i1, i2, ...] forming triangles
     static PackedInt32Array delaunay(const PackedVector2Array& points);
 
+    // Delaunay triangulation with adjacency
+    // Returns [triangles: PackedInt32Array, half_edges: PackedInt32Array]
+    // Half-edge e runs from triangles[e] to the next corner of triangle e / 3;
+    // half_edges[e] is the opposite half-edge in the neighboring triangle, or -1 on the hull
+    static Array delaunay_half_edges(const PackedVector2Array& points);
+
+    // Constrained Delaunay triangulation of a boundary polygon with holes
+    // (Array of PackedVector2Array). Every outline edge is an edge of the result
+    // and only triangles inside the boundary and outside the holes are kept.
+    // Returns [vertices: PackedVector2Array, triangles: PackedInt32Array, half_edges: PackedInt32Array]
+    // Vertices are the boundary points followed by each hole's points;
+    // half_edges[e] is -1 where the triangle borders a wall
+    static Array constrained_delaunay(const PackedVector2Array& boundary, const Array& holes = Array());
+
     // ========== VORONOI ==========
 
     // Returns Array of PackedVector2Array, one polygon per input point
+    // Each cell is clipped only against its Delaunay neighbors
     static Array voronoi_cells(const PackedVector2Array& points, const Rect2& bounds);
 
     // Returns edges as flat array [x1, y1, x2, y2, ...]
@@ -0,0 +1,96 @@
+/**
+ * ComponentLabeling - Two-pass union-find labeling shared by GridOps and ConnectedComponents
+ *
+ * Labels the 4-connected components of cells equal to target_value in one
+ * scan plus one relabel pass, instead of a flood fill per component. The
+ * first pass gives each cell the provisional label of its left or upper
+ * neighbour and records equivalences in a union-find; the second pass maps
+ * every provisional label to its final one. Final labels are numbered 1, 2,
+ * ... in order of each component's first cell in row-major order, which is
+ * the order a scanning flood fill finds them in.
+ *
+ * Usage (internal):
+ *   std::vector<int32_t> sizes;
+ *   int32_t count = component_labeling::label(grid, width, height, FLOOR, labels, sizes);
+ */
+
+#ifndef AGENTITE_COMPONENT_LABELING_HPP
+#define AGENTITE_COMPONENT_LABELING_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+namespace component_labeling {
+
+// Root of a provisional label (path halving)
+inline int32_t find_root(std::vector<int32_t>& parent, int32_t label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+// Write component labels (0 = not target_value) for every cell and the size
+// of each component to sizes[label - 1]. Returns the number of components.
+inline int32_t label(const int32_t* grid, int width, int height, int target_value,
+                     int32_t* labels, std::vector<int32_t>& sizes) {
+    sizes.clear();
+    if (width <= 0 || height <= 0) return 0;
+
+    // Pass 1: provisional labels; the lower label of two equivalent ones is kept as root,
+    // so every root is the label its component's first cell received
+    std::vector<int32_t> parent(1, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int64_t i = static_cast<int64_t>(y) * width + x;
+            if (grid[i] != target_value) {
+                labels[i] = 0;
+                continue;
+            }
+
+            int32_t left = x > 0 ? labels[i - 1] : 0;
+            int32_t up = y > 0 ? labels[i - width] : 0;
+            if (left == 0 && up == 0) {
+                int32_t fresh = static_cast<int32_t>(parent.size());
+                parent.push_back(fresh);
+                labels[i] = fresh;
+            } else if (up == 0) {
+                labels[i] = left;
+            } else if (left == 0) {
+                labels[i] = up;
+            } else {
+                labels[i] = left;
+                int32_t a = find_root(parent, left);
+                int32_t b = find_root(parent, up);
+                if (a < b) {
+                    parent[b] = a;
+                } else if (b < a) {
+                    parent[a] = b;
+                }
+            }
+        }
+    }
+
+    // Pass 2: final labels in order of first appearance
+    std::vector<int32_t> final_label(parent.size(), 0);
+    int32_t count = 0;
+    int64_t size = static_cast<int64_t>(width) * height;
+    for (int64_t i = 0; i < size; i++) {
+        if (labels[i] == 0) continue;
+        int32_t root = find_root(parent, labels[i]);
+        if (final_label[root] == 0) {
+            final_label[root] = ++count;
+            sizes.push_back(0);
+        }
+        labels[i] = final_label[root];
+        sizes[labels[i] - 1]++;
+    }
+    return count;
+}
+
+}
+}
+
+#endif // AGENTITE_COMPONENT_LABELING_HPP
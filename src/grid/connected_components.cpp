@@ -0,0 +1,422 @@
+/**
+ * ConnectedComponents Implementation
+ */
+
+#include "connected_components.hpp"
+#include "component_labeling.hpp"
+#include "core/snapshot.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+// A removed cell has at most 4 neighbours, so at most 4 fills run at once
+static const int MAX_FILLS = 4;
+
+// Snapshot layout (bump SNAPSHOT_VERSION when it changes)
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotTag : uint32_t {
+    TAG_INFO = 1,
+    TAG_LABELS = 2,
+    TAG_SIZES = 3,
+    TAG_FREE_LABELS = 4,
+};
+
+struct SnapshotInfo {
+    int32_t width;
+    int32_t height;
+    int32_t target_value;
+    int32_t component_count;
+};
+
+void ConnectedComponents::_bind_methods() {
+    // Grid
+    ClassDB::bind_method(D_METHOD("set_grid", "grid", "width", "height", "target_value"), &ConnectedComponents::set_grid);
+    ClassDB::bind_method(D_METHOD("update_cells", "grid", "cells"), &ConnectedComponents::update_cells);
+    ClassDB::bind_method(D_METHOD("clear"), &ConnectedComponents::clear);
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &ConnectedComponents::save_snapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "data"), &ConnectedComponents::load_snapshot);
+
+    // Queries
+    ClassDB::bind_method(D_METHOD("get_labels"), &ConnectedComponents::get_labels);
+    ClassDB::bind_method(D_METHOD("get_label", "cell"), &ConnectedComponents::get_label);
+    ClassDB::bind_method(D_METHOD("get_component_size", "label"), &ConnectedComponents::get_component_size);
+    ClassDB::bind_method(D_METHOD("get_component_count"), &ConnectedComponents::get_component_count);
+    ClassDB::bind_method(D_METHOD("get_component_labels"), &ConnectedComponents::get_component_labels);
+    ClassDB::bind_method(D_METHOD("are_connected", "a", "b"), &ConnectedComponents::are_connected);
+}
+
+ConnectedComponents::ConnectedComponents() {
+}
+
+ConnectedComponents::~ConnectedComponents() {
+}
+
+// ========== GRID ==========
+
+void ConnectedComponents::set_grid(const PackedInt32Array& grid, int32_t p_width, int32_t p_height, int32_t p_target_value) {
+    if (p_width <= 0 || p_height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: ConnectedComponents width and height must be positive");
+        return;
+    }
+    if (grid.size() < static_cast<int64_t>(p_width) * p_height) {
+        UtilityFunctions::push_error("AgentiteG: ConnectedComponents grid array is smaller than width * height");
+        return;
+    }
+
+    width = p_width;
+    height = p_height;
+    target_value = p_target_value;
+
+    int64_t cell_count = static_cast<int64_t>(width) * height;
+    labels.resize(cell_count);
+    std::vector<int32_t> component_sizes;
+    component_count = component_labeling::label(grid.ptr(), width, height, target_value, labels.ptrw(), component_sizes);
+
+    sizes.assign(1, 0);
+    sizes.insert(sizes.end(), component_sizes.begin(), component_sizes.end());
+    free_labels.clear();
+
+    visit_epoch.assign(cell_count, 0);
+    visit_fill.assign(cell_count, 0);
+    epoch = 0;
+}
+
+void ConnectedComponents::update_cells(const PackedInt32Array& grid, const PackedInt32Array& cells) {
+    if (width == 0) {
+        UtilityFunctions::push_error("AgentiteG: ConnectedComponents needs set_grid before update_cells");
+        return;
+    }
+    int64_t cell_count = static_cast<int64_t>(width) * height;
+    if (grid.size() < cell_count) {
+        UtilityFunctions::push_error("AgentiteG: ConnectedComponents grid array is smaller than width * height");
+        return;
+    }
+
+    const int32_t* grid_ptr = grid.ptr();
+    const int32_t* cells_ptr = cells.ptr();
+    int32_t* label_ptr = labels.ptrw();
+
+    for (int64_t k = 0; k < cells.size(); k++) {
+        int32_t cell = cells_ptr[k];
+        if (cell < 0 || cell >= cell_count) continue;
+
+        bool now = grid_ptr[cell] == target_value;
+        bool was = label_ptr[cell] != 0;
+        if (now && !was) {
+            add_cell(label_ptr, cell);
+        } else if (!now && was) {
+            remove_cell(label_ptr, cell);
+        }
+    }
+}
+
+void ConnectedComponents::clear() {
+    width = 0;
+    height = 0;
+    labels = PackedInt32Array();
+    sizes.clear();
+    free_labels.clear();
+    component_count = 0;
+    visit_epoch.clear();
+    visit_fill.clear();
+    epoch = 0;
+}
+
+// ========== SNAPSHOTS ==========
+
+PackedByteArray ConnectedComponents::save_snapshot() const {
+    SnapshotInfo info;
+    info.width = width;
+    info.height = height;
+    info.target_value = target_value;
+    info.component_count = component_count;
+
+    snapshot::Writer w(snapshot::KIND_CONNECTED_COMPONENTS, SNAPSHOT_VERSION);
+    w.add_value(TAG_INFO, info);
+    w.add(TAG_LABELS, labels.ptr(), labels.size());
+    w.add(TAG_SIZES, sizes);
+    w.add(TAG_FREE_LABELS, free_labels);
+    return w.finish();
+}
+
+bool ConnectedComponents::load_snapshot(const PackedByteArray& data) {
+    snapshot::Reader r;
+    if (!r.open(data, snapshot::KIND_CONNECTED_COMPONENTS, SNAPSHOT_VERSION, "ConnectedComponents")) {
+        return false;
+    }
+
+    SnapshotInfo info;
+    PackedInt32Array new_labels;
+    std::vector<int32_t> new_sizes;
+    std::vector<int32_t> new_free;
+    if (!r.read_value(TAG_INFO, info) || !r.read_packed<int32_t>(TAG_LABELS, new_labels) ||
+        !r.read(TAG_SIZES, new_sizes) || !r.read(TAG_FREE_LABELS, new_free)) {
+        return false;
+    }
+    int64_t cell_count = static_cast<int64_t>(info.width) * info.height;
+    if (info.width < 0 || info.height < 0 || (info.width == 0) != (info.height == 0) ||
+        new_labels.size() != cell_count) {
+        return r.fail("grid settings are invalid");
+    }
+    if (info.width == 0) {
+        clear();
+        target_value = info.target_value;
+        return true;
+    }
+
+    // Sizes must match the labels exactly; updates trust them to find the smaller side of a merge
+    int32_t label_count = static_cast<int32_t>(new_sizes.size());
+    std::vector<int32_t> counted(std::max(label_count, 1), 0);
+    const int32_t* label_ptr = new_labels.ptr();
+    for (int64_t i = 0; i < cell_count; i++) {
+        if (label_ptr[i] < 0 || label_ptr[i] >= label_count) {
+            return r.fail("labels are out of range");
+        }
+        counted[label_ptr[i]]++;
+    }
+    int32_t used = 0;
+    for (int32_t l = 1; l < label_count; l++) {
+        if (counted[l] != new_sizes[l]) return r.fail("component sizes don't match the labels");
+        used += new_sizes[l] > 0 ? 1 : 0;
+    }
+    if (label_count == 0 || new_sizes[0] != 0 || used != info.component_count ||
+        static_cast<int32_t>(new_free.size()) != label_count - 1 - used) {
+        return r.fail("component sizes don't match the labels");
+    }
+    // Each unused id must be free exactly once
+    for (int32_t l : new_free) {
+        if (l <= 0 || l >= label_count || new_sizes[l] != 0 || counted[l] < 0) return r.fail("free labels are invalid");
+        counted[l] = -1;
+    }
+
+    width = info.width;
+    height = info.height;
+    target_value = info.target_value;
+    component_count = info.component_count;
+    labels = new_labels;
+    sizes.swap(new_sizes);
+    free_labels.swap(new_free);
+    visit_epoch.assign(cell_count, 0);
+    visit_fill.assign(cell_count, 0);
+    epoch = 0;
+    return true;
+}
+
+// ========== LABELS ==========
+
+int32_t ConnectedComponents::new_label() {
+    component_count++;
+    if (!free_labels.empty()) {
+        int32_t label = free_labels.back();
+        free_labels.pop_back();
+        return label;
+    }
+    sizes.push_back(0);
+    return static_cast<int32_t>(sizes.size()) - 1;
+}
+
+void ConnectedComponents::free_label(int32_t label) {
+    sizes[label] = 0;
+    free_labels.push_back(label);
+    component_count--;
+}
+
+int32_t ConnectedComponents::neighbors(int32_t cell, int32_t* out) const {
+    int32_t x = cell % width;
+    int32_t y = cell / width;
+    int32_t count = 0;
+    if (y > 0) out[count++] = cell - width;
+    if (x < width - 1) out[count++] = cell + 1;
+    if (y < height - 1) out[count++] = cell + width;
+    if (x > 0) out[count++] = cell - 1;
+    return count;
+}
+
+// Flood fill the component of start from label `from` to label `to`
+void ConnectedComponents::relabel(int32_t* label_ptr, int32_t start, int32_t from, int32_t to) {
+    std::vector<int32_t> stack;
+    stack.push_back(start);
+    label_ptr[start] = to;
+    while (!stack.empty()) {
+        int32_t cell = stack.back();
+        stack.pop_back();
+        int32_t adjacent[4];
+        int32_t n = neighbors(cell, adjacent);
+        for (int32_t j = 0; j < n; j++) {
+            if (label_ptr[adjacent[j]] == from) {
+                label_ptr[adjacent[j]] = to;
+                stack.push_back(adjacent[j]);
+            }
+        }
+    }
+}
+
+void ConnectedComponents::add_cell(int32_t* label_ptr, int32_t cell) {
+    int32_t adjacent[4];
+    int32_t n = neighbors(cell, adjacent);
+
+    // Join the largest neighbouring component, then merge the others into it
+    int32_t best = 0;
+    for (int32_t j = 0; j < n; j++) {
+        int32_t label = label_ptr[adjacent[j]];
+        if (label != 0 && (best == 0 || sizes[label] > sizes[best])) {
+            best = label;
+        }
+    }
+    if (best == 0) {
+        best = new_label();
+    }
+    label_ptr[cell] = best;
+    sizes[best]++;
+
+    for (int32_t j = 0; j < n; j++) {
+        int32_t label = label_ptr[adjacent[j]];
+        if (label != 0 && label != best) {
+            sizes[best] += sizes[label];
+            relabel(label_ptr, adjacent[j], label, best);
+            free_label(label);
+        }
+    }
+}
+
+void ConnectedComponents::remove_cell(int32_t* label_ptr, int32_t cell) {
+    int32_t label = label_ptr[cell];
+    label_ptr[cell] = 0;
+    if (--sizes[label] == 0) {
+        free_label(label);
+        return;
+    }
+
+    int32_t adjacent[4];
+    int32_t n = neighbors(cell, adjacent);
+    int32_t seeds[MAX_FILLS];
+    int32_t fill_count = 0;
+    for (int32_t j = 0; j < n; j++) {
+        if (label_ptr[adjacent[j]] == label) {
+            seeds[fill_count++] = adjacent[j];
+        }
+    }
+    // With one neighbour left in the component, no path ran through the cell
+    if (fill_count <= 1) return;
+
+    if (++epoch == 0) {
+        std::fill(visit_epoch.begin(), visit_epoch.end(), 0);
+        epoch = 1;
+    }
+
+    // One fill per neighbour; fills that meet are joined in a tiny union-find
+    std::vector<int32_t> fills[MAX_FILLS];
+    size_t heads[MAX_FILLS] = {0, 0, 0, 0};
+    int32_t group[MAX_FILLS];
+    bool retired[MAX_FILLS] = {false, false, false, false};
+    for (int32_t f = 0; f < fill_count; f++) {
+        fills[f].push_back(seeds[f]);
+        visit_epoch[seeds[f]] = epoch;
+        visit_fill[seeds[f]] = static_cast<uint8_t>(f);
+        group[f] = f;
+    }
+    auto root = [&](int32_t f) {
+        while (group[f] != f) f = group[f];
+        return f;
+    };
+
+    while (true) {
+        // A group whose fills all ran out is a piece that broke off,
+        // unless it is the only group left
+        int32_t live_groups = 0;
+        int32_t finished = -1;
+        for (int32_t f = 0; f < fill_count; f++) {
+            if (retired[f] || root(f) != f) continue;
+            live_groups++;
+            bool exhausted = true;
+            for (int32_t g = 0; g < fill_count; g++) {
+                if (root(g) == f && heads[g] < fills[g].size()) exhausted = false;
+            }
+            if (exhausted && finished == -1) finished = f;
+        }
+        if (live_groups <= 1) return;
+
+        if (finished != -1) {
+            int32_t piece = new_label();
+            for (int32_t g = 0; g < fill_count; g++) {
+                if (retired[g] || root(g) != finished) continue;
+                for (int32_t c : fills[g]) {
+                    label_ptr[c] = piece;
+                }
+                sizes[piece] += static_cast<int32_t>(fills[g].size());
+                sizes[label] -= static_cast<int32_t>(fills[g].size());
+                retired[g] = true;
+            }
+            continue;
+        }
+
+        // Advance every fill by one cell
+        for (int32_t f = 0; f < fill_count; f++) {
+            if (retired[f] || heads[f] >= fills[f].size()) continue;
+            int32_t current = fills[f][heads[f]++];
+            int32_t next[4];
+            int32_t m = neighbors(current, next);
+            for (int32_t j = 0; j < m; j++) {
+                int32_t c = next[j];
+                if (label_ptr[c] != label) continue;
+                if (visit_epoch[c] != epoch) {
+                    visit_epoch[c] = epoch;
+                    visit_fill[c] = static_cast<uint8_t>(f);
+                    fills[f].push_back(c);
+                } else {
+                    int32_t a = root(f);
+                    int32_t b = root(visit_fill[c]);
+                    if (a != b) group[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    }
+}
+
+// ========== QUERIES ==========
+
+PackedInt32Array ConnectedComponents::get_labels() const {
+    return labels;
+}
+
+int32_t ConnectedComponents::get_label(const Vector2i& cell) const {
+    if (cell.x < 0 || cell.x >= width || cell.y < 0 || cell.y >= height) {
+        return 0;
+    }
+    return labels[cell.y * width + cell.x];
+}
+
+int32_t ConnectedComponents::get_component_size(int32_t label) const {
+    if (label <= 0 || label >= static_cast<int32_t>(sizes.size())) {
+        return 0;
+    }
+    return sizes[label];
+}
+
+int32_t ConnectedComponents::get_component_count() const {
+    return component_count;
+}
+
+PackedInt32Array ConnectedComponents::get_component_labels() const {
+    PackedInt32Array result;
+    result.resize(component_count);
+    int32_t* dst = result.ptrw();
+    for (size_t label = 1; label < sizes.size(); label++) {
+        if (sizes[label] > 0) {
+            *dst++ = static_cast<int32_t>(label);
+        }
+    }
+    return result;
+}
+
+bool ConnectedComponents::are_connected(const Vector2i& a, const Vector2i& b) const {
+    int32_t label = get_label(a);
+    return label != 0 && label == get_label(b);
+}
+
+}
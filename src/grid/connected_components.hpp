@@ -0,0 +1,114 @@
+/**
+ * ConnectedComponents - Component labels kept up to date as grid cells change
+ *
+ * Labels the 4-connected components of cells equal to target_value once,
+ * then updates the labels incrementally when cells are added or removed:
+ * - An added cell joins its neighbours' component; several neighbouring
+ *   components are merged by relabeling the smaller ones.
+ * - A removed cell can split its component. A flood fill starts from each
+ *   of its neighbours, all advancing in lockstep; fills that meet are
+ *   merged, and a fill that runs out of cells before the others is a piece
+ *   that broke off and gets a new label. The largest piece is not walked
+ *   to the end, so eroding a big island costs about the size of what broke
+ *   off, not the island.
+ *
+ * Right after set_grid() labels match GridOps.label_connected_components
+ * (1, 2, ... in row-major order). Later labels are stable ids: a component
+ * keeps its label while it grows, shrinks or loses pieces, and new ids are
+ * handed out for pieces that break off. Freed ids are reused.
+ *
+ * Usage:
+ *   var islands = ConnectedComponents.new()
+ *   islands.set_grid(terrain, width, height, LAND)
+ *
+ *   # Terrain destroyed
+ *   terrain[cell_index] = WATER
+ *   islands.update_cells(terrain, PackedInt32Array([cell_index]))
+ *   if not islands.are_connected(base_cell, outpost_cell):
+ *       outpost.cut_off()
+ */
+
+#ifndef AGENTITE_CONNECTED_COMPONENTS_HPP
+#define AGENTITE_CONNECTED_COMPONENTS_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class ConnectedComponents : public RefCounted {
+    GDCLASS(ConnectedComponents, RefCounted)
+
+private:
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t target_value = 1;
+
+    PackedInt32Array labels;            // 0 = not a target cell
+    std::vector<int32_t> sizes;         // Cells per label (index 0 unused), 0 = free id
+    std::vector<int32_t> free_labels;
+    int32_t component_count = 0;
+
+    // Split search state, reused between removals
+    std::vector<uint32_t> visit_epoch;  // Search that last reached each cell
+    std::vector<uint8_t> visit_fill;    // Fill within that search
+    uint32_t epoch = 0;
+
+    int32_t new_label();
+    void free_label(int32_t label);
+    int32_t neighbors(int32_t cell, int32_t* out) const;
+    void relabel(int32_t* label_ptr, int32_t start, int32_t from, int32_t to);
+    void add_cell(int32_t* label_ptr, int32_t cell);
+    void remove_cell(int32_t* label_ptr, int32_t cell);
+
+protected:
+    static void _bind_methods();
+
+public:
+    ConnectedComponents();
+    ~ConnectedComponents();
+
+    // Label the grid from scratch (cells equal to target_value are connected)
+    void set_grid(const PackedInt32Array& grid, int32_t p_width, int32_t p_height, int32_t p_target_value);
+
+    // Update labels after the listed cells changed in grid
+    // Cells not listed are assumed unchanged since the last call
+    void update_cells(const PackedInt32Array& grid, const PackedInt32Array& cells);
+
+    // Label of every cell (0 = not a target cell)
+    PackedInt32Array get_labels() const;
+
+    // Label of one cell (0 if it is not a target cell or outside the grid)
+    int32_t get_label(const Vector2i& cell) const;
+
+    // Number of cells with label (0 for unused labels)
+    int32_t get_component_size(int32_t label) const;
+
+    // Number of components
+    int32_t get_component_count() const;
+
+    // Labels currently in use, ascending
+    PackedInt32Array get_component_labels() const;
+
+    // True if both cells are target cells in the same component
+    bool are_connected(const Vector2i& a, const Vector2i& b) const;
+
+    // Remove the grid and all labels
+    void clear();
+
+    // Save the labels and component ids as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the labels with a saved snapshot, without relabeling the grid
+    // Returns false (and keeps the current labels) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+};
+
+}
+
+#endif // AGENTITE_CONNECTED_COMPONENTS_HPP
@@ -3,17 +3,30 @@
  */
 
 #include "grid_ops.hpp"
+#include "component_labeling.hpp"
+#include "shadowcast.hpp"
+#include "core/parallel.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <queue>
 #include <vector>
 #include <unordered_set>
 
 namespace godot {
 
+// Observers per chunk for fov_shadowcast_multi (each casts a whole FOV)
+static const int64_t FOV_CHUNK = 4;
+
+// Columns, rows and cells per chunk for the Euclidean distance transform
+static const int64_t EDT_COLUMN_CHUNK = 64;
+static const int64_t EDT_ROW_CHUNK = 16;
+static const int64_t EDT_CONVERT_CHUNK = 16384;
+
 void GridOps::_bind_methods() {
     // Coordinate conversion
     ClassDB::bind_static_method("GridOps", D_METHOD("to_index", "x", "y", "width"), &GridOps::to_index);
@@ -40,20 +53,24 @@ void GridOps::_bind_methods() {
     ClassDB::bind_static_method("GridOps", D_METHOD("line_clear", "grid", "width", "from", "to", "blocking_value"), &GridOps::line_clear);
     ClassDB::bind_static_method("GridOps", D_METHOD("raycast_grid", "grid", "width", "from", "direction", "max_distance", "blocking_value"), &GridOps::raycast_grid);
     ClassDB::bind_static_method("GridOps", D_METHOD("line_first_blocking", "grid", "width", "from", "to", "blocking_value"), &GridOps::line_first_blocking);
+    ClassDB::bind_static_method("GridOps", D_METHOD("raycast_grid_batch", "grid", "width", "height", "origins", "directions", "max_distances", "blocking_value"), &GridOps::raycast_grid_batch);
 
     // Field of view
     ClassDB::bind_static_method("GridOps", D_METHOD("fov_shadowcast", "grid", "width", "height", "origin", "radius", "blocking_value"), &GridOps::fov_shadowcast);
+    ClassDB::bind_static_method("GridOps", D_METHOD("fov_shadowcast_multi", "grid", "width", "height", "origins", "radii", "blocking_value"), &GridOps::fov_shadowcast_multi);
     ClassDB::bind_static_method("GridOps", D_METHOD("fov_raycast", "grid", "width", "height", "origin", "radius", "blocking_value", "ray_count"), &GridOps::fov_raycast);
 
     // Distance transforms
     ClassDB::bind_static_method("GridOps", D_METHOD("manhattan_distance_field", "grid", "width", "height", "target_value"), &GridOps::manhattan_distance_field);
     ClassDB::bind_static_method("GridOps", D_METHOD("chebyshev_distance_field", "grid", "width", "height", "target_value"), &GridOps::chebyshev_distance_field);
     ClassDB::bind_static_method("GridOps", D_METHOD("euclidean_distance_field", "grid", "width", "height", "target_value"), &GridOps::euclidean_distance_field);
+    ClassDB::bind_static_method("GridOps", D_METHOD("euclidean_distance_field_squared", "grid", "width", "height", "target_value"), &GridOps::euclidean_distance_field_squared);
 
     // Connected components
     ClassDB::bind_static_method("GridOps", D_METHOD("label_connected_components", "grid", "width", "height", "target_value"), &GridOps::label_connected_components);
     ClassDB::bind_static_method("GridOps", D_METHOD("count_connected_components", "grid", "width", "height", "target_value"), &GridOps::count_connected_components);
     ClassDB::bind_static_method("GridOps", D_METHOD("component_sizes", "grid", "width", "height", "target_value"), &GridOps::component_sizes);
+    ClassDB::bind_static_method("GridOps", D_METHOD("label_components_with_sizes", "grid", "width", "height", "target_value"), &GridOps::label_components_with_sizes);
 
     // Utilities
     ClassDB::bind_static_method("GridOps", D_METHOD("find_value", "grid", "value"), &GridOps::find_value);
@@ -463,85 +480,179 @@ int GridOps::line_first_blocking(const PackedInt32Array& grid, int width, const
     return -1;
 }
 
-// ========== FIELD OF VIEW (SHADOWCASTING) ==========
+// Walk the cells along one ray (Amanatides-Woo DDA) until a blocking cell
+// is entered. Returns its index, or -1, and sets hit_distance.
+static int32_t dda_first_blocking(const int32_t* grid, int width, int height,
+                                  const Vector2& origin, const Vector2& direction, float max_distance,
+                                  int blocking_value, float& hit_distance) {
+    const float INF = std::numeric_limits<float>::infinity();
+    hit_distance = INF;
+
+    float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (len <= 0.0f) return -1;
+    const float o[2] = {static_cast<float>(origin.x), static_cast<float>(origin.y)};
+    const float d[2] = {static_cast<float>(direction.x / len), static_cast<float>(direction.y / len)};
+    const int size[2] = {width, height};
+
+    // Clip the ray to the grid rectangle (slab test)
+    float t_enter = 0.0f;
+    float t_exit = max_distance;
+    for (int a = 0; a < 2; a++) {
+        if (d[a] == 0.0f) {
+            if (o[a] < 0.0f || o[a] >= size[a]) return -1;
+            continue;
+        }
+        float t1 = (0.0f - o[a]) / d[a];
+        float t2 = (size[a] - o[a]) / d[a];
+        t_enter = std::fmax(t_enter, std::fmin(t1, t2));
+        t_exit = std::fmin(t_exit, std::fmax(t1, t2));
+    }
+    if (t_enter > t_exit) return -1;
+
+    // The origin's own cell is skipped; a ray from outside the grid can be
+    // blocked by the first cell it enters
+    bool skip_first = o[0] >= 0.0f && o[0] < width && o[1] >= 0.0f && o[1] < height;
+
+    int cell[2];
+    int step[2];
+    float t_next[2];
+    float t_delta[2];
+    for (int a = 0; a < 2; a++) {
+        float p = o[a] + d[a] * t_enter;
+        cell[a] = std::min(std::max(static_cast<int>(std::floor(p)), 0), size[a] - 1);
+        if (d[a] > 0.0f) {
+            step[a] = 1;
+            t_next[a] = (cell[a] + 1 - o[a]) / d[a];
+            t_delta[a] = 1.0f / d[a];
+        } else if (d[a] < 0.0f) {
+            step[a] = -1;
+            t_next[a] = (cell[a] - o[a]) / d[a];
+            t_delta[a] = -1.0f / d[a];
+        } else {
+            step[a] = 0;
+            t_next[a] = INF;
+            t_delta[a] = INF;
+        }
+    }
 
-void GridOps::cast_light(const PackedInt32Array& grid, int width, int height,
-                        PackedInt32Array& visible, const Vector2i& origin, int radius,
-                        int blocking_value, int row, float start_slope, float end_slope,
-                        int xx, int xy, int yx, int yy) {
-    if (start_slope < end_slope) return;
+    float t = t_enter;
+    while (true) {
+        if (!skip_first && grid[cell[1] * width + cell[0]] == blocking_value) {
+            hit_distance = t;
+            return cell[1] * width + cell[0];
+        }
+        skip_first = false;
+
+        int a = t_next[0] <= t_next[1] ? 0 : 1;
+        t = t_next[a];
+        if (t > t_exit) return -1;
+        cell[a] += step[a];
+        if (cell[a] < 0 || cell[a] >= size[a]) return -1;
+        t_next[a] += t_delta[a];
+    }
+}
 
-    const int32_t* grid_ptr = grid.ptr();
-    float next_start_slope = start_slope;
-    int radius_sq = radius * radius;
-
-    for (int i = row; i <= radius; i++) {
-        bool blocked = false;
-        for (int dx = -i, dy = -i; dx <= 0; dx++) {
-            // Translate from octant coordinates to actual coordinates
-            int ax = origin.x + dx * xx + dy * xy;
-            int ay = origin.y + dx * yx + dy * yy;
-
-            float l_slope = (dx - 0.5f) / (dy + 0.5f);
-            float r_slope = (dx + 0.5f) / (dy - 0.5f);
-
-            if (start_slope < r_slope) continue;
-            if (end_slope > l_slope) break;
-
-            // Check if in bounds and within radius
-            int dist_sq = dx * dx + dy * dy;
-            if (dist_sq <= radius_sq && ax >= 0 && ax < width && ay >= 0 && ay < height) {
-                int idx = ay * width + ax;
-                visible.append(idx);
-            }
+Array GridOps::raycast_grid_batch(const PackedInt32Array& grid, int width, int height,
+                                  const PackedVector2Array& origins, const PackedVector2Array& directions,
+                                  const PackedFloat32Array& max_distances, int blocking_value) {
+    Array result;
+    if (width <= 0 || height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: raycast_grid_batch width and height must be positive");
+        return result;
+    }
+    if (grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: raycast_grid_batch grid array is smaller than width * height");
+        return result;
+    }
+    int32_t ray_count = origins.size();
+    if (directions.size() != ray_count || max_distances.size() != ray_count) {
+        UtilityFunctions::push_error("AgentiteG: origins, directions and max_distances arrays must have same size");
+        return result;
+    }
 
-            if (blocked) {
-                if (ax < 0 || ax >= width || ay < 0 || ay >= height ||
-                    grid_ptr[ay * width + ax] == blocking_value) {
-                    next_start_slope = r_slope;
-                    continue;
-                } else {
-                    blocked = false;
-                    start_slope = next_start_slope;
-                }
-            } else {
-                if (ax >= 0 && ax < width && ay >= 0 && ay < height &&
-                    grid_ptr[ay * width + ax] == blocking_value && i < radius) {
-                    blocked = true;
-                    cast_light(grid, width, height, visible, origin, radius, blocking_value,
-                              i + 1, start_slope, l_slope, xx, xy, yx, yy);
-                    next_start_slope = r_slope;
-                }
-            }
+    PackedInt32Array cells;
+    PackedFloat32Array distances;
+    cells.resize(ray_count);
+    distances.resize(ray_count);
+
+    const int32_t* grid_ptr = grid.ptr();
+    const Vector2* origins_ptr = origins.ptr();
+    const Vector2* directions_ptr = directions.ptr();
+    const float* max_ptr = max_distances.ptr();
+    int32_t* cells_ptr = cells.ptrw();
+    float* distances_ptr = distances.ptrw();
+
+    // Rays only read the grid, so large batches run across worker threads
+    parallel::for_range(ray_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            cells_ptr[i] = dda_first_blocking(grid_ptr, width, height, origins_ptr[i], directions_ptr[i],
+                                              max_ptr[i], blocking_value, distances_ptr[i]);
         }
-        if (blocked) break;
-    }
+    });
+
+    result.append(cells);
+    result.append(distances);
+    return result;
 }
 
+// ========== FIELD OF VIEW (SHADOWCASTING) ==========
+
 PackedInt32Array GridOps::fov_shadowcast(const PackedInt32Array& grid, int width, int height,
                                          const Vector2i& origin, int radius, int blocking_value) {
+    std::vector<int32_t> cells;
+    shadowcast::for_each_visible(grid.ptr(), width, height, origin.x, origin.y, radius, blocking_value,
+                                 [&](int32_t index) { cells.push_back(index); });
+
     PackedInt32Array visible;
+    visible.resize(cells.size());
+    std::copy(cells.begin(), cells.end(), visible.ptrw());
+    return visible;
+}
 
-    // Add origin
-    if (origin.x >= 0 && origin.x < width && origin.y >= 0 && origin.y < height) {
-        visible.append(origin.y * width + origin.x);
+PackedByteArray GridOps::fov_shadowcast_multi(const PackedInt32Array& grid, int width, int height,
+                                              const PackedVector2Array& origins, const PackedInt32Array& radii,
+                                              int blocking_value) {
+    PackedByteArray visibility;
+    if (width <= 0 || height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: fov_shadowcast_multi width and height must be positive");
+        return visibility;
+    }
+    if (grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: fov_shadowcast_multi grid array is smaller than width * height");
+        return visibility;
+    }
+    if (origins.size() != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        return visibility;
     }
 
-    // Cast light in all 8 octants
-    // Multipliers for octant transformations
-    static const int mult[4][8] = {
-        {1, 0, 0, -1, -1, 0, 0, 1},
-        {0, 1, -1, 0, 0, -1, 1, 0},
-        {0, 1, 1, 0, 0, -1, -1, 0},
-        {1, 0, 0, 1, -1, 0, 0, -1}
-    };
+    visibility.resize(static_cast<int64_t>(width) * height);
+    uint8_t* visibility_ptr = visibility.ptrw();
+    std::fill(visibility_ptr, visibility_ptr + visibility.size(), 0);
 
-    for (int oct = 0; oct < 8; oct++) {
-        cast_light(grid, width, height, visible, origin, radius, blocking_value,
-                  1, 1.0f, 0.0f, mult[0][oct], mult[1][oct], mult[2][oct], mult[3][oct]);
-    }
+    const int32_t* grid_ptr = grid.ptr();
+    const Vector2* origins_ptr = origins.ptr();
+    const int32_t* radii_ptr = radii.ptr();
+    int32_t observer_count = origins.size();
+
+    // Observers are cast in parallel into their own cell lists, then merged
+    // here, so no two threads ever write the same byte
+    std::vector<std::vector<int32_t>> seen(observer_count);
+    parallel::for_range(observer_count, FOV_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            shadowcast::for_each_visible(grid_ptr, width, height,
+                                         static_cast<int>(std::floor(origins_ptr[i].x)), static_cast<int>(std::floor(origins_ptr[i].y)),
+                                         radii_ptr[i], blocking_value,
+                                         [&](int32_t index) { seen[i].push_back(index); });
+        }
+    });
 
-    return visible;
+    for (const std::vector<int32_t>& cells : seen) {
+        for (int32_t index : cells) {
+            visibility_ptr[index] = 1;
+        }
+    }
+    return visibility;
 }
 
 PackedInt32Array GridOps::fov_raycast(const PackedInt32Array& grid, int width, int height,
@@ -680,175 +791,174 @@ PackedInt32Array GridOps::chebyshev_distance_field(const PackedInt32Array& grid,
     return result;
 }
 
-PackedFloat32Array GridOps::euclidean_distance_field(const PackedInt32Array& grid, int width, int height, int target_value) {
-    // Uses 8SSEDT approximation (fast approximation of Euclidean distance)
-    int32_t size = width * height;
-    PackedFloat32Array result;
-    result.resize(size);
+// Exact squared Euclidean distance to the nearest target cell (Felzenszwalb-Huttenlocher),
+// or -1 everywhere if there is no target. Both passes run across worker threads.
+static void squared_distance_transform(const int32_t* grid, int width, int height, int target_value, int32_t* out) {
+    // Pass 1: distance to the nearest target in the same column (-1 = none).
+    // Sweeps go row by row so each thread reads and writes contiguous spans of its columns.
+    parallel::for_range(width, EDT_COLUMN_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int y = 0; y < height; y++) {
+            const int32_t* cells = grid + static_cast<int64_t>(y) * width;
+            int32_t* row = out + static_cast<int64_t>(y) * width;
+            const int32_t* above = y > 0 ? row - width : nullptr;
+            for (int64_t x = begin; x < end; x++) {
+                if (cells[x] == target_value) {
+                    row[x] = 0;
+                } else {
+                    row[x] = (above && above[x] >= 0) ? above[x] + 1 : -1;
+                }
+            }
+        }
+        for (int y = height - 2; y >= 0; y--) {
+            int32_t* row = out + static_cast<int64_t>(y) * width;
+            const int32_t* below = row + width;
+            for (int64_t x = begin; x < end; x++) {
+                if (below[x] >= 0 && (row[x] < 0 || below[x] + 1 < row[x])) {
+                    row[x] = below[x] + 1;
+                }
+            }
+        }
+    });
+
+    // Pass 2: per row, the lower envelope of the parabolas (x - q)^2 + column_distance(q)^2
+    parallel::for_range(height, EDT_ROW_CHUNK, [&](int64_t begin, int64_t end) {
+        std::vector<int32_t> column(width);
+        std::vector<int32_t> sites(width);      // Columns whose parabola is on the envelope
+        std::vector<double> bounds(width + 1);  // Envelope section k covers [bounds[k], bounds[k + 1])
+
+        for (int64_t y = begin; y < end; y++) {
+            int32_t* row = out + y * width;
+            std::copy(row, row + width, column.begin());
+
+            int k = -1;
+            for (int q = 0; q < width; q++) {
+                if (column[q] < 0) continue;
+                double f_q = static_cast<double>(column[q]) * column[q] + static_cast<double>(q) * q;
+                while (k >= 0) {
+                    int v = sites[k];
+                    double f_v = static_cast<double>(column[v]) * column[v] + static_cast<double>(v) * v;
+                    double s = (f_q - f_v) / (2.0 * (q - v));
+                    if (s > bounds[k]) {
+                        sites[++k] = q;
+                        bounds[k] = s;
+                        bounds[k + 1] = std::numeric_limits<double>::infinity();
+                        break;
+                    }
+                    k--;
+                }
+                if (k < 0) {
+                    k = 0;
+                    sites[0] = q;
+                    bounds[0] = -std::numeric_limits<double>::infinity();
+                    bounds[1] = std::numeric_limits<double>::infinity();
+                }
+            }
 
-    const int32_t* grid_ptr = grid.ptr();
-    float* dst = result.ptrw();
+            // No target in any column: the whole grid has no target
+            if (k < 0) {
+                std::fill(row, row + width, -1);
+                continue;
+            }
 
-    const float INF = static_cast<float>(width + height + 1);
-    const float SQRT2 = 1.41421356237f;
+            int section = 0;
+            for (int x = 0; x < width; x++) {
+                while (bounds[section + 1] < x) section++;
+                int v = sites[section];
+                row[x] = (x - v) * (x - v) + column[v] * column[v];
+            }
+        }
+    });
+}
 
-    // Initialize
-    for (int32_t i = 0; i < size; i++) {
-        dst[i] = (grid_ptr[i] == target_value) ? 0.0f : INF;
+PackedFloat32Array GridOps::euclidean_distance_field(const PackedInt32Array& grid, int width, int height, int target_value) {
+    PackedFloat32Array result;
+    if (width <= 0 || height <= 0) return result;
+    if (grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: euclidean_distance_field grid array is smaller than width * height");
+        return result;
     }
 
-    // Forward pass
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int i = y * width + x;
-            if (x > 0) dst[i] = std::fmin(dst[i], dst[i - 1] + 1.0f);
-            if (y > 0) dst[i] = std::fmin(dst[i], dst[(y - 1) * width + x] + 1.0f);
-            if (x > 0 && y > 0) dst[i] = std::fmin(dst[i], dst[(y - 1) * width + (x - 1)] + SQRT2);
-            if (x < width - 1 && y > 0) dst[i] = std::fmin(dst[i], dst[(y - 1) * width + (x + 1)] + SQRT2);
-        }
-    }
+    int64_t size = static_cast<int64_t>(width) * height;
+    std::vector<int32_t> squared(size);
+    squared_distance_transform(grid.ptr(), width, height, target_value, squared.data());
+
+    result.resize(size);
+    float* dst = result.ptrw();
 
-    // Backward pass
-    for (int y = height - 1; y >= 0; y--) {
-        for (int x = width - 1; x >= 0; x--) {
-            int i = y * width + x;
-            if (x < width - 1) dst[i] = std::fmin(dst[i], dst[i + 1] + 1.0f);
-            if (y < height - 1) dst[i] = std::fmin(dst[i], dst[(y + 1) * width + x] + 1.0f);
-            if (x < width - 1 && y < height - 1) dst[i] = std::fmin(dst[i], dst[(y + 1) * width + (x + 1)] + SQRT2);
-            if (x > 0 && y < height - 1) dst[i] = std::fmin(dst[i], dst[(y + 1) * width + (x - 1)] + SQRT2);
+    // Grids without a target get width + height + 1 everywhere
+    const float NO_TARGET = static_cast<float>(width + height + 1);
+    parallel::for_range(size, EDT_CONVERT_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            dst[i] = squared[i] >= 0 ? std::sqrt(static_cast<float>(squared[i])) : NO_TARGET;
         }
-    }
+    });
 
     return result;
 }
 
-// ========== CONNECTED COMPONENTS ==========
-
-PackedInt32Array GridOps::label_connected_components(const PackedInt32Array& grid, int width, int height, int target_value) {
-    int32_t size = width * height;
-    PackedInt32Array labels;
-    labels.resize(size);
-
-    const int32_t* grid_ptr = grid.ptr();
-    int32_t* label_ptr = labels.ptrw();
-
-    // Initialize all labels to 0 (unlabeled)
-    for (int32_t i = 0; i < size; i++) {
-        label_ptr[i] = 0;
+PackedInt32Array GridOps::euclidean_distance_field_squared(const PackedInt32Array& grid, int width, int height, int target_value) {
+    PackedInt32Array result;
+    if (width <= 0 || height <= 0) return result;
+    if (grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: euclidean_distance_field_squared grid array is smaller than width * height");
+        return result;
     }
 
-    int current_label = 0;
+    result.resize(static_cast<int64_t>(width) * height);
+    squared_distance_transform(grid.ptr(), width, height, target_value, result.ptrw());
+    return result;
+}
 
-    for (int32_t i = 0; i < size; i++) {
-        if (grid_ptr[i] == target_value && label_ptr[i] == 0) {
-            current_label++;
+// ========== CONNECTED COMPONENTS ==========
 
-            // BFS to label component
-            std::queue<int> queue;
-            queue.push(i);
-            label_ptr[i] = current_label;
-
-            while (!queue.empty()) {
-                int current = queue.front();
-                queue.pop();
-
-                int x = current % width;
-                int y = current / width;
-
-                static const int dx[] = {0, 1, 0, -1};
-                static const int dy[] = {-1, 0, 1, 0};
-
-                for (int d = 0; d < 4; d++) {
-                    int nx = x + dx[d];
-                    int ny = y + dy[d];
-                    if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                        int ni = ny * width + nx;
-                        if (grid_ptr[ni] == target_value && label_ptr[ni] == 0) {
-                            label_ptr[ni] = current_label;
-                            queue.push(ni);
-                        }
-                    }
-                }
-            }
-        }
+// Label grid into labels (union-find, one pass plus relabel), or push an error and return -1
+static int32_t label_components(const PackedInt32Array& grid, int width, int height, int target_value,
+                                PackedInt32Array& labels, std::vector<int32_t>& sizes) {
+    if (width <= 0 || height <= 0) return 0;
+    if (grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: connected components grid array is smaller than width * height");
+        return -1;
     }
+    labels.resize(static_cast<int64_t>(width) * height);
+    return component_labeling::label(grid.ptr(), width, height, target_value, labels.ptrw(), sizes);
+}
+
+static PackedInt32Array to_packed(const std::vector<int32_t>& values) {
+    PackedInt32Array result;
+    result.resize(values.size());
+    std::copy(values.begin(), values.end(), result.ptrw());
+    return result;
+}
 
+PackedInt32Array GridOps::label_connected_components(const PackedInt32Array& grid, int width, int height, int target_value) {
+    PackedInt32Array labels;
+    std::vector<int32_t> sizes;
+    label_components(grid, width, height, target_value, labels, sizes);
     return labels;
 }
 
 int GridOps::count_connected_components(const PackedInt32Array& grid, int width, int height, int target_value) {
-    int32_t size = width * height;
-    std::vector<bool> visited(size, false);
-
-    const int32_t* grid_ptr = grid.ptr();
-    int count = 0;
-
-    for (int32_t i = 0; i < size; i++) {
-        if (grid_ptr[i] == target_value && !visited[i]) {
-            count++;
-
-            std::queue<int> queue;
-            queue.push(i);
-            visited[i] = true;
-
-            while (!queue.empty()) {
-                int current = queue.front();
-                queue.pop();
-
-                int x = current % width;
-                int y = current / width;
-
-                static const int dx[] = {0, 1, 0, -1};
-                static const int dy[] = {-1, 0, 1, 0};
-
-                for (int d = 0; d < 4; d++) {
-                    int nx = x + dx[d];
-                    int ny = y + dy[d];
-                    if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                        int ni = ny * width + nx;
-                        if (grid_ptr[ni] == target_value && !visited[ni]) {
-                            visited[ni] = true;
-                            queue.push(ni);
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return count;
+    PackedInt32Array labels;
+    std::vector<int32_t> sizes;
+    return std::max(label_components(grid, width, height, target_value, labels, sizes), 0);
 }
 
 PackedInt32Array GridOps::component_sizes(const PackedInt32Array& grid, int width, int height, int target_value) {
-    PackedInt32Array labels = label_connected_components(grid, width, height, target_value);
-
-    // Find max label
-    int32_t max_label = 0;
-    const int32_t* label_ptr = labels.ptr();
-    int32_t size = labels.size();
-
-    for (int32_t i = 0; i < size; i++) {
-        if (label_ptr[i] > max_label) max_label = label_ptr[i];
-    }
-
-    if (max_label == 0) return PackedInt32Array();
-
-    // Count sizes
-    std::vector<int> sizes(max_label + 1, 0);
-    for (int32_t i = 0; i < size; i++) {
-        if (label_ptr[i] > 0) {
-            sizes[label_ptr[i]]++;
-        }
-    }
+    PackedInt32Array labels;
+    std::vector<int32_t> sizes;
+    label_components(grid, width, height, target_value, labels, sizes);
+    return to_packed(sizes);
+}
 
-    // Convert to result (skip index 0)
-    PackedInt32Array result;
-    result.resize(max_label);
-    int32_t* dst = result.ptrw();
-    for (int i = 1; i <= max_label; i++) {
-        dst[i - 1] = sizes[i];
+Array GridOps::label_components_with_sizes(const PackedInt32Array& grid, int width, int height, int target_value) {
+    Array result;
+    PackedInt32Array labels;
+    std::vector<int32_t> sizes;
+    if (label_components(grid, width, height, target_value, labels, sizes) < 0) {
+        return result;
     }
-
+    result.append(labels);
+    result.append(to_packed(sizes));
     return result;
 }
 
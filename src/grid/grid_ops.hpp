@@ -17,15 +17,20 @@
  *
  *   # Line of sight
  *   var visible = GridOps.line_clear(grid, width, from, to, blocking)
+ *
+ *   # Many rays at once: [hit cells, hit distances]
+ *   var hits = GridOps.raycast_grid_batch(grid, width, height, origins, directions, max_dists, blocking)
  */
 
 #ifndef AGENTITE_GRID_OPS_HPP
 #define AGENTITE_GRID_OPS_HPP
 
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <godot_cpp/variant/vector2i.hpp>
 
@@ -81,10 +86,20 @@ public:
     static PackedInt32Array raycast_grid(const PackedInt32Array& grid, int width, const Vector2i& from, const Vector2i& direction, int max_distance, int blocking_value);
     // Get the first blocking cell along a line (returns -1 if none)
     static int line_first_blocking(const PackedInt32Array& grid, int width, const Vector2i& from, const Vector2i& to, int blocking_value);
+    // Batch raycast (DDA, multithreaded): find the first blocking cell along each ray.
+    // Positions are in cell units (cell (x, y) covers [x, x + 1) x [y, y + 1)); the
+    // cell a ray starts in never blocks it. Returns [PackedInt32Array cell indices,
+    // PackedFloat32Array distances], with -1 and INF for rays that hit nothing.
+    static Array raycast_grid_batch(const PackedInt32Array& grid, int width, int height,
+                                    const PackedVector2Array& origins, const PackedVector2Array& directions,
+                                    const PackedFloat32Array& max_distances, int blocking_value);
 
     // ========== FIELD OF VIEW (SHADOWCASTING) ==========
     // Calculate visible cells from origin within radius using shadowcasting
     static PackedInt32Array fov_shadowcast(const PackedInt32Array& grid, int width, int height, const Vector2i& origin, int radius, int blocking_value);
+    // Combined FOV of many observers (multithreaded): 1 for cells any observer sees, else 0
+    // origins are cell coordinates; see VisibilityMap to recompute only observers that changed
+    static PackedByteArray fov_shadowcast_multi(const PackedInt32Array& grid, int width, int height, const PackedVector2Array& origins, const PackedInt32Array& radii, int blocking_value);
     // Simpler FOV using ray tracing (slower but simpler)
     static PackedInt32Array fov_raycast(const PackedInt32Array& grid, int width, int height, const Vector2i& origin, int radius, int blocking_value, int ray_count);
 
@@ -93,16 +108,21 @@ public:
     static PackedInt32Array manhattan_distance_field(const PackedInt32Array& grid, int width, int height, int target_value);
     // Chebyshev (chessboard) distance field
     static PackedInt32Array chebyshev_distance_field(const PackedInt32Array& grid, int width, int height, int target_value);
-    // Euclidean distance field (approximation using 3-4-5 weights)
+    // Exact Euclidean distance field (separable transform, multithreaded)
     static PackedFloat32Array euclidean_distance_field(const PackedInt32Array& grid, int width, int height, int target_value);
+    // Exact squared Euclidean distances as integers (-1 everywhere if there is no target)
+    static PackedInt32Array euclidean_distance_field_squared(const PackedInt32Array& grid, int width, int height, int target_value);
 
     // ========== CONNECTED COMPONENTS ==========
-    // Label all connected components (4-connected), returns labels array
+    // Label all connected components (4-connected, union-find), returns labels array
     static PackedInt32Array label_connected_components(const PackedInt32Array& grid, int width, int height, int target_value);
     // Count number of connected components
     static int count_connected_components(const PackedInt32Array& grid, int width, int height, int target_value);
     // Get sizes of each connected component
     static PackedInt32Array component_sizes(const PackedInt32Array& grid, int width, int height, int target_value);
+    // Labels and sizes in one pass: [labels, sizes] (sizes[k] is the size of label k + 1)
+    // See ConnectedComponents for labels kept up to date as cells change
+    static Array label_components_with_sizes(const PackedInt32Array& grid, int width, int height, int target_value);
 
     // ========== GRID UTILITIES ==========
     // Find all cells with specific value
@@ -115,13 +135,6 @@ public:
     static PackedInt32Array get_region(const PackedInt32Array& grid, int grid_width, int x, int y, int region_width, int region_height);
     // Set rectangular region from flat array
     static PackedInt32Array set_region(const PackedInt32Array& grid, int grid_width, int x, int y, int region_width, int region_height, const PackedInt32Array& values);
-
-private:
-    // Internal helper for shadowcasting octants
-    static void cast_light(const PackedInt32Array& grid, int width, int height,
-                          PackedInt32Array& visible, const Vector2i& origin, int radius,
-                          int blocking_value, int row, float start_slope, float end_slope,
-                          int xx, int xy, int yx, int yy);
 };
 
 }
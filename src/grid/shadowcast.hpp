@@ -0,0 +1,100 @@
+/**
+ * Shadowcast - Recursive shadowcasting FOV shared by GridOps and VisibilityMap
+ *
+ * Walks the eight octants around an origin row by row, narrowing the lit
+ * slope range at every blocking cell, and calls visit(index) for each
+ * visible cell. Cells on octant borders are visited once per octant, so
+ * callers that need a set must deduplicate.
+ *
+ * Visibility only depends on cells within radius (Chebyshev) of the origin,
+ * which lets callers skip observers whose square did not change.
+ *
+ * Usage (internal):
+ *   shadowcast::for_each_visible(grid, width, height, ox, oy, radius, WALL,
+ *       [&](int32_t index) { seen[index] = 1; });
+ */
+
+#ifndef AGENTITE_SHADOWCAST_HPP
+#define AGENTITE_SHADOWCAST_HPP
+
+#include <cstdint>
+
+namespace godot {
+namespace shadowcast {
+
+// Scan one octant from row onward, between start_slope and end_slope
+template <typename Visit>
+void cast_light(const int32_t* grid, int width, int height, int ox, int oy, int radius,
+                int blocking_value, int row, float start_slope, float end_slope,
+                int xx, int xy, int yx, int yy, const Visit& visit) {
+    if (start_slope < end_slope) return;
+
+    float next_start_slope = start_slope;
+    int radius_sq = radius * radius;
+
+    for (int i = row; i <= radius; i++) {
+        bool blocked = false;
+        for (int dx = -i, dy = -i; dx <= 0; dx++) {
+            // Translate from octant coordinates to actual coordinates
+            int ax = ox + dx * xx + dy * xy;
+            int ay = oy + dx * yx + dy * yy;
+
+            float l_slope = (dx - 0.5f) / (dy + 0.5f);
+            float r_slope = (dx + 0.5f) / (dy - 0.5f);
+
+            if (start_slope < r_slope) continue;
+            if (end_slope > l_slope) break;
+
+            // Check if in bounds and within radius
+            bool in_bounds = ax >= 0 && ax < width && ay >= 0 && ay < height;
+            if (in_bounds && dx * dx + dy * dy <= radius_sq) {
+                visit(static_cast<int32_t>(ay * width + ax));
+            }
+
+            if (blocked) {
+                if (!in_bounds || grid[ay * width + ax] == blocking_value) {
+                    next_start_slope = r_slope;
+                    continue;
+                } else {
+                    blocked = false;
+                    start_slope = next_start_slope;
+                }
+            } else {
+                if (in_bounds && grid[ay * width + ax] == blocking_value && i < radius) {
+                    blocked = true;
+                    cast_light(grid, width, height, ox, oy, radius, blocking_value,
+                               i + 1, start_slope, l_slope, xx, xy, yx, yy, visit);
+                    next_start_slope = r_slope;
+                }
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+// Visit every cell visible from (ox, oy) within radius, origin first
+template <typename Visit>
+void for_each_visible(const int32_t* grid, int width, int height, int ox, int oy, int radius,
+                      int blocking_value, const Visit& visit) {
+    if (ox >= 0 && ox < width && oy >= 0 && oy < height) {
+        visit(static_cast<int32_t>(oy * width + ox));
+    }
+
+    // Multipliers for octant transformations
+    static const int mult[4][8] = {
+        {1, 0, 0, -1, -1, 0, 0, 1},
+        {0, 1, -1, 0, 0, -1, 1, 0},
+        {0, 1, 1, 0, 0, -1, -1, 0},
+        {1, 0, 0, 1, -1, 0, 0, -1}
+    };
+
+    for (int oct = 0; oct < 8; oct++) {
+        cast_light(grid, width, height, ox, oy, radius, blocking_value,
+                   1, 1.0f, 0.0f, mult[0][oct], mult[1][oct], mult[2][oct], mult[3][oct], visit);
+    }
+}
+
+}
+}
+
+#endif // AGENTITE_SHADOWCAST_HPP
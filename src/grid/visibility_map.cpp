@@ -0,0 +1,207 @@
+/**
+ * VisibilityMap Implementation
+ */
+
+#include "visibility_map.hpp"
+#include "shadowcast.hpp"
+#include "core/parallel.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace godot {
+
+// Observers per chunk when recasting (each casts a whole FOV)
+static const int64_t FOV_CHUNK = 4;
+
+// Helper: grid cell holding an origin coordinate (floor, so -0.5 is cell -1)
+static inline int32_t origin_cell(real_t v) {
+    return static_cast<int32_t>(std::floor(v));
+}
+
+void VisibilityMap::_bind_methods() {
+    // Grid
+    ClassDB::bind_method(D_METHOD("set_grid", "grid", "width", "height", "blocking_value"), &VisibilityMap::set_grid);
+    ClassDB::bind_method(D_METHOD("update_grid", "grid", "region"), &VisibilityMap::update_grid);
+
+    // Observers
+    ClassDB::bind_method(D_METHOD("update", "origins", "radii"), &VisibilityMap::update);
+    ClassDB::bind_method(D_METHOD("get_observer_count"), &VisibilityMap::get_observer_count);
+    ClassDB::bind_method(D_METHOD("clear"), &VisibilityMap::clear);
+
+    // Results
+    ClassDB::bind_method(D_METHOD("get_visibility"), &VisibilityMap::get_visibility);
+    ClassDB::bind_method(D_METHOD("is_cell_visible", "cell"), &VisibilityMap::is_cell_visible);
+}
+
+VisibilityMap::VisibilityMap() {
+}
+
+VisibilityMap::~VisibilityMap() {
+}
+
+// ========== GRID ==========
+
+void VisibilityMap::set_grid(const PackedInt32Array& p_grid, int32_t p_width, int32_t p_height, int32_t p_blocking_value) {
+    if (p_width <= 0 || p_height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: VisibilityMap width and height must be positive");
+        return;
+    }
+    if (p_grid.size() < static_cast<int64_t>(p_width) * p_height) {
+        UtilityFunctions::push_error("AgentiteG: VisibilityMap grid array is smaller than width * height");
+        return;
+    }
+
+    grid = p_grid;
+    width = p_width;
+    height = p_height;
+    blocking_value = p_blocking_value;
+
+    // Cell indices depend on the size, so start the merge over
+    int64_t cell_count = static_cast<int64_t>(width) * height;
+    counts.assign(cell_count, 0);
+    visibility.resize(cell_count);
+    visibility.fill(0);
+    for (Observer& observer : observers) {
+        observer.cells.clear();
+        observer.dirty = true;
+    }
+}
+
+void VisibilityMap::update_grid(const PackedInt32Array& p_grid, const Rect2i& region) {
+    if (width == 0) {
+        UtilityFunctions::push_error("AgentiteG: VisibilityMap needs set_grid before update_grid");
+        return;
+    }
+    if (p_grid.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: VisibilityMap grid array is smaller than width * height");
+        return;
+    }
+
+    grid = p_grid;
+
+    int32_t x0 = region.position.x;
+    int32_t y0 = region.position.y;
+    int32_t x1 = region.position.x + region.size.x;
+    int32_t y1 = region.position.y + region.size.y;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    // An FOV only reads cells within radius of its origin (a square)
+    for (Observer& observer : observers) {
+        if (observer.x + observer.radius >= x0 && observer.x - observer.radius < x1 &&
+            observer.y + observer.radius >= y0 && observer.y - observer.radius < y1) {
+            observer.dirty = true;
+        }
+    }
+}
+
+// ========== OBSERVERS ==========
+
+void VisibilityMap::drop_cells(Observer& observer, uint8_t* visibility_ptr) {
+    for (int32_t index : observer.cells) {
+        if (--counts[index] == 0) {
+            visibility_ptr[index] = 0;
+        }
+    }
+    observer.cells.clear();
+}
+
+int32_t VisibilityMap::update(const PackedVector2Array& origins, const PackedInt32Array& radii) {
+    if (width == 0) {
+        UtilityFunctions::push_error("AgentiteG: VisibilityMap needs set_grid before update");
+        return 0;
+    }
+    if (origins.size() != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        return 0;
+    }
+
+    int32_t observer_count = origins.size();
+    const Vector2* origins_ptr = origins.ptr();
+    const int32_t* radii_ptr = radii.ptr();
+
+    // Find observers that moved, changed radius, saw the grid change, or are new
+    std::vector<int32_t> recast;
+    size_t kept = std::min(observers.size(), static_cast<size_t>(observer_count));
+    for (int32_t i = 0; i < observer_count; i++) {
+        int32_t x = origin_cell(origins_ptr[i].x);
+        int32_t y = origin_cell(origins_ptr[i].y);
+        int32_t radius = std::max(radii_ptr[i], 0);
+        if (static_cast<size_t>(i) >= kept || observers[i].dirty ||
+            observers[i].x != x || observers[i].y != y || observers[i].radius != radius) {
+            recast.push_back(i);
+        }
+    }
+    if (recast.empty() && observers.size() == static_cast<size_t>(observer_count)) {
+        return 0;
+    }
+
+    // Cast the changed observers in parallel, each into its own list
+    const int32_t* grid_ptr = grid.ptr();
+    std::vector<std::vector<int32_t>> fresh(recast.size());
+    parallel::for_range(static_cast<int64_t>(recast.size()), FOV_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t k = begin; k < end; k++) {
+            int32_t i = recast[k];
+            std::vector<int32_t>& cells = fresh[k];
+            shadowcast::for_each_visible(grid_ptr, width, height,
+                                         origin_cell(origins_ptr[i].x), origin_cell(origins_ptr[i].y),
+                                         std::max(radii_ptr[i], 0), blocking_value,
+                                         [&](int32_t index) { cells.push_back(index); });
+            // Octant borders are visited twice
+            std::sort(cells.begin(), cells.end());
+            cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        }
+    });
+
+    // Merge the differences into the shared counts (serial, proportional to recast cells)
+    uint8_t* visibility_ptr = visibility.ptrw();
+    for (size_t i = observer_count; i < observers.size(); i++) {
+        drop_cells(observers[i], visibility_ptr);
+    }
+    observers.resize(observer_count);
+
+    for (size_t k = 0; k < recast.size(); k++) {
+        Observer& observer = observers[recast[k]];
+        drop_cells(observer, visibility_ptr);
+        observer.cells.swap(fresh[k]);
+        for (int32_t index : observer.cells) {
+            if (counts[index]++ == 0) {
+                visibility_ptr[index] = 1;
+            }
+        }
+        observer.x = origin_cell(origins_ptr[recast[k]].x);
+        observer.y = origin_cell(origins_ptr[recast[k]].y);
+        observer.radius = std::max(radii_ptr[recast[k]], 0);
+        observer.dirty = false;
+    }
+
+    return static_cast<int32_t>(recast.size());
+}
+
+int32_t VisibilityMap::get_observer_count() const {
+    return static_cast<int32_t>(observers.size());
+}
+
+void VisibilityMap::clear() {
+    observers.clear();
+    std::fill(counts.begin(), counts.end(), 0);
+    visibility.fill(0);
+}
+
+// ========== RESULTS ==========
+
+PackedByteArray VisibilityMap::get_visibility() const {
+    return visibility;
+}
+
+bool VisibilityMap::is_cell_visible(const Vector2i& cell) const {
+    if (cell.x < 0 || cell.x >= width || cell.y < 0 || cell.y >= height) {
+        return false;
+    }
+    return counts[cell.y * width + cell.x] > 0;
+}
+
+}
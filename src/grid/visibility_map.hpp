@@ -0,0 +1,98 @@
+/**
+ * VisibilityMap - Merged fog-of-war visibility for many observers
+ *
+ * Keeps one shadowcast FOV per observer and a per-cell count of how many
+ * observers see it, merged into a reusable PackedByteArray (1 = visible).
+ * Each update() recomputes only observers that moved, changed radius, or
+ * had a grid change within their radius; everyone else is skipped. The
+ * recomputed observers are cast across worker threads.
+ *
+ * Observers are identified by their index in the arrays passed to update(),
+ * so keep units in a stable order. Results match
+ * GridOps.fov_shadowcast_multi on the same grid and observers.
+ *
+ * Usage:
+ *   var fog = VisibilityMap.new()
+ *   fog.set_grid(tilemap, width, height, WALL)
+ *
+ *   # Every tick
+ *   fog.update(unit_cells, sight_radii)
+ *   var visible: PackedByteArray = fog.get_visibility()
+ *
+ *   # A wall was destroyed
+ *   tilemap[wall_index] = FLOOR
+ *   fog.update_grid(tilemap, Rect2i(wall_x, wall_y, 1, 1))
+ */
+
+#ifndef AGENTITE_VISIBILITY_MAP_HPP
+#define AGENTITE_VISIBILITY_MAP_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class VisibilityMap : public RefCounted {
+    GDCLASS(VisibilityMap, RefCounted)
+
+private:
+    struct Observer {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t radius = 0;
+        bool dirty = true;              // Grid changed within radius since the last cast
+        std::vector<int32_t> cells;     // Sorted visible cells from the last cast
+    };
+
+    PackedInt32Array grid;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t blocking_value = 1;
+
+    std::vector<Observer> observers;
+    std::vector<int32_t> counts;        // Observers seeing each cell
+    PackedByteArray visibility;
+
+    void drop_cells(Observer& observer, uint8_t* visibility_ptr);
+
+protected:
+    static void _bind_methods();
+
+public:
+    VisibilityMap();
+    ~VisibilityMap();
+
+    // Set the grid and the value that blocks sight. Every observer is recast on the next update().
+    void set_grid(const PackedInt32Array& p_grid, int32_t p_width, int32_t p_height, int32_t p_blocking_value);
+
+    // Replace the grid after the cells in region changed
+    // Only observers whose radius reaches region are recast
+    void update_grid(const PackedInt32Array& p_grid, const Rect2i& region);
+
+    // Set the observers (cell coordinates and sight radii) and recast the ones that changed
+    // Returns the number of observers recast
+    int32_t update(const PackedVector2Array& origins, const PackedInt32Array& radii);
+
+    // Visibility of every cell (1 = seen by at least one observer), row-major
+    PackedByteArray get_visibility() const;
+
+    // Whether any observer sees cell
+    bool is_cell_visible(const Vector2i& cell) const;
+
+    // Number of observers from the last update()
+    int32_t get_observer_count() const;
+
+    // Remove all observers (nothing is visible until the next update())
+    void clear();
+};
+
+}
+
+#endif // AGENTITE_VISIBILITY_MAP_HPP
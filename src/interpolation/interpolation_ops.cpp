@@ -3,8 +3,11 @@
  */
 
 #include "interpolation_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/simd.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 #include <cmath>
 
 namespace godot {
@@ -16,6 +19,12 @@ static const float BACK_C1 = 1.70158f;
 static const float BACK_C2 = BACK_C1 * 1.525f;
 static const float BACK_C3 = BACK_C1 + 1.0f;
 
+// Values per worker task in ease_batch
+static const int64_t EASE_CHUNK = 16384;
+
+static_assert(static_cast<int>(InterpolationOps::EASE_TYPE_COUNT) == static_cast<int>(simd::EASE_COUNT),
+              "EaseType must match simd::Ease");
+
 void InterpolationOps::_bind_methods() {
     // Quadratic
     ClassDB::bind_static_method("InterpolationOps", D_METHOD("ease_in_quad", "t"), &InterpolationOps::ease_in_quad);
@@ -66,6 +75,41 @@ void InterpolationOps::_bind_methods() {
     ClassDB::bind_static_method("InterpolationOps", D_METHOD("ease_in_bounce", "t"), &InterpolationOps::ease_in_bounce);
     ClassDB::bind_static_method("InterpolationOps", D_METHOD("ease_out_bounce", "t"), &InterpolationOps::ease_out_bounce);
     ClassDB::bind_static_method("InterpolationOps", D_METHOD("ease_in_out_bounce", "t"), &InterpolationOps::ease_in_out_bounce);
+    ClassDB::bind_static_method("InterpolationOps", D_METHOD("ease_batch", "type", "t"), &InterpolationOps::ease_batch);
+
+    BIND_CONSTANT(EASE_LINEAR);
+    BIND_CONSTANT(EASE_IN_QUAD);
+    BIND_CONSTANT(EASE_OUT_QUAD);
+    BIND_CONSTANT(EASE_IN_OUT_QUAD);
+    BIND_CONSTANT(EASE_IN_CUBIC);
+    BIND_CONSTANT(EASE_OUT_CUBIC);
+    BIND_CONSTANT(EASE_IN_OUT_CUBIC);
+    BIND_CONSTANT(EASE_IN_QUART);
+    BIND_CONSTANT(EASE_OUT_QUART);
+    BIND_CONSTANT(EASE_IN_OUT_QUART);
+    BIND_CONSTANT(EASE_IN_QUINT);
+    BIND_CONSTANT(EASE_OUT_QUINT);
+    BIND_CONSTANT(EASE_IN_OUT_QUINT);
+    BIND_CONSTANT(EASE_IN_SINE);
+    BIND_CONSTANT(EASE_OUT_SINE);
+    BIND_CONSTANT(EASE_IN_OUT_SINE);
+    BIND_CONSTANT(EASE_IN_EXPO);
+    BIND_CONSTANT(EASE_OUT_EXPO);
+    BIND_CONSTANT(EASE_IN_OUT_EXPO);
+    BIND_CONSTANT(EASE_IN_CIRC);
+    BIND_CONSTANT(EASE_OUT_CIRC);
+    BIND_CONSTANT(EASE_IN_OUT_CIRC);
+    BIND_CONSTANT(EASE_IN_BACK);
+    BIND_CONSTANT(EASE_OUT_BACK);
+    BIND_CONSTANT(EASE_IN_OUT_BACK);
+    BIND_CONSTANT(EASE_IN_ELASTIC);
+    BIND_CONSTANT(EASE_OUT_ELASTIC);
+    BIND_CONSTANT(EASE_IN_OUT_ELASTIC);
+    BIND_CONSTANT(EASE_IN_BOUNCE);
+    BIND_CONSTANT(EASE_OUT_BOUNCE);
+    BIND_CONSTANT(EASE_IN_OUT_BOUNCE);
+    BIND_CONSTANT(EASE_SMOOTHSTEP);
+    BIND_CONSTANT(EASE_SMOOTHERSTEP);
 
     // Bezier
     ClassDB::bind_static_method("InterpolationOps", D_METHOD("bezier_quadratic_2d", "p0", "p1", "p2", "t"), &InterpolationOps::bezier_quadratic_2d);
@@ -667,6 +711,29 @@ PackedFloat32Array InterpolationOps::ease_in_out_bounce(const PackedFloat32Array
     return result;
 }
 
+// === Batch Easing ===
+
+PackedFloat32Array InterpolationOps::ease_batch(int type, const PackedFloat32Array& t) {
+    PackedFloat32Array result;
+    if (type < 0 || type >= EASE_TYPE_COUNT) {
+        UtilityFunctions::push_error("AgentiteG: ease_batch type must be an InterpolationOps.EASE_* constant");
+        return result;
+    }
+
+    int64_t n = t.size();
+    result.resize(n);
+
+    const float* t_ptr = t.ptr();
+    float* r_ptr = result.ptrw();
+    const simd::Kernels& k = simd::kernels();
+
+    parallel::for_range(n, EASE_CHUNK, [&](int64_t begin, int64_t end) {
+        k.ease(type, t_ptr + begin, r_ptr + begin, end - begin);
+    });
+
+    return result;
+}
+
 // === Bezier Curves ===
 
 PackedVector2Array InterpolationOps::bezier_quadratic_2d(const Vector2& p0, const Vector2& p1,
@@ -15,6 +15,9 @@
  *   var t_values = PackedFloat32Array([0.0, 0.25, 0.5, 0.75, 1.0])
  *   var eased = InterpolationOps.ease_out_quad(t_values)
  *
+ *   # Any curve by type, SIMD and multi-threaded for large arrays
+ *   var eased_all = InterpolationOps.ease_batch(InterpolationOps.EASE_OUT_ELASTIC, t_values)
+ *
  *   # Bezier curves
  *   var points = InterpolationOps.bezier_cubic(p0, p1, p2, p3, t_values)
  */
@@ -38,6 +41,23 @@ protected:
     static void _bind_methods();
 
 public:
+    // Curves for ease_batch
+    enum EaseType {
+        EASE_LINEAR,
+        EASE_IN_QUAD, EASE_OUT_QUAD, EASE_IN_OUT_QUAD,
+        EASE_IN_CUBIC, EASE_OUT_CUBIC, EASE_IN_OUT_CUBIC,
+        EASE_IN_QUART, EASE_OUT_QUART, EASE_IN_OUT_QUART,
+        EASE_IN_QUINT, EASE_OUT_QUINT, EASE_IN_OUT_QUINT,
+        EASE_IN_SINE, EASE_OUT_SINE, EASE_IN_OUT_SINE,
+        EASE_IN_EXPO, EASE_OUT_EXPO, EASE_IN_OUT_EXPO,
+        EASE_IN_CIRC, EASE_OUT_CIRC, EASE_IN_OUT_CIRC,
+        EASE_IN_BACK, EASE_OUT_BACK, EASE_IN_OUT_BACK,
+        EASE_IN_ELASTIC, EASE_OUT_ELASTIC, EASE_IN_OUT_ELASTIC,
+        EASE_IN_BOUNCE, EASE_OUT_BOUNCE, EASE_IN_OUT_BOUNCE,
+        EASE_SMOOTHSTEP, EASE_SMOOTHERSTEP,
+        EASE_TYPE_COUNT,
+    };
+
     // === Easing Functions (batch) ===
     // All take t values in [0,1] and return eased values
 
@@ -91,6 +111,10 @@ public:
     static PackedFloat32Array ease_out_bounce(const PackedFloat32Array& t);
     static PackedFloat32Array ease_in_out_bounce(const PackedFloat32Array& t);
 
+    // Any curve by EaseType, on the SIMD kernels (multi-threaded for large arrays)
+    // t is clamped to [0,1]; sin and exp2 use polynomials accurate to ~1e-6
+    static PackedFloat32Array ease_batch(int type, const PackedFloat32Array& t);
+
     // === Bezier Curves ===
 
     // Quadratic bezier (3 control points)
@@ -0,0 +1,164 @@
+/**
+ * Spline3D Implementation
+ */
+
+#include "spline_3d.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+void Spline3D::_bind_methods() {
+    // Settings
+    ClassDB::bind_method(D_METHOD("set_closed", "closed"), &Spline3D::set_closed);
+    ClassDB::bind_method(D_METHOD("get_closed"), &Spline3D::get_closed);
+    ClassDB::bind_method(D_METHOD("set_samples_per_segment", "samples_per_segment"), &Spline3D::set_samples_per_segment);
+    ClassDB::bind_method(D_METHOD("get_samples_per_segment"), &Spline3D::get_samples_per_segment);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &Spline3D::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &Spline3D::get_threaded);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "closed"), "set_closed", "get_closed");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "samples_per_segment"), "set_samples_per_segment", "get_samples_per_segment");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+
+    // Points
+    ClassDB::bind_method(D_METHOD("set_points", "points"), &Spline3D::set_points);
+    ClassDB::bind_method(D_METHOD("get_points"), &Spline3D::get_points);
+    ClassDB::bind_method(D_METHOD("get_point_count"), &Spline3D::get_point_count);
+    ClassDB::bind_method(D_METHOD("get_segment_count"), &Spline3D::get_segment_count);
+    ClassDB::bind_method(D_METHOD("get_length"), &Spline3D::get_length);
+
+    // Sampling
+    ClassDB::bind_method(D_METHOD("sample_batch", "t"), &Spline3D::sample_batch);
+    ClassDB::bind_method(D_METHOD("sample_at_distances", "distances"), &Spline3D::sample_at_distances);
+    ClassDB::bind_method(D_METHOD("tangent_batch", "t"), &Spline3D::tangent_batch);
+    ClassDB::bind_method(D_METHOD("sample_evenly", "count"), &Spline3D::sample_evenly);
+}
+
+Spline3D::Spline3D() {
+}
+
+Spline3D::~Spline3D() {
+}
+
+template <typename Distance>
+PackedVector3Array Spline3D::sample(int64_t count, bool tangents, const Distance& distance) const {
+    PackedVector3Array result;
+    if (core.points.empty()) {
+        UtilityFunctions::push_error("AgentiteG: Spline3D has no points (call set_points first)");
+        return result;
+    }
+    result.resize(count);
+    Vector3* dst = result.ptrw();
+
+    if (core.segments.empty()) {
+        // A single point
+        Vector3 only = tangents ? Vector3() : Vector3(core.points[0][0], core.points[0][1], core.points[0][2]);
+        for (int64_t i = 0; i < count; i++) {
+            dst[i] = only;
+        }
+        return result;
+    }
+
+    core.run(count, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            SplineCore<3>::Point p = tangents ? core.tangent_at(distance(i)) : core.point_at(distance(i));
+            dst[i] = Vector3(p[0], p[1], p[2]);
+        }
+    });
+    return result;
+}
+
+// ========== SETTINGS ==========
+
+void Spline3D::set_closed(bool p_closed) {
+    core.config.closed = p_closed;
+    core.build();
+}
+
+bool Spline3D::get_closed() const {
+    return core.config.closed;
+}
+
+void Spline3D::set_samples_per_segment(int32_t p_samples_per_segment) {
+    core.config.samples_per_segment = std::max(p_samples_per_segment, 1);
+    core.build();
+}
+
+int32_t Spline3D::get_samples_per_segment() const {
+    return core.config.samples_per_segment;
+}
+
+void Spline3D::set_threaded(bool p_threaded) {
+    core.config.threaded = p_threaded;
+}
+
+bool Spline3D::get_threaded() const {
+    return core.config.threaded;
+}
+
+// ========== POINTS ==========
+
+void Spline3D::set_points(const PackedVector3Array& points) {
+    const Vector3* src = points.ptr();
+    core.points.resize(points.size());
+    for (int64_t i = 0; i < points.size(); i++) {
+        core.points[i] = {src[i].x, src[i].y, src[i].z};
+    }
+    core.build();
+}
+
+PackedVector3Array Spline3D::get_points() const {
+    PackedVector3Array result;
+    result.resize(static_cast<int64_t>(core.points.size()));
+    Vector3* dst = result.ptrw();
+    for (size_t i = 0; i < core.points.size(); i++) {
+        dst[i] = Vector3(core.points[i][0], core.points[i][1], core.points[i][2]);
+    }
+    return result;
+}
+
+int32_t Spline3D::get_point_count() const {
+    return static_cast<int32_t>(core.points.size());
+}
+
+int32_t Spline3D::get_segment_count() const {
+    return static_cast<int32_t>(core.segment_count());
+}
+
+float Spline3D::get_length() const {
+    return core.length;
+}
+
+// ========== SAMPLING ==========
+
+PackedVector3Array Spline3D::sample_batch(const PackedFloat32Array& t) const {
+    const float* src = t.ptr();
+    float length = core.length;
+    return sample(t.size(), false, [src, length](int64_t i) { return src[i] * length; });
+}
+
+PackedVector3Array Spline3D::sample_at_distances(const PackedFloat32Array& distances) const {
+    const float* src = distances.ptr();
+    return sample(distances.size(), false, [src](int64_t i) { return src[i]; });
+}
+
+PackedVector3Array Spline3D::tangent_batch(const PackedFloat32Array& t) const {
+    const float* src = t.ptr();
+    float length = core.length;
+    return sample(t.size(), true, [src, length](int64_t i) { return src[i] * length; });
+}
+
+PackedVector3Array Spline3D::sample_evenly(int32_t count) const {
+    if (count < 1) {
+        return PackedVector3Array();
+    }
+    // Closed curves end where they start, so leave out the repeated point
+    float step = core.length / (core.config.closed ? count : std::max(count - 1, 1));
+    return sample(count, false, [step](int64_t i) { return static_cast<float>(i) * step; });
+}
+
+}
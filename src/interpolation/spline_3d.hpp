@@ -0,0 +1,93 @@
+/**
+ * Spline3D - Arc-length parameterized Catmull-Rom spline
+ *
+ * InterpolationOps.catmull_rom_3d re-evaluates the basis for every sample
+ * and spaces samples evenly in the curve parameter, so points bunch up on
+ * tight segments and spread out on long ones. Spline3D builds the segment
+ * polynomials and an arc-length lookup table once, when the points or
+ * settings change. After that, sampling by distance is a binary search
+ * into the table plus one polynomial evaluation, and equal steps in t move
+ * equal distances along the curve (constant speed).
+ *
+ * The curve passes through every point, from the first to the last (or
+ * back to the first when closed).
+ *
+ * Usage:
+ *   var path = Spline3D.new()
+ *   path.closed = true
+ *   path.set_points(waypoints)
+ *
+ *   # Each frame: t in [0, 1] of the total length, for 10k followers
+ *   var positions = path.sample_batch(progress)
+ *   var headings = path.tangent_batch(progress)
+ *
+ *   # Evenly spaced markers every ~32 units
+ *   var markers = path.sample_evenly(int(path.get_length() / 32.0) + 1)
+ */
+
+#ifndef AGENTITE_SPLINE_3D_HPP
+#define AGENTITE_SPLINE_3D_HPP
+
+#include "spline_core.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class Spline3D : public RefCounted {
+    GDCLASS(Spline3D, RefCounted)
+
+private:
+    SplineCore<3> core;
+
+    // Sample point_at (or tangent_at) for each distance(i), i in [0, count)
+    template <typename Distance>
+    PackedVector3Array sample(int64_t count, bool tangents, const Distance& distance) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    Spline3D();
+    ~Spline3D();
+
+    // ========== SETTINGS ==========
+
+    void set_closed(bool p_closed);
+    bool get_closed() const;
+    void set_samples_per_segment(int32_t p_samples_per_segment);  // Arc-length table resolution
+    int32_t get_samples_per_segment() const;
+    void set_threaded(bool p_threaded);
+    bool get_threaded() const;
+
+    // ========== POINTS ==========
+
+    // Rebuilds the segment polynomials and the arc-length table
+    void set_points(const PackedVector3Array& points);
+    PackedVector3Array get_points() const;
+    int32_t get_point_count() const;
+    int32_t get_segment_count() const;
+    float get_length() const;
+
+    // ========== SAMPLING ==========
+    // All sampling is by arc length, so equal steps give equally spaced points.
+    // Open splines clamp to the ends; closed splines wrap around.
+
+    // t in [0, 1] as a fraction of the total length
+    PackedVector3Array sample_batch(const PackedFloat32Array& t) const;
+    // Distances along the curve from the first point
+    PackedVector3Array sample_at_distances(const PackedFloat32Array& distances) const;
+    // Unit tangents at t (fraction of length)
+    PackedVector3Array tangent_batch(const PackedFloat32Array& t) const;
+    // count points evenly spaced along the whole curve (ends included when open)
+    PackedVector3Array sample_evenly(int32_t count) const;
+};
+
+}
+
+#endif // AGENTITE_SPLINE_3D_HPP
@@ -0,0 +1,246 @@
+/**
+ * SplineCore - Arc-length parameterized Catmull-Rom spline shared by
+ * Spline2D and Spline3D
+ *
+ * The curve passes through every point. Each segment's cubic is expanded
+ * once into polynomial coefficients, and a lookup table holds the
+ * cumulative arc length at samples_per_segment steps per segment (Gauss-
+ * Legendre quadrature of the speed over each step).
+ *
+ * A distance along the curve is mapped to a curve parameter by a binary
+ * search in the table, a linear guess inside the step and one Newton step
+ * on the actual arc length, then the segment polynomial is evaluated. No
+ * basis functions are re-evaluated per sample, and equal steps in distance
+ * give equally spaced points (constant speed).
+ *
+ * Open splines extrapolate the missing end neighbors (p[-1] = 2 p[0] - p[1]),
+ * so the curve starts at the first point and ends at the last. Closed
+ * splines add a segment from the last point back to the first.
+ *
+ * Usage (internal):
+ *   SplineCore<2> core;
+ *   core.points = {...};
+ *   core.build();
+ *   SplineCore<2>::Point p = core.point_at(core.length * 0.5f);
+ */
+
+#ifndef AGENTITE_SPLINE_CORE_HPP
+#define AGENTITE_SPLINE_CORE_HPP
+
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+// Minimum number of samples per chunk in a threaded batch
+static const int64_t SPLINE_CHUNK = 2048;
+
+template <int D>
+class SplineCore {
+public:
+    using Point = std::array<float, D>;
+
+    struct Config {
+        bool closed = false;
+        int32_t samples_per_segment = 16;  // Arc-length table steps per segment
+        bool threaded = true;
+    };
+
+    Config config;
+    std::vector<Point> points;
+
+    // Per segment: position(u) = a + b u + c u^2 + d u^3, u in [0, 1]
+    struct Segment {
+        Point a, b, c, d;
+    };
+    std::vector<Segment> segments;
+
+    // Cumulative arc length at u = k / samples_per_segment of each segment,
+    // segments.size() * samples_per_segment + 1 entries, starting at 0
+    std::vector<float> lut;
+    float length = 0.0f;
+
+    int64_t segment_count() const {
+        return static_cast<int64_t>(segments.size());
+    }
+
+    // Rebuild the coefficients and the arc-length table from points
+    void build() {
+        segments.clear();
+        lut.assign(1, 0.0f);
+        length = 0.0f;
+
+        int64_t n = static_cast<int64_t>(points.size());
+        if (n < 2) {
+            return;
+        }
+
+        int64_t count = config.closed ? n : n - 1;
+        segments.resize(count);
+        for (int64_t s = 0; s < count; s++) {
+            Point p0 = neighbor(s - 1);
+            Point p1 = neighbor(s);
+            Point p2 = neighbor(s + 1);
+            Point p3 = neighbor(s + 2);
+            Segment& seg = segments[s];
+            for (int a = 0; a < D; a++) {
+                seg.a[a] = p1[a];
+                seg.b[a] = 0.5f * (p2[a] - p0[a]);
+                seg.c[a] = 0.5f * (2.0f * p0[a] - 5.0f * p1[a] + 4.0f * p2[a] - p3[a]);
+                seg.d[a] = 0.5f * (-p0[a] + 3.0f * p1[a] - 3.0f * p2[a] + p3[a]);
+            }
+        }
+
+        int32_t steps = config.samples_per_segment;
+        lut.resize(count * steps + 1);
+        double total = 0.0;
+        for (int64_t s = 0; s < count; s++) {
+            for (int32_t k = 0; k < steps; k++) {
+                float u0 = static_cast<float>(k) / steps;
+                float u1 = static_cast<float>(k + 1) / steps;
+                total += arc_length(segments[s], u0, u1);
+                lut[s * steps + k + 1] = static_cast<float>(total);
+            }
+        }
+        length = static_cast<float>(total);
+    }
+
+    static Point evaluate(const Segment& seg, float u) {
+        Point p;
+        for (int a = 0; a < D; a++) {
+            p[a] = seg.a[a] + u * (seg.b[a] + u * (seg.c[a] + u * seg.d[a]));
+        }
+        return p;
+    }
+
+    static Point derivative(const Segment& seg, float u) {
+        Point p;
+        for (int a = 0; a < D; a++) {
+            p[a] = seg.b[a] + u * (2.0f * seg.c[a] + 3.0f * u * seg.d[a]);
+        }
+        return p;
+    }
+
+    static float speed(const Segment& seg, float u) {
+        Point v = derivative(seg, u);
+        float sq = 0.0f;
+        for (int a = 0; a < D; a++) {
+            sq += v[a] * v[a];
+        }
+        return std::sqrt(sq);
+    }
+
+    // Arc length of seg over [u0, u1], 3-point Gauss-Legendre
+    static float arc_length(const Segment& seg, float u0, float u1) {
+        const float node = 0.77459667f;  // sqrt(3 / 5)
+        float half = 0.5f * (u1 - u0);
+        float mid = 0.5f * (u0 + u1);
+        float sum = (5.0f / 9.0f) * speed(seg, mid - half * node) +
+                    (8.0f / 9.0f) * speed(seg, mid) +
+                    (5.0f / 9.0f) * speed(seg, mid + half * node);
+        return sum * half;
+    }
+
+    // Segment index and parameter u at arc length distance along the curve
+    // Open splines clamp distance to [0, length]; closed splines wrap it
+    void locate(float distance, int64_t& seg, float& u) const {
+        int64_t steps_total = static_cast<int64_t>(lut.size()) - 1;
+        int32_t steps = config.samples_per_segment;
+
+        if (config.closed && length > 0.0f) {
+            distance = std::fmod(distance, length);
+            if (distance < 0.0f) {
+                distance += length;
+            }
+        }
+        distance = std::min(std::max(distance, 0.0f), length);
+
+        // Table step containing distance
+        int64_t k = static_cast<int64_t>(std::upper_bound(lut.begin(), lut.end(), distance) - lut.begin()) - 1;
+        k = std::min(std::max<int64_t>(k, 0), steps_total - 1);
+
+        seg = k / steps;
+        int64_t local = k - seg * steps;
+        float u0 = static_cast<float>(local) / steps;
+        float u1 = static_cast<float>(local + 1) / steps;
+        float span = lut[k + 1] - lut[k];
+        float f = span > 0.0f ? (distance - lut[k]) / span : 0.0f;
+        u = u0 + f * (u1 - u0);
+
+        // One Newton step on the arc length from u0
+        const Segment& s = segments[seg];
+        float v = speed(s, u);
+        if (v > 0.0f) {
+            float error = lut[k] + arc_length(s, u0, u) - distance;
+            u = std::min(std::max(u - error / v, u0), u1);
+        }
+    }
+
+    Point point_at(float distance) const {
+        int64_t seg;
+        float u;
+        locate(distance, seg, u);
+        return evaluate(segments[seg], u);
+    }
+
+    // Unit tangent (zero where the curve has zero speed)
+    Point tangent_at(float distance) const {
+        int64_t seg;
+        float u;
+        locate(distance, seg, u);
+        Point v = derivative(segments[seg], u);
+        float sq = 0.0f;
+        for (int a = 0; a < D; a++) {
+            sq += v[a] * v[a];
+        }
+        if (sq > 0.0f) {
+            float inv = 1.0f / std::sqrt(sq);
+            for (int a = 0; a < D; a++) {
+                v[a] *= inv;
+            }
+        }
+        return v;
+    }
+
+    template <typename Body>
+    void run(int64_t count, const Body& body) const {
+        if (config.threaded) {
+            parallel::for_range(count, SPLINE_CHUNK, body);
+        } else {
+            body(0, count);
+        }
+    }
+
+private:
+    // Point i of the control polygon, wrapped (closed) or extrapolated (open)
+    Point neighbor(int64_t i) const {
+        int64_t n = static_cast<int64_t>(points.size());
+        if (config.closed) {
+            return points[((i % n) + n) % n];
+        }
+        if (i < 0) {
+            return reflect(points[0], points[1]);
+        }
+        if (i >= n) {
+            return reflect(points[n - 1], points[n - 2]);
+        }
+        return points[i];
+    }
+
+    static Point reflect(const Point& end, const Point& inner) {
+        Point p;
+        for (int a = 0; a < D; a++) {
+            p[a] = 2.0f * end[a] - inner[a];
+        }
+        return p;
+    }
+};
+
+}
+
+#endif // AGENTITE_SPLINE_CORE_HPP
@@ -3,18 +3,60 @@
  */
 
 #include "math_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/simd.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace godot {
 
+// Vectors are plain float pairs / triples unless Godot is built with double precision,
+// in which case the loops below run instead of the SIMD kernels
+static constexpr bool FLOAT_VECTORS = sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 3 * sizeof(float);
+
+// Points of b per tile in distance matrices (8 KB of coordinates, stays in L1)
+static const int64_t MATRIX_TILE = 1024;
+
+// Minimum matrix entries per chunk when rows are split across threads
+static const int64_t MATRIX_CHUNK_CELLS = 16384;
+
+// Helper: Transform2D columns as the 6 floats the SIMD kernels expect
+static void transform_columns(const Transform2D& xform, float* m) {
+    m[0] = xform.columns[0].x;
+    m[1] = xform.columns[0].y;
+    m[2] = xform.columns[1].x;
+    m[3] = xform.columns[1].y;
+    m[4] = xform.columns[2].x;
+    m[5] = xform.columns[2].y;
+}
+
+// Helper: distance matrix over coordinate arrays, in tiles of b, rows spread over threads
+static void distance_matrix_2d_tiled(const float* ax, const float* ay, int64_t count_a,
+                                     const float* bx, const float* by, int64_t count_b, float* dst) {
+    const simd::Kernels& k = simd::kernels();
+    int64_t min_rows = std::max<int64_t>(1, MATRIX_CHUNK_CELLS / std::max<int64_t>(1, count_b));
+
+    parallel::for_range(count_a, min_rows, [&](int64_t begin, int64_t end) {
+        for (int64_t j0 = 0; j0 < count_b; j0 += MATRIX_TILE) {
+            int64_t len = std::min(MATRIX_TILE, count_b - j0);
+            for (int64_t i = begin; i < end; i++) {
+                k.distance_row_2d(ax[i], ay[i], bx + j0, by + j0, dst + i * count_b + j0, len);
+            }
+        }
+    });
+}
+
 void MathOps::_bind_methods() {
     // Normalization
     ClassDB::bind_static_method("MathOps", D_METHOD("normalize_batch_2d", "vectors"), &MathOps::normalize_batch_2d);
     ClassDB::bind_static_method("MathOps", D_METHOD("normalize_batch_3d", "vectors"), &MathOps::normalize_batch_3d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("normalize_batch_2d_in_place", "vectors"), &MathOps::normalize_batch_2d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("normalize_batch_3d_in_place", "vectors"), &MathOps::normalize_batch_3d_in_place);
 
     // Dot products
     ClassDB::bind_static_method("MathOps", D_METHOD("dot_batch_2d", "a", "b"), &MathOps::dot_batch_2d);
@@ -51,6 +93,12 @@ void MathOps::_bind_methods() {
     ClassDB::bind_static_method("MathOps", D_METHOD("sub_batch_3d", "a", "b"), &MathOps::sub_batch_3d);
     ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_2d", "vectors", "scalar"), &MathOps::scale_batch_2d);
     ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_3d", "vectors", "scalar"), &MathOps::scale_batch_3d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("add_batch_2d_in_place", "a", "b"), &MathOps::add_batch_2d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("add_batch_3d_in_place", "a", "b"), &MathOps::add_batch_3d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("sub_batch_2d_in_place", "a", "b"), &MathOps::sub_batch_2d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("sub_batch_3d_in_place", "a", "b"), &MathOps::sub_batch_3d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_2d_in_place", "vectors", "scalar"), &MathOps::scale_batch_2d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_3d_in_place", "vectors", "scalar"), &MathOps::scale_batch_3d_in_place);
     ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_2d_weights", "vectors", "scalars"), &MathOps::scale_batch_2d_weights);
     ClassDB::bind_static_method("MathOps", D_METHOD("scale_batch_3d_weights", "vectors", "scalars"), &MathOps::scale_batch_3d_weights);
 
@@ -79,21 +127,36 @@ void MathOps::_bind_methods() {
     // Clamping
     ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_batch_2d", "vectors", "max_length"), &MathOps::clamp_length_batch_2d);
     ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_batch_3d", "vectors", "max_length"), &MathOps::clamp_length_batch_3d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_batch_2d_in_place", "vectors", "max_length"), &MathOps::clamp_length_batch_2d_in_place);
+    ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_batch_3d_in_place", "vectors", "max_length"), &MathOps::clamp_length_batch_3d_in_place);
     ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_range_batch_2d", "vectors", "min_length", "max_length"), &MathOps::clamp_length_range_batch_2d);
     ClassDB::bind_static_method("MathOps", D_METHOD("clamp_length_range_batch_3d", "vectors", "min_length", "max_length"), &MathOps::clamp_length_range_batch_3d);
+
+    // Structure of arrays
+    ClassDB::bind_static_method("MathOps", D_METHOD("to_soa_2d", "vectors"), &MathOps::to_soa_2d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("to_soa_3d", "vectors"), &MathOps::to_soa_3d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("from_soa_2d", "x", "y"), &MathOps::from_soa_2d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("from_soa_3d", "x", "y", "z"), &MathOps::from_soa_3d);
+    ClassDB::bind_static_method("MathOps", D_METHOD("length_batch_2d_soa", "x", "y"), &MathOps::length_batch_2d_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("normalize_batch_2d_soa", "x", "y"), &MathOps::normalize_batch_2d_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("distance_batch_2d_soa", "ax", "ay", "bx", "by"), &MathOps::distance_batch_2d_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("dot_batch_3d_soa", "ax", "ay", "az", "bx", "by", "bz"), &MathOps::dot_batch_3d_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("transform_2d_batch_soa", "xform", "x", "y"), &MathOps::transform_2d_batch_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("distance_matrix_2d_soa", "ax", "ay", "bx", "by"), &MathOps::distance_matrix_2d_soa);
+    ClassDB::bind_static_method("MathOps", D_METHOD("get_simd_level"), &MathOps::get_simd_level);
 }
 
 // ========== NORMALIZATION ==========
 
-PackedVector2Array MathOps::normalize_batch_2d(const PackedVector2Array& vectors) {
-    int32_t count = vectors.size();
-    PackedVector2Array result;
-    result.resize(count);
+// Kernels shared by the returning and *_in_place variants; dst may be src
 
-    const Vector2* src = vectors.ptr();
-    Vector2* dst = result.ptrw();
+static void normalize_2d(const Vector2* src, Vector2* dst, int64_t count) {
+    if (FLOAT_VECTORS) {
+        simd::kernels().normalize_2d_aos(reinterpret_cast<const float*>(src), reinterpret_cast<float*>(dst), count);
+        return;
+    }
 
-    for (int32_t i = 0; i < count; i++) {
+    for (int64_t i = 0; i < count; i++) {
         float len_sq = src[i].x * src[i].x + src[i].y * src[i].y;
         if (len_sq > 0.0f) {
             float inv_len = 1.0f / std::sqrt(len_sq);
@@ -102,19 +165,10 @@ PackedVector2Array MathOps::normalize_batch_2d(const PackedVector2Array& vectors
             dst[i] = Vector2(0.0f, 0.0f);
         }
     }
-
-    return result;
 }
 
-PackedVector3Array MathOps::normalize_batch_3d(const PackedVector3Array& vectors) {
-    int32_t count = vectors.size();
-    PackedVector3Array result;
-    result.resize(count);
-
-    const Vector3* src = vectors.ptr();
-    Vector3* dst = result.ptrw();
-
-    for (int32_t i = 0; i < count; i++) {
+static void normalize_3d(const Vector3* src, Vector3* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
         float len_sq = src[i].x * src[i].x + src[i].y * src[i].y + src[i].z * src[i].z;
         if (len_sq > 0.0f) {
             float inv_len = 1.0f / std::sqrt(len_sq);
@@ -123,10 +177,40 @@ PackedVector3Array MathOps::normalize_batch_3d(const PackedVector3Array& vectors
             dst[i] = Vector3(0.0f, 0.0f, 0.0f);
         }
     }
+}
 
+PackedVector2Array MathOps::normalize_batch_2d(const PackedVector2Array& vectors) {
+    int32_t count = vectors.size();
+    PackedVector2Array result;
+    result.resize(count);
+    normalize_2d(vectors.ptr(), result.ptrw(), count);
+    return result;
+}
+
+PackedVector3Array MathOps::normalize_batch_3d(const PackedVector3Array& vectors) {
+    int32_t count = vectors.size();
+    PackedVector3Array result;
+    result.resize(count);
+    normalize_3d(vectors.ptr(), result.ptrw(), count);
     return result;
 }
 
+void MathOps::normalize_batch_2d_in_place(const Ref<Vector2Buffer>& vectors) {
+    if (!vector_buffer::check(vectors, "normalize_batch_2d_in_place", -1)) {
+        return;
+    }
+    Vector2* ptr = vectors->data().ptrw();
+    normalize_2d(ptr, ptr, vectors->size());
+}
+
+void MathOps::normalize_batch_3d_in_place(const Ref<Vector3Buffer>& vectors) {
+    if (!vector_buffer::check(vectors, "normalize_batch_3d_in_place", -1)) {
+        return;
+    }
+    Vector3* ptr = vectors->data().ptrw();
+    normalize_3d(ptr, ptr, vectors->size());
+}
+
 // ========== DOT PRODUCTS ==========
 
 PackedFloat32Array MathOps::dot_batch_2d(const PackedVector2Array& a, const PackedVector2Array& b) {
@@ -154,6 +238,11 @@ PackedFloat32Array MathOps::dot_batch_3d(const PackedVector3Array& a, const Pack
     const Vector3* pb = b.ptr();
     float* dst = result.ptrw();
 
+    if (FLOAT_VECTORS) {
+        simd::kernels().dot_3d_aos(reinterpret_cast<const float*>(pa), reinterpret_cast<const float*>(pb), dst, count);
+        return result;
+    }
+
     for (int32_t i = 0; i < count; i++) {
         dst[i] = pa[i].x * pb[i].x + pa[i].y * pb[i].y + pa[i].z * pb[i].z;
     }
@@ -272,6 +361,11 @@ PackedFloat32Array MathOps::distance_batch_2d(const PackedVector2Array& a, const
     const Vector2* pb = b.ptr();
     float* dst = result.ptrw();
 
+    if (FLOAT_VECTORS) {
+        simd::kernels().distance_2d_aos(reinterpret_cast<const float*>(pa), reinterpret_cast<const float*>(pb), dst, count);
+        return result;
+    }
+
     for (int32_t i = 0; i < count; i++) {
         float dx = pb[i].x - pa[i].x;
         float dy = pb[i].y - pa[i].y;
@@ -338,23 +432,26 @@ PackedFloat32Array MathOps::distance_squared_batch_3d(const PackedVector3Array&
 }
 
 PackedFloat32Array MathOps::distance_matrix_2d(const PackedVector2Array& a, const PackedVector2Array& b) {
-    int32_t count_a = a.size();
-    int32_t count_b = b.size();
+    int64_t count_a = a.size();
+    int64_t count_b = b.size();
     PackedFloat32Array result;
     result.resize(count_a * count_b);
 
     const Vector2* pa = a.ptr();
     const Vector2* pb = b.ptr();
-    float* dst = result.ptrw();
 
-    for (int32_t i = 0; i < count_a; i++) {
-        for (int32_t j = 0; j < count_b; j++) {
-            float dx = pb[j].x - pa[i].x;
-            float dy = pb[j].y - pa[i].y;
-            dst[i * count_b + j] = std::sqrt(dx * dx + dy * dy);
-        }
+    // Coordinates as separate arrays so each row is a straight SIMD loop
+    std::vector<float> ax(count_a), ay(count_a), bx(count_b), by(count_b);
+    for (int64_t i = 0; i < count_a; i++) {
+        ax[i] = pa[i].x;
+        ay[i] = pa[i].y;
+    }
+    for (int64_t j = 0; j < count_b; j++) {
+        bx[j] = pb[j].x;
+        by[j] = pb[j].y;
     }
 
+    distance_matrix_2d_tiled(ax.data(), ay.data(), count_a, bx.data(), by.data(), count_b, result.ptrw());
     return result;
 }
 
@@ -470,19 +567,49 @@ PackedVector3Array MathOps::lerp_batch_3d_weights(const PackedVector3Array& a, c
 
 // ========== VECTOR ARITHMETIC ==========
 
-PackedVector2Array MathOps::add_batch_2d(const PackedVector2Array& a, const PackedVector2Array& b) {
-    int32_t count = std::min(a.size(), b.size());
-    PackedVector2Array result;
-    result.resize(count);
+// Kernels shared by the returning and *_in_place variants; dst may be an input
 
-    const Vector2* pa = a.ptr();
-    const Vector2* pb = b.ptr();
-    Vector2* dst = result.ptrw();
+static void add_2d(const Vector2* a, const Vector2* b, Vector2* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector2(a[i].x + b[i].x, a[i].y + b[i].y);
+    }
+}
 
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector2(pa[i].x + pb[i].x, pa[i].y + pb[i].y);
+static void add_3d(const Vector3* a, const Vector3* b, Vector3* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector3(a[i].x + b[i].x, a[i].y + b[i].y, a[i].z + b[i].z);
+    }
+}
+
+static void sub_2d(const Vector2* a, const Vector2* b, Vector2* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector2(a[i].x - b[i].x, a[i].y - b[i].y);
+    }
+}
+
+static void sub_3d(const Vector3* a, const Vector3* b, Vector3* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector3(a[i].x - b[i].x, a[i].y - b[i].y, a[i].z - b[i].z);
+    }
+}
+
+static void scale_2d(const Vector2* src, float scalar, Vector2* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector2(src[i].x * scalar, src[i].y * scalar);
     }
+}
+
+static void scale_3d(const Vector3* src, float scalar, Vector3* dst, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector3(src[i].x * scalar, src[i].y * scalar, src[i].z * scalar);
+    }
+}
 
+PackedVector2Array MathOps::add_batch_2d(const PackedVector2Array& a, const PackedVector2Array& b) {
+    int32_t count = std::min(a.size(), b.size());
+    PackedVector2Array result;
+    result.resize(count);
+    add_2d(a.ptr(), b.ptr(), result.ptrw(), count);
     return result;
 }
 
@@ -490,15 +617,7 @@ PackedVector3Array MathOps::add_batch_3d(const PackedVector3Array& a, const Pack
     int32_t count = std::min(a.size(), b.size());
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* pa = a.ptr();
-    const Vector3* pb = b.ptr();
-    Vector3* dst = result.ptrw();
-
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector3(pa[i].x + pb[i].x, pa[i].y + pb[i].y, pa[i].z + pb[i].z);
-    }
-
+    add_3d(a.ptr(), b.ptr(), result.ptrw(), count);
     return result;
 }
 
@@ -506,15 +625,7 @@ PackedVector2Array MathOps::sub_batch_2d(const PackedVector2Array& a, const Pack
     int32_t count = std::min(a.size(), b.size());
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* pa = a.ptr();
-    const Vector2* pb = b.ptr();
-    Vector2* dst = result.ptrw();
-
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector2(pa[i].x - pb[i].x, pa[i].y - pb[i].y);
-    }
-
+    sub_2d(a.ptr(), b.ptr(), result.ptrw(), count);
     return result;
 }
 
@@ -522,15 +633,7 @@ PackedVector3Array MathOps::sub_batch_3d(const PackedVector3Array& a, const Pack
     int32_t count = std::min(a.size(), b.size());
     PackedVector3Array result;
     result.resize(count);
-
-    const Vector3* pa = a.ptr();
-    const Vector3* pb = b.ptr();
-    Vector3* dst = result.ptrw();
-
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector3(pa[i].x - pb[i].x, pa[i].y - pb[i].y, pa[i].z - pb[i].z);
-    }
-
+    sub_3d(a.ptr(), b.ptr(), result.ptrw(), count);
     return result;
 }
 
@@ -538,14 +641,7 @@ PackedVector2Array MathOps::scale_batch_2d(const PackedVector2Array& vectors, fl
     int32_t count = vectors.size();
     PackedVector2Array result;
     result.resize(count);
-
-    const Vector2* src = vectors.ptr();
-    Vector2* dst = result.ptrw();
-
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector2(src[i].x * scalar, src[i].y * scalar);
-    }
-
+    scale_2d(vectors.ptr(), scalar, result.ptrw(), count);
     return result;
 }
 
@@ -553,15 +649,56 @@ PackedVector3Array MathOps::scale_batch_3d(const PackedVector3Array& vectors, fl
     int32_t count = vectors.size();
     PackedVector3Array result;
     result.resize(count);
+    scale_3d(vectors.ptr(), scalar, result.ptrw(), count);
+    return result;
+}
 
-    const Vector3* src = vectors.ptr();
-    Vector3* dst = result.ptrw();
+void MathOps::add_batch_2d_in_place(const Ref<Vector2Buffer>& a, const PackedVector2Array& b) {
+    if (!vector_buffer::check(a, "add_batch_2d_in_place", b.size())) {
+        return;
+    }
+    Vector2* ptr = a->data().ptrw();
+    add_2d(ptr, b.ptr(), ptr, b.size());
+}
 
-    for (int32_t i = 0; i < count; i++) {
-        dst[i] = Vector3(src[i].x * scalar, src[i].y * scalar, src[i].z * scalar);
+void MathOps::add_batch_3d_in_place(const Ref<Vector3Buffer>& a, const PackedVector3Array& b) {
+    if (!vector_buffer::check(a, "add_batch_3d_in_place", b.size())) {
+        return;
     }
+    Vector3* ptr = a->data().ptrw();
+    add_3d(ptr, b.ptr(), ptr, b.size());
+}
 
-    return result;
+void MathOps::sub_batch_2d_in_place(const Ref<Vector2Buffer>& a, const PackedVector2Array& b) {
+    if (!vector_buffer::check(a, "sub_batch_2d_in_place", b.size())) {
+        return;
+    }
+    Vector2* ptr = a->data().ptrw();
+    sub_2d(ptr, b.ptr(), ptr, b.size());
+}
+
+void MathOps::sub_batch_3d_in_place(const Ref<Vector3Buffer>& a, const PackedVector3Array& b) {
+    if (!vector_buffer::check(a, "sub_batch_3d_in_place", b.size())) {
+        return;
+    }
+    Vector3* ptr = a->data().ptrw();
+    sub_3d(ptr, b.ptr(), ptr, b.size());
+}
+
+void MathOps::scale_batch_2d_in_place(const Ref<Vector2Buffer>& vectors, float scalar) {
+    if (!vector_buffer::check(vectors, "scale_batch_2d_in_place", -1)) {
+        return;
+    }
+    Vector2* ptr = vectors->data().ptrw();
+    scale_2d(ptr, scalar, ptr, vectors->size());
+}
+
+void MathOps::scale_batch_3d_in_place(const Ref<Vector3Buffer>& vectors, float scalar) {
+    if (!vector_buffer::check(vectors, "scale_batch_3d_in_place", -1)) {
+        return;
+    }
+    Vector3* ptr = vectors->data().ptrw();
+    scale_3d(ptr, scalar, ptr, vectors->size());
 }
 
 PackedVector2Array MathOps::scale_batch_2d_weights(const PackedVector2Array& vectors, const PackedFloat32Array& scalars) {
@@ -657,6 +794,13 @@ PackedVector2Array MathOps::transform_2d_batch(const Transform2D& xform, const P
     const Vector2* src = points.ptr();
     Vector2* dst = result.ptrw();
 
+    if (FLOAT_VECTORS) {
+        float m[6];
+        transform_columns(xform, m);
+        simd::kernels().transform_2d_aos(m, reinterpret_cast<const float*>(src), reinterpret_cast<float*>(dst), count);
+        return result;
+    }
+
     for (int32_t i = 0; i < count; i++) {
         dst[i] = xform.xform(src[i]);
     }
@@ -883,16 +1027,10 @@ PackedVector3Array MathOps::reflect_batch_3d(const PackedVector3Array& vectors,
 
 // ========== CLAMPING ==========
 
-PackedVector2Array MathOps::clamp_length_batch_2d(const PackedVector2Array& vectors, float max_length) {
-    int32_t count = vectors.size();
-    PackedVector2Array result;
-    result.resize(count);
-
-    const Vector2* src = vectors.ptr();
-    Vector2* dst = result.ptrw();
+static void clamp_length_2d(const Vector2* src, float max_length, Vector2* dst, int64_t count) {
     float max_len_sq = max_length * max_length;
 
-    for (int32_t i = 0; i < count; i++) {
+    for (int64_t i = 0; i < count; i++) {
         float len_sq = src[i].x * src[i].x + src[i].y * src[i].y;
         if (len_sq > max_len_sq && len_sq > 0.0f) {
             float scale = max_length / std::sqrt(len_sq);
@@ -901,20 +1039,12 @@ PackedVector2Array MathOps::clamp_length_batch_2d(const PackedVector2Array& vect
             dst[i] = src[i];
         }
     }
-
-    return result;
 }
 
-PackedVector3Array MathOps::clamp_length_batch_3d(const PackedVector3Array& vectors, float max_length) {
-    int32_t count = vectors.size();
-    PackedVector3Array result;
-    result.resize(count);
-
-    const Vector3* src = vectors.ptr();
-    Vector3* dst = result.ptrw();
+static void clamp_length_3d(const Vector3* src, float max_length, Vector3* dst, int64_t count) {
     float max_len_sq = max_length * max_length;
 
-    for (int32_t i = 0; i < count; i++) {
+    for (int64_t i = 0; i < count; i++) {
         float len_sq = src[i].x * src[i].x + src[i].y * src[i].y + src[i].z * src[i].z;
         if (len_sq > max_len_sq && len_sq > 0.0f) {
             float scale = max_length / std::sqrt(len_sq);
@@ -923,10 +1053,40 @@ PackedVector3Array MathOps::clamp_length_batch_3d(const PackedVector3Array& vect
             dst[i] = src[i];
         }
     }
+}
+
+PackedVector2Array MathOps::clamp_length_batch_2d(const PackedVector2Array& vectors, float max_length) {
+    int32_t count = vectors.size();
+    PackedVector2Array result;
+    result.resize(count);
+    clamp_length_2d(vectors.ptr(), max_length, result.ptrw(), count);
+    return result;
+}
 
+PackedVector3Array MathOps::clamp_length_batch_3d(const PackedVector3Array& vectors, float max_length) {
+    int32_t count = vectors.size();
+    PackedVector3Array result;
+    result.resize(count);
+    clamp_length_3d(vectors.ptr(), max_length, result.ptrw(), count);
     return result;
 }
 
+void MathOps::clamp_length_batch_2d_in_place(const Ref<Vector2Buffer>& vectors, float max_length) {
+    if (!vector_buffer::check(vectors, "clamp_length_batch_2d_in_place", -1)) {
+        return;
+    }
+    Vector2* ptr = vectors->data().ptrw();
+    clamp_length_2d(ptr, max_length, ptr, vectors->size());
+}
+
+void MathOps::clamp_length_batch_3d_in_place(const Ref<Vector3Buffer>& vectors, float max_length) {
+    if (!vector_buffer::check(vectors, "clamp_length_batch_3d_in_place", -1)) {
+        return;
+    }
+    Vector3* ptr = vectors->data().ptrw();
+    clamp_length_3d(ptr, max_length, ptr, vectors->size());
+}
+
 PackedVector2Array MathOps::clamp_length_range_batch_2d(const PackedVector2Array& vectors, float min_length, float max_length) {
     int32_t count = vectors.size();
     PackedVector2Array result;
@@ -979,4 +1139,160 @@ PackedVector3Array MathOps::clamp_length_range_batch_3d(const PackedVector3Array
     return result;
 }
 
+
+// ========== STRUCTURE OF ARRAYS ==========
+
+Array MathOps::to_soa_2d(const PackedVector2Array& vectors) {
+    int64_t count = vectors.size();
+    PackedFloat32Array x, y;
+    x.resize(count);
+    y.resize(count);
+
+    const Vector2* src = vectors.ptr();
+    float* px = x.ptrw();
+    float* py = y.ptrw();
+
+    for (int64_t i = 0; i < count; i++) {
+        px[i] = src[i].x;
+        py[i] = src[i].y;
+    }
+
+    Array result;
+    result.append(x);
+    result.append(y);
+    return result;
+}
+
+Array MathOps::to_soa_3d(const PackedVector3Array& vectors) {
+    int64_t count = vectors.size();
+    PackedFloat32Array x, y, z;
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+
+    const Vector3* src = vectors.ptr();
+    float* px = x.ptrw();
+    float* py = y.ptrw();
+    float* pz = z.ptrw();
+
+    for (int64_t i = 0; i < count; i++) {
+        px[i] = src[i].x;
+        py[i] = src[i].y;
+        pz[i] = src[i].z;
+    }
+
+    Array result;
+    result.append(x);
+    result.append(y);
+    result.append(z);
+    return result;
+}
+
+PackedVector2Array MathOps::from_soa_2d(const PackedFloat32Array& x, const PackedFloat32Array& y) {
+    int64_t count = std::min(x.size(), y.size());
+    PackedVector2Array result;
+    result.resize(count);
+
+    const float* px = x.ptr();
+    const float* py = y.ptr();
+    Vector2* dst = result.ptrw();
+
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector2(px[i], py[i]);
+    }
+
+    return result;
+}
+
+PackedVector3Array MathOps::from_soa_3d(const PackedFloat32Array& x, const PackedFloat32Array& y, const PackedFloat32Array& z) {
+    int64_t count = std::min({x.size(), y.size(), z.size()});
+    PackedVector3Array result;
+    result.resize(count);
+
+    const float* px = x.ptr();
+    const float* py = y.ptr();
+    const float* pz = z.ptr();
+    Vector3* dst = result.ptrw();
+
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Vector3(px[i], py[i], pz[i]);
+    }
+
+    return result;
+}
+
+PackedFloat32Array MathOps::length_batch_2d_soa(const PackedFloat32Array& x, const PackedFloat32Array& y) {
+    int64_t count = std::min(x.size(), y.size());
+    PackedFloat32Array result;
+    result.resize(count);
+
+    simd::kernels().length_2d_soa(x.ptr(), y.ptr(), result.ptrw(), count);
+    return result;
+}
+
+Array MathOps::normalize_batch_2d_soa(const PackedFloat32Array& x, const PackedFloat32Array& y) {
+    int64_t count = std::min(x.size(), y.size());
+    PackedFloat32Array out_x, out_y;
+    out_x.resize(count);
+    out_y.resize(count);
+
+    simd::kernels().normalize_2d_soa(x.ptr(), y.ptr(), out_x.ptrw(), out_y.ptrw(), count);
+
+    Array result;
+    result.append(out_x);
+    result.append(out_y);
+    return result;
+}
+
+PackedFloat32Array MathOps::distance_batch_2d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay,
+                                                  const PackedFloat32Array& bx, const PackedFloat32Array& by) {
+    int64_t count = std::min({ax.size(), ay.size(), bx.size(), by.size()});
+    PackedFloat32Array result;
+    result.resize(count);
+
+    simd::kernels().distance_2d_soa(ax.ptr(), ay.ptr(), bx.ptr(), by.ptr(), result.ptrw(), count);
+    return result;
+}
+
+PackedFloat32Array MathOps::dot_batch_3d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay, const PackedFloat32Array& az,
+                                             const PackedFloat32Array& bx, const PackedFloat32Array& by, const PackedFloat32Array& bz) {
+    int64_t count = std::min({ax.size(), ay.size(), az.size(), bx.size(), by.size(), bz.size()});
+    PackedFloat32Array result;
+    result.resize(count);
+
+    simd::kernels().dot_3d_soa(ax.ptr(), ay.ptr(), az.ptr(), bx.ptr(), by.ptr(), bz.ptr(), result.ptrw(), count);
+    return result;
+}
+
+Array MathOps::transform_2d_batch_soa(const Transform2D& xform, const PackedFloat32Array& x, const PackedFloat32Array& y) {
+    int64_t count = std::min(x.size(), y.size());
+    PackedFloat32Array out_x, out_y;
+    out_x.resize(count);
+    out_y.resize(count);
+
+    float m[6];
+    transform_columns(xform, m);
+    simd::kernels().transform_2d_soa(m, x.ptr(), y.ptr(), out_x.ptrw(), out_y.ptrw(), count);
+
+    Array result;
+    result.append(out_x);
+    result.append(out_y);
+    return result;
+}
+
+PackedFloat32Array MathOps::distance_matrix_2d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay,
+                                                   const PackedFloat32Array& bx, const PackedFloat32Array& by) {
+    int64_t count_a = std::min(ax.size(), ay.size());
+    int64_t count_b = std::min(bx.size(), by.size());
+    PackedFloat32Array result;
+    result.resize(count_a * count_b);
+
+    distance_matrix_2d_tiled(ax.ptr(), ay.ptr(), count_a, bx.ptr(), by.ptr(), count_b, result.ptrw());
+    return result;
+}
+
+String MathOps::get_simd_level() {
+    return String(simd::get_level_name(simd::get_level()));
+}
+
 }
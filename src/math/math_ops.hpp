@@ -4,6 +4,14 @@
  * Provides high-performance batch vector and matrix operations
  * that avoid the overhead of GDScript loops.
  *
+ * The hot kernels (normalize, distance, dot, transform, distance matrix)
+ * use SSE2, AVX2 or NEON, picked at runtime for the CPU. The *_soa
+ * variants take separate x/y(/z) float arrays, which vectorize without
+ * any shuffling.
+ *
+ * The *_in_place variants update a Vector2Buffer / Vector3Buffer in its own
+ * memory instead of allocating a result array.
+ *
  * Usage:
  *   # Normalize many vectors at once
  *   var normals = MathOps.normalize_batch_2d(vectors)
@@ -18,7 +26,10 @@
 #ifndef AGENTITE_MATH_OPS_HPP
 #define AGENTITE_MATH_OPS_HPP
 
+#include "arrays/vector_buffer.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
@@ -26,6 +37,7 @@
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/variant/transform2d.hpp>
 #include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/string.hpp>
 
 namespace godot {
 
@@ -40,6 +52,8 @@ public:
     // Normalize vectors (safe: zero vectors become zero)
     static PackedVector2Array normalize_batch_2d(const PackedVector2Array& vectors);
     static PackedVector3Array normalize_batch_3d(const PackedVector3Array& vectors);
+    static void normalize_batch_2d_in_place(const Ref<Vector2Buffer>& vectors);
+    static void normalize_batch_3d_in_place(const Ref<Vector3Buffer>& vectors);
 
     // ========== DOT PRODUCTS ==========
     // Pairwise dot products: result[i] = a[i].dot(b[i])
@@ -91,6 +105,13 @@ public:
     // Scalar multiplication
     static PackedVector2Array scale_batch_2d(const PackedVector2Array& vectors, float scalar);
     static PackedVector3Array scale_batch_3d(const PackedVector3Array& vectors, float scalar);
+    // In-place: a += b, a -= b, vectors *= scalar (sizes must match)
+    static void add_batch_2d_in_place(const Ref<Vector2Buffer>& a, const PackedVector2Array& b);
+    static void add_batch_3d_in_place(const Ref<Vector3Buffer>& a, const PackedVector3Array& b);
+    static void sub_batch_2d_in_place(const Ref<Vector2Buffer>& a, const PackedVector2Array& b);
+    static void sub_batch_3d_in_place(const Ref<Vector3Buffer>& a, const PackedVector3Array& b);
+    static void scale_batch_2d_in_place(const Ref<Vector2Buffer>& vectors, float scalar);
+    static void scale_batch_3d_in_place(const Ref<Vector3Buffer>& vectors, float scalar);
     // Per-element scalar multiplication
     static PackedVector2Array scale_batch_2d_weights(const PackedVector2Array& vectors, const PackedFloat32Array& scalars);
     static PackedVector3Array scale_batch_3d_weights(const PackedVector3Array& vectors, const PackedFloat32Array& scalars);
@@ -130,9 +151,35 @@ public:
     // Clamp vector lengths
     static PackedVector2Array clamp_length_batch_2d(const PackedVector2Array& vectors, float max_length);
     static PackedVector3Array clamp_length_batch_3d(const PackedVector3Array& vectors, float max_length);
+    static void clamp_length_batch_2d_in_place(const Ref<Vector2Buffer>& vectors, float max_length);
+    static void clamp_length_batch_3d_in_place(const Ref<Vector3Buffer>& vectors, float max_length);
     // Clamp vector lengths with min and max
     static PackedVector2Array clamp_length_range_batch_2d(const PackedVector2Array& vectors, float min_length, float max_length);
     static PackedVector3Array clamp_length_range_batch_3d(const PackedVector3Array& vectors, float min_length, float max_length);
+
+    // ========== STRUCTURE OF ARRAYS ==========
+    // Split vectors into coordinate arrays: [x, y] / [x, y, z] (PackedFloat32Array each)
+    static Array to_soa_2d(const PackedVector2Array& vectors);
+    static Array to_soa_3d(const PackedVector3Array& vectors);
+    // Join coordinate arrays back into vectors
+    static PackedVector2Array from_soa_2d(const PackedFloat32Array& x, const PackedFloat32Array& y);
+    static PackedVector3Array from_soa_3d(const PackedFloat32Array& x, const PackedFloat32Array& y, const PackedFloat32Array& z);
+
+    // Same results as the vector versions, on coordinate arrays
+    static PackedFloat32Array length_batch_2d_soa(const PackedFloat32Array& x, const PackedFloat32Array& y);
+    // Returns [x, y]
+    static Array normalize_batch_2d_soa(const PackedFloat32Array& x, const PackedFloat32Array& y);
+    static PackedFloat32Array distance_batch_2d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay,
+                                                    const PackedFloat32Array& bx, const PackedFloat32Array& by);
+    static PackedFloat32Array dot_batch_3d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay, const PackedFloat32Array& az,
+                                               const PackedFloat32Array& bx, const PackedFloat32Array& by, const PackedFloat32Array& bz);
+    // Returns [x, y]
+    static Array transform_2d_batch_soa(const Transform2D& xform, const PackedFloat32Array& x, const PackedFloat32Array& y);
+    static PackedFloat32Array distance_matrix_2d_soa(const PackedFloat32Array& ax, const PackedFloat32Array& ay,
+                                                     const PackedFloat32Array& bx, const PackedFloat32Array& by);
+
+    // Instruction set used by the kernels: "avx2", "sse2", "neon" or "scalar"
+    static String get_simd_level();
 };
 
 }
@@ -6,11 +6,15 @@
  */
 
 #include "noise_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/simd.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 namespace godot {
 
@@ -50,6 +54,36 @@ static inline int fast_floor(float x) {
     return x < xi ? xi - 1 : xi;
 }
 
+// ========== GRID HELPERS ==========
+
+// Minimum cells per chunk when grid rows are split across threads
+static const int64_t GRID_CHUNK_CELLS = 4096;
+
+// SIMD row kernel: out[i] = noise(x[i], y) (see core/simd.hpp)
+typedef void (*NoiseRowKernel)(const int32_t* perm, const float* x, float y, float* out, int64_t count);
+
+// Helper: rows per chunk so each chunk covers at least GRID_CHUNK_CELLS cells
+static int64_t grid_row_chunk(int64_t width) {
+    return std::max<int64_t>(1, GRID_CHUNK_CELLS / width);
+}
+
+// Helper: single-octave 2D grid, one kernel call per row, rows split across threads.
+// Coordinates are computed exactly as the scalar loops did, so results match them bit for bit.
+static void fill_noise_grid_2d(NoiseRowKernel kernel, const int32_t* perm, const Vector2& origin,
+                               const Vector2& cell_size, float frequency, int width, int height, float* dst) {
+    std::vector<float> xs(width);
+    for (int x = 0; x < width; x++) {
+        xs[x] = (origin.x + x * cell_size.x) * frequency;
+    }
+
+    parallel::for_range(height, grid_row_chunk(width), [&](int64_t begin, int64_t end) {
+        for (int y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+            float py = (origin.y + y * cell_size.y) * frequency;
+            kernel(perm, xs.data(), py, dst + static_cast<int64_t>(y) * width, width);
+        }
+    });
+}
+
 // ========== BINDING ==========
 
 void NoiseOps::_bind_methods() {
@@ -111,6 +145,12 @@ void NoiseOps::_bind_methods() {
     ClassDB::bind_method(D_METHOD("warp_2d", "positions", "strength"), &NoiseOps::warp_2d);
     ClassDB::bind_method(D_METHOD("warp_3d", "positions", "strength"), &NoiseOps::warp_3d);
 
+    // Volumes
+    ClassDB::bind_method(D_METHOD("fbm_3d_volume", "origin", "cell_size", "dims", "warp_strength", "padding"),
+                         &NoiseOps::fbm_3d_volume, DEFVAL(0.0f), DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("ridged_3d_volume", "origin", "cell_size", "dims", "warp_strength", "padding"),
+                         &NoiseOps::ridged_3d_volume, DEFVAL(0.0f), DEFVAL(0));
+
     // Properties
     ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "octaves"), "set_octaves", "get_octaves");
@@ -152,6 +192,10 @@ void NoiseOps::rebuild_permutation() {
         perm12[i] = perm[i] % 12;
         perm12[i + 256] = perm12[i];
     }
+
+    for (int i = 0; i < 512; i++) {
+        perm_lanes[i] = perm[i];
+    }
 }
 
 // ========== CONFIGURATION ==========
@@ -309,15 +353,8 @@ PackedFloat32Array NoiseOps::perlin_2d_grid(const Vector2& origin, const Vector2
 
     PackedFloat32Array result;
     result.resize(width * height);
-    float* dst = result.ptrw();
 
-    for (int y = 0; y < height; y++) {
-        float py = (origin.y + y * cell_size.y) * frequency;
-        for (int x = 0; x < width; x++) {
-            float px = (origin.x + x * cell_size.x) * frequency;
-            dst[y * width + x] = perlin_2d_single(px, py);
-        }
-    }
+    fill_noise_grid_2d(simd::kernels().perlin_2d_row, perm_lanes, origin, cell_size, frequency, width, height, result.ptrw());
 
     return result;
 }
@@ -329,16 +366,20 @@ PackedFloat32Array NoiseOps::perlin_3d_grid(const Vector3& origin, const Vector3
     result.resize(width * height * depth);
     float* dst = result.ptrw();
 
-    for (int z = 0; z < depth; z++) {
-        float pz = (origin.z + z * cell_size.z) * frequency;
-        for (int y = 0; y < height; y++) {
+    // One task item per (z, y) row
+    parallel::for_range(static_cast<int64_t>(depth) * height, grid_row_chunk(width), [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; row++) {
+            int z = static_cast<int>(row / height);
+            int y = static_cast<int>(row % height);
+            float pz = (origin.z + z * cell_size.z) * frequency;
             float py = (origin.y + y * cell_size.y) * frequency;
+            float* out = dst + row * width;
             for (int x = 0; x < width; x++) {
                 float px = (origin.x + x * cell_size.x) * frequency;
-                dst[z * width * height + y * width + x] = perlin_3d_single(px, py, pz);
+                out[x] = perlin_3d_single(px, py, pz);
             }
         }
-    }
+    });
 
     return result;
 }
@@ -515,15 +556,8 @@ PackedFloat32Array NoiseOps::simplex_2d_grid(const Vector2& origin, const Vector
 
     PackedFloat32Array result;
     result.resize(width * height);
-    float* dst = result.ptrw();
 
-    for (int y = 0; y < height; y++) {
-        float py = (origin.y + y * cell_size.y) * frequency;
-        for (int x = 0; x < width; x++) {
-            float px = (origin.x + x * cell_size.x) * frequency;
-            dst[y * width + x] = simplex_2d_single(px, py);
-        }
-    }
+    fill_noise_grid_2d(simd::kernels().simplex_2d_row, perm_lanes, origin, cell_size, frequency, width, height, result.ptrw());
 
     return result;
 }
@@ -640,15 +674,8 @@ PackedFloat32Array NoiseOps::worley_2d_grid(const Vector2& origin, const Vector2
 
     PackedFloat32Array result;
     result.resize(width * height);
-    float* dst = result.ptrw();
 
-    for (int y = 0; y < height; y++) {
-        float py = (origin.y + y * cell_size.y) * frequency;
-        for (int x = 0; x < width; x++) {
-            float px = (origin.x + x * cell_size.x) * frequency;
-            dst[y * width + x] = worley_2d_single(px, py);
-        }
-    }
+    fill_noise_grid_2d(simd::kernels().worley_2d_row, perm_lanes, origin, cell_size, frequency, width, height, result.ptrw());
 
     return result;
 }
@@ -748,26 +775,51 @@ PackedFloat32Array NoiseOps::fbm_2d_grid(const Vector2& origin, const Vector2& c
     result.resize(width * height);
     float* dst = result.ptrw();
 
-    for (int y = 0; y < height; y++) {
-        float py = origin.y + y * cell_size.y;
+    // Octave amplitudes and frequencies are the same for every cell
+    std::vector<float> amps, freqs;
+    float max_amp = 0.0f;
+    {
+        float amp = 1.0f;
+        float freq = frequency;
+        for (int o = 0; o < octaves; o++) {
+            amps.push_back(amp);
+            freqs.push_back(freq);
+            max_amp += amp;
+            amp *= persistence;
+            freq *= lacunarity;
+        }
+    }
+
+    // Per-octave x coordinates, shared by every row
+    std::vector<float> xs(static_cast<size_t>(octaves) * width);
+    for (int o = 0; o < octaves; o++) {
         for (int x = 0; x < width; x++) {
             float px = origin.x + x * cell_size.x;
+            xs[static_cast<size_t>(o) * width + x] = px * freqs[o];
+        }
+    }
 
-            float sum = 0.0f;
-            float amp = 1.0f;
-            float freq = frequency;
-            float max_amp = 0.0f;
+    NoiseRowKernel kernel = simd::kernels().perlin_2d_row;
+    parallel::for_range(height, grid_row_chunk(width), [&](int64_t begin, int64_t end) {
+        std::vector<float> n(width);
+        std::vector<float> sum(width);
+        for (int y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+            float py = origin.y + y * cell_size.y;
+            std::fill(sum.begin(), sum.end(), 0.0f);
 
             for (int o = 0; o < octaves; o++) {
-                sum += perlin_2d_single(px * freq, py * freq) * amp;
-                max_amp += amp;
-                amp *= persistence;
-                freq *= lacunarity;
+                kernel(perm_lanes, xs.data() + static_cast<size_t>(o) * width, py * freqs[o], n.data(), width);
+                for (int x = 0; x < width; x++) {
+                    sum[x] += n[x] * amps[o];
+                }
             }
 
-            dst[y * width + x] = sum / max_amp;
+            float* out = dst + static_cast<int64_t>(y) * width;
+            for (int x = 0; x < width; x++) {
+                out[x] = sum[x] / max_amp;
+            }
         }
-    }
+    });
 
     return result;
 }
@@ -887,31 +939,50 @@ PackedFloat32Array NoiseOps::ridged_2d_grid(const Vector2& origin, const Vector2
     result.resize(width * height);
     float* dst = result.ptrw();
 
-    for (int y = 0; y < height; y++) {
-        float py = origin.y + y * cell_size.y;
+    // Octave amplitudes and frequencies are the same for every cell
+    std::vector<float> amps, freqs;
+    {
+        float amp = 1.0f;
+        float freq = frequency;
+        for (int o = 0; o < octaves; o++) {
+            amps.push_back(amp);
+            freqs.push_back(freq);
+            amp *= persistence;
+            freq *= lacunarity;
+        }
+    }
+
+    // Per-octave x coordinates, shared by every row
+    std::vector<float> xs(static_cast<size_t>(octaves) * width);
+    for (int o = 0; o < octaves; o++) {
         for (int x = 0; x < width; x++) {
             float px = origin.x + x * cell_size.x;
+            xs[static_cast<size_t>(o) * width + x] = px * freqs[o];
+        }
+    }
 
-            float sum = 0.0f;
-            float amp = 1.0f;
-            float freq = frequency;
-            float weight = 1.0f;
+    NoiseRowKernel kernel = simd::kernels().perlin_2d_row;
+    parallel::for_range(height, grid_row_chunk(width), [&](int64_t begin, int64_t end) {
+        std::vector<float> n(width);
+        std::vector<float> weight(width);
+        for (int y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+            float py = origin.y + y * cell_size.y;
+            float* sum = dst + static_cast<int64_t>(y) * width;
+            std::fill(sum, sum + width, 0.0f);
+            std::fill(weight.begin(), weight.end(), 1.0f);
 
             for (int o = 0; o < octaves; o++) {
-                float n = perlin_2d_single(px * freq, py * freq);
-                n = 1.0f - std::abs(n);
-                n = n * n;
-                n = n * weight;
-                weight = std::min(1.0f, std::max(0.0f, n * 2.0f));
-
-                sum += n * amp;
-                amp *= persistence;
-                freq *= lacunarity;
+                kernel(perm_lanes, xs.data() + static_cast<size_t>(o) * width, py * freqs[o], n.data(), width);
+                for (int x = 0; x < width; x++) {
+                    float v = 1.0f - std::abs(n[x]);
+                    v = v * v;
+                    v = v * weight[x];
+                    weight[x] = std::min(1.0f, std::max(0.0f, v * 2.0f));
+                    sum[x] += v * amps[o];
+                }
             }
-
-            dst[y * width + x] = sum;
         }
-    }
+    });
 
     return result;
 }
@@ -1025,18 +1096,79 @@ PackedVector3Array NoiseOps::warp_3d(const PackedVector3Array& positions, float
     Vector3* dst = result.ptrw();
 
     for (int i = 0; i < count; i++) {
-        float wx = perlin_3d_single(src[i].x * frequency, src[i].y * frequency, src[i].z * frequency);
-        float wy = perlin_3d_single(src[i].x * frequency + 5.2f, src[i].y * frequency + 1.3f, src[i].z * frequency + 2.8f);
-        float wz = perlin_3d_single(src[i].x * frequency + 9.1f, src[i].y * frequency + 4.7f, src[i].z * frequency + 6.3f);
-
-        dst[i] = Vector3(
-            src[i].x + wx * strength,
-            src[i].y + wy * strength,
-            src[i].z + wz * strength
-        );
+        dst[i] = warp_point_3d(src[i], strength);
+    }
+
+    return result;
+}
+
+Vector3 NoiseOps::warp_point_3d(const Vector3& pos, float strength) const {
+    float wx = perlin_3d_single(pos.x * frequency, pos.y * frequency, pos.z * frequency);
+    float wy = perlin_3d_single(pos.x * frequency + 5.2f, pos.y * frequency + 1.3f, pos.z * frequency + 2.8f);
+    float wz = perlin_3d_single(pos.x * frequency + 9.1f, pos.y * frequency + 4.7f, pos.z * frequency + 6.3f);
+
+    return Vector3(
+        pos.x + wx * strength,
+        pos.y + wy * strength,
+        pos.z + wz * strength
+    );
+}
+
+// ========== VOLUMES ==========
+
+PackedFloat32Array NoiseOps::fractal_3d_volume(float (NoiseOps::*fractal)(const Vector3&), const Vector3& origin,
+                                               const Vector3& cell_size, const Vector3i& dims, float warp_strength, int padding) {
+    if (dims.x <= 0 || dims.y <= 0 || dims.z <= 0) return PackedFloat32Array();
+    if (padding < 0) {
+        UtilityFunctions::push_error("AgentiteG: NoiseOps volume padding must be >= 0");
+        return PackedFloat32Array();
+    }
+
+    int64_t size_x = static_cast<int64_t>(dims.x) + 2 * static_cast<int64_t>(padding);
+    int64_t size_y = static_cast<int64_t>(dims.y) + 2 * static_cast<int64_t>(padding);
+    int64_t size_z = static_cast<int64_t>(dims.z) + 2 * static_cast<int64_t>(padding);
+
+    PackedFloat32Array result;
+    result.resize(size_x * size_y * size_z);
+    float* dst = result.ptrw();
+
+    // Lattice x coordinates, shared by every row
+    std::vector<real_t> xs(size_x);
+    for (int64_t i = 0; i < size_x; i++) {
+        xs[i] = origin.x + (i - padding) * cell_size.x;
     }
 
+    // One task item per (z, y) row; each sample is warped and evaluated in place,
+    // so no position buffer is ever built
+    parallel::for_range(size_z * size_y, grid_row_chunk(size_x), [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; row++) {
+            int64_t k = row / size_y;
+            int64_t j = row % size_y;
+            real_t py = origin.y + (j - padding) * cell_size.y;
+            real_t pz = origin.z + (k - padding) * cell_size.z;
+            float* out = dst + row * size_x;
+
+            for (int64_t i = 0; i < size_x; i++) {
+                Vector3 pos(xs[i], py, pz);
+                if (warp_strength != 0.0f) {
+                    pos = warp_point_3d(pos, warp_strength);
+                }
+                out[i] = (this->*fractal)(pos);
+            }
+        }
+    });
+
     return result;
 }
 
+PackedFloat32Array NoiseOps::fbm_3d_volume(const Vector3& origin, const Vector3& cell_size, const Vector3i& dims,
+                                           float warp_strength, int padding) {
+    return fractal_3d_volume(&NoiseOps::fbm_3d, origin, cell_size, dims, warp_strength, padding);
+}
+
+PackedFloat32Array NoiseOps::ridged_3d_volume(const Vector3& origin, const Vector3& cell_size, const Vector3i& dims,
+                                              float warp_strength, int padding) {
+    return fractal_3d_volume(&NoiseOps::ridged_3d, origin, cell_size, dims, warp_strength, padding);
+}
+
 }
@@ -40,6 +40,7 @@ private:
     // Permutation table (256 + 256 for wrapping)
     uint8_t perm[512];
     uint8_t perm12[512]; // perm mod 12 for 3D gradients
+    int32_t perm_lanes[512]; // perm widened for the SIMD grid kernels
 
     // Noise parameters
     int octaves;
@@ -63,6 +64,13 @@ private:
     // Rebuild permutation table
     void rebuild_permutation();
 
+    // Domain warp of a single 3D point (shared by warp_3d and the volumes)
+    Vector3 warp_point_3d(const Vector3& pos, float strength) const;
+
+    // Fused volume: lattice positions, optional warp, then the given fractal
+    PackedFloat32Array fractal_3d_volume(float (NoiseOps::*fractal)(const Vector3&), const Vector3& origin,
+                                         const Vector3& cell_size, const Vector3i& dims, float warp_strength, int padding);
+
 protected:
     static void _bind_methods();
 
@@ -145,6 +153,16 @@ public:
     // Warp positions using noise for organic distortion
     PackedVector2Array warp_2d(const PackedVector2Array& positions, float strength);
     PackedVector3Array warp_3d(const PackedVector3Array& positions, float strength);
+
+    // ========== VOLUMES ==========
+    // Fused warp + fractal over a voxel chunk, written straight into the result
+    // Returns (dims + 2 * padding) samples per axis (x fastest, then y, then z);
+    // sample (i, j, k) is at origin + (i - padding, j - padding, k - padding) * cell_size.
+    // With warp_strength != 0 each position is first moved as warp_3d does.
+    PackedFloat32Array fbm_3d_volume(const Vector3& origin, const Vector3& cell_size, const Vector3i& dims,
+                                     float warp_strength = 0.0f, int padding = 0);
+    PackedFloat32Array ridged_3d_volume(const Vector3& origin, const Vector3& cell_size, const Vector3i& dims,
+                                        float warp_strength = 0.0f, int padding = 0);
 };
 
 }
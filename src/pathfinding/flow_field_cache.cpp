@@ -0,0 +1,528 @@
+/**
+ * FlowFieldCache Implementation
+ */
+
+#include "flow_field_cache.hpp"
+#include "pathfinding_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+#include "core/snapshot.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace godot {
+
+static const float INF = std::numeric_limits<float>::infinity();
+
+// Repairs touching more than 1 / FULL_REBUILD_FRACTION of the grid recompute the whole field
+static const int64_t FULL_REBUILD_FRACTION = 4;
+
+// Snapshot layout (bump SNAPSHOT_VERSION when it changes)
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotTag : uint32_t {
+    TAG_INFO = 1,
+    TAG_COSTS = 2,
+    TAG_FIELDS = 3,
+    TAG_DISTANCES = 4,  // width * height per field, in field order
+    TAG_FLOW = 5,
+    TAG_GOALS = 10,     // Jagged: 10 = offsets, 11 = cells
+    TAG_DIRTY = 12,     // Jagged: 12 = offsets, 13 = regions
+};
+
+struct SnapshotInfo {
+    int32_t width;
+    int32_t height;
+    int32_t max_fields;
+    int32_t field_count;
+    uint64_t use_counter;
+};
+
+struct SnapshotField {
+    uint64_t last_used;
+    int32_t needs_full;
+    int32_t reserved;
+};
+
+void FlowFieldCache::_bind_methods() {
+    // Configuration
+    ClassDB::bind_method(D_METHOD("set_max_fields", "count"), &FlowFieldCache::set_max_fields);
+    ClassDB::bind_method(D_METHOD("get_max_fields"), &FlowFieldCache::get_max_fields);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_fields"), "set_max_fields", "get_max_fields");
+
+    // Costs
+    ClassDB::bind_method(D_METHOD("set_costs", "costs", "width", "height"), &FlowFieldCache::set_costs);
+    ClassDB::bind_method(D_METHOD("update_costs", "costs", "region"), &FlowFieldCache::update_costs);
+
+    // Fields
+    ClassDB::bind_method(D_METHOD("get_flow_field", "goals"), &FlowFieldCache::get_flow_field);
+    ClassDB::bind_method(D_METHOD("get_dijkstra_map", "goals"), &FlowFieldCache::get_dijkstra_map);
+    ClassDB::bind_method(D_METHOD("refresh"), &FlowFieldCache::refresh);
+
+    // Cache management
+    ClassDB::bind_method(D_METHOD("has_field", "goals"), &FlowFieldCache::has_field);
+    ClassDB::bind_method(D_METHOD("remove_field", "goals"), &FlowFieldCache::remove_field);
+    ClassDB::bind_method(D_METHOD("clear"), &FlowFieldCache::clear);
+    ClassDB::bind_method(D_METHOD("get_field_count"), &FlowFieldCache::get_field_count);
+
+    // Snapshots
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &FlowFieldCache::save_snapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "data"), &FlowFieldCache::load_snapshot);
+}
+
+FlowFieldCache::FlowFieldCache() {
+}
+
+FlowFieldCache::~FlowFieldCache() {
+}
+
+// ========== CONFIGURATION ==========
+
+void FlowFieldCache::set_max_fields(int32_t count) {
+    max_fields = std::max(1, count);
+    evict_to(max_fields);
+}
+
+int32_t FlowFieldCache::get_max_fields() const {
+    return max_fields;
+}
+
+// ========== COSTS ==========
+
+void FlowFieldCache::set_costs(const PackedFloat32Array& p_costs, int32_t p_width, int32_t p_height) {
+    if (p_width <= 0 || p_height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: FlowFieldCache width and height must be positive");
+        return;
+    }
+    if (p_costs.size() < static_cast<int64_t>(p_width) * p_height) {
+        UtilityFunctions::push_error("AgentiteG: FlowFieldCache costs array is smaller than width * height");
+        return;
+    }
+
+    costs = p_costs;
+    width = p_width;
+    height = p_height;
+    fields.clear();
+}
+
+void FlowFieldCache::update_costs(const PackedFloat32Array& p_costs, const Rect2i& region) {
+    if (width == 0) {
+        UtilityFunctions::push_error("AgentiteG: FlowFieldCache needs set_costs before update_costs");
+        return;
+    }
+    if (p_costs.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: FlowFieldCache costs array is smaller than width * height");
+        return;
+    }
+
+    costs = p_costs;
+
+    int32_t x0 = std::max(0, region.position.x);
+    int32_t y0 = std::max(0, region.position.y);
+    int32_t x1 = std::min(width, region.position.x + region.size.x);
+    int32_t y1 = std::min(height, region.position.y + region.size.y);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    Rect2i clipped(x0, y0, x1 - x0, y1 - y0);
+
+    for (const std::unique_ptr<Field>& field : fields) {
+        if (!field->needs_full) {
+            field->dirty.push_back(clipped);
+        }
+    }
+}
+
+// ========== FIELD LOOKUP ==========
+
+std::vector<int32_t> FlowFieldCache::make_key(const PackedVector2Array& goals) const {
+    std::vector<int32_t> key;
+    key.reserve(goals.size());
+
+    const Vector2* goal_ptr = goals.ptr();
+    for (int64_t i = 0; i < goals.size(); i++) {
+        int32_t gx = static_cast<int32_t>(goal_ptr[i].x);
+        int32_t gy = static_cast<int32_t>(goal_ptr[i].y);
+        if (gx >= 0 && gx < width && gy >= 0 && gy < height) {
+            key.push_back(gy * width + gx);
+        }
+    }
+
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+    return key;
+}
+
+FlowFieldCache::Field* FlowFieldCache::find_field(const std::vector<int32_t>& key) const {
+    for (const std::unique_ptr<Field>& field : fields) {
+        if (field->goals == key) {
+            return field.get();
+        }
+    }
+    return nullptr;
+}
+
+FlowFieldCache::Field* FlowFieldCache::acquire_field(const PackedVector2Array& goals) {
+    if (width == 0) {
+        UtilityFunctions::push_error("AgentiteG: FlowFieldCache needs set_costs before fields can be requested");
+        return nullptr;
+    }
+
+    std::vector<int32_t> key = make_key(goals);
+    Field* field = find_field(key);
+    if (!field) {
+        evict_to(max_fields - 1);
+
+        std::unique_ptr<Field> created = std::make_unique<Field>();
+        created->goals = std::move(key);
+        created->distances.resize(static_cast<int64_t>(width) * height);
+        created->flow.resize(static_cast<int64_t>(width) * height);
+        field = created.get();
+        fields.push_back(std::move(created));
+    }
+
+    field->last_used = ++use_counter;
+    if (needs_update(*field)) {
+        GridSearchPool::Lease lease(searches);
+        update_field(*field, lease.get());
+    }
+    return field;
+}
+
+void FlowFieldCache::evict_to(int32_t count) {
+    while (static_cast<int32_t>(fields.size()) > std::max(0, count)) {
+        auto oldest = std::min_element(fields.begin(), fields.end(),
+            [](const std::unique_ptr<Field>& a, const std::unique_ptr<Field>& b) {
+                return a->last_used < b->last_used;
+            });
+        fields.erase(oldest);
+    }
+}
+
+// ========== REPAIR ==========
+
+bool FlowFieldCache::needs_update(const Field& field) const {
+    return field.needs_full || !field.dirty.empty();
+}
+
+void FlowFieldCache::update_field(Field& field, GridSearch& search) const {
+    int32_t size = width * height;
+    const float* cost_ptr = costs.ptr();
+    float* dist_ptr = field.distances.ptrw();
+
+    static const int dx[] = {0, 1, 0, -1};
+    static const int dy[] = {-1, 0, 1, 0};
+
+    search.begin(size);
+
+    // Cells whose distance must be recomputed (marked in the search)
+    std::vector<int32_t> affected;
+    bool full = field.needs_full;
+
+    if (!full) {
+        // Changed cells
+        for (const Rect2i& rect : field.dirty) {
+            for (int32_t y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+                for (int32_t x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+                    int32_t i = y * width + x;
+                    if (!search.is_marked(i)) {
+                        search.mark(i);
+                        affected.push_back(i);
+                    }
+                }
+            }
+        }
+
+        // Plus every cell whose shortest path ran through them
+        int64_t limit = static_cast<int64_t>(size) / FULL_REBUILD_FRACTION;
+        for (size_t k = 0; k < affected.size() && !full; k++) {
+            int32_t current = affected[k];
+            float current_dist = dist_ptr[current];
+            if (current_dist >= INF) continue;
+
+            int32_t cx = current % width;
+            int32_t cy = current / width;
+            for (int d = 0; d < 4; d++) {
+                int32_t nx = cx + dx[d];
+                int32_t ny = cy + dy[d];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+                int32_t ni = ny * width + nx;
+                float cell_cost = cost_ptr[ni];
+                if (search.is_marked(ni) || cell_cost <= 0) continue;
+                if (dist_ptr[ni] == current_dist + cell_cost) {
+                    search.mark(ni);
+                    affected.push_back(ni);
+                }
+            }
+            full = static_cast<int64_t>(affected.size()) > limit;
+        }
+    }
+
+    if (full) {
+        search.begin(size);
+        std::fill(dist_ptr, dist_ptr + size, INF);
+
+        // Seed goals the same way as PathfindingOps::dijkstra_map
+        for (int32_t gi : field.goals) {
+            if (cost_ptr[gi] > 0) {
+                dist_ptr[gi] = 0;
+                search.relax(gi, 0, -1, 0);
+            }
+        }
+    } else {
+        for (int32_t i : affected) {
+            dist_ptr[i] = INF;
+        }
+
+        // Seed affected cells from goals and from the unaffected cells around them
+        for (int32_t i : affected) {
+            if (cost_ptr[i] <= 0) continue;
+
+            float best = INF;
+            if (std::binary_search(field.goals.begin(), field.goals.end(), i)) {
+                best = 0;
+            } else {
+                int32_t cx = i % width;
+                int32_t cy = i / width;
+                for (int d = 0; d < 4; d++) {
+                    int32_t nx = cx + dx[d];
+                    int32_t ny = cy + dy[d];
+                    if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+                    int32_t ni = ny * width + nx;
+                    if (!search.is_marked(ni)) {
+                        best = std::min(best, dist_ptr[ni] + cost_ptr[i]);
+                    }
+                }
+            }
+
+            if (best < INF) {
+                dist_ptr[i] = best;
+                search.relax(i, best, -1, best);
+            }
+        }
+    }
+
+    // Dijkstra from the seeds; unaffected cells are only reopened when they improve
+    std::vector<int32_t> changed;
+    while (!search.open_empty()) {
+        float current_dist;
+        int32_t current = search.pop(current_dist);
+        if (!full) changed.push_back(current);
+
+        int32_t cx = current % width;
+        int32_t cy = current / width;
+        for (int d = 0; d < 4; d++) {
+            int32_t nx = cx + dx[d];
+            int32_t ny = cy + dy[d];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int32_t ni = ny * width + nx;
+            float cell_cost = cost_ptr[ni];
+            if (cell_cost <= 0) continue;
+
+            float new_dist = current_dist + cell_cost;
+            if (new_dist < dist_ptr[ni]) {
+                dist_ptr[ni] = new_dist;
+                search.relax(ni, new_dist, current, new_dist);
+            }
+        }
+    }
+
+    // Rewrite directions of every cell next to a changed distance
+    Vector2* flow_ptr = field.flow.ptrw();
+    if (full) {
+        for (int32_t i = 0; i < size; i++) {
+            flow_ptr[i] = PathfindingOps::flow_direction(dist_ptr, width, height, i);
+        }
+    } else {
+        affected.insert(affected.end(), changed.begin(), changed.end());
+        for (int32_t i : affected) {
+            int32_t cx = i % width;
+            int32_t cy = i / width;
+            for (int32_t ny = std::max(0, cy - 1); ny <= std::min(height - 1, cy + 1); ny++) {
+                for (int32_t nx = std::max(0, cx - 1); nx <= std::min(width - 1, cx + 1); nx++) {
+                    int32_t ni = ny * width + nx;
+                    flow_ptr[ni] = PathfindingOps::flow_direction(dist_ptr, width, height, ni);
+                }
+            }
+        }
+    }
+
+    field.dirty.clear();
+    field.needs_full = false;
+}
+
+// ========== FIELDS ==========
+
+PackedVector2Array FlowFieldCache::get_flow_field(const PackedVector2Array& goals) {
+    AGENTITE_PROFILE("FlowFieldCache.get_flow_field", goals.size());
+    Field* field = acquire_field(goals);
+    if (!field) {
+        return PackedVector2Array();
+    }
+    return field->flow;
+}
+
+PackedFloat32Array FlowFieldCache::get_dijkstra_map(const PackedVector2Array& goals) {
+    Field* field = acquire_field(goals);
+    if (!field) {
+        return PackedFloat32Array();
+    }
+    return field->distances;
+}
+
+void FlowFieldCache::refresh() {
+    AGENTITE_PROFILE("FlowFieldCache.refresh", fields.size());
+    std::vector<Field*> pending;
+    for (const std::unique_ptr<Field>& field : fields) {
+        if (needs_update(*field)) {
+            pending.push_back(field.get());
+        }
+    }
+
+    parallel::for_range(static_cast<int64_t>(pending.size()), 1, [&](int64_t begin, int64_t end) {
+        GridSearchPool::Lease lease(searches);
+        for (int64_t i = begin; i < end; i++) {
+            update_field(*pending[i], lease.get());
+        }
+    });
+}
+
+// ========== CACHE MANAGEMENT ==========
+
+bool FlowFieldCache::has_field(const PackedVector2Array& goals) const {
+    return find_field(make_key(goals)) != nullptr;
+}
+
+void FlowFieldCache::remove_field(const PackedVector2Array& goals) {
+    std::vector<int32_t> key = make_key(goals);
+    fields.erase(std::remove_if(fields.begin(), fields.end(),
+        [&](const std::unique_ptr<Field>& field) { return field->goals == key; }),
+        fields.end());
+}
+
+void FlowFieldCache::clear() {
+    costs = PackedFloat32Array();
+    width = 0;
+    height = 0;
+    fields.clear();
+    searches.clear();
+}
+
+int32_t FlowFieldCache::get_field_count() const {
+    return static_cast<int32_t>(fields.size());
+}
+
+// ========== SNAPSHOTS ==========
+
+PackedByteArray FlowFieldCache::save_snapshot() const {
+    int64_t size = static_cast<int64_t>(width) * height;
+    uint64_t n = fields.size();
+
+    SnapshotInfo info;
+    info.width = width;
+    info.height = height;
+    info.max_fields = max_fields;
+    info.field_count = static_cast<int32_t>(n);
+    info.use_counter = use_counter;
+
+    std::vector<SnapshotField> records(n);
+    std::vector<float> distances(static_cast<size_t>(n * size));
+    std::vector<Vector2> flow(static_cast<size_t>(n * size));
+    for (uint64_t i = 0; i < n; i++) {
+        const Field& field = *fields[i];
+        records[i].last_used = field.last_used;
+        records[i].needs_full = field.needs_full ? 1 : 0;
+        records[i].reserved = 0;
+        std::copy(field.distances.ptr(), field.distances.ptr() + size, distances.begin() + i * size);
+        std::copy(field.flow.ptr(), field.flow.ptr() + size, flow.begin() + i * size);
+    }
+
+    snapshot::Writer w(snapshot::KIND_FLOW_FIELD_CACHE, SNAPSHOT_VERSION);
+    w.add_value(TAG_INFO, info);
+    w.add(TAG_COSTS, costs.ptr(), static_cast<uint64_t>(size));
+    w.add(TAG_FIELDS, records);
+    w.add(TAG_DISTANCES, distances);
+    w.add(TAG_FLOW, flow);
+    w.add_jagged<int32_t>(TAG_GOALS, n, [&](uint64_t i) -> const std::vector<int32_t>& { return fields[i]->goals; });
+    w.add_jagged<Rect2i>(TAG_DIRTY, n, [&](uint64_t i) -> const std::vector<Rect2i>& { return fields[i]->dirty; });
+    return w.finish();
+}
+
+bool FlowFieldCache::load_snapshot(const PackedByteArray& data) {
+    snapshot::Reader r;
+    if (!r.open(data, snapshot::KIND_FLOW_FIELD_CACHE, SNAPSHOT_VERSION, "FlowFieldCache")) {
+        return false;
+    }
+
+    SnapshotInfo info;
+    PackedFloat32Array new_costs;
+    std::vector<SnapshotField> records;
+    if (!r.read_value(TAG_INFO, info) || !r.read_packed<float>(TAG_COSTS, new_costs) || !r.read(TAG_FIELDS, records)) {
+        return false;
+    }
+    bool has_grid = info.width > 0 && info.height > 0;
+    if (info.width < 0 || info.height < 0 || (info.width == 0) != (info.height == 0) ||
+        info.max_fields < 1 || info.field_count < 0 || info.field_count > info.max_fields ||
+        (!has_grid && info.field_count > 0) || records.size() != static_cast<size_t>(info.field_count)) {
+        return r.fail("cache settings are invalid");
+    }
+    int64_t size = static_cast<int64_t>(info.width) * info.height;
+    if (new_costs.size() != size) {
+        return r.fail("cost grid doesn't match width * height");
+    }
+
+    uint64_t n = records.size();
+    const float* distances = r.view<float>(TAG_DISTANCES, n * size);
+    const Vector2* flow = r.view<Vector2>(TAG_FLOW, n * size);
+    if (!distances || !flow) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Field>> new_fields(n);
+    for (uint64_t i = 0; i < n; i++) {
+        new_fields[i] = std::make_unique<Field>();
+    }
+    if (!r.read_jagged<int32_t>(TAG_GOALS, n, [&](uint64_t i) -> std::vector<int32_t>& { return new_fields[i]->goals; }) ||
+        !r.read_jagged<Rect2i>(TAG_DIRTY, n, [&](uint64_t i) -> std::vector<Rect2i>& { return new_fields[i]->dirty; })) {
+        return false;
+    }
+
+    // Goals are the cache key (sorted, unique cells) and dirty regions are
+    // walked cell by cell, so both must lie inside the grid
+    Rect2i grid(0, 0, info.width, info.height);
+    for (uint64_t i = 0; i < n; i++) {
+        Field& field = *new_fields[i];
+        for (size_t g = 0; g < field.goals.size(); g++) {
+            if (field.goals[g] < 0 || field.goals[g] >= size || (g > 0 && field.goals[g] <= field.goals[g - 1])) {
+                return r.fail("field goals are invalid");
+            }
+        }
+        for (const Rect2i& rect : field.dirty) {
+            if (rect.size.x <= 0 || rect.size.y <= 0 || !grid.encloses(rect)) {
+                return r.fail("field repair regions are out of range");
+            }
+        }
+        field.needs_full = records[i].needs_full != 0;
+        field.last_used = records[i].last_used;
+        field.distances.resize(size);
+        field.flow.resize(size);
+        std::copy(distances + i * size, distances + (i + 1) * size, field.distances.ptrw());
+        std::copy(flow + i * size, flow + (i + 1) * size, field.flow.ptrw());
+    }
+
+    costs = new_costs;
+    width = info.width;
+    height = info.height;
+    max_fields = info.max_fields;
+    use_counter = info.use_counter;
+    fields.swap(new_fields);
+    return true;
+}
+
+}
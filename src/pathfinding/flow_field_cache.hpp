@@ -0,0 +1,123 @@
+/**
+ * FlowFieldCache - Shared flow fields with incremental repair
+ *
+ * Keeps one Dijkstra map and flow field per goal set over a shared cost grid.
+ * Asking for the same goals again returns the stored field without any work.
+ * When costs change inside a rectangle, each field is repaired on its next
+ * use: only cells whose shortest path ran through the changed cells (or that
+ * can now be reached more cheaply through them) are recomputed, and the
+ * directions are rewritten in place around them.
+ *
+ * Fields match PathfindingOps.flow_field_multi / dijkstra_map on the same
+ * costs and goals. The least recently used field is dropped once more than
+ * max_fields goal sets are cached.
+ *
+ * Usage:
+ *   var flows = FlowFieldCache.new()
+ *   flows.set_costs(costs, width, height)
+ *   var flow = flows.get_flow_field(PackedVector2Array([rally_point]))
+ *
+ *   # A door opened
+ *   costs[door_index] = 1.0
+ *   flows.update_costs(costs, Rect2i(door_x, door_y, 1, 1))
+ *   flows.refresh()  # Optional: repair every field now, across threads
+ *
+ *   # Precompute fields offline and ship them with the level
+ *   var data = flows.save_snapshot()
+ *   flows.load_snapshot(data)
+ */
+
+#ifndef AGENTITE_FLOW_FIELD_CACHE_HPP
+#define AGENTITE_FLOW_FIELD_CACHE_HPP
+
+#include "pathfinding_context.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace godot {
+
+class FlowFieldCache : public RefCounted {
+    GDCLASS(FlowFieldCache, RefCounted)
+
+private:
+    struct Field {
+        std::vector<int32_t> goals;     // Sorted goal cells (the cache key)
+        PackedFloat32Array distances;
+        PackedVector2Array flow;
+        std::vector<Rect2i> dirty;      // Changed regions not yet repaired
+        bool needs_full = true;         // No valid distances yet
+        uint64_t last_used = 0;
+    };
+
+    int32_t max_fields = 64;
+
+    PackedFloat32Array costs;
+    int32_t width = 0;
+    int32_t height = 0;
+
+    std::vector<std::unique_ptr<Field>> fields;
+    uint64_t use_counter = 0;
+
+    // Grid-sized searches lent to repairs (one per thread in refresh())
+    GridSearchPool searches;
+
+    std::vector<int32_t> make_key(const PackedVector2Array& goals) const;
+    Field* find_field(const std::vector<int32_t>& key) const;
+    Field* acquire_field(const PackedVector2Array& goals);
+    void evict_to(int32_t count);
+
+    bool needs_update(const Field& field) const;
+    void update_field(Field& field, GridSearch& search) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    FlowFieldCache();
+    ~FlowFieldCache();
+
+    // Configuration
+    void set_max_fields(int32_t count);
+    int32_t get_max_fields() const;
+
+    // Set the cost grid (same format as PathfindingOps). Invalidates all fields.
+    void set_costs(const PackedFloat32Array& p_costs, int32_t p_width, int32_t p_height);
+
+    // Replace the cost grid after the cells in region changed
+    // Fields are repaired around region on their next use
+    void update_costs(const PackedFloat32Array& p_costs, const Rect2i& region);
+
+    // Flow field toward the nearest of goals (cached per goal set)
+    PackedVector2Array get_flow_field(const PackedVector2Array& goals);
+
+    // Distance map for the same goal set (INF for unreachable cells)
+    PackedFloat32Array get_dijkstra_map(const PackedVector2Array& goals);
+
+    // Repair every cached field that has pending changes, across worker threads
+    void refresh();
+
+    // Cache management
+    bool has_field(const PackedVector2Array& goals) const;
+    void remove_field(const PackedVector2Array& goals);
+    void clear();
+    int32_t get_field_count() const;
+
+    // Save the cost grid and every cached field as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the cache with a saved snapshot; its fields are ready without any searches
+    // Returns false (and keeps the current cache) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+};
+
+}
+
+#endif // AGENTITE_FLOW_FIELD_CACHE_HPP
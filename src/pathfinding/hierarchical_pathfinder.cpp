@@ -0,0 +1,760 @@
+/**
+ * HierarchicalPathfinder Implementation
+ */
+
+#include "hierarchical_pathfinder.hpp"
+#include "pathfinding_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+#include "core/snapshot.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace godot {
+
+static const float INF = std::numeric_limits<float>::infinity();
+static const float SQRT2 = 1.41421356237f;
+
+// Border runs at least this long get an entrance at each end instead of one in the middle
+static const int32_t ENTRANCE_SPLIT_LENGTH = 6;
+
+// Minimum clusters per chunk when rebuilding clusters in parallel
+static const int64_t CLUSTER_CHUNK = 16;
+
+// Snapshot layout (bump SNAPSHOT_VERSION when it changes)
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotTag : uint32_t {
+    TAG_INFO = 1,
+    TAG_COSTS = 2,
+    // Jagged lists, one per cluster: tag = offsets, tag + 1 = elements
+    TAG_NODES = 10,
+    TAG_DIST = 12,
+    TAG_LINK_OFFSETS = 14,
+    TAG_LINKS = 16,
+    TAG_EAST = 20,
+    TAG_SOUTH = 22,
+    TAG_CORNER = 24,
+};
+
+struct SnapshotInfo {
+    int32_t width;
+    int32_t height;
+    int32_t cluster_size;
+    int32_t diagonal;
+    int32_t clusters_x;
+    int32_t clusters_y;
+};
+
+void HierarchicalPathfinder::_bind_methods() {
+    // Configuration
+    ClassDB::bind_method(D_METHOD("set_cluster_size", "size"), &HierarchicalPathfinder::set_cluster_size);
+    ClassDB::bind_method(D_METHOD("get_cluster_size"), &HierarchicalPathfinder::get_cluster_size);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "cluster_size"), "set_cluster_size", "get_cluster_size");
+
+    ClassDB::bind_method(D_METHOD("set_allow_diagonal", "enabled"), &HierarchicalPathfinder::set_allow_diagonal);
+    ClassDB::bind_method(D_METHOD("get_allow_diagonal"), &HierarchicalPathfinder::get_allow_diagonal);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_diagonal"), "set_allow_diagonal", "get_allow_diagonal");
+
+    // Building
+    ClassDB::bind_method(D_METHOD("build", "costs", "width", "height"), &HierarchicalPathfinder::build);
+    ClassDB::bind_method(D_METHOD("update_region", "costs", "region"), &HierarchicalPathfinder::update_region);
+    ClassDB::bind_method(D_METHOD("clear"), &HierarchicalPathfinder::clear);
+
+    // Snapshots
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &HierarchicalPathfinder::save_snapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "data"), &HierarchicalPathfinder::load_snapshot);
+
+    // Queries
+    ClassDB::bind_method(D_METHOD("find_path", "start", "goal", "context"), &HierarchicalPathfinder::find_path, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("find_abstract_path", "start", "goal", "context"), &HierarchicalPathfinder::find_abstract_path, DEFVAL(Variant()));
+
+    // Info
+    ClassDB::bind_method(D_METHOD("get_width"), &HierarchicalPathfinder::get_width);
+    ClassDB::bind_method(D_METHOD("get_height"), &HierarchicalPathfinder::get_height);
+    ClassDB::bind_method(D_METHOD("get_cluster_count"), &HierarchicalPathfinder::get_cluster_count);
+    ClassDB::bind_method(D_METHOD("get_node_count"), &HierarchicalPathfinder::get_node_count);
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder() {
+}
+
+HierarchicalPathfinder::~HierarchicalPathfinder() {
+}
+
+// Helper: heuristic for the abstract search (same as PathfindingOps A*)
+static inline float heuristic(int x1, int y1, int x2, int y2, bool diagonal) {
+    int dx = std::abs(x2 - x1);
+    int dy = std::abs(y2 - y1);
+    if (diagonal) {
+        return static_cast<float>(std::max(dx, dy)) + (SQRT2 - 1.0f) * static_cast<float>(std::min(dx, dy));
+    }
+    return static_cast<float>(dx + dy);
+}
+
+// ========== CONFIGURATION ==========
+
+void HierarchicalPathfinder::set_cluster_size(int32_t size) {
+    cluster_size = std::max(2, size);
+}
+
+int32_t HierarchicalPathfinder::get_cluster_size() const {
+    return cluster_size;
+}
+
+void HierarchicalPathfinder::set_allow_diagonal(bool enabled) {
+    allow_diagonal = enabled;
+}
+
+bool HierarchicalPathfinder::get_allow_diagonal() const {
+    return allow_diagonal;
+}
+
+// ========== CLUSTER HELPERS ==========
+
+int32_t HierarchicalPathfinder::cluster_of(int32_t cell) const {
+    int32_t x = cell % width;
+    int32_t y = cell / width;
+    return (y / built_cluster_size) * clusters_x + x / built_cluster_size;
+}
+
+Rect2i HierarchicalPathfinder::cluster_bounds(int32_t cluster) const {
+    int32_t x = (cluster % clusters_x) * built_cluster_size;
+    int32_t y = (cluster / clusters_x) * built_cluster_size;
+    return Rect2i(x, y, std::min(built_cluster_size, width - x), std::min(built_cluster_size, height - y));
+}
+
+int32_t HierarchicalPathfinder::node_slot(const Cluster& cluster, int32_t cell) const {
+    auto it = std::lower_bound(cluster.nodes.begin(), cluster.nodes.end(), cell);
+    if (it == cluster.nodes.end() || *it != cell) {
+        return -1;
+    }
+    return static_cast<int32_t>(it - cluster.nodes.begin());
+}
+
+void HierarchicalPathfinder::cluster_dijkstra(GridSearch& search, const Rect2i& bounds, int32_t origin, bool reverse,
+                                              const std::vector<int32_t>& targets, float* dist_out) const {
+    const float* cost_ptr = costs.ptr();
+    int32_t bw = bounds.size.x;
+    int32_t bh = bounds.size.y;
+
+    // Cluster-local cell index
+    auto local = [&](int32_t cell) {
+        return (cell / width - bounds.position.y) * bw + (cell % width - bounds.position.x);
+    };
+
+    // Direction arrays
+    static const int dx4[] = {0, 1, 0, -1};
+    static const int dy4[] = {-1, 0, 1, 0};
+    static const int dx8[] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static const int dy8[] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    static const float cost8[] = {1, SQRT2, 1, SQRT2, 1, SQRT2, 1, SQRT2};
+
+    const int* dx = built_diagonal ? dx8 : dx4;
+    const int* dy = built_diagonal ? dy8 : dy4;
+    int dir_count = built_diagonal ? 8 : 4;
+
+    search.begin(bw * bh);
+    search.relax(local(origin), 0, -1, 0);
+
+    // Stop once every target is settled
+    int32_t remaining = 0;
+    for (int32_t target : targets) {
+        int32_t t = local(target);
+        if (!search.is_marked(t)) {
+            search.mark(t);
+            remaining++;
+        }
+    }
+
+    while (!search.open_empty() && remaining > 0) {
+        float current_g;
+        int32_t current = search.pop(current_g);
+        if (search.is_marked(current)) {
+            remaining--;
+        }
+
+        int32_t lx = current % bw;
+        int32_t ly = current / bw;
+        int32_t cell = (bounds.position.y + ly) * width + bounds.position.x + lx;
+
+        for (int d = 0; d < dir_count; d++) {
+            int32_t nx = lx + dx[d];
+            int32_t ny = ly + dy[d];
+            if (nx < 0 || nx >= bw || ny < 0 || ny >= bh) continue;
+
+            int32_t ni = ny * bw + nx;
+            if (search.is_closed(ni)) continue;
+
+            int32_t neighbor = (bounds.position.y + ny) * width + bounds.position.x + nx;
+            float neighbor_cost = cost_ptr[neighbor];
+            if (neighbor_cost <= 0) continue;
+
+            // Reverse searches measure the step from neighbor into current
+            float move_cost = built_diagonal ? cost8[d] : 1.0f;
+            float new_g = current_g + move_cost * (reverse ? cost_ptr[cell] : neighbor_cost);
+
+            if (new_g < search.get_cost(ni)) {
+                search.relax(ni, new_g, current, new_g);
+            }
+        }
+    }
+
+    for (size_t t = 0; t < targets.size(); t++) {
+        dist_out[t] = search.get_cost(local(targets[t]));
+    }
+}
+
+// ========== BUILDING ==========
+
+void HierarchicalPathfinder::find_transitions(int32_t cluster, bool east) {
+    std::vector<Transition>& out = east ? east_transitions[cluster] : south_transitions[cluster];
+    out.clear();
+
+    int32_t cx = cluster % clusters_x;
+    int32_t cy = cluster / clusters_x;
+    if (east ? cx + 1 >= clusters_x : cy + 1 >= clusters_y) return;
+
+    const float* cost_ptr = costs.ptr();
+    Rect2i bounds = cluster_bounds(cluster);
+
+    // Walk the border, pairing cell a (inside) with cell b (across the border)
+    int32_t length = east ? bounds.size.y : bounds.size.x;
+    int32_t a_first = east ? bounds.position.y * width + bounds.position.x + bounds.size.x - 1
+                           : (bounds.position.y + bounds.size.y - 1) * width + bounds.position.x;
+    int32_t step = east ? width : 1;
+    int32_t across = east ? 1 : width;
+
+    auto straight_open = [&](int32_t i) {
+        int32_t a = a_first + i * step;
+        return cost_ptr[a] > 0 && cost_ptr[a + across] > 0;
+    };
+
+    int32_t run_start = -1;
+    for (int32_t i = 0; i <= length; i++) {
+        bool open = i < length && straight_open(i);
+
+        if (open && run_start < 0) {
+            run_start = i;
+        } else if (!open && run_start >= 0) {
+            int32_t run_length = i - run_start;
+            if (run_length < ENTRANCE_SPLIT_LENGTH) {
+                int32_t mid = a_first + (run_start + run_length / 2) * step;
+                out.push_back({mid, mid + across});
+            } else {
+                int32_t first = a_first + run_start * step;
+                int32_t last = a_first + (i - 1) * step;
+                out.push_back({first, first + across});
+                out.push_back({last, last + across});
+            }
+            run_start = -1;
+        }
+    }
+
+    // Diagonal steps across the border that no straight crossing next to them covers
+    if (!built_diagonal) return;
+    for (int32_t i = 0; i + 1 < length; i++) {
+        if (straight_open(i) || straight_open(i + 1)) continue;
+        int32_t a0 = a_first + i * step;
+        int32_t a1 = a0 + step;
+        if (cost_ptr[a0] > 0 && cost_ptr[a1 + across] > 0) {
+            out.push_back({a0, a1 + across});
+        }
+        if (cost_ptr[a1] > 0 && cost_ptr[a0 + across] > 0) {
+            out.push_back({a1, a0 + across});
+        }
+    }
+}
+
+void HierarchicalPathfinder::find_corner_transitions(int32_t cluster) {
+    std::vector<Transition>& out = corner_transitions[cluster];
+    out.clear();
+
+    int32_t cx = cluster % clusters_x;
+    int32_t cy = cluster / clusters_x;
+    if (!built_diagonal || cy + 1 >= clusters_y) return;
+
+    const float* cost_ptr = costs.ptr();
+    Rect2i bounds = cluster_bounds(cluster);
+    int32_t bottom = bounds.position.y + bounds.size.y - 1;
+
+    // Diagonal step between the corner cells of diagonally adjacent clusters,
+    // only needed when both cells beside the step are blocked
+    auto try_step = [&](int32_t ax, int32_t bx) {
+        int32_t a = bottom * width + ax;
+        int32_t b = (bottom + 1) * width + bx;
+        if (cost_ptr[a] > 0 && cost_ptr[b] > 0 &&
+            cost_ptr[bottom * width + bx] <= 0 && cost_ptr[(bottom + 1) * width + ax] <= 0) {
+            out.push_back({a, b});
+        }
+    };
+
+    if (cx + 1 < clusters_x) {
+        int32_t right = bounds.position.x + bounds.size.x - 1;
+        try_step(right, right + 1);
+    }
+    if (cx > 0) {
+        int32_t left = bounds.position.x;
+        try_step(left, left - 1);
+    }
+}
+
+void HierarchicalPathfinder::build_cluster(int32_t cluster, GridSearch& search) {
+    Cluster& c = clusters[cluster];
+    int32_t cx = cluster % clusters_x;
+    int32_t cy = cluster / clusters_x;
+
+    // Gather (entrance in this cluster, cell across the border) from all four borders
+    std::vector<Transition> crossings;
+    for (const Transition& t : east_transitions[cluster]) {
+        crossings.push_back({t.a, t.b});
+    }
+    for (const Transition& t : south_transitions[cluster]) {
+        crossings.push_back({t.a, t.b});
+    }
+    if (cx > 0) {
+        for (const Transition& t : east_transitions[cluster - 1]) {
+            crossings.push_back({t.b, t.a});
+        }
+    }
+    if (cy > 0) {
+        for (const Transition& t : south_transitions[cluster - clusters_x]) {
+            crossings.push_back({t.b, t.a});
+        }
+    }
+    for (const Transition& t : corner_transitions[cluster]) {
+        crossings.push_back({t.a, t.b});
+    }
+    if (cy > 0) {
+        // Corner steps into this cluster from the north-west and north-east
+        for (int32_t nx = std::max(0, cx - 1); nx <= std::min(clusters_x - 1, cx + 1); nx += 2) {
+            for (const Transition& t : corner_transitions[cluster - clusters_x + (nx - cx)]) {
+                if (cluster_of(t.b) == cluster) {
+                    crossings.push_back({t.b, t.a});
+                }
+            }
+        }
+    }
+    std::sort(crossings.begin(), crossings.end(), [](const Transition& x, const Transition& y) {
+        return x.a < y.a || (x.a == y.a && x.b < y.b);
+    });
+
+    // Entrance nodes with their border links (CSR)
+    const float* cost_ptr = costs.ptr();
+    c.nodes.clear();
+    c.links.clear();
+    c.link_offsets.clear();
+    for (const Transition& t : crossings) {
+        if (c.nodes.empty() || c.nodes.back() != t.a) {
+            c.nodes.push_back(t.a);
+            c.link_offsets.push_back(static_cast<int32_t>(c.links.size()));
+        }
+        bool diagonal = (t.a % width) != (t.b % width) && (t.a / width) != (t.b / width);
+        c.links.push_back({t.b, (diagonal ? SQRT2 : 1.0f) * cost_ptr[t.b]});
+    }
+    c.link_offsets.push_back(static_cast<int32_t>(c.links.size()));
+
+    // Costs between every pair of entrances inside the cluster
+    int32_t n = static_cast<int32_t>(c.nodes.size());
+    c.dist.resize(static_cast<size_t>(n) * n);
+    Rect2i bounds = cluster_bounds(cluster);
+    for (int32_t i = 0; i < n; i++) {
+        cluster_dijkstra(search, bounds, c.nodes[i], false, c.nodes, c.dist.data() + static_cast<size_t>(i) * n);
+    }
+}
+
+void HierarchicalPathfinder::rebuild(int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1) {
+    // Borders touching the changed clusters
+    for (int32_t cy = cy0; cy <= cy1; cy++) {
+        for (int32_t cx = std::max(0, cx0 - 1); cx <= cx1; cx++) {
+            find_transitions(cy * clusters_x + cx, true);
+        }
+    }
+    for (int32_t cy = std::max(0, cy0 - 1); cy <= cy1; cy++) {
+        for (int32_t cx = cx0; cx <= cx1; cx++) {
+            find_transitions(cy * clusters_x + cx, false);
+        }
+        for (int32_t cx = std::max(0, cx0 - 1); cx <= std::min(clusters_x - 1, cx1 + 1); cx++) {
+            find_corner_transitions(cy * clusters_x + cx);
+        }
+    }
+
+    // Changed clusters and their neighbors (whose border entrances may have moved)
+    int32_t rx0 = std::max(0, cx0 - 1);
+    int32_t ry0 = std::max(0, cy0 - 1);
+    int32_t rx1 = std::min(clusters_x - 1, cx1 + 1);
+    int32_t ry1 = std::min(clusters_y - 1, cy1 + 1);
+    int32_t span_x = rx1 - rx0 + 1;
+    int64_t count = static_cast<int64_t>(span_x) * (ry1 - ry0 + 1);
+
+    parallel::for_range(count, CLUSTER_CHUNK, [&](int64_t begin, int64_t end) {
+        GridSearchPool::Lease lease(local_searches);
+        for (int64_t i = begin; i < end; i++) {
+            int32_t cx = rx0 + static_cast<int32_t>(i % span_x);
+            int32_t cy = ry0 + static_cast<int32_t>(i / span_x);
+            build_cluster(cy * clusters_x + cx, lease.get());
+        }
+    });
+}
+
+void HierarchicalPathfinder::build(const PackedFloat32Array& p_costs, int32_t p_width, int32_t p_height) {
+    AGENTITE_PROFILE("HierarchicalPathfinder.build", static_cast<int64_t>(p_width) * p_height);
+    clear();
+
+    if (p_width <= 0 || p_height <= 0) {
+        UtilityFunctions::push_error("AgentiteG: HierarchicalPathfinder width and height must be positive");
+        return;
+    }
+    if (p_costs.size() < static_cast<int64_t>(p_width) * p_height) {
+        UtilityFunctions::push_error("AgentiteG: HierarchicalPathfinder costs array is smaller than width * height");
+        return;
+    }
+
+    costs = p_costs;
+    width = p_width;
+    height = p_height;
+    built_cluster_size = cluster_size;
+    built_diagonal = allow_diagonal;
+    clusters_x = (width + built_cluster_size - 1) / built_cluster_size;
+    clusters_y = (height + built_cluster_size - 1) / built_cluster_size;
+
+    int32_t cluster_count = clusters_x * clusters_y;
+    clusters.resize(cluster_count);
+    east_transitions.resize(cluster_count);
+    south_transitions.resize(cluster_count);
+    corner_transitions.resize(cluster_count);
+
+    rebuild(0, 0, clusters_x - 1, clusters_y - 1);
+}
+
+void HierarchicalPathfinder::update_region(const PackedFloat32Array& p_costs, const Rect2i& region) {
+    AGENTITE_PROFILE("HierarchicalPathfinder.update_region", static_cast<int64_t>(region.size.x) * region.size.y);
+    if (clusters.empty()) {
+        UtilityFunctions::push_error("AgentiteG: HierarchicalPathfinder must be built before update_region");
+        return;
+    }
+    if (p_costs.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: HierarchicalPathfinder costs array is smaller than width * height");
+        return;
+    }
+
+    costs = p_costs;
+
+    // Changed cells plus one cell around them (border entrances look across)
+    int32_t x0 = std::max(0, region.position.x - 1);
+    int32_t y0 = std::max(0, region.position.y - 1);
+    int32_t x1 = std::min(width, region.position.x + region.size.x + 1);
+    int32_t y1 = std::min(height, region.position.y + region.size.y + 1);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    rebuild(x0 / built_cluster_size, y0 / built_cluster_size,
+            (x1 - 1) / built_cluster_size, (y1 - 1) / built_cluster_size);
+}
+
+void HierarchicalPathfinder::clear() {
+    costs = PackedFloat32Array();
+    width = 0;
+    height = 0;
+    clusters_x = 0;
+    clusters_y = 0;
+    clusters.clear();
+    east_transitions.clear();
+    south_transitions.clear();
+    corner_transitions.clear();
+    local_searches.clear();
+    default_context.unref();
+}
+
+// ========== SNAPSHOTS ==========
+
+PackedByteArray HierarchicalPathfinder::save_snapshot() const {
+    SnapshotInfo info;
+    info.width = width;
+    info.height = height;
+    info.cluster_size = built_cluster_size;
+    info.diagonal = built_diagonal ? 1 : 0;
+    info.clusters_x = clusters_x;
+    info.clusters_y = clusters_y;
+
+    uint64_t n = clusters.size();
+    snapshot::Writer w(snapshot::KIND_HIERARCHICAL_PATHFINDER, SNAPSHOT_VERSION);
+    w.add_value(TAG_INFO, info);
+    w.add(TAG_COSTS, costs.ptr(), static_cast<uint64_t>(width) * height);
+    w.add_jagged<int32_t>(TAG_NODES, n, [&](uint64_t i) -> const std::vector<int32_t>& { return clusters[i].nodes; });
+    w.add_jagged<float>(TAG_DIST, n, [&](uint64_t i) -> const std::vector<float>& { return clusters[i].dist; });
+    w.add_jagged<int32_t>(TAG_LINK_OFFSETS, n, [&](uint64_t i) -> const std::vector<int32_t>& { return clusters[i].link_offsets; });
+    w.add_jagged<Link>(TAG_LINKS, n, [&](uint64_t i) -> const std::vector<Link>& { return clusters[i].links; });
+    w.add_jagged<Transition>(TAG_EAST, n, [&](uint64_t i) -> const std::vector<Transition>& { return east_transitions[i]; });
+    w.add_jagged<Transition>(TAG_SOUTH, n, [&](uint64_t i) -> const std::vector<Transition>& { return south_transitions[i]; });
+    w.add_jagged<Transition>(TAG_CORNER, n, [&](uint64_t i) -> const std::vector<Transition>& { return corner_transitions[i]; });
+    return w.finish();
+}
+
+bool HierarchicalPathfinder::load_snapshot(const PackedByteArray& data) {
+    snapshot::Reader r;
+    if (!r.open(data, snapshot::KIND_HIERARCHICAL_PATHFINDER, SNAPSHOT_VERSION, "HierarchicalPathfinder")) {
+        return false;
+    }
+
+    SnapshotInfo info;
+    PackedFloat32Array new_costs;
+    if (!r.read_value(TAG_INFO, info) || !r.read_packed<float>(TAG_COSTS, new_costs)) {
+        return false;
+    }
+    bool empty = info.width == 0 && info.height == 0 && info.clusters_x == 0 && info.clusters_y == 0;
+    if (info.cluster_size < 2 ||
+        (!empty && (info.width <= 0 || info.height <= 0 ||
+                    info.clusters_x != (info.width + info.cluster_size - 1) / info.cluster_size ||
+                    info.clusters_y != (info.height + info.cluster_size - 1) / info.cluster_size))) {
+        return r.fail("grid settings are invalid");
+    }
+    if (new_costs.size() != static_cast<int64_t>(info.width) * info.height) {
+        return r.fail("cost grid doesn't match width * height");
+    }
+
+    uint64_t n = static_cast<uint64_t>(info.clusters_x) * info.clusters_y;
+    std::vector<Cluster> new_clusters(n);
+    std::vector<std::vector<Transition>> new_east(n);
+    std::vector<std::vector<Transition>> new_south(n);
+    std::vector<std::vector<Transition>> new_corner(n);
+    if (!r.read_jagged<int32_t>(TAG_NODES, n, [&](uint64_t i) -> std::vector<int32_t>& { return new_clusters[i].nodes; }) ||
+        !r.read_jagged<float>(TAG_DIST, n, [&](uint64_t i) -> std::vector<float>& { return new_clusters[i].dist; }) ||
+        !r.read_jagged<int32_t>(TAG_LINK_OFFSETS, n, [&](uint64_t i) -> std::vector<int32_t>& { return new_clusters[i].link_offsets; }) ||
+        !r.read_jagged<Link>(TAG_LINKS, n, [&](uint64_t i) -> std::vector<Link>& { return new_clusters[i].links; }) ||
+        !r.read_jagged<Transition>(TAG_EAST, n, [&](uint64_t i) -> std::vector<Transition>& { return new_east[i]; }) ||
+        !r.read_jagged<Transition>(TAG_SOUTH, n, [&](uint64_t i) -> std::vector<Transition>& { return new_south[i]; }) ||
+        !r.read_jagged<Transition>(TAG_CORNER, n, [&](uint64_t i) -> std::vector<Transition>& { return new_corner[i]; })) {
+        return false;
+    }
+
+    // Queries index the grid and cluster arrays with these cells, so check
+    // each one lies where build() would have put it
+    int32_t cells = info.width * info.height;
+    int32_t cs = info.cluster_size;
+    auto cluster_at = [&](int32_t cell) {
+        return (cell / info.width / cs) * info.clusters_x + (cell % info.width) / cs;
+    };
+    auto in_grid = [&](int32_t cell) { return cell >= 0 && cell < cells; };
+    auto in_cluster = [&](int32_t cell, uint64_t cluster) {
+        return in_grid(cell) && static_cast<uint64_t>(cluster_at(cell)) == cluster;
+    };
+    for (uint64_t i = 0; i < n; i++) {
+        const Cluster& c = new_clusters[i];
+        size_t nodes = c.nodes.size();
+        if (c.dist.size() != nodes * nodes || c.link_offsets.size() != nodes + 1 ||
+            c.link_offsets[0] != 0 || c.link_offsets[nodes] != static_cast<int32_t>(c.links.size())) {
+            return r.fail("cluster arrays don't match their entrance count");
+        }
+        for (size_t j = 0; j < nodes; j++) {
+            if (!in_cluster(c.nodes[j], i) || (j > 0 && c.nodes[j] <= c.nodes[j - 1]) ||
+                c.link_offsets[j + 1] < c.link_offsets[j]) {
+                return r.fail("cluster entrances are invalid");
+            }
+        }
+        for (const Link& link : c.links) {
+            if (!in_grid(link.cell)) return r.fail("cluster links are out of range");
+        }
+        for (const Transition& t : new_east[i]) {
+            if (!in_cluster(t.a, i) || !in_cluster(t.b, i + 1)) return r.fail("border crossings are invalid");
+        }
+        for (const Transition& t : new_south[i]) {
+            if (!in_cluster(t.a, i) || !in_cluster(t.b, i + info.clusters_x)) return r.fail("border crossings are invalid");
+        }
+        for (const Transition& t : new_corner[i]) {
+            if (!in_cluster(t.a, i) || !in_grid(t.b)) return r.fail("border crossings are invalid");
+        }
+    }
+
+    clear();
+    costs = new_costs;
+    width = info.width;
+    height = info.height;
+    built_cluster_size = info.cluster_size;
+    built_diagonal = info.diagonal != 0;
+    cluster_size = built_cluster_size;
+    allow_diagonal = built_diagonal;
+    clusters_x = info.clusters_x;
+    clusters_y = info.clusters_y;
+    clusters.swap(new_clusters);
+    east_transitions.swap(new_east);
+    south_transitions.swap(new_south);
+    corner_transitions.swap(new_corner);
+    return true;
+}
+
+// ========== QUERIES ==========
+
+bool HierarchicalPathfinder::search_abstract(GridSearch& search, int32_t start_idx, int32_t goal_idx,
+                                             std::vector<int32_t>& waypoints) {
+    int32_t start_cluster = cluster_of(start_idx);
+    int32_t goal_cluster = cluster_of(goal_idx);
+    const Cluster& sc = clusters[start_cluster];
+    const Cluster& gc = clusters[goal_cluster];
+
+    // Connect start and goal to the entrances of their clusters
+    std::vector<float> start_dist(sc.nodes.size());
+    std::vector<float> goal_dist(gc.nodes.size());
+    float direct = INF;
+    {
+        GridSearchPool::Lease lease(local_searches);
+        cluster_dijkstra(lease.get(), cluster_bounds(start_cluster), start_idx, false, sc.nodes, start_dist.data());
+        cluster_dijkstra(lease.get(), cluster_bounds(goal_cluster), goal_idx, true, gc.nodes, goal_dist.data());
+        if (start_cluster == goal_cluster) {
+            std::vector<int32_t> goal_only(1, goal_idx);
+            cluster_dijkstra(lease.get(), cluster_bounds(start_cluster), start_idx, false, goal_only, &direct);
+        }
+    }
+
+    int32_t gx = goal_idx % width;
+    int32_t gy = goal_idx / width;
+
+    search.begin(width * height);
+    search.relax(start_idx, 0, -1, heuristic(start_idx % width, start_idx / width, gx, gy, built_diagonal));
+
+    auto relax = [&](int32_t from, float from_g, int32_t to, float edge_cost) {
+        if (!(edge_cost < INF) || search.is_closed(to)) return;
+        float new_g = from_g + edge_cost;
+        if (new_g < search.get_cost(to)) {
+            float h = heuristic(to % width, to / width, gx, gy, built_diagonal);
+            search.relax(to, new_g, from, new_g + h);
+        }
+    };
+
+    while (!search.open_empty()) {
+        float f;
+        int32_t current = search.pop(f);
+
+        if (current == goal_idx) {
+            // Collect waypoints from goal back to start
+            waypoints.clear();
+            for (int32_t cell = goal_idx; cell != -1; cell = search.get_parent(cell)) {
+                waypoints.push_back(cell);
+            }
+            std::reverse(waypoints.begin(), waypoints.end());
+            return true;
+        }
+
+        float current_g = search.get_cost(current);
+        int32_t cluster = cluster_of(current);
+        const Cluster& c = clusters[cluster];
+        int32_t slot = node_slot(c, current);
+        int32_t n = static_cast<int32_t>(c.nodes.size());
+
+        if (current == start_idx) {
+            for (int32_t j = 0; j < n; j++) {
+                relax(current, current_g, sc.nodes[j], start_dist[j]);
+            }
+            relax(current, current_g, goal_idx, direct);
+        } else if (slot >= 0) {
+            const float* row = c.dist.data() + static_cast<size_t>(slot) * n;
+            for (int32_t j = 0; j < n; j++) {
+                if (j != slot) {
+                    relax(current, current_g, c.nodes[j], row[j]);
+                }
+            }
+        }
+
+        if (slot >= 0) {
+            for (int32_t l = c.link_offsets[slot]; l < c.link_offsets[slot + 1]; l++) {
+                relax(current, current_g, c.links[l].cell, c.links[l].cost);
+            }
+            if (cluster == goal_cluster) {
+                relax(current, current_g, goal_idx, goal_dist[slot]);
+            }
+        }
+    }
+
+    return false;
+}
+
+PackedInt32Array HierarchicalPathfinder::find_abstract_path(const Vector2i& start, const Vector2i& goal,
+                                                            const Ref<PathfindingContext>& context) {
+    PackedInt32Array result;
+    if (clusters.empty()) return result;
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return result;
+    if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return result;
+
+    int32_t start_idx = start.y * width + start.x;
+    int32_t goal_idx = goal.y * width + goal.x;
+
+    const float* cost_ptr = costs.ptr();
+    if (cost_ptr[start_idx] <= 0 || cost_ptr[goal_idx] <= 0) return result;
+
+    if (context.is_null() && default_context.is_null()) {
+        default_context.instantiate();
+    }
+    GridSearch& search = context.is_valid() ? context->get_search() : default_context->get_search();
+
+    std::vector<int32_t> waypoints;
+    if (!search_abstract(search, start_idx, goal_idx, waypoints)) return result;
+
+    result.resize(static_cast<int64_t>(waypoints.size()));
+    std::copy(waypoints.begin(), waypoints.end(), result.ptrw());
+    return result;
+}
+
+PackedInt32Array HierarchicalPathfinder::find_path(const Vector2i& start, const Vector2i& goal,
+                                                   const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("HierarchicalPathfinder.find_path", 1);
+    // One context for the abstract search and every refinement step
+    Ref<PathfindingContext> ctx = context;
+    if (ctx.is_null()) {
+        if (default_context.is_null()) {
+            default_context.instantiate();
+        }
+        ctx = default_context;
+    }
+
+    PackedInt32Array waypoints = find_abstract_path(start, goal, ctx);
+    int32_t count = static_cast<int32_t>(waypoints.size());
+    if (count <= 1) return waypoints;
+
+    // Refine each abstract edge to cells with A*
+    const int32_t* wp = waypoints.ptr();
+    std::vector<int32_t> cells;
+    cells.push_back(wp[0]);
+    for (int32_t i = 1; i < count; i++) {
+        Vector2i from(wp[i - 1] % width, wp[i - 1] / width);
+        Vector2i to(wp[i] % width, wp[i] / width);
+        PackedInt32Array segment = PathfindingOps::astar_grid(costs, width, height, from, to, built_diagonal, ctx);
+        if (segment.size() == 0) return PackedInt32Array();
+
+        const int32_t* seg = segment.ptr();
+        cells.insert(cells.end(), seg + 1, seg + segment.size());
+    }
+
+    PackedInt32Array result;
+    result.resize(static_cast<int64_t>(cells.size()));
+    std::copy(cells.begin(), cells.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+// ========== INFO ==========
+
+int32_t HierarchicalPathfinder::get_width() const {
+    return width;
+}
+
+int32_t HierarchicalPathfinder::get_height() const {
+    return height;
+}
+
+int32_t HierarchicalPathfinder::get_cluster_count() const {
+    return static_cast<int32_t>(clusters.size());
+}
+
+int32_t HierarchicalPathfinder::get_node_count() const {
+    int32_t total = 0;
+    for (const Cluster& c : clusters) {
+        total += static_cast<int32_t>(c.nodes.size());
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,159 @@
+/**
+ * HierarchicalPathfinder - HPA* pathfinding for large cost grids
+ *
+ * Divides the grid into square clusters and precomputes an abstract graph:
+ * entrance cells on each shared cluster border, the cost between every pair
+ * of entrances inside a cluster, and the single-step links across borders.
+ * Queries search this small graph and refine the result to cells with the
+ * regular A* of PathfindingOps, so only a thin corridor of the map is explored.
+ *
+ * Uses the same cost grid format as PathfindingOps (row-major, positive =
+ * movement cost, 0 or negative = blocked). When part of the grid changes,
+ * update_region() rebuilds only the clusters around the changed rectangle.
+ *
+ * Paths are near-optimal: they pass through entrance cells, so they can be
+ * slightly longer than the paths found by astar_grid.
+ *
+ * Queries without a PathfindingContext share one internal context, so give
+ * each thread its own context when querying from several threads.
+ *
+ * Usage:
+ *   var hpa = HierarchicalPathfinder.new()
+ *   hpa.cluster_size = 16
+ *   hpa.build(costs, width, height)
+ *   var path = hpa.find_path(start, goal)
+ *
+ *   # After placing a building
+ *   hpa.update_region(costs, Rect2i(x, y, building_w, building_h))
+ *
+ *   # Ship the built graph with the level instead of building at load time
+ *   var data = hpa.save_snapshot()
+ *   hpa.load_snapshot(data)
+ */
+
+#ifndef AGENTITE_HIERARCHICAL_PATHFINDER_HPP
+#define AGENTITE_HIERARCHICAL_PATHFINDER_HPP
+
+#include "pathfinding_context.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+
+#include <vector>
+
+namespace godot {
+
+class HierarchicalPathfinder : public RefCounted {
+    GDCLASS(HierarchicalPathfinder, RefCounted)
+
+private:
+    // Crossing between two adjacent cells on a cluster border
+    // (a on the west/north side, b on the east/south side, possibly diagonal)
+    struct Transition {
+        int32_t a;
+        int32_t b;
+    };
+
+    // Abstract edge from an entrance to a cell in a neighboring cluster
+    struct Link {
+        int32_t cell;
+        float cost;
+    };
+
+    struct Cluster {
+        std::vector<int32_t> nodes;         // Entrance cells, sorted
+        std::vector<float> dist;            // dist[i * n + j] = cost nodes[i] -> nodes[j] inside the cluster
+        std::vector<int32_t> link_offsets;  // Links of node i are links[link_offsets[i] .. link_offsets[i + 1])
+        std::vector<Link> links;
+    };
+
+    int32_t cluster_size = 16;
+    bool allow_diagonal = true;
+
+    // Built state
+    PackedFloat32Array costs;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t built_cluster_size = 16;
+    bool built_diagonal = true;
+    int32_t clusters_x = 0;
+    int32_t clusters_y = 0;
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<Transition>> east_transitions;   // Border with the cluster to the east
+    std::vector<std::vector<Transition>> south_transitions;  // Border with the cluster to the south
+    std::vector<std::vector<Transition>> corner_transitions; // Diagonal steps from the bottom corners
+
+    // Cluster-sized searches lent to build workers and queries
+    GridSearchPool local_searches;
+
+    // Grid-sized search state for queries made without a context
+    Ref<PathfindingContext> default_context;
+
+    int32_t cluster_of(int32_t cell) const;
+    Rect2i cluster_bounds(int32_t cluster) const;
+    int32_t node_slot(const Cluster& cluster, int32_t cell) const;
+
+    void find_transitions(int32_t cluster, bool east);
+    void find_corner_transitions(int32_t cluster);
+    void build_cluster(int32_t cluster, GridSearch& search);
+    void rebuild(int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1);
+
+    // Costs from origin to each target (or from each target to origin) without leaving bounds
+    void cluster_dijkstra(GridSearch& search, const Rect2i& bounds, int32_t origin, bool reverse,
+                          const std::vector<int32_t>& targets, float* dist_out) const;
+
+    bool search_abstract(GridSearch& search, int32_t start_idx, int32_t goal_idx,
+                         std::vector<int32_t>& waypoints);
+
+protected:
+    static void _bind_methods();
+
+public:
+    HierarchicalPathfinder();
+    ~HierarchicalPathfinder();
+
+    // Configuration (applied on the next build)
+    void set_cluster_size(int32_t size);
+    int32_t get_cluster_size() const;
+
+    void set_allow_diagonal(bool enabled);
+    bool get_allow_diagonal() const;
+
+    // Build clusters and the abstract graph from a cost grid
+    void build(const PackedFloat32Array& p_costs, int32_t p_width, int32_t p_height);
+
+    // Replace the cost grid and rebuild only the clusters around region
+    void update_region(const PackedFloat32Array& p_costs, const Rect2i& region);
+
+    // Remove all data
+    void clear();
+
+    // Save the cost grid, clusters and abstract graph as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the built state with a saved snapshot, skipping the entrance searches of build()
+    // Returns false (and keeps the current state) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+
+    // Path as cell indices from start to goal, empty if unreachable
+    PackedInt32Array find_path(const Vector2i& start, const Vector2i& goal,
+                               const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
+
+    // Abstract path: start, the entrance cells passed through, and goal
+    PackedInt32Array find_abstract_path(const Vector2i& start, const Vector2i& goal,
+                                        const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
+
+    // Info
+    int32_t get_width() const;
+    int32_t get_height() const;
+    int32_t get_cluster_count() const;
+    int32_t get_node_count() const;
+};
+
+}
+
+#endif // AGENTITE_HIERARCHICAL_PATHFINDER_HPP
@@ -0,0 +1,399 @@
+/**
+ * NavMesh2D Implementation
+ */
+
+#include "nav_mesh_2d.hpp"
+#include "geometry/geometry_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace godot {
+
+// Lookup grid buckets per triangle (about one triangle per bucket)
+static const float BUCKETS_PER_TRIANGLE = 1.0f;
+
+// Largest lookup grid side, in buckets
+static const int32_t MAX_GRID_SIDE = 4096;
+
+// Minimum points per chunk for find_triangle_batch
+static const int64_t LOOKUP_CHUNK = 256;
+
+void NavMesh2D::_bind_methods() {
+    // Building
+    ClassDB::bind_method(D_METHOD("build", "boundary", "holes"), &NavMesh2D::build, DEFVAL(Array()));
+    ClassDB::bind_method(D_METHOD("clear"), &NavMesh2D::clear);
+
+    // Queries
+    ClassDB::bind_method(D_METHOD("find_triangle", "point"), &NavMesh2D::find_triangle);
+    ClassDB::bind_method(D_METHOD("find_triangle_batch", "points"), &NavMesh2D::find_triangle_batch);
+    ClassDB::bind_method(D_METHOD("find_triangle_path", "start", "goal", "context"), &NavMesh2D::find_triangle_path, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("find_path", "start", "goal", "context"), &NavMesh2D::find_path, DEFVAL(Variant()));
+
+    // Mesh data
+    ClassDB::bind_method(D_METHOD("get_vertices"), &NavMesh2D::get_vertices);
+    ClassDB::bind_method(D_METHOD("get_triangles"), &NavMesh2D::get_triangles);
+    ClassDB::bind_method(D_METHOD("get_half_edges"), &NavMesh2D::get_half_edges);
+    ClassDB::bind_method(D_METHOD("get_triangle_count"), &NavMesh2D::get_triangle_count);
+    ClassDB::bind_method(D_METHOD("get_triangle_neighbors", "triangle"), &NavMesh2D::get_triangle_neighbors);
+    ClassDB::bind_method(D_METHOD("get_triangle_center", "triangle"), &NavMesh2D::get_triangle_center);
+}
+
+NavMesh2D::NavMesh2D() {
+}
+
+NavMesh2D::~NavMesh2D() {
+}
+
+// Helper: twice the signed area of (a, b, c), positive when c is left of a -> b
+static inline double cross2(const Vector2& a, const Vector2& b, const Vector2& c) {
+    return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+           (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+}
+
+// ========== BUILDING ==========
+
+bool NavMesh2D::build(const PackedVector2Array& boundary, const Array& holes) {
+    AGENTITE_PROFILE("NavMesh2D.build", boundary.size());
+    clear();
+
+    Array mesh = GeometryOps::constrained_delaunay(boundary, holes);
+    PackedInt32Array tris = mesh[1];
+    if (tris.size() == 0) return false;
+
+    vertices = mesh[0];
+    triangles = tris;
+    half_edges = mesh[2];
+
+    int32_t tri_count = get_triangle_count();
+    const Vector2* v = vertices.ptr();
+    const int32_t* t = triangles.ptr();
+    centers.resize(tri_count);
+    for (int32_t i = 0; i < tri_count; i++) {
+        centers[i] = (v[t[3 * i]] + v[t[3 * i + 1]] + v[t[3 * i + 2]]) / 3.0f;
+    }
+
+    build_lookup();
+    return true;
+}
+
+void NavMesh2D::build_lookup() {
+    int32_t tri_count = get_triangle_count();
+    const Vector2* v = vertices.ptr();
+    const int32_t* t = triangles.ptr();
+
+    Vector2 lo = v[t[0]];
+    Vector2 hi = lo;
+    for (int32_t e = 0; e < triangles.size(); e++) {
+        lo.x = std::min(lo.x, v[t[e]].x);
+        lo.y = std::min(lo.y, v[t[e]].y);
+        hi.x = std::max(hi.x, v[t[e]].x);
+        hi.y = std::max(hi.y, v[t[e]].y);
+    }
+    Vector2 extent = hi - lo;
+
+    // Square buckets, about BUCKETS_PER_TRIANGLE of them per triangle
+    float area = std::max(extent.x, 1e-6f) * std::max(extent.y, 1e-6f);
+    grid_cell_size = std::sqrt(area / (tri_count * BUCKETS_PER_TRIANGLE));
+    grid_cell_size = std::max({grid_cell_size, extent.x / MAX_GRID_SIDE, extent.y / MAX_GRID_SIDE, 1e-6f});
+    grid_origin = lo;
+    grid_extent = extent;
+    grid_width = std::min(MAX_GRID_SIDE, static_cast<int32_t>(extent.x / grid_cell_size) + 1);
+    grid_height = std::min(MAX_GRID_SIDE, static_cast<int32_t>(extent.y / grid_cell_size) + 1);
+
+    // Bucket range covered by a triangle's bounding box
+    auto bucket_range = [&](int32_t tri, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) {
+        Vector2 a = v[t[3 * tri]];
+        Vector2 b = v[t[3 * tri + 1]];
+        Vector2 c = v[t[3 * tri + 2]];
+        float min_x = (std::min({a.x, b.x, c.x}) - grid_origin.x) / grid_cell_size;
+        float min_y = (std::min({a.y, b.y, c.y}) - grid_origin.y) / grid_cell_size;
+        float max_x = (std::max({a.x, b.x, c.x}) - grid_origin.x) / grid_cell_size;
+        float max_y = (std::max({a.y, b.y, c.y}) - grid_origin.y) / grid_cell_size;
+        x0 = std::clamp(static_cast<int32_t>(min_x), 0, grid_width - 1);
+        y0 = std::clamp(static_cast<int32_t>(min_y), 0, grid_height - 1);
+        x1 = std::clamp(static_cast<int32_t>(max_x), 0, grid_width - 1);
+        y1 = std::clamp(static_cast<int32_t>(max_y), 0, grid_height - 1);
+    };
+
+    // Counting sort of triangles into buckets
+    bucket_offsets.assign(static_cast<size_t>(grid_width) * grid_height + 1, 0);
+    for (int32_t i = 0; i < tri_count; i++) {
+        int32_t x0, y0, x1, y1;
+        bucket_range(i, x0, y0, x1, y1);
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                bucket_offsets[y * grid_width + x + 1]++;
+            }
+        }
+    }
+    for (size_t b = 1; b < bucket_offsets.size(); b++) {
+        bucket_offsets[b] += bucket_offsets[b - 1];
+    }
+
+    bucket_triangles.resize(bucket_offsets.back());
+    std::vector<int32_t> fill(bucket_offsets.begin(), bucket_offsets.end() - 1);
+    for (int32_t i = 0; i < tri_count; i++) {
+        int32_t x0, y0, x1, y1;
+        bucket_range(i, x0, y0, x1, y1);
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                bucket_triangles[fill[y * grid_width + x]++] = i;
+            }
+        }
+    }
+}
+
+void NavMesh2D::clear() {
+    vertices = PackedVector2Array();
+    triangles = PackedInt32Array();
+    half_edges = PackedInt32Array();
+    centers.clear();
+    grid_width = 0;
+    grid_height = 0;
+    bucket_offsets.clear();
+    bucket_triangles.clear();
+    default_context.unref();
+}
+
+// ========== POINT LOCATION ==========
+
+bool NavMesh2D::triangle_contains(int32_t triangle, const Vector2& point) const {
+    const Vector2* v = vertices.ptr();
+    const int32_t* t = triangles.ptr() + 3 * triangle;
+    return cross2(v[t[0]], v[t[1]], point) >= 0.0 &&
+           cross2(v[t[1]], v[t[2]], point) >= 0.0 &&
+           cross2(v[t[2]], v[t[0]], point) >= 0.0;
+}
+
+int32_t NavMesh2D::find_triangle(const Vector2& point) const {
+    if (grid_width == 0) return -1;
+
+    float dx = point.x - grid_origin.x;
+    float dy = point.y - grid_origin.y;
+    if (!(dx >= 0.0f && dx <= grid_extent.x && dy >= 0.0f && dy <= grid_extent.y)) return -1;
+
+    // The far edge (and, when the grid side is clamped, a sliver before it)
+    // falls in the last bucket, as it does for the triangles in build_lookup()
+    int32_t x = std::min(static_cast<int32_t>(dx / grid_cell_size), grid_width - 1);
+    int32_t y = std::min(static_cast<int32_t>(dy / grid_cell_size), grid_height - 1);
+    int32_t bucket = y * grid_width + x;
+    for (int32_t i = bucket_offsets[bucket]; i < bucket_offsets[bucket + 1]; i++) {
+        if (triangle_contains(bucket_triangles[i], point)) {
+            return bucket_triangles[i];
+        }
+    }
+    return -1;
+}
+
+PackedInt32Array NavMesh2D::find_triangle_batch(const PackedVector2Array& points) const {
+    AGENTITE_PROFILE("NavMesh2D.find_triangle_batch", points.size());
+    PackedInt32Array result;
+    int64_t count = points.size();
+    result.resize(count);
+
+    const Vector2* p = points.ptr();
+    int32_t* out = result.ptrw();
+    parallel::for_range(count, LOOKUP_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            out[i] = find_triangle(p[i]);
+        }
+    });
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+// ========== QUERIES ==========
+
+GridSearch& NavMesh2D::search_for(const Ref<PathfindingContext>& context) {
+    if (context.is_null() && default_context.is_null()) {
+        default_context.instantiate();
+    }
+    return context.is_valid() ? context->get_search() : default_context->get_search();
+}
+
+// A* over triangles. A triangle stands at its centroid, except the start and
+// goal triangles, which stand at the start and goal points.
+bool NavMesh2D::search_corridor(GridSearch& search, int32_t start_tri, int32_t goal_tri,
+                                const Vector2& start, const Vector2& goal, std::vector<int32_t>& corridor) const {
+    corridor.clear();
+    const int32_t* he = half_edges.ptr();
+
+    auto position = [&](int32_t tri) {
+        return tri == start_tri ? start : (tri == goal_tri ? goal : centers[tri]);
+    };
+
+    search.begin(get_triangle_count());
+    search.relax(start_tri, 0.0f, -1, start.distance_to(goal));
+
+    while (!search.open_empty()) {
+        float f;
+        int32_t current = search.pop(f);
+
+        if (current == goal_tri) {
+            for (int32_t tri = goal_tri; tri != -1; tri = search.get_parent(tri)) {
+                corridor.push_back(tri);
+            }
+            std::reverse(corridor.begin(), corridor.end());
+            return true;
+        }
+
+        float current_g = search.get_cost(current);
+        Vector2 from = position(current);
+        for (int32_t k = 0; k < 3; k++) {
+            int32_t opposite = he[3 * current + k];
+            if (opposite == -1) continue;
+            int32_t next = opposite / 3;
+            if (search.is_closed(next)) continue;
+
+            Vector2 to = position(next);
+            float new_g = current_g + from.distance_to(to);
+            if (new_g < search.get_cost(next)) {
+                search.relax(next, new_g, current, new_g + to.distance_to(goal));
+            }
+        }
+    }
+
+    return false;
+}
+
+PackedInt32Array NavMesh2D::find_triangle_path(const Vector2& start, const Vector2& goal,
+                                               const Ref<PathfindingContext>& context) {
+    PackedInt32Array result;
+    int32_t start_tri = find_triangle(start);
+    int32_t goal_tri = find_triangle(goal);
+    if (start_tri == -1 || goal_tri == -1) return result;
+
+    std::vector<int32_t> corridor;
+    if (!search_corridor(search_for(context), start_tri, goal_tri, start, goal, corridor)) return result;
+
+    result.resize(static_cast<int64_t>(corridor.size()));
+    std::copy(corridor.begin(), corridor.end(), result.ptrw());
+    return result;
+}
+
+PackedVector2Array NavMesh2D::find_path(const Vector2& start, const Vector2& goal,
+                                        const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("NavMesh2D.find_path", 1);
+    PackedVector2Array result;
+    int32_t start_tri = find_triangle(start);
+    int32_t goal_tri = find_triangle(goal);
+    if (start_tri == -1 || goal_tri == -1) return result;
+
+    std::vector<int32_t> corridor;
+    if (!search_corridor(search_for(context), start_tri, goal_tri, start, goal, corridor)) return result;
+
+    // Portals: the shared edge between consecutive triangles, as seen when
+    // walking forward (left and right endpoints), between start and goal
+    const Vector2* v = vertices.ptr();
+    const int32_t* t = triangles.ptr();
+    const int32_t* he = half_edges.ptr();
+    size_t portal_count = corridor.size() + 1;
+    std::vector<Vector2> left(portal_count);
+    std::vector<Vector2> right(portal_count);
+    left[0] = right[0] = start;
+    for (size_t i = 0; i + 1 < corridor.size(); i++) {
+        int32_t base = 3 * corridor[i];
+        for (int32_t k = 0; k < 3; k++) {
+            if (he[base + k] != -1 && he[base + k] / 3 == corridor[i + 1]) {
+                // Counter-clockwise triangle: its exit edge runs right -> left
+                right[i + 1] = v[t[base + k]];
+                left[i + 1] = v[t[base + (k + 1) % 3]];
+                break;
+            }
+        }
+    }
+    left[portal_count - 1] = right[portal_count - 1] = goal;
+
+    // Funnel algorithm (string pulling through the portals)
+    std::vector<Vector2> points;
+    points.push_back(start);
+    Vector2 apex = start;
+    Vector2 funnel_left = start;
+    Vector2 funnel_right = start;
+    size_t left_index = 0;
+    size_t right_index = 0;
+
+    for (size_t i = 1; i < portal_count; i++) {
+        // Narrow the right side; if it crosses the left side, the left point is a corner
+        if (cross2(apex, funnel_right, right[i]) >= 0.0) {
+            if (apex == funnel_right || cross2(apex, funnel_left, right[i]) < 0.0) {
+                funnel_right = right[i];
+                right_index = i;
+            } else {
+                if (points.back() != funnel_left) points.push_back(funnel_left);
+                apex = funnel_left;
+                funnel_right = apex;
+                right_index = left_index;
+                i = left_index;
+                continue;
+            }
+        }
+
+        // Same for the left side
+        if (cross2(apex, funnel_left, left[i]) <= 0.0) {
+            if (apex == funnel_left || cross2(apex, funnel_right, left[i]) > 0.0) {
+                funnel_left = left[i];
+                left_index = i;
+            } else {
+                if (points.back() != funnel_right) points.push_back(funnel_right);
+                apex = funnel_right;
+                funnel_left = apex;
+                left_index = right_index;
+                i = right_index;
+                continue;
+            }
+        }
+    }
+
+    if (points.back() != goal) {
+        points.push_back(goal);
+    }
+
+    result.resize(static_cast<int64_t>(points.size()));
+    std::copy(points.begin(), points.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
+    return result;
+}
+
+// ========== MESH DATA ==========
+
+PackedVector2Array NavMesh2D::get_vertices() const {
+    return vertices;
+}
+
+PackedInt32Array NavMesh2D::get_triangles() const {
+    return triangles;
+}
+
+PackedInt32Array NavMesh2D::get_half_edges() const {
+    return half_edges;
+}
+
+int32_t NavMesh2D::get_triangle_count() const {
+    return static_cast<int32_t>(triangles.size() / 3);
+}
+
+PackedInt32Array NavMesh2D::get_triangle_neighbors(int32_t triangle) const {
+    PackedInt32Array result;
+    if (triangle < 0 || triangle >= get_triangle_count()) return result;
+
+    result.resize(3);
+    const int32_t* he = half_edges.ptr();
+    for (int32_t k = 0; k < 3; k++) {
+        int32_t opposite = he[3 * triangle + k];
+        result.set(k, opposite == -1 ? -1 : opposite / 3);
+    }
+    return result;
+}
+
+Vector2 NavMesh2D::get_triangle_center(int32_t triangle) const {
+    if (triangle < 0 || triangle >= get_triangle_count()) return Vector2();
+    return centers[triangle];
+}
+
+}
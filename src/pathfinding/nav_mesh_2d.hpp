@@ -0,0 +1,111 @@
+/**
+ * NavMesh2D - Triangle navigation mesh built from obstacle polygons
+ *
+ * Triangulates a walkable boundary polygon with holes (obstacles) using
+ * GeometryOps.constrained_delaunay, so walls are triangle edges and every
+ * triangle is walkable. Paths are found with A* over adjacent triangles and
+ * then pulled tight through the shared edges (portals) with the funnel
+ * algorithm, giving any-angle paths that hug obstacle corners.
+ *
+ * A uniform grid of buckets over the triangles' bounding boxes answers
+ * "which triangle contains this point" in O(1) expected time.
+ *
+ * Queries without a PathfindingContext share one internal context, so give
+ * each thread its own context when querying from several threads.
+ *
+ * Usage:
+ *   var nav = NavMesh2D.new()
+ *   nav.build(level_outline, [rock_polygon, house_polygon])
+ *   var path = nav.find_path(unit.position, target)
+ */
+
+#ifndef AGENTITE_NAV_MESH_2D_HPP
+#define AGENTITE_NAV_MESH_2D_HPP
+
+#include "pathfinding_context.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class NavMesh2D : public RefCounted {
+    GDCLASS(NavMesh2D, RefCounted)
+
+private:
+    // Built mesh
+    PackedVector2Array vertices;
+    PackedInt32Array triangles;   // Three vertex indices per triangle, counter-clockwise
+    PackedInt32Array half_edges;  // Opposite half-edge, -1 on walls
+    std::vector<Vector2> centers;
+
+    // Triangle lookup grid: bucket b holds bucket_triangles[bucket_offsets[b] .. bucket_offsets[b + 1])
+    Vector2 grid_origin;
+    Vector2 grid_extent;  // Size of the mesh bounding box (may overrun the last bucket when clamped)
+    float grid_cell_size = 1.0f;
+    int32_t grid_width = 0;
+    int32_t grid_height = 0;
+    std::vector<int32_t> bucket_offsets;
+    std::vector<int32_t> bucket_triangles;
+
+    // Search state for queries made without a context
+    Ref<PathfindingContext> default_context;
+
+    void build_lookup();
+    bool triangle_contains(int32_t triangle, const Vector2& point) const;
+
+    // Triangles from start_tri to goal_tri, empty if unreachable
+    bool search_corridor(GridSearch& search, int32_t start_tri, int32_t goal_tri,
+                         const Vector2& start, const Vector2& goal, std::vector<int32_t>& corridor) const;
+    GridSearch& search_for(const Ref<PathfindingContext>& context);
+
+protected:
+    static void _bind_methods();
+
+public:
+    NavMesh2D();
+    ~NavMesh2D();
+
+    // Triangulate the area inside boundary and outside every hole
+    // (Array of PackedVector2Array). Returns false if the outlines are invalid.
+    bool build(const PackedVector2Array& boundary, const Array& holes = Array());
+
+    // Remove all data
+    void clear();
+
+    // Triangle containing point, or -1 if it is outside the mesh
+    int32_t find_triangle(const Vector2& point) const;
+
+    // find_triangle for many points (multithreaded)
+    PackedInt32Array find_triangle_batch(const PackedVector2Array& points) const;
+
+    // Triangles crossed from start to goal, empty if unreachable
+    PackedInt32Array find_triangle_path(const Vector2& start, const Vector2& goal,
+                                        const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
+
+    // Shortest-corner path from start to goal (both included), empty if unreachable
+    PackedVector2Array find_path(const Vector2& start, const Vector2& goal,
+                                 const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
+
+    // Mesh data
+    PackedVector2Array get_vertices() const;
+    PackedInt32Array get_triangles() const;
+    PackedInt32Array get_half_edges() const;
+    int32_t get_triangle_count() const;
+
+    // Neighboring triangles across each edge of triangle, -1 for walls
+    PackedInt32Array get_triangle_neighbors(int32_t triangle) const;
+
+    // Centroid of triangle
+    Vector2 get_triangle_center(int32_t triangle) const;
+};
+
+}
+
+#endif // AGENTITE_NAV_MESH_2D_HPP
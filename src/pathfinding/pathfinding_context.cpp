@@ -0,0 +1,62 @@
+/**
+ * PathfindingContext Implementation
+ */
+
+#include "pathfinding_context.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+namespace godot {
+
+void PathfindingContext::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("reserve", "cell_count"), &PathfindingContext::reserve);
+    ClassDB::bind_method(D_METHOD("get_cell_capacity"), &PathfindingContext::get_cell_capacity);
+    ClassDB::bind_method(D_METHOD("clear"), &PathfindingContext::clear);
+}
+
+PathfindingContext::PathfindingContext() {
+}
+
+PathfindingContext::~PathfindingContext() {
+}
+
+void PathfindingContext::reserve(int32_t cell_count) {
+    if (cell_count > search.get_cell_capacity()) {
+        search.begin(cell_count);
+    }
+}
+
+int32_t PathfindingContext::get_cell_capacity() const {
+    return search.get_cell_capacity();
+}
+
+void PathfindingContext::clear() {
+    search.release();
+    workers.clear();
+}
+
+// ========== GridSearchPool ==========
+
+GridSearch* GridSearchPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idle.empty()) {
+        searches.push_back(std::make_unique<GridSearch>());
+        return searches.back().get();
+    }
+    GridSearch* search = idle.back();
+    idle.pop_back();
+    return search;
+}
+
+void GridSearchPool::release(GridSearch* search) {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(search);
+}
+
+void GridSearchPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.clear();
+    searches.clear();
+}
+
+}
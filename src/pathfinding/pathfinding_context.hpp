@@ -0,0 +1,253 @@
+/**
+ * PathfindingContext - Reusable search state for grid pathfinding
+ *
+ * Owns the per-cell cost, parent and open-list buffers used by the A*, JPS,
+ * Dijkstra and reachability searches in PathfindingOps. Cells are stamped
+ * with a search generation instead of being cleared, so once the buffers
+ * have grown to the grid size a search starts in O(1) and allocates nothing.
+ *
+ * A context holds the state of one search at a time. Do not share one
+ * context between searches running on different threads. Batch searches
+ * such as astar_batch keep a separate set of per-thread buffers in the
+ * context, so those may be given a context too.
+ *
+ * Usage:
+ *   var ctx = PathfindingContext.new()
+ *   for unit in units:
+ *       var path = PathfindingOps.astar_grid(costs, width, height, unit.cell, goal, true, ctx)
+ */
+
+#ifndef AGENTITE_PATHFINDING_CONTEXT_HPP
+#define AGENTITE_PATHFINDING_CONTEXT_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace godot {
+
+// Per-cell search state and an indexed binary heap keyed by priority.
+// Plain C++ so searches without a PathfindingContext can use a local one.
+class GridSearch {
+public:
+    // Start a new search over cell_count cells. Invalidates all cell state.
+    void begin(int32_t cell_count);
+
+    // Best known cost to reach a cell this search (INF if not reached)
+    float get_cost(int32_t cell) const {
+        const Cell& c = cells[cell];
+        return c.stamp == generation ? c.cost : std::numeric_limits<float>::infinity();
+    }
+
+    // Cell the best known path arrived from (-1 for start or unreached cells)
+    int32_t get_parent(int32_t cell) const {
+        const Cell& c = cells[cell];
+        return c.stamp == generation ? c.parent : -1;
+    }
+
+    // True once a cell has been popped from the open list
+    bool is_closed(int32_t cell) const {
+        const Cell& c = cells[cell];
+        return c.stamp == generation && c.heap_pos == CLOSED;
+    }
+
+    // Record a new best cost for a cell and open it (or lower its priority)
+    void relax(int32_t cell, float cost, int32_t parent, float priority);
+
+    bool open_empty() const { return open.empty(); }
+
+    // Remove the open cell with the lowest priority and close it
+    int32_t pop(float& priority);
+
+    // Flag a cell for this search only (e.g. as a goal)
+    void mark(int32_t cell) { marks[cell] = generation; }
+    bool is_marked(int32_t cell) const { return marks[cell] == generation; }
+
+    int32_t get_cell_capacity() const { return static_cast<int32_t>(cells.size()); }
+
+    // Free all buffers
+    void release();
+
+private:
+    static constexpr int32_t CLOSED = -1;
+    static constexpr int32_t NOT_OPEN = -2;
+
+    struct Cell {
+        uint32_t stamp = 0;
+        int32_t parent = -1;
+        float cost = 0.0f;
+        int32_t heap_pos = NOT_OPEN;
+    };
+
+    struct OpenEntry {
+        float priority;
+        int32_t cell;
+    };
+
+    std::vector<Cell> cells;
+    std::vector<uint32_t> marks;
+    std::vector<OpenEntry> open;
+    uint32_t generation = 0;
+
+    void sift_up(int32_t pos);
+    void sift_down(int32_t pos);
+};
+
+// GridSearch objects lent to worker threads one at a time (C++ only)
+class GridSearchPool {
+public:
+    // Borrows a GridSearch for the lifetime of the lease
+    class Lease {
+    public:
+        explicit Lease(GridSearchPool& p_pool) : pool(p_pool), search(p_pool.acquire()) {}
+        ~Lease() { pool.release(search); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        GridSearch& get() { return *search; }
+
+    private:
+        GridSearchPool& pool;
+        GridSearch* search;
+    };
+
+    GridSearch* acquire();
+    void release(GridSearch* search);
+
+    // Free all pooled searches (none may be leased)
+    void clear();
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<GridSearch>> searches;
+    std::vector<GridSearch*> idle;
+};
+
+class PathfindingContext : public RefCounted {
+    GDCLASS(PathfindingContext, RefCounted)
+
+private:
+    GridSearch search;
+    GridSearchPool workers;
+
+protected:
+    static void _bind_methods();
+
+public:
+    PathfindingContext();
+    ~PathfindingContext();
+
+    // Grow the buffers up front for grids of up to cell_count cells
+    void reserve(int32_t cell_count);
+
+    // Number of cells the buffers currently cover
+    int32_t get_cell_capacity() const;
+
+    // Free all buffers (they grow again on the next search)
+    void clear();
+
+    // C++ API: search state used by PathfindingOps
+    GridSearch& get_search() { return search; }
+
+    // C++ API: per-thread search state for batch searches
+    GridSearchPool& get_worker_pool() { return workers; }
+};
+
+inline void GridSearch::begin(int32_t cell_count) {
+    if (static_cast<int32_t>(cells.size()) < cell_count) {
+        cells.resize(cell_count);
+        marks.resize(cell_count, 0);
+    }
+    open.clear();
+
+    generation++;
+    if (generation == 0) {
+        // Stamps wrapped around: forget every old stamp once
+        for (Cell& c : cells) {
+            c.stamp = 0;
+        }
+        std::fill(marks.begin(), marks.end(), 0);
+        generation = 1;
+    }
+}
+
+inline void GridSearch::relax(int32_t cell, float cost, int32_t parent, float priority) {
+    Cell& c = cells[cell];
+    if (c.stamp != generation) {
+        c.stamp = generation;
+        c.heap_pos = NOT_OPEN;
+    }
+    c.cost = cost;
+    c.parent = parent;
+
+    if (c.heap_pos >= 0) {
+        open[c.heap_pos].priority = priority;
+        sift_up(c.heap_pos);
+    } else {
+        c.heap_pos = static_cast<int32_t>(open.size());
+        open.push_back({priority, cell});
+        sift_up(c.heap_pos);
+    }
+}
+
+inline int32_t GridSearch::pop(float& priority) {
+    OpenEntry top = open[0];
+    priority = top.priority;
+    cells[top.cell].heap_pos = CLOSED;
+
+    OpenEntry last = open.back();
+    open.pop_back();
+    if (!open.empty()) {
+        open[0] = last;
+        cells[last.cell].heap_pos = 0;
+        sift_down(0);
+    }
+    return top.cell;
+}
+
+inline void GridSearch::sift_up(int32_t pos) {
+    OpenEntry entry = open[pos];
+    while (pos > 0) {
+        int32_t parent = (pos - 1) / 2;
+        if (!(entry.priority < open[parent].priority)) break;
+        open[pos] = open[parent];
+        cells[open[pos].cell].heap_pos = pos;
+        pos = parent;
+    }
+    open[pos] = entry;
+    cells[entry.cell].heap_pos = pos;
+}
+
+inline void GridSearch::sift_down(int32_t pos) {
+    int32_t size = static_cast<int32_t>(open.size());
+    OpenEntry entry = open[pos];
+    while (true) {
+        int32_t child = pos * 2 + 1;
+        if (child >= size) break;
+        if (child + 1 < size && open[child + 1].priority < open[child].priority) {
+            child++;
+        }
+        if (!(open[child].priority < entry.priority)) break;
+        open[pos] = open[child];
+        cells[open[pos].cell].heap_pos = pos;
+        pos = child;
+    }
+    open[pos] = entry;
+    cells[entry.cell].heap_pos = pos;
+}
+
+inline void GridSearch::release() {
+    std::vector<Cell>().swap(cells);
+    std::vector<uint32_t>().swap(marks);
+    std::vector<OpenEntry>().swap(open);
+    generation = 0;
+}
+
+}
+
+#endif // AGENTITE_PATHFINDING_CONTEXT_HPP
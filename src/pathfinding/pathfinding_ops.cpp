@@ -3,51 +3,44 @@
  */
 
 #include "pathfinding_ops.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
 #include <cmath>
-#include <queue>
 #include <vector>
-#include <unordered_set>
 #include <algorithm>
 #include <limits>
 
 namespace godot {
 
-// Priority queue node for A* and Dijkstra
-struct PathNode {
-    int index;
-    float f_cost;  // For A*: g + h, for Dijkstra: g only
-
-    bool operator>(const PathNode& other) const {
-        return f_cost > other.f_cost;
-    }
-};
-
 // Constants
 static const float INF = std::numeric_limits<float>::infinity();
 static const float SQRT2 = 1.41421356237f;
 
+// Minimum searches per chunk for batch pathfinding
+static const int64_t PATH_BATCH_CHUNK = 4;
+
 void PathfindingOps::_bind_methods() {
     // A*
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_grid", "costs", "width", "height", "start", "goal", "allow_diagonal"), &PathfindingOps::astar_grid);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_grid_weighted", "costs", "width", "height", "start", "goal", "allow_diagonal", "heuristic_weight"), &PathfindingOps::astar_grid_weighted);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_uniform", "walkable", "width", "height", "start", "goal", "allow_diagonal"), &PathfindingOps::astar_uniform);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_grid", "costs", "width", "height", "start", "goal", "allow_diagonal", "context"), &PathfindingOps::astar_grid, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_grid_weighted", "costs", "width", "height", "start", "goal", "allow_diagonal", "heuristic_weight", "context"), &PathfindingOps::astar_grid_weighted, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_uniform", "walkable", "width", "height", "start", "goal", "allow_diagonal", "context"), &PathfindingOps::astar_uniform, DEFVAL(Variant()));
 
     // Dijkstra
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_grid", "costs", "width", "height", "start", "goals"), &PathfindingOps::dijkstra_grid);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_map", "costs", "width", "height", "goals"), &PathfindingOps::dijkstra_map);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_map_single", "costs", "width", "height", "goal"), &PathfindingOps::dijkstra_map_single);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_grid", "costs", "width", "height", "start", "goals", "context"), &PathfindingOps::dijkstra_grid, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_map", "costs", "width", "height", "goals", "context"), &PathfindingOps::dijkstra_map, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("dijkstra_map_single", "costs", "width", "height", "goal", "context"), &PathfindingOps::dijkstra_map_single, DEFVAL(Variant()));
 
     // Flow fields
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("flow_field", "costs", "width", "height", "goal"), &PathfindingOps::flow_field);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("flow_field_multi", "costs", "width", "height", "goals"), &PathfindingOps::flow_field_multi);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("flow_field", "costs", "width", "height", "goal", "context"), &PathfindingOps::flow_field, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("flow_field_multi", "costs", "width", "height", "goals", "context"), &PathfindingOps::flow_field_multi, DEFVAL(Variant()));
     ClassDB::bind_static_method("PathfindingOps", D_METHOD("flow_field_from_dijkstra", "dijkstra_map", "width", "height"), &PathfindingOps::flow_field_from_dijkstra);
 
     // JPS
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("jps_grid", "walkable", "width", "height", "start", "goal"), &PathfindingOps::jps_grid);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("jps_grid", "walkable", "width", "height", "start", "goal", "context"), &PathfindingOps::jps_grid, DEFVAL(Variant()));
 
     // Path utilities
     ClassDB::bind_static_method("PathfindingOps", D_METHOD("smooth_path", "path", "iterations"), &PathfindingOps::smooth_path);
@@ -56,12 +49,13 @@ void PathfindingOps::_bind_methods() {
     ClassDB::bind_static_method("PathfindingOps", D_METHOD("simplify_path", "path", "width"), &PathfindingOps::simplify_path);
 
     // Batch
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_batch", "costs", "width", "height", "starts", "goals", "allow_diagonal"), &PathfindingOps::astar_batch);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_batch", "costs", "width", "height", "starts", "goals", "allow_diagonal", "context"), &PathfindingOps::astar_batch, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("astar_batch_flat", "costs", "width", "height", "starts", "goals", "allow_diagonal", "out", "context"), &PathfindingOps::astar_batch_flat, DEFVAL(Variant()), DEFVAL(Variant()));
 
     // Reachability
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("reachable_cells", "costs", "width", "height", "start", "max_cost"), &PathfindingOps::reachable_cells);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("is_reachable", "costs", "width", "height", "start", "goal"), &PathfindingOps::is_reachable);
-    ClassDB::bind_static_method("PathfindingOps", D_METHOD("path_cost", "costs", "width", "height", "start", "goal", "allow_diagonal"), &PathfindingOps::path_cost);
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("reachable_cells", "costs", "width", "height", "start", "max_cost", "context"), &PathfindingOps::reachable_cells, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("is_reachable", "costs", "width", "height", "start", "goal", "context"), &PathfindingOps::is_reachable, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PathfindingOps", D_METHOD("path_cost", "costs", "width", "height", "start", "goal", "allow_diagonal", "context"), &PathfindingOps::path_cost, DEFVAL(Variant()));
 }
 
 // Helper: heuristic for A*
@@ -77,66 +71,52 @@ static inline float heuristic(int x1, int y1, int x2, int y2, bool diagonal) {
     }
 }
 
-// Helper: reconstruct path from came_from array
-static PackedInt32Array reconstruct_path(const std::vector<int>& came_from, int start_idx, int goal_idx) {
-    PackedInt32Array path;
+// Helper: number of cells on the path recorded during a search
+static int path_length(const GridSearch& search, int start_idx, int goal_idx) {
+    int length = 0;
     int current = goal_idx;
-
     while (current != start_idx && current != -1) {
-        path.append(current);
-        current = came_from[current];
+        length++;
+        current = search.get_parent(current);
     }
+    return current == start_idx ? length + 1 : length;
+}
 
-    if (current == start_idx) {
-        path.append(start_idx);
+// Helper: write the recorded path from start to goal into dst (path_length entries)
+static void write_path(const GridSearch& search, int start_idx, int goal_idx, int32_t* dst) {
+    // Fill back to front so the path runs from start to goal
+    int pos = path_length(search, start_idx, goal_idx) - 1;
+    int current = goal_idx;
+    while (current != start_idx && current != -1) {
+        dst[pos--] = current;
+        current = search.get_parent(current);
     }
-
-    // Reverse path
-    int n = path.size();
-    int32_t* ptr = path.ptrw();
-    for (int i = 0; i < n / 2; i++) {
-        int temp = ptr[i];
-        ptr[i] = ptr[n - 1 - i];
-        ptr[n - 1 - i] = temp;
+    if (current == start_idx) {
+        dst[0] = start_idx;
     }
-
-    return path;
 }
 
-// ========== A* PATHFINDING ==========
-
-PackedInt32Array PathfindingOps::astar_grid(const PackedFloat32Array& costs, int width, int height,
-                                            const Vector2i& start, const Vector2i& goal,
-                                            bool allow_diagonal) {
-    return astar_grid_weighted(costs, width, height, start, goal, allow_diagonal, 1.0f);
+// Helper: reconstruct path from the parents recorded during a search
+static PackedInt32Array reconstruct_path(const GridSearch& search, int start_idx, int goal_idx) {
+    PackedInt32Array path;
+    path.resize(path_length(search, start_idx, goal_idx));
+    write_path(search, start_idx, goal_idx, path.ptrw());
+    return path;
 }
 
-PackedInt32Array PathfindingOps::astar_grid_weighted(const PackedFloat32Array& costs, int width, int height,
-                                                     const Vector2i& start, const Vector2i& goal,
-                                                     bool allow_diagonal, float heuristic_weight) {
-    PackedInt32Array empty_result;
-    int size = width * height;
-
-    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return empty_result;
-    if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return empty_result;
-
-    int start_idx = start.y * width + start.x;
+// Helper: A* from start to goal, cell_cost(index) <= 0 means blocked.
+// Returns true if goal was reached; the path is left in search.
+template <typename CellCost>
+static bool astar_search(GridSearch& search, const CellCost& cell_cost, int width, int height,
+                         int start_idx, const Vector2i& goal, bool allow_diagonal, float heuristic_weight) {
     int goal_idx = goal.y * width + goal.x;
 
-    const float* cost_ptr = costs.ptr();
-
-    // Check if start or goal is blocked
-    if (cost_ptr[start_idx] <= 0 || cost_ptr[goal_idx] <= 0) return empty_result;
-
-    std::vector<float> g_cost(size, INF);
-    std::vector<int> came_from(size, -1);
-    std::vector<bool> closed(size, false);
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
+    search.begin(width * height);
 
-    g_cost[start_idx] = 0;
-    float h = heuristic(start.x, start.y, goal.x, goal.y, allow_diagonal) * heuristic_weight;
-    open.push({start_idx, h});
+    int sx = start_idx % width;
+    int sy = start_idx / width;
+    float h = heuristic(sx, sy, goal.x, goal.y, allow_diagonal) * heuristic_weight;
+    search.relax(start_idx, 0, -1, h);
 
     // Direction arrays
     static const int dx4[] = {0, 1, 0, -1};
@@ -149,19 +129,17 @@ PackedInt32Array PathfindingOps::astar_grid_weighted(const PackedFloat32Array& c
     const int* dy = allow_diagonal ? dy8 : dy4;
     int dir_count = allow_diagonal ? 8 : 4;
 
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
+    while (!search.open_empty()) {
+        float f;
+        int current = search.pop(f);
 
-        if (current.index == goal_idx) {
-            return reconstruct_path(came_from, start_idx, goal_idx);
+        if (current == goal_idx) {
+            return true;
         }
 
-        if (closed[current.index]) continue;
-        closed[current.index] = true;
-
-        int cx = current.index % width;
-        int cy = current.index / width;
+        int cx = current % width;
+        int cy = current / width;
+        float current_g = search.get_cost(current);
 
         for (int d = 0; d < dir_count; d++) {
             int nx = cx + dx[d];
@@ -170,48 +148,101 @@ PackedInt32Array PathfindingOps::astar_grid_weighted(const PackedFloat32Array& c
             if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
 
             int ni = ny * width + nx;
-            if (closed[ni]) continue;
+            if (search.is_closed(ni)) continue;
 
-            float cell_cost = cost_ptr[ni];
-            if (cell_cost <= 0) continue;  // Blocked
+            float cost = cell_cost(ni);
+            if (cost <= 0) continue;  // Blocked
 
             float move_cost = allow_diagonal ? cost8[d] : 1.0f;
-            float new_g = g_cost[current.index] + move_cost * cell_cost;
+            float new_g = current_g + move_cost * cost;
 
-            if (new_g < g_cost[ni]) {
-                g_cost[ni] = new_g;
-                came_from[ni] = current.index;
-                float h = heuristic(nx, ny, goal.x, goal.y, allow_diagonal) * heuristic_weight;
-                open.push({ni, new_g + h});
+            if (new_g < search.get_cost(ni)) {
+                float nh = heuristic(nx, ny, goal.x, goal.y, allow_diagonal) * heuristic_weight;
+                search.relax(ni, new_g, current, new_g + nh);
             }
         }
     }
 
-    return empty_result;  // No path found
+    return false;  // No path found
+}
+
+// ========== A* PATHFINDING ==========
+
+PackedInt32Array PathfindingOps::astar_grid(const PackedFloat32Array& costs, int width, int height,
+                                            const Vector2i& start, const Vector2i& goal,
+                                            bool allow_diagonal,
+                                            const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.astar_grid", static_cast<int64_t>(width) * height);
+    return astar_grid_weighted(costs, width, height, start, goal, allow_diagonal, 1.0f, context);
+}
+
+// Helper: A* on a cost grid with start/goal validation.
+// Returns true if a path was found; it is left in search.
+static bool astar_cost_grid(GridSearch& search, const float* cost_ptr, int width, int height,
+                            const Vector2i& start, const Vector2i& goal,
+                            bool allow_diagonal, float heuristic_weight) {
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return false;
+    if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return false;
+
+    int start_idx = start.y * width + start.x;
+    int goal_idx = goal.y * width + goal.x;
+
+    // Check if start or goal is blocked
+    if (cost_ptr[start_idx] <= 0 || cost_ptr[goal_idx] <= 0) return false;
+
+    auto cell_cost = [cost_ptr](int i) { return cost_ptr[i]; };
+    return astar_search(search, cell_cost, width, height, start_idx, goal, allow_diagonal, heuristic_weight);
+}
+
+PackedInt32Array PathfindingOps::astar_grid_weighted(const PackedFloat32Array& costs, int width, int height,
+                                                     const Vector2i& start, const Vector2i& goal,
+                                                     bool allow_diagonal, float heuristic_weight,
+                                                     const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.astar_grid_weighted", static_cast<int64_t>(width) * height);
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
+
+    if (!astar_cost_grid(search, costs.ptr(), width, height, start, goal, allow_diagonal, heuristic_weight)) {
+        return PackedInt32Array();
+    }
+    return reconstruct_path(search, start.y * width + start.x, goal.y * width + goal.x);
 }
 
 PackedInt32Array PathfindingOps::astar_uniform(const PackedInt32Array& walkable, int width, int height,
                                                const Vector2i& start, const Vector2i& goal,
-                                               bool allow_diagonal) {
-    // Convert walkable to costs (1.0 for walkable, 0.0 for blocked)
-    PackedFloat32Array costs;
-    costs.resize(walkable.size());
+                                               bool allow_diagonal,
+                                               const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.astar_uniform", static_cast<int64_t>(width) * height);
+    PackedInt32Array empty_result;
+
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return empty_result;
+    if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return empty_result;
+
+    int start_idx = start.y * width + start.x;
+    int goal_idx = goal.y * width + goal.x;
+
     const int32_t* walk_ptr = walkable.ptr();
-    float* cost_ptr = costs.ptrw();
 
-    for (int i = 0; i < walkable.size(); i++) {
-        cost_ptr[i] = walk_ptr[i] != 0 ? 1.0f : 0.0f;
-    }
+    if (walk_ptr[start_idx] == 0 || walk_ptr[goal_idx] == 0) return empty_result;
+
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
 
-    return astar_grid(costs, width, height, start, goal, allow_diagonal);
+    // Walkable cells cost 1, blocked cells 0
+    auto cell_cost = [walk_ptr](int i) { return walk_ptr[i] != 0 ? 1.0f : 0.0f; };
+    if (!astar_search(search, cell_cost, width, height, start_idx, goal, allow_diagonal, 1.0f)) {
+        return empty_result;
+    }
+    return reconstruct_path(search, start_idx, goal_idx);
 }
 
 // ========== DIJKSTRA ==========
 
 PackedInt32Array PathfindingOps::dijkstra_grid(const PackedFloat32Array& costs, int width, int height,
-                                               const Vector2i& start, const PackedVector2Array& goals) {
+                                               const Vector2i& start, const PackedVector2Array& goals,
+                                               const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.dijkstra_grid", static_cast<int64_t>(width) * height);
     PackedInt32Array empty_result;
-    int size = width * height;
 
     if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return empty_result;
 
@@ -220,42 +251,39 @@ PackedInt32Array PathfindingOps::dijkstra_grid(const PackedFloat32Array& costs,
 
     if (cost_ptr[start_idx] <= 0) return empty_result;
 
-    // Build goal set
-    std::unordered_set<int> goal_set;
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
+    search.begin(width * height);
+
+    // Mark goal cells
+    bool has_goal = false;
     const Vector2* goal_ptr = goals.ptr();
     for (int i = 0; i < goals.size(); i++) {
         int gx = static_cast<int>(goal_ptr[i].x);
         int gy = static_cast<int>(goal_ptr[i].y);
         if (gx >= 0 && gx < width && gy >= 0 && gy < height) {
-            goal_set.insert(gy * width + gx);
+            search.mark(gy * width + gx);
+            has_goal = true;
         }
     }
 
-    if (goal_set.empty()) return empty_result;
-
-    std::vector<float> g_cost(size, INF);
-    std::vector<int> came_from(size, -1);
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
+    if (!has_goal) return empty_result;
 
-    g_cost[start_idx] = 0;
-    open.push({start_idx, 0});
+    search.relax(start_idx, 0, -1, 0);
 
     static const int dx[] = {0, 1, 0, -1};
     static const int dy[] = {-1, 0, 1, 0};
 
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
+    while (!search.open_empty()) {
+        float current_g;
+        int current = search.pop(current_g);
 
-        if (goal_set.count(current.index)) {
-            return reconstruct_path(came_from, start_idx, current.index);
+        if (search.is_marked(current)) {
+            return reconstruct_path(search, start_idx, current);
         }
 
-        if (current.f_cost > g_cost[current.index]) continue;
-
-        int cx = current.index % width;
-        int cy = current.index / width;
+        int cx = current % width;
+        int cy = current / width;
 
         for (int d = 0; d < 4; d++) {
             int nx = cx + dx[d];
@@ -267,12 +295,10 @@ PackedInt32Array PathfindingOps::dijkstra_grid(const PackedFloat32Array& costs,
             float cell_cost = cost_ptr[ni];
             if (cell_cost <= 0) continue;
 
-            float new_g = g_cost[current.index] + cell_cost;
+            float new_g = current_g + cell_cost;
 
-            if (new_g < g_cost[ni]) {
-                g_cost[ni] = new_g;
-                came_from[ni] = current.index;
-                open.push({ni, new_g});
+            if (new_g < search.get_cost(ni)) {
+                search.relax(ni, new_g, current, new_g);
             }
         }
     }
@@ -281,7 +307,9 @@ PackedInt32Array PathfindingOps::dijkstra_grid(const PackedFloat32Array& costs,
 }
 
 PackedFloat32Array PathfindingOps::dijkstra_map(const PackedFloat32Array& costs, int width, int height,
-                                                const PackedVector2Array& goals) {
+                                                const PackedVector2Array& goals,
+                                                const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.dijkstra_map", static_cast<int64_t>(width) * height);
     int size = width * height;
     PackedFloat32Array result;
     result.resize(size);
@@ -289,11 +317,9 @@ PackedFloat32Array PathfindingOps::dijkstra_map(const PackedFloat32Array& costs,
     float* dist_ptr = result.ptrw();
     const float* cost_ptr = costs.ptr();
 
-    for (int i = 0; i < size; i++) {
-        dist_ptr[i] = INF;
-    }
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
+    search.begin(size);
 
     // Initialize goals
     const Vector2* goal_ptr = goals.ptr();
@@ -302,9 +328,8 @@ PackedFloat32Array PathfindingOps::dijkstra_map(const PackedFloat32Array& costs,
         int gy = static_cast<int>(goal_ptr[i].y);
         if (gx >= 0 && gx < width && gy >= 0 && gy < height) {
             int gi = gy * width + gx;
-            if (cost_ptr[gi] > 0) {
-                dist_ptr[gi] = 0;
-                open.push({gi, 0});
+            if (cost_ptr[gi] > 0 && search.get_cost(gi) > 0) {
+                search.relax(gi, 0, -1, 0);
             }
         }
     }
@@ -312,14 +337,12 @@ PackedFloat32Array PathfindingOps::dijkstra_map(const PackedFloat32Array& costs,
     static const int dx[] = {0, 1, 0, -1};
     static const int dy[] = {-1, 0, 1, 0};
 
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
-
-        if (current.f_cost > dist_ptr[current.index]) continue;
+    while (!search.open_empty()) {
+        float current_dist;
+        int current = search.pop(current_dist);
 
-        int cx = current.index % width;
-        int cy = current.index / width;
+        int cx = current % width;
+        int cy = current / width;
 
         for (int d = 0; d < 4; d++) {
             int nx = cx + dx[d];
@@ -331,87 +354,101 @@ PackedFloat32Array PathfindingOps::dijkstra_map(const PackedFloat32Array& costs,
             float cell_cost = cost_ptr[ni];
             if (cell_cost <= 0) continue;
 
-            float new_dist = dist_ptr[current.index] + cell_cost;
+            float new_dist = current_dist + cell_cost;
 
-            if (new_dist < dist_ptr[ni]) {
-                dist_ptr[ni] = new_dist;
-                open.push({ni, new_dist});
+            if (new_dist < search.get_cost(ni)) {
+                search.relax(ni, new_dist, current, new_dist);
             }
         }
     }
 
+    for (int i = 0; i < size; i++) {
+        dist_ptr[i] = search.get_cost(i);
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(float));
     return result;
 }
 
 PackedFloat32Array PathfindingOps::dijkstra_map_single(const PackedFloat32Array& costs, int width, int height,
-                                                       const Vector2i& goal) {
+                                                       const Vector2i& goal,
+                                                       const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.dijkstra_map_single", static_cast<int64_t>(width) * height);
     PackedVector2Array goals;
     goals.append(Vector2(goal.x, goal.y));
-    return dijkstra_map(costs, width, height, goals);
+    return dijkstra_map(costs, width, height, goals, context);
 }
 
 // ========== FLOW FIELDS ==========
 
 PackedVector2Array PathfindingOps::flow_field(const PackedFloat32Array& costs, int width, int height,
-                                              const Vector2i& goal) {
-    PackedFloat32Array dmap = dijkstra_map_single(costs, width, height, goal);
+                                              const Vector2i& goal,
+                                              const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.flow_field", static_cast<int64_t>(width) * height);
+    PackedFloat32Array dmap = dijkstra_map_single(costs, width, height, goal, context);
     return flow_field_from_dijkstra(dmap, width, height);
 }
 
 PackedVector2Array PathfindingOps::flow_field_multi(const PackedFloat32Array& costs, int width, int height,
-                                                    const PackedVector2Array& goals) {
-    PackedFloat32Array dmap = dijkstra_map(costs, width, height, goals);
+                                                    const PackedVector2Array& goals,
+                                                    const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.flow_field_multi", static_cast<int64_t>(width) * height);
+    PackedFloat32Array dmap = dijkstra_map(costs, width, height, goals, context);
     return flow_field_from_dijkstra(dmap, width, height);
 }
 
-PackedVector2Array PathfindingOps::flow_field_from_dijkstra(const PackedFloat32Array& dijkstra_map,
-                                                            int width, int height) {
-    int size = width * height;
-    PackedVector2Array result;
-    result.resize(size);
-
-    const float* dist_ptr = dijkstra_map.ptr();
-    Vector2* flow_ptr = result.ptrw();
+Vector2 PathfindingOps::flow_direction(const float* dist_ptr, int width, int height, int index) {
+    if (dist_ptr[index] >= INF) {
+        return Vector2(0, 0);
+    }
 
     static const int dx[] = {0, 1, 1, 1, 0, -1, -1, -1};
     static const int dy[] = {-1, -1, 0, 1, 1, 1, 0, -1};
 
-    for (int i = 0; i < size; i++) {
-        if (dist_ptr[i] >= INF) {
-            flow_ptr[i] = Vector2(0, 0);
-            continue;
-        }
-
-        int x = i % width;
-        int y = i / width;
+    int x = index % width;
+    int y = index / width;
 
-        float best_dist = dist_ptr[i];
-        int best_dx = 0;
-        int best_dy = 0;
+    float best_dist = dist_ptr[index];
+    int best_dx = 0;
+    int best_dy = 0;
 
-        for (int d = 0; d < 8; d++) {
-            int nx = x + dx[d];
-            int ny = y + dy[d];
+    for (int d = 0; d < 8; d++) {
+        int nx = x + dx[d];
+        int ny = y + dy[d];
 
-            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
 
-            int ni = ny * width + nx;
-            if (dist_ptr[ni] < best_dist) {
-                best_dist = dist_ptr[ni];
-                best_dx = dx[d];
-                best_dy = dy[d];
-            }
+        int ni = ny * width + nx;
+        if (dist_ptr[ni] < best_dist) {
+            best_dist = dist_ptr[ni];
+            best_dx = dx[d];
+            best_dy = dy[d];
         }
+    }
 
-        // Normalize
-        if (best_dx != 0 || best_dy != 0) {
-            float len = std::sqrt(static_cast<float>(best_dx * best_dx + best_dy * best_dy));
-            flow_ptr[i] = Vector2(best_dx / len, best_dy / len);
-        } else {
-            flow_ptr[i] = Vector2(0, 0);
-        }
+    // Normalize
+    if (best_dx != 0 || best_dy != 0) {
+        float len = std::sqrt(static_cast<float>(best_dx * best_dx + best_dy * best_dy));
+        return Vector2(best_dx / len, best_dy / len);
     }
+    return Vector2(0, 0);
+}
 
+PackedVector2Array PathfindingOps::flow_field_from_dijkstra(const PackedFloat32Array& dijkstra_map,
+                                                            int width, int height) {
+    AGENTITE_PROFILE("PathfindingOps.flow_field_from_dijkstra", static_cast<int64_t>(width) * height);
+    int size = width * height;
+    PackedVector2Array result;
+    result.resize(size);
+
+    const float* dist_ptr = dijkstra_map.ptr();
+    Vector2* flow_ptr = result.ptrw();
+
+    for (int i = 0; i < size; i++) {
+        flow_ptr[i] = flow_direction(dist_ptr, width, height, i);
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(Vector2));
     return result;
 }
 
@@ -466,9 +503,10 @@ namespace jps_internal {
 }
 
 PackedInt32Array PathfindingOps::jps_grid(const PackedInt32Array& walkable, int width, int height,
-                                          const Vector2i& start, const Vector2i& goal) {
+                                          const Vector2i& start, const Vector2i& goal,
+                                          const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.jps_grid", static_cast<int64_t>(width) * height);
     PackedInt32Array empty_result;
-    int size = width * height;
 
     if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return empty_result;
     if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return empty_result;
@@ -480,35 +518,30 @@ PackedInt32Array PathfindingOps::jps_grid(const PackedInt32Array& walkable, int
 
     if (walk_ptr[start_idx] == 0 || walk_ptr[goal_idx] == 0) return empty_result;
 
-    std::vector<float> g_cost(size, INF);
-    std::vector<int> came_from(size, -1);
-    std::vector<bool> closed(size, false);
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
+    search.begin(width * height);
 
-    g_cost[start_idx] = 0;
-    open.push({start_idx, heuristic(start.x, start.y, goal.x, goal.y, true)});
+    search.relax(start_idx, 0, -1, heuristic(start.x, start.y, goal.x, goal.y, true));
 
     // All 8 directions for initial expansion
     static const int dx8[] = {0, 1, 1, 1, 0, -1, -1, -1};
     static const int dy8[] = {-1, -1, 0, 1, 1, 1, 0, -1};
 
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
+    while (!search.open_empty()) {
+        float f;
+        int current = search.pop(f);
 
-        if (current.index == goal_idx) {
-            return reconstruct_path(came_from, start_idx, goal_idx);
+        if (current == goal_idx) {
+            return reconstruct_path(search, start_idx, goal_idx);
         }
 
-        if (closed[current.index]) continue;
-        closed[current.index] = true;
-
-        int cx = current.index % width;
-        int cy = current.index / width;
+        int cx = current % width;
+        int cy = current / width;
+        float current_g = search.get_cost(current);
 
         // Get parent direction
-        int parent = came_from[current.index];
+        int parent = search.get_parent(current);
         int pdx = 0, pdy = 0;
         if (parent != -1) {
             int px = parent % width;
@@ -519,62 +552,68 @@ PackedInt32Array PathfindingOps::jps_grid(const PackedInt32Array& walkable, int
             if (pdy != 0) pdy = pdy / std::abs(pdy);
         }
 
-        // Determine directions to search
-        std::vector<std::pair<int, int>> directions;
+        // Determine directions to search (at most 8)
+        int dir_x[8];
+        int dir_y[8];
+        int dir_count = 0;
+        auto add_direction = [&](int x, int y) {
+            dir_x[dir_count] = x;
+            dir_y[dir_count] = y;
+            dir_count++;
+        };
+
         if (parent == -1) {
             // Start node: all 8 directions
             for (int d = 0; d < 8; d++) {
-                directions.push_back({dx8[d], dy8[d]});
+                add_direction(dx8[d], dy8[d]);
             }
         } else if (pdx != 0 && pdy != 0) {
             // Diagonal movement: natural neighbors + forced
-            directions.push_back({pdx, pdy});  // Continue diagonal
-            directions.push_back({pdx, 0});    // Horizontal
-            directions.push_back({0, pdy});    // Vertical
+            add_direction(pdx, pdy);  // Continue diagonal
+            add_direction(pdx, 0);    // Horizontal
+            add_direction(0, pdy);    // Vertical
             // Forced neighbors
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx - pdx, cy)) {
-                directions.push_back({-pdx, pdy});
+                add_direction(-pdx, pdy);
             }
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx, cy - pdy)) {
-                directions.push_back({pdx, -pdy});
+                add_direction(pdx, -pdy);
             }
         } else if (pdx != 0) {
             // Horizontal movement
-            directions.push_back({pdx, 0});
+            add_direction(pdx, 0);
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx, cy - 1)) {
-                directions.push_back({pdx, -1});
+                add_direction(pdx, -1);
             }
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx, cy + 1)) {
-                directions.push_back({pdx, 1});
+                add_direction(pdx, 1);
             }
         } else if (pdy != 0) {
             // Vertical movement
-            directions.push_back({0, pdy});
+            add_direction(0, pdy);
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx - 1, cy)) {
-                directions.push_back({-1, pdy});
+                add_direction(-1, pdy);
             }
             if (!jps_internal::is_walkable(walk_ptr, width, height, cx + 1, cy)) {
-                directions.push_back({1, pdy});
+                add_direction(1, pdy);
             }
         }
 
-        for (auto& dir : directions) {
-            int jump_idx = jps_internal::jump(walk_ptr, width, height, cx, cy, dir.first, dir.second, goal.x, goal.y);
+        for (int d = 0; d < dir_count; d++) {
+            int jump_idx = jps_internal::jump(walk_ptr, width, height, cx, cy, dir_x[d], dir_y[d], goal.x, goal.y);
             if (jump_idx == -1) continue;
 
             int jx = jump_idx % width;
             int jy = jump_idx / width;
 
-            if (closed[jump_idx]) continue;
+            if (search.is_closed(jump_idx)) continue;
 
             float dist = std::sqrt(static_cast<float>((jx - cx) * (jx - cx) + (jy - cy) * (jy - cy)));
-            float new_g = g_cost[current.index] + dist;
+            float new_g = current_g + dist;
 
-            if (new_g < g_cost[jump_idx]) {
-                g_cost[jump_idx] = new_g;
-                came_from[jump_idx] = current.index;
+            if (new_g < search.get_cost(jump_idx)) {
                 float h = heuristic(jx, jy, goal.x, goal.y, true);
-                open.push({jump_idx, new_g + h});
+                search.relax(jump_idx, new_g, current, new_g + h);
             }
         }
     }
@@ -724,30 +763,101 @@ PackedInt32Array PathfindingOps::simplify_path(const PackedInt32Array& path, int
 
 // ========== BATCH PATHFINDING ==========
 
+// Helper: validate batch inputs, returning the number of pairs to search (-1 on error)
+static int batch_pair_count(const PackedFloat32Array& costs, int width, int height,
+                            const PackedVector2Array& starts, const PackedVector2Array& goals) {
+    if (width < 0 || height < 0 || costs.size() < static_cast<int64_t>(width) * height) {
+        UtilityFunctions::push_error("AgentiteG: astar_batch costs array is smaller than width * height");
+        return -1;
+    }
+    return static_cast<int>(std::min(starts.size(), goals.size()));
+}
+
 Array PathfindingOps::astar_batch(const PackedFloat32Array& costs, int width, int height,
                                   const PackedVector2Array& starts, const PackedVector2Array& goals,
-                                  bool allow_diagonal) {
+                                  bool allow_diagonal,
+                                  const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.astar_batch", starts.size());
     Array result;
-    int count = std::min(starts.size(), goals.size());
+    int count = batch_pair_count(costs, width, height, starts, goals);
+    if (count <= 0) return result;
 
+    const float* cost_ptr = costs.ptr();
     const Vector2* start_ptr = starts.ptr();
     const Vector2* goal_ptr = goals.ptr();
 
+    // Each worker leases its own search buffers; the cost grid is shared read-only
+    GridSearchPool local_pool;
+    GridSearchPool& pool = context.is_valid() ? context->get_worker_pool() : local_pool;
+
+    std::vector<PackedInt32Array> paths(count);
+    parallel::for_range(count, PATH_BATCH_CHUNK, [&](int64_t begin, int64_t end) {
+        GridSearchPool::Lease lease(pool);
+        GridSearch& search = lease.get();
+        for (int64_t i = begin; i < end; i++) {
+            Vector2i start(static_cast<int>(start_ptr[i].x), static_cast<int>(start_ptr[i].y));
+            Vector2i goal(static_cast<int>(goal_ptr[i].x), static_cast<int>(goal_ptr[i].y));
+            if (astar_cost_grid(search, cost_ptr, width, height, start, goal, allow_diagonal, 1.0f)) {
+                paths[i] = reconstruct_path(search, start.y * width + start.x, goal.y * width + goal.x);
+            }
+        }
+    });
+
+    result.resize(count);
     for (int i = 0; i < count; i++) {
-        Vector2i start(static_cast<int>(start_ptr[i].x), static_cast<int>(start_ptr[i].y));
-        Vector2i goal(static_cast<int>(goal_ptr[i].x), static_cast<int>(goal_ptr[i].y));
-        result.append(astar_grid(costs, width, height, start, goal, allow_diagonal));
+        result[i] = paths[i];
     }
 
     return result;
 }
 
+Ref<NeighborList> PathfindingOps::astar_batch_flat(const PackedFloat32Array& costs, int width, int height,
+                                                   const PackedVector2Array& starts, const PackedVector2Array& goals,
+                                                   bool allow_diagonal, const Ref<NeighborList>& out,
+                                                   const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.astar_batch_flat", starts.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    int count = batch_pair_count(costs, width, height, starts, goals);
+    if (count < 0) {
+        list->clear();
+        return list;
+    }
+
+    const float* cost_ptr = costs.ptr();
+    const Vector2* start_ptr = starts.ptr();
+    const Vector2* goal_ptr = goals.ptr();
+
+    GridSearchPool local_pool;
+    GridSearchPool& pool = context.is_valid() ? context->get_worker_pool() : local_pool;
+
+    list->fill(count, [&](int32_t i, std::vector<int32_t>& hits) {
+        GridSearchPool::Lease lease(pool);
+        GridSearch& search = lease.get();
+        Vector2i start(static_cast<int>(start_ptr[i].x), static_cast<int>(start_ptr[i].y));
+        Vector2i goal(static_cast<int>(goal_ptr[i].x), static_cast<int>(goal_ptr[i].y));
+        if (astar_cost_grid(search, cost_ptr, width, height, start, goal, allow_diagonal, 1.0f)) {
+            int start_idx = start.y * width + start.x;
+            int goal_idx = goal.y * width + goal.x;
+            size_t base = hits.size();
+            hits.resize(base + path_length(search, start_idx, goal_idx));
+            write_path(search, start_idx, goal_idx, hits.data() + base);
+        }
+    });
+
+    return list;
+}
+
 // ========== REACHABILITY ==========
 
 PackedInt32Array PathfindingOps::reachable_cells(const PackedFloat32Array& costs, int width, int height,
-                                                 const Vector2i& start, float max_cost) {
+                                                 const Vector2i& start, float max_cost,
+                                                 const Ref<PathfindingContext>& context) {
+    AGENTITE_PROFILE("PathfindingOps.reachable_cells", static_cast<int64_t>(width) * height);
     PackedInt32Array result;
-    int size = width * height;
 
     if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return result;
 
@@ -756,25 +866,23 @@ PackedInt32Array PathfindingOps::reachable_cells(const PackedFloat32Array& costs
 
     if (cost_ptr[start_idx] <= 0) return result;
 
-    std::vector<float> g_cost(size, INF);
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
+    search.begin(width * height);
 
-    g_cost[start_idx] = 0;
-    open.push({start_idx, 0});
+    search.relax(start_idx, 0, -1, 0);
 
     static const int dx[] = {0, 1, 0, -1};
     static const int dy[] = {-1, 0, 1, 0};
 
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
+    while (!search.open_empty()) {
+        float current_g;
+        int current = search.pop(current_g);
 
-        if (current.f_cost > g_cost[current.index]) continue;
+        result.append(current);
 
-        result.append(current.index);
-
-        int cx = current.index % width;
-        int cy = current.index / width;
+        int cx = current % width;
+        int cy = current / width;
 
         for (int d = 0; d < 4; d++) {
             int nx = cx + dx[d];
@@ -786,95 +894,35 @@ PackedInt32Array PathfindingOps::reachable_cells(const PackedFloat32Array& costs
             float cell_cost = cost_ptr[ni];
             if (cell_cost <= 0) continue;
 
-            float new_g = g_cost[current.index] + cell_cost;
+            float new_g = current_g + cell_cost;
             if (new_g > max_cost) continue;
 
-            if (new_g < g_cost[ni]) {
-                g_cost[ni] = new_g;
-                open.push({ni, new_g});
+            if (new_g < search.get_cost(ni)) {
+                search.relax(ni, new_g, current, new_g);
             }
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 bool PathfindingOps::is_reachable(const PackedFloat32Array& costs, int width, int height,
-                                  const Vector2i& start, const Vector2i& goal) {
-    PackedInt32Array path = astar_grid(costs, width, height, start, goal, true);
-    return path.size() > 0;
+                                  const Vector2i& start, const Vector2i& goal,
+                                  const Ref<PathfindingContext>& context) {
+    return path_cost(costs, width, height, start, goal, true, context) < INF;
 }
 
 float PathfindingOps::path_cost(const PackedFloat32Array& costs, int width, int height,
-                                const Vector2i& start, const Vector2i& goal, bool allow_diagonal) {
-    int size = width * height;
-
-    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height) return INF;
-    if (goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height) return INF;
-
-    int start_idx = start.y * width + start.x;
-    int goal_idx = goal.y * width + goal.x;
-
-    const float* cost_ptr = costs.ptr();
-
-    if (cost_ptr[start_idx] <= 0 || cost_ptr[goal_idx] <= 0) return INF;
-
-    std::vector<float> g_cost(size, INF);
-    std::vector<bool> closed(size, false);
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> open;
-
-    g_cost[start_idx] = 0;
-    open.push({start_idx, heuristic(start.x, start.y, goal.x, goal.y, allow_diagonal)});
-
-    static const int dx4[] = {0, 1, 0, -1};
-    static const int dy4[] = {-1, 0, 1, 0};
-    static const int dx8[] = {0, 1, 1, 1, 0, -1, -1, -1};
-    static const int dy8[] = {-1, -1, 0, 1, 1, 1, 0, -1};
-    static const float cost8[] = {1, SQRT2, 1, SQRT2, 1, SQRT2, 1, SQRT2};
-
-    const int* dx = allow_diagonal ? dx8 : dx4;
-    const int* dy = allow_diagonal ? dy8 : dy4;
-    int dir_count = allow_diagonal ? 8 : 4;
-
-    while (!open.empty()) {
-        PathNode current = open.top();
-        open.pop();
-
-        if (current.index == goal_idx) {
-            return g_cost[goal_idx];
-        }
-
-        if (closed[current.index]) continue;
-        closed[current.index] = true;
+                                const Vector2i& start, const Vector2i& goal, bool allow_diagonal,
+                                const Ref<PathfindingContext>& context) {
+    GridSearch local_search;
+    GridSearch& search = context.is_valid() ? context->get_search() : local_search;
 
-        int cx = current.index % width;
-        int cy = current.index / width;
-
-        for (int d = 0; d < dir_count; d++) {
-            int nx = cx + dx[d];
-            int ny = cy + dy[d];
-
-            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
-
-            int ni = ny * width + nx;
-            if (closed[ni]) continue;
-
-            float cell_cost = cost_ptr[ni];
-            if (cell_cost <= 0) continue;
-
-            float move_cost = allow_diagonal ? cost8[d] : 1.0f;
-            float new_g = g_cost[current.index] + move_cost * cell_cost;
-
-            if (new_g < g_cost[ni]) {
-                g_cost[ni] = new_g;
-                float h = heuristic(nx, ny, goal.x, goal.y, allow_diagonal);
-                open.push({ni, new_g + h});
-            }
-        }
+    if (!astar_cost_grid(search, costs.ptr(), width, height, start, goal, allow_diagonal, 1.0f)) {
+        return INF;
     }
-
-    return INF;
+    return search.get_cost(goal.y * width + goal.x);
 }
 
 }
@@ -14,11 +14,17 @@
  *
  *   # Flow field for many units
  *   var flow = PathfindingOps.flow_field(costs, width, height, goal)
+ *
+ * Searches take an optional PathfindingContext as their last argument.
+ * Reusing one context across calls avoids reallocating the per-cell buffers.
  */
 
 #ifndef AGENTITE_PATHFINDING_OPS_HPP
 #define AGENTITE_PATHFINDING_OPS_HPP
 
+#include "pathfinding_context.hpp"
+#include "spatial/neighbor_list.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
@@ -41,51 +47,63 @@ public:
     // Costs array: positive = traversable (movement cost), 0 or negative = blocked
     static PackedInt32Array astar_grid(const PackedFloat32Array& costs, int width, int height,
                                        const Vector2i& start, const Vector2i& goal,
-                                       bool allow_diagonal);
+                                       bool allow_diagonal,
+                                       const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // A* with weighted heuristic (weight > 1 = faster but less optimal)
     static PackedInt32Array astar_grid_weighted(const PackedFloat32Array& costs, int width, int height,
                                                 const Vector2i& start, const Vector2i& goal,
-                                                bool allow_diagonal, float heuristic_weight);
+                                                bool allow_diagonal, float heuristic_weight,
+                                                const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // A* with uniform cost (all walkable cells cost 1)
     // walkable array: non-zero = walkable, 0 = blocked
     static PackedInt32Array astar_uniform(const PackedInt32Array& walkable, int width, int height,
                                           const Vector2i& start, const Vector2i& goal,
-                                          bool allow_diagonal);
+                                          bool allow_diagonal,
+                                          const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // ========== DIJKSTRA ==========
     // Dijkstra from start to nearest goal. Returns path to nearest goal.
     static PackedInt32Array dijkstra_grid(const PackedFloat32Array& costs, int width, int height,
-                                          const Vector2i& start, const PackedVector2Array& goals);
+                                          const Vector2i& start, const PackedVector2Array& goals,
+                                          const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Dijkstra map: distance from every cell to nearest goal
     // Returns distance array (same size as costs). INF for unreachable cells.
     static PackedFloat32Array dijkstra_map(const PackedFloat32Array& costs, int width, int height,
-                                           const PackedVector2Array& goals);
+                                           const PackedVector2Array& goals,
+                                           const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Dijkstra map from single goal
     static PackedFloat32Array dijkstra_map_single(const PackedFloat32Array& costs, int width, int height,
-                                                  const Vector2i& goal);
+                                                  const Vector2i& goal,
+                                                  const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // ========== FLOW FIELDS ==========
     // Flow field: normalized direction at each cell toward goal
     static PackedVector2Array flow_field(const PackedFloat32Array& costs, int width, int height,
-                                         const Vector2i& goal);
+                                         const Vector2i& goal,
+                                         const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Flow field toward multiple goals
     static PackedVector2Array flow_field_multi(const PackedFloat32Array& costs, int width, int height,
-                                               const PackedVector2Array& goals);
+                                               const PackedVector2Array& goals,
+                                               const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Flow field from pre-computed Dijkstra map
     static PackedVector2Array flow_field_from_dijkstra(const PackedFloat32Array& dijkstra_map,
                                                        int width, int height);
 
+    // C++ API: flow direction of one cell of a Dijkstra map (as in flow_field_from_dijkstra)
+    static Vector2 flow_direction(const float* dist_ptr, int width, int height, int index);
+
     // ========== JUMP POINT SEARCH ==========
     // JPS: faster A* for uniform-cost grids
     // walkable array: non-zero = walkable, 0 = blocked
     static PackedInt32Array jps_grid(const PackedInt32Array& walkable, int width, int height,
-                                     const Vector2i& start, const Vector2i& goal);
+                                     const Vector2i& start, const Vector2i& goal,
+                                     const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // ========== PATH UTILITIES ==========
     // Smooth path using string-pulling
@@ -103,23 +121,35 @@ public:
 
     // ========== BATCH PATHFINDING ==========
     // Find paths for multiple start/goal pairs
-    // Returns Array of PackedInt32Array paths
+    // Returns Array of PackedInt32Array paths, in the order of starts/goals
+    // Searches run across worker threads, each with its own search buffers
     static Array astar_batch(const PackedFloat32Array& costs, int width, int height,
                              const PackedVector2Array& starts, const PackedVector2Array& goals,
-                             bool allow_diagonal);
+                             bool allow_diagonal,
+                             const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
+
+    // Flat variant: path i is row i of the NeighborList (empty if no path)
+    static Ref<NeighborList> astar_batch_flat(const PackedFloat32Array& costs, int width, int height,
+                                              const PackedVector2Array& starts, const PackedVector2Array& goals,
+                                              bool allow_diagonal,
+                                              const Ref<NeighborList>& out = Ref<NeighborList>(),
+                                              const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // ========== REACHABILITY ==========
     // Get all reachable cells from start within max_cost
     static PackedInt32Array reachable_cells(const PackedFloat32Array& costs, int width, int height,
-                                            const Vector2i& start, float max_cost);
+                                            const Vector2i& start, float max_cost,
+                                            const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Check if goal is reachable from start
     static bool is_reachable(const PackedFloat32Array& costs, int width, int height,
-                             const Vector2i& start, const Vector2i& goal);
+                             const Vector2i& start, const Vector2i& goal,
+                             const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 
     // Get cost to travel from start to goal (returns INF if unreachable)
     static float path_cost(const PackedFloat32Array& costs, int width, int height,
-                           const Vector2i& start, const Vector2i& goal, bool allow_diagonal);
+                           const Vector2i& start, const Vector2i& goal, bool allow_diagonal,
+                           const Ref<PathfindingContext>& context = Ref<PathfindingContext>());
 };
 
 }
@@ -0,0 +1,391 @@
+/**
+ * ParallelRandom Implementation
+ *
+ * Every element is computed from its absolute index alone, so chunks can be
+ * handed to any thread. Floats and integers pack four elements into one
+ * Philox block, normals and 2D points two; rejected samples retry on their
+ * own sub-blocks. Other elements get one CounterStream each.
+ */
+
+#include "parallel_random.hpp"
+#include "core/parallel.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+#include <cmath>
+
+namespace godot {
+
+// Minimum elements per chunk for threaded fills
+static const int64_t RANDOM_CHUNK = 4096;
+
+void ParallelRandom::_bind_methods() {
+    // Settings
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &ParallelRandom::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &ParallelRandom::get_seed);
+    ClassDB::bind_method(D_METHOD("set_stream", "stream"), &ParallelRandom::set_stream);
+    ClassDB::bind_method(D_METHOD("get_stream"), &ParallelRandom::get_stream);
+    ClassDB::bind_method(D_METHOD("set_position", "position"), &ParallelRandom::set_position);
+    ClassDB::bind_method(D_METHOD("get_position"), &ParallelRandom::get_position);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &ParallelRandom::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &ParallelRandom::get_threaded);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "stream"), "set_stream", "get_stream");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "position"), "set_position", "get_position");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+
+    // Bulk generation
+    ClassDB::bind_method(D_METHOD("randf_array", "count"), &ParallelRandom::randf_array);
+    ClassDB::bind_method(D_METHOD("randf_range_array", "count", "min_val", "max_val"), &ParallelRandom::randf_range_array);
+    ClassDB::bind_method(D_METHOD("randi_array", "count"), &ParallelRandom::randi_array);
+    ClassDB::bind_method(D_METHOD("randi_range_array", "count", "min_val", "max_val"), &ParallelRandom::randi_range_array);
+    ClassDB::bind_method(D_METHOD("randn_array", "count"), &ParallelRandom::randn_array);
+    ClassDB::bind_method(D_METHOD("randn_array_params", "count", "mean", "std_dev"), &ParallelRandom::randn_array_params);
+
+    ClassDB::bind_method(D_METHOD("rand_points_in_rect", "count", "rect"), &ParallelRandom::rand_points_in_rect);
+    ClassDB::bind_method(D_METHOD("rand_points_in_box", "count", "box"), &ParallelRandom::rand_points_in_box);
+    ClassDB::bind_method(D_METHOD("rand_points_in_circle", "count", "center", "radius"), &ParallelRandom::rand_points_in_circle);
+    ClassDB::bind_method(D_METHOD("rand_points_in_sphere", "count", "center", "radius"), &ParallelRandom::rand_points_in_sphere);
+    ClassDB::bind_method(D_METHOD("rand_directions_2d", "count"), &ParallelRandom::rand_directions_2d);
+    ClassDB::bind_method(D_METHOD("rand_directions_3d", "count"), &ParallelRandom::rand_directions_3d);
+}
+
+ParallelRandom::ParallelRandom() {
+}
+
+ParallelRandom::~ParallelRandom() {
+}
+
+template <typename Body>
+void ParallelRandom::fill(int64_t count, Body&& body) {
+    if (threaded) {
+        parallel::for_range(count, RANDOM_CHUNK, body);
+    } else {
+        body(0, count);
+    }
+    position += count;
+}
+
+// Call emit(i, word) for elements [begin, end), element i taking word
+// (first + i) % 4 of block (first + i) / 4
+template <typename Emit>
+static void packed_words(const rng::Key& key, rng::Kind kind, uint64_t first, int64_t begin, int64_t end, Emit&& emit) {
+    int64_t i = begin;
+    while (i < end) {
+        uint64_t index = first + static_cast<uint64_t>(i);
+        rng::Block block = key.block(kind, index >> 2);
+        for (uint32_t w = static_cast<uint32_t>(index & 3); w < 4 && i < end; w++, i++) {
+            emit(i, block.w[w]);
+        }
+    }
+}
+
+// Call emit(i, bits) for elements [begin, end), element i taking 64 bits,
+// half (first + i) % 2 of block (first + i) / 2
+template <typename Emit>
+static void packed_pairs(const rng::Key& key, rng::Kind kind, uint64_t first, int64_t begin, int64_t end, Emit&& emit) {
+    int64_t i = begin;
+    while (i < end) {
+        uint64_t index = first + static_cast<uint64_t>(i);
+        rng::Block block = key.block(kind, index >> 1);
+        for (uint32_t h = static_cast<uint32_t>(index & 1); h < 2 && i < end; h++, i++) {
+            emit(i, (static_cast<uint64_t>(block.w[2 * h]) << 32) | block.w[2 * h + 1]);
+        }
+    }
+}
+
+// Call emit(i, stream) for elements [begin, end), element i drawing from
+// its own CounterStream
+template <typename Emit>
+static void element_streams(const rng::Key& key, rng::Kind kind, uint64_t first, int64_t begin, int64_t end, Emit&& emit) {
+    for (int64_t i = begin; i < end; i++) {
+        rng::CounterStream s(key, kind, first + static_cast<uint64_t>(i));
+        emit(i, s);
+    }
+}
+
+static inline float to_float(uint32_t word) {
+    return (word >> 8) * (1.0f / 16777216.0f);
+}
+
+// ========== SETTINGS ==========
+
+void ParallelRandom::set_seed(int64_t p_seed) {
+    seed_value = p_seed;
+}
+
+int64_t ParallelRandom::get_seed() const {
+    return seed_value;
+}
+
+void ParallelRandom::set_stream(int64_t p_stream) {
+    stream = p_stream;
+}
+
+int64_t ParallelRandom::get_stream() const {
+    return stream;
+}
+
+void ParallelRandom::set_position(int64_t p_position) {
+    position = p_position;
+}
+
+int64_t ParallelRandom::get_position() const {
+    return position;
+}
+
+void ParallelRandom::set_threaded(bool p_threaded) {
+    threaded = p_threaded;
+}
+
+bool ParallelRandom::get_threaded() const {
+    return threaded;
+}
+
+// ========== BULK GENERATION ==========
+
+PackedFloat32Array ParallelRandom::randf_array(int count) {
+    return randf_range_array(count, 0.0f, 1.0f);
+}
+
+PackedFloat32Array ParallelRandom::randf_range_array(int count, float min_val, float max_val) {
+    if (count <= 0) return PackedFloat32Array();
+
+    PackedFloat32Array result;
+    result.resize(count);
+    float* dst = result.ptrw();
+    float range = max_val - min_val;
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_words(key, rng::KIND_UNIFORM, first, begin, end, [&](int64_t i, uint32_t word) {
+            dst[i] = min_val + to_float(word) * range;
+        });
+    });
+
+    return result;
+}
+
+PackedInt32Array ParallelRandom::randi_array(int count) {
+    if (count <= 0) return PackedInt32Array();
+
+    PackedInt32Array result;
+    result.resize(count);
+    int32_t* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_words(key, rng::KIND_INT, first, begin, end, [&](int64_t i, uint32_t word) {
+            dst[i] = static_cast<int32_t>(word);
+        });
+    });
+
+    return result;
+}
+
+PackedInt32Array ParallelRandom::randi_range_array(int count, int min_val, int max_val) {
+    if (count <= 0 || min_val > max_val) return PackedInt32Array();
+
+    PackedInt32Array result;
+    result.resize(count);
+    int32_t* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    // Unbiased bounded integers (Lemire's multiply-shift with rejection)
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max_val) - min_val) + 1;
+    uint32_t range32 = static_cast<uint32_t>(range);
+    uint32_t threshold = range < (static_cast<uint64_t>(1) << 32) ? (0u - range32) % range32 : 0;
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_words(key, rng::KIND_RANGE, first, begin, end, [&](int64_t i, uint32_t word) {
+            uint64_t m = static_cast<uint64_t>(word) * range;
+            if (static_cast<uint32_t>(m) < threshold) {
+                rng::CounterStream retry(key, rng::KIND_RANGE, first + static_cast<uint64_t>(i), 1);
+                do {
+                    m = static_cast<uint64_t>(retry.next32()) * range;
+                } while (static_cast<uint32_t>(m) < threshold);
+            }
+            dst[i] = static_cast<int32_t>(static_cast<int64_t>(min_val) + static_cast<int64_t>(m >> 32));
+        });
+    });
+
+    return result;
+}
+
+PackedFloat32Array ParallelRandom::randn_array(int count) {
+    return randn_array_params(count, 0.0f, 1.0f);
+}
+
+PackedFloat32Array ParallelRandom::randn_array_params(int count, float mean, float std_dev) {
+    if (count <= 0) return PackedFloat32Array();
+
+    PackedFloat32Array result;
+    result.resize(count);
+    float* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_pairs(key, rng::KIND_NORMAL, first, begin, end, [&](int64_t i, uint64_t bits) {
+            // The packed bits serve the ziggurat fast path; rejected samples
+            // continue on their own stream
+            bool packed = true;
+            rng::CounterStream retry(key, rng::KIND_NORMAL, first + static_cast<uint64_t>(i), 1);
+            dst[i] = rng::normal([&]() {
+                if (packed) {
+                    packed = false;
+                    return bits;
+                }
+                return retry.next64();
+            }) * std_dev + mean;
+        });
+    });
+
+    return result;
+}
+
+PackedVector2Array ParallelRandom::rand_points_in_rect(int count, const Rect2& rect) {
+    if (count <= 0) return PackedVector2Array();
+
+    PackedVector2Array result;
+    result.resize(count);
+    Vector2* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_pairs(key, rng::KIND_RECT, first, begin, end, [&](int64_t i, uint64_t bits) {
+            float x = to_float(static_cast<uint32_t>(bits >> 32));
+            float y = to_float(static_cast<uint32_t>(bits));
+            dst[i] = Vector2(rect.position.x + x * rect.size.x, rect.position.y + y * rect.size.y);
+        });
+    });
+
+    return result;
+}
+
+PackedVector3Array ParallelRandom::rand_points_in_box(int count, const AABB& box) {
+    if (count <= 0) return PackedVector3Array();
+
+    PackedVector3Array result;
+    result.resize(count);
+    Vector3* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        element_streams(key, rng::KIND_BOX, first, begin, end, [&](int64_t i, rng::CounterStream& s) {
+            float x = s.next_float();
+            float y = s.next_float();
+            float z = s.next_float();
+            dst[i] = Vector3(box.position.x + x * box.size.x,
+                             box.position.y + y * box.size.y,
+                             box.position.z + z * box.size.z);
+        });
+    });
+
+    return result;
+}
+
+PackedVector2Array ParallelRandom::rand_points_in_circle(int count, const Vector2& center, float radius) {
+    if (count <= 0 || radius <= 0.0f) return PackedVector2Array();
+
+    PackedVector2Array result;
+    result.resize(count);
+    Vector2* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+    float r2 = radius * radius;
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_pairs(key, rng::KIND_CIRCLE, first, begin, end, [&](int64_t i, uint64_t bits) {
+            float x = (to_float(static_cast<uint32_t>(bits >> 32)) * 2.0f - 1.0f) * radius;
+            float y = (to_float(static_cast<uint32_t>(bits)) * 2.0f - 1.0f) * radius;
+            if (x * x + y * y > r2) {
+                rng::CounterStream retry(key, rng::KIND_CIRCLE, first + static_cast<uint64_t>(i), 1);
+                do {
+                    x = (retry.next_float() * 2.0f - 1.0f) * radius;
+                    y = (retry.next_float() * 2.0f - 1.0f) * radius;
+                } while (x * x + y * y > r2);
+            }
+            dst[i] = Vector2(center.x + x, center.y + y);
+        });
+    });
+
+    return result;
+}
+
+PackedVector3Array ParallelRandom::rand_points_in_sphere(int count, const Vector3& center, float radius) {
+    if (count <= 0 || radius <= 0.0f) return PackedVector3Array();
+
+    PackedVector3Array result;
+    result.resize(count);
+    Vector3* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+    float r2 = radius * radius;
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        element_streams(key, rng::KIND_SPHERE, first, begin, end, [&](int64_t i, rng::CounterStream& s) {
+            float x, y, z;
+            do {
+                x = (s.next_float() * 2.0f - 1.0f) * radius;
+                y = (s.next_float() * 2.0f - 1.0f) * radius;
+                z = (s.next_float() * 2.0f - 1.0f) * radius;
+            } while (x * x + y * y + z * z > r2);
+            dst[i] = Vector3(center.x + x, center.y + y, center.z + z);
+        });
+    });
+
+    return result;
+}
+
+PackedVector2Array ParallelRandom::rand_directions_2d(int count) {
+    if (count <= 0) return PackedVector2Array();
+
+    PackedVector2Array result;
+    result.resize(count);
+    Vector2* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    const float TWO_PI = 6.283185307179586f;
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        packed_words(key, rng::KIND_DIRECTION_2D, first, begin, end, [&](int64_t i, uint32_t word) {
+            float angle = to_float(word) * TWO_PI;
+            dst[i] = Vector2(std::cos(angle), std::sin(angle));
+        });
+    });
+
+    return result;
+}
+
+PackedVector3Array ParallelRandom::rand_directions_3d(int count) {
+    if (count <= 0) return PackedVector3Array();
+
+    PackedVector3Array result;
+    result.resize(count);
+    Vector3* dst = result.ptrw();
+    rng::Key key(seed_value, stream);
+    uint64_t first = static_cast<uint64_t>(position);
+
+    const float TWO_PI = 6.283185307179586f;
+
+    fill(count, [&](int64_t begin, int64_t end) {
+        element_streams(key, rng::KIND_DIRECTION_3D, first, begin, end, [&](int64_t i, rng::CounterStream& s) {
+            float theta = TWO_PI * s.next_float();
+            float phi = std::acos(2.0f * s.next_float() - 1.0f);
+            float sin_phi = std::sin(phi);
+            dst[i] = Vector3(sin_phi * std::cos(theta), sin_phi * std::sin(theta), std::cos(phi));
+        });
+    });
+
+    return result;
+}
+
+}
@@ -0,0 +1,200 @@
+/**
+ * RandomCore - Generators shared by RandomOps and ParallelRandom
+ *
+ * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+ * is a counter-based generator: a keyed bijection that maps a 128-bit counter
+ * to 128 random bits. With no state to advance, value i of a sequence is
+ * computed directly from i, so any range of a sequence can be generated on
+ * any thread, in any order, with the same result.
+ *
+ * The normal sampler is the Marsaglia-Tsang ziggurat with 128 layers. About
+ * 99% of samples take one 64-bit draw, one table lookup and one compare,
+ * with no log, sqrt or trig call.
+ *
+ * Usage (internal):
+ *   rng::Key key(seed, stream);
+ *   rng::CounterStream s(key, rng::KIND_NORMAL, index);
+ *   float n = rng::normal([&]() { return s.next64(); });
+ */
+
+#ifndef AGENTITE_RANDOM_CORE_HPP
+#define AGENTITE_RANDOM_CORE_HPP
+
+#include <cmath>
+#include <cstdint>
+
+namespace godot {
+namespace rng {
+
+// ========== PHILOX 4x32-10 ==========
+
+struct Block {
+    uint32_t w[4];
+};
+
+inline Block philox4x32(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1) {
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+        uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return Block{{c0, c1, c2, c3}};
+}
+
+// Counter layout: (block index low, block index high, kind << 24 | sub-block, stream)
+// Each kind of value draws from its own counter space, so values of
+// different kinds never share random bits, whatever their positions.
+// Sub-block 0 holds the packed first draws; an element that is rejected
+// continues with its own sub-blocks 1, 2, ... (a CounterStream).
+enum Kind : uint32_t {
+    // Packed four elements per block (one 32-bit word each)
+    KIND_UNIFORM = 1,
+    KIND_INT,
+    KIND_RANGE,
+    KIND_DIRECTION_2D,
+    // Packed two elements per block (64 bits each)
+    KIND_NORMAL,
+    KIND_RECT,
+    KIND_CIRCLE,
+    // One block per element
+    KIND_BOX,
+    KIND_SPHERE,
+    KIND_DIRECTION_3D,
+};
+
+struct Key {
+    uint32_t k0 = 0;
+    uint32_t k1 = 0;
+    uint32_t stream = 0;
+
+    Key() {}
+    Key(int64_t seed, int64_t stream_id)
+        : k0(static_cast<uint32_t>(static_cast<uint64_t>(seed))),
+          k1(static_cast<uint32_t>(static_cast<uint64_t>(seed) >> 32)),
+          stream(static_cast<uint32_t>(static_cast<uint64_t>(stream_id))) {}
+
+    Block block(Kind kind, uint64_t index, uint32_t sub = 0) const {
+        return philox4x32(static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                          (static_cast<uint32_t>(kind) << 24) | (sub & 0xFFFFFFu), stream, k0, k1);
+    }
+};
+
+// Words for one element: block (kind, index, first_sub), then the
+// following sub-blocks when an element needs more than four words
+// (rejection sampling)
+class CounterStream {
+private:
+    const Key& key;
+    Kind kind;
+    uint64_t index;
+    uint32_t sub = 0;
+    Block current;
+    int used = 4;
+
+public:
+    CounterStream(const Key& p_key, Kind p_kind, uint64_t p_index, uint32_t p_first_sub = 0)
+        : key(p_key), kind(p_kind), index(p_index), sub(p_first_sub) {}
+
+    uint32_t next32() {
+        if (used == 4) {
+            current = key.block(kind, index, sub++);
+            used = 0;
+        }
+        return current.w[used++];
+    }
+
+    uint64_t next64() {
+        uint64_t hi = next32();
+        return (hi << 32) | next32();
+    }
+
+    // [0, 1) with 24 bits of precision, like RandomOps
+    float next_float() {
+        return (next32() >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+// ========== ZIGGURAT NORMAL ==========
+
+struct ZigguratTables {
+    uint32_t kn[128];
+    float wn[128];
+    float fn[128];
+
+    ZigguratTables() {
+        const double m1 = 2147483648.0;
+        const double vn = 9.91256303526217e-3;
+        double dn = 3.442619855899;
+        double tn = dn;
+        double q = vn / std::exp(-0.5 * dn * dn);
+
+        kn[0] = static_cast<uint32_t>((dn / q) * m1);
+        kn[1] = 0;
+        wn[0] = static_cast<float>(q / m1);
+        wn[127] = static_cast<float>(dn / m1);
+        fn[0] = 1.0f;
+        fn[127] = static_cast<float>(std::exp(-0.5 * dn * dn));
+
+        for (int i = 126; i >= 1; i--) {
+            dn = std::sqrt(-2.0 * std::log(vn / dn + std::exp(-0.5 * dn * dn)));
+            kn[i + 1] = static_cast<uint32_t>((dn / tn) * m1);
+            tn = dn;
+            fn[i] = static_cast<float>(std::exp(-0.5 * dn * dn));
+            wn[i] = static_cast<float>(dn / m1);
+        }
+    }
+};
+
+inline const ZigguratTables& ziggurat_tables() {
+    static const ZigguratTables tables;
+    return tables;
+}
+
+// Standard normal sample; next() returns 64 random bits
+// The layer comes from the low 7 bits and the value from the high 32, so
+// the two are independent.
+template <typename Next64>
+inline float normal(Next64&& next) {
+    const ZigguratTables& t = ziggurat_tables();
+    const float R = 3.442620f;
+    auto uniform = [&]() {
+        // (0, 1], safe for log
+        return static_cast<float>((next() >> 40) + 1) * (1.0f / 16777216.0f);
+    };
+
+    for (;;) {
+        uint64_t u = next();
+        int layer = static_cast<int>(u & 127);
+        int32_t hz = static_cast<int32_t>(static_cast<uint32_t>(u >> 32));
+        int64_t magnitude = hz < 0 ? -static_cast<int64_t>(hz) : hz;
+        float x = hz * t.wn[layer];
+        if (magnitude < t.kn[layer]) {
+            return x;
+        }
+        if (layer == 0) {
+            // Tail beyond R
+            float tx, ty;
+            do {
+                tx = -std::log(uniform()) * (1.0f / R);
+                ty = -std::log(uniform());
+            } while (ty + ty < tx * tx);
+            return hz > 0 ? R + tx : -R - tx;
+        }
+        // Wedge between layers
+        if (t.fn[layer] + uniform() * (t.fn[layer - 1] - t.fn[layer]) < std::exp(-0.5f * x * x)) {
+            return x;
+        }
+    }
+}
+
+}
+}
+
+#endif // AGENTITE_RANDOM_CORE_HPP
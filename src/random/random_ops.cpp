@@ -6,6 +6,7 @@
  */
 
 #include "random_ops.hpp"
+#include "random_core.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -34,6 +35,8 @@ void RandomOps::_bind_methods() {
     // Seeding
     ClassDB::bind_method(D_METHOD("seed", "seed_value"), &RandomOps::seed);
     ClassDB::bind_method(D_METHOD("seed_from_time"), &RandomOps::seed_from_time);
+    ClassDB::bind_method(D_METHOD("jump"), &RandomOps::jump);
+    ClassDB::bind_method(D_METHOD("long_jump"), &RandomOps::long_jump);
 
     // Float generation
     ClassDB::bind_method(D_METHOD("randf_array", "count"), &RandomOps::randf_array);
@@ -127,6 +130,41 @@ void RandomOps::seed_from_time() {
     seed(static_cast<int64_t>(ns));
 }
 
+// Jump polynomials from the xoshiro256** reference implementation
+static const uint64_t JUMP[4] = {
+    0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+};
+static const uint64_t LONG_JUMP[4] = {
+    0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635
+};
+
+void RandomOps::apply_jump(const uint64_t* polynomial) {
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (polynomial[i] & (static_cast<uint64_t>(1) << b)) {
+                s[0] ^= state[0];
+                s[1] ^= state[1];
+                s[2] ^= state[2];
+                s[3] ^= state[3];
+            }
+            next();
+        }
+    }
+    state[0] = s[0];
+    state[1] = s[1];
+    state[2] = s[2];
+    state[3] = s[3];
+}
+
+void RandomOps::jump() {
+    apply_jump(JUMP);
+}
+
+void RandomOps::long_jump() {
+    apply_jump(LONG_JUMP);
+}
+
 // ========== BULK FLOAT GENERATION ==========
 
 PackedFloat32Array RandomOps::randf_array(int count) {
@@ -783,32 +821,9 @@ PackedFloat32Array RandomOps::randn_array(int count) {
     result.resize(count);
     float* dst = result.ptrw();
 
-    const float TWO_PI = 6.283185307179586f;
-
-    // Box-Muller transform generates pairs
-    int pairs = count / 2;
-    for (int i = 0; i < pairs; i++) {
-        float u1 = next_float();
-        float u2 = next_float();
-
-        // Avoid log(0)
-        if (u1 < 1e-10f) u1 = 1e-10f;
-
-        float r = std::sqrt(-2.0f * std::log(u1));
-        float theta = TWO_PI * u2;
-
-        dst[i * 2] = r * std::cos(theta);
-        dst[i * 2 + 1] = r * std::sin(theta);
-    }
-
-    // Handle odd count
-    if (count % 2 == 1) {
-        float u1 = next_float();
-        float u2 = next_float();
-        if (u1 < 1e-10f) u1 = 1e-10f;
-        float r = std::sqrt(-2.0f * std::log(u1));
-        float theta = TWO_PI * u2;
-        dst[count - 1] = r * std::cos(theta);
+    auto next64 = [this]() { return next(); };
+    for (int i = 0; i < count; i++) {
+        dst[i] = rng::normal(next64);
     }
 
     return result;
@@ -2,7 +2,9 @@
  * RandomOps - High-performance random number generation
  *
  * Provides bulk random number generation optimized for game development.
- * Uses xoshiro256** for fast, high-quality randomness.
+ * Uses xoshiro256** for fast, high-quality randomness. One instance is one
+ * sequential stream; for parallel or order-independent generation use
+ * ParallelRandom, or split instances with jump() / long_jump().
  *
  * Usage:
  *   var rng = RandomOps.new()
@@ -46,6 +48,7 @@ private:
     uint64_t next();
     double next_double();  // 0.0 to 1.0
     float next_float();    // 0.0 to 1.0
+    void apply_jump(const uint64_t* polynomial);
 
 protected:
     static void _bind_methods();
@@ -59,6 +62,10 @@ public:
     void seed(int64_t seed_value);
     // Seed from current time (non-deterministic)
     void seed_from_time();
+    // Advance by 2^128 values (2^64 non-overlapping streams)
+    void jump();
+    // Advance by 2^192 values (2^64 groups of jump() streams)
+    void long_jump();
 
     // ========== BULK FLOAT GENERATION ==========
     // Generate count floats in range [0.0, 1.0)
@@ -114,7 +121,7 @@ public:
     PackedVector3Array rand_directions_3d(int count);
 
     // ========== GAUSSIAN/NORMAL DISTRIBUTION ==========
-    // Generate normally distributed values (mean=0, std=1)
+    // Generate normally distributed values (mean=0, std=1), ziggurat method
     PackedFloat32Array randn_array(int count);
     // Generate normally distributed values with custom mean and std
     PackedFloat32Array randn_array_params(int count, float mean, float std_dev);
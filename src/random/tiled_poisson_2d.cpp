@@ -0,0 +1,197 @@
+/**
+ * TiledPoisson2D Implementation
+ */
+
+#include "tiled_poisson_2d.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace godot {
+
+void TiledPoisson2D::_bind_methods() {
+    // Settings
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &TiledPoisson2D::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &TiledPoisson2D::get_seed);
+    ClassDB::bind_method(D_METHOD("set_tile_size", "tile_size"), &TiledPoisson2D::set_tile_size);
+    ClassDB::bind_method(D_METHOD("get_tile_size"), &TiledPoisson2D::get_tile_size);
+    ClassDB::bind_method(D_METHOD("set_min_distance", "min_distance"), &TiledPoisson2D::set_min_distance);
+    ClassDB::bind_method(D_METHOD("get_min_distance"), &TiledPoisson2D::get_min_distance);
+    ClassDB::bind_method(D_METHOD("set_max_distance", "max_distance"), &TiledPoisson2D::set_max_distance);
+    ClassDB::bind_method(D_METHOD("get_max_distance"), &TiledPoisson2D::get_max_distance);
+    ClassDB::bind_method(D_METHOD("set_max_attempts", "max_attempts"), &TiledPoisson2D::set_max_attempts);
+    ClassDB::bind_method(D_METHOD("get_max_attempts"), &TiledPoisson2D::get_max_attempts);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &TiledPoisson2D::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &TiledPoisson2D::get_threaded);
+    ClassDB::bind_method(D_METHOD("get_min_tile_size"), &TiledPoisson2D::get_min_tile_size);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tile_size"), "set_tile_size", "get_tile_size");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_distance"), "set_min_distance", "get_min_distance");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_distance"), "set_max_distance", "get_max_distance");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_attempts"), "set_max_attempts", "get_max_attempts");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+
+    // Density
+    ClassDB::bind_method(D_METHOD("set_density_map", "density", "size", "rect"), &TiledPoisson2D::set_density_map);
+    ClassDB::bind_method(D_METHOD("clear_density_map"), &TiledPoisson2D::clear_density_map);
+
+    // Generation
+    ClassDB::bind_method(D_METHOD("generate_chunk", "chunk"), &TiledPoisson2D::generate_chunk);
+    ClassDB::bind_method(D_METHOD("generate", "bounds"), &TiledPoisson2D::generate);
+    ClassDB::bind_method(D_METHOD("get_chunk_bounds", "chunk"), &TiledPoisson2D::get_chunk_bounds);
+    ClassDB::bind_method(D_METHOD("get_chunk_at", "position"), &TiledPoisson2D::get_chunk_at);
+}
+
+TiledPoisson2D::TiledPoisson2D() {
+}
+
+TiledPoisson2D::~TiledPoisson2D() {
+}
+
+bool TiledPoisson2D::check_settings() const {
+    if (!(core.config.min_distance > 0.0f)) {
+        return false;
+    }
+    if (!(core.config.tile_size >= get_min_tile_size())) {
+        UtilityFunctions::push_error("AgentiteG: TiledPoisson2D tile_size is below get_min_tile_size() for this spacing");
+        return false;
+    }
+    return true;
+}
+
+PackedVector2Array TiledPoisson2D::to_packed(const std::vector<TiledPoissonCore<2>::Point>& points) const {
+    PackedVector2Array result;
+    result.resize(static_cast<int64_t>(points.size()));
+    Vector2* dst = result.ptrw();
+    for (size_t i = 0; i < points.size(); i++) {
+        dst[i] = Vector2(points[i][0], points[i][1]);
+    }
+    return result;
+}
+
+// ========== SETTINGS ==========
+
+void TiledPoisson2D::set_seed(int64_t p_seed) {
+    core.config.seed = p_seed;
+}
+
+int64_t TiledPoisson2D::get_seed() const {
+    return core.config.seed;
+}
+
+void TiledPoisson2D::set_tile_size(float p_tile_size) {
+    core.config.tile_size = p_tile_size;
+}
+
+float TiledPoisson2D::get_tile_size() const {
+    return core.config.tile_size;
+}
+
+void TiledPoisson2D::set_min_distance(float p_min_distance) {
+    core.config.min_distance = p_min_distance;
+}
+
+float TiledPoisson2D::get_min_distance() const {
+    return core.config.min_distance;
+}
+
+void TiledPoisson2D::set_max_distance(float p_max_distance) {
+    core.config.max_distance = p_max_distance;
+}
+
+float TiledPoisson2D::get_max_distance() const {
+    return core.config.max_distance;
+}
+
+void TiledPoisson2D::set_max_attempts(int32_t p_max_attempts) {
+    core.config.max_attempts = std::max(p_max_attempts, 1);
+}
+
+int32_t TiledPoisson2D::get_max_attempts() const {
+    return core.config.max_attempts;
+}
+
+void TiledPoisson2D::set_threaded(bool p_threaded) {
+    core.config.threaded = p_threaded;
+}
+
+bool TiledPoisson2D::get_threaded() const {
+    return core.config.threaded;
+}
+
+float TiledPoisson2D::get_min_tile_size() const {
+    return TiledPoissonCore<2>::min_tile_size(core.max_spacing());
+}
+
+// ========== DENSITY ==========
+
+void TiledPoisson2D::set_density_map(const PackedFloat32Array& density, const Vector2i& size, const Rect2& rect) {
+    if (size.x <= 0 || size.y <= 0 || density.size() != static_cast<int64_t>(size.x) * size.y) {
+        UtilityFunctions::push_error("AgentiteG: set_density_map needs size.x * size.y values");
+        return;
+    }
+    if (!(rect.size.x > 0.0f && rect.size.y > 0.0f)) {
+        UtilityFunctions::push_error("AgentiteG: set_density_map needs a rect with positive size");
+        return;
+    }
+    core.density.assign(density.ptr(), density.ptr() + density.size());
+    core.density_size = {size.x, size.y};
+    core.density_origin = {rect.position.x, rect.position.y};
+    core.density_extent = {rect.size.x, rect.size.y};
+}
+
+void TiledPoisson2D::clear_density_map() {
+    core.density.clear();
+}
+
+// ========== GENERATION ==========
+
+PackedVector2Array TiledPoisson2D::generate_chunk(const Vector2i& chunk) const {
+    if (!check_settings()) {
+        return PackedVector2Array();
+    }
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<TiledPoissonCore<2>::Point> points;
+    core.generate({{chunk.x, chunk.y}}, {-inf, -inf}, {inf, inf}, points);
+    return to_packed(points);
+}
+
+PackedVector2Array TiledPoisson2D::generate(const Rect2& bounds) const {
+    if (!check_settings() || !(bounds.size.x > 0.0f && bounds.size.y > 0.0f)) {
+        return PackedVector2Array();
+    }
+    float size = core.config.tile_size;
+    Vector2 end = bounds.position + bounds.size;
+    int32_t first_x = static_cast<int32_t>(std::floor(bounds.position.x / size));
+    int32_t first_y = static_cast<int32_t>(std::floor(bounds.position.y / size));
+    int32_t last_x = static_cast<int32_t>(std::ceil(end.x / size)) - 1;
+    int32_t last_y = static_cast<int32_t>(std::ceil(end.y / size)) - 1;
+
+    std::vector<TiledPoissonCore<2>::Coord> tiles;
+    for (int32_t y = first_y; y <= last_y; y++) {
+        for (int32_t x = first_x; x <= last_x; x++) {
+            tiles.push_back({x, y});
+        }
+    }
+    std::vector<TiledPoissonCore<2>::Point> points;
+    core.generate(tiles, {bounds.position.x, bounds.position.y}, {end.x, end.y}, points);
+    return to_packed(points);
+}
+
+Rect2 TiledPoisson2D::get_chunk_bounds(const Vector2i& chunk) const {
+    float size = core.config.tile_size;
+    return Rect2(chunk.x * size, chunk.y * size, size, size);
+}
+
+Vector2i TiledPoisson2D::get_chunk_at(const Vector2& position) const {
+    float size = core.config.tile_size;
+    return Vector2i(static_cast<int32_t>(std::floor(position.x / size)),
+                    static_cast<int32_t>(std::floor(position.y / size)));
+}
+
+}
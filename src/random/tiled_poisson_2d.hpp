@@ -0,0 +1,98 @@
+/**
+ * TiledPoisson2D - Deterministic, tiled and parallel Poisson disk sampling
+ *
+ * RandomOps.poisson_disk_2d runs one serial Bridson pass with one grid over
+ * the whole bounds. TiledPoisson2D splits the plane into tiles of tile_size
+ * and generates them in parallel, with each tile's samples depending only on
+ * (seed, tile coordinate). A tile can be generated on its own when a
+ * streaming chunk loads, and it matches its neighbors: the minimum distance
+ * holds across tile borders, and a tile generated alone is identical to the
+ * same tile inside a larger region.
+ *
+ * An optional density map varies the spacing between min_distance
+ * (density 1) and max_distance (density 0); density <= 0 leaves an area
+ * empty.
+ *
+ * Usage:
+ *   var foliage = TiledPoisson2D.new()
+ *   foliage.seed = world_seed
+ *   foliage.tile_size = 256.0
+ *   foliage.min_distance = 6.0
+ *   foliage.max_distance = 24.0
+ *   foliage.set_density_map(forest_density, Vector2i(512, 512), world_rect)
+ *
+ *   var points = foliage.generate_chunk(Vector2i(12, 7))   # On chunk load
+ *   var region = foliage.generate(Rect2(0, 0, 8192, 8192)) # Whole world
+ */
+
+#ifndef AGENTITE_TILED_POISSON_2D_HPP
+#define AGENTITE_TILED_POISSON_2D_HPP
+
+#include "tiled_poisson_core.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class TiledPoisson2D : public RefCounted {
+    GDCLASS(TiledPoisson2D, RefCounted)
+
+private:
+    TiledPoissonCore<2> core;
+
+    // Report settings that cannot produce samples
+    bool check_settings() const;
+    PackedVector2Array to_packed(const std::vector<TiledPoissonCore<2>::Point>& points) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    TiledPoisson2D();
+    ~TiledPoisson2D();
+
+    // ========== SETTINGS ==========
+
+    void set_seed(int64_t p_seed);
+    int64_t get_seed() const;
+    void set_tile_size(float p_tile_size);
+    float get_tile_size() const;
+    void set_min_distance(float p_min_distance);
+    float get_min_distance() const;
+    void set_max_distance(float p_max_distance);  // Spacing at density 0 (<= min_distance = uniform)
+    float get_max_distance() const;
+    void set_max_attempts(int32_t p_max_attempts);
+    int32_t get_max_attempts() const;
+    void set_threaded(bool p_threaded);
+    bool get_threaded() const;
+
+    // Smallest tile_size allowed for the current spacing
+    float get_min_tile_size() const;
+
+    // ========== DENSITY ==========
+
+    // size.x * size.y values in [0, 1], row-major, covering rect
+    void set_density_map(const PackedFloat32Array& density, const Vector2i& size, const Rect2& rect);
+    void clear_density_map();
+
+    // ========== GENERATION ==========
+
+    // Samples inside one tile
+    PackedVector2Array generate_chunk(const Vector2i& chunk) const;
+    // Samples inside bounds (the union of the tiles it overlaps, clipped)
+    PackedVector2Array generate(const Rect2& bounds) const;
+
+    Rect2 get_chunk_bounds(const Vector2i& chunk) const;
+    Vector2i get_chunk_at(const Vector2& position) const;
+};
+
+}
+
+#endif // AGENTITE_TILED_POISSON_2D_HPP
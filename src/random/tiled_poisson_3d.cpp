@@ -0,0 +1,205 @@
+/**
+ * TiledPoisson3D Implementation
+ */
+
+#include "tiled_poisson_3d.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace godot {
+
+void TiledPoisson3D::_bind_methods() {
+    // Settings
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &TiledPoisson3D::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &TiledPoisson3D::get_seed);
+    ClassDB::bind_method(D_METHOD("set_tile_size", "tile_size"), &TiledPoisson3D::set_tile_size);
+    ClassDB::bind_method(D_METHOD("get_tile_size"), &TiledPoisson3D::get_tile_size);
+    ClassDB::bind_method(D_METHOD("set_min_distance", "min_distance"), &TiledPoisson3D::set_min_distance);
+    ClassDB::bind_method(D_METHOD("get_min_distance"), &TiledPoisson3D::get_min_distance);
+    ClassDB::bind_method(D_METHOD("set_max_distance", "max_distance"), &TiledPoisson3D::set_max_distance);
+    ClassDB::bind_method(D_METHOD("get_max_distance"), &TiledPoisson3D::get_max_distance);
+    ClassDB::bind_method(D_METHOD("set_max_attempts", "max_attempts"), &TiledPoisson3D::set_max_attempts);
+    ClassDB::bind_method(D_METHOD("get_max_attempts"), &TiledPoisson3D::get_max_attempts);
+    ClassDB::bind_method(D_METHOD("set_threaded", "threaded"), &TiledPoisson3D::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &TiledPoisson3D::get_threaded);
+    ClassDB::bind_method(D_METHOD("get_min_tile_size"), &TiledPoisson3D::get_min_tile_size);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tile_size"), "set_tile_size", "get_tile_size");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_distance"), "set_min_distance", "get_min_distance");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_distance"), "set_max_distance", "get_max_distance");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_attempts"), "set_max_attempts", "get_max_attempts");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+
+    // Density
+    ClassDB::bind_method(D_METHOD("set_density_map", "density", "size", "box"), &TiledPoisson3D::set_density_map);
+    ClassDB::bind_method(D_METHOD("clear_density_map"), &TiledPoisson3D::clear_density_map);
+
+    // Generation
+    ClassDB::bind_method(D_METHOD("generate_chunk", "chunk"), &TiledPoisson3D::generate_chunk);
+    ClassDB::bind_method(D_METHOD("generate", "bounds"), &TiledPoisson3D::generate);
+    ClassDB::bind_method(D_METHOD("get_chunk_bounds", "chunk"), &TiledPoisson3D::get_chunk_bounds);
+    ClassDB::bind_method(D_METHOD("get_chunk_at", "position"), &TiledPoisson3D::get_chunk_at);
+}
+
+TiledPoisson3D::TiledPoisson3D() {
+    core.config.tile_size = 64.0f;
+    core.config.min_distance = 4.0f;
+}
+
+TiledPoisson3D::~TiledPoisson3D() {
+}
+
+bool TiledPoisson3D::check_settings() const {
+    if (!(core.config.min_distance > 0.0f)) {
+        return false;
+    }
+    if (!(core.config.tile_size >= get_min_tile_size())) {
+        UtilityFunctions::push_error("AgentiteG: TiledPoisson3D tile_size is below get_min_tile_size() for this spacing");
+        return false;
+    }
+    return true;
+}
+
+PackedVector3Array TiledPoisson3D::to_packed(const std::vector<TiledPoissonCore<3>::Point>& points) const {
+    PackedVector3Array result;
+    result.resize(static_cast<int64_t>(points.size()));
+    Vector3* dst = result.ptrw();
+    for (size_t i = 0; i < points.size(); i++) {
+        dst[i] = Vector3(points[i][0], points[i][1], points[i][2]);
+    }
+    return result;
+}
+
+// ========== SETTINGS ==========
+
+void TiledPoisson3D::set_seed(int64_t p_seed) {
+    core.config.seed = p_seed;
+}
+
+int64_t TiledPoisson3D::get_seed() const {
+    return core.config.seed;
+}
+
+void TiledPoisson3D::set_tile_size(float p_tile_size) {
+    core.config.tile_size = p_tile_size;
+}
+
+float TiledPoisson3D::get_tile_size() const {
+    return core.config.tile_size;
+}
+
+void TiledPoisson3D::set_min_distance(float p_min_distance) {
+    core.config.min_distance = p_min_distance;
+}
+
+float TiledPoisson3D::get_min_distance() const {
+    return core.config.min_distance;
+}
+
+void TiledPoisson3D::set_max_distance(float p_max_distance) {
+    core.config.max_distance = p_max_distance;
+}
+
+float TiledPoisson3D::get_max_distance() const {
+    return core.config.max_distance;
+}
+
+void TiledPoisson3D::set_max_attempts(int32_t p_max_attempts) {
+    core.config.max_attempts = std::max(p_max_attempts, 1);
+}
+
+int32_t TiledPoisson3D::get_max_attempts() const {
+    return core.config.max_attempts;
+}
+
+void TiledPoisson3D::set_threaded(bool p_threaded) {
+    core.config.threaded = p_threaded;
+}
+
+bool TiledPoisson3D::get_threaded() const {
+    return core.config.threaded;
+}
+
+float TiledPoisson3D::get_min_tile_size() const {
+    return TiledPoissonCore<3>::min_tile_size(core.max_spacing());
+}
+
+// ========== DENSITY ==========
+
+void TiledPoisson3D::set_density_map(const PackedFloat32Array& density, const Vector3i& size, const AABB& box) {
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0 ||
+        density.size() != static_cast<int64_t>(size.x) * size.y * size.z) {
+        UtilityFunctions::push_error("AgentiteG: set_density_map needs size.x * size.y * size.z values");
+        return;
+    }
+    if (!(box.size.x > 0.0f && box.size.y > 0.0f && box.size.z > 0.0f)) {
+        UtilityFunctions::push_error("AgentiteG: set_density_map needs a box with positive size");
+        return;
+    }
+    core.density.assign(density.ptr(), density.ptr() + density.size());
+    core.density_size = {size.x, size.y, size.z};
+    core.density_origin = {box.position.x, box.position.y, box.position.z};
+    core.density_extent = {box.size.x, box.size.y, box.size.z};
+}
+
+void TiledPoisson3D::clear_density_map() {
+    core.density.clear();
+}
+
+// ========== GENERATION ==========
+
+PackedVector3Array TiledPoisson3D::generate_chunk(const Vector3i& chunk) const {
+    if (!check_settings()) {
+        return PackedVector3Array();
+    }
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<TiledPoissonCore<3>::Point> points;
+    core.generate({{chunk.x, chunk.y, chunk.z}}, {-inf, -inf, -inf}, {inf, inf, inf}, points);
+    return to_packed(points);
+}
+
+PackedVector3Array TiledPoisson3D::generate(const AABB& bounds) const {
+    if (!check_settings() || !(bounds.size.x > 0.0f && bounds.size.y > 0.0f && bounds.size.z > 0.0f)) {
+        return PackedVector3Array();
+    }
+    float size = core.config.tile_size;
+    Vector3 end = bounds.position + bounds.size;
+    int32_t first_x = static_cast<int32_t>(std::floor(bounds.position.x / size));
+    int32_t first_y = static_cast<int32_t>(std::floor(bounds.position.y / size));
+    int32_t first_z = static_cast<int32_t>(std::floor(bounds.position.z / size));
+    int32_t last_x = static_cast<int32_t>(std::ceil(end.x / size)) - 1;
+    int32_t last_y = static_cast<int32_t>(std::ceil(end.y / size)) - 1;
+    int32_t last_z = static_cast<int32_t>(std::ceil(end.z / size)) - 1;
+
+    std::vector<TiledPoissonCore<3>::Coord> tiles;
+    for (int32_t z = first_z; z <= last_z; z++) {
+        for (int32_t y = first_y; y <= last_y; y++) {
+            for (int32_t x = first_x; x <= last_x; x++) {
+                tiles.push_back({x, y, z});
+            }
+        }
+    }
+    std::vector<TiledPoissonCore<3>::Point> points;
+    core.generate(tiles, {bounds.position.x, bounds.position.y, bounds.position.z}, {end.x, end.y, end.z}, points);
+    return to_packed(points);
+}
+
+AABB TiledPoisson3D::get_chunk_bounds(const Vector3i& chunk) const {
+    float size = core.config.tile_size;
+    return AABB(Vector3(chunk.x * size, chunk.y * size, chunk.z * size), Vector3(size, size, size));
+}
+
+Vector3i TiledPoisson3D::get_chunk_at(const Vector3& position) const {
+    float size = core.config.tile_size;
+    return Vector3i(static_cast<int32_t>(std::floor(position.x / size)),
+                    static_cast<int32_t>(std::floor(position.y / size)),
+                    static_cast<int32_t>(std::floor(position.z / size)));
+}
+
+}
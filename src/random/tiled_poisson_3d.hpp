@@ -0,0 +1,86 @@
+/**
+ * TiledPoisson3D - Deterministic, tiled and parallel Poisson disk sampling (3D)
+ *
+ * The 3D counterpart of TiledPoisson2D: cubic tiles generated in parallel,
+ * each depending only on (seed, tile coordinate), with the minimum distance
+ * kept across tile borders and an optional 3D density map.
+ *
+ * Usage:
+ *   var asteroids = TiledPoisson3D.new()
+ *   asteroids.seed = sector_seed
+ *   asteroids.tile_size = 128.0
+ *   asteroids.min_distance = 12.0
+ *   var points = asteroids.generate_chunk(Vector3i(2, 0, -1))
+ */
+
+#ifndef AGENTITE_TILED_POISSON_3D_HPP
+#define AGENTITE_TILED_POISSON_3D_HPP
+
+#include "tiled_poisson_core.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+class TiledPoisson3D : public RefCounted {
+    GDCLASS(TiledPoisson3D, RefCounted)
+
+private:
+    TiledPoissonCore<3> core;
+
+    // Report settings that cannot produce samples
+    bool check_settings() const;
+    PackedVector3Array to_packed(const std::vector<TiledPoissonCore<3>::Point>& points) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    TiledPoisson3D();
+    ~TiledPoisson3D();
+
+    // ========== SETTINGS ==========
+
+    void set_seed(int64_t p_seed);
+    int64_t get_seed() const;
+    void set_tile_size(float p_tile_size);
+    float get_tile_size() const;
+    void set_min_distance(float p_min_distance);
+    float get_min_distance() const;
+    void set_max_distance(float p_max_distance);  // Spacing at density 0 (<= min_distance = uniform)
+    float get_max_distance() const;
+    void set_max_attempts(int32_t p_max_attempts);
+    int32_t get_max_attempts() const;
+    void set_threaded(bool p_threaded);
+    bool get_threaded() const;
+
+    // Smallest tile_size allowed for the current spacing
+    float get_min_tile_size() const;
+
+    // ========== DENSITY ==========
+
+    // size.x * size.y * size.z values in [0, 1], x fastest, covering box
+    void set_density_map(const PackedFloat32Array& density, const Vector3i& size, const AABB& box);
+    void clear_density_map();
+
+    // ========== GENERATION ==========
+
+    // Samples inside one tile
+    PackedVector3Array generate_chunk(const Vector3i& chunk) const;
+    // Samples inside bounds (the union of the tiles it overlaps, clipped)
+    PackedVector3Array generate(const AABB& bounds) const;
+
+    AABB get_chunk_bounds(const Vector3i& chunk) const;
+    Vector3i get_chunk_at(const Vector3& position) const;
+};
+
+}
+
+#endif // AGENTITE_TILED_POISSON_3D_HPP
@@ -0,0 +1,597 @@
+/**
+ * TiledPoissonCore - Deterministic, tiled Poisson disk sampling shared by
+ * TiledPoisson2D and TiledPoisson3D
+ *
+ * Space is cut into square (cubic) tiles of tile_size, and the area around
+ * the tile lattice into pieces, by how close a point is to the lattice lines:
+ *
+ *   level 0: corners    - near every lattice line (around a lattice vertex)
+ *   level 1: edges      - near D-1 lines (strips along a tile edge)
+ *   level 2: faces (3D) - near one plane
+ *   level D: interiors  - the rest of each tile
+ *
+ * The bands around the lines are sized so that two pieces on the same level
+ * are always farther apart than the largest spacing. Pieces are filled with
+ * Bridson's algorithm level by level: each piece only has to respect the
+ * samples of the lower-level pieces around it, and all pieces on one level
+ * run in parallel. Every piece draws from its own generator seeded by
+ * (seed, piece coordinate), so the samples of a tile are the same whether
+ * it is generated alone, next to its neighbors, or as part of a region, and
+ * the minimum distance holds across tile borders.
+ *
+ * Spacing may vary with a density map: density 1 gives min_distance,
+ * density 0 gives max_distance, and density <= 0 gives no samples. A sample
+ * keeps its own spacing from every sample placed before it.
+ *
+ * Usage (internal):
+ *   TiledPoissonCore<2> core;
+ *   core.config.min_distance = 4.0f;
+ *   std::vector<TiledPoissonCore<2>::Point> samples;
+ *   core.generate({{0, 0}, {1, 0}}, clip_lo, clip_hi, samples);
+ */
+
+#ifndef AGENTITE_TILED_POISSON_CORE_HPP
+#define AGENTITE_TILED_POISSON_CORE_HPP
+
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+template <int D>
+class TiledPoissonCore {
+public:
+    using Point = std::array<float, D>;
+    using Coord = std::array<int32_t, D>;
+
+    struct Config {
+        int64_t seed = 0;
+        float tile_size = 256.0f;
+        float min_distance = 8.0f;
+        float max_distance = 0.0f;  // Spacing at density 0; <= min_distance = uniform
+        int32_t max_attempts = 30;
+        bool threaded = true;
+    };
+
+    Config config;
+
+    // Density in [0, 1] on a regular grid of density_size cells covering
+    // [density_origin, density_origin + density_extent]; empty = 1 everywhere
+    std::vector<float> density;
+    Coord density_size{};
+    Point density_origin{};
+    Point density_extent{};
+
+    float max_spacing() const {
+        return std::max(config.min_distance, config.max_distance);
+    }
+
+    // Smallest tile_size for which pieces on the same level cannot interact
+    static float min_tile_size(float spacing) {
+        return 2.0f * band(0, spacing) + layout_distance(spacing);
+    }
+
+    // Append the samples of each tile (half-open cells of tile_size), tile by
+    // tile, keeping those inside [clip_lo, clip_hi)
+    void generate(const std::vector<Coord>& tiles, const Point& clip_lo, const Point& clip_hi,
+                  std::vector<Point>& out) const {
+        std::unordered_map<Piece, int32_t, PieceHash> index;
+        std::vector<Piece> pieces;
+        std::vector<std::vector<int32_t>> deps;
+        std::vector<Piece> scratch;
+
+        auto add = [&](const Piece& piece) {
+            auto inserted = index.emplace(piece, static_cast<int32_t>(pieces.size()));
+            if (inserted.second) {
+                pieces.push_back(piece);
+            }
+            return inserted.first->second;
+        };
+
+        // Pieces overlapping the tiles, then everything they depend on
+        // (dependencies are always on a lower level, so this terminates)
+        std::vector<std::vector<int32_t>> tile_pieces(tiles.size());
+        for (size_t t = 0; t < tiles.size(); t++) {
+            pieces_in_tile(tiles[t], scratch);
+            for (const Piece& piece : scratch) {
+                tile_pieces[t].push_back(add(piece));
+            }
+        }
+        for (size_t i = 0; i < pieces.size(); i++) {
+            Piece piece = pieces[i];
+            dependencies(piece, scratch);
+            std::vector<int32_t> piece_deps;
+            piece_deps.reserve(scratch.size());
+            for (const Piece& dep : scratch) {
+                piece_deps.push_back(add(dep));
+            }
+            deps.push_back(std::move(piece_deps));
+        }
+
+        // Fill level by level; pieces on one level are independent
+        std::vector<std::vector<Point>> samples(pieces.size());
+        std::vector<int32_t> ids;
+        for (int lvl = 0; lvl <= D; lvl++) {
+            ids.clear();
+            for (size_t i = 0; i < pieces.size(); i++) {
+                if (level(pieces[i].far) == lvl) {
+                    ids.push_back(static_cast<int32_t>(i));
+                }
+            }
+            run(static_cast<int64_t>(ids.size()), [&](int64_t begin, int64_t end) {
+                std::vector<const std::vector<Point>*> constraints;
+                for (int64_t k = begin; k < end; k++) {
+                    int32_t i = ids[k];
+                    constraints.clear();
+                    for (int32_t dep : deps[i]) {
+                        constraints.push_back(&samples[dep]);
+                    }
+                    fill_piece(pieces[i], constraints, samples[i]);
+                }
+            });
+        }
+
+        float size = config.tile_size;
+        for (size_t t = 0; t < tiles.size(); t++) {
+            Point lo, hi;
+            for (int a = 0; a < D; a++) {
+                lo[a] = std::max(tiles[t][a] * size, clip_lo[a]);
+                hi[a] = std::min((tiles[t][a] + 1) * size, clip_hi[a]);
+            }
+            for (int32_t id : tile_pieces[t]) {
+                for (const Point& p : samples[id]) {
+                    if (inside(p, lo, hi)) {
+                        out.push_back(p);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // A piece is a region around the tile lattice. For each axis, coord is a
+    // lattice line index if the axis is near a line, or a tile cell index if
+    // its bit is set in far.
+    struct Piece {
+        Coord coord;
+        uint32_t far;
+
+        bool operator==(const Piece& other) const {
+            return far == other.far && coord == other.coord;
+        }
+    };
+
+    struct PieceHash {
+        size_t operator()(const Piece& piece) const {
+            uint64_t h = piece.far;
+            for (int a = 0; a < D; a++) {
+                h = mix(h ^ static_cast<uint32_t>(piece.coord[a]));
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    // SplitMix64 stream, one per piece
+    struct Rng {
+        uint64_t state;
+
+        uint64_t next() {
+            return mix(state += 0x9e3779b97f4a7c15ULL);
+        }
+
+        float next_float() {
+            return (next() >> 40) * (1.0f / 16777216.0f);
+        }
+    };
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static int level(uint32_t far) {
+        int count = 0;
+        for (int a = 0; a < D; a++) {
+            count += (far >> a) & 1;
+        }
+        return count;
+    }
+
+    // Piece separation, with a margin so float rounding cannot bring two
+    // pieces on the same level within the spacing
+    static float layout_distance(float spacing) {
+        return spacing * 1.01f;
+    }
+
+    // Half-width of the band around a lattice line for pieces of a level.
+    // Interiors are split by bands of width r; each lower level widens the
+    // band by r / sqrt(2), which keeps pieces on the same level (meeting at
+    // right angles) at least r apart.
+    static float band(int lvl, float spacing) {
+        float r = layout_distance(spacing);
+        return 0.5f * r + (D - 1 - lvl) * r * 0.70710678f;
+    }
+
+    template <typename Body>
+    void run(int64_t count, const Body& body) const {
+        if (config.threaded) {
+            parallel::for_range(count, 1, body);
+        } else {
+            body(0, count);
+        }
+    }
+
+    static bool inside(const Point& p, const Point& lo, const Point& hi) {
+        for (int a = 0; a < D; a++) {
+            if (!(p[a] >= lo[a] && p[a] < hi[a])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Piece classify(const Point& p) const {
+        float size = config.tile_size;
+        float spacing = max_spacing();
+        float dist[D];
+        int32_t line[D];
+        int32_t cell[D];
+        int order[D];
+        for (int a = 0; a < D; a++) {
+            float t = p[a] / size;
+            line[a] = static_cast<int32_t>(std::floor(t + 0.5f));
+            cell[a] = static_cast<int32_t>(std::floor(t));
+            dist[a] = std::abs(p[a] - line[a] * size);
+            order[a] = a;
+        }
+        // Axes by distance to their nearest line, closest first
+        for (int a = 1; a < D; a++) {
+            for (int b = a; b > 0 && dist[order[b]] < dist[order[b - 1]]; b--) {
+                std::swap(order[b], order[b - 1]);
+            }
+        }
+
+        // Level L: the D - L closest axes are all within the band of level L
+        int lvl = D;
+        for (int l = 0; l < D; l++) {
+            if (dist[order[D - 1 - l]] <= band(l, spacing)) {
+                lvl = l;
+                break;
+            }
+        }
+
+        Piece piece;
+        piece.far = 0;
+        for (int k = 0; k < D; k++) {
+            int a = order[k];
+            if (k < D - lvl) {
+                piece.coord[a] = line[a];
+            } else {
+                piece.coord[a] = cell[a];
+                piece.far |= 1u << a;
+            }
+        }
+        return piece;
+    }
+
+    void piece_bounds(const Piece& piece, Point& lo, Point& hi) const {
+        float size = config.tile_size;
+        float half = band(level(piece.far), max_spacing());
+        for (int a = 0; a < D; a++) {
+            float base = piece.coord[a] * size;
+            if ((piece.far >> a) & 1) {
+                lo[a] = base;
+                hi[a] = base + size;
+            } else {
+                lo[a] = base - half;
+                hi[a] = base + half;
+            }
+        }
+    }
+
+    // Append every piece of the given far mask with coord in [first, last]
+    static void add_box(uint32_t far, const Coord& first, const Coord& last, std::vector<Piece>& out) {
+        for (int a = 0; a < D; a++) {
+            if (first[a] > last[a]) {
+                return;
+            }
+        }
+        Piece piece;
+        piece.far = far;
+        piece.coord = first;
+        while (true) {
+            out.push_back(piece);
+            int a = 0;
+            for (; a < D; a++) {
+                if (++piece.coord[a] <= last[a]) {
+                    break;
+                }
+                piece.coord[a] = first[a];
+            }
+            if (a == D) {
+                break;
+            }
+        }
+    }
+
+    // Pieces that can hold samples inside a tile: per axis, the two lines
+    // bounding the tile or the tile's own cell
+    void pieces_in_tile(const Coord& tile, std::vector<Piece>& out) const {
+        out.clear();
+        for (uint32_t far = 0; far < (1u << D); far++) {
+            Coord first, last;
+            for (int a = 0; a < D; a++) {
+                first[a] = tile[a];
+                last[a] = ((far >> a) & 1) ? tile[a] : tile[a] + 1;
+            }
+            add_box(far, first, last, out);
+        }
+    }
+
+    // Lower-level pieces whose bounds come within the spacing of piece
+    void dependencies(const Piece& piece, std::vector<Piece>& out) const {
+        out.clear();
+        int lvl = level(piece.far);
+        if (lvl == 0) {
+            return;
+        }
+        float size = config.tile_size;
+        float spacing = max_spacing();
+        float reach = layout_distance(spacing);
+        Point lo, hi;
+        piece_bounds(piece, lo, hi);
+
+        for (uint32_t far = 0; far < (1u << D); far++) {
+            if (level(far) >= lvl) {
+                continue;
+            }
+            float half = band(level(far), spacing);
+            Coord first, last;
+            for (int a = 0; a < D; a++) {
+                if ((far >> a) & 1) {
+                    first[a] = static_cast<int32_t>(std::floor((lo[a] - reach) / size));
+                    last[a] = static_cast<int32_t>(std::floor((hi[a] + reach) / size));
+                } else {
+                    first[a] = static_cast<int32_t>(std::ceil((lo[a] - reach - half) / size));
+                    last[a] = static_cast<int32_t>(std::floor((hi[a] + reach + half) / size));
+                }
+            }
+            add_box(far, first, last, out);
+        }
+    }
+
+    float density_at(const Point& p) const {
+        // Multilinear interpolation between cell centers, clamped at the edges
+        int32_t i0[D];
+        int32_t i1[D];
+        float f[D];
+        for (int a = 0; a < D; a++) {
+            int32_t n = density_size[a];
+            float u = (p[a] - density_origin[a]) / density_extent[a] * n - 0.5f;
+            u = std::min(std::max(u, 0.0f), static_cast<float>(n - 1));
+            i0[a] = static_cast<int32_t>(u);
+            i1[a] = std::min(i0[a] + 1, n - 1);
+            f[a] = u - i0[a];
+        }
+        float value = 0.0f;
+        for (uint32_t corner = 0; corner < (1u << D); corner++) {
+            float weight = 1.0f;
+            int64_t idx = 0;
+            int64_t stride = 1;
+            for (int a = 0; a < D; a++) {
+                bool upper = (corner >> a) & 1;
+                weight *= upper ? f[a] : 1.0f - f[a];
+                idx += (upper ? i1[a] : i0[a]) * stride;
+                stride *= density_size[a];
+            }
+            value += weight * density[idx];
+        }
+        return value;
+    }
+
+    // Spacing around a point; 0 = no samples here
+    float spacing_at(const Point& p) const {
+        if (density.empty()) {
+            return config.min_distance;
+        }
+        float value = density_at(p);
+        if (!(value > 0.0f)) {
+            return 0.0f;
+        }
+        value = std::min(value, 1.0f);
+        float far_spacing = max_spacing();
+        return far_spacing + (config.min_distance - far_spacing) * value;
+    }
+
+    // Random point at distance [spacing, 2 * spacing] from center
+    static Point around(const Point& center, float spacing, Rng& rng) {
+        const float TWO_PI = 6.283185307179586f;
+        float r = spacing + rng.next_float() * spacing;
+        Point p = center;
+        if constexpr (D == 2) {
+            float angle = rng.next_float() * TWO_PI;
+            p[0] += std::cos(angle) * r;
+            p[1] += std::sin(angle) * r;
+        } else {
+            float theta = rng.next_float() * TWO_PI;
+            float phi = std::acos(2.0f * rng.next_float() - 1.0f);
+            float sin_phi = std::sin(phi);
+            p[0] += r * sin_phi * std::cos(theta);
+            p[1] += r * sin_phi * std::sin(theta);
+            p[2] += r * std::cos(phi);
+        }
+        return p;
+    }
+
+    // Bridson's algorithm inside one piece, around the fixed samples of its dependencies
+    void fill_piece(const Piece& piece, const std::vector<const std::vector<Point>*>& constraints,
+                    std::vector<Point>& out) const {
+        float min_distance = config.min_distance;
+        float reach = layout_distance(max_spacing());
+        Point lo, hi;
+        piece_bounds(piece, lo, hi);
+
+        // Local grid over the piece plus the reach of its neighbors; cells
+        // are small enough to hold at most one sample
+        float cell = min_distance / std::sqrt(static_cast<float>(D));
+        float inv_cell = 1.0f / cell;
+        Point grid_lo;
+        int32_t dims[D];
+        int64_t total = 1;
+        for (int a = 0; a < D; a++) {
+            grid_lo[a] = lo[a] - reach;
+            dims[a] = static_cast<int32_t>(std::ceil((hi[a] - lo[a] + 2.0f * reach) * inv_cell)) + 1;
+            total *= dims[a];
+        }
+        std::vector<int32_t> grid(static_cast<size_t>(total), -1);
+        std::vector<Point> points;
+        std::vector<float> spacings;
+        std::vector<int32_t> active;
+
+        auto cell_of = [&](const Point& p, int32_t* c) {
+            for (int a = 0; a < D; a++) {
+                float u = (p[a] - grid_lo[a]) * inv_cell;
+                if (!(u >= 0.0f && u < static_cast<float>(dims[a]))) {
+                    return false;
+                }
+                c[a] = static_cast<int32_t>(u);
+            }
+            return true;
+        };
+        auto cell_index = [&](const int32_t* c) {
+            int64_t idx = 0;
+            int64_t stride = 1;
+            for (int a = 0; a < D; a++) {
+                idx += c[a] * stride;
+                stride *= dims[a];
+            }
+            return idx;
+        };
+        auto insert = [&](const Point& p, const int32_t* c, float spacing) {
+            grid[cell_index(c)] = static_cast<int32_t>(points.size());
+            active.push_back(static_cast<int32_t>(points.size()));
+            points.push_back(p);
+            spacings.push_back(spacing);
+        };
+        // No earlier sample within spacing of p
+        auto fits = [&](const Point& p, const int32_t* c, float spacing) {
+            int32_t span = static_cast<int32_t>(std::ceil(spacing * inv_cell));
+            int32_t first[D];
+            int32_t last[D];
+            for (int a = 0; a < D; a++) {
+                first[a] = std::max(c[a] - span, 0);
+                last[a] = std::min(c[a] + span, dims[a] - 1);
+            }
+            float limit_sq = spacing * spacing;
+            auto near = [&](int32_t other) {
+                float dist_sq = 0.0f;
+                for (int a = 0; a < D; a++) {
+                    float d = p[a] - points[other][a];
+                    dist_sq += d * d;
+                }
+                return dist_sq < limit_sq;
+            };
+            const int32_t* cells = grid.data();
+            if constexpr (D == 2) {
+                for (int32_t y = first[1]; y <= last[1]; y++) {
+                    const int32_t* row = cells + static_cast<int64_t>(y) * dims[0];
+                    for (int32_t x = first[0]; x <= last[0]; x++) {
+                        if (row[x] >= 0 && near(row[x])) {
+                            return false;
+                        }
+                    }
+                }
+            } else {
+                for (int32_t z = first[2]; z <= last[2]; z++) {
+                    for (int32_t y = first[1]; y <= last[1]; y++) {
+                        const int32_t* row = cells + (static_cast<int64_t>(z) * dims[1] + y) * dims[0];
+                        for (int32_t x = first[0]; x <= last[0]; x++) {
+                            if (row[x] >= 0 && near(row[x])) {
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+            return true;
+        };
+        // Interior points farther than the widest band from the tile border
+        // always belong to this piece and skip classify()
+        Point sure_lo = hi;
+        Point sure_hi = lo;
+        if (level(piece.far) == D) {
+            float widest = band(0, max_spacing());
+            for (int a = 0; a < D; a++) {
+                sure_lo[a] = lo[a] + widest;
+                sure_hi[a] = hi[a] - widest;
+            }
+        }
+        auto try_add = [&](const Point& p) {
+            if (!inside(p, lo, hi) || (!inside(p, sure_lo, sure_hi) && !(classify(p) == piece))) {
+                return false;
+            }
+            float spacing = spacing_at(p);
+            int32_t c[D];
+            if (!(spacing > 0.0f) || !cell_of(p, c) || !fits(p, c, spacing)) {
+                return false;
+            }
+            insert(p, c, spacing);
+            return true;
+        };
+
+        // Fixed samples also spawn candidates, so the piece grows in from its borders
+        for (const std::vector<Point>* fixed : constraints) {
+            for (const Point& p : *fixed) {
+                int32_t c[D];
+                if (cell_of(p, c)) {
+                    insert(p, c, spacing_at(p));
+                }
+            }
+        }
+        size_t own_start = points.size();
+
+        Rng rng{static_cast<uint64_t>(config.seed)};
+        rng.state = mix(rng.state ^ (static_cast<uint64_t>(piece.far) << 32));
+        for (int a = 0; a < D; a++) {
+            rng.state = mix(rng.state ^ static_cast<uint32_t>(piece.coord[a]) ^ (static_cast<uint64_t>(a + 1) << 40));
+        }
+
+        // A few darts seed pieces that no fixed sample reaches
+        for (int32_t k = 0; k < config.max_attempts; k++) {
+            Point p;
+            for (int a = 0; a < D; a++) {
+                p[a] = lo[a] + rng.next_float() * (hi[a] - lo[a]);
+            }
+            try_add(p);
+        }
+
+        while (!active.empty()) {
+            size_t pick = rng.next() % active.size();
+            int32_t center = active[pick];
+            bool found = false;
+            for (int32_t attempt = 0; attempt < config.max_attempts; attempt++) {
+                if (try_add(around(points[center], spacings[center], rng))) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                active[pick] = active.back();
+                active.pop_back();
+            }
+        }
+
+        out.assign(points.begin() + own_start, points.end());
+    }
+};
+
+}
+
+#endif // AGENTITE_TILED_POISSON_CORE_HPP
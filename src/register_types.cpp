@@ -11,23 +11,52 @@
 #include <godot_cpp/godot.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
+#include "spatial/neighbor_list.hpp"
 #include "spatial/spatial_hash_2d.hpp"
 #include "spatial/spatial_hash_3d.hpp"
+#include "spatial/spatial_grid_2d.hpp"
+#include "spatial/spatial_grid_3d.hpp"
 #include "spatial/kd_tree_2d.hpp"
 #include "spatial/kd_tree_3d.hpp"
 #include "spatial/quad_tree.hpp"
 #include "spatial/octree.hpp"
+#include "spatial/dynamic_aabb_tree_2d.hpp"
+#include "spatial/dynamic_aabb_tree_3d.hpp"
 #include "arrays/array_ops.hpp"
+#include "arrays/array_query.hpp"
+#include "arrays/vector_buffer.hpp"
+#include "arrays/agent_store_2d.hpp"
+#include "arrays/agent_store_3d.hpp"
 #include "math/math_ops.hpp"
 #include "batch/batch_ops.hpp"
+#include "batch/steering_integrator_2d.hpp"
+#include "batch/steering_integrator_3d.hpp"
 #include "random/random_ops.hpp"
+#include "random/parallel_random.hpp"
+#include "random/tiled_poisson_2d.hpp"
+#include "random/tiled_poisson_3d.hpp"
 #include "noise/noise_ops.hpp"
 #include "grid/grid_ops.hpp"
+#include "grid/visibility_map.hpp"
+#include "grid/connected_components.hpp"
+#include "pathfinding/pathfinding_context.hpp"
 #include "pathfinding/pathfinding_ops.hpp"
+#include "pathfinding/hierarchical_pathfinder.hpp"
+#include "pathfinding/flow_field_cache.hpp"
+#include "pathfinding/nav_mesh_2d.hpp"
 #include "collision/collision_ops.hpp"
 #include "geometry/geometry_ops.hpp"
 #include "interpolation/interpolation_ops.hpp"
+#include "interpolation/spline_2d.hpp"
+#include "interpolation/spline_3d.hpp"
 #include "stats/stat_ops.hpp"
+#include "stats/streaming_stats.hpp"
+#include "core/parallel.hpp"
+#include "core/profiler.hpp"
+
+#ifdef AGENTITE_BENCHMARKS
+#include "benchmark/native_benchmark.hpp"
+#endif
 
 using namespace godot;
 
@@ -37,33 +66,54 @@ void initialize_agentite_module(ModuleInitializationLevel p_level) {
     }
 
     // Register spatial classes
+    ClassDB::register_class<NeighborList>();
     ClassDB::register_class<SpatialHash2D>();
     ClassDB::register_class<SpatialHash3D>();
+    ClassDB::register_class<SpatialGrid2D>();
+    ClassDB::register_class<SpatialGrid3D>();
     ClassDB::register_class<KDTree2D>();
     ClassDB::register_class<KDTree3D>();
     ClassDB::register_class<QuadTree>();
     ClassDB::register_class<Octree>();
+    ClassDB::register_class<DynamicAABBTree2D>();
+    ClassDB::register_class<DynamicAABBTree3D>();
 
     // Register array operations (static methods via singleton)
     ClassDB::register_class<ArrayOps>();
+    ClassDB::register_class<ArrayQuery>();
+    ClassDB::register_class<Vector2Buffer>();
+    ClassDB::register_class<Vector3Buffer>();
+    ClassDB::register_class<AgentStore2D>();
+    ClassDB::register_class<AgentStore3D>();
 
     // Register math operations
     ClassDB::register_class<MathOps>();
 
     // Register batch operations
     ClassDB::register_class<BatchOps>();
+    ClassDB::register_class<SteeringIntegrator2D>();
+    ClassDB::register_class<SteeringIntegrator3D>();
 
     // Register random operations
     ClassDB::register_class<RandomOps>();
+    ClassDB::register_class<ParallelRandom>();
+    ClassDB::register_class<TiledPoisson2D>();
+    ClassDB::register_class<TiledPoisson3D>();
 
     // Register noise operations
     ClassDB::register_class<NoiseOps>();
 
     // Register grid operations
     ClassDB::register_class<GridOps>();
+    ClassDB::register_class<VisibilityMap>();
+    ClassDB::register_class<ConnectedComponents>();
 
     // Register pathfinding operations
+    ClassDB::register_class<PathfindingContext>();
     ClassDB::register_class<PathfindingOps>();
+    ClassDB::register_class<HierarchicalPathfinder>();
+    ClassDB::register_class<FlowFieldCache>();
+    ClassDB::register_class<NavMesh2D>();
 
     // Register collision operations
     ClassDB::register_class<CollisionOps>();
@@ -73,16 +123,32 @@ void initialize_agentite_module(ModuleInitializationLevel p_level) {
 
     // Register interpolation operations
     ClassDB::register_class<InterpolationOps>();
+    ClassDB::register_class<Spline2D>();
+    ClassDB::register_class<Spline3D>();
 
     // Register statistics operations
     ClassDB::register_class<StatOps>();
+    ClassDB::register_class<StreamingStats>();
+
+    // Register profiling
+    ClassDB::register_class<Profiler>();
+
+#ifdef AGENTITE_BENCHMARKS
+    // Benchmark harness (scons benchmarks=yes)
+    ClassDB::register_class<NativeBenchmark>();
+#endif
 }
 
 void uninitialize_agentite_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
     }
-    // Cleanup if needed
+
+    // Drop Performance monitors and the frame hook before the library unloads
+    Profiler::shutdown();
+
+    // Join worker threads used by parallel batch operations
+    parallel::shutdown();
 }
 
 extern "C" {
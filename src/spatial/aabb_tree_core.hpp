@@ -0,0 +1,447 @@
+/**
+ * AABBTreeCore - Incremental bounding volume hierarchy shared by
+ * DynamicAABBTree2D and DynamicAABBTree3D
+ *
+ * A binary tree of boxes in the style of Box2D's b2DynamicTree. Every leaf
+ * is one proxy with a tight box (what the caller inserted) and a fat box
+ * (the tight box grown by a margin). Inner nodes bound their children's fat
+ * boxes. Moving a proxy only touches the tree when its new tight box leaves
+ * its fat box, so small movements cost nothing.
+ *
+ * Leaves are inserted next to the sibling that grows the tree's total
+ * surface area (perimeter in 2D) the least, and AVL-style rotations keep
+ * the tree balanced. Nodes live in one array; freed nodes are recycled, so
+ * a proxy id (its leaf's index) may be reused after the proxy is removed.
+ *
+ * Queries walk the tree iteratively with a fixed-size stack and test
+ * leaves against their tight box.
+ *
+ * Usage (internal):
+ *   AABBTreeCore<2> tree;
+ *   int32_t id = tree.create(box, margin);
+ *   tree.query(area, [&](int32_t hit) { ... });
+ */
+
+#ifndef AGENTITE_AABB_TREE_CORE_HPP
+#define AGENTITE_AABB_TREE_CORE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace godot {
+
+template <int D>
+class AABBTreeCore {
+public:
+    struct Box {
+        float lo[D];
+        float hi[D];
+    };
+
+    // Add a proxy, returning its id
+    int32_t create(const Box& box, float margin) {
+        int32_t id = alloc_node();
+        nodes[id].tight = box;
+        nodes[id].fat = expand(box, margin);
+        insert_leaf(id);
+        leaf_count++;
+        return id;
+    }
+
+    void destroy(int32_t id) {
+        remove_leaf(id);
+        free_node(id);
+        leaf_count--;
+    }
+
+    // Change a proxy's box. Returns true if it had to be reinserted (the box
+    // left its fat box, or shrank so much that the fat box is far too big).
+    bool move(int32_t id, const Box& box, float margin) {
+        nodes[id].tight = box;
+        if (contains(nodes[id].fat, box) && contains(expand(box, 4.0f * margin), nodes[id].fat)) {
+            return false;
+        }
+
+        remove_leaf(id);
+        nodes[id].fat = expand(box, margin);
+        insert_leaf(id);
+        return true;
+    }
+
+    void clear() {
+        nodes.clear();
+        root = -1;
+        free_list = -1;
+        leaf_count = 0;
+    }
+
+    bool is_proxy(int32_t id) const {
+        return id >= 0 && id < static_cast<int32_t>(nodes.size()) && nodes[id].height == 0;
+    }
+
+    const Box& tight_box(int32_t id) const { return nodes[id].tight; }
+
+    // Number of proxies
+    int32_t size() const { return leaf_count; }
+
+    // One past the largest id in use
+    int32_t capacity() const { return static_cast<int32_t>(nodes.size()); }
+
+    // Edges on the longest root-to-leaf path (0 for a single proxy)
+    int32_t height() const { return root == -1 ? 0 : nodes[root].height; }
+
+    // Call visit(id) for every proxy whose tight box overlaps box (touching counts)
+    template <typename Visit>
+    void query(const Box& box, const Visit& visit) const {
+        if (root == -1) return;
+
+        int32_t stack[STACK_SIZE];
+        int32_t top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            int32_t id = stack[--top];
+            const Node& node = nodes[id];
+            if (!overlaps(node.fat, box)) continue;
+
+            if (node.child1 == -1) {
+                if (overlaps(node.tight, box)) {
+                    visit(id);
+                }
+            } else {
+                stack[top++] = node.child2;
+                stack[top++] = node.child1;
+            }
+        }
+    }
+
+    // Call visit(id, t) for every proxy whose tight box the ray hits at
+    // distance t <= max_t, where t is the entry distance, or the exit distance
+    // when origin is inside the box (like CollisionOps.ray_vs_aabbs_2d).
+    // direction must be normalized. visit returns the new max_t, so nearest-
+    // hit searches can shrink it; nearer children are visited first to make
+    // that pruning effective.
+    template <typename Visit>
+    void ray(const float* origin, const float* direction, float max_t, const Visit& visit) const {
+        walk_ray<false>(origin, direction, max_t, visit);
+    }
+
+    // As ray(), but t is where the ray enters the box (0 when origin is
+    // inside it). Every point of the box the ray reaches is at least t along
+    // it, so callers testing the exact shape inside each box can prune with
+    // the nearest exact hit.
+    template <typename Visit>
+    void ray_entry(const float* origin, const float* direction, float max_t, const Visit& visit) const {
+        walk_ray<true>(origin, direction, max_t, visit);
+    }
+
+    // Call visit(fat_box) for every node, parents before children
+    template <typename Visit>
+    void for_each_node(const Visit& visit) const {
+        if (root == -1) return;
+
+        int32_t stack[STACK_SIZE];
+        int32_t top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            visit(node.fat);
+            if (node.child1 != -1) {
+                stack[top++] = node.child2;
+                stack[top++] = node.child1;
+            }
+        }
+    }
+
+private:
+    struct Node {
+        Box fat;           // Bounds of the subtree (leaves: tight box plus margin)
+        Box tight;         // Leaves only: the proxy's box
+        int32_t parent;    // Next free node while on the free list
+        int32_t child1;    // -1 for a leaf
+        int32_t child2;
+        int32_t height;    // 0 for a leaf, -1 for a free node
+    };
+
+    // Rotations keep the height near 1.44 * log2(proxies), far below this
+    static constexpr int32_t STACK_SIZE = 256;
+
+    // Ray traversal stack entry: a node and the distance the ray enters its fat box
+    struct RayEntry {
+        int32_t id;
+        float t;
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = -1;
+    int32_t free_list = -1;
+    int32_t leaf_count = 0;
+
+    template <bool from_entry, typename Visit>
+    void walk_ray(const float* origin, const float* direction, float max_t, const Visit& visit) const {
+        if (root == -1) return;
+
+        float inv[D];
+        for (int a = 0; a < D; a++) {
+            inv[a] = direction[a] != 0.0f ? 1.0f / direction[a] : std::numeric_limits<float>::infinity();
+        }
+
+        RayEntry stack[STACK_SIZE];
+        int32_t top = 0;
+        float t_enter;
+        float t_exit;
+        if (!ray_box(nodes[root].fat, origin, inv, t_enter, t_exit)) return;
+        stack[top++] = {root, t_enter};
+        while (top > 0) {
+            RayEntry e = stack[--top];
+            if (e.t > max_t) continue;
+            const Node& node = nodes[e.id];
+
+            if (node.child1 == -1) {
+                if (ray_box(node.tight, origin, inv, t_enter, t_exit)) {
+                    float t = t_enter >= 0.0f ? t_enter : (from_entry ? 0.0f : t_exit);
+                    if (t <= max_t) {
+                        max_t = visit(e.id, t);
+                    }
+                }
+                continue;
+            }
+
+            float t1;
+            float t2;
+            bool hit1 = ray_box(nodes[node.child1].fat, origin, inv, t1, t_exit) && t1 <= max_t;
+            bool hit2 = ray_box(nodes[node.child2].fat, origin, inv, t2, t_exit) && t2 <= max_t;
+            if (hit1 && hit2) {
+                // Push the farther child first so the nearer one pops next
+                if (t1 <= t2) {
+                    stack[top++] = {node.child2, t2};
+                    stack[top++] = {node.child1, t1};
+                } else {
+                    stack[top++] = {node.child1, t1};
+                    stack[top++] = {node.child2, t2};
+                }
+            } else if (hit1) {
+                stack[top++] = {node.child1, t1};
+            } else if (hit2) {
+                stack[top++] = {node.child2, t2};
+            }
+        }
+    }
+
+    static Box expand(const Box& b, float margin) {
+        Box r;
+        for (int a = 0; a < D; a++) {
+            r.lo[a] = b.lo[a] - margin;
+            r.hi[a] = b.hi[a] + margin;
+        }
+        return r;
+    }
+
+    static Box merge(const Box& x, const Box& y) {
+        Box r;
+        for (int a = 0; a < D; a++) {
+            r.lo[a] = std::min(x.lo[a], y.lo[a]);
+            r.hi[a] = std::max(x.hi[a], y.hi[a]);
+        }
+        return r;
+    }
+
+    static bool contains(const Box& outer, const Box& inner) {
+        for (int a = 0; a < D; a++) {
+            if (inner.lo[a] < outer.lo[a] || inner.hi[a] > outer.hi[a]) return false;
+        }
+        return true;
+    }
+
+    static bool overlaps(const Box& x, const Box& y) {
+        for (int a = 0; a < D; a++) {
+            if (x.hi[a] < y.lo[a] || y.hi[a] < x.lo[a]) return false;
+        }
+        return true;
+    }
+
+    // Insertion cost: perimeter in 2D, surface area in 3D
+    static float area(const Box& b) {
+        float e[D];
+        for (int a = 0; a < D; a++) {
+            e[a] = b.hi[a] - b.lo[a];
+        }
+        if constexpr (D == 2) {
+            return 2.0f * (e[0] + e[1]);
+        } else {
+            return 2.0f * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+        }
+    }
+
+    static bool ray_box(const Box& b, const float* origin, const float* inv, float& t_enter, float& t_exit) {
+        t_enter = -std::numeric_limits<float>::infinity();
+        t_exit = std::numeric_limits<float>::infinity();
+        for (int a = 0; a < D; a++) {
+            float t1 = (b.lo[a] - origin[a]) * inv[a];
+            float t2 = (b.hi[a] - origin[a]) * inv[a];
+            t_enter = std::fmax(t_enter, std::fmin(t1, t2));
+            t_exit = std::fmin(t_exit, std::fmax(t1, t2));
+        }
+        return t_exit >= 0.0f && t_enter <= t_exit;
+    }
+
+    int32_t alloc_node() {
+        int32_t id;
+        if (free_list != -1) {
+            id = free_list;
+            free_list = nodes[id].parent;
+        } else {
+            id = static_cast<int32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& n = nodes[id];
+        n.parent = -1;
+        n.child1 = -1;
+        n.child2 = -1;
+        n.height = 0;
+        return id;
+    }
+
+    void free_node(int32_t id) {
+        nodes[id].parent = free_list;
+        nodes[id].height = -1;
+        free_list = id;
+    }
+
+    void refit(int32_t id) {
+        Node& n = nodes[id];
+        n.fat = merge(nodes[n.child1].fat, nodes[n.child2].fat);
+        n.height = 1 + std::max(nodes[n.child1].height, nodes[n.child2].height);
+    }
+
+    void replace_child(int32_t parent, int32_t old_child, int32_t new_child) {
+        if (parent == -1) {
+            root = new_child;
+        } else if (nodes[parent].child1 == old_child) {
+            nodes[parent].child1 = new_child;
+        } else {
+            nodes[parent].child2 = new_child;
+        }
+    }
+
+    void insert_leaf(int32_t leaf) {
+        if (root == -1) {
+            root = leaf;
+            nodes[leaf].parent = -1;
+            return;
+        }
+
+        // Find the best sibling: descend while splitting a child is cheaper
+        // than pairing the leaf with the current node
+        const Box leaf_box = nodes[leaf].fat;
+        int32_t index = root;
+        while (nodes[index].child1 != -1) {
+            const Node& n = nodes[index];
+            float combined_area = area(merge(n.fat, leaf_box));
+
+            // Cost of a new parent for this node and the leaf, and the cost
+            // pushed down to every ancestor when descending further
+            float cost = 2.0f * combined_area;
+            float inheritance = 2.0f * (combined_area - area(n.fat));
+
+            float child_cost[2];
+            const int32_t children[2] = {n.child1, n.child2};
+            for (int c = 0; c < 2; c++) {
+                const Node& child = nodes[children[c]];
+                float merged = area(merge(child.fat, leaf_box));
+                child_cost[c] = (child.child1 == -1 ? merged : merged - area(child.fat)) + inheritance;
+            }
+
+            if (cost < child_cost[0] && cost < child_cost[1]) break;
+            index = child_cost[0] < child_cost[1] ? n.child1 : n.child2;
+        }
+
+        // Give the sibling and the leaf a new parent
+        int32_t sibling = index;
+        int32_t old_parent = nodes[sibling].parent;
+        int32_t new_parent = alloc_node();
+        nodes[new_parent].parent = old_parent;
+        nodes[new_parent].child1 = sibling;
+        nodes[new_parent].child2 = leaf;
+        nodes[new_parent].fat = merge(leaf_box, nodes[sibling].fat);
+        nodes[new_parent].height = nodes[sibling].height + 1;
+        replace_child(old_parent, sibling, new_parent);
+        nodes[sibling].parent = new_parent;
+        nodes[leaf].parent = new_parent;
+
+        // Refit and rebalance the ancestors
+        for (index = nodes[leaf].parent; index != -1; index = nodes[index].parent) {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    void remove_leaf(int32_t leaf) {
+        if (leaf == root) {
+            root = -1;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grand_parent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        // The sibling takes the parent's place
+        replace_child(grand_parent, parent, sibling);
+        nodes[sibling].parent = grand_parent;
+        free_node(parent);
+
+        for (int32_t index = grand_parent; index != -1; index = nodes[index].parent) {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    // Rotate the taller grandchild up if a's children differ in height by
+    // more than one. Returns the node now at a's position.
+    int32_t balance(int32_t a) {
+        if (nodes[a].child1 == -1 || nodes[a].height < 2) return a;
+
+        int32_t b = nodes[a].child1;
+        int32_t c = nodes[a].child2;
+        int32_t diff = nodes[c].height - nodes[b].height;
+        if (diff > 1) return rotate_up(a, c, b, false);
+        if (diff < -1) return rotate_up(a, b, c, true);
+        return a;
+    }
+
+    // Make child the parent of a. other is a's remaining child;
+    // child_was_first says which slot of a child occupied.
+    int32_t rotate_up(int32_t a, int32_t child, int32_t other, bool child_was_first) {
+        int32_t f = nodes[child].child1;
+        int32_t g = nodes[child].child2;
+
+        nodes[child].child1 = a;
+        nodes[child].parent = nodes[a].parent;
+        nodes[a].parent = child;
+        replace_child(nodes[child].parent, a, child);
+
+        // a keeps the shorter grandchild, child keeps the taller one
+        int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+        int32_t give = keep == f ? g : f;
+        nodes[child].child2 = keep;
+        if (child_was_first) {
+            nodes[a].child1 = give;
+        } else {
+            nodes[a].child2 = give;
+        }
+        nodes[give].parent = a;
+
+        nodes[a].fat = merge(nodes[other].fat, nodes[give].fat);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[give].height);
+        nodes[child].fat = merge(nodes[a].fat, nodes[keep].fat);
+        nodes[child].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+        return child;
+    }
+};
+
+}
+
+#endif // AGENTITE_AABB_TREE_CORE_HPP
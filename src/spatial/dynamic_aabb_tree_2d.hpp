@@ -0,0 +1,123 @@
+/**
+ * DynamicAABBTree2D - Broadphase for moving 2D objects with a size
+ *
+ * A bounding volume hierarchy of boxes (proxies) that supports insert, move
+ * and remove, for objects that are not points: buildings, projectiles with
+ * a radius, trigger areas. Each proxy is stored with a fat box (its box
+ * grown by margin), so moving by less than the margin does not touch the
+ * tree at all.
+ *
+ * Ideal for:
+ * - Mixed-size entities (a SpatialHash cell size can't fit them all)
+ * - Box, point and ray queries against extended objects
+ * - Broadphase collision pairs in CollisionOps' flat [i0, j0, i1, j1, ...] format
+ *
+ * Proxy ids are stable while the proxy exists; the id of a removed proxy
+ * may be handed out again by a later insert().
+ *
+ * Usage:
+ *   var tree = DynamicAABBTree2D.new()
+ *   var id = tree.insert(Rect2(building.position, building.size))
+ *   tree.move(id, Rect2(unit.position - extents, extents * 2))
+ *   var pairs = tree.query_pairs()
+ */
+
+#ifndef AGENTITE_DYNAMIC_AABB_TREE_2D_HPP
+#define AGENTITE_DYNAMIC_AABB_TREE_2D_HPP
+
+#include "aabb_tree_core.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/array.hpp>
+
+#include <vector>
+
+namespace godot {
+
+class DynamicAABBTree2D : public RefCounted {
+    GDCLASS(DynamicAABBTree2D, RefCounted)
+
+private:
+    AABBTreeCore<2> tree;
+    float margin = 4.0f;
+
+    static AABBTreeCore<2>::Box to_box(const Rect2& rect);
+    bool check_proxy(int32_t id) const;
+    int32_t first_hit(const float* origin, const float* direction, float max_distance, float& distance) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    DynamicAABBTree2D();
+    ~DynamicAABBTree2D();
+
+    // Extra space around each box, so a proxy can move this far without
+    // reinsertion. Applies to boxes inserted or reinserted afterwards.
+    void set_margin(float p_margin);
+    float get_margin() const;
+
+    // Add a box, returning its proxy id
+    int32_t insert(const Rect2& box);
+
+    // Change a proxy's box. Returns true if the tree was restructured
+    // (the box moved outside its fat box).
+    bool move(int32_t id, const Rect2& box);
+
+    // Remove a proxy
+    void remove(int32_t id);
+
+    // Remove all proxies
+    void clear();
+
+    // Number of proxies
+    int32_t get_count() const;
+
+    // Box of a proxy as last inserted or moved
+    Rect2 get_box(int32_t id) const;
+
+    // Query: proxies whose box overlaps rect (touching counts)
+    PackedInt32Array query_box(const Rect2& rect) const;
+
+    // Query: proxies whose box contains point
+    PackedInt32Array query_point(const Vector2& point) const;
+
+    // Query: proxies hit by a ray within max_distance, nearest first
+    PackedInt32Array query_ray(const Vector2& origin, const Vector2& direction, float max_distance) const;
+
+    // Query: first proxy hit by a ray within max_distance, or -1
+    int32_t ray_first(const Vector2& origin, const Vector2& direction, float max_distance) const;
+
+    // Batch ray_first for many rays (multithreaded). Returns
+    // [PackedInt32Array ids, PackedFloat32Array distances], one entry per
+    // ray: -1 and INF for rays that hit nothing.
+    Array ray_first_batch(const PackedVector2Array& origins, const PackedVector2Array& directions,
+                          const PackedFloat32Array& max_distances) const;
+
+    // All overlapping proxy pairs as flat [i0, j0, i1, j1, ...], each pair once
+    // with i < j, ordered by i then j (multithreaded)
+    PackedInt32Array query_pairs() const;
+
+    // Overlapping pairs against another tree as flat [i0, j0, ...], where i is
+    // a proxy of this tree and j of other, ordered by i then j (multithreaded)
+    PackedInt32Array query_pairs_with(const Ref<DynamicAABBTree2D>& other) const;
+
+    // Debug: height of the tree
+    int32_t get_height() const;
+
+    // Debug: fat bounds of every node for visualization
+    // Returns Array of Rect2
+    Array get_node_bounds() const;
+
+    // C++ API: append proxies whose box overlaps rect
+    void collect_box(const Rect2& rect, std::vector<int32_t>& out) const;
+};
+
+}
+
+#endif // AGENTITE_DYNAMIC_AABB_TREE_2D_HPP
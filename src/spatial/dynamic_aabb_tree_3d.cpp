@@ -0,0 +1,320 @@
+/**
+ * DynamicAABBTree3D Implementation
+ */
+
+#include "dynamic_aabb_tree_3d.hpp"
+#include "neighbor_list.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace godot {
+
+void DynamicAABBTree3D::_bind_methods() {
+    // Configuration
+    ClassDB::bind_method(D_METHOD("set_margin", "margin"), &DynamicAABBTree3D::set_margin);
+    ClassDB::bind_method(D_METHOD("get_margin"), &DynamicAABBTree3D::get_margin);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "margin"), "set_margin", "get_margin");
+
+    // Core methods
+    ClassDB::bind_method(D_METHOD("insert", "box"), &DynamicAABBTree3D::insert);
+    ClassDB::bind_method(D_METHOD("move", "id", "box"), &DynamicAABBTree3D::move);
+    ClassDB::bind_method(D_METHOD("remove", "id"), &DynamicAABBTree3D::remove);
+    ClassDB::bind_method(D_METHOD("clear"), &DynamicAABBTree3D::clear);
+    ClassDB::bind_method(D_METHOD("get_count"), &DynamicAABBTree3D::get_count);
+    ClassDB::bind_method(D_METHOD("get_box", "id"), &DynamicAABBTree3D::get_box);
+
+    // Query methods
+    ClassDB::bind_method(D_METHOD("query_box", "box"), &DynamicAABBTree3D::query_box);
+    ClassDB::bind_method(D_METHOD("query_point", "point"), &DynamicAABBTree3D::query_point);
+    ClassDB::bind_method(D_METHOD("query_ray", "origin", "direction", "max_distance"), &DynamicAABBTree3D::query_ray);
+    ClassDB::bind_method(D_METHOD("ray_first", "origin", "direction", "max_distance"), &DynamicAABBTree3D::ray_first);
+    ClassDB::bind_method(D_METHOD("ray_first_batch", "origins", "directions", "max_distances"), &DynamicAABBTree3D::ray_first_batch);
+    ClassDB::bind_method(D_METHOD("query_pairs"), &DynamicAABBTree3D::query_pairs);
+    ClassDB::bind_method(D_METHOD("query_pairs_with", "other"), &DynamicAABBTree3D::query_pairs_with);
+
+    // Debug
+    ClassDB::bind_method(D_METHOD("get_height"), &DynamicAABBTree3D::get_height);
+    ClassDB::bind_method(D_METHOD("get_node_bounds"), &DynamicAABBTree3D::get_node_bounds);
+}
+
+DynamicAABBTree3D::DynamicAABBTree3D() {
+}
+
+DynamicAABBTree3D::~DynamicAABBTree3D() {
+    clear();
+}
+
+AABBTreeCore<3>::Box DynamicAABBTree3D::to_box(const AABB& aabb) {
+    // Negative sizes are allowed; the box spans both corners
+    Vector3 end = aabb.position + aabb.size;
+    AABBTreeCore<3>::Box box;
+    for (int a = 0; a < 3; a++) {
+        box.lo[a] = static_cast<float>(std::min(aabb.position[a], end[a]));
+        box.hi[a] = static_cast<float>(std::max(aabb.position[a], end[a]));
+    }
+    return box;
+}
+
+static AABB to_aabb(const AABBTreeCore<3>::Box& box) {
+    return AABB(Vector3(box.lo[0], box.lo[1], box.lo[2]),
+                Vector3(box.hi[0] - box.lo[0], box.hi[1] - box.lo[1], box.hi[2] - box.lo[2]));
+}
+
+bool DynamicAABBTree3D::check_proxy(int32_t id) const {
+    if (!tree.is_proxy(id)) {
+        UtilityFunctions::push_error("AgentiteG: DynamicAABBTree3D proxy id is not valid");
+        return false;
+    }
+    return true;
+}
+
+void DynamicAABBTree3D::set_margin(float p_margin) {
+    margin = std::max(p_margin, 0.0f);
+}
+
+float DynamicAABBTree3D::get_margin() const {
+    return margin;
+}
+
+// ========== PROXIES ==========
+
+int32_t DynamicAABBTree3D::insert(const AABB& box) {
+    return tree.create(to_box(box), margin);
+}
+
+bool DynamicAABBTree3D::move(int32_t id, const AABB& box) {
+    if (!check_proxy(id)) {
+        return false;
+    }
+    return tree.move(id, to_box(box), margin);
+}
+
+void DynamicAABBTree3D::remove(int32_t id) {
+    if (!check_proxy(id)) {
+        return;
+    }
+    tree.destroy(id);
+}
+
+void DynamicAABBTree3D::clear() {
+    tree.clear();
+}
+
+int32_t DynamicAABBTree3D::get_count() const {
+    return tree.size();
+}
+
+AABB DynamicAABBTree3D::get_box(int32_t id) const {
+    if (!check_proxy(id)) {
+        return AABB();
+    }
+    return to_aabb(tree.tight_box(id));
+}
+
+// ========== QUERIES ==========
+
+void DynamicAABBTree3D::collect_box(const AABB& box, std::vector<int32_t>& out) const {
+    tree.query(to_box(box), [&](int32_t id) { out.push_back(id); });
+}
+
+PackedInt32Array DynamicAABBTree3D::query_box(const AABB& box) const {
+    AGENTITE_PROFILE("DynamicAABBTree3D.query_box", 1);
+    std::vector<int32_t> hits;
+    collect_box(box, hits);
+
+    PackedInt32Array result;
+    result.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+PackedInt32Array DynamicAABBTree3D::query_point(const Vector3& point) const {
+    return query_box(AABB(point, Vector3()));
+}
+
+PackedInt32Array DynamicAABBTree3D::query_ray(const Vector3& origin, const Vector3& direction, float max_distance) const {
+    AGENTITE_PROFILE("DynamicAABBTree3D.query_ray", 1);
+    PackedInt32Array result;
+
+    float len = direction.length();
+    if (len <= 0.0f) {
+        return result;
+    }
+
+    const float o[3] = {static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z)};
+    const float d[3] = {static_cast<float>(direction.x / len), static_cast<float>(direction.y / len),
+                        static_cast<float>(direction.z / len)};
+
+    std::vector<std::pair<float, int32_t>> hits;
+    tree.ray(o, d, max_distance, [&](int32_t id, float t) {
+        hits.emplace_back(t, id);
+        return max_distance;
+    });
+    std::sort(hits.begin(), hits.end());
+
+    result.resize(hits.size());
+    int32_t* dst = result.ptrw();
+    for (size_t i = 0; i < hits.size(); i++) {
+        dst[i] = hits[i].second;
+    }
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+int32_t DynamicAABBTree3D::first_hit(const float* origin, const float* direction, float max_distance, float& distance) const {
+    // Shrink the search to the nearest hit so far; ties go to the lower id
+    int32_t best_id = -1;
+    float best_t = max_distance;
+    tree.ray(origin, direction, max_distance, [&](int32_t id, float t) {
+        if (best_id == -1 || t < best_t || (t == best_t && id < best_id)) {
+            best_id = id;
+            best_t = t;
+        }
+        return best_t;
+    });
+    distance = best_id == -1 ? std::numeric_limits<float>::infinity() : best_t;
+    return best_id;
+}
+
+int32_t DynamicAABBTree3D::ray_first(const Vector3& origin, const Vector3& direction, float max_distance) const {
+    float len = direction.length();
+    if (len <= 0.0f) {
+        return -1;
+    }
+
+    const float o[3] = {static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z)};
+    const float d[3] = {static_cast<float>(direction.x / len), static_cast<float>(direction.y / len),
+                        static_cast<float>(direction.z / len)};
+
+    float distance;
+    return first_hit(o, d, max_distance, distance);
+}
+
+Array DynamicAABBTree3D::ray_first_batch(const PackedVector3Array& origins, const PackedVector3Array& directions,
+                                         const PackedFloat32Array& max_distances) const {
+    AGENTITE_PROFILE("DynamicAABBTree3D.ray_first_batch", origins.size());
+    Array result;
+    int32_t ray_count = origins.size();
+    if (directions.size() != ray_count || max_distances.size() != ray_count) {
+        UtilityFunctions::push_error("AgentiteG: origins, directions and max_distances arrays must have same size");
+        return result;
+    }
+
+    PackedInt32Array ids;
+    PackedFloat32Array distances;
+    ids.resize(ray_count);
+    distances.resize(ray_count);
+
+    const Vector3* origins_ptr = origins.ptr();
+    const Vector3* directions_ptr = directions.ptr();
+    const float* max_ptr = max_distances.ptr();
+    int32_t* ids_ptr = ids.ptrw();
+    float* distances_ptr = distances.ptrw();
+
+    // Rays are read-only and independent, so large batches run across worker threads
+    parallel::for_range(ray_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const Vector3& origin = origins_ptr[i];
+            const Vector3& direction = directions_ptr[i];
+            float len = direction.length();
+            if (len <= 0.0f) {
+                ids_ptr[i] = -1;
+                distances_ptr[i] = std::numeric_limits<float>::infinity();
+                continue;
+            }
+            const float o[3] = {static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z)};
+            const float d[3] = {static_cast<float>(direction.x / len), static_cast<float>(direction.y / len),
+                                static_cast<float>(direction.z / len)};
+            ids_ptr[i] = first_hit(o, d, max_ptr[i], distances_ptr[i]);
+        }
+    });
+
+    result.append(ids);
+    result.append(distances);
+    return result;
+}
+
+// ========== PAIRS ==========
+
+// Expand per-proxy partner lists to the flat [i0, j0, i1, j1, ...] format
+static PackedInt32Array flatten_pairs(const Ref<NeighborList>& partners) {
+    PackedInt32Array result;
+    PackedInt32Array offsets = partners->get_offsets();
+    PackedInt32Array js = partners->get_indices();
+    const int32_t* offsets_ptr = offsets.ptr();
+    const int32_t* js_ptr = js.ptr();
+    result.resize(js.size() * 2);
+    int32_t* out = result.ptrw();
+    for (int32_t i = 0; i + 1 < offsets.size(); i++) {
+        for (int32_t h = offsets_ptr[i]; h < offsets_ptr[i + 1]; h++) {
+            *out++ = i;
+            *out++ = js_ptr[h];
+        }
+    }
+    return result;
+}
+
+PackedInt32Array DynamicAABBTree3D::query_pairs() const {
+    AGENTITE_PROFILE("DynamicAABBTree3D.query_pairs", get_count());
+    Ref<NeighborList> partners;
+    partners.instantiate();
+    partners->fill(tree.capacity(), [&](int32_t i, std::vector<int32_t>& hits) {
+        if (!tree.is_proxy(i)) {
+            return;
+        }
+        size_t first = hits.size();
+        tree.query(tree.tight_box(i), [&](int32_t j) {
+            if (j > i) {
+                hits.push_back(j);
+            }
+        });
+        std::sort(hits.begin() + first, hits.end());
+    });
+    return flatten_pairs(partners);
+}
+
+PackedInt32Array DynamicAABBTree3D::query_pairs_with(const Ref<DynamicAABBTree3D>& other) const {
+    AGENTITE_PROFILE("DynamicAABBTree3D.query_pairs_with", get_count());
+    if (other.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: query_pairs_with needs another DynamicAABBTree3D");
+        return PackedInt32Array();
+    }
+
+    const AABBTreeCore<3>& other_tree = other->tree;
+    Ref<NeighborList> partners;
+    partners.instantiate();
+    partners->fill(tree.capacity(), [&](int32_t i, std::vector<int32_t>& hits) {
+        if (!tree.is_proxy(i)) {
+            return;
+        }
+        size_t first = hits.size();
+        other_tree.query(tree.tight_box(i), [&](int32_t j) { hits.push_back(j); });
+        std::sort(hits.begin() + first, hits.end());
+    });
+    return flatten_pairs(partners);
+}
+
+// ========== DEBUG ==========
+
+int32_t DynamicAABBTree3D::get_height() const {
+    return tree.height();
+}
+
+Array DynamicAABBTree3D::get_node_bounds() const {
+    Array bounds;
+    tree.for_each_node([&](const AABBTreeCore<3>::Box& box) {
+        bounds.push_back(to_aabb(box));
+    });
+    return bounds;
+}
+
+}
@@ -10,6 +10,10 @@
  * - Fast single nearest neighbor queries
  * - Scenarios where data doesn't change frequently (static builds)
  *
+ * Points are stored in a flat breadth-first layout with leaf buckets
+ * (see kd_tree_layout.hpp), so builds are O(n log n) and queries run
+ * iteratively with a fixed-size stack.
+ *
  * Usage:
  *   var kdtree = KDTree3D.new()
  *   kdtree.build(positions)  # PackedVector3Array
@@ -20,14 +24,18 @@
 #ifndef AGENTITE_KD_TREE_3D_HPP
 #define AGENTITE_KD_TREE_3D_HPP
 
+#include "neighbor_list.hpp"
+#include "kd_tree_layout.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 
 #include <vector>
-#include <queue>
 
 namespace godot {
 
@@ -35,35 +43,12 @@ class KDTree3D : public RefCounted {
     GDCLASS(KDTree3D, RefCounted)
 
 private:
-    // Node structure for the KD-Tree
-    struct Node {
-        int32_t point_index;  // Index into original points array
-        int32_t left;         // Index of left child (-1 if none)
-        int32_t right;        // Index of right child (-1 if none)
-        uint8_t axis;         // Split axis (0=x, 1=y, 2=z)
-    };
-
-    std::vector<Node> nodes;
-    PackedVector3Array stored_points;
-    int32_t root_index = -1;
-
-    // Build tree recursively, returns node index
-    int32_t build_recursive(std::vector<int32_t>& indices, int32_t start, int32_t end, int depth);
-
-    // Nearest neighbor search helpers
-    void nearest_one_recursive(int32_t node_idx, const Vector3& target,
-                                int32_t& best_idx, float& best_dist_sq) const;
+    // Implicit tree with coordinates stored inline, in tree order
+    KDTreeLayout<3> tree;
 
-    void nearest_k_recursive(int32_t node_idx, const Vector3& target, int32_t k,
-                              std::priority_queue<std::pair<float, int32_t>>& heap) const;
-
-    void radius_recursive(int32_t node_idx, const Vector3& target, float radius_sq,
-                           PackedInt32Array& results) const;
-
-    // Helper to get axis value from Vector3
-    inline float get_axis_value(const Vector3& v, uint8_t axis) const {
-        return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
-    }
+    // Append query results to out (shared by single and flat batch queries)
+    void collect_nearest(const Vector3& point, int32_t k, std::vector<int32_t>& out) const;
+    void collect_radius(const Vector3& point, float radius, std::vector<int32_t>& out) const;
 
 protected:
     static void _bind_methods();
@@ -82,6 +67,13 @@ public:
     // Get number of points in the tree
     int32_t size() const;
 
+    // Save the built tree as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the tree with a saved snapshot, without rebuilding
+    // Returns false (and keeps the current tree) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+
     // Query: find nearest single point to target
     // Returns index into original points array, or -1 if empty
     int32_t query_nearest_one(const Vector3& point) const;
@@ -95,12 +87,28 @@ public:
     PackedInt32Array query_radius(const Vector3& point, float radius) const;
 
     // Batch query: find nearest one for multiple query points
+    // Large batches are split across worker threads; result order matches points
     // Returns PackedInt32Array of indices, one per query point
     PackedInt32Array query_nearest_one_batch(const PackedVector3Array& points) const;
 
     // Batch query: find k nearest for multiple query points
     // Returns Array of PackedInt32Array, one per query point
     Array query_nearest_batch(const PackedVector3Array& points, int32_t k) const;
+
+    // Flat batch query: k nearest per point, stored CSR-style in a NeighborList
+    // Pass the same out list every frame to reuse its memory (a new list is created if null)
+    Ref<NeighborList> query_nearest_batch_flat(
+        const PackedVector3Array& points,
+        int32_t k,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
+
+    // Flat batch query: all points within a per-query radius
+    Ref<NeighborList> query_radius_batch_flat(
+        const PackedVector3Array& points,
+        const PackedFloat32Array& radii,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
 };
 
 }
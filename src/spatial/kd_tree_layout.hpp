@@ -0,0 +1,324 @@
+/**
+ * KDTreeLayout - Implicit, cache-friendly k-d tree shared by KDTree2D and KDTree3D
+ *
+ * Points are reordered so every node covers a contiguous range, and their
+ * coordinates are stored inline in that order (D floats per point). Nodes
+ * use breadth-first numbering: node i has children 2i + 1 and 2i + 2, and a
+ * node's range is split at its middle, so ranges follow from the tree shape
+ * and only the split plane is stored. Ranges of LEAF_SIZE points or fewer
+ * are leaf buckets, scanned linearly.
+ *
+ * Built with nth_element partitioning on the axis of largest spread
+ * (O(n log n)); large builds split the top subtrees across worker threads.
+ * Queries walk the tree iteratively with a fixed-size stack.
+ *
+ * Usage (internal):
+ *   KDTreeLayout<2> tree;
+ *   tree.build(xy, count);  // x0, y0, x1, y1, ...
+ *   int32_t nearest = tree.nearest_one(query_xy);
+ *
+ * save()/load() write the arrays as snapshot sections, so a loaded tree
+ * is ready to query without rebuilding.
+ */
+
+#ifndef AGENTITE_KD_TREE_LAYOUT_HPP
+#define AGENTITE_KD_TREE_LAYOUT_HPP
+
+#include "core/parallel.hpp"
+#include "core/snapshot.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace godot {
+
+template <int D>
+class KDTreeLayout {
+public:
+    // Points per leaf bucket
+    static constexpr int32_t LEAF_SIZE = 8;
+
+    // Build from count points of D floats each (replaces any previous tree)
+    void build(const float* points, int32_t point_count) {
+        clear();
+        if (point_count <= 0) return;
+        count = point_count;
+
+        int32_t levels = 0;
+        for (int32_t c = count; c > LEAF_SIZE; c = (c + 1) / 2) levels++;
+        splits.resize((static_cast<size_t>(1) << levels) - 1);
+
+        std::vector<int32_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+
+        // Split the top levels here, then build the subtrees below them in parallel
+        std::vector<Task> tasks;
+        int32_t parallel_depth = count >= PARALLEL_MIN_POINTS ? PARALLEL_DEPTH : 0;
+        build_node(points, order, 0, 0, count, parallel_depth, &tasks);
+        parallel::for_range(static_cast<int64_t>(tasks.size()), 1, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; i++) {
+                build_node(points, order, tasks[i].node, tasks[i].begin, tasks[i].end, 0, nullptr);
+            }
+        });
+
+        ids.swap(order);
+        coords.resize(static_cast<size_t>(count) * D);
+        for (int32_t i = 0; i < count; i++) {
+            for (int a = 0; a < D; a++) {
+                coords[static_cast<size_t>(i) * D + a] = points[static_cast<size_t>(ids[i]) * D + a];
+            }
+        }
+    }
+
+    void clear() {
+        coords.clear();
+        ids.clear();
+        splits.clear();
+        count = 0;
+    }
+
+    int32_t size() const { return count; }
+
+    // Write the tree's arrays to a snapshot
+    void save(snapshot::Writer& w) const {
+        w.add_value(TAG_COUNT, count);
+        w.add(TAG_COORDS, coords);
+        w.add(TAG_IDS, ids);
+        w.add(TAG_SPLITS, splits);
+    }
+
+    // Replace the tree with one read from a snapshot; unchanged on failure
+    bool load(const snapshot::Reader& r) {
+        int32_t n = 0;
+        std::vector<float> new_coords;
+        std::vector<int32_t> new_ids;
+        std::vector<Split> new_splits;
+        if (!r.read_value(TAG_COUNT, n) || !r.read(TAG_COORDS, new_coords) ||
+            !r.read(TAG_IDS, new_ids) || !r.read(TAG_SPLITS, new_splits)) {
+            return false;
+        }
+
+        int32_t levels = 0;
+        for (int32_t c = n; c > LEAF_SIZE; c = (c + 1) / 2) levels++;
+        size_t expected_splits = n > 0 ? (static_cast<size_t>(1) << levels) - 1 : 0;
+        if (n < 0 || new_coords.size() != static_cast<size_t>(n) * D ||
+            new_ids.size() != static_cast<size_t>(n) || new_splits.size() != expected_splits) {
+            return r.fail("tree arrays don't match the point count");
+        }
+        for (int32_t id : new_ids) {
+            if (id < 0 || id >= n) return r.fail("point index out of range");
+        }
+        for (const Split& s : new_splits) {
+            if (s.axis < 0 || s.axis >= D) return r.fail("split axis out of range");
+        }
+
+        coords.swap(new_coords);
+        ids.swap(new_ids);
+        splits.swap(new_splits);
+        count = n;
+        return true;
+    }
+
+    // Index of the point nearest q, or -1 if empty
+    int32_t nearest_one(const float* q) const {
+        int32_t best_id = -1;
+        float best_dist_sq = std::numeric_limits<float>::max();
+        if (count == 0) return best_id;
+
+        Entry stack[STACK_SIZE];
+        int32_t top = 0;
+        stack[top++] = {0, 0, count, 0.0f};
+        while (top > 0) {
+            Entry e = stack[--top];
+            // Ties resolve to the lowest index, so a node exactly at the best distance is still visited
+            if (e.bound > best_dist_sq) continue;
+            descend(q, e, stack, top);
+            for (int32_t i = e.begin; i < e.end; i++) {
+                float d = dist_sq(q, i);
+                if (d < best_dist_sq || (d == best_dist_sq && ids[i] < best_id)) {
+                    best_dist_sq = d;
+                    best_id = ids[i];
+                }
+            }
+        }
+        return best_id;
+    }
+
+    // Append the k points nearest q to out, nearest first
+    void nearest_k(const float* q, int32_t k, std::vector<int32_t>& out) const {
+        if (count == 0 || k <= 0) return;
+
+        // Max-heap of the best candidates so far, reused per thread
+        thread_local std::vector<std::pair<float, int32_t>> heap;
+        heap.clear();
+
+        if (k >= count) {
+            for (int32_t i = 0; i < count; i++) {
+                heap.emplace_back(dist_sq(q, i), ids[i]);
+            }
+        } else {
+            Entry stack[STACK_SIZE];
+            int32_t top = 0;
+            stack[top++] = {0, 0, count, 0.0f};
+            while (top > 0) {
+                Entry e = stack[--top];
+                if (static_cast<int32_t>(heap.size()) == k && e.bound > heap.front().first) continue;
+                descend(q, e, stack, top);
+                for (int32_t i = e.begin; i < e.end; i++) {
+                    std::pair<float, int32_t> candidate(dist_sq(q, i), ids[i]);
+                    if (static_cast<int32_t>(heap.size()) < k) {
+                        heap.push_back(candidate);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (candidate < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = candidate;
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+            }
+        }
+
+        std::sort(heap.begin(), heap.end());
+        for (const auto& item : heap) {
+            out.push_back(item.second);
+        }
+    }
+
+    // Append every point within sqrt(radius_sq) of q to out (unsorted)
+    void radius(const float* q, float radius_sq, std::vector<int32_t>& out) const {
+        if (count == 0) return;
+
+        Entry stack[STACK_SIZE];
+        int32_t top = 0;
+        stack[top++] = {0, 0, count, 0.0f};
+        while (top > 0) {
+            Entry e = stack[--top];
+            if (e.bound > radius_sq) continue;
+            descend(q, e, stack, top);
+            for (int32_t i = e.begin; i < e.end; i++) {
+                if (dist_sq(q, i) <= radius_sq) {
+                    out.push_back(ids[i]);
+                }
+            }
+        }
+    }
+
+private:
+    struct Split {
+        float value;   // Points left of the split are <= value, right are >= value
+        int32_t axis;
+    };
+
+    // Subtree waiting to be visited: its node, point range and a lower bound
+    // on its squared distance to the query
+    struct Entry {
+        int32_t node;
+        int32_t begin;
+        int32_t end;
+        float bound;
+    };
+
+    struct Task {
+        int32_t node;
+        int32_t begin;
+        int32_t end;
+    };
+
+    // Snapshot section tags
+    static constexpr uint32_t TAG_COUNT = 1;
+    static constexpr uint32_t TAG_COORDS = 2;
+    static constexpr uint32_t TAG_IDS = 3;
+    static constexpr uint32_t TAG_SPLITS = 4;
+
+    // Deeper than any tree of 2^31 points
+    static constexpr int32_t STACK_SIZE = 64;
+
+    // Builds of at least this many points split the top PARALLEL_DEPTH levels across threads
+    static constexpr int32_t PARALLEL_MIN_POINTS = 16384;
+    static constexpr int32_t PARALLEL_DEPTH = 4;
+
+    std::vector<float> coords;   // D floats per point, in tree order
+    std::vector<int32_t> ids;    // Original index of each point, in tree order
+    std::vector<Split> splits;   // One per inner node
+    int32_t count = 0;
+
+    float dist_sq(const float* q, int32_t i) const {
+        const float* p = coords.data() + static_cast<size_t>(i) * D;
+        float sum = 0.0f;
+        for (int a = 0; a < D; a++) {
+            float d = q[a] - p[a];
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    // Walk e down to the leaf on q's side, pushing each far child
+    void descend(const float* q, Entry& e, Entry* stack, int32_t& top) const {
+        while (e.end - e.begin > LEAF_SIZE) {
+            const Split& s = splits[e.node];
+            int32_t mid = e.begin + (e.end - e.begin) / 2;
+            int32_t left = 2 * e.node + 1;
+            float diff = q[s.axis] - s.value;
+            float far_bound = std::max(e.bound, diff * diff);
+            if (diff < 0.0f) {
+                stack[top++] = {left + 1, mid, e.end, far_bound};
+                e.node = left;
+                e.end = mid;
+            } else {
+                stack[top++] = {left, e.begin, mid, far_bound};
+                e.node = left + 1;
+                e.begin = mid;
+            }
+        }
+    }
+
+    // Partition order[begin, end) for node and its subtree. Subtrees at
+    // defer_depth levels below are queued in tasks instead of built.
+    void build_node(const float* points, std::vector<int32_t>& order, int32_t node, int32_t begin, int32_t end,
+                    int32_t defer_depth, std::vector<Task>* tasks) {
+        if (end - begin <= LEAF_SIZE) return;
+        if (tasks && defer_depth == 0) {
+            tasks->push_back({node, begin, end});
+            return;
+        }
+
+        // Split on the axis with the largest spread
+        float lo[D];
+        float hi[D];
+        for (int a = 0; a < D; a++) {
+            lo[a] = hi[a] = points[static_cast<size_t>(order[begin]) * D + a];
+        }
+        for (int32_t i = begin + 1; i < end; i++) {
+            const float* p = points + static_cast<size_t>(order[i]) * D;
+            for (int a = 0; a < D; a++) {
+                lo[a] = std::min(lo[a], p[a]);
+                hi[a] = std::max(hi[a], p[a]);
+            }
+        }
+        int32_t axis = 0;
+        for (int a = 1; a < D; a++) {
+            if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+        }
+
+        int32_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+            [points, axis](int32_t a, int32_t b) {
+                return points[static_cast<size_t>(a) * D + axis] < points[static_cast<size_t>(b) * D + axis];
+            });
+
+        // Subtrees touch disjoint nodes and ranges, so parallel builds never share writes
+        splits[node].value = points[static_cast<size_t>(order[mid]) * D + axis];
+        splits[node].axis = axis;
+
+        build_node(points, order, 2 * node + 1, begin, mid, defer_depth - 1, tasks);
+        build_node(points, order, 2 * node + 2, mid, end, defer_depth - 1, tasks);
+    }
+};
+
+}
+
+#endif // AGENTITE_KD_TREE_LAYOUT_HPP
@@ -0,0 +1,80 @@
+/**
+ * NeighborList Implementation
+ */
+
+#include "neighbor_list.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot {
+
+void NeighborList::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("get_indices"), &NeighborList::get_indices);
+    ClassDB::bind_method(D_METHOD("get_offsets"), &NeighborList::get_offsets);
+    ClassDB::bind_method(D_METHOD("get_query_count"), &NeighborList::get_query_count);
+    ClassDB::bind_method(D_METHOD("get_total_count"), &NeighborList::get_total_count);
+    ClassDB::bind_method(D_METHOD("get_neighbor_count", "query"), &NeighborList::get_neighbor_count);
+    ClassDB::bind_method(D_METHOD("get_neighbors", "query"), &NeighborList::get_neighbors);
+    ClassDB::bind_method(D_METHOD("clear"), &NeighborList::clear);
+}
+
+NeighborList::NeighborList() {
+    offsets.push_back(0);
+}
+
+NeighborList::~NeighborList() {
+}
+
+PackedInt32Array NeighborList::get_indices() const {
+    return indices;
+}
+
+PackedInt32Array NeighborList::get_offsets() const {
+    return offsets;
+}
+
+int32_t NeighborList::get_query_count() const {
+    return static_cast<int32_t>(offsets.size()) - 1;
+}
+
+int32_t NeighborList::get_total_count() const {
+    return static_cast<int32_t>(indices.size());
+}
+
+int32_t NeighborList::get_neighbor_count(int32_t query) const {
+    if (query < 0 || query >= get_query_count()) {
+        UtilityFunctions::push_error("AgentiteG: NeighborList query index out of range");
+        return 0;
+    }
+    const int32_t* offsets_ptr = offsets.ptr();
+    return offsets_ptr[query + 1] - offsets_ptr[query];
+}
+
+PackedInt32Array NeighborList::get_neighbors(int32_t query) const {
+    PackedInt32Array result;
+
+    if (query < 0 || query >= get_query_count()) {
+        UtilityFunctions::push_error("AgentiteG: NeighborList query index out of range");
+        return result;
+    }
+
+    const int32_t* offsets_ptr = offsets.ptr();
+    int32_t begin = offsets_ptr[query];
+    int32_t count = offsets_ptr[query + 1] - begin;
+
+    result.resize(count);
+    if (count > 0) {
+        std::memcpy(result.ptrw(), indices.ptr() + begin, count * sizeof(int32_t));
+    }
+
+    return result;
+}
+
+void NeighborList::clear() {
+    indices.resize(0);
+    offsets.resize(1);
+    offsets.set(0, 0);
+}
+
+}
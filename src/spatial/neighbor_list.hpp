@@ -0,0 +1,133 @@
+/**
+ * NeighborList - Flat (CSR) result storage for batch neighbor queries
+ *
+ * Holds the results of many neighbor queries in two packed arrays instead of
+ * an Array of PackedInt32Array. The neighbors of query i are
+ * indices[offsets[i]] .. indices[offsets[i + 1] - 1], and offsets has
+ * query_count + 1 entries.
+ *
+ * Passing the same NeighborList to a *_batch_flat query every frame reuses
+ * its memory, so a warmed-up list performs no per-query allocations.
+ *
+ * Usage:
+ *   var neighbors = NeighborList.new()
+ *   spatial.query_radius_batch_uniform_flat(positions, 50.0, neighbors)
+ *   var indices = neighbors.get_indices()
+ *   var offsets = neighbors.get_offsets()
+ *   for i in range(positions.size()):
+ *       for j in range(offsets[i], offsets[i + 1]):
+ *           var neighbor = indices[j]
+ */
+
+#ifndef AGENTITE_NEIGHBOR_LIST_HPP
+#define AGENTITE_NEIGHBOR_LIST_HPP
+
+#include "core/parallel.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace godot {
+
+class NeighborList : public RefCounted {
+    GDCLASS(NeighborList, RefCounted)
+
+private:
+    PackedInt32Array indices;
+    PackedInt32Array offsets;
+
+    // Per-block scratch kept between fills so reuse does not allocate
+    std::vector<std::vector<int32_t>> block_hits;
+
+protected:
+    static void _bind_methods();
+
+public:
+    NeighborList();
+    ~NeighborList();
+
+    // Flat neighbor indices for all queries, in query order
+    PackedInt32Array get_indices() const;
+
+    // Start of each query's neighbors in indices (query_count + 1 entries)
+    PackedInt32Array get_offsets() const;
+
+    // Number of queries stored
+    int32_t get_query_count() const;
+
+    // Total number of neighbor entries across all queries
+    int32_t get_total_count() const;
+
+    // Number of neighbors of one query
+    int32_t get_neighbor_count(int32_t query) const;
+
+    // Neighbors of one query (copies a slice, prefer indices + offsets in hot loops)
+    PackedInt32Array get_neighbors(int32_t query) const;
+
+    // Remove all results (keeps allocated memory)
+    void clear();
+
+    // C++ API: run collect(query, hits) for every query, appending that query's
+    // neighbors to hits, then store the results in query order.
+    // Queries run across worker threads in blocks of parallel::QUERY_CHUNK.
+    template <typename Collect>
+    void fill(int32_t query_count, const Collect& collect);
+};
+
+template <typename Collect>
+void NeighborList::fill(int32_t query_count, const Collect& collect) {
+    query_count = std::max(query_count, 0);
+    const int64_t block_size = parallel::QUERY_CHUNK;
+    int64_t block_count = (query_count + block_size - 1) / block_size;
+
+    if (static_cast<int64_t>(block_hits.size()) < block_count) {
+        block_hits.resize(block_count);
+    }
+    offsets.resize(query_count + 1);
+    int32_t* offsets_ptr = offsets.ptrw();
+
+    // Pass 1: run the queries, recording offsets local to each block
+    parallel::for_range(block_count, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+            std::vector<int32_t>& hits = block_hits[b];
+            hits.clear();
+            int64_t query_end = std::min<int64_t>(query_count, (b + 1) * block_size);
+            for (int64_t q = b * block_size; q < query_end; q++) {
+                offsets_ptr[q] = static_cast<int32_t>(hits.size());
+                collect(static_cast<int32_t>(q), hits);
+            }
+        }
+    });
+
+    // Block base offsets
+    std::vector<int64_t> block_base(block_count + 1, 0);
+    for (int64_t b = 0; b < block_count; b++) {
+        block_base[b + 1] = block_base[b] + static_cast<int64_t>(block_hits[b].size());
+    }
+    int64_t total = block_base[block_count];
+
+    // Pass 2: concatenate blocks and make offsets global
+    indices.resize(total);
+    int32_t* indices_ptr = indices.ptrw();
+    parallel::for_range(block_count, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+            const std::vector<int32_t>& hits = block_hits[b];
+            if (!hits.empty()) {
+                std::memcpy(indices_ptr + block_base[b], hits.data(), hits.size() * sizeof(int32_t));
+            }
+            int64_t query_end = std::min<int64_t>(query_count, (b + 1) * block_size);
+            for (int64_t q = b * block_size; q < query_end; q++) {
+                offsets_ptr[q] += static_cast<int32_t>(block_base[b]);
+            }
+        }
+    });
+    offsets_ptr[query_count] = static_cast<int32_t>(total);
+}
+
+}
+
+#endif // AGENTITE_NEIGHBOR_LIST_HPP
@@ -10,6 +10,11 @@
  * - Frustum culling
  * - Level-of-detail systems
  *
+ * Uses the same flat layout as QuadTree: nodes in one contiguous array
+ * (children are eight consecutive entries), points in one pooled buffer
+ * linked per leaf, and a Z-order (Morton order) bulk build.
+ * Points can be moved or removed incrementally, as in QuadTree.
+ *
  * Usage:
  *   var octree = Octree.new()
  *   octree.set_bounds(AABB(Vector3.ZERO, Vector3(1000, 1000, 1000)))
@@ -22,13 +27,14 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/variant/aabb.hpp>
 #include <godot_cpp/variant/array.hpp>
 
+#include <cstdint>
 #include <vector>
-#include <memory>
 
 namespace godot {
 
@@ -38,33 +44,61 @@ class Octree : public RefCounted {
 private:
     struct Node {
         AABB bounds;
-        std::vector<int32_t> point_indices;  // Points stored at this node
-        std::unique_ptr<Node> children[8];   // 8 octants
-        bool is_leaf = true;
+        int32_t first_child = -1;  // Children are 8 consecutive nodes (octants 0-7), -1 for a leaf
+        int32_t first_item = -1;   // Leaf points, linked through Item::next
+        int32_t last_item = -1;
+        int32_t count = 0;
+        int32_t parent;            // -1 for the root
+
+        Node() : parent(-1) {}
+        Node(const AABB& b, int32_t p) : bounds(b), parent(p) {}
+    };
 
-        Node(const AABB& b) : bounds(b) {}
+    struct Item {
+        Vector3 position;
+        int32_t index;
+        int32_t next;
+        int32_t prev;
+        int32_t node;  // Owning leaf
     };
 
-    std::unique_ptr<Node> root;
-    PackedVector3Array stored_points;
+    std::vector<Node> nodes;          // nodes[0] is the root
+    std::vector<Item> items;          // Pooled storage for every leaf's points
+    std::vector<int32_t> item_slot;   // Pooled item of each index
+    std::vector<int32_t> free_items;  // Unused pooled items
+    std::vector<int32_t> free_blocks; // First node of each child block freed by merging
     AABB tree_bounds;
     int32_t max_depth = 8;
     int32_t max_items_per_node = 8;
-    int32_t item_count = 0;
+    int32_t item_count = 0;           // Indices handed out, including removed ones
+    int32_t removed_count = 0;
+
+    // Pooled item storage
+    int32_t alloc_item(const Vector3& position, int32_t index);
+    void append_item(int32_t node, int32_t item);
+    void unlink_item(int32_t item);
+
+    // Insert a pooled item below node, subdividing leaves that overflow.
+    // Returns false if the point falls outside the tree.
+    bool insert_item(int32_t node, int32_t item, int depth);
+
+    // Store index at position (skipped if outside the tree bounds)
+    void store_item(int32_t index, const Vector3& position);
+
+    // Move index to position. Returns the leaf it left, or -1 if it stayed put.
+    int32_t move_item(int32_t index, const Vector3& position);
 
-    // Insert point into a node recursively
-    void insert_into_node(Node* node, int32_t point_index, int depth);
+    // Merge the ancestors of node that have become nearly empty
+    void collapse_from(int32_t node);
 
-    // Subdivide a node into 8 children
-    void subdivide(Node* node, int depth);
+    // Create node's 8 children, returning the index of the first
+    int32_t split(int32_t node);
 
-    // Query helpers
-    void query_box_recursive(const Node* node, const AABB& box, PackedInt32Array& results) const;
-    void query_radius_recursive(const Node* node, const Vector3& center, float radius_sq,
-                                 PackedInt32Array& results) const;
+    // Subdivide a leaf into 8 children
+    void subdivide(int32_t node, int depth);
 
-    // Get all node bounds for visualization
-    void collect_node_bounds(const Node* node, Array& bounds) const;
+    // Bulk build: partition ids[0, count) into the subtree of node. scratch has room for count ids.
+    void build_node(int32_t node, int32_t* ids, int32_t count, int32_t* scratch, int depth, const Vector3* points);
 
     // Get octant index for a point (0-7)
     int get_octant(const AABB& bounds, const Vector3& point) const;
@@ -93,12 +127,29 @@ public:
     // Insert a single point (returns the index assigned)
     int32_t insert(const Vector3& position);
 
+    // Move a point. Only touches its old and new leaf; points that stay
+    // inside their leaf are updated in place.
+    void update(int32_t index, const Vector3& new_position);
+
+    // Move many points, merging emptied nodes once at the end
+    void update_many(const PackedInt32Array& indices, const PackedVector3Array& new_positions);
+
+    // Remove a point (its index is not reused)
+    void remove(int32_t index);
+
     // Clear all data
     void clear();
 
     // Get number of points in the tree
     int32_t size() const;
 
+    // Save the tree, including moved and removed points, as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the tree with a saved snapshot, without rebuilding
+    // Returns false (and keeps the current tree) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+
     // Query: find all points within an AABB
     // Returns PackedInt32Array of indices
     PackedInt32Array query_box(const AABB& box) const;
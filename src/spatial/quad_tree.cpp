@@ -3,14 +3,49 @@
  */
 
 #include "quad_tree.hpp"
+#include "core/profiling.hpp"
+#include "core/snapshot.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace godot {
 
+// Pending nodes in an iterative walk. max_depth <= 16, so at most 3 * 16 + 4
+// nodes are ever waiting.
+static const int32_t QUERY_STACK_SIZE = 64;
+
+// item_slot values for indices without a pooled item
+static const int32_t NOT_STORED = -1;  // Outside the tree bounds
+static const int32_t REMOVED = -2;
+
+// Node::parent of a child block waiting in free_blocks
+static const int32_t FREED_NODE = -2;
+
+// Snapshot layout (bump SNAPSHOT_VERSION when it changes)
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotTag : uint32_t {
+    TAG_INFO = 1,
+    TAG_NODES = 2,
+    TAG_ITEMS = 3,
+    TAG_ITEM_SLOT = 4,
+    TAG_FREE_ITEMS = 5,
+    TAG_FREE_BLOCKS = 6,
+};
+
+struct SnapshotInfo {
+    Rect2 bounds;
+    int32_t max_depth;
+    int32_t max_items_per_node;
+    int32_t item_count;
+    int32_t removed_count;
+};
+
 void QuadTree::_bind_methods() {
     // Configuration
     ClassDB::bind_method(D_METHOD("set_bounds", "bounds"), &QuadTree::set_bounds);
@@ -28,8 +63,13 @@ void QuadTree::_bind_methods() {
     // Core methods
     ClassDB::bind_method(D_METHOD("build", "positions"), &QuadTree::build);
     ClassDB::bind_method(D_METHOD("insert", "position"), &QuadTree::insert);
+    ClassDB::bind_method(D_METHOD("update", "index", "new_position"), &QuadTree::update);
+    ClassDB::bind_method(D_METHOD("update_many", "indices", "new_positions"), &QuadTree::update_many);
+    ClassDB::bind_method(D_METHOD("remove", "index"), &QuadTree::remove);
     ClassDB::bind_method(D_METHOD("clear"), &QuadTree::clear);
     ClassDB::bind_method(D_METHOD("size"), &QuadTree::size);
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &QuadTree::save_snapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "data"), &QuadTree::load_snapshot);
 
     // Query methods
     ClassDB::bind_method(D_METHOD("query_rect", "rect"), &QuadTree::query_rect);
@@ -78,6 +118,7 @@ int32_t QuadTree::get_max_items_per_node() const {
 }
 
 void QuadTree::build(const PackedVector2Array& positions) {
+    AGENTITE_PROFILE("QuadTree.build", positions.size());
     clear();
 
     int32_t n = positions.size();
@@ -85,11 +126,10 @@ void QuadTree::build(const PackedVector2Array& positions) {
         return;
     }
 
-    stored_points = positions;
+    const Vector2* pos_ptr = positions.ptr();
 
     // Auto-detect bounds if default
     if (tree_bounds.size.x <= 0 || tree_bounds.size.y <= 0) {
-        const Vector2* pos_ptr = positions.ptr();
         Vector2 min_p = pos_ptr[0];
         Vector2 max_p = pos_ptr[0];
 
@@ -106,78 +146,322 @@ void QuadTree::build(const PackedVector2Array& positions) {
     }
 
     // Create root node
-    root = std::make_unique<Node>(tree_bounds);
+    nodes.emplace_back(tree_bounds, -1);
 
-    // Insert all points
+    // Partition all points top-down. Each partition is stable, so leaves see
+    // their points in index order and the tree matches one built by inserting
+    // them one at a time.
+    std::vector<int32_t> ids(n);
+    std::vector<int32_t> scratch(n);
     for (int32_t i = 0; i < n; i++) {
-        insert_into_node(root.get(), i, 0);
+        ids[i] = i;
     }
+    items.reserve(n);
+    item_slot.assign(n, NOT_STORED);
+    build_node(0, ids.data(), n, scratch.data(), 0, pos_ptr);
 
     item_count = n;
 }
 
+void QuadTree::build_node(int32_t node, int32_t* ids, int32_t count, int32_t* scratch, int depth,
+                          const Vector2* points) {
+    const Rect2 bounds = nodes[node].bounds;
+
+    // Drop points outside this node (as insertion does)
+    int32_t kept = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (bounds.has_point(points[ids[i]])) {
+            ids[kept++] = ids[i];
+        }
+    }
+
+    if (kept <= max_items_per_node || depth >= max_depth) {
+        for (int32_t i = 0; i < kept; i++) {
+            item_slot[ids[i]] = static_cast<int32_t>(items.size());
+            items.push_back({points[ids[i]], ids[i], -1, -1, -1});
+            append_item(node, item_slot[ids[i]]);
+        }
+        return;
+    }
+
+    // Counting sort by quadrant into scratch, then recurse with the buffers swapped
+    int32_t offsets[5] = {0, 0, 0, 0, 0};
+    for (int32_t i = 0; i < kept; i++) {
+        offsets[get_quadrant(bounds, points[ids[i]]) + 1]++;
+    }
+    for (int q = 0; q < 4; q++) {
+        offsets[q + 1] += offsets[q];
+    }
+    int32_t cursor[4] = {offsets[0], offsets[1], offsets[2], offsets[3]};
+    for (int32_t i = 0; i < kept; i++) {
+        scratch[cursor[get_quadrant(bounds, points[ids[i]])]++] = ids[i];
+    }
+
+    int32_t first = split(node);
+    for (int q = 0; q < 4; q++) {
+        build_node(first + q, scratch + offsets[q], offsets[q + 1] - offsets[q], ids + offsets[q], depth + 1, points);
+    }
+}
+
 int32_t QuadTree::insert(const Vector2& position) {
     // Create root if needed
-    if (!root) {
-        root = std::make_unique<Node>(tree_bounds);
+    if (nodes.empty()) {
+        nodes.emplace_back(tree_bounds, -1);
     }
 
-    int32_t index = stored_points.size();
-    stored_points.push_back(position);
-    insert_into_node(root.get(), index, 0);
+    int32_t index = item_count;
     item_count++;
+    item_slot.push_back(NOT_STORED);
+    store_item(index, position);
 
     return index;
 }
 
-void QuadTree::insert_into_node(Node* node, int32_t point_index, int depth) {
-    const Vector2& point = stored_points[point_index];
+void QuadTree::update(int32_t index, const Vector2& new_position) {
+    if (index < 0 || index >= item_count || item_slot[index] == REMOVED) {
+        return;
+    }
 
-    // If point is outside bounds, skip (shouldn't happen normally)
-    if (!node->bounds.has_point(point)) {
+    int32_t left = move_item(index, new_position);
+    if (left != -1) {
+        collapse_from(left);
+    }
+}
+
+void QuadTree::update_many(const PackedInt32Array& indices, const PackedVector2Array& new_positions) {
+    AGENTITE_PROFILE("QuadTree.update_many", indices.size());
+    if (indices.size() != new_positions.size()) {
+        UtilityFunctions::push_error("AgentiteG: indices and positions arrays must have same size");
         return;
     }
 
-    // If this is a leaf node
-    if (node->is_leaf) {
-        node->point_indices.push_back(point_index);
+    const int32_t* idx_ptr = indices.ptr();
+    const Vector2* pos_ptr = new_positions.ptr();
 
-        // Check if we need to subdivide
-        if (static_cast<int32_t>(node->point_indices.size()) > max_items_per_node && depth < max_depth) {
-            subdivide(node, depth);
+    // Move everything first, then merge the leaves that lost points
+    std::vector<int32_t> left_leaves;
+    for (int32_t i = 0; i < indices.size(); i++) {
+        int32_t index = idx_ptr[i];
+        if (index < 0 || index >= item_count || item_slot[index] == REMOVED) {
+            continue;
         }
+        int32_t left = move_item(index, pos_ptr[i]);
+        if (left != -1) {
+            left_leaves.push_back(left);
+        }
+    }
+
+    for (int32_t leaf : left_leaves) {
+        collapse_from(leaf);
+    }
+}
+
+void QuadTree::remove(int32_t index) {
+    if (index < 0 || index >= item_count || item_slot[index] == REMOVED) {
+        return;
+    }
+
+    int32_t slot = item_slot[index];
+    item_slot[index] = REMOVED;
+    removed_count++;
+
+    if (slot >= 0) {
+        int32_t leaf = items[slot].node;
+        unlink_item(slot);
+        free_items.push_back(slot);
+        collapse_from(leaf);
+    }
+}
+
+int32_t QuadTree::alloc_item(const Vector2& position, int32_t index) {
+    Item item = {position, index, -1, -1, -1};
+    if (!free_items.empty()) {
+        int32_t slot = free_items.back();
+        free_items.pop_back();
+        items[slot] = item;
+        return slot;
+    }
+    items.push_back(item);
+    return static_cast<int32_t>(items.size()) - 1;
+}
+
+void QuadTree::store_item(int32_t index, const Vector2& position) {
+    // Points outside the tree are counted but not stored
+    if (!nodes[0].bounds.has_point(position)) {
+        return;
+    }
+
+    int32_t slot = alloc_item(position, index);
+    item_slot[index] = slot;
+    if (!insert_item(0, slot, 0)) {
+        item_slot[index] = NOT_STORED;
+        free_items.push_back(slot);
+    }
+}
+
+int32_t QuadTree::move_item(int32_t index, const Vector2& position) {
+    int32_t slot = item_slot[index];
+    if (slot < 0) {
+        store_item(index, position);
+        return -1;
+    }
+
+    // Still inside its leaf: nothing to relink
+    int32_t leaf = items[slot].node;
+    if (nodes[leaf].bounds.has_point(position)) {
+        items[slot].position = position;
+        return -1;
+    }
+
+    unlink_item(slot);
+    free_items.push_back(slot);
+    item_slot[index] = NOT_STORED;
+    store_item(index, position);
+    return leaf;
+}
+
+void QuadTree::append_item(int32_t node, int32_t item) {
+    Node& n = nodes[node];
+    items[item].next = -1;
+    items[item].prev = n.last_item;
+    items[item].node = node;
+    if (n.last_item == -1) {
+        n.first_item = item;
+    } else {
+        items[n.last_item].next = item;
+    }
+    n.last_item = item;
+    n.count++;
+}
+
+void QuadTree::unlink_item(int32_t item) {
+    const Item& it = items[item];
+    Node& n = nodes[it.node];
+    if (it.prev == -1) {
+        n.first_item = it.next;
     } else {
+        items[it.prev].next = it.next;
+    }
+    if (it.next == -1) {
+        n.last_item = it.prev;
+    } else {
+        items[it.next].prev = it.prev;
+    }
+    n.count--;
+}
+
+bool QuadTree::insert_item(int32_t node, int32_t item, int depth) {
+    const Vector2 point = items[item].position;
+
+    while (true) {
+        // If point is outside bounds, skip (shouldn't happen normally)
+        if (!nodes[node].bounds.has_point(point)) {
+            return false;
+        }
+
+        // If this is a leaf node
+        if (nodes[node].first_child == -1) {
+            append_item(node, item);
+
+            // Check if we need to subdivide
+            if (nodes[node].count > max_items_per_node && depth < max_depth) {
+                subdivide(node, depth);
+            }
+            return true;
+        }
+
         // Route to appropriate child
-        int quadrant = get_quadrant(node->bounds, point);
-        if (node->children[quadrant]) {
-            insert_into_node(node->children[quadrant].get(), point_index, depth + 1);
+        node = nodes[node].first_child + get_quadrant(nodes[node].bounds, point);
+        depth++;
+    }
+}
+
+void QuadTree::collapse_from(int32_t node) {
+    if (nodes[node].parent == FREED_NODE) {
+        return;
+    }
+
+    // Merge upward while a parent's children are all leaves holding few points.
+    // Merging at half capacity (not at the split threshold) keeps a point
+    // moving back and forth across a boundary from splitting and merging
+    // every frame.
+    for (int32_t parent = nodes[node].parent; parent != -1; parent = nodes[parent].parent) {
+        int32_t first = nodes[parent].first_child;
+        int32_t total = 0;
+        for (int c = 0; c < 4; c++) {
+            if (nodes[first + c].first_child != -1) {
+                return;
+            }
+            total += nodes[first + c].count;
+        }
+        if (total > max_items_per_node / 2) {
+            return;
         }
+
+        nodes[parent].first_child = -1;
+        for (int c = 0; c < 4; c++) {
+            int32_t item = nodes[first + c].first_item;
+            while (item != -1) {
+                int32_t next = items[item].next;
+                append_item(parent, item);
+                item = next;
+            }
+            nodes[first + c].parent = FREED_NODE;
+        }
+        free_blocks.push_back(first);
     }
 }
 
-void QuadTree::subdivide(Node* node, int depth) {
-    const Rect2& b = node->bounds;
+int32_t QuadTree::split(int32_t node) {
+    // Copy: adding children may reallocate the node array
+    const Rect2 b = nodes[node].bounds;
     Vector2 center = b.position + b.size * 0.5f;
     Vector2 half_size = b.size * 0.5f;
 
-    // Create children: NW, NE, SW, SE
-    node->children[0] = std::make_unique<Node>(Rect2(b.position, half_size));  // NW
-    node->children[1] = std::make_unique<Node>(Rect2(Vector2(center.x, b.position.y), half_size));  // NE
-    node->children[2] = std::make_unique<Node>(Rect2(Vector2(b.position.x, center.y), half_size));  // SW
-    node->children[3] = std::make_unique<Node>(Rect2(center, half_size));  // SE
+    // Children: NW, NE, SW, SE
+    const Rect2 child_bounds[4] = {
+        Rect2(b.position, half_size),                        // NW
+        Rect2(Vector2(center.x, b.position.y), half_size),   // NE
+        Rect2(Vector2(b.position.x, center.y), half_size),   // SW
+        Rect2(center, half_size),                            // SE
+    };
+
+    // Reuse a block freed by merging before growing the array
+    int32_t first;
+    if (!free_blocks.empty()) {
+        first = free_blocks.back();
+        free_blocks.pop_back();
+        for (int c = 0; c < 4; c++) {
+            nodes[first + c] = Node(child_bounds[c], node);
+        }
+    } else {
+        first = static_cast<int32_t>(nodes.size());
+        for (int c = 0; c < 4; c++) {
+            nodes.emplace_back(child_bounds[c], node);
+        }
+    }
 
-    node->is_leaf = false;
+    nodes[node].first_child = first;
+    return first;
+}
 
-    // Re-insert all points from this node into children
-    for (int32_t idx : node->point_indices) {
-        const Vector2& point = stored_points[idx];
-        int quadrant = get_quadrant(b, point);
-        insert_into_node(node->children[quadrant].get(), idx, depth + 1);
+void QuadTree::subdivide(int32_t node, int depth) {
+    // Detach this leaf's points, then re-insert them into the children in order
+    int32_t item = nodes[node].first_item;
+    nodes[node].first_item = -1;
+    nodes[node].last_item = -1;
+    nodes[node].count = 0;
+
+    int32_t first = split(node);
+    const Rect2 b = nodes[node].bounds;
+    while (item != -1) {
+        int32_t next = items[item].next;
+        if (!insert_item(first + get_quadrant(b, items[item].position), item, depth + 1)) {
+            item_slot[items[item].index] = NOT_STORED;
+            free_items.push_back(item);
+        }
+        item = next;
     }
-
-    // Clear points from this node (they're now in children)
-    node->point_indices.clear();
-    node->point_indices.shrink_to_fit();
 }
 
 int QuadTree::get_quadrant(const Rect2& bounds, const Vector2& point) const {
@@ -195,109 +479,272 @@ int QuadTree::get_quadrant(const Rect2& bounds, const Vector2& point) const {
 }
 
 void QuadTree::clear() {
-    root.reset();
-    stored_points.resize(0);
+    // Keeps capacity so the next build reuses the buffers
+    nodes.clear();
+    items.clear();
+    item_slot.clear();
+    free_items.clear();
+    free_blocks.clear();
     item_count = 0;
+    removed_count = 0;
 }
 
 int32_t QuadTree::size() const {
-    return item_count;
+    return item_count - removed_count;
+}
+
+PackedByteArray QuadTree::save_snapshot() const {
+    SnapshotInfo info;
+    info.bounds = tree_bounds;
+    info.max_depth = max_depth;
+    info.max_items_per_node = max_items_per_node;
+    info.item_count = item_count;
+    info.removed_count = removed_count;
+
+    snapshot::Writer w(snapshot::KIND_QUAD_TREE, SNAPSHOT_VERSION);
+    w.add_value(TAG_INFO, info);
+    w.add(TAG_NODES, nodes);
+    w.add(TAG_ITEMS, items);
+    w.add(TAG_ITEM_SLOT, item_slot);
+    w.add(TAG_FREE_ITEMS, free_items);
+    w.add(TAG_FREE_BLOCKS, free_blocks);
+    return w.finish();
+}
+
+bool QuadTree::load_snapshot(const PackedByteArray& data) {
+    snapshot::Reader r;
+    if (!r.open(data, snapshot::KIND_QUAD_TREE, SNAPSHOT_VERSION, "QuadTree")) {
+        return false;
+    }
+
+    SnapshotInfo info;
+    std::vector<Node> new_nodes;
+    std::vector<Item> new_items;
+    std::vector<int32_t> new_slot;
+    std::vector<int32_t> new_free_items;
+    std::vector<int32_t> new_free_blocks;
+    if (!r.read_value(TAG_INFO, info) || !r.read(TAG_NODES, new_nodes) || !r.read(TAG_ITEMS, new_items) ||
+        !r.read(TAG_ITEM_SLOT, new_slot) || !r.read(TAG_FREE_ITEMS, new_free_items) ||
+        !r.read(TAG_FREE_BLOCKS, new_free_blocks)) {
+        return false;
+    }
+
+    // Check every link so queries on the loaded tree can't index out of bounds
+    int32_t node_count = static_cast<int32_t>(new_nodes.size());
+    int32_t pool_size = static_cast<int32_t>(new_items.size());
+    auto item_ok = [pool_size](int32_t i) { return i >= -1 && i < pool_size; };
+    auto block_ok = [node_count](int32_t first) { return first > 0 && first <= node_count - 4; };
+    if (info.max_depth <= 0 || info.max_depth > 16 || info.max_items_per_node <= 0 ||
+        info.item_count < 0 || info.removed_count < 0 || info.removed_count > info.item_count ||
+        static_cast<int32_t>(new_slot.size()) != info.item_count || (node_count == 0 && pool_size > 0)) {
+        return r.fail("tree settings are invalid");
+    }
+    for (const Node& n : new_nodes) {
+        if ((n.first_child != -1 && !block_ok(n.first_child)) || !item_ok(n.first_item) || !item_ok(n.last_item) ||
+            n.parent < FREED_NODE || n.parent >= node_count) {
+            return r.fail("node links are out of range");
+        }
+    }
+    for (const Item& it : new_items) {
+        if (!item_ok(it.next) || !item_ok(it.prev) || it.node < -1 || it.node >= node_count ||
+            it.index < 0 || it.index >= info.item_count) {
+            return r.fail("point links are out of range");
+        }
+    }
+    for (int32_t slot : new_slot) {
+        if (slot < REMOVED || slot >= pool_size) return r.fail("point slots are out of range");
+    }
+    for (int32_t slot : new_free_items) {
+        if (slot < 0 || slot >= pool_size) return r.fail("free list is out of range");
+    }
+    for (int32_t first : new_free_blocks) {
+        if (!block_ok(first)) return r.fail("free list is out of range");
+    }
+
+    // Walk the tree from the root: each child block and pooled point must be
+    // reached once, no deeper than 16 levels (the bound QUERY_STACK_SIZE
+    // relies on), with back links that agree, so every walk terminates
+    std::vector<uint8_t> node_used(node_count, 0);
+    std::vector<uint8_t> item_used(pool_size, 0);
+    std::vector<std::pair<int32_t, int32_t>> walk;  // Node, depth
+    if (node_count > 0) {
+        if (new_nodes[0].parent != -1) return r.fail("tree structure is invalid");
+        node_used[0] = 1;
+        walk.push_back({0, 0});
+    }
+    while (!walk.empty()) {
+        int32_t node = walk.back().first;
+        int32_t depth = walk.back().second;
+        walk.pop_back();
+        const Node& n = new_nodes[node];
+        if (n.first_child != -1) {
+            if (depth >= 16 || n.first_item != -1 || n.last_item != -1 || n.count != 0) {
+                return r.fail("tree structure is invalid");
+            }
+            for (int c = 0; c < 4; c++) {
+                int32_t child = n.first_child + c;
+                if (node_used[child] || new_nodes[child].parent != node) return r.fail("tree structure is invalid");
+                node_used[child] = 1;
+                walk.push_back({child, depth + 1});
+            }
+            continue;
+        }
+        int32_t prev = -1;
+        int32_t length = 0;
+        for (int32_t it = n.first_item; it != -1; it = new_items[it].next) {
+            const Item& item = new_items[it];
+            if (item_used[it] || item.node != node || item.prev != prev || new_slot[item.index] != it) {
+                return r.fail("point lists are invalid");
+            }
+            item_used[it] = 1;
+            prev = it;
+            length++;
+        }
+        if (n.last_item != prev || n.count != length) return r.fail("point lists are invalid");
+    }
+
+    // Every stored index is in a list, and the free lists hold only unused entries
+    int32_t removed = 0;
+    for (int32_t slot : new_slot) {
+        if (slot >= 0 && !item_used[slot]) return r.fail("point slots are invalid");
+        if (slot == REMOVED) removed++;
+    }
+    if (removed != info.removed_count) return r.fail("point slots are invalid");
+    for (int32_t slot : new_free_items) {
+        if (item_used[slot]) return r.fail("free list overlaps the tree");
+        item_used[slot] = 1;
+    }
+    for (int32_t first : new_free_blocks) {
+        for (int c = 0; c < 4; c++) {
+            if (node_used[first + c] || new_nodes[first + c].parent != FREED_NODE) {
+                return r.fail("free list overlaps the tree");
+            }
+            node_used[first + c] = 1;
+        }
+    }
+
+    nodes.swap(new_nodes);
+    items.swap(new_items);
+    item_slot.swap(new_slot);
+    free_items.swap(new_free_items);
+    free_blocks.swap(new_free_blocks);
+    tree_bounds = info.bounds;
+    max_depth = info.max_depth;
+    max_items_per_node = info.max_items_per_node;
+    item_count = info.item_count;
+    removed_count = info.removed_count;
+    return true;
 }
 
 PackedInt32Array QuadTree::query_rect(const Rect2& rect) const {
+    AGENTITE_PROFILE("QuadTree.query_rect", 1);
     PackedInt32Array results;
 
-    if (!root) {
+    if (nodes.empty()) {
         return results;
     }
 
-    query_rect_recursive(root.get(), rect, results);
-    return results;
-}
+    std::vector<int32_t> hits;
+    int32_t stack[QUERY_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = 0;
 
-void QuadTree::query_rect_recursive(const Node* node, const Rect2& rect, PackedInt32Array& results) const {
-    // Check if query rect intersects this node's bounds
-    if (!node->bounds.intersects(rect)) {
-        return;
-    }
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
 
-    if (node->is_leaf) {
-        // Check all points in this leaf
-        for (int32_t idx : node->point_indices) {
-            if (rect.has_point(stored_points[idx])) {
-                results.push_back(idx);
-            }
+        // Check if query rect intersects this node's bounds
+        if (!node.bounds.intersects(rect)) {
+            continue;
         }
-    } else {
-        // Recurse into children
-        for (int i = 0; i < 4; i++) {
-            if (node->children[i]) {
-                query_rect_recursive(node->children[i].get(), rect, results);
+
+        if (node.first_child == -1) {
+            // Check all points in this leaf
+            for (int32_t it = node.first_item; it != -1; it = items[it].next) {
+                if (rect.has_point(items[it].position)) {
+                    hits.push_back(items[it].index);
+                }
+            }
+        } else {
+            // Visit children in order (pushed in reverse)
+            for (int i = 3; i >= 0; i--) {
+                stack[top++] = node.first_child + i;
             }
         }
     }
+
+    results.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), results.ptrw());
+    return results;
 }
 
 PackedInt32Array QuadTree::query_radius(const Vector2& center, float radius) const {
+    AGENTITE_PROFILE("QuadTree.query_radius", 1);
     PackedInt32Array results;
 
-    if (!root || radius <= 0.0f) {
+    if (nodes.empty() || radius <= 0.0f) {
         return results;
     }
 
     float radius_sq = radius * radius;
-    query_radius_recursive(root.get(), center, radius_sq, results);
-    return results;
-}
 
-void QuadTree::query_radius_recursive(const Node* node, const Vector2& center, float radius_sq,
-                                       PackedInt32Array& results) const {
-    // Check if circle intersects this node's bounds
-    // Use AABB of circle for quick rejection
-    float radius = std::sqrt(radius_sq);
+    // Use AABB of circle for quick rejection of nodes
     Rect2 circle_bounds(center.x - radius, center.y - radius, radius * 2, radius * 2);
 
-    if (!node->bounds.intersects(circle_bounds)) {
-        return;
-    }
+    std::vector<int32_t> hits;
+    int32_t stack[QUERY_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = 0;
 
-    if (node->is_leaf) {
-        // Check all points in this leaf
-        for (int32_t idx : node->point_indices) {
-            if (center.distance_squared_to(stored_points[idx]) <= radius_sq) {
-                results.push_back(idx);
-            }
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+
+        if (!node.bounds.intersects(circle_bounds)) {
+            continue;
         }
-    } else {
-        // Recurse into children
-        for (int i = 0; i < 4; i++) {
-            if (node->children[i]) {
-                query_radius_recursive(node->children[i].get(), center, radius_sq, results);
+
+        if (node.first_child == -1) {
+            // Check all points in this leaf
+            for (int32_t it = node.first_item; it != -1; it = items[it].next) {
+                if (center.distance_squared_to(items[it].position) <= radius_sq) {
+                    hits.push_back(items[it].index);
+                }
+            }
+        } else {
+            for (int i = 3; i >= 0; i--) {
+                stack[top++] = node.first_child + i;
             }
         }
     }
+
+    results.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), results.ptrw());
+    return results;
 }
 
 Array QuadTree::get_node_bounds() const {
     Array bounds;
 
-    if (root) {
-        collect_node_bounds(root.get(), bounds);
+    if (nodes.empty()) {
+        return bounds;
     }
 
-    return bounds;
-}
+    // Depth-first, parents before children
+    int32_t stack[QUERY_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = 0;
 
-void QuadTree::collect_node_bounds(const Node* node, Array& bounds) const {
-    bounds.push_back(node->bounds);
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        bounds.push_back(node.bounds);
 
-    if (!node->is_leaf) {
-        for (int i = 0; i < 4; i++) {
-            if (node->children[i]) {
-                collect_node_bounds(node->children[i].get(), bounds);
+        if (node.first_child != -1) {
+            for (int i = 3; i >= 0; i--) {
+                stack[top++] = node.first_child + i;
             }
         }
     }
+
+    return bounds;
 }
 
 }
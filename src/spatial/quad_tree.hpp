@@ -16,6 +16,17 @@
  * - Supports dynamic insertion
  * - Slightly slower for uniform distributions
  *
+ * Nodes live in one contiguous array (children of a node are four
+ * consecutive entries) and points live in one pooled buffer linked per
+ * leaf, so subdividing allocates nothing once the buffers have grown, and
+ * clear()/build() keep their capacity for the next rebuild. build() lays
+ * points out in Z-order (Morton order), so each leaf's points are
+ * contiguous in memory.
+ *
+ * Points can be moved or removed without a rebuild. Nodes whose children
+ * end up holding at most half of max_items_per_node are merged back into
+ * a single leaf.
+ *
  * Usage:
  *   var quadtree = QuadTree.new()
  *   quadtree.set_bounds(Rect2(0, 0, 1000, 1000))
@@ -28,13 +39,14 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/array.hpp>
 
+#include <cstdint>
 #include <vector>
-#include <memory>
 
 namespace godot {
 
@@ -44,33 +56,61 @@ class QuadTree : public RefCounted {
 private:
     struct Node {
         Rect2 bounds;
-        std::vector<int32_t> point_indices;  // Points stored at this node
-        std::unique_ptr<Node> children[4];   // NW, NE, SW, SE
-        bool is_leaf = true;
+        int32_t first_child = -1;  // Children are 4 consecutive nodes (NW, NE, SW, SE), -1 for a leaf
+        int32_t first_item = -1;   // Leaf points, linked through Item::next
+        int32_t last_item = -1;
+        int32_t count = 0;
+        int32_t parent;            // -1 for the root
+
+        Node() : parent(-1) {}
+        Node(const Rect2& b, int32_t p) : bounds(b), parent(p) {}
+    };
 
-        Node(const Rect2& b) : bounds(b) {}
+    struct Item {
+        Vector2 position;
+        int32_t index;
+        int32_t next;
+        int32_t prev;
+        int32_t node;  // Owning leaf
     };
 
-    std::unique_ptr<Node> root;
-    PackedVector2Array stored_points;
+    std::vector<Node> nodes;          // nodes[0] is the root
+    std::vector<Item> items;          // Pooled storage for every leaf's points
+    std::vector<int32_t> item_slot;   // Pooled item of each index
+    std::vector<int32_t> free_items;  // Unused pooled items
+    std::vector<int32_t> free_blocks; // First node of each child block freed by merging
     Rect2 tree_bounds;
     int32_t max_depth = 8;
     int32_t max_items_per_node = 8;
-    int32_t item_count = 0;
+    int32_t item_count = 0;           // Indices handed out, including removed ones
+    int32_t removed_count = 0;
+
+    // Pooled item storage
+    int32_t alloc_item(const Vector2& position, int32_t index);
+    void append_item(int32_t node, int32_t item);
+    void unlink_item(int32_t item);
+
+    // Insert a pooled item below node, subdividing leaves that overflow.
+    // Returns false if the point falls outside the tree.
+    bool insert_item(int32_t node, int32_t item, int depth);
+
+    // Store index at position (skipped if outside the tree bounds)
+    void store_item(int32_t index, const Vector2& position);
 
-    // Insert point into a node recursively
-    void insert_into_node(Node* node, int32_t point_index, int depth);
+    // Move index to position. Returns the leaf it left, or -1 if it stayed put.
+    int32_t move_item(int32_t index, const Vector2& position);
 
-    // Subdivide a node into 4 children
-    void subdivide(Node* node, int depth);
+    // Merge the ancestors of node that have become nearly empty
+    void collapse_from(int32_t node);
 
-    // Query helpers
-    void query_rect_recursive(const Node* node, const Rect2& rect, PackedInt32Array& results) const;
-    void query_radius_recursive(const Node* node, const Vector2& center, float radius_sq,
-                                 PackedInt32Array& results) const;
+    // Create node's 4 children, returning the index of the first
+    int32_t split(int32_t node);
 
-    // Get all node bounds for visualization
-    void collect_node_bounds(const Node* node, Array& bounds) const;
+    // Subdivide a leaf into 4 children
+    void subdivide(int32_t node, int depth);
+
+    // Bulk build: partition ids[0, count) into the subtree of node. scratch has room for count ids.
+    void build_node(int32_t node, int32_t* ids, int32_t count, int32_t* scratch, int depth, const Vector2* points);
 
     // Get quadrant index for a point (0=NW, 1=NE, 2=SW, 3=SE)
     int get_quadrant(const Rect2& bounds, const Vector2& point) const;
@@ -99,12 +139,29 @@ public:
     // Insert a single point (returns the index assigned)
     int32_t insert(const Vector2& position);
 
+    // Move a point. Only touches its old and new leaf; points that stay
+    // inside their leaf are updated in place.
+    void update(int32_t index, const Vector2& new_position);
+
+    // Move many points, merging emptied nodes once at the end
+    void update_many(const PackedInt32Array& indices, const PackedVector2Array& new_positions);
+
+    // Remove a point (its index is not reused)
+    void remove(int32_t index);
+
     // Clear all data
     void clear();
 
     // Get number of points in the tree
     int32_t size() const;
 
+    // Save the tree, including moved and removed points, as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the tree with a saved snapshot, without rebuilding
+    // Returns false (and keeps the current tree) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+
     // Query: find all points within a rectangle
     // Returns PackedInt32Array of indices
     PackedInt32Array query_rect(const Rect2& rect) const;
@@ -0,0 +1,536 @@
+/**
+ * SpatialGrid2D Implementation
+ */
+
+#include "spatial_grid_2d.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace godot {
+
+void SpatialGrid2D::_bind_methods() {
+    // Properties
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &SpatialGrid2D::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &SpatialGrid2D::get_cell_size);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+
+    ClassDB::bind_method(D_METHOD("set_bounds", "bounds"), &SpatialGrid2D::set_bounds);
+    ClassDB::bind_method(D_METHOD("get_bounds"), &SpatialGrid2D::get_bounds);
+    ADD_PROPERTY(PropertyInfo(Variant::RECT2, "bounds"), "set_bounds", "get_bounds");
+
+    ClassDB::bind_method(D_METHOD("get_count"), &SpatialGrid2D::get_count);
+    ClassDB::bind_method(D_METHOD("get_grid_size"), &SpatialGrid2D::get_grid_size);
+    ClassDB::bind_method(D_METHOD("get_effective_cell_size"), &SpatialGrid2D::get_effective_cell_size);
+
+    // Core methods
+    ClassDB::bind_method(D_METHOD("build", "positions"), &SpatialGrid2D::build);
+    ClassDB::bind_method(D_METHOD("build_from_store", "store"), &SpatialGrid2D::build_from_store);
+    ClassDB::bind_method(D_METHOD("clear"), &SpatialGrid2D::clear);
+
+    // Query methods
+    ClassDB::bind_method(D_METHOD("query_radius", "origin", "radius"), &SpatialGrid2D::query_radius);
+    ClassDB::bind_method(D_METHOD("query_rect", "rect"), &SpatialGrid2D::query_rect);
+    ClassDB::bind_method(D_METHOD("query_nearest", "origin", "k"), &SpatialGrid2D::query_nearest);
+    ClassDB::bind_method(D_METHOD("query_nearest_one", "origin"), &SpatialGrid2D::query_nearest_one);
+
+    // Batch queries
+    ClassDB::bind_method(D_METHOD("query_radius_batch", "origins", "radii"), &SpatialGrid2D::query_radius_batch);
+    ClassDB::bind_method(D_METHOD("query_radius_batch_uniform", "origins", "radius"), &SpatialGrid2D::query_radius_batch_uniform);
+    ClassDB::bind_method(D_METHOD("query_radius_batch_flat", "origins", "radii", "out"), &SpatialGrid2D::query_radius_batch_flat, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("query_radius_batch_uniform_flat", "origins", "radius", "out"), &SpatialGrid2D::query_radius_batch_uniform_flat, DEFVAL(Variant()));
+
+    // Utility queries
+    ClassDB::bind_method(D_METHOD("has_any_in_radius", "origin", "radius"), &SpatialGrid2D::has_any_in_radius);
+    ClassDB::bind_method(D_METHOD("count_in_radius", "origin", "radius"), &SpatialGrid2D::count_in_radius);
+}
+
+SpatialGrid2D::SpatialGrid2D() {
+}
+
+SpatialGrid2D::~SpatialGrid2D() {
+}
+
+void SpatialGrid2D::set_cell_size(float p_size) {
+    if (p_size > 0.0f) {
+        cell_size = p_size;
+    }
+}
+
+float SpatialGrid2D::get_cell_size() const {
+    return cell_size;
+}
+
+void SpatialGrid2D::set_bounds(const Rect2& p_bounds) {
+    bounds = p_bounds;
+}
+
+Rect2 SpatialGrid2D::get_bounds() const {
+    return bounds;
+}
+
+int32_t SpatialGrid2D::get_count() const {
+    return item_count;
+}
+
+Vector2i SpatialGrid2D::get_grid_size() const {
+    return Vector2i(grid_width, grid_height);
+}
+
+float SpatialGrid2D::get_effective_cell_size() const {
+    return grid_cell_size;
+}
+
+void SpatialGrid2D::build(const PackedVector2Array& positions) {
+    AGENTITE_PROFILE("SpatialGrid2D.build", positions.size());
+    int32_t n = static_cast<int32_t>(positions.size());
+    if (n == 0) {
+        clear();
+        return;
+    }
+
+    const Vector2* pos_ptr = positions.ptr();
+
+    // Determine the world extent: user bounds, or the bounding box of finite points
+    Vector2 min_p, max_p;
+    if (bounds.size.x > 0.0f && bounds.size.y > 0.0f) {
+        min_p = bounds.position;
+        max_p = bounds.position + bounds.size;
+    } else {
+        min_p = Vector2(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        max_p = Vector2(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+        for (int32_t i = 0; i < n; i++) {
+            const Vector2& p = pos_ptr[i];
+            if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+                continue;
+            }
+            min_p.x = std::min(min_p.x, p.x);
+            min_p.y = std::min(min_p.y, p.y);
+            max_p.x = std::max(max_p.x, p.x);
+            max_p.y = std::max(max_p.y, p.y);
+        }
+        if (min_p.x > max_p.x) {
+            min_p = max_p = Vector2();
+        }
+    }
+
+    // Pick grid dimensions, enlarging the cell size if the grid would be too large
+    double extent_x = static_cast<double>(max_p.x) - min_p.x;
+    double extent_y = static_cast<double>(max_p.y) - min_p.y;
+    int64_t budget = std::max<int64_t>(MIN_CELL_BUDGET, static_cast<int64_t>(n) * MAX_CELLS_PER_ITEM);
+
+    double size = cell_size;
+    if (extent_x * extent_y / (size * size) > static_cast<double>(budget)) {
+        size = std::sqrt(extent_x * extent_y / static_cast<double>(budget));
+    }
+    int64_t w, h;
+    while (true) {
+        w = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(extent_x / size)));
+        h = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(extent_y / size)));
+        if (w * h <= budget) {
+            break;
+        }
+        size *= 1.25;
+    }
+
+    grid_origin = min_p;
+    grid_cell_size = static_cast<float>(size);
+    inv_cell_size = 1.0f / grid_cell_size;
+    grid_width = static_cast<int32_t>(w);
+    grid_height = static_cast<int32_t>(h);
+    item_count = n;
+
+    int32_t cell_count = grid_width * grid_height;
+
+    // Counting sort pass 1: count points per cell
+    cell_start.assign(cell_count + 1, 0);
+    point_cells.resize(n);
+    for (int32_t i = 0; i < n; i++) {
+        int32_t c = cell_y(pos_ptr[i].y) * grid_width + cell_x(pos_ptr[i].x);
+        point_cells[i] = c;
+        cell_start[c]++;
+    }
+
+    // Pass 2: inclusive prefix sum, cell_start[c] becomes the end of cell c
+    for (int32_t c = 1; c < cell_count; c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+    cell_start[cell_count] = n;
+
+    // Pass 3: scatter in reverse so each cell keeps ascending index order,
+    // leaving cell_start[c] at the start of cell c
+    sorted_indices.resize(n);
+    sorted_positions.resize(n);
+    for (int32_t i = n - 1; i >= 0; i--) {
+        int32_t slot = --cell_start[point_cells[i]];
+        sorted_indices[slot] = i;
+        sorted_positions[slot] = pos_ptr[i];
+    }
+}
+
+void SpatialGrid2D::build_from_store(const Ref<AgentStore2D>& store) {
+    if (store.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: SpatialGrid2D.build_from_store needs a store");
+        return;
+    }
+    build(store->position_column());
+}
+
+void SpatialGrid2D::clear() {
+    cell_start.clear();
+    sorted_indices.clear();
+    sorted_positions.clear();
+    point_cells.clear();
+    grid_width = 0;
+    grid_height = 0;
+    item_count = 0;
+}
+
+PackedInt32Array SpatialGrid2D::query_radius(const Vector2& origin, float radius) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_radius", 1);
+    std::vector<int32_t> hits;
+    collect_radius(origin, radius, hits);
+
+    PackedInt32Array result;
+    result.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+void SpatialGrid2D::collect_radius(const Vector2& origin, float radius, std::vector<int32_t>& out) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return;
+    }
+
+    float radius_sq = radius * radius;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector2* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+        // Cells of a row are adjacent, so the whole row span is one contiguous range
+        int32_t row = cy * grid_width;
+        int32_t begin = start_ptr[row + min_cx];
+        int32_t end = start_ptr[row + max_cx + 1];
+        for (int32_t j = begin; j < end; j++) {
+            if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                out.push_back(idx_ptr[j]);
+            }
+        }
+    }
+}
+
+PackedInt32Array SpatialGrid2D::query_rect(const Rect2& rect) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_rect", 1);
+    PackedInt32Array result;
+
+    if (item_count == 0) {
+        return result;
+    }
+
+    Vector2 end_p = rect.position + rect.size;
+    int32_t min_cx = cell_x(rect.position.x);
+    int32_t max_cx = cell_x(end_p.x);
+    int32_t min_cy = cell_y(rect.position.y);
+    int32_t max_cy = cell_y(end_p.y);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector2* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+        int32_t row = cy * grid_width;
+        int32_t begin = start_ptr[row + min_cx];
+        int32_t end = start_ptr[row + max_cx + 1];
+        for (int32_t j = begin; j < end; j++) {
+            if (rect.has_point(pos_ptr[j])) {
+                result.push_back(idx_ptr[j]);
+            }
+        }
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+PackedInt32Array SpatialGrid2D::query_nearest(const Vector2& origin, int32_t k) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_nearest", 1);
+    PackedInt32Array result;
+
+    if (k <= 0 || item_count == 0) {
+        return result;
+    }
+    k = std::min(k, item_count);
+
+    // Expanding ring search with a bounded max-heap (farthest candidate on top)
+    std::priority_queue<std::pair<float, int32_t>> heap;
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector2* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    auto visit_span = [&](int32_t begin, int32_t end) {
+        for (int32_t j = begin; j < end; j++) {
+            float dist_sq = origin.distance_squared_to(pos_ptr[j]);
+            if (static_cast<int32_t>(heap.size()) < k) {
+                heap.emplace(dist_sq, idx_ptr[j]);
+            } else if (dist_sq < heap.top().first) {
+                heap.pop();
+                heap.emplace(dist_sq, idx_ptr[j]);
+            }
+        }
+    };
+
+    int32_t cx = cell_x(origin.x);
+    int32_t cy = cell_y(origin.y);
+    int32_t max_ring = std::max(std::max(cx, grid_width - 1 - cx), std::max(cy, grid_height - 1 - cy));
+
+    for (int32_t ring = 0; ring <= max_ring; ring++) {
+        int32_t x0 = std::max(cx - ring, 0);
+        int32_t x1 = std::min(cx + ring, grid_width - 1);
+
+        // Top and bottom rows of the ring (full width)
+        if (cy - ring >= 0) {
+            int32_t row = (cy - ring) * grid_width;
+            visit_span(start_ptr[row + x0], start_ptr[row + x1 + 1]);
+        }
+        if (ring > 0 && cy + ring < grid_height) {
+            int32_t row = (cy + ring) * grid_width;
+            visit_span(start_ptr[row + x0], start_ptr[row + x1 + 1]);
+        }
+
+        // Left and right columns, excluding the corners already visited
+        if (ring > 0) {
+            int32_t y0 = std::max(cy - ring + 1, 0);
+            int32_t y1 = std::min(cy + ring - 1, grid_height - 1);
+            for (int32_t y = y0; y <= y1; y++) {
+                int32_t row = y * grid_width;
+                if (cx - ring >= 0) {
+                    int32_t c = row + cx - ring;
+                    visit_span(start_ptr[c], start_ptr[c + 1]);
+                }
+                if (cx + ring < grid_width) {
+                    int32_t c = row + cx + ring;
+                    visit_span(start_ptr[c], start_ptr[c + 1]);
+                }
+            }
+        }
+
+        if (static_cast<int32_t>(heap.size()) < k) {
+            continue;
+        }
+
+        // Distance from origin to the nearest cell outside the visited square
+        float gap = std::numeric_limits<float>::max();
+        if (cx - ring > 0) {
+            gap = std::min(gap, origin.x - (grid_origin.x + (cx - ring) * grid_cell_size));
+        }
+        if (cx + ring < grid_width - 1) {
+            gap = std::min(gap, grid_origin.x + (cx + ring + 1) * grid_cell_size - origin.x);
+        }
+        if (cy - ring > 0) {
+            gap = std::min(gap, origin.y - (grid_origin.y + (cy - ring) * grid_cell_size));
+        }
+        if (cy + ring < grid_height - 1) {
+            gap = std::min(gap, grid_origin.y + (cy + ring + 1) * grid_cell_size - origin.y);
+        }
+        if (gap > 0.0f && gap * gap >= heap.top().first) {
+            break;
+        }
+    }
+
+    // Extract results nearest first
+    int32_t found = static_cast<int32_t>(heap.size());
+    result.resize(found);
+    int32_t* res_ptr = result.ptrw();
+    for (int32_t i = found - 1; i >= 0; i--) {
+        res_ptr[i] = heap.top().second;
+        heap.pop();
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+int32_t SpatialGrid2D::query_nearest_one(const Vector2& origin) const {
+    PackedInt32Array nearest = query_nearest(origin, 1);
+    return nearest.size() > 0 ? nearest[0] : -1;
+}
+
+Array SpatialGrid2D::query_radius_batch(
+    const PackedVector2Array& origins,
+    const PackedFloat32Array& radii
+) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_radius_batch", origins.size());
+    Array results;
+
+    int32_t query_count = origins.size();
+    if (query_count != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        return results;
+    }
+
+    const Vector2* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    // Queries are read-only and independent, so large batches run across worker threads
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius_ptr[i]);
+        }
+    });
+
+    results.resize(query_count);
+    for (int32_t i = 0; i < query_count; i++) {
+        results[i] = per_query[i];
+    }
+
+    return results;
+}
+
+Array SpatialGrid2D::query_radius_batch_uniform(
+    const PackedVector2Array& origins,
+    float radius
+) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_radius_batch_uniform", origins.size());
+    Array results;
+
+    int32_t query_count = origins.size();
+    const Vector2* origin_ptr = origins.ptr();
+
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius);
+        }
+    });
+
+    results.resize(query_count);
+    for (int32_t i = 0; i < query_count; i++) {
+        results[i] = per_query[i];
+    }
+
+    return results;
+}
+
+Ref<NeighborList> SpatialGrid2D::query_radius_batch_flat(
+    const PackedVector2Array& origins,
+    const PackedFloat32Array& radii,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_radius_batch_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    int32_t query_count = origins.size();
+    if (query_count != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        list->clear();
+        return list;
+    }
+
+    const Vector2* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    list->fill(query_count, [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius_ptr[i], hits);
+    });
+
+    return list;
+}
+
+Ref<NeighborList> SpatialGrid2D::query_radius_batch_uniform_flat(
+    const PackedVector2Array& origins,
+    float radius,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialGrid2D.query_radius_batch_uniform_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    const Vector2* origin_ptr = origins.ptr();
+
+    list->fill(origins.size(), [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius, hits);
+    });
+
+    return list;
+}
+
+bool SpatialGrid2D::has_any_in_radius(const Vector2& origin, float radius) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return false;
+    }
+
+    float radius_sq = radius * radius;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector2* pos_ptr = sorted_positions.data();
+
+    for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+        int32_t row = cy * grid_width;
+        int32_t end = start_ptr[row + max_cx + 1];
+        for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+            if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int32_t SpatialGrid2D::count_in_radius(const Vector2& origin, float radius) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return 0;
+    }
+
+    float radius_sq = radius * radius;
+    int32_t count = 0;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector2* pos_ptr = sorted_positions.data();
+
+    for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+        int32_t row = cy * grid_width;
+        int32_t end = start_ptr[row + max_cx + 1];
+        for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+            if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+}
@@ -0,0 +1,566 @@
+/**
+ * SpatialGrid3D Implementation
+ */
+
+#include "spatial_grid_3d.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace godot {
+
+void SpatialGrid3D::_bind_methods() {
+    // Properties
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &SpatialGrid3D::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &SpatialGrid3D::get_cell_size);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+
+    ClassDB::bind_method(D_METHOD("set_bounds", "bounds"), &SpatialGrid3D::set_bounds);
+    ClassDB::bind_method(D_METHOD("get_bounds"), &SpatialGrid3D::get_bounds);
+    ADD_PROPERTY(PropertyInfo(Variant::AABB, "bounds"), "set_bounds", "get_bounds");
+
+    ClassDB::bind_method(D_METHOD("get_count"), &SpatialGrid3D::get_count);
+    ClassDB::bind_method(D_METHOD("get_grid_size"), &SpatialGrid3D::get_grid_size);
+    ClassDB::bind_method(D_METHOD("get_effective_cell_size"), &SpatialGrid3D::get_effective_cell_size);
+
+    // Core methods
+    ClassDB::bind_method(D_METHOD("build", "positions"), &SpatialGrid3D::build);
+    ClassDB::bind_method(D_METHOD("build_from_store", "store"), &SpatialGrid3D::build_from_store);
+    ClassDB::bind_method(D_METHOD("clear"), &SpatialGrid3D::clear);
+
+    // Query methods
+    ClassDB::bind_method(D_METHOD("query_radius", "origin", "radius"), &SpatialGrid3D::query_radius);
+    ClassDB::bind_method(D_METHOD("query_box", "box"), &SpatialGrid3D::query_box);
+    ClassDB::bind_method(D_METHOD("query_nearest", "origin", "k"), &SpatialGrid3D::query_nearest);
+    ClassDB::bind_method(D_METHOD("query_nearest_one", "origin"), &SpatialGrid3D::query_nearest_one);
+
+    // Batch queries
+    ClassDB::bind_method(D_METHOD("query_radius_batch", "origins", "radii"), &SpatialGrid3D::query_radius_batch);
+    ClassDB::bind_method(D_METHOD("query_radius_batch_uniform", "origins", "radius"), &SpatialGrid3D::query_radius_batch_uniform);
+    ClassDB::bind_method(D_METHOD("query_radius_batch_flat", "origins", "radii", "out"), &SpatialGrid3D::query_radius_batch_flat, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("query_radius_batch_uniform_flat", "origins", "radius", "out"), &SpatialGrid3D::query_radius_batch_uniform_flat, DEFVAL(Variant()));
+
+    // Utility queries
+    ClassDB::bind_method(D_METHOD("has_any_in_radius", "origin", "radius"), &SpatialGrid3D::has_any_in_radius);
+    ClassDB::bind_method(D_METHOD("count_in_radius", "origin", "radius"), &SpatialGrid3D::count_in_radius);
+}
+
+SpatialGrid3D::SpatialGrid3D() {
+}
+
+SpatialGrid3D::~SpatialGrid3D() {
+}
+
+void SpatialGrid3D::set_cell_size(float p_size) {
+    if (p_size > 0.0f) {
+        cell_size = p_size;
+    }
+}
+
+float SpatialGrid3D::get_cell_size() const {
+    return cell_size;
+}
+
+void SpatialGrid3D::set_bounds(const AABB& p_bounds) {
+    bounds = p_bounds;
+}
+
+AABB SpatialGrid3D::get_bounds() const {
+    return bounds;
+}
+
+int32_t SpatialGrid3D::get_count() const {
+    return item_count;
+}
+
+Vector3i SpatialGrid3D::get_grid_size() const {
+    return Vector3i(grid_width, grid_height, grid_depth);
+}
+
+float SpatialGrid3D::get_effective_cell_size() const {
+    return grid_cell_size;
+}
+
+void SpatialGrid3D::build(const PackedVector3Array& positions) {
+    AGENTITE_PROFILE("SpatialGrid3D.build", positions.size());
+    int32_t n = static_cast<int32_t>(positions.size());
+    if (n == 0) {
+        clear();
+        return;
+    }
+
+    const Vector3* pos_ptr = positions.ptr();
+
+    // Determine the world extent: user bounds, or the bounding box of finite points
+    Vector3 min_p, max_p;
+    if (bounds.size.x > 0.0f && bounds.size.y > 0.0f && bounds.size.z > 0.0f) {
+        min_p = bounds.position;
+        max_p = bounds.position + bounds.size;
+    } else {
+        const float fmax = std::numeric_limits<float>::max();
+        const float fmin = std::numeric_limits<float>::lowest();
+        min_p = Vector3(fmax, fmax, fmax);
+        max_p = Vector3(fmin, fmin, fmin);
+        for (int32_t i = 0; i < n; i++) {
+            const Vector3& p = pos_ptr[i];
+            if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+                continue;
+            }
+            min_p.x = std::min(min_p.x, p.x);
+            min_p.y = std::min(min_p.y, p.y);
+            min_p.z = std::min(min_p.z, p.z);
+            max_p.x = std::max(max_p.x, p.x);
+            max_p.y = std::max(max_p.y, p.y);
+            max_p.z = std::max(max_p.z, p.z);
+        }
+        if (min_p.x > max_p.x) {
+            min_p = max_p = Vector3();
+        }
+    }
+
+    // Pick grid dimensions, enlarging the cell size if the grid would be too large
+    double extent_x = static_cast<double>(max_p.x) - min_p.x;
+    double extent_y = static_cast<double>(max_p.y) - min_p.y;
+    double extent_z = static_cast<double>(max_p.z) - min_p.z;
+    int64_t budget = std::max<int64_t>(MIN_CELL_BUDGET, static_cast<int64_t>(n) * MAX_CELLS_PER_ITEM);
+
+    double size = cell_size;
+    double volume = extent_x * extent_y * extent_z;
+    if (volume / (size * size * size) > static_cast<double>(budget)) {
+        size = std::cbrt(volume / static_cast<double>(budget));
+    }
+    int64_t w, h, d;
+    while (true) {
+        w = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(extent_x / size)));
+        h = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(extent_y / size)));
+        d = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(extent_z / size)));
+        if (w * h * d <= budget) {
+            break;
+        }
+        size *= 1.25;
+    }
+
+    grid_origin = min_p;
+    grid_cell_size = static_cast<float>(size);
+    inv_cell_size = 1.0f / grid_cell_size;
+    grid_width = static_cast<int32_t>(w);
+    grid_height = static_cast<int32_t>(h);
+    grid_depth = static_cast<int32_t>(d);
+    item_count = n;
+
+    int32_t cell_count = grid_width * grid_height * grid_depth;
+
+    // Counting sort pass 1: count points per cell
+    cell_start.assign(cell_count + 1, 0);
+    point_cells.resize(n);
+    for (int32_t i = 0; i < n; i++) {
+        const Vector3& p = pos_ptr[i];
+        int32_t c = (cell_z(p.z) * grid_height + cell_y(p.y)) * grid_width + cell_x(p.x);
+        point_cells[i] = c;
+        cell_start[c]++;
+    }
+
+    // Pass 2: inclusive prefix sum, cell_start[c] becomes the end of cell c
+    for (int32_t c = 1; c < cell_count; c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+    cell_start[cell_count] = n;
+
+    // Pass 3: scatter in reverse so each cell keeps ascending index order,
+    // leaving cell_start[c] at the start of cell c
+    sorted_indices.resize(n);
+    sorted_positions.resize(n);
+    for (int32_t i = n - 1; i >= 0; i--) {
+        int32_t slot = --cell_start[point_cells[i]];
+        sorted_indices[slot] = i;
+        sorted_positions[slot] = pos_ptr[i];
+    }
+}
+
+void SpatialGrid3D::build_from_store(const Ref<AgentStore3D>& store) {
+    if (store.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: SpatialGrid3D.build_from_store needs a store");
+        return;
+    }
+    build(store->position_column());
+}
+
+void SpatialGrid3D::clear() {
+    cell_start.clear();
+    sorted_indices.clear();
+    sorted_positions.clear();
+    point_cells.clear();
+    grid_width = 0;
+    grid_height = 0;
+    grid_depth = 0;
+    item_count = 0;
+}
+
+PackedInt32Array SpatialGrid3D::query_radius(const Vector3& origin, float radius) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_radius", 1);
+    std::vector<int32_t> hits;
+    collect_radius(origin, radius, hits);
+
+    PackedInt32Array result;
+    result.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+void SpatialGrid3D::collect_radius(const Vector3& origin, float radius, std::vector<int32_t>& out) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return;
+    }
+
+    float radius_sq = radius * radius;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+    int32_t min_cz = cell_z(origin.z - radius);
+    int32_t max_cz = cell_z(origin.z + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector3* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    for (int32_t cz = min_cz; cz <= max_cz; cz++) {
+        for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+            // Cells of a row are adjacent, so the whole row span is one contiguous range
+            int32_t row = (cz * grid_height + cy) * grid_width;
+            int32_t end = start_ptr[row + max_cx + 1];
+            for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+                if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                    out.push_back(idx_ptr[j]);
+                }
+            }
+        }
+    }
+}
+
+PackedInt32Array SpatialGrid3D::query_box(const AABB& box) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_box", 1);
+    PackedInt32Array result;
+
+    if (item_count == 0) {
+        return result;
+    }
+
+    Vector3 end_p = box.position + box.size;
+    int32_t min_cx = cell_x(box.position.x);
+    int32_t max_cx = cell_x(end_p.x);
+    int32_t min_cy = cell_y(box.position.y);
+    int32_t max_cy = cell_y(end_p.y);
+    int32_t min_cz = cell_z(box.position.z);
+    int32_t max_cz = cell_z(end_p.z);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector3* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    for (int32_t cz = min_cz; cz <= max_cz; cz++) {
+        for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+            int32_t row = (cz * grid_height + cy) * grid_width;
+            int32_t end = start_ptr[row + max_cx + 1];
+            for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+                if (box.has_point(pos_ptr[j])) {
+                    result.push_back(idx_ptr[j]);
+                }
+            }
+        }
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+PackedInt32Array SpatialGrid3D::query_nearest(const Vector3& origin, int32_t k) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_nearest", 1);
+    PackedInt32Array result;
+
+    if (k <= 0 || item_count == 0) {
+        return result;
+    }
+    k = std::min(k, item_count);
+
+    // Expanding shell search with a bounded max-heap (farthest candidate on top)
+    std::priority_queue<std::pair<float, int32_t>> heap;
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector3* pos_ptr = sorted_positions.data();
+    const int32_t* idx_ptr = sorted_indices.data();
+
+    auto visit_span = [&](int32_t begin, int32_t end) {
+        for (int32_t j = begin; j < end; j++) {
+            float dist_sq = origin.distance_squared_to(pos_ptr[j]);
+            if (static_cast<int32_t>(heap.size()) < k) {
+                heap.emplace(dist_sq, idx_ptr[j]);
+            } else if (dist_sq < heap.top().first) {
+                heap.pop();
+                heap.emplace(dist_sq, idx_ptr[j]);
+            }
+        }
+    };
+
+    int32_t cx = cell_x(origin.x);
+    int32_t cy = cell_y(origin.y);
+    int32_t cz = cell_z(origin.z);
+    int32_t max_ring = std::max(std::max(std::max(cx, grid_width - 1 - cx), std::max(cy, grid_height - 1 - cy)),
+                                std::max(cz, grid_depth - 1 - cz));
+
+    for (int32_t ring = 0; ring <= max_ring; ring++) {
+        int32_t x0 = std::max(cx - ring, 0);
+        int32_t x1 = std::min(cx + ring, grid_width - 1);
+        int32_t y0 = std::max(cy - ring, 0);
+        int32_t y1 = std::min(cy + ring, grid_height - 1);
+        int32_t z0 = std::max(cz - ring, 0);
+        int32_t z1 = std::min(cz + ring, grid_depth - 1);
+
+        for (int32_t z = z0; z <= z1; z++) {
+            bool z_face = (z == cz - ring || z == cz + ring);
+            for (int32_t y = y0; y <= y1; y++) {
+                int32_t row = (z * grid_height + y) * grid_width;
+                if (z_face || y == cy - ring || y == cy + ring) {
+                    // Row lies on a face of the shell: visit its full span
+                    visit_span(start_ptr[row + x0], start_ptr[row + x1 + 1]);
+                } else {
+                    // Interior row: only the two end cells belong to the shell
+                    if (cx - ring >= 0) {
+                        int32_t c = row + cx - ring;
+                        visit_span(start_ptr[c], start_ptr[c + 1]);
+                    }
+                    if (ring > 0 && cx + ring < grid_width) {
+                        int32_t c = row + cx + ring;
+                        visit_span(start_ptr[c], start_ptr[c + 1]);
+                    }
+                }
+            }
+        }
+
+        if (static_cast<int32_t>(heap.size()) < k) {
+            continue;
+        }
+
+        // Distance from origin to the nearest cell outside the visited cube
+        float gap = std::numeric_limits<float>::max();
+        if (cx - ring > 0) {
+            gap = std::min(gap, origin.x - (grid_origin.x + (cx - ring) * grid_cell_size));
+        }
+        if (cx + ring < grid_width - 1) {
+            gap = std::min(gap, grid_origin.x + (cx + ring + 1) * grid_cell_size - origin.x);
+        }
+        if (cy - ring > 0) {
+            gap = std::min(gap, origin.y - (grid_origin.y + (cy - ring) * grid_cell_size));
+        }
+        if (cy + ring < grid_height - 1) {
+            gap = std::min(gap, grid_origin.y + (cy + ring + 1) * grid_cell_size - origin.y);
+        }
+        if (cz - ring > 0) {
+            gap = std::min(gap, origin.z - (grid_origin.z + (cz - ring) * grid_cell_size));
+        }
+        if (cz + ring < grid_depth - 1) {
+            gap = std::min(gap, grid_origin.z + (cz + ring + 1) * grid_cell_size - origin.z);
+        }
+        if (gap > 0.0f && gap * gap >= heap.top().first) {
+            break;
+        }
+    }
+
+    // Extract results nearest first
+    int32_t found = static_cast<int32_t>(heap.size());
+    result.resize(found);
+    int32_t* res_ptr = result.ptrw();
+    for (int32_t i = found - 1; i >= 0; i--) {
+        res_ptr[i] = heap.top().second;
+        heap.pop();
+    }
+
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
+
+int32_t SpatialGrid3D::query_nearest_one(const Vector3& origin) const {
+    PackedInt32Array nearest = query_nearest(origin, 1);
+    return nearest.size() > 0 ? nearest[0] : -1;
+}
+
+Array SpatialGrid3D::query_radius_batch(
+    const PackedVector3Array& origins,
+    const PackedFloat32Array& radii
+) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_radius_batch", origins.size());
+    Array results;
+
+    int32_t query_count = origins.size();
+    if (query_count != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        return results;
+    }
+
+    const Vector3* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    // Queries are read-only and independent, so large batches run across worker threads
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius_ptr[i]);
+        }
+    });
+
+    results.resize(query_count);
+    for (int32_t i = 0; i < query_count; i++) {
+        results[i] = per_query[i];
+    }
+
+    return results;
+}
+
+Array SpatialGrid3D::query_radius_batch_uniform(
+    const PackedVector3Array& origins,
+    float radius
+) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_radius_batch_uniform", origins.size());
+    Array results;
+
+    int32_t query_count = origins.size();
+    const Vector3* origin_ptr = origins.ptr();
+
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius);
+        }
+    });
+
+    results.resize(query_count);
+    for (int32_t i = 0; i < query_count; i++) {
+        results[i] = per_query[i];
+    }
+
+    return results;
+}
+
+Ref<NeighborList> SpatialGrid3D::query_radius_batch_flat(
+    const PackedVector3Array& origins,
+    const PackedFloat32Array& radii,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_radius_batch_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    int32_t query_count = origins.size();
+    if (query_count != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        list->clear();
+        return list;
+    }
+
+    const Vector3* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    list->fill(query_count, [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius_ptr[i], hits);
+    });
+
+    return list;
+}
+
+Ref<NeighborList> SpatialGrid3D::query_radius_batch_uniform_flat(
+    const PackedVector3Array& origins,
+    float radius,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialGrid3D.query_radius_batch_uniform_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    const Vector3* origin_ptr = origins.ptr();
+
+    list->fill(origins.size(), [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius, hits);
+    });
+
+    return list;
+}
+
+bool SpatialGrid3D::has_any_in_radius(const Vector3& origin, float radius) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return false;
+    }
+
+    float radius_sq = radius * radius;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+    int32_t min_cz = cell_z(origin.z - radius);
+    int32_t max_cz = cell_z(origin.z + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector3* pos_ptr = sorted_positions.data();
+
+    for (int32_t cz = min_cz; cz <= max_cz; cz++) {
+        for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+            int32_t row = (cz * grid_height + cy) * grid_width;
+            int32_t end = start_ptr[row + max_cx + 1];
+            for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+                if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+int32_t SpatialGrid3D::count_in_radius(const Vector3& origin, float radius) const {
+    if (radius <= 0.0f || item_count == 0) {
+        return 0;
+    }
+
+    float radius_sq = radius * radius;
+    int32_t count = 0;
+
+    int32_t min_cx = cell_x(origin.x - radius);
+    int32_t max_cx = cell_x(origin.x + radius);
+    int32_t min_cy = cell_y(origin.y - radius);
+    int32_t max_cy = cell_y(origin.y + radius);
+    int32_t min_cz = cell_z(origin.z - radius);
+    int32_t max_cz = cell_z(origin.z + radius);
+
+    const int32_t* start_ptr = cell_start.data();
+    const Vector3* pos_ptr = sorted_positions.data();
+
+    for (int32_t cz = min_cz; cz <= max_cz; cz++) {
+        for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+            int32_t row = (cz * grid_height + cy) * grid_width;
+            int32_t end = start_ptr[row + max_cx + 1];
+            for (int32_t j = start_ptr[row + min_cx]; j < end; j++) {
+                if (origin.distance_squared_to(pos_ptr[j]) <= radius_sq) {
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+}
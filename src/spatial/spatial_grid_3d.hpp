@@ -0,0 +1,176 @@
+/**
+ * SpatialGrid3D - Flat, rebuild-per-frame spatial grid for 3D games
+ *
+ * A fixed-extent uniform grid built with a counting sort. Instead of one
+ * heap-allocated bucket per cell (as in SpatialHash3D), all point indices
+ * live in a single contiguous array sorted by cell, with a per-cell offset
+ * table. Rebuilding reuses the same buffers, so a warmed-up grid performs
+ * no allocations, and queries walk contiguous memory.
+ *
+ * Ideal for:
+ * - Crowds of agents that are fully rebuilt every physics frame
+ * - Radius / box queries over 10k+ points
+ * - Broad phase for many moving bodies
+ *
+ * Trade-offs vs SpatialHash3D:
+ * - Much faster build() and queries
+ * - No insert/update (rebuild when positions change)
+ * - Finite extent: points outside bounds are clamped into border cells
+ *
+ * Usage:
+ *   var grid = SpatialGrid3D.new()
+ *   grid.cell_size = 64.0
+ *   grid.build(positions)  # PackedVector3Array, bounds fitted automatically
+ *   var nearby = grid.query_radius(origin, radius)  # Returns indices
+ */
+
+#ifndef AGENTITE_SPATIAL_GRID_3D_HPP
+#define AGENTITE_SPATIAL_GRID_3D_HPP
+
+#include "neighbor_list.hpp"
+#include "arrays/agent_store_3d.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/array.hpp>
+
+#include <vector>
+
+namespace godot {
+
+class SpatialGrid3D : public RefCounted {
+    GDCLASS(SpatialGrid3D, RefCounted)
+
+private:
+    float cell_size = 64.0f;
+    AABB bounds;                  // User bounds (zero size = fit to data on build)
+
+    // Built grid layout
+    Vector3 grid_origin;
+    float grid_cell_size = 64.0f; // Effective cell size (may exceed cell_size, see build())
+    float inv_cell_size = 1.0f / 64.0f;
+    int32_t grid_width = 0;
+    int32_t grid_height = 0;
+    int32_t grid_depth = 0;
+
+    // Counting-sort storage: points of cell c are [cell_start[c], cell_start[c + 1])
+    std::vector<int32_t> cell_start;
+    std::vector<int32_t> sorted_indices;       // Original point index per slot
+    std::vector<Vector3> sorted_positions;     // Positions in slot order
+    std::vector<int32_t> point_cells;          // Scratch: cell of each input point
+    int32_t item_count = 0;
+
+    // Grids never use more than MAX_CELLS_PER_ITEM cells per item (with a floor of
+    // MIN_CELL_BUDGET); the effective cell size is enlarged instead
+    static constexpr int64_t MAX_CELLS_PER_ITEM = 4;
+    static constexpr int64_t MIN_CELL_BUDGET = 4096;
+
+    // Clamped cell coordinate along one axis (NaN and out-of-range go to the border)
+    static inline int32_t clamp_cell(float offset, float inv_size, int32_t cells) {
+        float f = offset * inv_size;
+        if (!(f >= 0.0f)) {
+            return 0;
+        }
+        if (f >= static_cast<float>(cells)) {
+            return cells - 1;
+        }
+        return static_cast<int32_t>(f);
+    }
+    inline int32_t cell_x(float x) const { return clamp_cell(x - grid_origin.x, inv_cell_size, grid_width); }
+    inline int32_t cell_y(float y) const { return clamp_cell(y - grid_origin.y, inv_cell_size, grid_height); }
+    inline int32_t cell_z(float z) const { return clamp_cell(z - grid_origin.z, inv_cell_size, grid_depth); }
+
+protected:
+    static void _bind_methods();
+
+public:
+    SpatialGrid3D();
+    ~SpatialGrid3D();
+
+    // Properties
+    void set_cell_size(float p_size);
+    float get_cell_size() const;
+
+    // World extent of the grid. Leave empty (default) to fit the points on every build.
+    void set_bounds(const AABB& p_bounds);
+    AABB get_bounds() const;
+
+    // Get count of items in the grid
+    int32_t get_count() const;
+
+    // Grid dimensions in cells after the last build
+    Vector3i get_grid_size() const;
+
+    // Cell size actually used by the last build
+    float get_effective_cell_size() const;
+
+    // Build the grid from a position array (counting sort, reuses buffers)
+    void build(const PackedVector3Array& positions);
+
+    // Build from the position column of an AgentStore (item indices = dense store indices)
+    void build_from_store(const Ref<AgentStore3D>& store);
+
+    // Clear all data (keeps allocated memory for the next build)
+    void clear();
+
+    // Query: find all items within radius of origin
+    // Returns PackedInt32Array of indices into the original positions array
+    PackedInt32Array query_radius(const Vector3& origin, float radius) const;
+
+    // Query: find all items within an AABB
+    PackedInt32Array query_box(const AABB& box) const;
+
+    // Query: find k nearest items to origin, sorted by distance (nearest first)
+    PackedInt32Array query_nearest(const Vector3& origin, int32_t k) const;
+
+    // Query: find nearest single item (-1 if empty)
+    int32_t query_nearest_one(const Vector3& origin) const;
+
+    // Batch query: multiple radius queries at once
+    // Returns Array of PackedInt32Array, one per query
+    // Large batches are split across worker threads; result order matches origins
+    Array query_radius_batch(
+        const PackedVector3Array& origins,
+        const PackedFloat32Array& radii
+    ) const;
+
+    // Batch query: same radius for all queries
+    Array query_radius_batch_uniform(
+        const PackedVector3Array& origins,
+        float radius
+    ) const;
+
+    // Flat batch query: results stored CSR-style in a NeighborList
+    // Pass the same out list every frame to reuse its memory (a new list is created if null)
+    Ref<NeighborList> query_radius_batch_flat(
+        const PackedVector3Array& origins,
+        const PackedFloat32Array& radii,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
+
+    // Flat batch query: same radius for all queries
+    Ref<NeighborList> query_radius_batch_uniform_flat(
+        const PackedVector3Array& origins,
+        float radius,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
+
+    // Check if any item is within radius
+    bool has_any_in_radius(const Vector3& origin, float radius) const;
+
+    // Count items in radius
+    int32_t count_in_radius(const Vector3& origin, float radius) const;
+
+    // C++ API: append indices within radius of origin to out
+    // (shared by the single, flat batch and CollisionOps broadphase queries)
+    void collect_radius(const Vector3& origin, float radius, std::vector<int32_t>& out) const;
+};
+
+}
+
+#endif // AGENTITE_SPATIAL_GRID_3D_HPP
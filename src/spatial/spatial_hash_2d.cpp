@@ -3,6 +3,9 @@
  */
 
 #include "spatial_hash_2d.hpp"
+#include "core/parallel.hpp"
+#include "core/profiling.hpp"
+#include "core/snapshot.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -10,9 +13,26 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace godot {
 
+// Snapshot layout (bump SNAPSHOT_VERSION when it changes)
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotTag : uint32_t {
+    TAG_INFO = 1,
+    TAG_POSITIONS = 2,
+    TAG_CELL_SLOT = 3,
+    TAG_CELL_KEYS = 4,
+    TAG_CELL_ITEMS = 5,  // Jagged: 5 = offsets, 6 = indices
+};
+
+struct SnapshotInfo {
+    float cell_size;
+    int32_t item_count;
+};
+
 void SpatialHash2D::_bind_methods() {
     // Properties
     ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &SpatialHash2D::set_cell_size);
@@ -20,9 +40,12 @@ void SpatialHash2D::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
 
     ClassDB::bind_method(D_METHOD("get_count"), &SpatialHash2D::get_count);
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &SpatialHash2D::save_snapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "data"), &SpatialHash2D::load_snapshot);
 
     // Core methods
     ClassDB::bind_method(D_METHOD("build", "positions"), &SpatialHash2D::build);
+    ClassDB::bind_method(D_METHOD("build_from_store", "store"), &SpatialHash2D::build_from_store);
     ClassDB::bind_method(D_METHOD("clear"), &SpatialHash2D::clear);
     ClassDB::bind_method(D_METHOD("insert", "position"), &SpatialHash2D::insert);
     ClassDB::bind_method(D_METHOD("update", "index", "new_position"), &SpatialHash2D::update);
@@ -36,6 +59,8 @@ void SpatialHash2D::_bind_methods() {
     // Batch queries
     ClassDB::bind_method(D_METHOD("query_radius_batch", "origins", "radii"), &SpatialHash2D::query_radius_batch);
     ClassDB::bind_method(D_METHOD("query_radius_batch_uniform", "origins", "radius"), &SpatialHash2D::query_radius_batch_uniform);
+    ClassDB::bind_method(D_METHOD("query_radius_batch_flat", "origins", "radii", "out"), &SpatialHash2D::query_radius_batch_flat, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("query_radius_batch_uniform_flat", "origins", "radius", "out"), &SpatialHash2D::query_radius_batch_uniform_flat, DEFVAL(Variant()));
 
     // Utility queries
     ClassDB::bind_method(D_METHOD("has_any_in_radius", "origin", "radius"), &SpatialHash2D::has_any_in_radius);
@@ -63,6 +88,99 @@ int32_t SpatialHash2D::get_count() const {
     return item_count;
 }
 
+PackedByteArray SpatialHash2D::save_snapshot() const {
+    SnapshotInfo info;
+    info.cell_size = cell_size;
+    info.item_count = item_count;
+
+    // Cells in key order, so equal contents give equal snapshots
+    std::vector<int64_t> keys;
+    keys.reserve(cells.size());
+    for (const auto& cell : cells) {
+        keys.push_back(cell.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    snapshot::Writer w(snapshot::KIND_SPATIAL_HASH_2D, SNAPSHOT_VERSION);
+    w.add_value(TAG_INFO, info);
+    w.add(TAG_POSITIONS, stored_positions);
+    w.add(TAG_CELL_SLOT, cell_slot);
+    w.add(TAG_CELL_KEYS, keys);
+    w.add_jagged<int32_t>(TAG_CELL_ITEMS, keys.size(), [&](uint64_t i) -> const std::vector<int32_t>& {
+        return cells.find(keys[i])->second;
+    });
+    return w.finish();
+}
+
+bool SpatialHash2D::load_snapshot(const PackedByteArray& data) {
+    snapshot::Reader r;
+    if (!r.open(data, snapshot::KIND_SPATIAL_HASH_2D, SNAPSHOT_VERSION, "SpatialHash2D")) {
+        return false;
+    }
+
+    SnapshotInfo info;
+    std::vector<Vector2> positions;
+    std::vector<int32_t> slots;
+    std::vector<int64_t> keys;
+    if (!r.read_value(TAG_INFO, info) || !r.read(TAG_POSITIONS, positions) ||
+        !r.read(TAG_CELL_SLOT, slots) || !r.read(TAG_CELL_KEYS, keys)) {
+        return false;
+    }
+    std::vector<std::vector<int32_t>> lists(keys.size());
+    if (!r.read_jagged<int32_t>(TAG_CELL_ITEMS, keys.size(), [&](uint64_t i) -> std::vector<int32_t>& {
+        return lists[i];
+    })) {
+        return false;
+    }
+
+    if (!(info.cell_size > 0.0f) || info.item_count < 0 || static_cast<int32_t>(positions.size()) != info.item_count ||
+        static_cast<int32_t>(slots.size()) != info.item_count) {
+        return r.fail("hash settings are invalid");
+    }
+
+    // Every index must sit in exactly one cell: the one its position hashes to
+    // (update() relies on this), at the slot cell_slot records.
+    // hash_position() uses the member cell size, so swap it in while checking.
+    const Vector2* pos = positions.data();
+    auto contents_ok = [&]() {
+        int64_t stored = 0;
+        for (size_t c = 0; c < keys.size(); c++) {
+            const std::vector<int32_t>& list = lists[c];
+            if (list.empty()) return false;
+            for (size_t j = 0; j < list.size(); j++) {
+                int32_t index = list[j];
+                if (index < 0 || index >= info.item_count || slots[index] != static_cast<int32_t>(j) ||
+                    hash_position(pos[index]) != keys[c]) {
+                    return false;
+                }
+            }
+            stored += static_cast<int64_t>(list.size());
+        }
+        return stored == info.item_count;
+    };
+    const float previous_cell_size = cell_size;
+    cell_size = info.cell_size;
+    if (!contents_ok()) {
+        cell_size = previous_cell_size;
+        return r.fail("cell contents don't match the positions");
+    }
+
+    std::unordered_map<int64_t, std::vector<int32_t>> new_cells;
+    new_cells.reserve(keys.size());
+    for (size_t c = 0; c < keys.size(); c++) {
+        if (!new_cells.emplace(keys[c], std::move(lists[c])).second) {
+            cell_size = previous_cell_size;
+            return r.fail("duplicate cell");
+        }
+    }
+
+    cells.swap(new_cells);
+    cell_slot.swap(slots);
+    stored_positions.swap(positions);
+    item_count = info.item_count;
+    return true;
+}
+
 int64_t SpatialHash2D::hash_position(const Vector2& pos) const {
     int32_t cx, cy;
     get_cell_coords(pos, cx, cy);
@@ -76,24 +194,37 @@ void SpatialHash2D::get_cell_coords(const Vector2& pos, int32_t& cx, int32_t& cy
 }
 
 void SpatialHash2D::build(const PackedVector2Array& positions) {
+    AGENTITE_PROFILE("SpatialHash2D.build", positions.size());
     clear();
 
-    stored_positions = positions;
+    stored_positions.assign(positions.ptr(), positions.ptr() + positions.size());
     item_count = positions.size();
 
     // Pre-size hint for cells map based on expected density
     // Assume roughly uniform distribution
 
     const Vector2* pos_ptr = positions.ptr();
+    cell_slot.resize(item_count);
     for (int32_t i = 0; i < item_count; i++) {
         int64_t key = hash_position(pos_ptr[i]);
-        cells[key].push_back(i);
+        std::vector<int32_t>& cell = cells[key];
+        cell_slot[i] = static_cast<int32_t>(cell.size());
+        cell.push_back(i);
+    }
+}
+
+void SpatialHash2D::build_from_store(const Ref<AgentStore2D>& store) {
+    if (store.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: SpatialHash2D.build_from_store needs a store");
+        return;
     }
+    build(store->position_column());
 }
 
 void SpatialHash2D::clear() {
     cells.clear();
-    stored_positions.resize(0);
+    cell_slot.clear();
+    stored_positions.clear();
     item_count = 0;
 }
 
@@ -103,7 +234,9 @@ int32_t SpatialHash2D::insert(const Vector2& position) {
     item_count++;
 
     int64_t key = hash_position(position);
-    cells[key].push_back(index);
+    std::vector<int32_t>& cell = cells[key];
+    cell_slot.push_back(static_cast<int32_t>(cell.size()));
+    cell.push_back(index);
 
     return index;
 }
@@ -118,27 +251,42 @@ void SpatialHash2D::update(int32_t index, const Vector2& new_position) {
     int64_t new_key = hash_position(new_position);
 
     // Update stored position
-    stored_positions.set(index, new_position);
+    stored_positions[index] = new_position;
 
     // If cell changed, update the hash
     if (old_key != new_key) {
-        // Remove from old cell
+        // Remove from old cell: move its last entry into the freed slot
         auto& old_cell = cells[old_key];
-        old_cell.erase(std::remove(old_cell.begin(), old_cell.end(), index), old_cell.end());
+        int32_t moved = old_cell.back();
+        old_cell[cell_slot[index]] = moved;
+        cell_slot[moved] = cell_slot[index];
+        old_cell.pop_back();
         if (old_cell.empty()) {
             cells.erase(old_key);
         }
 
         // Add to new cell
-        cells[new_key].push_back(index);
+        auto& new_cell = cells[new_key];
+        cell_slot[index] = static_cast<int32_t>(new_cell.size());
+        new_cell.push_back(index);
     }
 }
 
 PackedInt32Array SpatialHash2D::query_radius(const Vector2& origin, float radius) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_radius", 1);
+    std::vector<int32_t> hits;
+    collect_radius(origin, radius, hits);
+
     PackedInt32Array result;
+    result.resize(hits.size());
+    std::copy(hits.begin(), hits.end(), result.ptrw());
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
+    return result;
+}
 
+void SpatialHash2D::collect_radius(const Vector2& origin, float radius, std::vector<int32_t>& out) const {
     if (radius <= 0.0f || item_count == 0) {
-        return result;
+        return;
     }
 
     float radius_sq = radius * radius;
@@ -147,7 +295,7 @@ PackedInt32Array SpatialHash2D::query_radius(const Vector2& origin, float radius
     get_cell_coords(origin, cx, cy);
     int32_t range = static_cast<int32_t>(std::ceil(radius / cell_size));
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     for (int32_t dy = -range; dy <= range; dy++) {
         for (int32_t dx = -range; dx <= range; dx++) {
@@ -159,17 +307,16 @@ PackedInt32Array SpatialHash2D::query_radius(const Vector2& origin, float radius
                 for (int32_t idx : it->second) {
                     float dist_sq = origin.distance_squared_to(pos_ptr[idx]);
                     if (dist_sq <= radius_sq) {
-                        result.push_back(idx);
+                        out.push_back(idx);
                     }
                 }
             }
         }
     }
-
-    return result;
 }
 
 PackedInt32Array SpatialHash2D::query_rect(const Rect2& rect) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_rect", 1);
     PackedInt32Array result;
 
     if (item_count == 0) {
@@ -180,7 +327,7 @@ PackedInt32Array SpatialHash2D::query_rect(const Rect2& rect) const {
     get_cell_coords(rect.position, min_cx, min_cy);
     get_cell_coords(rect.position + rect.size, max_cx, max_cy);
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     for (int32_t cy = min_cy; cy <= max_cy; cy++) {
         for (int32_t cx = min_cx; cx <= max_cx; cx++) {
@@ -197,10 +344,12 @@ PackedInt32Array SpatialHash2D::query_rect(const Rect2& rect) const {
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
 PackedInt32Array SpatialHash2D::query_nearest(const Vector2& origin, int32_t k) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_nearest", 1);
     PackedInt32Array result;
 
     if (k <= 0 || item_count == 0) {
@@ -210,7 +359,7 @@ PackedInt32Array SpatialHash2D::query_nearest(const Vector2& origin, int32_t k)
     // For small k relative to total items, use expanding search
     // For large k, just sort everything
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     if (k >= item_count) {
         // Return all items sorted by distance
@@ -244,6 +393,7 @@ PackedInt32Array SpatialHash2D::query_nearest(const Vector2& origin, int32_t k)
         }
     }
 
+    profile_scope.add_bytes(result.size() * sizeof(int32_t));
     return result;
 }
 
@@ -252,7 +402,7 @@ int32_t SpatialHash2D::query_nearest_one(const Vector2& origin) const {
         return -1;
     }
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     int32_t nearest_idx = 0;
     float nearest_dist_sq = origin.distance_squared_to(pos_ptr[0]);
@@ -272,6 +422,7 @@ Array SpatialHash2D::query_radius_batch(
     const PackedVector2Array& origins,
     const PackedFloat32Array& radii
 ) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_radius_batch", origins.size());
     Array results;
 
     int32_t query_count = origins.size();
@@ -280,8 +431,20 @@ Array SpatialHash2D::query_radius_batch(
         return results;
     }
 
+    const Vector2* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    // Queries are read-only and independent, so large batches run across worker threads
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius_ptr[i]);
+        }
+    });
+
+    results.resize(query_count);
     for (int32_t i = 0; i < query_count; i++) {
-        results.push_back(query_radius(origins[i], radii[i]));
+        results[i] = per_query[i];
     }
 
     return results;
@@ -291,16 +454,75 @@ Array SpatialHash2D::query_radius_batch_uniform(
     const PackedVector2Array& origins,
     float radius
 ) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_radius_batch_uniform", origins.size());
     Array results;
 
     int32_t query_count = origins.size();
+    const Vector2* origin_ptr = origins.ptr();
+
+    std::vector<PackedInt32Array> per_query(query_count);
+    parallel::for_range(query_count, parallel::QUERY_CHUNK, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            per_query[i] = query_radius(origin_ptr[i], radius);
+        }
+    });
+
+    results.resize(query_count);
     for (int32_t i = 0; i < query_count; i++) {
-        results.push_back(query_radius(origins[i], radius));
+        results[i] = per_query[i];
     }
 
     return results;
 }
 
+Ref<NeighborList> SpatialHash2D::query_radius_batch_flat(
+    const PackedVector2Array& origins,
+    const PackedFloat32Array& radii,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_radius_batch_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    int32_t query_count = origins.size();
+    if (query_count != radii.size()) {
+        UtilityFunctions::push_error("AgentiteG: origins and radii arrays must have same size");
+        list->clear();
+        return list;
+    }
+
+    const Vector2* origin_ptr = origins.ptr();
+    const float* radius_ptr = radii.ptr();
+
+    list->fill(query_count, [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius_ptr[i], hits);
+    });
+
+    return list;
+}
+
+Ref<NeighborList> SpatialHash2D::query_radius_batch_uniform_flat(
+    const PackedVector2Array& origins,
+    float radius,
+    const Ref<NeighborList>& out
+) const {
+    AGENTITE_PROFILE("SpatialHash2D.query_radius_batch_uniform_flat", origins.size());
+    Ref<NeighborList> list = out;
+    if (list.is_null()) {
+        list.instantiate();
+    }
+
+    const Vector2* origin_ptr = origins.ptr();
+
+    list->fill(origins.size(), [&](int32_t i, std::vector<int32_t>& hits) {
+        collect_radius(origin_ptr[i], radius, hits);
+    });
+
+    return list;
+}
+
 bool SpatialHash2D::has_any_in_radius(const Vector2& origin, float radius) const {
     if (radius <= 0.0f || item_count == 0) {
         return false;
@@ -312,7 +534,7 @@ bool SpatialHash2D::has_any_in_radius(const Vector2& origin, float radius) const
     get_cell_coords(origin, cx, cy);
     int32_t range = static_cast<int32_t>(std::ceil(radius / cell_size));
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     for (int32_t dy = -range; dy <= range; dy++) {
         for (int32_t dx = -range; dx <= range; dx++) {
@@ -345,7 +567,7 @@ int32_t SpatialHash2D::count_in_radius(const Vector2& origin, float radius) cons
     get_cell_coords(origin, cx, cy);
     int32_t range = static_cast<int32_t>(std::ceil(radius / cell_size));
 
-    const Vector2* pos_ptr = stored_positions.ptr();
+    const Vector2* pos_ptr = stored_positions.data();
 
     for (int32_t dy = -range; dy <= range; dy++) {
         for (int32_t dx = -range; dx <= range; dx++) {
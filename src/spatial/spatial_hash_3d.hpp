@@ -18,8 +18,12 @@
 #ifndef AGENTITE_SPATIAL_HASH_3D_HPP
 #define AGENTITE_SPATIAL_HASH_3D_HPP
 
+#include "neighbor_list.hpp"
+#include "arrays/agent_store_3d.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/vector3.hpp>
@@ -37,7 +41,8 @@ class SpatialHash3D : public RefCounted {
 private:
     float cell_size = 64.0f;
     std::unordered_map<uint64_t, std::vector<int32_t>> cells;
-    PackedVector3Array stored_positions;
+    std::vector<int32_t> cell_slot;  // Position of each index within its cell's list
+    std::vector<Vector3> stored_positions;  // Own copy, so building from a store never shares its column
     int32_t item_count = 0;
 
     // Hash a position to a cell key
@@ -63,17 +68,27 @@ public:
     // Get count of items in the hash
     int32_t get_count() const;
 
+    // Save the cells and positions as a flat snapshot
+    PackedByteArray save_snapshot() const;
+
+    // Replace the contents with a saved snapshot, without re-inserting points
+    // Returns false (and keeps the current contents) if the data is invalid
+    bool load_snapshot(const PackedByteArray& data);
+
     // Build the hash from a position array
     // This clears existing data and rebuilds from scratch
     void build(const PackedVector3Array& positions);
 
+    // Build from the position column of an AgentStore (item indices = dense store indices)
+    void build_from_store(const Ref<AgentStore3D>& store);
+
     // Clear all data
     void clear();
 
     // Insert a single item (returns the index assigned)
     int32_t insert(const Vector3& position);
 
-    // Update a single item's position
+    // Update a single item's position (O(1): swap-removes it from its old cell)
     void update(int32_t index, const Vector3& new_position);
 
     // Query: find all items within radius of origin
@@ -91,6 +106,7 @@ public:
 
     // Batch query: multiple radius queries at once
     // Returns Array of PackedInt32Array, one per query
+    // Large batches are split across worker threads; result order matches origins
     Array query_radius_batch(
         const PackedVector3Array& origins,
         const PackedFloat32Array& radii
@@ -102,11 +118,30 @@ public:
         float radius
     ) const;
 
+    // Flat batch query: results stored CSR-style in a NeighborList
+    // Pass the same out list every frame to reuse its memory (a new list is created if null)
+    Ref<NeighborList> query_radius_batch_flat(
+        const PackedVector3Array& origins,
+        const PackedFloat32Array& radii,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
+
+    // Flat batch query: same radius for all queries
+    Ref<NeighborList> query_radius_batch_uniform_flat(
+        const PackedVector3Array& origins,
+        float radius,
+        const Ref<NeighborList>& out = Ref<NeighborList>()
+    ) const;
+
     // Check if any item is within radius (faster than query when you just need bool)
     bool has_any_in_radius(const Vector3& origin, float radius) const;
 
     // Count items in radius (faster than query().size() when you just need count)
     int32_t count_in_radius(const Vector3& origin, float radius) const;
+
+    // C++ API: append indices within radius of origin to out
+    // (shared by the single, flat batch and CollisionOps broadphase queries)
+    void collect_radius(const Vector3& origin, float radius, std::vector<int32_t>& out) const;
 };
 
 }
@@ -5,11 +5,11 @@
 #include "stat_ops.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 
 #include <algorithm>
 #include <cmath>
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <deque>
 #include <set>
@@ -72,6 +72,107 @@ void StatOps::_bind_methods() {
     ClassDB::bind_static_method("StatOps", D_METHOD("count_in_range", "values", "min_val", "max_val"), &StatOps::count_in_range);
     ClassDB::bind_static_method("StatOps", D_METHOD("unique", "values"), &StatOps::unique);
     ClassDB::bind_static_method("StatOps", D_METHOD("count_unique", "values"), &StatOps::count_unique);
+
+    // Fused summary
+    ClassDB::bind_static_method("StatOps", D_METHOD("describe", "values", "flags", "range_min", "range_max"), &StatOps::describe, DEFVAL(DESCRIBE_DEFAULT), DEFVAL(0.0f), DEFVAL(0.0f));
+    ClassDB::bind_static_method("StatOps", D_METHOD("describe_columns", "values", "columns", "flags", "range_min", "range_max"), &StatOps::describe_columns, DEFVAL(DESCRIBE_DEFAULT), DEFVAL(0.0f), DEFVAL(0.0f));
+
+    BIND_CONSTANT(DESCRIBE_COUNT);
+    BIND_CONSTANT(DESCRIBE_SUM);
+    BIND_CONSTANT(DESCRIBE_MEAN);
+    BIND_CONSTANT(DESCRIBE_VARIANCE);
+    BIND_CONSTANT(DESCRIBE_STD_DEV);
+    BIND_CONSTANT(DESCRIBE_MIN);
+    BIND_CONSTANT(DESCRIBE_MAX);
+    BIND_CONSTANT(DESCRIBE_IN_RANGE);
+    BIND_CONSTANT(DESCRIBE_DEFAULT);
+}
+
+// === Selection Helpers ===
+
+// mode() counts bins in a flat array when the bins span at most this many
+// slots per value, and sorts the bin indices otherwise
+static const int64_t MODE_DENSE_SPAN_PER_VALUE = 4;
+
+// Sorted positions a percentile interpolates between (linear method)
+struct PercentileRank {
+    int32_t lower;
+    int32_t upper;
+    float frac;
+};
+
+static PercentileRank percentile_rank(float p, int32_t n) {
+    // Clamp p to [0, 100]
+    if (p < 0.0f) p = 0.0f;
+    if (p > 100.0f) p = 100.0f;
+
+    float rank = (p / 100.0f) * (n - 1);
+    PercentileRank r;
+    r.lower = static_cast<int32_t>(std::floor(rank));
+    r.upper = static_cast<int32_t>(std::ceil(rank));
+    r.frac = rank - r.lower;
+    return r;
+}
+
+// Move the values at sorted positions ranks[first..last) (ascending, unique,
+// all inside [begin, end)) into place. Each nth_element splits the range at the
+// middle rank, so k ranks cost O(n log k) instead of a full sort.
+static void select_ranks(float* data, int32_t begin, int32_t end,
+                         const int32_t* ranks, int32_t first, int32_t last) {
+    if (first >= last) return;
+    int32_t mid = first + (last - first) / 2;
+    int32_t k = ranks[mid];
+    std::nth_element(data + begin, data + k, data + end);
+    select_ranks(data, begin, k, ranks, first, mid);
+    select_ranks(data, k + 1, end, ranks, mid + 1, last);
+}
+
+// Percentiles of data (reordered in place) with the same interpolation as a full sort
+static void select_percentiles(std::vector<float>& data, const float* ps, int32_t np, float* out) {
+    int32_t n = static_cast<int32_t>(data.size());
+
+    std::vector<int32_t> ranks;
+    ranks.reserve(np * 2);
+    for (int32_t i = 0; i < np; i++) {
+        PercentileRank r = percentile_rank(ps[i], n);
+        ranks.push_back(r.lower);
+        ranks.push_back(r.upper);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    select_ranks(data.data(), 0, n, ranks.data(), 0, static_cast<int32_t>(ranks.size()));
+
+    for (int32_t i = 0; i < np; i++) {
+        PercentileRank r = percentile_rank(ps[i], n);
+        if (r.lower == r.upper) {
+            out[i] = data[r.lower];
+        } else {
+            out[i] = data[r.lower] * (1.0f - r.frac) + data[r.upper] * r.frac;
+        }
+    }
+}
+
+// Median of data (reordered in place)
+static float select_median(std::vector<float>& data) {
+    int32_t n = static_cast<int32_t>(data.size());
+    std::nth_element(data.begin(), data.begin() + n / 2, data.end());
+    if (n % 2 == 0) {
+        // The lower middle value is the largest of the left partition
+        float lower = *std::max_element(data.begin(), data.begin() + n / 2);
+        return (lower + data[n / 2]) / 2.0f;
+    }
+    return data[n / 2];
+}
+
+// First and third quartile with one shared selection
+static void select_quartiles(const PackedFloat32Array& values, float& q1_val, float& q3_val) {
+    std::vector<float> data(values.ptr(), values.ptr() + values.size());
+    const float ps[2] = {25.0f, 75.0f};
+    float out[2];
+    select_percentiles(data, ps, 2, out);
+    q1_val = out[0];
+    q3_val = out[1];
 }
 
 // === Descriptive Statistics ===
@@ -93,14 +194,8 @@ float StatOps::median(const PackedFloat32Array& values) {
     int32_t n = values.size();
     if (n == 0) return 0.0f;
 
-    std::vector<float> sorted(values.ptr(), values.ptr() + n);
-    std::sort(sorted.begin(), sorted.end());
-
-    if (n % 2 == 0) {
-        return (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0f;
-    } else {
-        return sorted[n / 2];
-    }
+    std::vector<float> data(values.ptr(), values.ptr() + n);
+    return select_median(data);
 }
 
 float StatOps::mode(const PackedFloat32Array& values, float bin_size) {
@@ -109,20 +204,43 @@ float StatOps::mode(const PackedFloat32Array& values, float bin_size) {
     if (bin_size <= 0.0f) bin_size = 1.0f;
 
     const float* v = values.ptr();
-    std::unordered_map<int64_t, int32_t> bins;
+    std::vector<int64_t> bins(n);
+    int64_t lowest = std::numeric_limits<int64_t>::max();
+    int64_t highest = std::numeric_limits<int64_t>::min();
 
     for (int32_t i = 0; i < n; i++) {
-        int64_t bin = static_cast<int64_t>(std::floor(v[i] / bin_size));
-        bins[bin]++;
+        bins[i] = static_cast<int64_t>(std::floor(v[i] / bin_size));
+        lowest = std::min(lowest, bins[i]);
+        highest = std::max(highest, bins[i]);
     }
 
-    int64_t mode_bin = 0;
+    // Ties go to the lowest bin
+    int64_t mode_bin = lowest;
     int32_t mode_count = 0;
+    uint64_t span = static_cast<uint64_t>(highest) - static_cast<uint64_t>(lowest);
 
-    for (const auto& pair : bins) {
-        if (pair.second > mode_count) {
-            mode_count = pair.second;
-            mode_bin = pair.first;
+    if (span < static_cast<uint64_t>(n) * MODE_DENSE_SPAN_PER_VALUE) {
+        std::vector<int32_t> counts(span + 1, 0);
+        for (int32_t i = 0; i < n; i++) {
+            counts[bins[i] - lowest]++;
+        }
+        for (uint64_t b = 0; b <= span; b++) {
+            if (counts[b] > mode_count) {
+                mode_count = counts[b];
+                mode_bin = lowest + static_cast<int64_t>(b);
+            }
+        }
+    } else {
+        // Sparse bins: equal bins are adjacent after sorting
+        std::sort(bins.begin(), bins.end());
+        for (int32_t i = 0; i < n;) {
+            int32_t run_end = i + 1;
+            while (run_end < n && bins[run_end] == bins[i]) run_end++;
+            if (run_end - i > mode_count) {
+                mode_count = run_end - i;
+                mode_bin = bins[i];
+            }
+            i = run_end;
         }
     }
 
@@ -155,24 +273,11 @@ float StatOps::percentile(const PackedFloat32Array& values, float p) {
     int32_t n = values.size();
     if (n == 0) return 0.0f;
 
-    // Clamp p to [0, 100]
-    if (p < 0.0f) p = 0.0f;
-    if (p > 100.0f) p = 100.0f;
-
-    std::vector<float> sorted(values.ptr(), values.ptr() + n);
-    std::sort(sorted.begin(), sorted.end());
-
-    // Linear interpolation method
-    float rank = (p / 100.0f) * (n - 1);
-    int32_t lower = static_cast<int32_t>(std::floor(rank));
-    int32_t upper = static_cast<int32_t>(std::ceil(rank));
-
-    if (lower == upper) {
-        return sorted[lower];
-    }
-
-    float frac = rank - lower;
-    return sorted[lower] * (1.0f - frac) + sorted[upper] * frac;
+    // Linear interpolation method, selecting only the two values it needs
+    std::vector<float> data(values.ptr(), values.ptr() + n);
+    float result;
+    select_percentiles(data, &p, 1, &result);
+    return result;
 }
 
 PackedFloat32Array StatOps::percentiles(const PackedFloat32Array& values,
@@ -186,27 +291,9 @@ PackedFloat32Array StatOps::percentiles(const PackedFloat32Array& values,
     result.resize(np);
     float* r_ptr = result.ptrw();
 
-    std::vector<float> sorted(values.ptr(), values.ptr() + n);
-    std::sort(sorted.begin(), sorted.end());
-
-    const float* p_ptr = ps.ptr();
-
-    for (int32_t i = 0; i < np; i++) {
-        float p = p_ptr[i];
-        if (p < 0.0f) p = 0.0f;
-        if (p > 100.0f) p = 100.0f;
-
-        float rank = (p / 100.0f) * (n - 1);
-        int32_t lower = static_cast<int32_t>(std::floor(rank));
-        int32_t upper = static_cast<int32_t>(std::ceil(rank));
-
-        if (lower == upper) {
-            r_ptr[i] = sorted[lower];
-        } else {
-            float frac = rank - lower;
-            r_ptr[i] = sorted[lower] * (1.0f - frac) + sorted[upper] * frac;
-        }
-    }
+    // One partial partition for all requested percentiles
+    std::vector<float> data(values.ptr(), values.ptr() + n);
+    select_percentiles(data, ps.ptr(), np, r_ptr);
 
     return result;
 }
@@ -275,7 +362,11 @@ float StatOps::range(const PackedFloat32Array& values) {
 }
 
 float StatOps::iqr(const PackedFloat32Array& values) {
-    return q3(values) - q1(values);
+    if (values.size() == 0) return 0.0f;
+
+    float q1_val, q3_val;
+    select_quartiles(values, q1_val, q3_val);
+    return q3_val - q1_val;
 }
 
 float StatOps::sum(const PackedFloat32Array& values) {
@@ -678,8 +769,8 @@ PackedInt32Array StatOps::outliers_iqr(const PackedFloat32Array& values, float k
     int32_t n = values.size();
     if (n < 4) return result;
 
-    float q1_val = q1(values);
-    float q3_val = q3(values);
+    float q1_val, q3_val;
+    select_quartiles(values, q1_val, q3_val);
     float iqr_val = q3_val - q1_val;
 
     float lower_bound = q1_val - k * iqr_val;
@@ -724,19 +815,16 @@ PackedInt32Array StatOps::outliers_modified_zscore(const PackedFloat32Array& val
     if (n < 2) return result;
 
     // Use median and MAD (Median Absolute Deviation) for robustness
-    float med = median(values);
-
-    // Calculate MAD
-    PackedFloat32Array deviations;
-    deviations.resize(n);
-    float* d_ptr = deviations.ptrw();
     const float* v = values.ptr();
+    std::vector<float> scratch(v, v + n);
+    float med = select_median(scratch);
 
+    // Calculate MAD, reusing the scratch buffer for the deviations
     for (int32_t i = 0; i < n; i++) {
-        d_ptr[i] = std::abs(v[i] - med);
+        scratch[i] = std::abs(v[i] - med);
     }
 
-    float mad = median(deviations);
+    float mad = select_median(scratch);
 
     if (mad < 1e-10f) return result;
 
@@ -842,4 +930,225 @@ int32_t StatOps::count_unique(const PackedFloat32Array& values) {
     return static_cast<int32_t>(seen.size());
 }
 
+// === Fused Summary ===
+
+// describe() works through the data in blocks of this many values: one read
+// from memory, then each requested statistic loops over the block in cache
+static const int64_t DESCRIBE_BLOCK = 1024;
+
+// Independent accumulators per loop. Each one is updated in order, so the
+// loops vectorize without reassociating floating-point sums.
+static const int DESCRIBE_LANES = 8;
+
+// Running totals, one block at a time
+struct DescribeAccumulator {
+    int64_t count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;     // Sum of squared deviations from the mean
+    float min_val = 0.0f;
+    float max_val = 0.0f;
+    int64_t in_range = 0;
+};
+
+// Add one contiguous block. The block's squared deviations are taken from its
+// own mean (a second pass over cached data) and combined with Chan's formula,
+// which is as stable as the two-pass variance().
+static void describe_block(const float* v, int64_t n, int32_t flags, float range_min, float range_max,
+                           DescribeAccumulator& acc) {
+    const bool need_m2 = (flags & (StatOps::DESCRIBE_VARIANCE | StatOps::DESCRIBE_STD_DEV)) != 0;
+    const bool need_sum = need_m2 || (flags & (StatOps::DESCRIBE_SUM | StatOps::DESCRIBE_MEAN)) != 0;
+    const bool need_min_max = (flags & (StatOps::DESCRIBE_MIN | StatOps::DESCRIBE_MAX)) != 0;
+    const int64_t full = n - n % DESCRIBE_LANES;
+
+    double block_sum = 0.0;
+    if (need_sum) {
+        double lanes[DESCRIBE_LANES] = {};
+        for (int64_t i = 0; i < full; i += DESCRIBE_LANES) {
+            for (int l = 0; l < DESCRIBE_LANES; l++) {
+                lanes[l] += v[i + l];
+            }
+        }
+        for (int l = 0; l < DESCRIBE_LANES; l++) {
+            block_sum += lanes[l];
+        }
+        for (int64_t i = full; i < n; i++) {
+            block_sum += v[i];
+        }
+    }
+
+    double block_m2 = 0.0;
+    double block_mean = block_sum / n;
+    if (need_m2) {
+        double lanes[DESCRIBE_LANES] = {};
+        for (int64_t i = 0; i < full; i += DESCRIBE_LANES) {
+            for (int l = 0; l < DESCRIBE_LANES; l++) {
+                double diff = v[i + l] - block_mean;
+                lanes[l] += diff * diff;
+            }
+        }
+        for (int l = 0; l < DESCRIBE_LANES; l++) {
+            block_m2 += lanes[l];
+        }
+        for (int64_t i = full; i < n; i++) {
+            double diff = v[i] - block_mean;
+            block_m2 += diff * diff;
+        }
+    }
+
+    float block_min = v[0];
+    float block_max = v[0];
+    if (need_min_max) {
+        float lo[DESCRIBE_LANES];
+        float hi[DESCRIBE_LANES];
+        for (int l = 0; l < DESCRIBE_LANES; l++) {
+            lo[l] = v[0];
+            hi[l] = v[0];
+        }
+        for (int64_t i = 0; i < full; i += DESCRIBE_LANES) {
+            for (int l = 0; l < DESCRIBE_LANES; l++) {
+                lo[l] = v[i + l] < lo[l] ? v[i + l] : lo[l];
+                hi[l] = v[i + l] > hi[l] ? v[i + l] : hi[l];
+            }
+        }
+        for (int l = 0; l < DESCRIBE_LANES; l++) {
+            block_min = std::min(block_min, lo[l]);
+            block_max = std::max(block_max, hi[l]);
+        }
+        for (int64_t i = full; i < n; i++) {
+            block_min = std::min(block_min, v[i]);
+            block_max = std::max(block_max, v[i]);
+        }
+    }
+
+    if (flags & StatOps::DESCRIBE_IN_RANGE) {
+        int32_t lanes[DESCRIBE_LANES] = {};
+        for (int64_t i = 0; i < full; i += DESCRIBE_LANES) {
+            for (int l = 0; l < DESCRIBE_LANES; l++) {
+                lanes[l] += (v[i + l] >= range_min) & (v[i + l] <= range_max);
+            }
+        }
+        for (int l = 0; l < DESCRIBE_LANES; l++) {
+            acc.in_range += lanes[l];
+        }
+        for (int64_t i = full; i < n; i++) {
+            acc.in_range += (v[i] >= range_min && v[i] <= range_max) ? 1 : 0;
+        }
+    }
+
+    if (acc.count == 0) {
+        acc.mean = block_mean;
+        acc.m2 = block_m2;
+        acc.min_val = block_min;
+        acc.max_val = block_max;
+    } else {
+        int64_t total = acc.count + n;
+        double delta = block_mean - acc.mean;
+        acc.mean += delta * n / total;
+        acc.m2 += block_m2 + delta * delta * (static_cast<double>(acc.count) * n / total);
+        acc.min_val = std::min(acc.min_val, block_min);
+        acc.max_val = std::max(acc.max_val, block_max);
+    }
+    acc.count += n;
+    acc.sum += block_sum;
+}
+
+// Final values with the same conventions as the single-statistic functions
+// (0 for an empty array, sample variance, 0 variance below two values)
+static float describe_mean(const DescribeAccumulator& acc) {
+    return acc.count > 0 ? static_cast<float>(acc.sum / acc.count) : 0.0f;
+}
+
+static float describe_variance(const DescribeAccumulator& acc) {
+    return acc.count > 1 ? static_cast<float>(acc.m2 / (acc.count - 1)) : 0.0f;
+}
+
+Dictionary StatOps::describe(const PackedFloat32Array& values, int32_t flags,
+                             float range_min, float range_max) {
+    DescribeAccumulator acc;
+    int64_t n = values.size();
+    const float* v = values.ptr();
+    for (int64_t start = 0; start < n; start += DESCRIBE_BLOCK) {
+        describe_block(v + start, std::min(DESCRIBE_BLOCK, n - start), flags, range_min, range_max, acc);
+    }
+
+    Dictionary result;
+    if (flags & DESCRIBE_COUNT) result["count"] = acc.count;
+    if (flags & DESCRIBE_SUM) result["sum"] = static_cast<float>(acc.sum);
+    if (flags & DESCRIBE_MEAN) result["mean"] = describe_mean(acc);
+    if (flags & DESCRIBE_VARIANCE) result["variance"] = describe_variance(acc);
+    if (flags & DESCRIBE_STD_DEV) result["std_dev"] = std::sqrt(describe_variance(acc));
+    if (flags & DESCRIBE_MIN) result["min"] = acc.min_val;
+    if (flags & DESCRIBE_MAX) result["max"] = acc.max_val;
+    if (flags & DESCRIBE_IN_RANGE) result["in_range"] = acc.in_range;
+    return result;
+}
+
+Dictionary StatOps::describe_columns(const PackedFloat32Array& values, int32_t columns, int32_t flags,
+                                     float range_min, float range_max) {
+    if (columns <= 0) {
+        UtilityFunctions::push_error("AgentiteG: describe_columns columns must be positive");
+        return Dictionary();
+    }
+    int64_t n = values.size();
+    if (n % columns != 0) {
+        UtilityFunctions::push_error("AgentiteG: describe_columns values size must be a multiple of columns");
+        return Dictionary();
+    }
+
+    // Rows are read once, one block at a time; each column of the block is
+    // copied out contiguously so it runs through the same kernel as describe()
+    int64_t rows = n / columns;
+    const float* v = values.ptr();
+    std::vector<DescribeAccumulator> accs(columns);
+    std::vector<float> column_block(DESCRIBE_BLOCK);
+    for (int64_t start = 0; start < rows; start += DESCRIBE_BLOCK) {
+        int64_t block_rows = std::min(DESCRIBE_BLOCK, rows - start);
+        const float* block = v + start * columns;
+        for (int32_t c = 0; c < columns; c++) {
+            for (int64_t r = 0; r < block_rows; r++) {
+                column_block[r] = block[r * columns + c];
+            }
+            describe_block(column_block.data(), block_rows, flags, range_min, range_max, accs[c]);
+        }
+    }
+
+    auto column_values = [&](float (*stat)(const DescribeAccumulator&)) {
+        PackedFloat32Array out;
+        out.resize(columns);
+        float* o = out.ptrw();
+        for (int32_t c = 0; c < columns; c++) {
+            o[c] = stat(accs[c]);
+        }
+        return out;
+    };
+
+    Dictionary result;
+    if (flags & DESCRIBE_COUNT) result["count"] = rows;
+    if (flags & DESCRIBE_SUM) {
+        result["sum"] = column_values([](const DescribeAccumulator& a) { return static_cast<float>(a.sum); });
+    }
+    if (flags & DESCRIBE_MEAN) result["mean"] = column_values(describe_mean);
+    if (flags & DESCRIBE_VARIANCE) result["variance"] = column_values(describe_variance);
+    if (flags & DESCRIBE_STD_DEV) {
+        result["std_dev"] = column_values([](const DescribeAccumulator& a) { return std::sqrt(describe_variance(a)); });
+    }
+    if (flags & DESCRIBE_MIN) {
+        result["min"] = column_values([](const DescribeAccumulator& a) { return a.min_val; });
+    }
+    if (flags & DESCRIBE_MAX) {
+        result["max"] = column_values([](const DescribeAccumulator& a) { return a.max_val; });
+    }
+    if (flags & DESCRIBE_IN_RANGE) {
+        PackedInt32Array in_range;
+        in_range.resize(columns);
+        int32_t* o = in_range.ptrw();
+        for (int32_t c = 0; c < columns; c++) {
+            o[c] = static_cast<int32_t>(accs[c].in_range);
+        }
+        result["in_range"] = in_range;
+    }
+    return result;
+}
+
 }
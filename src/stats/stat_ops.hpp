@@ -14,12 +14,17 @@
  *   var avg = StatOps.mean(health_values)
  *   var mid = StatOps.median(health_values)
  *   var outliers = StatOps.outliers_iqr(health_values, 1.5)
+ *
+ *   # Several statistics in one pass
+ *   var stats = StatOps.describe(health_values)
+ *   print(stats["mean"], " +- ", stats["std_dev"])
  */
 
 #ifndef AGENTITE_STAT_OPS_HPP
 #define AGENTITE_STAT_OPS_HPP
 
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
@@ -33,6 +38,19 @@ protected:
     static void _bind_methods();
 
 public:
+    // Statistics computed by describe() / describe_columns(), combined as bit flags
+    enum DescribeFlags {
+        DESCRIBE_COUNT = 1,
+        DESCRIBE_SUM = 2,
+        DESCRIBE_MEAN = 4,
+        DESCRIBE_VARIANCE = 8,
+        DESCRIBE_STD_DEV = 16,
+        DESCRIBE_MIN = 32,
+        DESCRIBE_MAX = 64,
+        DESCRIBE_IN_RANGE = 128,       // Values in [range_min, range_max]
+        DESCRIBE_DEFAULT = 127,        // Everything except DESCRIBE_IN_RANGE
+    };
+
     // === Descriptive Statistics ===
 
     // Central tendency
@@ -132,6 +150,18 @@ public:
     // Unique values
     static PackedFloat32Array unique(const PackedFloat32Array& values);
     static int32_t count_unique(const PackedFloat32Array& values);
+
+    // === Fused Summary ===
+
+    // The statistics selected by flags in one pass over memory, keyed "count", "sum",
+    // "mean", "variance", "std_dev", "min", "max" and "in_range"
+    static Dictionary describe(const PackedFloat32Array& values, int32_t flags,
+                               float range_min, float range_max);
+
+    // Same for interleaved data with `columns` values per row: every entry is a
+    // PackedFloat32Array with one value per column ("count" stays the row count)
+    static Dictionary describe_columns(const PackedFloat32Array& values, int32_t columns, int32_t flags,
+                                       float range_min, float range_max);
 };
 
 }
@@ -0,0 +1,431 @@
+/**
+ * StreamingStats Implementation
+ */
+
+#include "streaming_stats.hpp"
+#include "stat_ops.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace godot {
+
+// Pending samples are merged into the digest once the buffer holds this many per unit of compression
+static const int32_t BUFFER_PER_COMPRESSION = 8;
+
+// Smaller digests are too coarse to be useful
+static const float MIN_COMPRESSION = 10.0f;
+
+static const double PI = 3.14159265358979323846;
+
+void StreamingStats::_bind_methods() {
+    // Configuration
+    ClassDB::bind_method(D_METHOD("set_histogram", "min_val", "max_val", "bin_count"), &StreamingStats::set_histogram);
+    ClassDB::bind_method(D_METHOD("set_compression", "compression"), &StreamingStats::set_compression);
+    ClassDB::bind_method(D_METHOD("get_compression"), &StreamingStats::get_compression);
+
+    // Adding samples
+    ClassDB::bind_method(D_METHOD("push", "value"), &StreamingStats::push);
+    ClassDB::bind_method(D_METHOD("push_batch", "values"), &StreamingStats::push_batch);
+    ClassDB::bind_method(D_METHOD("merge", "other"), &StreamingStats::merge);
+    ClassDB::bind_method(D_METHOD("clear"), &StreamingStats::clear);
+
+    // Moments
+    ClassDB::bind_method(D_METHOD("get_count"), &StreamingStats::get_count);
+    ClassDB::bind_method(D_METHOD("get_sum"), &StreamingStats::get_sum);
+    ClassDB::bind_method(D_METHOD("get_mean"), &StreamingStats::get_mean);
+    ClassDB::bind_method(D_METHOD("get_variance"), &StreamingStats::get_variance);
+    ClassDB::bind_method(D_METHOD("get_std_dev"), &StreamingStats::get_std_dev);
+    ClassDB::bind_method(D_METHOD("get_min"), &StreamingStats::get_min);
+    ClassDB::bind_method(D_METHOD("get_max"), &StreamingStats::get_max);
+
+    // Quantiles
+    ClassDB::bind_method(D_METHOD("get_percentile", "p"), &StreamingStats::get_percentile);
+    ClassDB::bind_method(D_METHOD("get_percentiles", "ps"), &StreamingStats::get_percentiles);
+    ClassDB::bind_method(D_METHOD("get_median"), &StreamingStats::get_median);
+    ClassDB::bind_method(D_METHOD("get_centroid_count"), &StreamingStats::get_centroid_count);
+
+    // Histogram
+    ClassDB::bind_method(D_METHOD("get_histogram"), &StreamingStats::get_histogram);
+    ClassDB::bind_method(D_METHOD("get_bin_edges"), &StreamingStats::get_bin_edges);
+}
+
+StreamingStats::StreamingStats() {
+}
+
+StreamingStats::~StreamingStats() {
+}
+
+// ========== CONFIGURATION ==========
+
+void StreamingStats::set_histogram(float p_min_val, float p_max_val, int32_t bin_count) {
+    if (bin_count < 0) {
+        UtilityFunctions::push_error("AgentiteG: StreamingStats bin_count must not be negative");
+        return;
+    }
+    if (bin_count > 0 && !(p_max_val > p_min_val)) {
+        UtilityFunctions::push_error("AgentiteG: StreamingStats histogram max_val must be greater than min_val");
+        return;
+    }
+
+    // Samples already pushed are not re-binned
+    histogram_min = p_min_val;
+    histogram_max = p_max_val;
+    bins.assign(bin_count, 0);
+}
+
+void StreamingStats::set_compression(float p_compression) {
+    if (!(p_compression >= MIN_COMPRESSION)) {
+        UtilityFunctions::push_error("AgentiteG: StreamingStats compression must be at least 10");
+        return;
+    }
+    compression = p_compression;
+}
+
+float StreamingStats::get_compression() const {
+    return compression;
+}
+
+// ========== ADDING SAMPLES ==========
+
+// Combine the current moments with those of another set of samples (Chan et al.)
+void StreamingStats::add_moments(int64_t n, double batch_mean, double batch_m2, double batch_sum,
+                                 float batch_min, float batch_max) {
+    if (n == 0) return;
+
+    if (count == 0) {
+        count = n;
+        mean = batch_mean;
+        m2 = batch_m2;
+        sum = batch_sum;
+        min_val = batch_min;
+        max_val = batch_max;
+        return;
+    }
+
+    int64_t total = count + n;
+    double delta = batch_mean - mean;
+    mean += delta * n / total;
+    m2 += batch_m2 + delta * delta * (static_cast<double>(count) * n / total);
+    count = total;
+    sum += batch_sum;
+    min_val = std::min(min_val, batch_min);
+    max_val = std::max(max_val, batch_max);
+}
+
+void StreamingStats::add_to_histogram(float value) {
+    int32_t bin_count = static_cast<int32_t>(bins.size());
+    float normalized = (value - histogram_min) / (histogram_max - histogram_min);
+
+    // Same binning as StatOps.histogram_range, clamped before the cast
+    int32_t bin = 0;
+    if (normalized >= 1.0f) {
+        bin = bin_count - 1;
+    } else if (normalized > 0.0f) {
+        bin = std::min(static_cast<int32_t>(normalized * bin_count), bin_count - 1);
+    }
+    bins[bin]++;
+}
+
+void StreamingStats::push(float value) {
+    if (!std::isfinite(value)) return;
+
+    add_moments(1, value, 0.0, value, value, value);
+    if (!bins.empty()) {
+        add_to_histogram(value);
+    }
+
+    pending.push_back(value);
+    if (pending.size() >= static_cast<size_t>(compression) * BUFFER_PER_COMPRESSION) {
+        compress();
+    }
+}
+
+void StreamingStats::push_batch(const PackedFloat32Array& values) {
+    int64_t n = values.size();
+    if (n == 0) return;
+    const float* v = values.ptr();
+
+    // Moments of the batch in two passes, then one combine
+    int64_t batch_count = 0;
+    double batch_sum = 0.0;
+    float batch_min = 0.0f;
+    float batch_max = 0.0f;
+    for (int64_t i = 0; i < n; i++) {
+        if (!std::isfinite(v[i])) continue;
+        if (batch_count == 0) {
+            batch_min = v[i];
+            batch_max = v[i];
+        }
+        batch_count++;
+        batch_sum += v[i];
+        batch_min = std::min(batch_min, v[i]);
+        batch_max = std::max(batch_max, v[i]);
+    }
+    if (batch_count == 0) return;
+
+    double batch_mean = batch_sum / batch_count;
+    double batch_m2 = 0.0;
+    for (int64_t i = 0; i < n; i++) {
+        if (!std::isfinite(v[i])) continue;
+        double diff = v[i] - batch_mean;
+        batch_m2 += diff * diff;
+    }
+    add_moments(batch_count, batch_mean, batch_m2, batch_sum, batch_min, batch_max);
+
+    size_t capacity = static_cast<size_t>(compression) * BUFFER_PER_COMPRESSION;
+    bool histogram = !bins.empty();
+    for (int64_t i = 0; i < n; i++) {
+        if (!std::isfinite(v[i])) continue;
+        if (histogram) {
+            add_to_histogram(v[i]);
+        }
+        pending.push_back(v[i]);
+        if (pending.size() >= capacity) {
+            compress();
+        }
+    }
+}
+
+void StreamingStats::merge(const Ref<StreamingStats>& other) {
+    if (other.is_null()) {
+        UtilityFunctions::push_error("AgentiteG: StreamingStats merge needs another StreamingStats");
+        return;
+    }
+    const StreamingStats* src = other.ptr();
+    if (src->bins.size() != bins.size() ||
+            (!bins.empty() && (src->histogram_min != histogram_min || src->histogram_max != histogram_max))) {
+        UtilityFunctions::push_error("AgentiteG: StreamingStats merge needs matching histogram settings");
+        return;
+    }
+
+    // Copy first: other may be this accumulator
+    std::vector<Centroid> incoming = src->centroids;
+    std::vector<float> incoming_pending = src->pending;
+    std::vector<int64_t> incoming_bins = src->bins;
+
+    add_moments(src->count, src->mean, src->m2, src->sum, src->min_val, src->max_val);
+    for (size_t b = 0; b < bins.size(); b++) {
+        bins[b] += incoming_bins[b];
+    }
+
+    // Raw samples stay raw; centroids join ours and are compressed together
+    pending.insert(pending.end(), incoming_pending.begin(), incoming_pending.end());
+    if (!incoming.empty()) {
+        scratch.resize(centroids.size() + incoming.size());
+        std::merge(centroids.begin(), centroids.end(), incoming.begin(), incoming.end(), scratch.begin(),
+                   [](const Centroid& a, const Centroid& b) {
+            return a.mean < b.mean;
+        });
+        centroids.swap(scratch);
+        compress();
+    } else if (pending.size() >= static_cast<size_t>(compression) * BUFFER_PER_COMPRESSION) {
+        compress();
+    }
+}
+
+void StreamingStats::clear() {
+    count = 0;
+    mean = 0.0;
+    m2 = 0.0;
+    sum = 0.0;
+    min_val = 0.0f;
+    max_val = 0.0f;
+    centroids.clear();
+    pending.clear();
+    std::fill(bins.begin(), bins.end(), 0);
+}
+
+// ========== T-DIGEST ==========
+
+// Largest cumulative fraction a centroid starting at fraction q may reach.
+// Uses the k1 scale function k(q) = compression / (2 pi) * asin(2q - 1):
+// each centroid covers at most one unit of k, so centroids shrink near q = 0 and q = 1.
+static double quantile_limit(double q, double compression) {
+    double x = std::max(-1.0, std::min(1.0, 2.0 * q - 1.0));
+    double k = compression / (2.0 * PI) * std::asin(x) + 1.0;
+    double angle = k * 2.0 * PI / compression;
+    if (angle >= PI / 2.0) return 1.0;
+    return (std::sin(angle) + 1.0) / 2.0;
+}
+
+// Merge pending samples and existing centroids in one pass over them in order of mean
+void StreamingStats::compress() {
+    if (centroids.empty() && pending.empty()) return;
+    std::sort(pending.begin(), pending.end());
+
+    // Not count: push_batch adds the moments of the whole batch before its samples arrive here
+    double total = static_cast<double>(pending.size());
+    for (const Centroid& c : centroids) {
+        total += c.weight;
+    }
+
+    // Walk both sorted lists together
+    size_t next_centroid = 0;
+    size_t next_sample = 0;
+    auto take = [&]() {
+        if (next_sample < pending.size() &&
+                (next_centroid >= centroids.size() || pending[next_sample] < centroids[next_centroid].mean)) {
+            return Centroid{pending[next_sample++], 1.0};
+        }
+        return centroids[next_centroid++];
+    };
+    size_t remaining = centroids.size() + pending.size();
+
+    scratch.clear();
+    Centroid current = take();
+    double merged_weight = 0.0;
+    double limit = total * quantile_limit(0.0, compression);
+    for (size_t i = 1; i < remaining; i++) {
+        Centroid next = take();
+        double proposed = current.weight + next.weight;
+        if (merged_weight + proposed <= limit) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            merged_weight += current.weight;
+            scratch.push_back(current);
+            limit = total * quantile_limit(merged_weight / total, compression);
+            current = next;
+        }
+    }
+    scratch.push_back(current);
+
+    centroids.swap(scratch);
+    pending.clear();
+}
+
+// Centroids and pending samples in one list sorted by mean, without compressing:
+// pending samples stay exact until the buffer fills up
+void StreamingStats::sorted_view() {
+    std::sort(pending.begin(), pending.end());
+    view.clear();
+    view.reserve(centroids.size() + pending.size());
+    size_t c = 0;
+    for (float sample : pending) {
+        while (c < centroids.size() && centroids[c].mean <= sample) {
+            view.push_back(centroids[c++]);
+        }
+        view.push_back({sample, 1.0});
+    }
+    view.insert(view.end(), centroids.begin() + c, centroids.end());
+
+    // Sorted position of each centroid's center, on the same 0 .. count-1 scale as
+    // StatOps.percentile, so single samples give exact percentiles
+    view_ranks.resize(view.size());
+    double before = 0.0;
+    for (size_t i = 0; i < view.size(); i++) {
+        view_ranks[i] = before + (view[i].weight - 1.0) / 2.0;
+        before += view[i].weight;
+    }
+}
+
+// Interpolate between neighbouring centroids of the sorted view; min and max anchor the ends
+double StreamingStats::quantile(float p) const {
+    const std::vector<double>& centers = view_ranks;
+    const std::vector<Centroid>& points = view;
+    if (p < 0.0f) p = 0.0f;
+    if (p > 100.0f) p = 100.0f;
+    double rank = (p / 100.0) * (count - 1);
+
+    size_t last = points.size() - 1;
+    if (rank <= centers[0]) {
+        if (centers[0] <= 0.0) return points[0].mean;
+        return min_val + (points[0].mean - min_val) * (rank / centers[0]);
+    }
+    if (rank >= centers[last]) {
+        double span = (count - 1) - centers[last];
+        if (span <= 0.0) return points[last].mean;
+        return points[last].mean + (max_val - points[last].mean) * ((rank - centers[last]) / span);
+    }
+
+    size_t upper = std::upper_bound(centers.begin(), centers.end(), rank) - centers.begin();
+    size_t lower = upper - 1;
+    double t = (rank - centers[lower]) / (centers[upper] - centers[lower]);
+    return points[lower].mean + (points[upper].mean - points[lower].mean) * t;
+}
+
+// ========== MOMENTS ==========
+
+int64_t StreamingStats::get_count() const {
+    return count;
+}
+
+float StreamingStats::get_sum() const {
+    return static_cast<float>(sum);
+}
+
+float StreamingStats::get_mean() const {
+    return static_cast<float>(mean);
+}
+
+float StreamingStats::get_variance() const {
+    if (count < 2) return 0.0f;
+    return static_cast<float>(m2 / (count - 1));
+}
+
+float StreamingStats::get_std_dev() const {
+    return std::sqrt(get_variance());
+}
+
+float StreamingStats::get_min() const {
+    return min_val;
+}
+
+float StreamingStats::get_max() const {
+    return max_val;
+}
+
+// ========== QUANTILES ==========
+
+float StreamingStats::get_percentile(float p) {
+    if (count == 0) return 0.0f;
+    sorted_view();
+    return static_cast<float>(quantile(p));
+}
+
+PackedFloat32Array StreamingStats::get_percentiles(const PackedFloat32Array& ps) {
+    PackedFloat32Array result;
+    int32_t np = ps.size();
+    if (count == 0 || np == 0) return result;
+
+    sorted_view();
+
+    result.resize(np);
+    float* r_ptr = result.ptrw();
+    const float* p_ptr = ps.ptr();
+    for (int32_t i = 0; i < np; i++) {
+        r_ptr[i] = static_cast<float>(quantile(p_ptr[i]));
+    }
+    return result;
+}
+
+float StreamingStats::get_median() {
+    return get_percentile(50.0f);
+}
+
+int32_t StreamingStats::get_centroid_count() {
+    compress();
+    return static_cast<int32_t>(centroids.size());
+}
+
+// ========== HISTOGRAM ==========
+
+PackedInt64Array StreamingStats::get_histogram() const {
+    PackedInt64Array result;
+    result.resize(bins.size());
+    int64_t* r_ptr = result.ptrw();
+    for (size_t b = 0; b < bins.size(); b++) {
+        r_ptr[b] = bins[b];
+    }
+    return result;
+}
+
+PackedFloat32Array StreamingStats::get_bin_edges() const {
+    return StatOps::bin_edges(histogram_min, histogram_max, static_cast<int32_t>(bins.size()));
+}
+
+}
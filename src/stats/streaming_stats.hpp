@@ -0,0 +1,136 @@
+/**
+ * StreamingStats - Running statistics over an unbounded stream of samples
+ *
+ * Keeps summary statistics in a fixed amount of memory, so samples can be
+ * pushed forever without storing them:
+ * - count, sum, min, max, mean and sample variance (Welford / Chan updates)
+ * - percentiles from a t-digest sketch: a few hundred weighted centroids that
+ *   are small near the tails, so p1 / p99 stay accurate
+ * - an optional histogram with fixed bins over a configured range
+ *
+ * Several accumulators (per thread, per match, per level) can be combined
+ * with merge(). While the digest has not compressed anything, percentiles are
+ * exact and match StatOps.percentile.
+ *
+ * Usage:
+ *   var frame_times = StreamingStats.new()
+ *   frame_times.set_histogram(0.0, 50.0, 50)
+ *
+ *   # Every frame
+ *   frame_times.push(delta * 1000.0)
+ *
+ *   # Telemetry report
+ *   var p99 = frame_times.get_percentile(99.0)
+ *   var bins = frame_times.get_histogram()
+ */
+
+#ifndef AGENTITE_STREAMING_STATS_HPP
+#define AGENTITE_STREAMING_STATS_HPP
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class StreamingStats : public RefCounted {
+    GDCLASS(StreamingStats, RefCounted)
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Moments
+    int64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;     // Sum of squared deviations from the mean
+    double sum = 0.0;
+    float min_val = 0.0f;
+    float max_val = 0.0f;
+
+    // t-digest: compressed centroids sorted by mean, plus samples not merged yet
+    float compression = 100.0f;
+    std::vector<Centroid> centroids;
+    std::vector<float> pending;
+    std::vector<Centroid> scratch;
+
+    // Sorted centroids and pending samples for queries, with each one's center rank
+    std::vector<Centroid> view;
+    std::vector<double> view_ranks;
+
+    // Fixed-bin histogram (bin_count 0 = disabled)
+    float histogram_min = 0.0f;
+    float histogram_max = 0.0f;
+    std::vector<int64_t> bins;
+
+    void add_moments(int64_t n, double batch_mean, double batch_m2, double batch_sum,
+                     float batch_min, float batch_max);
+    void add_to_histogram(float value);
+    void compress();
+    void sorted_view();
+    double quantile(float p) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    StreamingStats();
+    ~StreamingStats();
+
+    // === Configuration ===
+
+    // Count samples into bin_count equal bins over [min_val, max_val] (0 bins disables)
+    // Samples outside the range go to the first / last bin, as in StatOps.histogram_range
+    void set_histogram(float p_min_val, float p_max_val, int32_t bin_count);
+
+    // t-digest size: between compression / 2 and compression centroids are kept.
+    // Higher is more accurate and uses more memory.
+    void set_compression(float p_compression);
+    float get_compression() const;
+
+    // === Adding Samples ===
+
+    // NaN and infinite samples are ignored
+    void push(float value);
+    void push_batch(const PackedFloat32Array& values);
+
+    // Add everything other has seen (histogram settings must match)
+    void merge(const Ref<StreamingStats>& other);
+
+    // Forget all samples (settings are kept)
+    void clear();
+
+    // === Moments ===
+
+    int64_t get_count() const;
+    float get_sum() const;
+    float get_mean() const;
+    float get_variance() const;  // Sample variance, as StatOps.variance
+    float get_std_dev() const;
+    float get_min() const;
+    float get_max() const;
+
+    // === Quantiles ===
+
+    // p in 0-100. Exact until the first compression (compression * 8 samples).
+    float get_percentile(float p);
+    PackedFloat32Array get_percentiles(const PackedFloat32Array& ps);
+    float get_median();
+
+    // Number of t-digest centroids after flushing pending samples
+    int32_t get_centroid_count();
+
+    // === Histogram ===
+
+    PackedInt64Array get_histogram() const;
+    PackedFloat32Array get_bin_edges() const;
+};
+
+}
+
+#endif // AGENTITE_STREAMING_STATS_HPP